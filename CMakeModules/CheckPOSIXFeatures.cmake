@@ -7,3 +7,14 @@ check_function_exists(timegm       HAVE_TIMEGM)
 check_variable_exists(daylight     HAVE_DAYLIGHT)
 check_function_exists(ftime        HAVE_FTIME)
 check_function_exists(gettimeofday HAVE_GETTIMEOFDAY)
+
+check_function_exists(shm_open     HAVE_SHM_OPEN)
+if (NOT HAVE_SHM_OPEN AND NOT WIN32)
+    # before glibc 2.34, shm_open() is in librt
+    include(CheckLibraryExists)
+    check_library_exists(rt shm_open "" HAVE_SHM_OPEN_IN_RT)
+    if (HAVE_SHM_OPEN_IN_RT)
+        set(HAVE_SHM_OPEN 1)
+        list(APPEND PLATFORM_LIBS rt)
+    endif()
+endif()
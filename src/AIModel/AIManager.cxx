@@ -31,6 +31,7 @@
 
 #include <Add-ons/AddonManager.hxx>
 #include <Airports/airport.hxx>
+#include <Main/FrameProfiler.hxx>
 #include <Main/fg_props.hxx>
 #include <Main/globals.hxx>
 #include <Main/sentryIntegration.hxx>
@@ -322,6 +323,9 @@ FGAIManager::shutdown()
     }
 
     ai_list.clear();
+    _spatialIndex.clear();
+    _objectsById.clear();
+    _objectsByProps.clear();
     _environmentVisiblity.clear();
 
     if (_userAircraft) {
@@ -355,6 +359,12 @@ void FGAIManager::removeDeadItem(FGAIBase* base)
 {
     SGPropertyNode *props = base->_getProps();
 
+    auto idIt = _objectsById.find(base->getID());
+    if ((idIt != _objectsById.end()) && (idIt->second == base)) {
+        _objectsById.erase(idIt);
+    }
+    _objectsByProps.erase(props);
+
     props->setBoolValue("valid", false);
     base->unbind();
 
@@ -369,6 +379,7 @@ void FGAIManager::removeDeadItem(FGAIBase* base)
 void
 FGAIManager::update(double dt)
 {
+    FG_PROFILE_SCOPE("subsystems/ai-model");
     // initialize these for finding nearest thermals
     range_nearest = 10000.0;
     strength = 0.0;
@@ -394,6 +405,8 @@ FGAIManager::update(double dt)
 
     ai_list.erase(ai_list.begin(), firstAlive);
 
+    rebuildSpatialIndex(dt);
+
     // every remaining item is alive. update them in turn, but guard for
     // exceptions, so a single misbehaving AI object doesn't bring down the
     // entire subsystem.
@@ -414,6 +427,23 @@ FGAIManager::update(double dt)
     thermal_lift_node->setDoubleValue( strength );  // for thermals
 }
 
+void FGAIManager::rebuildSpatialIndex(double dt)
+{
+    _spatialIndex.clear();
+    _maxCollisionLengthFt = 0;
+    double maxSpeedKts = 0.0;
+
+    for (FGAIBase* base : ai_list) {
+        _spatialIndex.insert(base, base->getCartPos());
+        _maxCollisionLengthFt = std::max(_maxCollisionLengthFt, base->getCollisionLength());
+        maxSpeedKts = std::max(maxSpeedKts, fabs(base->_getSpeed()));
+    }
+
+    // objects move during the update which follows; pad queries by the
+    // furthest any of them can travel in one frame
+    _spatialIndexSlackM = maxSpeedKts * SG_KT_TO_MPS * dt;
+}
+
 /** update LOD settings of all AI/MP models */
 void
 FGAIManager::updateLOD(SGPropertyNode* node)
@@ -450,6 +480,13 @@ FGAIManager::attach(const SGSharedPtr<FGAIBase> &model)
     model->init(model->getSearchOrder());
     model->bind();
     p->setBoolValue("valid", true);
+
+    // make the object visible to queries straight away, rather than from
+    // the next update()
+    _objectsById[model->getID()] = model.get();
+    _objectsByProps[p] = model.get();
+    _spatialIndex.insert(model.get(), model->getCartPos());
+    _maxCollisionLengthFt = std::max(_maxCollisionLengthFt, model->getCollisionLength());
 }
 
 bool FGAIManager::isVisible(const SGGeod& pos) const
@@ -589,33 +626,29 @@ bool FGAIManager::removeObjectCommand(const SGPropertyNode* arg, const SGPropert
 bool FGAIManager::removeObject(const SGPropertyNode* args)
 {
     int id = args->getIntValue("id");
-    auto coll = get_ai_list();
-    auto it_ai = std::find_if(coll.begin(), coll.end(), [id](FGAIBasePtr ai) {
-        return ai->getID() == id;
-    });
-    if (it_ai != coll.end())
-        (*it_ai)->setDie(true);
-
-#if 0
-    for (FGAIBase* ai : get_ai_list()) {
-        if (ai->getID() == id) {
-            ai->setDie(true);
-            break;
-        }
-    }
-#endif
+    auto it = _objectsById.find(id);
+    if (it != _objectsById.end())
+        it->second->setDie(true);
 
     return false;
 }
 
 FGAIBasePtr FGAIManager::getObjectFromProperty(const SGPropertyNode* aProp) const
 {
-    auto it = std::find_if(ai_list.begin(), ai_list.end(),
-                           [aProp](FGAIBasePtr ai) { return ai->_getProps() == aProp; });
-    if (it == ai_list.end()) {
+    auto it = _objectsByProps.find(aProp);
+    if (it == _objectsByProps.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+FGAIBasePtr FGAIManager::getObjectById(int id) const
+{
+    auto it = _objectsById.find(id);
+    if (it == _objectsById.end()) {
         return nullptr;
     }
-    return *it;
+    return it->second;
 }
 
 bool
@@ -708,41 +741,25 @@ FGAIManager::loadScenarioFile(const std::string& scenarioName, SGPath& outPath)
 const FGAIBase *
 FGAIManager::calcCollision(double alt, double lat, double lon, double fuse_range)
 {
-    ai_list_iterator ai_list_itr = ai_list.begin();
-    ai_list_iterator end = ai_list.end();
-
     SGGeod pos(SGGeod::fromDegFt(lon, lat, alt));
     SGVec3d cartPos(SGVec3d::fromGeod(pos));
 
-    while (ai_list_itr != end) {
-        FGAIBasePtr aiModel = *ai_list_itr;
+    // nothing further away than the longest collision length can be hit
+    const double queryRangeM = (_maxCollisionLengthFt + fuse_range) * SG_FEET_TO_METER;
+
+    for (FGAIBase* aiModel : findObjectsInRange(cartPos, queryRangeM)) {
         FGAIBase::object_type type = aiModel->getType();
         double tgt_alt = aiModel->_getAltitude();
         int tgt_ht = aiModel->getCollisionHeight() + fuse_range;
 
         if (fabs(tgt_alt - alt) > tgt_ht || type == FGAIBase::object_type::otBallistic
             || type == FGAIBase::object_type::otStorm || type == FGAIBase::object_type::otThermal ) {
-                //SG_LOG(SG_AI, SG_DEBUG, "AIManager: skipping "
-                //    << fabs(tgt_alt - alt)
-                //    << " "
-                //    << type
-                //    );
-                ++ai_list_itr;
                 continue;
         }
 
-        int id = (*ai_list_itr)->getID();
+        int id = aiModel->getID();
 
-        double range = calcRangeFt(cartPos, (*ai_list_itr));
-
-        //SG_LOG(SG_AI, SG_DEBUG, "AIManager:  AI list size "
-        //    << ai_list.size()
-        //    << " type " << type
-        //    << " ID " << id
-        //    << " range " << range
-        //    //<< " bearing " << bearing
-        //    << " alt " << tgt_alt
-        //    );
+        double range = calcRangeFt(cartPos, aiModel);
 
         int tgt_length = aiModel->getCollisionLength() + fuse_range;
 
@@ -754,13 +771,27 @@ FGAIManager::calcCollision(double alt, double lat, double lon, double fuse_range
                 << " range " << range
                 << " alt " << tgt_alt
                 );
-            return aiModel.get();
+            return aiModel;
         }
-        ++ai_list_itr;
     }
     return nullptr;
 }
 
+FGAIManager::ai_list_type
+FGAIManager::findObjectsInRange(const SGVec3d& aCartPos, double rangeM) const
+{
+    std::vector<FGAIBase*> found;
+    _spatialIndex.findWithinRange(aCartPos, rangeM + _spatialIndexSlackM, found);
+    return ai_list_type(found.begin(), found.end());
+}
+
+FGAIManager::ai_list_type
+FGAIManager::findNearestObjects(const SGVec3d& aCartPos, size_t count, double maxRangeM) const
+{
+    auto found = _spatialIndex.findNearest(aCartPos, count, maxRangeM + _spatialIndexSlackM);
+    return ai_list_type(found.begin(), found.end());
+}
+
 double
 FGAIManager::calcRangeFt(const SGVec3d& aCartPos, const FGAIBase* aObject) const
 {
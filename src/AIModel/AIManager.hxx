@@ -24,6 +24,7 @@
 
 #include <list>
 #include <map>
+#include <unordered_map>
 
 #include <simgear/math/SGVec3.hxx>
 #include <simgear/misc/sg_path.hxx>
@@ -31,6 +32,8 @@
 #include <simgear/structure/SGSharedPtr.hxx>
 #include <simgear/structure/subsystem_mgr.hxx>
 
+#include "AISpatialIndex.hxx"
+
 class FGAIBase;
 class FGAIThermal;
 class FGAIAircraft;
@@ -88,6 +91,11 @@ public:
      */
     FGAIBasePtr getObjectFromProperty(const SGPropertyNode* aProp) const;
 
+    /**
+     * @brief return the AI object with the given ID, or NULL.
+     */
+    FGAIBasePtr getObjectById(int id) const;
+
     typedef std::vector <FGAIBasePtr> ai_list_type;
     const ai_list_type& get_ai_list() const {
         return ai_list;
@@ -95,6 +103,20 @@ public:
 
     double calcRangeFt(const SGVec3d& aCartPos, const FGAIBase* aObject) const;
 
+    /**
+     * @brief AI objects within rangeM of a cartesian position, in AI list
+     * order. Answered from the spatial index built at the start of the
+     * current update, padded by one frame of travel, so callers needing an
+     * exact range must still check it against the current position.
+     */
+    ai_list_type findObjectsInRange(const SGVec3d& aCartPos, double rangeM) const;
+
+    /**
+     * @brief up to count AI objects within maxRangeM of a cartesian
+     * position, nearest first (by their position at the start of the update).
+     */
+    ai_list_type findNearestObjects(const SGVec3d& aCartPos, size_t count, double maxRangeM) const;
+
     /**
      * @brief Retrieve the representation of the user's aircraft in the AI manager
      * the position and velocity of this object are slaved to the user's aircraft,
@@ -124,6 +146,8 @@ private:
 
     void removeDeadItem(FGAIBase* base);
 
+    void rebuildSpatialIndex(double dt);
+
     // Returns true on success, e.g. returns false if scenario is already loaded.
     bool loadScenarioCommand(const SGPropertyNode* args, SGPropertyNode* root);
     
@@ -147,6 +171,14 @@ private:
     
     ai_list_type ai_list;
 
+    // spatial index and lookup tables over ai_list, maintained by attach()
+    // and rebuilt once per update()
+    AISpatialIndex _spatialIndex;
+    double _spatialIndexSlackM = 0.0;
+    int _maxCollisionLengthFt = 0;
+    std::unordered_map<int, FGAIBase*> _objectsById;
+    std::unordered_map<const SGPropertyNode*, FGAIBase*> _objectsByProps;
+
     double user_altitude_agl = 0.0;
     double user_heading = 0.0;
     double user_pitch = 0.0;
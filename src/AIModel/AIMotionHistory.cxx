@@ -0,0 +1,186 @@
+// AIMotionHistory - time ordered ring of multiplayer motion samples
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include <config.h>
+
+#include "AIMotionHistory.hxx"
+
+#include <algorithm>
+#include <cstring>
+
+#include <MultiPlayer/mpmessages.hxx>
+
+FGAIMotionHistory::FGAIMotionHistory() = default;
+
+FGAIMotionHistory::~FGAIMotionHistory() = default;
+
+static bool isStringType(simgear::props::Type type)
+{
+    return (type == simgear::props::STRING) || (type == simgear::props::UNSPECIFIED);
+}
+
+void FGAIMotionHistory::add(double key, const FGExternalMotionData& motionInfo)
+{
+    // Find the slot: normally at the back, as packets arrive in order.
+    size_t index = _size;
+    while (index > 0 && at(index - 1).key > key) {
+        --index;
+    }
+
+    const bool replace = (index > 0 && at(index - 1).key == key);
+    if (replace) {
+        --index;
+    } else {
+        if (_size == _samples.size()) {
+            growSamples();
+        }
+
+        // make room, moving later samples up by one
+        for (size_t i = _size; i > index; --i) {
+            at(i) = at(i - 1);
+        }
+        ++_size;
+        if (index < _cursor) {
+            ++_cursor;
+        }
+    }
+
+    Sample& s = at(index);
+    s.key = key;
+    s.time = motionInfo.time;
+    s.lag = motionInfo.lag;
+    s.position = motionInfo.position;
+    s.orientation = motionInfo.orientation;
+    s.linearVel = motionInfo.linearVel;
+    s.angularVel = motionInfo.angularVel;
+    s.linearAccel = motionInfo.linearAccel;
+    s.angularAccel = motionInfo.angularAccel;
+
+    size_t stringBytes = 0;
+    for (const FGPropertyData* data : motionInfo.properties) {
+        if (isStringType(data->type)) {
+            stringBytes += (data->string_value ? strlen(data->string_value) : 0) + 1;
+        }
+    }
+
+    // A replaced sample's old values stay in the pools until the samples
+    // around them have been consumed.
+    s.numProperties = static_cast<uint32_t>(motionInfo.properties.size());
+    s.propertiesBegin = _properties.allocate(s.numProperties);
+    s.stringsBegin = _strings.allocate(stringBytes);
+
+    uint64_t nextString = s.stringsBegin;
+    uint64_t p = s.propertiesBegin;
+    for (const FGPropertyData* data : motionInfo.properties) {
+        Property& prop = _properties[p++];
+        prop.id = data->id;
+        prop.type = data->type;
+        prop.string_begin = nextString;
+        if (isStringType(data->type)) {
+            const char* value = data->string_value ? data->string_value : "";
+            const size_t length = strlen(value) + 1;
+            memcpy(&_strings[nextString], value, length);
+            nextString += length;
+            prop.int_value = 0;
+        } else {
+            prop.int_value = data->int_value;
+        }
+    }
+}
+
+void FGAIMotionHistory::clear()
+{
+    _first = 0;
+    _size = 0;
+    _cursor = 0;
+    _properties.clear();
+    _strings.clear();
+}
+
+size_t FGAIMotionHistory::upperBound(double t)
+{
+    if (_cursor > _size) {
+        _cursor = _size;
+    }
+
+    // Time usually moves forwards by a fraction of the packet interval, so
+    // the answer is at or just after the previous one.
+    if (_cursor == 0 || at(_cursor - 1).key <= t) {
+        while (_cursor < _size && at(_cursor).key <= t) {
+            ++_cursor;
+        }
+        return _cursor;
+    }
+
+    size_t lo = 0;
+    size_t hi = _cursor - 1;
+    while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        if (at(mid).key <= t) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    _cursor = lo;
+    return _cursor;
+}
+
+void FGAIMotionHistory::eraseFront(size_t n)
+{
+    n = std::min(n, _size);
+    if (n == 0) {
+        return;
+    }
+
+    _first = (_first + n) & _sampleMask;
+    _size -= n;
+    _cursor = (_cursor > n) ? _cursor - n : 0;
+    releasePools();
+}
+
+void FGAIMotionHistory::growSamples()
+{
+    const size_t size = _samples.empty() ? 16 : _samples.size() * 2;
+    std::vector<Sample> samples(size);
+    for (size_t i = 0; i < _size; ++i) {
+        samples[i] = at(i);
+    }
+    _samples.swap(samples);
+    _sampleMask = size - 1;
+    _first = 0;
+}
+
+void FGAIMotionHistory::releasePools()
+{
+    if (_size == 0) {
+        _properties.clear();
+        _strings.clear();
+        return;
+    }
+
+    // The oldest sample's values are usually the oldest in the pools, but
+    // not if samples arrived out of order.
+    uint64_t propertiesHead = _properties.tail();
+    uint64_t stringsHead = _strings.tail();
+    for (size_t i = 0; i < _size; ++i) {
+        const Sample& s = at(i);
+        propertiesHead = std::min(propertiesHead, s.propertiesBegin);
+        stringsHead = std::min(stringsHead, s.stringsBegin);
+    }
+    _properties.release(propertiesHead);
+    _strings.release(stringsHead);
+}
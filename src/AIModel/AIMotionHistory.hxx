@@ -0,0 +1,195 @@
+// AIMotionHistory - time ordered ring of multiplayer motion samples
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <simgear/math/SGMath.hxx>
+#include <simgear/props/props.hxx>
+
+struct FGExternalMotionData;
+
+/**
+ * @brief The motion samples received for one multiplayer aircraft, sorted
+ * by time.
+ *
+ * Samples live in a power-of-two ring, and their property values (and the
+ * characters of string values) in further rings shared by all samples, so
+ * once the rings have grown to fit the usual backlog, adding and discarding
+ * samples doesn't allocate.
+ * Samples normally arrive in time order and are consumed from the front,
+ * which makes both operations constant time; a sample arriving out of
+ * order is inserted at its place, and one with the time of an existing
+ * sample replaces it.
+ *
+ * upperBound() remembers where the previous search ended, since each frame
+ * asks for a slightly later time than the one before.
+ */
+class FGAIMotionHistory
+{
+public:
+    struct Property {
+        unsigned id;
+        simgear::props::Type type;
+        union {
+            int int_value;
+            float float_value;
+        };
+        uint64_t string_begin; ///< STRING and UNSPECIFIED values only
+    };
+
+    struct Sample {
+        double key; ///< time used for ordering, maybe compensated
+        double time;
+        double lag;
+        SGVec3d position;
+        SGQuatf orientation;
+        SGVec3f linearVel;
+        SGVec3f angularVel;
+        SGVec3f linearAccel;
+        SGVec3f angularAccel;
+
+        // absolute indexes into the property and string rings
+        uint64_t propertiesBegin;
+        uint64_t stringsBegin;
+        uint32_t numProperties;
+    };
+
+    FGAIMotionHistory();
+    ~FGAIMotionHistory();
+
+    /// Copies motionInfo, including its property values, under key.
+    void add(double key, const FGExternalMotionData& motionInfo);
+
+    void clear();
+
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+
+    /// i counts from the oldest sample
+    const Sample& operator[](size_t i) const
+    {
+        return _samples[(_first + i) & _sampleMask];
+    }
+
+    const Sample& front() const { return (*this)[0]; }
+    const Sample& back() const { return (*this)[_size - 1]; }
+
+    /// index of the first sample with key > t, or size() if there is none
+    size_t upperBound(double t);
+
+    /// discard the n oldest samples
+    void eraseFront(size_t n);
+
+    /// the properties of s are contiguous
+    const Property* properties(const Sample& s) const
+    {
+        return s.numProperties ? &_properties[s.propertiesBegin] : nullptr;
+    }
+
+    const char* stringValue(const Property& p) const
+    {
+        return &_strings[p.string_begin];
+    }
+
+private:
+    /**
+     * Ring of T addressed by ever increasing absolute indexes, handing out
+     * contiguous blocks. Blocks are released in bulk, by moving the head.
+     */
+    template <class T>
+    class Pool
+    {
+    public:
+        const T& operator[](uint64_t i) const { return _items[i & _mask]; }
+        T& operator[](uint64_t i) { return _items[i & _mask]; }
+
+        uint64_t head() const { return _head; }
+        uint64_t tail() const { return _tail; }
+
+        uint64_t allocate(size_t n)
+        {
+            if (n == 0) {
+                return _tail;
+            }
+
+            for (;;) {
+                // a block which would wrap starts at the beginning instead
+                uint64_t begin = _tail;
+                const uint64_t offset = begin & _mask;
+                if (!_items.empty() && offset + n > _items.size()) {
+                    begin += _items.size() - offset;
+                }
+
+                if (!_items.empty() && begin + n - _head <= _items.size()) {
+                    _tail = begin + n;
+                    return begin;
+                }
+
+                grow(_tail - _head + n);
+            }
+        }
+
+        /// everything before head is no longer used
+        void release(uint64_t head) { _head = head; }
+
+        void clear() { _head = _tail; }
+
+    private:
+        void grow(uint64_t needed)
+        {
+            size_t size = _items.empty() ? 64 : _items.size() * 2;
+            while (size < needed) {
+                size *= 2;
+            }
+
+            // Entries keep their absolute indexes, and since the new size is
+            // a multiple of the old one, blocks stay contiguous.
+            std::vector<T> items(size);
+            const uint64_t mask = size - 1;
+            for (uint64_t i = _head; i < _tail; ++i) {
+                items[i & mask] = _items[i & _mask];
+            }
+            _items.swap(items);
+            _mask = mask;
+        }
+
+        std::vector<T> _items;
+        uint64_t _mask = 0;
+        uint64_t _head = 0;
+        uint64_t _tail = 0;
+    };
+
+    Sample& at(size_t i)
+    {
+        return _samples[(_first + i) & _sampleMask];
+    }
+
+    void growSamples();
+    void releasePools();
+
+    std::vector<Sample> _samples;
+    size_t _sampleMask = 0;
+    size_t _first = 0;
+    size_t _size = 0;
+    size_t _cursor = 0; ///< result of the last upperBound()
+
+    Pool<Property> _properties;
+    Pool<char> _strings;
+};
@@ -129,8 +129,8 @@ SGRawValueMethods<FGAIMultiplayer, type>(*this, \
 
 
 void FGAIMultiplayer::FGAIMultiplayerInterpolate(
-        MotionInfo::iterator prevIt,
-        MotionInfo::iterator nextIt,
+        const FGAIMotionHistory::Sample& prev,
+        const FGAIMotionHistory::Sample& next,
         double tau,
         SGVec3d& ecPos,
         SGQuatf& ecOrient,
@@ -138,27 +138,21 @@ void FGAIMultiplayer::FGAIMultiplayerInterpolate(
         )
 {
     // Here we do just linear interpolation on the position
-    ecPos = interpolate(tau, prevIt->second.position, nextIt->second.position);
-    ecOrient = interpolate((float)tau, prevIt->second.orientation,
-        nextIt->second.orientation);
-    ecLinearVel = interpolate((float)tau, prevIt->second.linearVel, nextIt->second.linearVel);
+    ecPos = interpolate(tau, prev.position, next.position);
+    ecOrient = interpolate((float)tau, prev.orientation,
+        next.orientation);
+    ecLinearVel = interpolate((float)tau, prev.linearVel, next.linearVel);
     speed = norm(ecLinearVel) * SG_METER_TO_NM * 3600.0;
 
-    if (prevIt->second.properties.size() == nextIt->second.properties.size()) {
-        std::vector<FGPropertyData*>::const_iterator prevPropIt;
-        std::vector<FGPropertyData*>::const_iterator prevPropItEnd;
-        std::vector<FGPropertyData*>::const_iterator nextPropIt;
-        std::vector<FGPropertyData*>::const_iterator nextPropItEnd;
+    if (prev.numProperties == next.numProperties) {
+        const FGAIMotionHistory::Property* prevProp = mMotionInfo.properties(prev);
+        const FGAIMotionHistory::Property* prevPropEnd = prevProp + prev.numProperties;
+        const FGAIMotionHistory::Property* nextProp = mMotionInfo.properties(next);
 
-        prevPropIt = prevIt->second.properties.begin();
-        prevPropItEnd = prevIt->second.properties.end();
-        nextPropIt = nextIt->second.properties.begin();
-        nextPropItEnd = nextIt->second.properties.end();
-
-        while (prevPropIt != prevPropItEnd)
+        while (prevProp != prevPropEnd)
         {
-            PropertyMap::iterator pIt = mPropertyMap.find((*prevPropIt)->id);
-            //cout << " Setting property..." << (*prevPropIt)->id;
+            PropertyMap::iterator pIt = mPropertyMap.find(prevProp->id);
+            //cout << " Setting property..." << prevProp->id;
 
             if (pIt != mPropertyMap.end())
             {
@@ -169,16 +163,16 @@ void FGAIMultiplayer::FGAIMultiplayerInterpolate(
                  * During multiplayer operations a series of crashes were encountered that affected all players
                  * within range of each other and resulting in an exception being thrown at exactly the same moment in time
                  * (within case props::STRING: ref http://i.imgur.com/y6MBoXq.png)
-                 * Investigation showed that the nextPropIt and prevPropIt were pointing to different properties
+                 * Investigation showed that the nextProp and prevProp were pointing to different properties
                  * which may be caused due to certain models that have overloaded mp property transmission and
                  * these craft have their properties truncated due to packet size. However the result of this
                  * will be different contents in the previous and current packets, so here we protect against
                  * this by only considering properties where the previous and next id are the same.
                  * It might be a better solution to search the previous and next lists to locate the matching id's
                  */
-                if (*nextPropIt && (*nextPropIt)->id == (*prevPropIt)->id)
+                if (nextProp->id == prevProp->id)
                 {
-                    switch ((*prevPropIt)->type)
+                    switch (prevProp->type)
                     {
                         case simgear::props::INT:
                         case simgear::props::BOOL:
@@ -186,29 +180,29 @@ void FGAIMultiplayer::FGAIMultiplayerInterpolate(
                             // Jean Pellotier, 2018-01-02 : we don't want interpolation for integer values, they are mostly used
                             // for non linearly changing values (e.g. transponder etc ...)
                             // fixes: https://sourceforge.net/p/flightgear/codetickets/1885/
-                            pIt->second->setIntValue((*nextPropIt)->int_value);
+                            pIt->second->setIntValue(nextProp->int_value);
                             break;
 
                         case simgear::props::FLOAT:
                         case simgear::props::DOUBLE:
                             {
-                                float val = (1 - tau)*(*prevPropIt)->float_value +
-                                            tau*(*nextPropIt)->float_value;
+                                float val = (1 - tau)*prevProp->float_value +
+                                            tau*nextProp->float_value;
                                 pIt->second->setFloatValue(val);
                             }
                             break;
                         
                         case simgear::props::STRING:
                         case simgear::props::UNSPECIFIED:
-                            //cout << "Str: " << (*nextPropIt)->string_value << "\n";
-                            pIt->second->setStringValue((*nextPropIt)->string_value);
+                            //cout << "Str: " << mMotionInfo.stringValue(*nextProp) << "\n";
+                            pIt->second->setStringValue(mMotionInfo.stringValue(*nextProp));
                             break;
 
                         default:
                             // FIXME - currently defaults to float values
                             {
-                                float val = (1 - tau)*(*prevPropIt)->float_value +
-                                            tau*(*nextPropIt)->float_value;
+                                float val = (1 - tau)*prevProp->float_value +
+                                            tau*nextProp->float_value;
                                 pIt->second->setFloatValue(val);
                             }
                             break;
@@ -216,22 +210,22 @@ void FGAIMultiplayer::FGAIMultiplayerInterpolate(
                 }
                 else
                 {
-                    SG_LOG(SG_AI, SG_WARN, "MP packet mismatch during lag interpolation: " << (*prevPropIt)->id << " != " << (*nextPropIt)->id << "\n");
+                    SG_LOG(SG_AI, SG_WARN, "MP packet mismatch during lag interpolation: " << prevProp->id << " != " << nextProp->id << "\n");
                 }
             }
             else
             {
-                SG_LOG(SG_AI, SG_DEBUG, "Unable to find property: " << (*prevPropIt)->id << "\n");
+                SG_LOG(SG_AI, SG_DEBUG, "Unable to find property: " << prevProp->id << "\n");
             }
 
-            ++prevPropIt;
-            ++nextPropIt;
+            ++prevProp;
+            ++nextProp;
         }
     }
 }
 
 void FGAIMultiplayer::FGAIMultiplayerExtrapolate(
-        MotionInfo::iterator nextIt,
+        const FGAIMotionHistory::Sample& next,
         double tInterp,
         bool motion_logging,
         SGVec3d& ecPos,
@@ -239,12 +233,12 @@ void FGAIMultiplayer::FGAIMultiplayerExtrapolate(
         SGVec3f& ecLinearVel
         )
 {
-    const FGExternalMotionData& motionInfo = nextIt->second;
+    const FGAIMotionHistory::Sample& motionInfo = next;
 
     // The time to predict, limit to 3 seconds. But don't do this if we are
     // running motion tests, because it can mess up the results.
     //
-    double t = tInterp - nextIt->first;
+    double t = tInterp - next.key;
     if (!motion_logging)
     {
         props->setDoubleValue("lag/extrapolation-t", t);
@@ -291,49 +285,47 @@ void FGAIMultiplayer::FGAIMultiplayerExtrapolate(
         ecPos += t*(ecVel);
     }
 
-    std::vector<FGPropertyData*>::const_iterator firstPropIt;
-    std::vector<FGPropertyData*>::const_iterator firstPropItEnd;
     speed = norm(ecLinearVel) * SG_METER_TO_NM * 3600.0;
-    firstPropIt = motionInfo.properties.begin();
-    firstPropItEnd = motionInfo.properties.end();
-    while (firstPropIt != firstPropItEnd)
+    const FGAIMotionHistory::Property* firstProp = mMotionInfo.properties(motionInfo);
+    const FGAIMotionHistory::Property* firstPropEnd = firstProp + motionInfo.numProperties;
+    while (firstProp != firstPropEnd)
     {
-        PropertyMap::iterator pIt = mPropertyMap.find((*firstPropIt)->id);
-        //cout << " Setting property..." << (*firstPropIt)->id;
+        PropertyMap::iterator pIt = mPropertyMap.find(firstProp->id);
+        //cout << " Setting property..." << firstProp->id;
 
         if (pIt != mPropertyMap.end())
         {
-            switch ((*firstPropIt)->type)
+            switch (firstProp->type)
             {
               case simgear::props::INT:
               case simgear::props::BOOL:
               case simgear::props::LONG:
-                  pIt->second->setIntValue((*firstPropIt)->int_value);
-                  //cout << "Int: " << (*firstPropIt)->int_value << "\n";
+                  pIt->second->setIntValue(firstProp->int_value);
+                  //cout << "Int: " << firstProp->int_value << "\n";
                   break;
               case simgear::props::FLOAT:
               case simgear::props::DOUBLE:
-                  pIt->second->setFloatValue((*firstPropIt)->float_value);
-                  //cout << "Flo: " << (*firstPropIt)->float_value << "\n";
+                  pIt->second->setFloatValue(firstProp->float_value);
+                  //cout << "Flo: " << firstProp->float_value << "\n";
                   break;
               case simgear::props::STRING:
               case simgear::props::UNSPECIFIED:
-                  pIt->second->setStringValue((*firstPropIt)->string_value);
-                  //cout << "Str: " << (*firstPropIt)->string_value << "\n";
+                  pIt->second->setStringValue(mMotionInfo.stringValue(*firstProp));
+                  //cout << "Str: " << mMotionInfo.stringValue(*firstProp) << "\n";
                   break;
               default:
                   // FIXME - currently defaults to float values
-                  pIt->second->setFloatValue((*firstPropIt)->float_value);
-                  //cout << "Unk: " << (*firstPropIt)->float_value << "\n";
+                  pIt->second->setFloatValue(firstProp->float_value);
+                  //cout << "Unk: " << firstProp->float_value << "\n";
                   break;
             }
         }
         else
         {
-            SG_LOG(SG_AI, SG_DEBUG, "Unable to find property: " << (*firstPropIt)->id << "\n");
+            SG_LOG(SG_AI, SG_DEBUG, "Unable to find property: " << firstProp->id << "\n");
         }
 
-        ++firstPropIt;
+        ++firstProp;
     }
 }
 
@@ -462,8 +454,8 @@ void FGAIMultiplayer::update(double dt)
     else
     {
         // Get the last available time
-        MotionInfo::reverse_iterator motioninfo_back = mMotionInfo.rbegin();
-        const double curentPkgTime = motioninfo_back->first;
+        const FGAIMotionHistory::Sample& motioninfo_back = mMotionInfo.back();
+        const double curentPkgTime = motioninfo_back.key;
 
         // The current simulation time we need to update for,
         // note that the simulation time is updated before calling all the
@@ -480,7 +472,7 @@ void FGAIMultiplayer::update(double dt)
         // component will provide this. We just take the error of the currently
         // requested time to the most recent available packet. This is the
         // target we want to reach in average.
-        double lag = motioninfo_back->second.lag;
+        double lag = motioninfo_back.lag;
 
         rawLag = curentPkgTime - curtime;
         realTime = false; //default behaviour
@@ -589,7 +581,7 @@ void FGAIMultiplayer::update(double dt)
                     SG_LOG(SG_AI, SG_DEBUG, "Offset adjust system: time offset = "
                          << mTimeOffset << ", expected longitudinal position error due to "
                          " current adjustment of the offset: "
-                         << fabs(norm(motioninfo_back->second.linearVel)*systemIncrement));
+                         << fabs(norm(motioninfo_back.linearVel)*systemIncrement));
                 }
             }
         }
@@ -603,27 +595,27 @@ void FGAIMultiplayer::update(double dt)
     SGQuatf ecOrient;
     SGVec3f ecLinearVel;
 
-    MotionInfo::iterator nextIt = mMotionInfo.upper_bound(tInterp);
-    MotionInfo::iterator prevIt = nextIt;
+    size_t next = mMotionInfo.upperBound(tInterp);
+    size_t prev = next;
     
-    if (nextIt != mMotionInfo.end() && nextIt->first >= tInterp)
+    if (next != mMotionInfo.size() && mMotionInfo[next].key >= tInterp)
     {
         // Ok, we need a time prevous to the last available packet,
         // that is good ...
         // the case tInterp = curentPkgTime need to be in the interpolation, to avoid a bug zeroing the position
 
         double tau = 0;
-        if (nextIt == mMotionInfo.begin())
+        if (next == 0)
         {
-            // Leave prevIt and nextIt pointing at same item.
+            // Leave prev and next pointing at same item.
             SG_LOG(SG_GENERAL, SG_DEBUG, "Only one frame for interpolation: " << _callsign);
         }
         else
         {
-            --prevIt;
+            --prev;
             // Interpolation coefficient is between 0 and 1
-            double intervalStart = prevIt->first;
-            double intervalEnd = nextIt->first;
+            double intervalStart = mMotionInfo[prev].key;
+            double intervalEnd = mMotionInfo[next].key;
 
             double intervalLen = intervalEnd - intervalStart;
             if (intervalLen != 0.0)
@@ -632,21 +624,21 @@ void FGAIMultiplayer::update(double dt)
             }
         }
         
-        FGAIMultiplayerInterpolate(prevIt, nextIt, tau, ecPos, ecOrient, ecLinearVel);
+        FGAIMultiplayerInterpolate(mMotionInfo[prev], mMotionInfo[next], tau, ecPos, ecOrient, ecLinearVel);
     }
     else
     {
         // Ok, we need to predict the future, so, take the best data we can have
         // and do some eom computation to guess that for now.
-        --nextIt;
-        --prevIt;   // so mMotionInfo.erase() does the right thing below.
-        FGAIMultiplayerExtrapolate(nextIt, tInterp, motion_logging, ecPos, ecOrient, ecLinearVel);
+        --next;
+        --prev;   // so mMotionInfo.eraseFront() does the right thing below.
+        FGAIMultiplayerExtrapolate(mMotionInfo[next], tInterp, motion_logging, ecPos, ecOrient, ecLinearVel);
     }
 
-    // Remove any motion information before <prevIt> - we will not need this in
+    // Remove any motion information before <prev> - we will not need this in
     // the future.
     //
-    mMotionInfo.erase(mMotionInfo.begin(), prevIt);
+    mMotionInfo.eraseFront(prev);
     
     // extract the position
     pos = SGGeod::fromCart(ecPos);
@@ -823,8 +815,8 @@ FGAIMultiplayer::addMotionInfo(FGExternalMotionData& motionInfo,
             // We need a time that can be consistently compared with our UTC
             // tInterp. So we set m_time_compensation to something to be
             // added to all times received in MP packets from _callsign. We
-            // use compensated time for keys in the the mMotionInfo[]
-            // map, thus code should generally use these key values, not
+            // use compensated time for the keys of the mMotionInfo[]
+            // samples, thus code should generally use these key values, not
             // mMotionInfo[].time.
             //
             m_simple_time_compensation = -m_simple_time_offset_smoothed;
@@ -863,20 +855,15 @@ FGAIMultiplayer::addMotionInfo(FGExternalMotionData& motionInfo,
         // m_time_compensation is set to non-zero if packets seem to have
         // wildly different times from us, if simple-time mode is enabled.
         //
-        // So most code with an <iterator> into mMotionInfo that needs to
-        // use the MP packet's time, will actuall use iterator->first, not
-        // iterator->second.time..
+        // So most code with a sample of mMotionInfo that needs to use the MP
+        // packet's time, will actually use sample.key, not sample.time.
         //
-        mMotionInfo[t_key] = motionInfo;
+        mMotionInfo.add(t_key, motionInfo);
     }
     else
     {
-        mMotionInfo[motionInfo.time] = motionInfo;
+        mMotionInfo.add(motionInfo.time, motionInfo);
     }
-
-    // We just copied the property (pointer) list - they are ours now. Clear the
-    // properties list in given/returned object, so former owner won't deallocate them.
-    motionInfo.properties.clear();
   
     {
         // Gather data on multiplayer speed, used by scripts/python/recordreplay.py.
@@ -27,6 +27,7 @@
 #include <MultiPlayer/mpmessages.hxx>
 
 #include "AIBase.hxx"
+#include "AIMotionHistory.hxx"
 
 class FGAIMultiplayer : public FGAIBase {
 public:
@@ -106,8 +107,7 @@ public:
 private:
 
   // Automatic sorting of motion data according to its timestamp
-  typedef std::map<double,FGExternalMotionData> MotionInfo;
-  MotionInfo mMotionInfo;
+  FGAIMotionHistory mMotionInfo;
 
   // Map between the property id's from the multiplayers network packets
   // and the property nodes
@@ -115,14 +115,14 @@ private:
   PropertyMap mPropertyMap;
   
   // Calculates position, orientation and velocity using interpolation between
-  // *prevIt and *nextIt, specifically (1-tau)*(*prevIt) + tau*(*nextIt).
+  // prev and next, specifically (1-tau)*prev + tau*next.
   //
   // Cannot call this method 'interpolate' because that would hide the name in
   // OSG.
   //
   void FGAIMultiplayerInterpolate(
-        MotionInfo::iterator prevIt,
-        MotionInfo::iterator nextIt,
+        const FGAIMotionHistory::Sample& prev,
+        const FGAIMotionHistory::Sample& next,
         double tau,
         SGVec3d& ecPos,
         SGQuatf& ecOrient,
@@ -130,10 +130,10 @@ private:
         );
 
   // Calculates position, orientation and velocity using extrapolation from
-  // *nextIt.
+  // next.
   //
   void FGAIMultiplayerExtrapolate(
-        MotionInfo::iterator nextIt,
+        const FGAIMotionHistory::Sample& next,
         double tInterp,
         bool motion_logging,
         SGVec3d& ecPos,
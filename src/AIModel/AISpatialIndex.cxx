@@ -0,0 +1,137 @@
+// AISpatialIndex - uniform ECEF grid for AI object proximity queries
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "AISpatialIndex.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+// cell coordinates are biased into 21 bits per axis; with 5km cells this
+// covers several times the earth radius
+static const int CELL_BIAS = 1 << 20;
+static const uint64_t CELL_MASK = (1 << 21) - 1;
+
+AISpatialIndex::AISpatialIndex(double cellSizeM) :
+    _cellSizeM(cellSizeM)
+{
+}
+
+void AISpatialIndex::clear()
+{
+    _entries.clear();
+    // keep the bucket vectors around, the same cells tend to be re-used
+    // every frame
+    for (auto& cell : _cells) {
+        cell.second.clear();
+    }
+}
+
+int AISpatialIndex::cellCoord(double v) const
+{
+    return static_cast<int>(std::floor(v / _cellSizeM));
+}
+
+AISpatialIndex::CellKey AISpatialIndex::makeKey(int x, int y, int z)
+{
+    return ((static_cast<uint64_t>(x + CELL_BIAS) & CELL_MASK) << 42) |
+           ((static_cast<uint64_t>(y + CELL_BIAS) & CELL_MASK) << 21) |
+           (static_cast<uint64_t>(z + CELL_BIAS) & CELL_MASK);
+}
+
+void AISpatialIndex::insert(FGAIBase* object, const SGVec3d& cartPos)
+{
+    const size_t index = _entries.size();
+    _entries.push_back({object, cartPos});
+
+    const CellKey key = makeKey(cellCoord(cartPos.x()),
+                                cellCoord(cartPos.y()),
+                                cellCoord(cartPos.z()));
+    _cells[key].push_back(index);
+}
+
+void AISpatialIndex::collectIndices(const SGVec3d& cartPos, double rangeM,
+                                    std::vector<size_t>& indices) const
+{
+    const double rangeSqr = rangeM * rangeM;
+    const int x0 = cellCoord(cartPos.x() - rangeM), x1 = cellCoord(cartPos.x() + rangeM);
+    const int y0 = cellCoord(cartPos.y() - rangeM), y1 = cellCoord(cartPos.y() + rangeM);
+    const int z0 = cellCoord(cartPos.z() - rangeM), z1 = cellCoord(cartPos.z() + rangeM);
+    const double cellCount = static_cast<double>(x1 - x0 + 1) *
+                             (y1 - y0 + 1) * (z1 - z0 + 1);
+
+    if (cellCount >= _entries.size()) {
+        // large query relative to the population: probing the cells would
+        // cost more than simply testing every object
+        for (size_t i = 0; i < _entries.size(); ++i) {
+            if (distSqr(cartPos, _entries[i].cartPos) <= rangeSqr) {
+                indices.push_back(i);
+            }
+        }
+
+        return;
+    }
+
+    for (int x = x0; x <= x1; ++x) {
+        for (int y = y0; y <= y1; ++y) {
+            for (int z = z0; z <= z1; ++z) {
+                auto it = _cells.find(makeKey(x, y, z));
+                if (it == _cells.end()) {
+                    continue;
+                }
+
+                for (size_t i : it->second) {
+                    if (distSqr(cartPos, _entries[i].cartPos) <= rangeSqr) {
+                        indices.push_back(i);
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort(indices.begin(), indices.end());
+}
+
+void AISpatialIndex::findWithinRange(const SGVec3d& cartPos, double rangeM,
+                                     std::vector<FGAIBase*>& result) const
+{
+    std::vector<size_t> indices;
+    collectIndices(cartPos, rangeM, indices);
+    for (size_t i : indices) {
+        result.push_back(_entries[i].object);
+    }
+}
+
+std::vector<FGAIBase*> AISpatialIndex::findNearest(const SGVec3d& cartPos, size_t count,
+                                                   double maxRangeM) const
+{
+    std::vector<size_t> indices;
+    collectIndices(cartPos, maxRangeM, indices);
+
+    const size_t n = std::min(count, indices.size());
+    std::partial_sort(indices.begin(), indices.begin() + n, indices.end(),
+                      [this, &cartPos](size_t a, size_t b) {
+                          return distSqr(cartPos, _entries[a].cartPos) <
+                                 distSqr(cartPos, _entries[b].cartPos);
+                      });
+
+    std::vector<FGAIBase*> result;
+    result.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        result.push_back(_entries[indices[i]].object);
+    }
+
+    return result;
+}
@@ -0,0 +1,76 @@
+// AISpatialIndex - uniform ECEF grid for AI object proximity queries
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <simgear/math/SGVec3.hxx>
+
+class FGAIBase;
+
+/**
+ * @brief Hashed uniform grid over cartesian (ECEF) positions.
+ *
+ * The AI manager rebuilds this once per frame; in between, queries are
+ * answered from the positions captured at rebuild time. Query results
+ * are returned in insertion order, so callers that relied on the order
+ * of the AI list keep seeing the same ordering.
+ */
+class AISpatialIndex
+{
+public:
+    explicit AISpatialIndex(double cellSizeM = 5000.0);
+
+    void clear();
+
+    void insert(FGAIBase* object, const SGVec3d& cartPos);
+
+    size_t size() const
+    { return _entries.size(); }
+
+    /**
+     * @brief append all objects within rangeM of cartPos to result
+     */
+    void findWithinRange(const SGVec3d& cartPos, double rangeM,
+                         std::vector<FGAIBase*>& result) const;
+
+    /**
+     * @brief up to count objects within maxRangeM of cartPos, nearest first
+     */
+    std::vector<FGAIBase*> findNearest(const SGVec3d& cartPos, size_t count,
+                                       double maxRangeM) const;
+
+private:
+    struct Entry {
+        FGAIBase* object;
+        SGVec3d cartPos;
+    };
+
+    using CellKey = uint64_t;
+
+    int cellCoord(double v) const;
+    static CellKey makeKey(int x, int y, int z);
+
+    void collectIndices(const SGVec3d& cartPos, double rangeM,
+                        std::vector<size_t>& indices) const;
+
+    double _cellSizeM;
+    std::vector<Entry> _entries;
+    std::unordered_map<CellKey, std::vector<size_t>> _cells;
+};
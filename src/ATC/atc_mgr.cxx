@@ -28,6 +28,7 @@
 #include <Airports/airportdynamicsmanager.hxx>
 #include <Airports/airport.hxx>
 #include <Scenery/scenery.hxx>
+#include <Main/FrameProfiler.hxx>
 #include <Main/globals.hxx>
 #include <Main/fg_props.hxx>
 #include <AIModel/AIAircraft.hxx>
@@ -300,6 +301,7 @@ update its state.
 update.  On first update, delta time will be 0.
 */
 void FGATCManager::update ( double time ) {
+    FG_PROFILE_SCOPE("subsystems/ATC");
     // SG_LOG(SG_ATC, SG_BULK, "ATC update code is running at time: " << time);
 
     // Test code: let my virtual co-pilot handle ATC
@@ -1,6 +1,7 @@
 #include "continuous.hxx"
 
 #include <Aircraft/flightrecorder.hxx>
+#include <Main/SPSCQueue.hxx>
 #include <Main/fg_props.hxx>
 #include <MultiPlayer/mpmessages.hxx>
 #include <Viewer/FGEventHandler.hxx>
@@ -16,6 +17,11 @@
 #include <assert.h>
 #include <string.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <sstream>
+
 
 Continuous::Continuous(std::shared_ptr<FGFlightRecorder> flight_recorder)
 :
@@ -27,6 +33,11 @@ m_flight_recorder(flight_recorder)
     fdm_initialized->addChangeListener(this, true /*initial*/);
 }
 
+Continuous::~Continuous()
+{
+    continuousStopWriter(*this);
+}
+
 // Reads binary data from a stream into an instance of a type.
 template<typename T>
 static void readRaw(std::istream& in, T& data)
@@ -480,42 +491,31 @@ static void writeFrame2(FGReplayData* r, std::ostream& out, SGPropertyNode_ptr c
     
 }
 
-bool continuousWriteFrame(
-        Continuous& continuous,
-        FGReplayData* r,
-        std::ostream& out,
-        SGPropertyNode_ptr config,
-        FGTapeType tape_type
-        )
+/* Sets bits in <flags> for the kinds of data in <r> that <config> says are
+to be recorded: 1 for signals, 2 for multiplayer, 4 for extra properties.
+Returns false if there is nothing to write. */
+static bool frameFlags(FGReplayData* r, SGPropertyNode_ptr config, uint8_t& flags)
 {
-    SG_LOG(SG_SYSTEMS, SG_BULK, "writing frame."
-            << " out.tellp()=" << out.tellp()
-            << " r->sim_time=" << r->sim_time
-            );
-    // Don't write frame if no data to write.
-    //bool r_has_data = false;
-    bool has_signals = false;
-    bool has_multiplayer = false;
-    bool has_extra_properties = false;
+    flags = 0;
     for (auto data: config->getChildren("data"))
     {
         std::string data_type = data->getStringValue();
         if (data_type == "signals")
         {
-            has_signals = true;
+            flags |= 1;
         }
         else if (data_type == "multiplayer")
         {
             if (!r->multiplayer_messages.empty())
             {
-                has_multiplayer = true;
+                flags |= 2;
             }
         }
         else if (data_type == "extra-properties")
         {
             if (!r->extra_properties.empty())
             {
-                has_extra_properties = true;
+                flags |= 4;
             }
         }
         else
@@ -524,7 +524,40 @@ bool continuousWriteFrame(
             assert(0);
         }
     }
-    if (!has_signals && !has_multiplayer && !has_extra_properties)
+    return flags != 0;
+}
+
+/* Writes the data for a frame of compressed Continuous recording, given the
+output of writeFrame2() in <data>. Same format as continuousWriteFrame(). */
+static void writeCompressedFrame(std::ostream& out, uint8_t flags, const char* data, size_t size)
+{
+    out.write((char*) &flags, sizeof(flags));
+    
+    std::ostringstream  compressed;
+    compression_ostream out_compressing(compressed, 1024, 1024);
+    out_compressing.write(data, size);
+    out_compressing.flush();
+    
+    uint32_t compressed_size = compressed.str().size();
+    out.write((char*) &compressed_size, sizeof(compressed_size));
+    out.write((char*) compressed.str().c_str(), compressed.str().size());
+}
+
+bool continuousWriteFrame(
+        Continuous& continuous,
+        FGReplayData* r,
+        std::ostream& out,
+        SGPropertyNode_ptr config,
+        FGTapeType tape_type
+        )
+{
+    SG_LOG(SG_SYSTEMS, SG_BULK, "writing frame."
+            << " out.tellp()=" << out.tellp()
+            << " r->sim_time=" << r->sim_time
+            );
+    // Don't write frame if no data to write.
+    uint8_t flags;
+    if (!frameFlags(r, config, flags))
     {
         SG_LOG(SG_SYSTEMS, SG_DEBUG, "Not writing frame because no data to write");
         return true;
@@ -534,10 +567,6 @@ bool continuousWriteFrame(
     
     if (tape_type == FGTapeType_CONTINUOUS && continuous.m_out_compression)
     {
-        uint8_t flags = 0;
-        if (has_signals)            flags |= 1;
-        if (has_multiplayer)        flags |= 2;
-        if (has_extra_properties)   flags |= 4;
         out.write((char*) &flags, sizeof(flags));
         
         /* We need to first write the size of the compressed data so compress
@@ -560,6 +589,229 @@ bool continuousWriteFrame(
     return ok;
 }
 
+
+// streambuf that appends to a std::vector<char>.
+struct vector_streambuf : std::streambuf
+{
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        out->insert(out->end(), s, s + n);
+        return n;
+    }
+    
+    int overflow(int c) override
+    {
+        if (c != EOF) out->push_back((char) c);
+        return c;
+    }
+    
+    std::vector<char>*  out = nullptr;
+};
+
+
+/* A frame serialised by writeFrame2(), waiting to be written. */
+struct ContinuousFrame
+{
+    double              sim_time = 0;
+    uint8_t             flags = 0;
+    std::vector<char>   data;
+};
+
+
+struct ContinuousWriter
+{
+    ContinuousWriter(std::ostream& out, int compression, size_t queue_frames)
+    :
+    m_out(out),
+    m_compression(compression),
+    m_queue(queue_frames),
+    m_free(queue_frames),
+    m_stream(&m_streambuf),
+    m_prop_queued(fgGetNode("/sim/replay/continuous-writer/queued-frames", true)),
+    m_prop_queued_max(fgGetNode("/sim/replay/continuous-writer/queued-frames-max", true)),
+    m_prop_written(fgGetNode("/sim/replay/continuous-writer/written-frames", true)),
+    m_prop_dropped(fgGetNode("/sim/replay/continuous-writer/dropped-frames", true)),
+    m_prop_stalls(fgGetNode("/sim/replay/continuous-writer/stalls", true))
+    {
+        m_prop_queued->setIntValue(0);
+        m_prop_queued_max->setIntValue(0);
+        m_prop_written->setIntValue(0);
+        m_prop_dropped->setIntValue(0);
+        m_prop_stalls->setIntValue(0);
+        m_thread = std::thread([this] { run(); });
+    }
+    
+    // Writes all queued frames, then stops the thread.
+    ~ContinuousWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_wake_lock);
+            m_stop = true;
+        }
+        m_wake.notify_one();
+        m_thread.join();
+        updateStats();
+    }
+    
+    /* Called from the main thread; serialises <r> and queues it. */
+    bool record(FGReplayData* r, SGPropertyNode_ptr config)
+    {
+        if (m_failed)
+        {
+            return false;
+        }
+        
+        ContinuousFrame frame;
+        if (!frameFlags(r, config, frame.flags))
+        {
+            return true;
+        }
+        frame.sim_time = r->sim_time;
+        
+        // Reuse a buffer that the writer thread has finished with, so in the
+        // steady state we don't allocate.
+        m_free.pop(frame.data);
+        frame.data.clear();
+        m_streambuf.out = &frame.data;
+        writeFrame2(r, m_stream, config);
+        m_streambuf.out = nullptr;
+        
+        if (!m_queue.push(frame))
+        {
+            if (frame.flags == 1)
+            {
+                // Only signals, so replay can interpolate over the gap.
+                m_frames_dropped += 1;
+            }
+            else
+            {
+                m_stalls += 1;
+                while (!m_queue.push(frame) && !m_failed)
+                {
+                    m_wake.notify_one();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        }
+        m_wake.notify_one();
+        updateStats();
+        return !m_failed;
+    }
+    
+    void updateStats()
+    {
+        size_t queued = m_queue.size();
+        m_queued_max = std::max(m_queued_max, queued);
+        m_prop_queued->setIntValue(queued);
+        m_prop_queued_max->setIntValue(m_queued_max);
+        m_prop_written->setLongValue(m_frames_written);
+        m_prop_dropped->setLongValue(m_frames_dropped);
+        m_prop_stalls->setLongValue(m_stalls);
+    }
+    
+    void run()
+    {
+        ContinuousFrame frame;
+        for(;;)
+        {
+            if (!m_queue.pop(frame))
+            {
+                if (m_stop)
+                {
+                    // The main thread doesn't push after setting m_stop, so
+                    // if this fails we are done.
+                    if (!m_queue.pop(frame)) break;
+                }
+                else
+                {
+                    std::unique_lock<std::mutex> lock(m_wake_lock);
+                    m_wake.wait_for(lock, std::chrono::milliseconds(20), [this]
+                    {
+                        return m_stop || m_queue.size();
+                    });
+                    continue;
+                }
+            }
+            
+            writeRaw(m_out, frame.sim_time);
+            if (m_compression)
+            {
+                writeCompressedFrame(m_out, frame.flags, frame.data.data(), frame.data.size());
+            }
+            else
+            {
+                m_out.write(frame.data.data(), frame.data.size());
+            }
+            if (!m_out)
+            {
+                SG_LOG(SG_SYSTEMS, SG_ALERT, "Failed to write continuous recording frame");
+                m_failed = true;
+            }
+            m_frames_written += 1;
+            
+            // Give the buffer back to the main thread; if its queue is full
+            // the buffer is simply freed.
+            m_free.push(frame.data);
+        }
+        m_out.flush();
+    }
+    
+    std::ostream&       m_out;
+    int                 m_compression;
+    
+    flightgear::SPSCQueue<ContinuousFrame>      m_queue;    // Main thread to writer.
+    flightgear::SPSCQueue<std::vector<char>>    m_free;     // Writer to main thread.
+    
+    std::thread                 m_thread;
+    std::mutex                  m_wake_lock;
+    std::condition_variable     m_wake;
+    std::atomic<bool>           m_stop{false};
+    std::atomic<bool>           m_failed{false};
+    std::atomic<uint64_t>       m_frames_written{0};
+    
+    // Only used by main thread.
+    vector_streambuf    m_streambuf;
+    std::ostream        m_stream;
+    uint64_t            m_frames_dropped = 0;
+    uint64_t            m_stalls = 0;
+    size_t              m_queued_max = 0;
+    SGPropertyNode_ptr  m_prop_queued;
+    SGPropertyNode_ptr  m_prop_queued_max;
+    SGPropertyNode_ptr  m_prop_written;
+    SGPropertyNode_ptr  m_prop_dropped;
+    SGPropertyNode_ptr  m_prop_stalls;
+};
+
+bool continuousRecordFrame(Continuous& continuous, FGReplayData* r)
+{
+    if (continuous.m_out_writer)
+    {
+        return continuous.m_out_writer->record(r, continuous.m_out_config);
+    }
+    return continuousWriteFrame(
+            continuous,
+            r,
+            continuous.m_out,
+            continuous.m_out_config,
+            FGTapeType_CONTINUOUS
+            );
+}
+
+void continuousStartWriter(Continuous& continuous, size_t queue_frames)
+{
+    continuousStopWriter(continuous);
+    continuous.m_out_writer.reset(new ContinuousWriter(
+            continuous.m_out,
+            continuous.m_out_compression,
+            std::max(queue_frames, (size_t) 1)
+            ));
+}
+
+void continuousStopWriter(Continuous& continuous)
+{
+    continuous.m_out_writer.reset();
+}
+
 SGPropertyNode_ptr continuousWriteHeader(
         Continuous&         continuous,
         FGFlightRecorder*   flight_recorder,
@@ -938,6 +1190,7 @@ void Continuous::valueChanged(SGPropertyNode * node)
     {
         // Stop existing continuous recording.
         SG_LOG(SG_SYSTEMS, SG_ALERT, "Stopping continuous recording");
+        continuousStopWriter(*this);
         m_out.close();
         popupTip("Continuous record to file stopped", 5 /*delay*/);
     }
@@ -963,6 +1216,13 @@ void Continuous::valueChanged(SGPropertyNode * node)
         
         SG_LOG(SG_SYSTEMS, SG_ALERT, "Starting continuous recording");
         
+        if (fgGetBool("/sim/replay/record-continuous-writer-thread", true))
+        {
+            // Compression and disc writes happen on a separate thread, so
+            // they don't cause frame rate hitches.
+            continuousStartWriter(*this, fgGetInt("/sim/replay/record-continuous-queue-frames", 256));
+        }
+        
         /* Make a convenience link to the recording. E.g.
         harrier-gr3-continuous.fgtape -> harrier-gr3-20201224-005034-continuous.fgtape.
         
@@ -6,6 +6,7 @@
 
 #include <fstream>
 
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -13,6 +14,7 @@
 struct Continuous : SGPropertyChangeListener
 {
     Continuous(std::shared_ptr<FGFlightRecorder> flight_recorder);
+    ~Continuous();
     
     /* Callback for SGPropertyChangeListener. */
     void valueChanged(SGPropertyNode * node) override;
@@ -48,6 +50,10 @@ struct Continuous : SGPropertyChangeListener
     std::ofstream       m_out;
     int                 m_out_compression = 0;
     int                 m_in_compression = 0;
+    
+    // If set, frames passed to continuousRecordFrame() are compressed and
+    // written to m_out by a background thread.
+    std::unique_ptr<struct ContinuousWriter>    m_out_writer;
 };
 
 /* Attempts to load Continuous recording header properties into
@@ -67,6 +73,26 @@ bool continuousWriteFrame(
         FGTapeType tape_type
         );
 
+/* Records one frame to the Continuous recording in continuous.m_out.
+
+If the writer thread is running, the frame is serialised and queued for it;
+compression and file I/O happen on that thread. If the queue is full, frames
+containing only signals are dropped, while frames with multiplayer or extra
+property data wait for space, because later frames depend on them. Statistics
+are in /sim/replay/continuous-writer/.
+
+Otherwise this is the same as continuousWriteFrame(). */
+bool continuousRecordFrame(Continuous& continuous, FGReplayData* r);
+
+/* Starts a thread which writes frames passed to continuousRecordFrame() to
+continuous.m_out, which must already contain the header. <queue_frames> is the
+maximum number of frames waiting to be written. */
+void continuousStartWriter(Continuous& continuous, size_t queue_frames);
+
+/* Waits for all queued frames to be written, then stops the writer thread, if
+any. */
+void continuousStopWriter(Continuous& continuous);
+
 /* Opens continuous recording file and writes header.
 
 If MetaData is unset, we initialise it by calling saveSetup(). Otherwise should
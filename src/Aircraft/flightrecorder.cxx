@@ -231,6 +231,7 @@ FGFlightRecorder::FGFlightRecorder(const char* pConfigName) :
     m_RecordContinuous          (fgGetNode("/sim/replay/record-continuous", true)),
     m_RecordExtraProperties     (fgGetNode("/sim/replay/record-extra-properties", true)),
     m_LogRawSpeed               (fgGetNode("/sim/replay/log-raw-speed", true)),
+    m_ReplayState               (fgGetNode("/sim/replay/replay-state", true)),
     m_TotalRecordSize(0),
     m_ConfigName(pConfigName),
     m_usingDefaultConfig(false),
@@ -309,7 +310,11 @@ FGFlightRecorder::reinit(SGPropertyNode_ptr ConfigNode)
     // expose size of actual flight recorder record
     m_RecorderNode->setIntValue("record-size", m_TotalRecordSize);
     SG_LOG(SG_SYSTEMS, SG_INFO, "FlightRecorder: record size is " << m_TotalRecordSize << " bytes");
-    
+
+    // the layout has changed, so any live data we kept is meaningless now
+    m_RecentRawData.clear();
+    m_RecentRawData.reserve(m_TotalRecordSize);
+
     s_record_extra_properties.reset(new RecordExtraProperties);
 }
 
@@ -513,28 +518,22 @@ FGFlightRecorder::capture(double SimTime, FGReplayData* ReplayData)
         ReplayData = new FGReplayData;
         if (!ReplayData)
             return NULL;
+        ReplayData->raw_data.reserve(m_TotalRecordSize);
     }
     
-    // When replaying, we are able to carry recording live multiplayer
-    // information. To make this work we need to record a stationay
-    // user aircraft, with information from the last live user aircraft
-    // FGReplayData. So we store the last live user aircraft information in
-    // this static vector.
-    //
-    static std::vector<char>    s_recent_raw_data;
-    
-    int in_replay = fgGetInt("/sim/replay/replay-state");
+    int in_replay = m_ReplayState->getIntValue();
     
     ReplayData->sim_time = SimTime;
     
-    if (in_replay && !s_recent_raw_data.empty()) {
+    if (in_replay && !m_RecentRawData.empty()) {
         // Record the fixed position of live user aircraft at the point at
         // which we started replay.
         //
-        ReplayData->raw_data = s_recent_raw_data;
+        ReplayData->raw_data = m_RecentRawData;
     }
     else {
-        // Find live information about the user aircraft.
+        // Find live information about the user aircraft. Recycled buffers
+        // already have the capacity, so the resize doesn't allocate.
         //
         int Offset = 0;
         ReplayData->raw_data.resize( m_TotalRecordSize);
@@ -615,10 +614,11 @@ FGFlightRecorder::capture(double SimTime, FGReplayData* ReplayData)
 
         assert(Offset + sizeof(double) == m_TotalRecordSize);
 
-        // Update s_recent_raw_data so that we will be able to carry recording
-        // while replaying.
+        // Update m_RecentRawData so that we will be able to carry recording
+        // while replaying. Both vectors have the same size, so this is a
+        // plain copy.
         //
-        s_recent_raw_data = ReplayData->raw_data;
+        m_RecentRawData = ReplayData->raw_data;
     }
     
     // If m_ReplayMultiplayer is true, move all recent
@@ -96,6 +96,7 @@ private:
     SGPropertyNode_ptr m_RecordExtraProperties;
     
     SGPropertyNode_ptr m_LogRawSpeed;
+    SGPropertyNode_ptr m_ReplayState;
     
     // This contains copy of all properties that we are recording, so that we
     // can send only differences.
@@ -109,6 +110,12 @@ private:
     FlightRecorder::TSignalList m_CaptureInt8;
     FlightRecorder::TSignalList m_CaptureBool;
 
+    // When replaying, we are able to carry recording live multiplayer
+    // information. To make this work we need to record a stationary
+    // user aircraft, with information from the last live user aircraft
+    // FGReplayData, which we keep here.
+    std::vector<char> m_RecentRawData;
+
     unsigned m_TotalRecordSize;
     std::string m_ConfigName;
     bool m_usingDefaultConfig;
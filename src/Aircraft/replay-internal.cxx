@@ -25,6 +25,7 @@
 #include "continuous.hxx"
 #include "flightrecorder.hxx"
 #include "replay.hxx"
+#include "replay-store.hxx"
 
 #include <Main/fg_props.hxx>
 #include <MultiPlayer/mpmessages.hxx>
@@ -156,6 +157,8 @@ FGReplayInternal::FGReplayInternal()
     m_low_res_time(3600.0),
     m_medium_sample_rate(0.5), // medium term sample rate (sec)
     m_long_sample_rate(5.0),   // long term sample rate (sec)
+    m_compressed(false),
+    m_compressed_store(new FGReplayFrameStore),
     m_flight_recorder(new FGFlightRecorder("replay-config")),
     m_continuous(new Continuous(m_flight_recorder)),
     m_MultiplayMgr(globals->get_subsystem<FGMultiplayMgr>())
@@ -250,6 +253,7 @@ static void clear(FGReplayInternal& self)
         delete self.m_recycler.front();
         self.m_recycler.pop_front();
     }
+    self.m_compressed_store->clear();
 
     // clear messages belonging to old replay session
     fgGetNode("/sim/replay/messages", 0, true)->removeChildren("msg");
@@ -260,6 +264,7 @@ FGReplayInternal::~FGReplayInternal()
 {
     if (m_continuous->m_out.is_open())
     {
+        continuousStopWriter(*m_continuous);
         m_continuous->m_out.close();
     }
     clear(*this);
@@ -352,6 +357,13 @@ FGReplayInternal::reinit()
     m_medium_sample_rate = fgGetDouble("/sim/replay/buffer/medium-res-sample-dt", 0.5); // medium term sample rate (sec)
     m_long_sample_rate   = fgGetDouble("/sim/replay/buffer/low-res-sample-dt",    5.0); // long term sample rate (sec)
 
+    // full rate compressed storage instead of medium and long term lists
+    m_compressed = fgGetBool("/sim/replay/buffer/compressed", false);
+    m_compressed_store->configure(
+            fgGetInt("/sim/replay/buffer/compressed-keyframe-interval", 64),
+            fgGetDouble("/sim/replay/buffer/compressed-max-mbyte", 256.0) * 1024 * 1024
+            );
+
     fillRecycler(*this);
     loadMessages(*this);
 
@@ -437,6 +449,7 @@ double get_start_time(FGReplayInternal& self)
     
     if (!self.m_long_term.empty())          ret = self.m_long_term.front()->sim_time;
     else if (!self.m_medium_term.empty())   ret = self.m_medium_term.front()->sim_time;
+    else if (!self.m_compressed_store->empty()) ret = self.m_compressed_store->front_time();
     else if (!self.m_short_term.empty())    ret = self.m_short_term.front()->sim_time;
     else                                    ret = 0.0;
     fgSetDouble("/sim/replay/start-time", ret);
@@ -489,7 +502,7 @@ FGReplayInternal::start(bool new_tape)
 
     unsigned long buffer_elements =  m_short_term.size()+m_medium_term.size()+m_long_term.size();
     fgSetDouble("/sim/replay/buffer-size-mbyte",
-                buffer_elements*m_flight_recorder->getRecordSize() / (1024*1024.0));
+                (buffer_elements*m_flight_recorder->getRecordSize() + m_compressed_store->bytes()) / (1024*1024.0));
     if ( fgGetBool("/sim/freeze/master") || !m_replay_master->getIntValue())
     {
         guiMessage("Replay active. 'Esc' to stop.");
@@ -572,17 +585,19 @@ static void MoveFrontMultiplayerPackets(std::deque<FGReplayData*>& list)
 }
 
 
-/** Save raw replay data in a separate container */
+/** Save raw replay data in a separate container. <for_each> is called with a
+ * callback taking a const FGReplayData&, which it must call for each of the
+ * <count> records in turn, stopping if the callback returns false.
+ */
+template<class ForEach>
 static bool saveRawReplayData(
         simgear::gzContainerWriter& output,
-        const std::deque<FGReplayData*>& replay_data,
+        size_t count,
+        const ForEach& for_each,
         size_t record_size,
         SGPropertyNode* meta
         )
 {
-    // get number of records in this stream
-    size_t count = replay_data.size();
-
     // write container header for raw data
     if (!output.writeContainerHeader(ReplayContainer::RawData, count * record_size))
     {
@@ -592,38 +607,44 @@ static bool saveRawReplayData(
         return false;
     }
 
-    // read the raw data (all records in the given list)
-    auto it = replay_data.begin();
+    bool multiplayer = false;
+    for (auto data: meta->getNode("meta")->getChildren("data"))
+    {
+        SG_LOG(SG_SYSTEMS, SG_DEBUG, "data->getStringValue()=" << data->getStringValue());
+        if (data->getStringValue() == "multiplayer")
+        {
+            multiplayer = true;
+            break;
+        }
+    }
+
+    // write the raw data (all records in the given list)
     size_t check_count = 0;
-    while (it != replay_data.end() && !output.fail())
+    for_each([&](const FGReplayData& frame)
     {
-        const FGReplayData* frame = *it++;
-        assert(record_size == frame->raw_data.size());
-        writeRaw(output, frame->sim_time);
-        output.write(&frame->raw_data.front(), frame->raw_data.size());
+        if (output.fail()) return false;
+        assert(record_size == frame.raw_data.size());
+        writeRaw(output, frame.sim_time);
+        output.write(&frame.raw_data.front(), frame.raw_data.size());
 
-        for (auto data: meta->getNode("meta")->getChildren("data"))
+        if (multiplayer)
         {
-            SG_LOG(SG_SYSTEMS, SG_DEBUG, "data->getStringValue()=" << data->getStringValue());
-            if (data->getStringValue() == "multiplayer")
+            uint32_t length = 0;
+            for (auto message: frame.multiplayer_messages)
             {
-                uint32_t length = 0;
-                for (auto message: frame->multiplayer_messages)
-                {
-                    length += sizeof(uint16_t) + message->size();
-                }
-                writeRaw(output, length);
-                for (auto message: frame->multiplayer_messages)
-                {
-                    uint16_t message_size = message->size();
-                    writeRaw(output, message_size);
-                    output.write(&message->front(), message_size);
-                }
-                break;
+                length += sizeof(uint16_t) + message->size();
+            }
+            writeRaw(output, length);
+            for (auto message: frame.multiplayer_messages)
+            {
+                uint16_t message_size = message->size();
+                writeRaw(output, message_size);
+                output.write(&message->front(), message_size);
             }
         }
         check_count++;
-    }
+        return true;
+    });
 
     // Did we really write as much as we intended?
     if (check_count != count)
@@ -836,6 +857,26 @@ bool replayNormal(FGReplayInternal& self, double time)
         {
             interpolate( self, time, self.m_short_term );
         }
+        else if ( ! self.m_compressed_store->empty() )
+        {
+            // full rate frames that are older than the short term list
+            FGReplayData* older = nullptr;
+            FGReplayData* newer = nullptr;
+            self.m_compressed_store->find(time, older, newer);
+            if (!older)
+            {
+                // replay the oldest frame
+                replayNormal2(self, time, newer);
+            }
+            else if (!newer)
+            {
+                replayNormal2(self, time, self.m_short_term.front(), older);
+            }
+            else
+            {
+                replayNormal2(self, time, newer, older);
+            }
+        }
         else if ( ! self.m_medium_term.empty() )
         {
             t1 = self.m_short_term.front()->sim_time;
@@ -1156,7 +1197,7 @@ FGReplayInternal::update( double dt )
     
     if (m_continuous->m_out.is_open())
     {
-        continuousWriteFrame(*m_continuous, r, m_continuous->m_out, m_continuous->m_out_config, FGTapeType_CONTINUOUS);
+        continuousRecordFrame(*m_continuous, r);
     }
     
     if (replay_state == 0)
@@ -1227,13 +1268,21 @@ FGReplayInternal::update( double dt )
         while ( !m_short_term.empty() && m_sim_time - st_front->sim_time > m_high_res_time )
         {
             st_front = m_short_term.front();
-            MoveFrontMultiplayerPackets(m_short_term);
+            if (m_compressed)
+            {
+                // keep every frame, so no multiplayer packets are lost
+                m_compressed_store->push_back(*st_front);
+            }
+            else
+            {
+                MoveFrontMultiplayerPackets(m_short_term);
+            }
             m_recycler.push_back(st_front);
             m_short_term.pop_front();
         }
 
         // update the medium term list
-        if ( m_sim_time - m_last_mt_time > m_medium_sample_rate )
+        if ( !m_compressed && m_sim_time - m_last_mt_time > m_medium_sample_rate )
         {
             m_last_mt_time = m_sim_time;
             if (!m_short_term.empty())
@@ -1441,12 +1490,40 @@ static bool saveTape2(FGReplayInternal& self, const SGPath& filename, SGProperty
                 << "Config:recorder/signal-count=" <<  config->getIntValue("recorder/signal-count", 0)
                 << " RecordSize: " << record_size
                 );
+        auto save_list = [&](const std::deque<FGReplayData*>& list)
+        {
+            return saveRawReplayData(output, list.size(),
+                    [&list](const std::function<bool (const FGReplayData&)>& fn)
+                    {
+                        for (const FGReplayData* frame: list)
+                        {
+                            if (!fn(*frame)) break;
+                        }
+                    },
+                    record_size, metadata);
+        };
         if (ok)
-            ok &= saveRawReplayData(output, self.m_short_term,  record_size, metadata);
-        if (ok)
-            ok &= saveRawReplayData(output, self.m_medium_term, record_size, metadata);
+            ok &= save_list(self.m_short_term);
+        if (self.m_compressed_store->empty())
+        {
+            if (ok)
+                ok &= save_list(self.m_medium_term);
+        }
+        else
+        {
+            // Full rate compressed frames are stored as if they were the
+            // medium term list, so the tape format doesn't change.
+            const FGReplayFrameStore& store = *self.m_compressed_store;
+            if (ok)
+                ok &= saveRawReplayData(output, store.size(),
+                        [&store](const std::function<bool (const FGReplayData&)>& fn)
+                        {
+                            store.forEach(fn);
+                        },
+                        record_size, metadata);
+        }
         if (ok)
-            ok &= saveRawReplayData(output, self.m_long_term,   record_size, metadata);
+            ok &= save_list(self.m_long_term);
         config = 0;
     }
 
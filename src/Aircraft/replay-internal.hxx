@@ -208,6 +208,12 @@ struct FGReplayInternal
     double  m_medium_sample_rate;   // medium term sample rate (sec)
     double  m_long_sample_rate;     // long term sample rate (sec)
 
+    /* If true, frames older than m_high_res_time are kept at full rate in
+    m_compressed_store instead of being thinned out into m_medium_term and
+    m_long_term. */
+    bool    m_compressed;
+    std::unique_ptr<struct FGReplayFrameStore>  m_compressed_store;
+
     std::shared_ptr<FGFlightRecorder>   m_flight_recorder;
     
     /* Things for Continuous recording/replay support. */
@@ -0,0 +1,327 @@
+#include "replay-store.hxx"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <assert.h>
+#include <string.h>
+#include <zlib.h>
+
+
+template<typename T>
+static void appendRaw(std::vector<char>& out, const T& data)
+{
+    const char* p = reinterpret_cast<const char*>(&data);
+    out.insert(out.end(), p, p + sizeof(data));
+}
+
+template<typename T>
+static void readRaw(const char*& p, T& data)
+{
+    memcpy(&data, p, sizeof(data));
+    p += sizeof(data);
+}
+
+
+FGReplayFrameStore::FGReplayFrameStore()
+{
+}
+
+FGReplayFrameStore::~FGReplayFrameStore()
+{
+}
+
+void FGReplayFrameStore::configure(size_t keyframe_interval, size_t max_bytes)
+{
+    m_keyframe_interval = std::max(keyframe_interval, (size_t) 1);
+    m_max_bytes = max_bytes;
+    clear();
+}
+
+void FGReplayFrameStore::clear()
+{
+    m_chunks.clear();
+    m_open = Chunk();
+    m_previous_raw.clear();
+    m_first_id = 0;
+    m_num_frames = 0;
+    m_bytes = 0;
+    for (auto& d: m_decoded)
+    {
+        d.valid = false;
+        d.frames.clear();
+    }
+}
+
+size_t FGReplayFrameStore::bytes() const
+{
+    return m_bytes + m_open.data.size();
+}
+
+double FGReplayFrameStore::front_time() const
+{
+    assert(!empty());
+    return m_chunks.empty() ? m_open.begin_time : m_chunks.front().begin_time;
+}
+
+double FGReplayFrameStore::back_time() const
+{
+    assert(!empty());
+    return m_open.num_frames ? m_open.end_time : m_chunks.back().end_time;
+}
+
+void FGReplayFrameStore::push_back(const FGReplayData& frame)
+{
+    if (m_open.num_frames
+            && (m_open.num_frames >= m_keyframe_interval
+                || frame.raw_data.size() != m_open.record_size)
+            )
+    {
+        closeChunk();
+    }
+
+    // A cached decode of the open chunk would now be missing this frame.
+    const size_t open_id = m_first_id + m_chunks.size();
+    for (auto& d: m_decoded)
+    {
+        if (d.id == open_id) d.valid = false;
+    }
+
+    const bool keyframe = (m_open.num_frames == 0);
+    if (keyframe)
+    {
+        m_open.begin_time = frame.sim_time;
+        m_open.record_size = frame.raw_data.size();
+    }
+    m_open.end_time = frame.sim_time;
+
+    appendRaw(m_open.data, frame.sim_time);
+    size_t pos = m_open.data.size();
+    m_open.data.insert(m_open.data.end(), frame.raw_data.begin(), frame.raw_data.end());
+    if (!keyframe)
+    {
+        char* p = &m_open.data[pos];
+        for (size_t i = 0; i < m_open.record_size; ++i)
+        {
+            p[i] ^= m_previous_raw[i];
+        }
+    }
+    m_previous_raw = frame.raw_data;
+
+    // Multiplayer messages use the same layout as in fgtape files.
+    uint32_t length = 0;
+    for (auto& message: frame.multiplayer_messages)
+    {
+        length += sizeof(uint16_t) + message->size();
+    }
+    appendRaw(m_open.data, length);
+    for (auto& message: frame.multiplayer_messages)
+    {
+        uint16_t message_size = message->size();
+        appendRaw(m_open.data, message_size);
+        m_open.data.insert(m_open.data.end(), message->begin(), message->end());
+    }
+
+    m_open.num_frames += 1;
+    m_num_frames += 1;
+}
+
+void FGReplayFrameStore::closeChunk()
+{
+    Chunk chunk;
+    chunk.begin_time = m_open.begin_time;
+    chunk.end_time = m_open.end_time;
+    chunk.num_frames = m_open.num_frames;
+    chunk.record_size = m_open.record_size;
+    chunk.raw_size = m_open.data.size();
+
+    uLongf length = compressBound(chunk.raw_size);
+    chunk.data.resize(length);
+    int e = compress2(
+            reinterpret_cast<Bytef*>(chunk.data.data()),
+            &length,
+            reinterpret_cast<const Bytef*>(m_open.data.data()),
+            chunk.raw_size,
+            Z_BEST_SPEED
+            );
+    if (e != Z_OK)
+    {
+        throw std::runtime_error("compress2() failed");
+    }
+    chunk.data.resize(length);
+    chunk.data.shrink_to_fit();
+
+    m_bytes += chunk.data.size();
+    m_chunks.push_back(std::move(chunk));
+
+    // Keep the open buffer's capacity for the next chunk.
+    m_open.data.clear();
+    m_open.num_frames = 0;
+
+    // Discard oldest chunks if we are over budget, but always keep at least
+    // one.
+    while (m_bytes > m_max_bytes && m_chunks.size() > 1)
+    {
+        m_bytes -= m_chunks.front().data.size();
+        m_num_frames -= m_chunks.front().num_frames;
+        m_chunks.pop_front();
+        for (auto& d: m_decoded)
+        {
+            if (d.id == m_first_id) d.valid = false;
+        }
+        m_first_id += 1;
+    }
+}
+
+const FGReplayFrameStore::Chunk& FGReplayFrameStore::chunkById(size_t id) const
+{
+    size_t i = id - m_first_id;
+    if (i < m_chunks.size())    return m_chunks[i];
+    assert(i == m_chunks.size());
+    return m_open;
+}
+
+void FGReplayFrameStore::decode(const Chunk& chunk, std::vector<std::unique_ptr<FGReplayData>>& frames) const
+{
+    const char* p = chunk.data.data();
+    std::vector<char> inflated;
+    if (&chunk != &m_open)
+    {
+        inflated.resize(chunk.raw_size);
+        uLongf length = chunk.raw_size;
+        int e = uncompress(
+                reinterpret_cast<Bytef*>(inflated.data()),
+                &length,
+                reinterpret_cast<const Bytef*>(chunk.data.data()),
+                chunk.data.size()
+                );
+        if (e != Z_OK || length != chunk.raw_size)
+        {
+            throw std::runtime_error("uncompress() failed");
+        }
+        p = inflated.data();
+    }
+
+    // Reuse any frames from a previous decode, their buffers already have
+    // the right capacity.
+    frames.resize(chunk.num_frames);
+    const FGReplayData* previous = nullptr;
+    for (auto& frame: frames)
+    {
+        if (!frame) frame.reset(new FGReplayData);
+
+        readRaw(p, frame->sim_time);
+        frame->raw_data.assign(p, p + chunk.record_size);
+        p += chunk.record_size;
+        if (previous)
+        {
+            for (size_t i = 0; i < chunk.record_size; ++i)
+            {
+                frame->raw_data[i] ^= previous->raw_data[i];
+            }
+        }
+        previous = frame.get();
+
+        uint32_t length;
+        readRaw(p, length);
+        const char* end = p + length;
+        frame->multiplayer_messages.clear();
+        while (p < end)
+        {
+            uint16_t message_size;
+            readRaw(p, message_size);
+            frame->multiplayer_messages.push_back(
+                    std::make_shared<std::vector<char>>(p, p + message_size)
+                    );
+            p += message_size;
+        }
+    }
+}
+
+FGReplayFrameStore::Decoded& FGReplayFrameStore::decoded(size_t id)
+{
+    for (int i = 0; i < 2; ++i)
+    {
+        if (m_decoded[i].valid && m_decoded[i].id == id)
+        {
+            m_decoded_next = 1 - i;
+            return m_decoded[i];
+        }
+    }
+
+    Decoded& d = m_decoded[m_decoded_next];
+    d.valid = false;
+    decode(chunkById(id), d.frames);
+    d.id = id;
+    d.valid = true;
+    m_decoded_next = 1 - m_decoded_next;
+    return d;
+}
+
+bool FGReplayFrameStore::find(double time, FGReplayData*& older, FGReplayData*& newer)
+{
+    older = nullptr;
+    newer = nullptr;
+    if (empty()) return false;
+
+    if (time < front_time())
+    {
+        newer = decoded(m_first_id).frames.front().get();
+        return true;
+    }
+
+    // Find the last chunk that starts at or before <time>.
+    const size_t num_chunks = m_chunks.size() + (m_open.num_frames ? 1 : 0);
+    size_t lo = 0;
+    size_t hi = num_chunks;
+    while (hi - lo > 1)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (chunkById(m_first_id + mid).begin_time <= time) lo = mid;
+        else hi = mid;
+    }
+
+    const auto& frames = decoded(m_first_id + lo).frames;
+    auto it = std::upper_bound(frames.begin(), frames.end(), time,
+            [](double t, const std::unique_ptr<FGReplayData>& frame)
+            {
+                return t < frame->sim_time;
+            });
+    assert(it != frames.begin());
+    older = (it - 1)->get();
+    if (it != frames.end())
+    {
+        newer = it->get();
+    }
+    else if (lo + 1 < num_chunks)
+    {
+        // Keyframe of the next chunk. This doesn't evict the chunk we have
+        // just used, so <older> remains valid.
+        newer = decoded(m_first_id + lo + 1).frames.front().get();
+    }
+    return true;
+}
+
+bool FGReplayFrameStore::forEach(const std::function<bool (const FGReplayData&)>& fn) const
+{
+    std::vector<std::unique_ptr<FGReplayData>> frames;
+    auto visit = [&](const Chunk& chunk)
+    {
+        decode(chunk, frames);
+        for (auto& frame: frames)
+        {
+            if (!fn(*frame)) return false;
+        }
+        return true;
+    };
+
+    for (auto& chunk: m_chunks)
+    {
+        if (!visit(chunk)) return false;
+    }
+    if (m_open.num_frames)
+    {
+        if (!visit(m_open)) return false;
+    }
+    return true;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "replay-internal.hxx"
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+/* Compressed in-memory storage of full rate replay frames.
+
+Frames are grouped into chunks of up to <keyframe_interval> frames. The first
+frame of each chunk (the keyframe) is stored as is, and the raw_data of each
+following frame is XOR-ed with that of its predecessor, so that signals which
+didn't change become runs of zero bytes. A completed chunk is deflated at the
+fastest zlib level.
+
+Looking up a time only needs to decode the chunk(s) containing the
+surrounding frames; the two most recently decoded chunks are cached, so
+replaying forwards or backwards decodes each chunk once.
+
+When the compressed size exceeds the configured budget, the oldest chunks are
+discarded. */
+struct FGReplayFrameStore
+{
+    FGReplayFrameStore();
+    ~FGReplayFrameStore();
+
+    /* Sets number of frames per chunk and memory budget in bytes. Clears all
+    stored frames. */
+    void configure(size_t keyframe_interval, size_t max_bytes);
+
+    void clear();
+
+    /* Appends a copy of <frame>, whose sim_time must be later than that of
+    the previous frame. */
+    void push_back(const FGReplayData& frame);
+
+    bool    empty() const   { return m_num_frames == 0; }
+    size_t  size() const    { return m_num_frames; }
+
+    /* Memory used by the stored frames. */
+    size_t  bytes() const;
+
+    double  front_time() const;
+    double  back_time() const;
+
+    /* Finds the frames either side of <time>:
+
+        older:
+            Last frame with sim_time <= time, or nullptr if <time> is before
+            the first frame.
+        newer:
+            First frame with sim_time > time, or nullptr if <time> is at or
+            after the last frame.
+
+    The returned frames are owned by the store and remain valid until the next
+    call of a non-const method. Returns false if the store is empty. */
+    bool find(double time, FGReplayData*& older, FGReplayData*& newer);
+
+    /* Calls <fn> for each frame in chronological order, stopping early if it
+    returns false. Doesn't disturb the cache used by find(). Returns false if
+    <fn> returned false. */
+    bool forEach(const std::function<bool (const FGReplayData&)>& fn) const;
+
+private:
+    struct Chunk
+    {
+        double              begin_time = 0;
+        double              end_time = 0;
+        size_t              num_frames = 0;
+        size_t              record_size = 0;
+        size_t              raw_size = 0;   // Uncompressed size of <data>.
+        std::vector<char>   data;           // Deflated, except for the open chunk.
+    };
+
+    struct Decoded
+    {
+        size_t                                      id = 0;
+        bool                                        valid = false;
+        std::vector<std::unique_ptr<FGReplayData>>  frames;
+    };
+
+    void    closeChunk();
+    void    decode(const Chunk& chunk, std::vector<std::unique_ptr<FGReplayData>>& frames) const;
+    Decoded& decoded(size_t id);
+    const Chunk& chunkById(size_t id) const;
+
+    size_t              m_keyframe_interval = 64;
+    size_t              m_max_bytes = 256 * 1024 * 1024;
+
+    std::deque<Chunk>   m_chunks;       // Completed chunks, oldest first.
+    Chunk               m_open;         // Chunk being filled, not yet deflated.
+    std::vector<char>   m_previous_raw; // raw_data of the last frame pushed.
+
+    size_t              m_first_id = 0; // Id of m_chunks.front().
+    size_t              m_num_frames = 0;
+    size_t              m_bytes = 0;    // Total size of m_chunks[].data.
+
+    Decoded             m_decoded[2];
+    size_t              m_decoded_next = 0; // Entry of m_decoded[] to reuse next.
+};
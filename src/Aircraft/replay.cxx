@@ -25,6 +25,8 @@
 #include "replay.hxx"
 #include "replay-internal.hxx"
 
+#include <Main/FrameProfiler.hxx>
+
 
 FGReplay::FGReplay()
 :
@@ -72,6 +74,7 @@ FGReplay::start(bool NewTape)
 void
 FGReplay::update( double dt )
 {
+    FG_PROFILE_SCOPE("subsystems/replay");
     timingInfo.clear();
     stamp("begin");
     m_internal->update(dt);
@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <mutex>
 
 #include <simgear/misc/sg_path.hxx>
 #include <simgear/props/props.hxx>
@@ -62,6 +63,8 @@ using namespace flightgear;
  ***************************************************************************/
 
 AirportCache FGAirport::airportCache;
+// findByIdent() may be called from worker threads
+static std::mutex static_airportCacheLock;
 
 FGAirport::FGAirport( PositionedID aGuid,
                       const std::string &id,
@@ -487,15 +490,19 @@ bool FGAirport::TypeRunwayFilter::pass(FGPositioned* pos) const
 
 void FGAirport::clearAirportsCache()
 {
+    std::lock_guard<std::mutex> g(static_airportCacheLock);
     airportCache.clear();
 }
 
 //------------------------------------------------------------------------------
 FGAirportRef FGAirport::findByIdent(const std::string& aIdent)
 {
-  AirportCache::iterator it = airportCache.find(aIdent);
-  if (it != airportCache.end())
-   return it->second;
+  {
+    std::lock_guard<std::mutex> g(static_airportCacheLock);
+    AirportCache::iterator it = airportCache.find(aIdent);
+    if (it != airportCache.end())
+     return it->second;
+  }
 
   PortsFilter filter;
   FGAirportRef r = static_pointer_cast<FGAirport>
@@ -504,6 +511,7 @@ FGAirportRef FGAirport::findByIdent(const std::string& aIdent)
   );
 
   // add airport to the cache (even when it's NULL, so we don't need to search in vain again)
+  std::lock_guard<std::mutex> g(static_airportCacheLock);
   airportCache[aIdent] = r;
 
   // we don't warn here when r==NULL, let the caller do that
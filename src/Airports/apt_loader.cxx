@@ -42,9 +42,15 @@
 #include <simgear/misc/strutils.hxx>
 #include <simgear/structure/exception.hxx>
 #include <simgear/misc/sg_path.hxx>
+#include <simgear/io/sg_mmap.hxx>
 
+#include <charconv>
 #include <cstddef>              // std::size_t
+#include <future>
+#include <limits>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <utility>              // std::pair, std::move()
 
@@ -78,49 +84,236 @@ static FGPositioned::Type fptypeFromRobinType(unsigned int aType)
 
 namespace flightgear
 {
+
+namespace aptdat
+{
+
+static inline bool isFieldSpace(char c)
+{
+  // same set as isspace() in the "C" locale
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+void splitFields(std::string_view line, std::vector<std::string_view>& fields,
+                 std::size_t maxSplit)
+{
+  fields.clear();
+  const std::size_t len = line.size();
+  std::size_t i = 0;
+
+  while (i < len) {
+    while (i < len && isFieldSpace(line[i])) {
+      ++i;
+    }
+
+    const std::size_t j = i;
+    while (i < len && !isFieldSpace(line[i])) {
+      ++i;
+    }
+
+    if (j < i) {
+      fields.push_back(line.substr(j, i - j));
+      while (i < len && isFieldSpace(line[i])) {
+        ++i;
+      }
+
+      if (maxSplit && (fields.size() >= maxSplit) && (i < len)) {
+        fields.push_back(line.substr(i));
+        return;
+      }
+    }
+  }
+}
+
+// Position 'first' on the start of the number, as atof()/atoi() would
+static const char* skipToNumber(const char* first, const char* last)
+{
+  while (first < last && isFieldSpace(*first)) {
+    ++first;
+  }
+
+  if (first < last && *first == '+') {
+    ++first;
+  }
+
+  return first;
+}
+
+double parseDouble(std::string_view field)
+{
+  const char* first = skipToNumber(field.data(), field.data() + field.size());
+  const char* last = field.data() + field.size();
+  double value = 0.0;
+
+#if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+  std::from_chars(first, last, value);
+#else
+  // floating-point from_chars() is missing from some standard libraries:
+  // fall back to strtod() on a bounded, NUL-terminated copy
+  char buf[64];
+  const std::size_t n = std::min<std::size_t>(last - first, sizeof(buf) - 1);
+  memcpy(buf, first, n);
+  buf[n] = '\0';
+  value = strtod(buf, nullptr);
+#endif
+
+  return value;
+}
+
+int parseInt(std::string_view field)
+{
+  const char* first = skipToNumber(field.data(), field.data() + field.size());
+  int value = 0;
+  std::from_chars(first, field.data() + field.size(), value);
+  return value;
+}
+
+} // of namespace aptdat
+
+using aptdat::parseDouble;
+using aptdat::parseInt;
+
 APTLoader::APTLoader()
+  :  APTLoader(NavDataCache::instance())
+{ }
+
+APTLoader::APTLoader(NavDataCache* cache_)
   :  last_apt_id(""),
      last_apt_elev(0.0),
      currentAirportPosID(0),
-     cache(NavDataCache::instance())
+     cache(cache_)
 { }
 
 APTLoader::~APTLoader() { }
 
+std::string_view APTLoader::FileBuffer::data() const
+{
+  if (mapping) {
+    return std::string_view(mapping->get(), mapping->get_size());
+  }
+
+  return contents;
+}
+
 void APTLoader::readAptDatFile(const SGPath &aptdb_file,
                                std::size_t bytesReadSoFar,
                                std::size_t totalSizeOfAllAptDatFiles)
 {
-  string apt_dat = aptdb_file.utf8Str(); // full path to the file being parsed
-  sg_gzifstream in(aptdb_file, std::ios_base::in | std::ios_base::binary, true);
+  if (aptdb_file.extension() != "gz") {
+    // uncompressed: map the file instead of copying it into memory
+    std::unique_ptr<FileBuffer> buffer(new FileBuffer);
+    buffer->mapping.reset(new SGMMapFile(aptdb_file));
+    if (buffer->mapping->open(SG_IO_IN)) {
+      fileBuffers.push_back(std::move(buffer));
+      readAptDatBuffer(aptdb_file, *fileBuffers.back(), bytesReadSoFar,
+                       totalSizeOfAllAptDatFiles);
+      return;
+    }
 
-  if ( !in.is_open() ) {
-    const std::string errMsg = simgear::strutils::error_string(errno);
-    SG_LOG( SG_GENERAL, SG_ALERT,
-            "Cannot open file '" << apt_dat << "': " << errMsg );
-    throw sg_io_exception("Cannot open file (" + errMsg + ")",
-                          sg_location(aptdb_file));
+    SG_LOG(SG_GENERAL, SG_INFO, "Unable to map '" << aptdb_file.utf8Str() <<
+           "', reading it instead");
   }
 
-  string line;
+  readAptDatFile(aptdb_file,
+                 NavDataCache::readDatFileContents(aptdb_file, true),
+                 bytesReadSoFar, totalSizeOfAllAptDatFiles);
+}
 
-  unsigned int rowCode = 0;     // terminology used in the apt.dat format spec
-  unsigned int line_num = 0;
-  // "airport identifier": terminology used in the apt.dat format spec. It is
-  // often an ICAO code, but not always.
-  string currentAirportId;
-  // Boolean used to make sure we don't try to load the same airport several
-  // times. Defaults to true only to ensure we don't add garbage to
-  // 'airportInfoMap' under the key "" (empty airport identifier) in case the
-  // apt.dat file doesn't have a start-of-airport row code (1, 16 or 17) after
-  // its header---which would be invalid, anyway.
-  bool skipAirport = true;
+void APTLoader::readAptDatFile(const SGPath &aptdb_file,
+                               std::string contents,
+                               std::size_t bytesReadSoFar,
+                               std::size_t totalSizeOfAllAptDatFiles)
+{
+  std::unique_ptr<FileBuffer> buffer(new FileBuffer);
+  buffer->contents = std::move(contents);
+  fileBuffers.push_back(std::move(buffer));
+  readAptDatBuffer(aptdb_file, *fileBuffers.back(), bytesReadSoFar,
+                   totalSizeOfAllAptDatFiles);
+}
+
+// Don't bother splitting files (or what remains of them) smaller than this
+static const std::size_t MIN_APT_DAT_CHUNK_SIZE = 4 * 1024 * 1024;
+
+struct APTLoader::ScanProgress
+{
+  ScanProgress(NavDataCache* cache_, std::size_t bytesReadSoFar_,
+               std::size_t fileSize_, std::size_t totalSize_,
+               std::size_t bodySize_)
+    : cache(cache_), bytesReadSoFar(bytesReadSoFar_), fileSize(fileSize_),
+      totalSize(totalSize_), bodySize(bodySize_)
+  { }
+
+  // Called by the scanning threads after every few lines. Serialized, so
+  // the reported percentage never goes backwards.
+  void add(std::size_t bytes)
+  {
+    if (!cache || !totalSize) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> g(lock);
+    scanned += bytes;
+    // The sizes of the files are on disk (maybe compressed), the scan is of
+    // the decompressed body
+    const std::size_t fileDone = bodySize ? (fileSize * scanned) / bodySize
+                                          : fileSize;
+    const unsigned int percent = ((bytesReadSoFar + fileDone) * 100) / totalSize;
+    cache->setRebuildPhaseProgress(
+      NavDataCache::REBUILD_READING_APT_DAT_FILES, percent);
+  }
+
+  NavDataCache* const cache;
+  const std::size_t bytesReadSoFar;
+  const std::size_t fileSize;
+  const std::size_t totalSize;
+  const std::size_t bodySize;
+  std::mutex lock;
+  std::size_t scanned = 0;
+};
+
+// Equivalent of atoi(line) being 1, 16 or 17 for the line starting at 'p'
+static bool isAirportHeaderLine(const char* p, const char* end)
+{
+  const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+  const int rowCode = parseInt(std::string_view(p, (eol ? eol : end) - p));
+  return (rowCode == 1 || rowCode == 16 || rowCode == 17);
+}
+
+static const char* nextLineStart(const char* p, const char* end)
+{
+  const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+  return eol ? eol + 1 : end;
+}
+
+// The line starting at 'p', without its '\n' (it may still end with '\r')
+static std::string_view lineAt(const char* p, const char* lineEnd)
+{
+  return std::string_view(p, ((lineEnd[-1] == '\n') ? lineEnd - 1 : lineEnd) - p);
+}
+
+void APTLoader::readAptDatBuffer(const SGPath &aptdb_file,
+                                 const FileBuffer& buffer,
+                                 std::size_t bytesReadSoFar,
+                                 std::size_t totalSizeOfAllAptDatFiles)
+{
+  string apt_dat = aptdb_file.utf8Str(); // full path to the file being parsed
+  const std::string_view data = buffer.data();
+  const char* p = data.data();
+  const char* const end = p + data.size();
 
   // Read the apt.dat header (two lines)
-  while ( line_num < 2 && std::getline(in, line) ) {
-    // 'line' may end with an \r character (tested on Linux, only \n was
-    // stripped: std::getline() only discards the _native_ line terminator)
-    line_num++;
+  for (unsigned int line_num = 1; line_num <= 2; line_num++) {
+    if (p == end) {
+      std::string pb = "truncated file header";
+      SG_LOG( SG_GENERAL, SG_ALERT, aptdb_file << ": " << pb);
+      throw sg_format_exception("cannot parse '" + apt_dat + "': " + pb,
+                                string());
+    }
+
+    const char* lineEnd = nextLineStart(p, end);
+    // 'line' may end with an \r character
+    string line(lineAt(p, lineEnd));
+    p = lineEnd;
 
     if ( line_num == 1 ) {
       std::string stripped_line = simgear::strutils::strip(line);
@@ -149,71 +342,142 @@ void APTLoader::readAptDatFile(const SGPath &aptdb_file,
     }
   } // end of the apt.dat header
 
-  throwExceptionIfStreamError(in, aptdb_file);
+  // Split the body at airport headers into roughly equal pieces, one per
+  // worker thread. Each piece starts at a row code 1, 16 or 17 line, so the
+  // pieces can be scanned independently.
+  const std::size_t bodySize = end - p;
+  const std::size_t nbWorkers = std::max(1u, std::thread::hardware_concurrency());
+  const std::size_t nbChunks =
+    std::min(nbWorkers, bodySize / MIN_APT_DAT_CHUNK_SIZE + 1);
+
+  std::vector<const char*> bounds{p};
+  for (std::size_t i = 1; i < nbChunks; i++) {
+    const char* q = p + (bodySize * i) / nbChunks;
+    if (q <= bounds.back()) {
+      continue;
+    }
 
-  while ( std::getline(in, line) ) {
-    // 'line' may end with an \r character, see above
-    line_num++;
+    q = nextLineStart(q, end);
+    while (q < end && !isAirportHeaderLine(q, end)) {
+      q = nextLineStart(q, end);
+    }
 
-    if ( isBlankOrCommentLine(line) )
-      continue;
+    if (q >= end) {
+      break;
+    }
+
+    bounds.push_back(q);
+  }
+  bounds.push_back(end);
+
+  // The first piece is scanned on this thread, the others concurrently.
+  // Each reports its progress as it goes.
+  const std::size_t nbPieces = bounds.size() - 1;
+  std::vector<ScannedAirportList> pieces(nbPieces);
+  std::vector<std::future<void>> workers;
+  ScanProgress progress(cache, bytesReadSoFar, aptdb_file.sizeInBytes(),
+                        totalSizeOfAllAptDatFiles, bodySize);
+  unsigned int lineNumBefore = 2; // header lines
+
+  for (std::size_t i = 0; i < nbPieces; i++) {
+    if (i > 0) {
+      workers.push_back(std::async(std::launch::async, &APTLoader::scanAptDatChunk,
+                                   std::cref(aptdb_file), bounds[i], bounds[i+1],
+                                   lineNumBefore, std::ref(pieces[i]),
+                                   std::ref(progress)));
+    }
+    lineNumBefore += std::count(bounds[i], bounds[i+1], '\n');
+  }
+
+  scanAptDatChunk(aptdb_file, bounds[0], bounds[1], 2, pieces[0], progress);
+  for (auto& w : workers) {
+    w.get();
+  }
+
+  // Merge in file order, so the first definition of an airport wins
+  for (ScannedAirportList& piece : pieces) {
+    for (ScannedAirport& scanned : piece) {
+      std::pair<AirportInfoMapType::iterator, bool>
+        insertRetval = airportInfoMap.insert(
+          AirportInfoMapType::value_type(string(scanned.id), RawAirportInfo()));
+
+      if ( !insertRetval.second ) {
+        SG_LOG( SG_GENERAL, SG_INFO,
+                apt_dat << ":"  << scanned.info.firstLineNum <<
+                ": skipping airport " << scanned.id <<
+                " (already defined earlier)" );
+      } else {
+        // We haven't seen this airport yet in any apt.dat file
+        insertRetval.first->second = std::move(scanned.info);
+      }
+    }
+  }
+}
+
+void APTLoader::scanAptDatChunk(const SGPath& aptdb_file, const char* begin,
+                                const char* end, unsigned int lineNumBefore,
+                                ScannedAirportList& result,
+                                ScanProgress& progress)
+{
+  FieldList tokens;
+  unsigned int rowCode = 0;     // terminology used in the apt.dat format spec
+  unsigned int line_num = lineNumBefore;
+  // Index in 'result' of the airport the current lines belong to. Lines
+  // before the first (valid) airport header are discarded.
+  const std::size_t noAirport = std::numeric_limits<std::size_t>::max();
+  std::size_t current = noAirport;
+  const char* reported = begin;
+
+  for (const char* p = begin; p < end; ) {
+    const char* lineEnd = nextLineStart(p, end);
+    // 'line' may end with an \r character
+    const std::string_view line = lineAt(p, lineEnd);
+    p = lineEnd;
+    line_num++;
 
     if ((line_num % 100) == 0) {
-      // every 100 lines
-      unsigned int percent = ((bytesReadSoFar + in.approxOffset()) * 100)
-                             / totalSizeOfAllAptDatFiles;
-      cache->setRebuildPhaseProgress(
-        NavDataCache::REBUILD_READING_APT_DAT_FILES, percent);
+      // Every 100 lines
+      progress.add(p - reported);
+      reported = p;
     }
 
+    if ( isBlankOrCommentLine(line) )
+      continue;
+
     // Extract the first field into 'rowCode'
-    rowCode = atoi(line.c_str());
+    rowCode = parseInt(line);
 
     if ( rowCode == 1  /* Airport */ ||
          rowCode == 16 /* Seaplane base */ ||
          rowCode == 17 /* Heliport */ ) {
-      vector<string> tokens(simgear::strutils::split(line));
+      aptdat::splitFields(line, tokens);
       if (tokens.size() < 6) {
         SG_LOG( SG_GENERAL, SG_WARN,
-                apt_dat << ":"  << line_num << ": invalid airport header "
+                aptdb_file.utf8Str() << ":"  << line_num << ": invalid airport header "
                 "(at least 6 fields are required)" );
-        skipAirport = true; // discard everything until the next airport header
+        current = noAirport; // discard everything until the next airport header
         continue;
       }
 
-      currentAirportId = tokens[4]; // often an ICAO, but not always
-      // Check if the airport is already in 'airportInfoMap'; get the
-      // existing entry, if any, otherwise insert a new one.
-      std::pair<AirportInfoMapType::iterator, bool>
-        insertRetval = airportInfoMap.insert(
-          AirportInfoMapType::value_type(currentAirportId, RawAirportInfo()));
-      skipAirport = !insertRetval.second;
-
-      if ( skipAirport ) {
-        SG_LOG( SG_GENERAL, SG_INFO,
-                apt_dat << ":"  << line_num << ": skipping airport " <<
-                currentAirportId << " (already defined earlier)" );
-      } else {
-        // We haven't seen this airport yet in any apt.dat file
-        RawAirportInfo& airportInfo = insertRetval.first->second;
-        airportInfo.file = aptdb_file;
-        airportInfo.rowCode = rowCode;
-        airportInfo.firstLineNum = line_num;
-        airportInfo.firstLineTokens = std::move(tokens);
-      }
+      current = result.size();
+      result.emplace_back();
+      ScannedAirport& scanned = result.back();
+      scanned.id = tokens[4]; // often an ICAO, but not always
+      scanned.info.file = aptdb_file;
+      scanned.info.rowCode = rowCode;
+      scanned.info.firstLineNum = line_num;
+      scanned.info.firstLine = line;
     } else if ( rowCode == 99 ) {
       SG_LOG( SG_GENERAL, SG_DEBUG,
-              apt_dat << ":"  << line_num << ": code 99 found "
+              aptdb_file.utf8Str() << ":"  << line_num << ": code 99 found "
               "(normally at end of file)" );
-    } else if ( !skipAirport ) {
-      // Line belonging to an already started, and not skipped airport entry;
-      // just append it.
-      airportInfoMap[currentAirportId].otherLines.emplace_back(
-        line_num, rowCode, line);
+    } else if ( current != noAirport ) {
+      // Line belonging to an already started airport entry; just append it.
+      result[current].info.otherLines.emplace_back(line_num, rowCode, line);
     }
-  } // of file reading loop
+  } // of chunk reading loop
 
-  throwExceptionIfStreamError(in, aptdb_file);
+  progress.add(end - reported);
 }
 
 void APTLoader::loadAirports()
@@ -229,12 +493,11 @@ void APTLoader::loadAirports()
 
     // this is just the current airport identifier
     last_apt_id = it->first;
-    RawAirportInfo rawinfo = it->second;
 
-    loadAirport(aptDat, last_apt_id, &rawinfo);
+    loadAirport(aptDat, last_apt_id, &it->second);
     nbLoadedAirports++;
 
-    if ((nbLoadedAirports % 300) == 0) {
+    if (cache && (nbLoadedAirports % 300) == 0) {
       // Every 300 airports
       unsigned int percent = nbLoadedAirports * 100 / nbAirports;
       cache->setRebuildPhaseProgress(NavDataCache::REBUILD_LOADING_AIRPORTS,
@@ -252,10 +515,17 @@ const FGAirport* APTLoader::loadAirportFromFile(std::string id, const SGPath& ap
   std::size_t bytesReadSoFar = 10;
   std::size_t totalSizeOfAllAptDatFiles = 100;
 
-  readAptDatFile(aptdb_file.str(), bytesReadSoFar, totalSizeOfAllAptDatFiles);
+  readAptDatFile(aptdb_file, bytesReadSoFar, totalSizeOfAllAptDatFiles);
+
+  RawAirportInfo& rawInfo = airportInfoMap[id];
+  return loadAirport(aptdb_file.utf8Str(), id, &rawInfo, true);
+}
 
-  RawAirportInfo rawInfo = airportInfoMap[id];
-  return loadAirport(aptdb_file.c_str(), id, &rawInfo, true);
+const APTLoader::FieldList& APTLoader::tokenize(std::string_view line,
+                                                std::size_t maxSplit)
+{
+  aptdat::splitFields(line, token, maxSplit);
+  return token;
 }
 
 static bool isCommLine(const int code)
@@ -263,11 +533,11 @@ static bool isCommLine(const int code)
     return ((code >= 50) && (code <= 56)) || ((code >= 1050) && (code <= 1056));
 }
 
-const FGAirport* APTLoader::loadAirport(const string aptDat, const std::string airportID, RawAirportInfo* airport_info, bool createFGAirport)
+const FGAirport* APTLoader::loadAirport(const string& aptDat, const std::string& airportID,
+                                        const RawAirportInfo* airport_info, bool createFGAirport)
 {
-  // The first line for this airport was already split over whitespace, but
-  // remains to be parsed for the most part.
-  parseAirportLine(airport_info->rowCode, airport_info->firstLineTokens);
+  // The first line for this airport was only checked when scanning the file
+  parseAirportLine(airport_info->rowCode, tokenize(airport_info->firstLine));
   const LinesList& lines = airport_info->otherLines;
 
   NodeBlock current_block = None;
@@ -280,21 +550,21 @@ const FGAirport* APTLoader::loadAirport(const string aptDat, const std::string a
 
     if ( rowCode == 10 ) { // Runway v810
       parseRunwayLine810(aptDat, linesIt->number,
-                         simgear::strutils::split(linesIt->str));
+                         tokenize(linesIt->str));
     } else if ( rowCode == 100 ) { // Runway v850
       parseRunwayLine850(aptDat, linesIt->number,
-                         simgear::strutils::split(linesIt->str));
+                         tokenize(linesIt->str));
     } else if ( rowCode == 101 ) { // Water Runway v850
       parseWaterRunwayLine850(aptDat, linesIt->number,
-                              simgear::strutils::split(linesIt->str));
+                              tokenize(linesIt->str));
     } else if ( rowCode == 102 ) { // Helipad v850
       parseHelipadLine850(aptDat, linesIt->number,
-                          simgear::strutils::split(linesIt->str));
+                          tokenize(linesIt->str));
     } else if ( rowCode == 18 ) {
       // beacon entry (ignore)
     } else if ( rowCode == 14 ) {  // Viewpoint/control tower
       parseViewpointLine(aptDat, linesIt->number,
-                         simgear::strutils::split(linesIt->str));
+                         tokenize(linesIt->str));
     } else if ( rowCode == 19 ) {
       // windsock entry (ignore)
     } else if ( rowCode == 20 ) {
@@ -307,23 +577,23 @@ const FGAirport* APTLoader::loadAirport(const string aptDat, const std::string a
       // ??
     } else if (isCommLine(rowCode)) {
         parseCommLine(aptDat, linesIt->number, rowCode,
-                      simgear::strutils::split(linesIt->str));
+                      tokenize(linesIt->str));
     } else if (rowCode == 110) {
         current_block = Pavement;
-        parsePavementLine850(simgear::strutils::split(linesIt->str, 0, 4));
+        parsePavementLine850(tokenize(linesIt->str, 4));
     } else if (rowCode >= 111 && rowCode <= 116) {
         switch (current_block) {
         case Pavement :
           parseNodeLine850(&pavements, aptDat, linesIt->number, rowCode,
-                                   simgear::strutils::split(linesIt->str));
+                                   tokenize(linesIt->str));
           break;
         case AirportBoundary :
           parseNodeLine850(&airport_boundary, aptDat, linesIt->number, rowCode,
-                                          simgear::strutils::split(linesIt->str));
+                                          tokenize(linesIt->str));
           break;
         case LinearFeature :
           parseNodeLine850(&linear_feature, aptDat, linesIt->number, rowCode,
-                                        simgear::strutils::split(linesIt->str));
+                                        tokenize(linesIt->str));
           break;
         default :
         case None :
@@ -385,17 +655,17 @@ const FGAirport* APTLoader::loadAirport(const string aptDat, const std::string a
 
 
 // Tell whether an apt.dat line is blank or a comment line
-bool APTLoader::isBlankOrCommentLine(const std::string& line)
+bool APTLoader::isBlankOrCommentLine(std::string_view line)
 {
   size_t pos = line.find_first_not_of(" \t");
-  return ( pos == std::string::npos ||
+  return ( pos == std::string_view::npos ||
            line[pos] == '\r' ||
-           line.find("##", pos) == pos );
+           line.compare(pos, 2, "##") == 0 );
 }
 
-std::string APTLoader::cleanLine(const std::string& line)
+std::string APTLoader::cleanLine(std::string_view line)
 {
-  std::string res = line;
+  std::string res(line);
 
   // Lines obtained from readAptDatFile() may end with \r, which can be quite
   // confusing when printed to the terminal.
@@ -408,19 +678,6 @@ std::string APTLoader::cleanLine(const std::string& line)
   return res;
 }
 
-void APTLoader::throwExceptionIfStreamError(const sg_gzifstream& input_stream,
-                                            const SGPath& path)
-{
-  if (input_stream.bad()) {
-    const std::string errMsg = simgear::strutils::error_string(errno);
-
-    SG_LOG( SG_NAVAID, SG_ALERT,
-            "Error while reading '" << path.utf8Str() << "': " << errMsg );
-    throw sg_io_exception("APTLoader: error reading file (" + errMsg + ")",
-                          sg_location(path));
-  }
-}
-
 void APTLoader::finishAirport(const string& aptDat)
 {
   if (currentAirportPosID == 0) {
@@ -438,7 +695,9 @@ void APTLoader::finishAirport(const string& aptDat)
   double lon = rwy_lon_accum / (double)rwy_count;
 
   SGGeod pos(SGGeod::fromDegFt(lon, lat, last_apt_elev));
-  cache->updatePosition(currentAirportPosID, pos);
+  if (cache) {
+    cache->updatePosition(currentAirportPosID, pos);
+  }
 
   currentAirportPosID = 0;
 }
@@ -446,18 +705,19 @@ void APTLoader::finishAirport(const string& aptDat)
 // 'rowCode' is passed to avoid decoding it twice, since that work was already
 // done in order to detect the start of the new airport.
 void APTLoader::parseAirportLine(unsigned int rowCode,
-                                 const vector<string>& token)
+                                 const FieldList& token)
 {
   // The algorithm in APTLoader::readAptDatFile() ensures this is at least 5.
-  vector<string>::size_type lastIndex = token.size() - 1;
-  const string& id(token[4]);
-  double elev = atof( token[1].c_str() );
+  FieldList::size_type lastIndex = token.size() - 1;
+  const string id(token[4]);
+  double elev = parseDouble(token[1]);
   last_apt_elev = elev;
 
   string name;
   // build the name
-  for ( vector<string>::size_type i = 5; i < lastIndex; ++i ) {
-    name += token[i] + " ";
+  for ( FieldList::size_type i = 5; i < lastIndex; ++i ) {
+    name += token[i];
+    name += ' ';
   }
   name += token[lastIndex];
 
@@ -466,12 +726,17 @@ void APTLoader::parseAirportLine(unsigned int rowCode,
   rwy_lat_accum = 0.0;
   rwy_count = 0;
 
-  currentAirportPosID = cache->insertAirport(fptypeFromRobinType(rowCode),
-                                             id, name);
+  if (cache) {
+    currentAirportPosID = cache->insertAirport(fptypeFromRobinType(rowCode),
+                                               id, name);
+  } else {
+    // parsing only: any non-zero ID tells finishAirport() there is an airport
+    currentAirportPosID = 1;
+  }
 }
 
 void APTLoader::parseRunwayLine810(const string& aptDat, unsigned int lineNum,
-                                   const vector<string>& token)
+                                   const FieldList& token)
 {
   if (token.size() < 11) {
     SG_LOG( SG_GENERAL, SG_WARN,
@@ -480,17 +745,17 @@ void APTLoader::parseRunwayLine810(const string& aptDat, unsigned int lineNum,
     return;
   }
 
-  double lat = atof( token[1].c_str() );
-  double lon = atof( token[2].c_str() );
+  double lat = parseDouble(token[1]);
+  double lon = parseDouble(token[2]);
   rwy_lat_accum += lat;
   rwy_lon_accum += lon;
   rwy_count++;
 
-  const string& rwy_no(token[3]);
+  const string rwy_no(token[3]);
 
-  double heading = atof( token[4].c_str() );
-  double length = atoi( token[5].c_str() );
-  double width = atoi( token[8].c_str() );
+  double heading = parseDouble(token[4]);
+  double length = parseInt(token[5]);
+  double width = parseInt(token[8]);
   length *= SG_FEET_TO_METER;
   width *= SG_FEET_TO_METER;
 
@@ -500,36 +765,45 @@ void APTLoader::parseRunwayLine810(const string& aptDat, unsigned int lineNum,
 
   last_rwy_heading = heading;
 
-  int surface_code = atoi( token[10].c_str() );
+  int surface_code = parseInt(token[10]);
 
   if (rwy_no[0] == 'x') {  // Taxiway
-    cache->insertRunway(
-      FGPositioned::TAXIWAY, rwy_no, pos_1, currentAirportPosID,
-      heading, length, width, 0.0, 0.0, surface_code);
+    if (cache) {
+      cache->insertRunway(
+        FGPositioned::TAXIWAY, rwy_no, pos_1, currentAirportPosID,
+        heading, length, width, 0.0, 0.0, surface_code);
+    }
   } else if (rwy_no[0] == 'H') {  // Helipad
     SGGeod pos(SGGeod::fromDegFt(lon, lat, last_apt_elev));
-    cache->insertRunway(FGPositioned::HELIPAD, rwy_no, pos, currentAirportPosID,
-                        heading, length, width, 0.0, 0.0, surface_code);
+    if (cache) {
+      cache->insertRunway(FGPositioned::HELIPAD, rwy_no, pos, currentAirportPosID,
+                          heading, length, width, 0.0, 0.0, surface_code);
+    }
   } else {
     // (pair of) runways
-    string rwy_displ_threshold = token[6];
-    vector<string> displ
-      = simgear::strutils::split( rwy_displ_threshold, "." );
-    double displ_thresh1 = atof( displ[0].c_str() );
-    double displ_thresh2 = atof( displ[1].c_str() );
+    // displaced thresholds and stopways are given as "<end 1>.<end 2>"
+    const std::string_view rwy_displ_threshold(token[6]);
+    const std::size_t displ_dot = rwy_displ_threshold.find('.');
+    double displ_thresh1 = parseDouble(rwy_displ_threshold.substr(0, displ_dot));
+    double displ_thresh2 = (displ_dot == std::string_view::npos) ? 0.0 :
+      parseDouble(rwy_displ_threshold.substr(displ_dot + 1));
     displ_thresh1 *= SG_FEET_TO_METER;
     displ_thresh2 *= SG_FEET_TO_METER;
 
-    string rwy_stopway = token[7];
-    vector<string> stop
-      = simgear::strutils::split( rwy_stopway, "." );
-    double stopway1 = atof( stop[0].c_str() );
-    double stopway2 = atof( stop[1].c_str() );
+    const std::string_view rwy_stopway(token[7]);
+    const std::size_t stop_dot = rwy_stopway.find('.');
+    double stopway1 = parseDouble(rwy_stopway.substr(0, stop_dot));
+    double stopway2 = (stop_dot == std::string_view::npos) ? 0.0 :
+      parseDouble(rwy_stopway.substr(stop_dot + 1));
     stopway1 *= SG_FEET_TO_METER;
     stopway2 *= SG_FEET_TO_METER;
 
     SGGeod pos_2 = SGGeodesy::direct( pos_1, heading, length );
 
+    if (!cache) {
+      return;
+    }
+
     PositionedID rwy = cache->insertRunway(FGPositioned::RUNWAY, rwy_no, pos_1,
                                            currentAirportPosID, heading, length,
                                            width, displ_thresh1, stopway1,
@@ -548,7 +822,7 @@ void APTLoader::parseRunwayLine810(const string& aptDat, unsigned int lineNum,
 }
 
 void APTLoader::parseRunwayLine850(const string& aptDat, unsigned int lineNum,
-                                   const vector<string>& token)
+                                   const FieldList& token)
 {
   if (token.size() < 26) {
     SG_LOG( SG_GENERAL, SG_WARN,
@@ -557,23 +831,23 @@ void APTLoader::parseRunwayLine850(const string& aptDat, unsigned int lineNum,
     return;
   }
 
-  double width = atof( token[1].c_str() );
-  int surface_code = atoi( token[2].c_str() );
-  int shoulder_code = atoi( token[3].c_str() );
-  float smoothness = atof( token[4].c_str() );
-  int center_lights = atoi( token[5].c_str() );
-  int edge_lights = atoi( token[6].c_str() );
-  int distance_remaining = atoi( token[7].c_str() );
+  double width = parseDouble(token[1]);
+  int surface_code = parseInt(token[2]);
+  int shoulder_code = parseInt(token[3]);
+  float smoothness = parseDouble(token[4]);
+  int center_lights = parseInt(token[5]);
+  int edge_lights = parseInt(token[6]);
+  int distance_remaining = parseInt(token[7]);
 
-  double lat_1 = atof( token[9].c_str() );
-  double lon_1 = atof( token[10].c_str() );
+  double lat_1 = parseDouble(token[9]);
+  double lon_1 = parseDouble(token[10]);
   SGGeod pos_1(SGGeod::fromDegFt(lon_1, lat_1, 0.0));
   rwy_lat_accum += lat_1;
   rwy_lon_accum += lon_1;
   rwy_count++;
 
-  double lat_2 = atof( token[18].c_str() );
-  double lon_2 = atof( token[19].c_str() );
+  double lat_2 = parseDouble(token[18]);
+  double lon_2 = parseDouble(token[19]);
   SGGeod pos_2(SGGeod::fromDegFt(lon_2, lat_2, 0.0));
   rwy_lat_accum += lat_2;
   rwy_lon_accum += lon_2;
@@ -584,28 +858,32 @@ void APTLoader::parseRunwayLine850(const string& aptDat, unsigned int lineNum,
 
   last_rwy_heading = heading_1;
 
-  const string& rwy_no_1(token[8]);
-  const string& rwy_no_2(token[17]);
+  const string rwy_no_1(token[8]);
+  const string rwy_no_2(token[17]);
   if ( rwy_no_1.empty() || rwy_no_2.empty() ) // these tests are weird...
     return;
 
-  double displ_thresh1 = atof( token[11].c_str() );
-  double displ_thresh2 = atof( token[20].c_str() );
+  double displ_thresh1 = parseDouble(token[11]);
+  double displ_thresh2 = parseDouble(token[20]);
 
-  double stopway1 = atof( token[12].c_str() );
-  double stopway2 = atof( token[21].c_str() );
+  double stopway1 = parseDouble(token[12]);
+  double stopway2 = parseDouble(token[21]);
 
-  int markings1 = atoi( token[13].c_str() );
-  int markings2 = atoi( token[22].c_str() );
+  int markings1 = parseInt(token[13]);
+  int markings2 = parseInt(token[22]);
 
-  int approach1 = atoi( token[14].c_str() );
-  int approach2 = atoi( token[23].c_str() );
+  int approach1 = parseInt(token[14]);
+  int approach2 = parseInt(token[23]);
 
-  int tdz1 = atoi( token[15].c_str() );
-  int tdz2 = atoi( token[24].c_str() );
+  int tdz1 = parseInt(token[15]);
+  int tdz2 = parseInt(token[24]);
 
-  int reil1 = atoi( token[16].c_str() );
-  int reil2 = atoi( token[25].c_str() );
+  int reil1 = parseInt(token[16]);
+  int reil2 = parseInt(token[25]);
+
+  if (!cache) {
+    return;
+  }
 
   PositionedID rwy = cache->insertRunway(FGPositioned::RUNWAY, rwy_no_1, pos_1,
                                          currentAirportPosID, heading_1, length,
@@ -628,7 +906,7 @@ void APTLoader::parseRunwayLine850(const string& aptDat, unsigned int lineNum,
 
 void APTLoader::parseWaterRunwayLine850(const string& aptDat,
                                         unsigned int lineNum,
-                                        const vector<string>& token)
+                                        const FieldList& token)
 {
   if (token.size() < 9) {
     SG_LOG( SG_GENERAL, SG_WARN,
@@ -637,17 +915,17 @@ void APTLoader::parseWaterRunwayLine850(const string& aptDat,
     return;
   }
 
-  double width = atof( token[1].c_str() );
+  double width = parseDouble(token[1]);
 
-  double lat_1 = atof( token[4].c_str() );
-  double lon_1 = atof( token[5].c_str() );
+  double lat_1 = parseDouble(token[4]);
+  double lon_1 = parseDouble(token[5]);
   SGGeod pos_1(SGGeod::fromDegFt(lon_1, lat_1, 0.0));
   rwy_lat_accum += lat_1;
   rwy_lon_accum += lon_1;
   rwy_count++;
 
-  double lat_2 = atof( token[7].c_str() );
-  double lon_2 = atof( token[8].c_str() );
+  double lat_2 = parseDouble(token[7]);
+  double lon_2 = parseDouble(token[8]);
   SGGeod pos_2(SGGeod::fromDegFt(lon_2, lat_2, 0.0));
   rwy_lat_accum += lat_2;
   rwy_lon_accum += lon_2;
@@ -658,8 +936,12 @@ void APTLoader::parseWaterRunwayLine850(const string& aptDat,
 
   last_rwy_heading = heading_1;
 
-  const string& rwy_no_1(token[3]);
-  const string& rwy_no_2(token[6]);
+  const string rwy_no_1(token[3]);
+  const string rwy_no_2(token[6]);
+
+  if (!cache) {
+    return;
+  }
 
   // For water runways we overload the edge_lights to indicate use of buoys,
   // as they too will be objects.  Also, water runways don't have edge lights.
@@ -677,7 +959,7 @@ void APTLoader::parseWaterRunwayLine850(const string& aptDat,
 }
 
 void APTLoader::parseHelipadLine850(const string& aptDat, unsigned int lineNum,
-                                    const vector<string>& token)
+                                    const FieldList& token)
 {
   if (token.size() < 12) {
     SG_LOG( SG_GENERAL, SG_WARN,
@@ -686,26 +968,30 @@ void APTLoader::parseHelipadLine850(const string& aptDat, unsigned int lineNum,
     return;
   }
 
-  double length = atof( token[5].c_str() );
-  double width = atof( token[6].c_str() );
+  double length = parseDouble(token[5]);
+  double width = parseDouble(token[6]);
 
-  double lat = atof( token[2].c_str() );
-  double lon = atof( token[3].c_str() );
+  double lat = parseDouble(token[2]);
+  double lon = parseDouble(token[3]);
   SGGeod pos(SGGeod::fromDegFt(lon, lat, 0.0));
   rwy_lat_accum += lat;
   rwy_lon_accum += lon;
   rwy_count++;
 
-  double heading = atof( token[4].c_str() );
+  double heading = parseDouble(token[4]);
 
   last_rwy_heading = heading;
 
-  const string& rwy_no(token[1]);
-  int surface_code = atoi( token[7].c_str() );
-  int markings = atoi( token[8].c_str() );
-  int shoulder_code = atoi( token[9].c_str() );
-  float smoothness = atof( token[10].c_str() );
-  int edge_lights = atoi( token[11].c_str() );
+  const string rwy_no(token[1]);
+  int surface_code = parseInt(token[7]);
+  int markings = parseInt(token[8]);
+  int shoulder_code = parseInt(token[9]);
+  float smoothness = parseDouble(token[10]);
+  int edge_lights = parseInt(token[11]);
+
+  if (!cache) {
+    return;
+  }
 
   cache->insertRunway(FGPositioned::HELIPAD, rwy_no, pos,
     currentAirportPosID, heading, length,
@@ -714,22 +1000,24 @@ void APTLoader::parseHelipadLine850(const string& aptDat, unsigned int lineNum,
 }
 
 void APTLoader::parseViewpointLine(const string& aptDat, unsigned int lineNum,
-                                   const vector<string>& token)
+                                   const FieldList& token)
 {
   if (token.size() < 5) {
     SG_LOG( SG_GENERAL, SG_WARN,
             aptDat << ":" << lineNum << ": invalid viewpoint line "
             "(row code 14): at least 5 fields are required" );
   } else {
-    double lat = atof(token[1].c_str());
-    double lon = atof(token[2].c_str());
-    double elev = atof(token[3].c_str());
+    double lat = parseDouble(token[1]);
+    double lon = parseDouble(token[2]);
+    double elev = parseDouble(token[3]);
     tower = SGGeod::fromDegFt(lon, lat, elev + last_apt_elev);
-    cache->insertTower(currentAirportPosID, tower);
+    if (cache) {
+      cache->insertTower(currentAirportPosID, tower);
+    }
   }
 }
 
-void APTLoader::parsePavementLine850(const vector<string>& token)
+void APTLoader::parsePavementLine850(const FieldList& token)
 {
   if ( token.size() >= 5 ) {
     pavement_ident = token[4];
@@ -744,7 +1032,7 @@ void APTLoader::parsePavementLine850(const vector<string>& token)
 void APTLoader::parseNodeLine850(NodeList *nodelist,
                                  const string& aptDat,
                                  unsigned int lineNum, int rowCode,
-                                 const vector<string>& token)
+                                 const FieldList& token)
 {
   static const unsigned int minNbTokens[] = {3, 5, 3, 5, 3, 5};
   assert(111 <= rowCode && rowCode <= 116);
@@ -757,8 +1045,8 @@ void APTLoader::parseNodeLine850(NodeList *nodelist,
     return;
   }
 
-  double lat = atof( token[1].c_str() );
-  double lon = atof( token[2].c_str() );
+  double lat = parseDouble(token[1]);
+  double lon = parseDouble(token[2]);
   SGGeod pos(SGGeod::fromDegFt(lon, lat, 0.0));
 
   FGPavement* pvt = 0;
@@ -777,18 +1065,18 @@ void APTLoader::parseNodeLine850(NodeList *nodelist,
   // is the light type of the segment.  Only applicable to codes 111-114.
   if ((rowCode < 115) && (token.size() == (minNbTokens[rowCode-111] + 1))) {
     // We've got a line paint code but no lighting code
-    paintCode = atoi(token[minNbTokens[rowCode-111]].c_str());
+    paintCode = parseInt(token[minNbTokens[rowCode-111]]);
   }
 
   if ((rowCode < 115) && (token.size() == (minNbTokens[rowCode-111] + 2))) {
     // We've got a line paint code and a lighting code
-    paintCode = atoi(token[minNbTokens[rowCode-111] -1].c_str());
-    lightCode = atoi(token[minNbTokens[rowCode-111]].c_str());
+    paintCode = parseInt(token[minNbTokens[rowCode-111] -1]);
+    lightCode = parseInt(token[minNbTokens[rowCode-111]]);
   }
 
   if ((rowCode == 112) || (rowCode == 114) || (rowCode == 116)) {
-    double lat_b = atof( token[3].c_str() );
-    double lon_b = atof( token[4].c_str() );
+    double lat_b = parseDouble(token[3]);
+    double lon_b = parseDouble(token[4]);
     SGGeod pos_b(SGGeod::fromDegFt(lon_b, lat_b, 0.0));
     pvt->addBezierNode(pos, pos_b, (rowCode == 114) || (rowCode == 116), (rowCode == 114), paintCode, lightCode);
   } else {
@@ -798,7 +1086,7 @@ void APTLoader::parseNodeLine850(NodeList *nodelist,
 
 void APTLoader::parseCommLine(const string& aptDat,
                               unsigned int lineNum, unsigned int rowCode,
-                              const vector<string>& token)
+                              const FieldList& token)
 {
   if (token.size() < 3) {
     SG_LOG( SG_GENERAL, SG_WARN,
@@ -824,7 +1112,7 @@ void APTLoader::parseCommLine(const string& aptDat,
   }
 
   // short int representing tens of kHz, or just kHz directly
-  int freqKhz = std::stoi(token[1]);
+  int freqKhz = parseInt(token[1]);
   if (isAPT1000Code) {
       const int channel = freqKhz % 25;
       if (channel != 0 && channel != 5 && channel != 10 && channel != 15) {
@@ -881,12 +1169,16 @@ void APTLoader::parseCommLine(const string& aptDat,
 
   // Name can contain whitespace. All tokens after the second token are
   // part of the name.
-  string name = token[2];
-  for (size_t i = 3; i < token.size(); ++i)
-    name += ' ' + token[i];
+  string name(token[2]);
+  for (size_t i = 3; i < token.size(); ++i) {
+    name += ' ';
+    name += token[i];
+  }
 
-  cache->insertCommStation(ty, name, pos, freqKhz, rangeNm,
-                           currentAirportPosID);
+  if (cache) {
+    cache->insertCommStation(ty, name, pos, freqKhz, rangeNm,
+                             currentAirportPosID);
+  }
 }
 
 // The 'metar.dat' file lists the airports that have METAR available.
@@ -25,7 +25,9 @@
 #ifndef _FG_APT_LOADER_HXX
 #define _FG_APT_LOADER_HXX
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include "airport.hxx"
@@ -37,26 +39,57 @@
 #include <Navaids/positioned.hxx>
 
 class NavDataCache;
-class sg_gzifstream;
 class FGPavement;
+class SGMMapFile;
 
 namespace flightgear
 {
 
+namespace aptdat
+{
+
+// Split 'line' at whitespace into 'fields' (which is cleared first). The
+// fields point into 'line'; nothing is allocated once 'fields' has grown
+// to the largest number of fields seen. If 'maxSplit' is non-zero, the
+// rest of the line after that many fields is returned as one more field,
+// like simgear::strutils::split(line, 0, maxSplit).
+void splitFields(std::string_view line, std::vector<std::string_view>& fields,
+                 std::size_t maxSplit = 0);
+
+// atof() / atoi() replacements for fields: leading whitespace and '+' are
+// skipped, trailing garbage is ignored and 0 is returned if 'field' does
+// not start with a number.
+double parseDouble(std::string_view field);
+int parseInt(std::string_view field);
+
+} // of namespace aptdat
+
 class APTLoader
 {
 public:
   APTLoader();
+  // A loader without a cache ('cache' is nullptr) parses every row in
+  // loadAirports() but stores nothing, e.g. to time or check apt.dat files.
+  explicit APTLoader(NavDataCache* cache);
   ~APTLoader();
 
-  // Read the specified apt.dat file into 'airportInfoMap'.
+  // Read the specified apt.dat file into 'airportInfoMap'. Uncompressed
+  // files are memory-mapped rather than read.
   // 'bytesReadSoFar' and 'totalSizeOfAllAptDatFiles' are used for progress
   // information.
   void readAptDatFile(const SGPath& aptdb_file, std::size_t bytesReadSoFar,
                       std::size_t totalSizeOfAllAptDatFiles);
-  // Read all airports gathered in 'airportInfoMap' and load them into the
-  // navdata cache (even in case of overlapping apt.dat files,
-  // 'airportInfoMap' has only one entry per airport).
+  // Same as above, for a file whose (decompressed) contents were already
+  // read into memory; the loader keeps them until it is destroyed. Large
+  // files are split at airport boundaries and the pieces scanned (split
+  // into lines and grouped by airport) concurrently; the result is the same
+  // as a serial scan. The rows themselves are parsed by loadAirports().
+  void readAptDatFile(const SGPath& aptdb_file, std::string contents,
+                      std::size_t bytesReadSoFar,
+                      std::size_t totalSizeOfAllAptDatFiles);
+  // Parse all airports gathered in 'airportInfoMap', on the calling thread,
+  // and load them into the navdata cache (even in case of overlapping
+  // apt.dat files, 'airportInfoMap' has only one entry per airport).
   void loadAirports();
 
   // Load a specific airport defined in aptdb_file, and return a "rich" view
@@ -64,14 +97,15 @@ public:
   const FGAirport* loadAirportFromFile(std::string id, const SGPath& aptdb_file);
 
 private:
+  // Lines refer to the contents of one of 'fileBuffers', without copying
   struct Line
   {
-    Line(unsigned int number_, unsigned int rowCode_, std::string str_)
+    Line(unsigned int number_, unsigned int rowCode_, std::string_view str_)
       : number(number_), rowCode(rowCode_), str(str_) { }
 
     unsigned int number;
     unsigned int rowCode;         // Terminology of the apt.dat spec
-    std::string str;
+    std::string_view str;
   };
 
   typedef std::vector<Line> LinesList;
@@ -84,52 +118,89 @@ private:
     unsigned int rowCode;
     // Line number in the apt.dat file where the airport definition starts
     unsigned int firstLineNum;
-    // The whitespace-separated strings comprising the first line of the airport
-    // definition
-    std::vector<std::string> firstLineTokens;
+    // The first line of the airport definition
+    std::string_view firstLine;
     // Subsequent lines of the airport definition (one element per line)
     LinesList otherLines;
   };
 
+  // Storage for the contents of an apt.dat file: a read-only mapping of an
+  // uncompressed file, or the decompressed contents of a gzipped one
+  struct FileBuffer
+  {
+    std::unique_ptr<SGMMapFile> mapping;
+    std::string contents;
+
+    std::string_view data() const;
+  };
+
   typedef std::unordered_map<std::string, RawAirportInfo> AirportInfoMapType;
+
+  // Airports in the order they were found in one piece of an apt.dat file,
+  // before duplicates are discarded
+  struct ScannedAirport
+  {
+    std::string_view id;
+    RawAirportInfo info;
+  };
+
+  typedef std::vector<ScannedAirport> ScannedAirportList;
+
+  // Progress of the scan of one file, shared by the threads scanning it
+  struct ScanProgress;
   typedef SGSharedPtr<FGPavement> FGPavementPtr;
   typedef std::vector<FGPavementPtr> NodeList;
+  typedef std::vector<std::string_view> FieldList;
 
   APTLoader(const APTLoader&);            // disable copy constructor
   APTLoader& operator=(const APTLoader&); // disable copy-assignment operator
 
-  const FGAirport* loadAirport(const string aptDat, const std::string airportID, RawAirportInfo* airport_info, bool createFGAirport=false);
+  void readAptDatBuffer(const SGPath& aptdb_file, const FileBuffer& buffer,
+                        std::size_t bytesReadSoFar,
+                        std::size_t totalSizeOfAllAptDatFiles);
+
+  const FGAirport* loadAirport(const string& aptDat, const std::string& airportID,
+                               const RawAirportInfo* airport_info, bool createFGAirport=false);
+
+  // Scan the apt.dat lines in [begin, end), which must start at an airport
+  // header (or right after the file header), into 'result'.
+  static void scanAptDatChunk(const SGPath& aptdb_file, const char* begin,
+                              const char* end, unsigned int lineNumBefore,
+                              ScannedAirportList& result,
+                              ScanProgress& progress);
+
+  // Split 'line' into the re-used 'token' list
+  const FieldList& tokenize(std::string_view line, std::size_t maxSplit = 0);
 
   // Tell whether an apt.dat line is blank or a comment line
-  bool isBlankOrCommentLine(const std::string& line);
+  static bool isBlankOrCommentLine(std::string_view line);
   // Return a copy of 'line' with trailing '\r' char(s) removed
-  std::string cleanLine(const std::string& line);
-  void throwExceptionIfStreamError(const sg_gzifstream& input_stream,
-                                   const SGPath& path);
-  void parseAirportLine(unsigned int rowCode,
-                        const std::vector<std::string>& token);
+  std::string cleanLine(std::string_view line);
+  void parseAirportLine(unsigned int rowCode, const FieldList& token);
   void finishAirport(const std::string& aptDat);
   void parseRunwayLine810(const std::string& aptDat, unsigned int lineNum,
-                          const std::vector<std::string>& token);
+                          const FieldList& token);
   void parseRunwayLine850(const std::string& aptDat, unsigned int lineNum,
-                          const std::vector<std::string>& token);
+                          const FieldList& token);
   void parseWaterRunwayLine850(const std::string& aptDat, unsigned int lineNum,
-                               const std::vector<std::string>& token);
+                               const FieldList& token);
   void parseHelipadLine850(const std::string& aptDat, unsigned int lineNum,
-                           const std::vector<std::string>& token);
+                           const FieldList& token);
   void parseViewpointLine(const std::string& aptDat, unsigned int lineNum,
-                          const std::vector<std::string>& token);
-  void parsePavementLine850(const std::vector<std::string>& token);
+                          const FieldList& token);
+  void parsePavementLine850(const FieldList& token);
   void parseNodeLine850(
     NodeList *nodelist,
     const std::string& aptDat, unsigned int lineNum, int rowCode,
-    const std::vector<std::string>& token);
+    const FieldList& token);
 
   void parseCommLine(
     const std::string& aptDat, unsigned int lineNum, unsigned int rowCode,
-    const std::vector<std::string>& token);
+    const FieldList& token);
 
-  std::vector<std::string> token;
+  // re-used for every line, so tokenizing doesn't allocate
+  FieldList token;
+  std::vector<std::unique_ptr<FileBuffer>> fileBuffers;
   AirportInfoMapType airportInfoMap;
   double rwy_lat_accum;
   double rwy_lon_accum;
@@ -27,8 +27,8 @@
 #include <cmath>
 #include <algorithm>
 #include <fstream>
-#include <map>
 #include <iterator>
+#include <queue>
 
 #include <simgear/debug/logstream.hxx>
 #include <simgear/scene/util/OsgMath.hxx>
@@ -218,6 +218,8 @@ void FGGroundNetwork::init()
       m_segmentsEndingAtNodeMap.insert(NodeFromSegmentMap::value_type{segment->getEnd(), segment});
     }
 
+    // segment indices are only assigned above
+    invalidateRouteCache();
     networkInitialized = true;
 }
 
@@ -431,91 +433,186 @@ FGTaxiSegment* FGGroundNetwork::findSegment(const FGTaxiNode* from, const FGTaxi
     return NULL; // not found
 }
 
-static int edgePenalty(FGTaxiNode* tn)
+static int edgePenalty(const FGTaxiNode* tn)
 {
   return (tn->type() == FGPositioned::PARKING ? 10000 : 0) +
     (tn->getIsOnRunway() ? 1000 : 0);
 }
 
-class ShortestPathData
+namespace {
+
+// number of (start, end) pairs memoised by findShortestRoute
+const size_t ROUTE_CACHE_SIZE = 256;
+
+struct OpenNode
 {
-public:
-  ShortestPathData() :
-    score(HUGE_VAL)
-  {}
+    double f; // score so far plus heuristic
+    int node;
 
-  double score;
-  FGTaxiNodeRef previousNode;
+    bool operator<(const OpenNode& other) const
+    {
+        // std::priority_queue is a max-heap, we want the lowest f first
+        return f > other.f;
+    }
 };
 
+} // of anonymous namespace
+
+void FGGroundNetwork::invalidateRouteCache()
+{
+    m_searchGraphValid = false;
+    m_routeCache.clear();
+    m_routeCacheIndex.clear();
+}
+
+void FGGroundNetwork::buildSearchGraph()
+{
+    const int nodeCount = static_cast<int>(m_nodes.size());
+
+    m_nodeIndexMap.clear();
+    m_nodeIndexMap.reserve(nodeCount);
+    m_nodeCart.resize(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        m_nodeIndexMap[m_nodes[i].ptr()] = i;
+        m_nodeCart[i] = m_nodes[i]->cart();
+    }
+
+    // counting pass, then fill; segments keep their original order so the
+    // first of several parallel segments wins, as with findSegment()
+    m_edgeStart.assign(nodeCount + 1, 0);
+    for (auto seg : segments) {
+        m_edgeStart[m_nodeIndexMap[seg->startNode] + 1]++;
+    }
+
+    for (int i = 0; i < nodeCount; ++i) {
+        m_edgeStart[i + 1] += m_edgeStart[i];
+    }
+
+    const size_t edgeCount = segments.size();
+    m_edgeTarget.resize(edgeCount);
+    m_edgeSegment.resize(edgeCount);
+    m_edgeCost.resize(edgeCount);
+
+    std::vector<int> fill(m_edgeStart.begin(), m_edgeStart.end() - 1);
+    for (auto seg : segments) {
+        const int from = m_nodeIndexMap[seg->startNode];
+        const int to = m_nodeIndexMap[seg->endNode];
+        const int e = fill[from]++;
+        m_edgeTarget[e] = to;
+        m_edgeSegment[e] = seg->getIndex();
+        m_edgeCost[e] = dist(m_nodeCart[from], m_nodeCart[to]) + edgePenalty(seg->endNode);
+    }
+
+    m_searchGraphValid = true;
+}
+
 FGTaxiRoute FGGroundNetwork::findShortestRoute(FGTaxiNode* start, FGTaxiNode* end, bool fullSearch)
 {
     if (!start || !end) {
         throw sg_exception("Bad arguments to findShortestRoute");
     }
-//implements Dijkstra's algorithm to find shortest distance route from start to end
-//taken from http://en.wikipedia.org/wiki/Dijkstra's_algorithm
-    FGTaxiNodeVector unvisited(m_nodes);
-    std::map<FGTaxiNode*, ShortestPathData> searchData;
 
-    searchData[start].score = 0.0;
+    if (!m_searchGraphValid) {
+        buildSearchGraph();
+    }
 
-    while (!unvisited.empty()) {
-        // find lowest scored unvisited
-        FGTaxiNodeRef best = unvisited.front();
-        for (auto i : unvisited) {
-            if (searchData[i].score < searchData[best].score) {
-                best = i;
-            }
+    auto startIt = m_nodeIndexMap.find(start);
+    auto endIt = m_nodeIndexMap.find(end);
+    if ((startIt == m_nodeIndexMap.end()) || (endIt == m_nodeIndexMap.end())) {
+        if (fullSearch) {
+            SG_LOG(SG_GENERAL, SG_ALERT,
+                   "Failed to find route from waypoint " << start->getIndex() << " to "
+                   << end->getIndex() << " at " << parent->getId() << ": node not in ground network");
         }
 
-      // remove 'best' from the unvisited set
-        FGTaxiNodeVectorIterator newend =
-            remove(unvisited.begin(), unvisited.end(), best);
-        unvisited.erase(newend, unvisited.end());
+        return FGTaxiRoute();
+    }
+
+    const int startIndex = startIt->second;
+    const int endIndex = endIt->second;
+    const uint64_t key = (static_cast<uint64_t>(startIndex) << 32) | static_cast<uint32_t>(endIndex);
+
+    auto cached = m_routeCacheIndex.find(key);
+    if (cached != m_routeCacheIndex.end()) {
+        // move to the front of the LRU list
+        m_routeCache.splice(m_routeCache.begin(), m_routeCache, cached->second);
+        return cached->second->route;
+    }
+
+    // A* search. Edge costs are straight-line (ECEF chord) distances plus a
+    // non-negative penalty, so the chord distance to the goal never
+    // overestimates and the result is the same as a plain Dijkstra search.
+    const size_t nodeCount = m_nodes.size();
+    const SGVec3d& goal = m_nodeCart[endIndex];
+    std::vector<double> score(nodeCount, HUGE_VAL);
+    std::vector<int> previous(nodeCount, -1);
+    std::vector<int> previousSegment(nodeCount, 0);
+    std::vector<bool> closed(nodeCount, false);
+    std::priority_queue<OpenNode> open;
+
+    score[startIndex] = 0.0;
+    open.push({dist(m_nodeCart[startIndex], goal), startIndex});
+
+    while (!open.empty()) {
+        const int best = open.top().node;
+        open.pop();
+
+        if (closed[best]) {
+            continue; // stale heap entry
+        }
 
-        if (best == end) { // found route or best not connected
+        closed[best] = true;
+        if (best == endIndex) {
             break;
         }
 
-        for (auto target : findSegmentsFrom(best)) {
-            double edgeLength = dist(best->cart(), target->cart());
-            double alt = searchData[best].score + edgeLength + edgePenalty(target);
-            if (alt < searchData[target].score) {    // Relax (u,v)
-                searchData[target].score = alt;
-                searchData[target].previousNode = best;
+        for (int e = m_edgeStart[best]; e < m_edgeStart[best + 1]; ++e) {
+            const int target = m_edgeTarget[e];
+            if (closed[target]) {
+                continue;
+            }
+
+            const double alt = score[best] + m_edgeCost[e];
+            if (alt < score[target]) { // Relax (u,v)
+                score[target] = alt;
+                previous[target] = best;
+                previousSegment[target] = m_edgeSegment[e];
+                open.push({alt + dist(m_nodeCart[target], goal), target});
             }
         } // of outgoing arcs/segments from current best node iteration
-    } // of unvisited nodes remaining
+    } // of open nodes remaining
 
-    if (searchData[end].score == HUGE_VAL) {
+    FGTaxiRoute result;
+    if (score[endIndex] == HUGE_VAL) {
         // no valid route found
-        if (fullSearch && start && end) {
+        if (fullSearch) {
             SG_LOG(SG_GENERAL, SG_ALERT,
                    "Failed to find route from waypoint " << start->getIndex() << " to "
                    << end->getIndex() << " at " << parent->getId());
         }
+    } else {
+        // assemble route from backtrace information
+        FGTaxiNodeVector nodes;
+        intVec routes;
+        for (int bt = endIndex; previous[bt] != -1; bt = previous[bt]) {
+            nodes.push_back(m_nodes[bt]);
+            routes.push_back(previousSegment[bt]);
+        }
 
-        return FGTaxiRoute();
+        nodes.push_back(start);
+        reverse(nodes.begin(), nodes.end());
+        reverse(routes.begin(), routes.end());
+        result = FGTaxiRoute(nodes, routes, score[endIndex], 0);
     }
 
-    // assemble route from backtrace information
-    FGTaxiNodeVector nodes;
-    intVec routes;
-    FGTaxiNode *bt = end;
-
-    while (searchData[bt].previousNode != 0) {
-        nodes.push_back(bt);
-        FGTaxiSegment *segment = findSegment(searchData[bt].previousNode, bt);
-        int idx = segment->getIndex();
-        routes.push_back(idx);
-        bt = searchData[bt].previousNode;
-
+    m_routeCache.push_front({key, result});
+    m_routeCacheIndex[key] = m_routeCache.begin();
+    if (m_routeCache.size() > ROUTE_CACHE_SIZE) {
+        m_routeCacheIndex.erase(m_routeCache.back().key);
+        m_routeCache.pop_back();
     }
-    nodes.push_back(start);
-    reverse(nodes.begin(), nodes.end());
-    reverse(routes.begin(), routes.end());
-    return FGTaxiRoute(nodes, routes, searchData[end].score, 0);
+
+    return result;
 }
 
 void FGGroundNetwork::unblockAllSegments(time_t now)
@@ -578,6 +675,7 @@ void FGGroundNetwork::addSegment(const FGTaxiNodeRef &from, const FGTaxiNodeRef
 {
     FGTaxiSegment* seg = new FGTaxiSegment(from, to);
     segments.push_back(seg);
+    invalidateRouteCache();
 
     FGTaxiNodeVector::iterator it = std::find(m_nodes.begin(), m_nodes.end(), from);
     if (it == m_nodes.end()) {
@@ -593,7 +691,7 @@ void FGGroundNetwork::addSegment(const FGTaxiNodeRef &from, const FGTaxiNodeRef
 void FGGroundNetwork::addParking(const FGParkingRef &park)
 {
     m_parkings.push_back(park);
-
+    invalidateRouteCache();
 
     FGTaxiNodeVector::iterator it = std::find(m_nodes.begin(), m_nodes.end(), park);
     if (it == m_nodes.end()) {
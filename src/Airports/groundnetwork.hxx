@@ -26,8 +26,11 @@
 
 #include <simgear/compiler.h>
 
+#include <cstdint>
+#include <list>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "gnnode.hxx"
 #include "parking.hxx"
@@ -165,6 +168,9 @@ public:
     int nodesLeft() {
         return nodes.end() - currNode;
     };
+    double getDistance() const {
+        return distance;
+    };
 };
 
 /**************************************************************************************
@@ -231,6 +237,33 @@ private:
     /// this map exists specifcially to make blockSegmentsEndingAt not be a bottleneck
     NodeFromSegmentMap m_segmentsEndingAtNodeMap;
 
+    /**
+     * Compact adjacency-array (CSR) copy of the taxi graph, used by
+     * findShortestRoute. Nodes are addressed by a dense index into
+     * m_nodes; the outgoing edges of node i are the range
+     * [m_edgeStart[i], m_edgeStart[i+1]) of the m_edge* arrays.
+     * Built lazily and discarded whenever the topology changes.
+     */
+    bool m_searchGraphValid = false;
+    std::unordered_map<const FGTaxiNode*, int> m_nodeIndexMap;
+    std::vector<SGVec3d> m_nodeCart;
+    std::vector<int> m_edgeStart;
+    std::vector<int> m_edgeTarget;
+    std::vector<int> m_edgeSegment;
+    std::vector<double> m_edgeCost;
+
+    void buildSearchGraph();
+
+    /// LRU cache of recently computed routes, keyed by (start, end) dense index
+    struct CachedRoute {
+        uint64_t key;
+        FGTaxiRoute route;
+    };
+
+    using RouteCacheList = std::list<CachedRoute>;
+    RouteCacheList m_routeCache;
+    std::unordered_map<uint64_t, RouteCacheList::iterator> m_routeCacheIndex;
+
 public:
     FGGroundNetwork(FGAirport* pr);
     ~FGGroundNetwork();
@@ -277,8 +310,19 @@ public:
     FGTaxiNodeVector findSegmentsFrom(const FGTaxiNodeRef& from) const;
 
 
+    /**
+     * A* search over the taxi graph. Results are memoised in a small LRU
+     * cache, so repeated requests for the same pair of nodes (typical for
+     * AI traffic pushing back from the same gates) are cheap.
+     */
     FGTaxiRoute findShortestRoute(FGTaxiNode* start, FGTaxiNode* end, bool fullSearch=true);
 
+    /**
+     * Drop the cached search graph and routes. Must be called whenever
+     * the segment topology or the inputs to the edge penalty change.
+     */
+    void invalidateRouteCache();
+
 
     void blockSegmentsEndingAt(FGTaxiSegment* seg, int blockId,
                                time_t blockTime, time_t now);
@@ -20,6 +20,7 @@
 #include <simgear/timing/sg_time.hxx>
 #include <simgear/sg_inlines.h>
 
+#include <Main/FrameProfiler.hxx>
 #include <Main/globals.hxx>
 #include "Main/fg_props.hxx"
 #include "Navaids/positioned.hxx"
@@ -483,6 +484,7 @@ void FGRouteMgr::setFlightPlan(const FlightPlanRef& plan)
 
 void FGRouteMgr::update( double dt )
 {
+  FG_PROFILE_SCOPE("subsystems/route-manager");
   if (dt <= 0.0) {
     return; // paused, nothing to do here
   }
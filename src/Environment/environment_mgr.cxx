@@ -31,6 +31,7 @@
 #include <simgear/scene/model/particles.hxx>
 #include <simgear/structure/event_mgr.hxx>
 
+#include <Main/FrameProfiler.hxx>
 #include <Main/main.hxx>
 #include <Main/fg_props.hxx>
 #include <Viewer/renderer.hxx>
@@ -268,6 +269,7 @@ FGEnvironmentMgr::unbind ()
 void
 FGEnvironmentMgr::update (double dt)
 {
+  FG_PROFILE_SCOPE("subsystems/environment");
   SGGeod aircraftPos(globals->get_aircraft_position());
 
   SGSubsystemGroup::update(dt);
@@ -45,6 +45,7 @@ INCLUDES
 #include <iomanip>
 
 #include "FGFDMExec.h"
+#include "FGWorkerPool.h"
 #include "models/atmosphere/FGStandardAtmosphere.h"
 #include "models/atmosphere/FGWinds.h"
 #include "models/FGFCS.h"
@@ -92,6 +93,7 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root, unsigned int* fdmctr)
   ResetMode = 0;
   RandomSeed = 0;
   HoldDown = false;
+  CompileFunctions = true;
 
   IncrementThenHolding = false;  // increment then hold is off by default
   TimeStepsUntilHold = -1;
@@ -180,6 +182,10 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root, unsigned int* fdmctr)
 
 FGFDMExec::~FGFDMExec()
 {
+  // The child FDMs use the property tree and FDM counter of this one
+  for (auto child: ChildFDMList) delete child;
+  ChildFDMList.clear();
+
   try {
     Unbind();
     DeAllocate();
@@ -201,8 +207,6 @@ FGFDMExec::~FGFDMExec()
     cout << "Caught error: " << msg << endl;
   }
 
-  for (unsigned int i=1; i<ChildFDMList.size(); i++) delete ChildFDMList[i]->exec;
-
   if (FDMctr != 0) (*FDMctr)--;
 
   Debug(1);
@@ -328,9 +332,32 @@ bool FGFDMExec::Run(void)
 
   Debug(2);
 
-  for (unsigned int i=1; i<ChildFDMList.size(); i++) {
-    ChildFDMList[i]->AssignState( (FGPropagate*)Models[ePropagate] ); // Transfer state to the child FDM
-    ChildFDMList[i]->Run();
+  if (WorkerPool && ChildFDMList.size() > 1) {
+    // The child FDMs only depend on the state of this FDM, which does not
+    // change until they are all done.
+    for (auto child: ChildFDMList)
+      child->AssignState( (FGPropagate*)Models[ePropagate] ); // Transfer state to the child FDM
+
+    // Listeners are left to the calling thread: the children which have
+    // some are run once the others are done, which gives the same results
+    // as they are independent of each other.
+    vector<char> deferred(ChildFDMList.size(), 0);
+    WorkerPool->Run(ChildFDMList.size(), [this, &deferred](unsigned int i) {
+      FGFDMExec* child = ChildFDMList[i]->exec;
+      if (child->instance->GetNode()->HasListeners())
+        deferred[i] = 1;
+      else
+        child->Run();
+    });
+
+    for (unsigned int i=0; i<ChildFDMList.size(); i++) {
+      if (deferred[i]) ChildFDMList[i]->Run();
+    }
+  } else {
+    for (auto child: ChildFDMList) {
+      child->AssignState( (FGPropagate*)Models[ePropagate] ); // Transfer state to the child FDM
+      child->Run();
+    }
   }
 
   IncrTime();
@@ -646,8 +673,8 @@ vector <string> FGFDMExec::EnumerateFDMs(void)
 
   FDMList.push_back(Aircraft->GetAircraftName());
 
-  for (unsigned int i=1; i<ChildFDMList.size(); i++) {
-    FDMList.push_back(ChildFDMList[i]->exec->GetAircraft()->GetAircraftName());
+  for (auto child: ChildFDMList) {
+    FDMList.push_back(child->exec->GetAircraft()->GetAircraftName());
   }
 
   return FDMList;
@@ -876,14 +903,16 @@ bool FGFDMExec::LoadModel(const string& model, bool addModelToPath)
       element = document->FindNextElement("output");
     }
 
-    // Lastly, process the child element. This element is OPTIONAL - and NOT YET SUPPORTED.
+    // Lastly, process the child elements. These are OPTIONAL.
     element = document->FindElement("child");
-    if (element) {
+    while (element) {
       result = ReadChild(element);
       if (!result) {
         cerr << endl << "Aircraft child element has problems in file " << aircraftCfgFileName << endl;
         return result;
       }
+
+      element = document->FindNextElement("child");
     }
 
     // Since all vehicle characteristics have been loaded, place the values in the Inputs
@@ -1082,6 +1111,8 @@ bool FGFDMExec::ReadChild(Element* el)
 
   child->exec = new FGFDMExec(Root, FDMctr);
   child->exec->SetChild(true);
+  child->exec->SetCompileFunctions(CompileFunctions);
+  child->exec->SetWorkerPool(WorkerPool);
 
   string childAircraft = el->GetAttributeValue("name");
   string sMated = el->GetAttributeValue("mated");
@@ -1118,6 +1149,15 @@ bool FGFDMExec::ReadChild(Element* el)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGFDMExec::SetWorkerPool(const shared_ptr<FGWorkerPool>& pool)
+{
+  WorkerPool = pool;
+
+  for (auto child: ChildFDMList) child->exec->SetWorkerPool(pool);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 FGPropertyManager* FGFDMExec::GetPropertyManager(void)
 {
   return instance;
@@ -71,6 +71,7 @@ class FGInput;
 class FGPropulsion;
 class FGMassBalance;
 class FGTrim;
+class FGWorkerPool;
 
 class TrimFailureException : public BaseException {
   public:
@@ -619,6 +620,28 @@ public:
   const std::shared_ptr<std::default_random_engine>& GetRandomEngine(void) const
   { return RandomEngine; }
 
+  /** Sets whether the functions that are loaded from now on are compiled to
+      flat programs (the default), or evaluated by walking their tree.
+      @see FGCompiledFunction */
+  void SetCompileFunctions(bool compile) { CompileFunctions = compile; }
+
+  /// Whether functions are compiled when they are loaded.
+  bool GetCompileFunctions(void) const { return CompileFunctions; }
+
+  /** Sets the pool of threads that runs the child FDMs. With a pool, Run()
+      first hands the current state to every child FDM, then runs them all at
+      once and waits for them before running the models of this FDM. Without
+      one (the default) they are run one after the other. The pool is passed
+      on to the child FDMs, loaded or yet to be loaded, and may be shared with
+      other FGFDMExec instances.
+      @param pool the worker pool, or nullptr to run the child FDMs serially
+      @see FGWorkerPool */
+  void SetWorkerPool(const std::shared_ptr<FGWorkerPool>& pool);
+
+  /// The pool of threads that runs the child FDMs, if any.
+  const std::shared_ptr<FGWorkerPool>& GetWorkerPool(void) const
+  { return WorkerPool; }
+
 private:
   unsigned int Frame;
   unsigned int IdFDM;
@@ -674,6 +697,8 @@ private:
   FGPropertyManager* instance;
 
   bool HoldDown;
+  bool CompileFunctions;
+  std::shared_ptr<FGWorkerPool> WorkerPool;
 
   int RandomSeed;
   std::shared_ptr<std::default_random_engine> RandomEngine;
@@ -80,8 +80,9 @@ const string FGJSBBase::JSBSim_version = JSBSIM_VERSION " " __DATE__ " " __TIME_
 queue <FGJSBBase::Message> FGJSBBase::Messages;
 FGJSBBase::Message FGJSBBase::localMsg;
 unsigned int FGJSBBase::messageId = 0;
+mutex FGJSBBase::MessageMutex;
 
-int FGJSBBase::gaussian_random_number_phase = 0;
+thread_local int FGJSBBase::gaussian_random_number_phase = 0;
 
 short FGJSBBase::debug_lvl  = 1;
 
@@ -89,6 +90,7 @@ short FGJSBBase::debug_lvl  = 1;
 
 void FGJSBBase::PutMessage(const Message& msg)
 {
+  lock_guard<mutex> lock(MessageMutex);
   Messages.push(msg);
 }
 
@@ -96,6 +98,7 @@ void FGJSBBase::PutMessage(const Message& msg)
 
 void FGJSBBase::PutMessage(const string& text)
 {
+  lock_guard<mutex> lock(MessageMutex);
   Message msg;
   msg.text = text;
   msg.messageId = messageId++;
@@ -108,6 +111,7 @@ void FGJSBBase::PutMessage(const string& text)
 
 void FGJSBBase::PutMessage(const string& text, bool bVal)
 {
+  lock_guard<mutex> lock(MessageMutex);
   Message msg;
   msg.text = text;
   msg.messageId = messageId++;
@@ -121,6 +125,7 @@ void FGJSBBase::PutMessage(const string& text, bool bVal)
 
 void FGJSBBase::PutMessage(const string& text, int iVal)
 {
+  lock_guard<mutex> lock(MessageMutex);
   Message msg;
   msg.text = text;
   msg.messageId = messageId++;
@@ -134,6 +139,7 @@ void FGJSBBase::PutMessage(const string& text, int iVal)
 
 void FGJSBBase::PutMessage(const string& text, double dVal)
 {
+  lock_guard<mutex> lock(MessageMutex);
   Message msg;
   msg.text = text;
   msg.messageId = messageId++;
@@ -147,6 +153,7 @@ void FGJSBBase::PutMessage(const string& text, double dVal)
 
 void FGJSBBase::ProcessMessage(void)
 {
+  lock_guard<mutex> lock(MessageMutex);
   if (Messages.empty()) return;
   localMsg = Messages.front();
 
@@ -179,6 +186,7 @@ void FGJSBBase::ProcessMessage(void)
 
 FGJSBBase::Message* FGJSBBase::ProcessNextMessage(void)
 {
+  lock_guard<mutex> lock(MessageMutex);
   if (Messages.empty()) return NULL;
   localMsg = Messages.front();
 
@@ -216,7 +224,7 @@ string FGJSBBase::CreateIndexedPropertyName(const string& Property, int index)
 
 double FGJSBBase::GaussianRandomNumber(void)
 {
-  static double V1, V2, S;
+  static thread_local double V1, V2, S;
   double X;
 
   if (gaussian_random_number_phase == 0) {
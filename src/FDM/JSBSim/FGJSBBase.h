@@ -39,6 +39,7 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include <float.h>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <cmath>
@@ -345,6 +346,9 @@ protected:
 
   static unsigned int messageId;
 
+  /// Guards the message queue, which models running on worker threads share.
+  static std::mutex MessageMutex;
+
   static constexpr double radtodeg = 180. / M_PI;
   static constexpr double degtorad = M_PI / 180.;
   static constexpr double hptoftlbssec = 550.0;
@@ -372,7 +376,7 @@ protected:
 
   static std::string CreateIndexedPropertyName(const std::string& Property, int index);
 
-  static int gaussian_random_number_phase;
+  static thread_local int gaussian_random_number_phase;
 
 public:
 /// Moments L, M, N
@@ -0,0 +1,163 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module: FGWorkerPool.cpp
+Date started: October 2026
+Purpose: Runs batches of independent tasks on a fixed set of threads
+
+ ------------- Copyright (C) 2026  The FlightGear Team -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or (at your option) any
+ later version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along
+ with this program; if not, write to the Free Software Foundation, Inc., 59
+ Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be
+ found on the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGWorkerPool.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+thread_local bool FGWorkerPool::InTask = false;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGWorkerPool::FGWorkerPool(unsigned int threads)
+  : Task(nullptr), Count(0), Next(0), Batch(0), Pending(0), Active(0),
+    Quit(false)
+{
+  if (threads == 0) threads = thread::hardware_concurrency();
+
+  for (unsigned int i=1; i<threads; i++)
+    Workers.emplace_back(&FGWorkerPool::Work, this);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGWorkerPool::~FGWorkerPool()
+{
+  {
+    lock_guard<mutex> lock(Mutex);
+    Quit = true;
+  }
+  Start.notify_all();
+
+  for (auto& worker: Workers) worker.join();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGWorkerPool::Run(unsigned int count,
+                       const function<void(unsigned int)>& task)
+{
+  if (Workers.empty() || InTask || count < 2) {
+    exception_ptr error;
+
+    for (unsigned int i=0; i<count; i++) {
+      try {
+        task(i);
+      } catch (...) {
+        if (!error) error = current_exception();
+      }
+    }
+
+    if (error) rethrow_exception(error);
+    return;
+  }
+
+  lock_guard<mutex> batch(RunMutex);
+
+  {
+    lock_guard<mutex> lock(Mutex);
+    Task = &task;
+    Count = count;
+    Next = 0;
+    Pending = count;
+    Error = nullptr;
+    Batch++;
+  }
+  Start.notify_all();
+
+  unsigned int done = Execute();
+
+  unique_lock<mutex> lock(Mutex);
+  Pending -= done;
+  // Wait for the workers that joined the batch to leave it, even if the tasks
+  // are all done already: they still hold a pointer to the task.
+  Done.wait(lock, [this]{ return Pending == 0 && Active == 0; });
+  Task = nullptr;
+
+  if (Error) {
+    exception_ptr error = Error;
+    Error = nullptr;
+    rethrow_exception(error);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGWorkerPool::Work(void)
+{
+  unsigned long batch = 0;
+  unique_lock<mutex> lock(Mutex);
+
+  while (true) {
+    Start.wait(lock, [&]{ return Quit || (Task && Batch != batch); });
+    if (Quit) return;
+
+    batch = Batch;
+    Active++;
+    lock.unlock();
+
+    unsigned int done = Execute();
+
+    lock.lock();
+    Active--;
+    Pending -= done;
+    if (Pending == 0 && Active == 0) Done.notify_all();
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Runs tasks of the current batch until none are left, and returns how many.
+
+unsigned int FGWorkerPool::Execute(void)
+{
+  unsigned int done = 0;
+  unsigned int i;
+
+  InTask = true;
+  while ((i = Next++) < Count) {
+    try {
+      (*Task)(i);
+    } catch (...) {
+      lock_guard<mutex> lock(Mutex);
+      if (!Error) Error = current_exception();
+    }
+    done++;
+  }
+  InTask = false;
+
+  return done;
+}
+
+} // namespace JSBSim
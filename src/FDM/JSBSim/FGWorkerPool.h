@@ -0,0 +1,137 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header: FGWorkerPool.h
+Date started: October 2026
+
+ ------------- Copyright (C) 2026  The FlightGear Team -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or (at your option) any
+ later version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along
+ with this program; if not, write to the Free Software Foundation, Inc., 59
+ Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be
+ found on the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGWORKERPOOL_H
+#define FGWORKERPOOL_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** A fixed set of threads that run batches of independent tasks.
+
+    Run() hands out the tasks of a batch to the worker threads and to the
+    calling thread, and returns once all of them are done, so each call is a
+    synchronization point: whatever the tasks wrote is visible to the caller
+    afterwards, and whatever the caller wrote before is visible to the tasks.
+
+    FGFDMExec uses a pool to run its child FDMs at the same time, and several
+    FGFDMExec instances can share one pool, e.g. to step a number of
+    independent aircraft at once:
+
+    @code
+    FGWorkerPool pool(4);
+    pool.Run(fdms.size(), [&](unsigned int i) { fdms[i]->Run(); });
+    @endcode
+
+    A batch started from within a task (for instance an FDM with child FDMs
+    run by a pool that also runs its parent) is executed serially by the
+    thread that started it.
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DECLARATION: FGWorkerPool
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGWorkerPool
+{
+public:
+  /** Constructor.
+      @param threads the number of threads that run the tasks, including the
+                     thread calling Run(). 0 uses one thread per core, 1 runs
+                     every task on the calling thread. */
+  explicit FGWorkerPool(unsigned int threads = 0);
+  ~FGWorkerPool();
+
+  FGWorkerPool(const FGWorkerPool&) = delete;
+  FGWorkerPool& operator=(const FGWorkerPool&) = delete;
+
+  /** Calls task(i) for i = 0 ... count-1 and returns when all calls have
+      returned. The calls are made in no particular order and from several
+      threads at once. If a call throws, the remaining tasks are still run and
+      the first exception is then rethrown by Run().
+      @param count the number of tasks
+      @param task the function called for each task index */
+  void Run(unsigned int count, const std::function<void(unsigned int)>& task);
+
+  /// The number of threads that run the tasks, including the calling thread.
+  unsigned int GetNumThreads(void) const
+  { return static_cast<unsigned int>(Workers.size()) + 1; }
+
+private:
+  void Work(void);
+  unsigned int Execute(void);
+
+  std::vector<std::thread> Workers;
+
+  /// Serializes batches that are started from several threads.
+  std::mutex RunMutex;
+
+  std::mutex Mutex;
+  std::condition_variable Start;
+  std::condition_variable Done;
+
+  // The current batch. Set by Run() while holding Mutex, read by the workers
+  // that joined it.
+  const std::function<void(unsigned int)>* Task;
+  unsigned int Count;
+  std::atomic<unsigned int> Next;
+  unsigned long Batch;
+
+  unsigned int Pending; ///< tasks of the batch that are not done yet
+  unsigned int Active;  ///< workers that joined the batch and have not left it
+  std::exception_ptr Error;
+  bool Quit;
+
+  /// Whether the current thread is running a task of any pool.
+  static thread_local bool InTask;
+};
+
+} // namespace JSBSim
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#endif
@@ -41,6 +41,7 @@ INCLUDES
 
 #include "initialization/FGTrim.h"
 #include "FGFDMExec.h"
+#include "FGWorkerPool.h"
 #include "input_output/FGXMLFileRead.h"
 
 #if !defined(__GNUC__) && !defined(sgi) && !defined(_MSC_VER)
@@ -66,8 +67,11 @@ INCLUDES
 #  include <sys/time.h>
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <cstdlib>
+#include <memory>
+#include <thread>
 
 using namespace std;
 using JSBSim::FGXMLFileRead;
@@ -93,6 +97,8 @@ bool play_nice;
 bool suspend;
 bool catalog;
 bool nohighlight;
+bool interpret_functions;
+unsigned int benchmark_copies;
 
 double end_time = 1e99;
 double simulation_rate = 1./120.;
@@ -105,6 +111,7 @@ FORWARD DECLARATIONS
 
 bool options(int, char**);
 int real_main(int argc, char* argv[]);
+int run_benchmark(void);
 void PrintHelp(void);
 
 #if defined(__BORLANDC__) || defined(_MSC_VER) || defined(__MINGW32__)
@@ -327,6 +334,8 @@ int real_main(int argc, char* argv[])
   suspend = false;
   catalog = false;
   nohighlight = false;
+  interpret_functions = false;
+  benchmark_copies = 0;
 
   // *** PARSE OPTIONS PASSED INTO THIS SPECIFIC APPLICATION: JSBSim *** //
   success = options(argc, argv);
@@ -335,6 +344,8 @@ int real_main(int argc, char* argv[])
     exit(-1);
   }
 
+  if (benchmark_copies > 0) return run_benchmark();
+
   // *** SET UP JSBSIM *** //
   FDMExec = new JSBSim::FGFDMExec();
   FDMExec->SetRootDir(RootDir);
@@ -345,6 +356,7 @@ int real_main(int argc, char* argv[])
   FDMExec->GetPropertyManager()->Tie("simulation/cycle_duration", &cycle_duration);
 
   if (nohighlight) FDMExec->disableHighLighting();
+  if (interpret_functions) FDMExec->SetCompileFunctions(false);
 
   if (simulation_rate < 1.0 )
     FDMExec->Setdt(simulation_rate);
@@ -493,6 +505,8 @@ int real_main(int argc, char* argv[])
 
   tzset(); 
   current_seconds = initial_seconds = getcurrentseconds();
+  double batch_seconds = 0.0;
+  unsigned long batch_frames = 0;
 
   // *** CYCLIC EXECUTION LOOP, AND MESSAGE READING *** //
   while (result && FDMExec->GetSimTime() <= end_time) {
@@ -510,7 +524,10 @@ int real_main(int argc, char* argv[])
     if ( ! FDMExec->Holding()) {
       if ( ! realtime ) {         // ------------ RUNNING IN BATCH MODE
 
+        double frame_start = getcurrentseconds();
         result = FDMExec->Run();
+        batch_seconds += getcurrentseconds() - frame_start;
+        batch_frames++;
 
         if (play_nice) sim_nsleep(sleep_nseconds);
 
@@ -553,12 +570,105 @@ int real_main(int argc, char* argv[])
   strftime(s, 99, "%A %B %d %Y %X", localtime(&tod));
   cout << "End: " << s << " (HH:MM:SS)" << endl;
 
+  if (batch_frames > 0)
+    cout << "Average frame time: " << 1e6*batch_seconds/batch_frames
+         << " us (" << batch_frames << " frames, functions "
+         << (interpret_functions ? "interpreted" : "compiled") << ")" << endl;
+
   // CLEAN UP
   delete FDMExec;
 
   return 0;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Runs benchmark_copies copies of the aircraft (or script) on a worker pool of
+// 1, 2, 4, ... threads and prints the number of FDM steps per second. Each
+// pass starts from the initial conditions and lasts until the end time given
+// with --end, or 10 seconds of simulated time.
+
+int run_benchmark(void)
+{
+  if (AircraftName.empty() && ScriptName.isNull()) {
+    cout << "  No Aircraft or Script information given" << endl << endl;
+    return -1;
+  }
+
+  vector <JSBSim::FGFDMExec*> copies;
+  bool loaded = true;
+
+  for (unsigned int i=0; loaded && i<benchmark_copies; i++) {
+    JSBSim::FGFDMExec* fdm = new JSBSim::FGFDMExec();
+    copies.push_back(fdm);
+
+    fdm->SetDebugLevel(0);
+    fdm->SetRootDir(RootDir);
+    fdm->SetAircraftPath(SGPath("aircraft"));
+    fdm->SetEnginePath(SGPath("engine"));
+    fdm->SetSystemsPath(SGPath("systems"));
+    if (nohighlight) fdm->disableHighLighting();
+    if (interpret_functions) fdm->SetCompileFunctions(false);
+
+    if (simulation_rate < 1.0 )
+      fdm->Setdt(simulation_rate);
+    else
+      fdm->Setdt(1.0/simulation_rate);
+
+    if (!ScriptName.isNull()) {
+      loaded = fdm->LoadScript(ScriptName,
+                               override_sim_rate ? fdm->GetDeltaT() : 0.0,
+                               ResetName);
+    } else {
+      loaded = fdm->LoadModel(SGPath("aircraft"), SGPath("engine"),
+                              SGPath("systems"), AircraftName)
+               && fdm->GetIC()->Load(ResetName);
+    }
+
+    if (loaded) fdm->RunIC();
+  }
+
+  if (!loaded) {
+    cerr << "  JSBSim could not be started" << endl << endl;
+    for (auto fdm: copies) delete fdm;
+    return -1;
+  }
+
+  double duration = end_time < 1e99 ? end_time : 10.0;
+  unsigned int frames = (unsigned int)(duration/copies[0]->GetDeltaT());
+  unsigned int cores = max(1u, thread::hardware_concurrency());
+  double serial_rate = 0.0;
+
+  cout << "Running " << copies.size() << " copies of the aircraft for "
+       << frames << " frames" << endl;
+
+  for (unsigned int threads=1; ; threads=min(2*threads, cores)) {
+    auto pool = make_shared<JSBSim::FGWorkerPool>(threads);
+
+    for (auto fdm: copies) {
+      fdm->SetWorkerPool(pool);
+      fdm->ResetToInitialConditions(0);
+    }
+
+    double start = getcurrentseconds();
+    for (unsigned int frame=0; frame<frames; frame++)
+      pool->Run(copies.size(), [&copies](unsigned int i) { copies[i]->Run(); });
+    double rate = frames*copies.size()/(getcurrentseconds() - start);
+
+    if (threads == 1) serial_rate = rate;
+    cout << "  " << threads << " thread(s): " << rate << " steps/s (x"
+         << rate/serial_rate << ")" << endl;
+
+    // Gear contact and crash reports, which are not of interest here.
+    while (copies[0]->ProcessNextMessage()) {}
+
+    if (threads == cores) break;
+  }
+
+  for (auto fdm: copies) delete fdm;
+
+  return 0;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 #define gripe cerr << "Option '" << keyword     \
@@ -612,6 +722,19 @@ bool options(int count, char **arg)
       suspend = true;
     } else if (keyword == "--nohighlight") {
         nohighlight = true;
+    } else if (keyword == "--interpret-functions") {
+        interpret_functions = true;
+    } else if (keyword == "--benchmark") {
+      if (n != string::npos) {
+        benchmark_copies = atoi( value.c_str() );
+        if (benchmark_copies == 0) {
+          cerr << endl << "  Invalid number of copies given!" << endl << endl;
+          result = false;
+        }
+      } else {
+        gripe;
+        exit(1);
+      }
     } else if (keyword == "--outputlogfile") {
       if (n != string::npos) {
         LogOutputName.push_back(value);
@@ -758,6 +881,11 @@ void PrintHelp(void)
     cout << "    --nice  specifies to run at lower CPU usage" << endl;
     cout << "    --nohighlight  specifies that console output should be pure text only (no color)" << endl;
     cout << "    --suspend  specifies to suspend the simulation after initialization" << endl;
+    cout << "    --interpret-functions  evaluates the function trees node by node instead of" << endl;
+    cout << "                           compiling them (to compare the average frame time)" << endl;
+    cout << "    --benchmark=<copies>  runs that many copies of the aircraft or script side by side," << endl;
+    cout << "                          on 1, 2, 4, ... threads up to the number of cores, and" << endl;
+    cout << "                          prints the steps per second for each thread count" << endl;
     cout << "    --initfile=<filename>  specifies an initilization file" << endl;
     cout << "    --catalog specifies that all properties for this aircraft model should be printed" << endl;
     cout << "              (catalog=aircraftname is an optional format)" << endl;
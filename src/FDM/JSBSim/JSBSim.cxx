@@ -48,6 +48,7 @@
 #include "JSBSim.hxx"
 #include <FDM/JSBSim/FGFDMExec.h>
 #include <FDM/JSBSim/FGJSBBase.h>
+#include <FDM/JSBSim/FGWorkerPool.h>
 #include <FDM/JSBSim/initialization/FGInitialCondition.h>
 #include <FDM/JSBSim/initialization/FGTrim.h>
 #include <FDM/JSBSim/models/FGModel.h>
@@ -223,6 +224,12 @@ FGJSBsim::FGJSBsim( double dt )
 
     fdmex->Setdt( dt );
 
+    // Child FDMs (towed or carried vehicles) can be run on a pool of threads.
+    // This is opt-in, as their systems may refer to each other's properties.
+    int child_threads = fgGetInt("/sim/fdm/jsbsim/child-threads", 0);
+    if (child_threads > 1)
+      fdmex->SetWorkerPool(std::make_shared<FGWorkerPool>(child_threads));
+
     result = fdmex->LoadModel( aircraft_path, engine_path, systems_path,
                                fgGetString("/sim/aero"), false );
 
@@ -29,6 +29,7 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include <assert.h>
+#include <mutex>
 #include "FGPropertyManager.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -42,6 +43,11 @@ FORWARD DECLARATIONS
 
 using namespace std;
 
+// Child FDMs share the property tree of their parent and may run on several
+// threads (see FGFDMExec::SetWorkerPool), so node lookups and creation are
+// serialized.
+static mutex NodeMutex;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 COMMENTS, REFERENCES, and NOTES [use "class documentation" below for API docs]
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -81,6 +87,7 @@ string FGPropertyManager::mkPropertyName(string name, bool lowercase) {
 FGPropertyNode*
 FGPropertyNode::GetNode (const string &path, bool create)
 {
+  lock_guard<mutex> lock(NodeMutex);
   SGPropertyNode* node = getNode(path.c_str(), create);
   if (node == 0) {
     cerr << "FGPropertyManager::GetNode() No node found for " << path << endl;
@@ -93,6 +100,7 @@ FGPropertyNode::GetNode (const string &path, bool create)
 FGPropertyNode*
 FGPropertyNode::GetNode (const string &relpath, int index, bool create)
 {
+  lock_guard<mutex> lock(NodeMutex);
   SGPropertyNode* node = getNode(relpath.c_str(), index, create);
   if (node == 0) {
     cerr << "FGPropertyManager::GetNode() No node found for " << relpath
@@ -105,12 +113,36 @@ FGPropertyNode::GetNode (const string &relpath, int index, bool create)
 
 bool FGPropertyNode::HasNode (const string &path)
 {
+  lock_guard<mutex> lock(NodeMutex);
   const SGPropertyNode* node = getNode(path.c_str(), false);
   return (node != 0);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+static bool SubtreeHasListeners(const SGPropertyNode* node)
+{
+  if (node->nListeners() > 0) return true;
+
+  for (int i=0; i<node->nChildren(); i++) {
+    if (SubtreeHasListeners(node->getChild(i))) return true;
+  }
+
+  return false;
+}
+
+bool FGPropertyNode::HasListeners (void) const
+{
+  // listeners of the parents are notified of changes to their children too
+  for (const SGPropertyNode* node = getParent(); node; node = node->getParent()) {
+    if (node->nListeners() > 0) return true;
+  }
+
+  return SubtreeHasListeners(this);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 string FGPropertyNode::GetPrintableName( void ) const
 {
   string temp_string(getNameString());
@@ -94,6 +94,13 @@ class FGPropertyNode : public SGPropertyNode
      */
     bool HasNode (const std::string &path);
 
+    /**
+     * Test whether a change to this node, or to any node below it, would
+     * notify a listener. Listeners are not thread safe, and must only be
+     * called from the thread which owns the property tree.
+     */
+    bool HasListeners (void) const;
+
     /**
      * Get the name of a node
      */
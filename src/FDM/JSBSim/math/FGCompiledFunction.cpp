@@ -0,0 +1,567 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module: FGCompiledFunction.cpp
+Date started: October 2026
+Purpose: Evaluates function expression trees as flat register based programs
+
+ ------------- Copyright (C) 2026  The FlightGear Team -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or (at your option) any
+ later version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along
+ with this program; if not, write to the Free Software Foundation, Inc., 59
+ Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be
+ found on the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cmath>
+#include <map>
+#include <typeinfo>
+
+#include "FGCompiledFunction.h"
+#include "FGFunction.h"
+#include "FGPropertyValue.h"
+#include "FGRealValue.h"
+#include "FGTable.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace {
+
+const double invlog2val = 1.0/log10(2.0);
+
+// The value of GetBinary() in FGFunction.cpp: 0 (false), 1 (true) or -1 for
+// the values it rejects.
+inline int Binary(double val)
+{
+  val = fabs(val);
+  if (val < 1E-9) return 0;
+  else if (val-1 < 1E-9) return 1;
+  else return -1;
+}
+
+// The bisection of <interpolate1d>. p[0] is the lookup value and d[k-1] is
+// the constant argument p[k], for n arguments.
+double Interpolate1D(double x, const double* d, size_t n)
+{
+  double xmin = d[0];
+  double ymin = d[1];
+  if (x <= xmin) return ymin;
+
+  double xmax = d[n-3];
+  double ymax = d[n-2];
+  if (x >= xmax) return ymax;
+
+  size_t nmin = 0;
+  size_t nmax = (n-3)/2;
+  while (nmax-nmin > 1) {
+    size_t m = (nmax-nmin)/2+nmin;
+    double xm = d[2*m];
+    double ym = d[2*m+1];
+    if (x < xm) {
+      xmax = xm;
+      ymax = ym;
+      nmax= m;
+    } else if (x > xm) {
+      xmin = xm;
+      ymin = ym;
+      nmin = m;
+    }
+    else
+      return ym;
+  }
+
+  return ymin + (x-xmin)*(ymax-ymin)/(xmax-xmin);
+}
+
+// How the arguments of the operations that map to a single instruction are
+// passed.
+enum class Arguments { List, Unary, Binary, ReversedBinary };
+
+} // anonymous namespace
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGCompiledFunction::FGCompiledFunction(const FGParameter* root,
+                                       const FGParameter* var)
+  : Result(0), NumCalls(0), Var(var)
+{
+  Result = Lower(root);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int FGCompiledFunction::NewRegister(void)
+{
+  Registers.push_back(0.0);
+  return Registers.size()-1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int FGCompiledFunction::Constant(double value)
+{
+  unsigned int r = NewRegister();
+  Registers[r] = value;
+  return r;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+size_t FGCompiledFunction::Emit(OpCode op, unsigned int dst, unsigned int a,
+                                unsigned int b, unsigned int c)
+{
+  Instruction i;
+  i.op = op;
+  i.dst = dst;
+  i.a = a;
+  i.b = b;
+  i.c = c;
+  i.param = nullptr;
+  Code.push_back(i);
+  return Code.size()-1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int FGCompiledFunction::EmitCall(const FGParameter* p)
+{
+  unsigned int r = NewRegister();
+  Code[Emit(OpCode::Call, r)].param = p;
+  NumCalls++;
+  return r;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGCompiledFunction::BindProperty(Instruction& i) const
+{
+  const FGPropertyValue* v = static_cast<const FGPropertyValue*>(i.param);
+
+  if (v->PropertyNode) {
+    i.op = v->Sign < 0.0 ? OpCode::NegProperty : OpCode::Property;
+    i.node = v->PropertyNode;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int FGCompiledFunction::Lower(const FGParameter* p)
+{
+  if (const FGRealValue* v = dynamic_cast<const FGRealValue*>(p))
+    return Constant(v->GetValue());
+
+  // Only plain properties: FGFunctionValue applies a template function to
+  // its property.
+  if (p != Var && typeid(*p) == typeid(FGPropertyValue)) {
+    unsigned int r = NewRegister();
+    size_t i = Emit(OpCode::LateProperty, r);
+    Code[i].param = p;
+    BindProperty(Code[i]);
+    return r;
+  }
+
+  if (const FGTable* t = dynamic_cast<const FGTable*>(p)) {
+    OpCode op = OpCode::Table1D;
+    unsigned int n = 1;
+    if (t->Type == FGTable::tt2D) {
+      op = OpCode::Table2D;
+      n = 2;
+    } else if (t->Type == FGTable::tt3D) {
+      op = OpCode::Table3D;
+      n = 3;
+    }
+
+    // Internal tables are looked up by their owner, not by GetValue().
+    for (unsigned int k=0; k<n; k++) {
+      if (!t->lookupProperty[k]) return EmitCall(p);
+    }
+
+    unsigned int key[3] = {0, 0, 0};
+    for (unsigned int k=0; k<n; k++)
+      key[k] = Lower(t->lookupProperty[k]);
+
+    unsigned int r = NewRegister();
+    Code[Emit(op, r, key[0], key[1], key[2])].table = t;
+    return r;
+  }
+
+  if (const FGFunction* f = dynamic_cast<const FGFunction*>(p))
+    return LowerFunction(f);
+
+  return EmitCall(p);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int FGCompiledFunction::LowerFunction(const FGFunction* f)
+{
+  static const map<string, pair<OpCode, Arguments> > operations = {
+    {"sum",        {OpCode::Sum,            Arguments::List}},
+    {"product",    {OpCode::Product,        Arguments::List}},
+    {"difference", {OpCode::Difference,     Arguments::List}},
+    {"min",        {OpCode::Min,            Arguments::List}},
+    {"max",        {OpCode::Max,            Arguments::List}},
+    {"avg",        {OpCode::Avg,            Arguments::List}},
+    {"quotient",   {OpCode::Quotient,       Arguments::ReversedBinary}},
+    {"fmod",       {OpCode::Fmod,           Arguments::ReversedBinary}},
+    {"pow",        {OpCode::Pow,            Arguments::Binary}},
+    {"atan2",      {OpCode::Atan2,          Arguments::Binary}},
+    {"mod",        {OpCode::Mod,            Arguments::Binary}},
+    {"lt",         {OpCode::Lt,             Arguments::Binary}},
+    {"le",         {OpCode::Le,             Arguments::Binary}},
+    {"gt",         {OpCode::Gt,             Arguments::Binary}},
+    {"ge",         {OpCode::Ge,             Arguments::Binary}},
+    {"eq",         {OpCode::Eq,             Arguments::Binary}},
+    {"nq",         {OpCode::Nq,             Arguments::Binary}},
+    {"toradians",  {OpCode::ToRadians,      Arguments::Unary}},
+    {"todegrees",  {OpCode::ToDegrees,      Arguments::Unary}},
+    {"sqrt",       {OpCode::Sqrt,           Arguments::Unary}},
+    {"log2",       {OpCode::Log2,           Arguments::Unary}},
+    {"ln",         {OpCode::Ln,             Arguments::Unary}},
+    {"log10",      {OpCode::Log10,          Arguments::Unary}},
+    {"sign",       {OpCode::Sign,           Arguments::Unary}},
+    {"exp",        {OpCode::Exp,            Arguments::Unary}},
+    {"abs",        {OpCode::Abs,            Arguments::Unary}},
+    {"sin",        {OpCode::Sin,            Arguments::Unary}},
+    {"cos",        {OpCode::Cos,            Arguments::Unary}},
+    {"tan",        {OpCode::Tan,            Arguments::Unary}},
+    {"asin",       {OpCode::Asin,           Arguments::Unary}},
+    {"acos",       {OpCode::Acos,           Arguments::Unary}},
+    {"atan",       {OpCode::Atan,           Arguments::Unary}},
+    {"floor",      {OpCode::Floor,          Arguments::Unary}},
+    {"ceil",       {OpCode::Ceil,           Arguments::Unary}},
+    {"fraction",   {OpCode::Fraction,       Arguments::Unary}},
+    {"integer",    {OpCode::Integer,        Arguments::Unary}},
+    {"not",        {OpCode::Not,            Arguments::Unary}}
+  };
+
+  const string& operation = f->Operation;
+  const vector<FGParameter_ptr>& p = f->Parameters;
+
+  if (operation == "and" || operation == "or") {
+    // Stop at the first argument that is false (and) or true (or).
+    bool isAnd = operation == "and";
+    OpCode test = isAnd ? OpCode::JumpIfFalse : OpCode::JumpIfTrue;
+    vector<size_t> jumps;
+
+    for (auto& arg: p) {
+      size_t i = Emit(test, 0, Lower(arg));
+      Code[i].param = f;
+      jumps.push_back(i);
+    }
+
+    unsigned int r = NewRegister();
+    Emit(OpCode::Copy, r, Constant(isAnd ? 1.0 : 0.0));
+    size_t end = Emit(OpCode::Jump, 0);
+    for (size_t i: jumps) Code[i].b = Code.size();
+    Emit(OpCode::Copy, r, Constant(isAnd ? 0.0 : 1.0));
+    Code[end].b = Code.size();
+    return r;
+  }
+
+  if (operation == "ifthen") {
+    unsigned int r = NewRegister();
+    size_t test = Emit(OpCode::JumpIfFalse, 0, Lower(p[0]));
+    Code[test].param = f;
+    Emit(OpCode::Copy, r, Lower(p[1]));
+    size_t end = Emit(OpCode::Jump, 0);
+    Code[test].b = Code.size();
+    Emit(OpCode::Copy, r, Lower(p[2]));
+    Code[end].b = Code.size();
+    return r;
+  }
+
+  if (operation == "interpolate1d") {
+    // Fused into a single lookup when the breakpoints are constant.
+    for (size_t k=1; k<p.size(); k++) {
+      if (!dynamic_cast<const FGRealValue*>(p[k].ptr())) return EmitCall(f);
+    }
+
+    unsigned int x = Lower(p[0]);
+    unsigned int offset = Data.size();
+    for (size_t k=1; k<p.size(); k++)
+      Data.push_back(p[k]->GetValue());
+
+    unsigned int r = NewRegister();
+    Emit(OpCode::Interpolate1D, r, x, offset, p.size());
+    return r;
+  }
+
+  auto it = operations.find(operation);
+  if (it == operations.end()) return EmitCall(f);
+
+  OpCode op = it->second.first;
+  unsigned int a = 0, b = 0;
+
+  switch (it->second.second) {
+  case Arguments::List:
+    {
+      vector<unsigned int> args;
+      for (auto& arg: p)
+        args.push_back(Lower(arg));
+      a = Args.size();
+      b = args.size();
+      Args.insert(Args.end(), args.begin(), args.end());
+    }
+    break;
+  case Arguments::Unary:
+    a = Lower(p[0]);
+    break;
+  case Arguments::Binary:
+    a = Lower(p[0]);
+    b = Lower(p[1]);
+    break;
+  case Arguments::ReversedBinary:
+    // <quotient> and <fmod> evaluate the divisor first.
+    b = Lower(p[1]);
+    a = Lower(p[0]);
+    break;
+  }
+
+  unsigned int r = NewRegister();
+  size_t i = Emit(op, r, a, b);
+  if (op == OpCode::Not) Code[i].param = f;
+  return r;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGCompiledFunction::Evaluate(void) const
+{
+  double* R = Registers.data();
+  const unsigned int* A = Args.data();
+  const size_t n = Code.size();
+  size_t pc = 0;
+
+  while (pc < n) {
+    Instruction& i = Code[pc++];
+    int binary;
+
+    switch (i.op) {
+    case OpCode::Call:
+      R[i.dst] = i.param->GetValue();
+      break;
+    case OpCode::LateProperty:
+      R[i.dst] = i.param->GetValue(); // Binds the node (or throws)
+      BindProperty(i);
+      break;
+    case OpCode::Property:
+      R[i.dst] = i.node->getDoubleValue();
+      break;
+    case OpCode::NegProperty:
+      R[i.dst] = -i.node->getDoubleValue();
+      break;
+    case OpCode::Copy:
+      R[i.dst] = R[i.a];
+      break;
+    case OpCode::Jump:
+      pc = i.b;
+      break;
+    case OpCode::JumpIfFalse:
+    case OpCode::JumpIfTrue:
+      binary = Binary(R[i.a]);
+      if (binary < 0) {
+        // Let the tree report the malformed condition.
+        i.param->GetValue();
+        throw("Fatal Error.");
+      }
+      if (binary == (i.op == OpCode::JumpIfTrue ? 1 : 0)) pc = i.b;
+      break;
+    case OpCode::Sum:
+      {
+        double temp = 0.0;
+        for (unsigned int k=0; k<i.b; k++)
+          temp += R[A[i.a+k]];
+        R[i.dst] = temp;
+      }
+      break;
+    case OpCode::Product:
+      {
+        double temp = 1.0;
+        for (unsigned int k=0; k<i.b; k++)
+          temp *= R[A[i.a+k]];
+        R[i.dst] = temp;
+      }
+      break;
+    case OpCode::Difference:
+      {
+        double temp = R[A[i.a]];
+        for (unsigned int k=1; k<i.b; k++)
+          temp -= R[A[i.a+k]];
+        R[i.dst] = temp;
+      }
+      break;
+    case OpCode::Min:
+      {
+        double _min = HUGE_VAL;
+        for (unsigned int k=0; k<i.b; k++) {
+          double x = R[A[i.a+k]];
+          if (x < _min)
+            _min = x;
+        }
+        R[i.dst] = _min;
+      }
+      break;
+    case OpCode::Max:
+      {
+        double _max = -HUGE_VAL;
+        for (unsigned int k=0; k<i.b; k++) {
+          double x = R[A[i.a+k]];
+          if (x > _max)
+            _max = x;
+        }
+        R[i.dst] = _max;
+      }
+      break;
+    case OpCode::Avg:
+      {
+        double temp = 0.0;
+        for (unsigned int k=0; k<i.b; k++)
+          temp += R[A[i.a+k]];
+        R[i.dst] = temp / static_cast<size_t>(i.b);
+      }
+      break;
+    case OpCode::Quotient:
+      R[i.dst] = R[i.b] != 0.0 ? R[i.a]/R[i.b] : HUGE_VAL;
+      break;
+    case OpCode::Pow:
+      R[i.dst] = pow(R[i.a], R[i.b]);
+      break;
+    case OpCode::Atan2:
+      R[i.dst] = atan2(R[i.a], R[i.b]);
+      break;
+    case OpCode::Fmod:
+      R[i.dst] = R[i.b] != 0.0 ? fmod(R[i.a], R[i.b]) : HUGE_VAL;
+      break;
+    case OpCode::Mod:
+      R[i.dst] = static_cast<int>(R[i.a]) % static_cast<int>(R[i.b]);
+      break;
+    case OpCode::Lt:
+      R[i.dst] = R[i.a] < R[i.b] ? 1.0 : 0.0;
+      break;
+    case OpCode::Le:
+      R[i.dst] = R[i.a] <= R[i.b] ? 1.0 : 0.0;
+      break;
+    case OpCode::Gt:
+      R[i.dst] = R[i.a] > R[i.b] ? 1.0 : 0.0;
+      break;
+    case OpCode::Ge:
+      R[i.dst] = R[i.a] >= R[i.b] ? 1.0 : 0.0;
+      break;
+    case OpCode::Eq:
+      R[i.dst] = R[i.a] == R[i.b] ? 1.0 : 0.0;
+      break;
+    case OpCode::Nq:
+      R[i.dst] = R[i.a] != R[i.b] ? 1.0 : 0.0;
+      break;
+    case OpCode::ToRadians:
+      R[i.dst] = R[i.a]*M_PI/180.;
+      break;
+    case OpCode::ToDegrees:
+      R[i.dst] = R[i.a]*180./M_PI;
+      break;
+    case OpCode::Sqrt:
+      R[i.dst] = R[i.a] >= 0.0 ? sqrt(R[i.a]) : -HUGE_VAL;
+      break;
+    case OpCode::Log2:
+      R[i.dst] = R[i.a] > 0.0 ? log10(R[i.a])*invlog2val : -HUGE_VAL;
+      break;
+    case OpCode::Ln:
+      R[i.dst] = R[i.a] > 0.0 ? log(R[i.a]) : -HUGE_VAL;
+      break;
+    case OpCode::Log10:
+      R[i.dst] = R[i.a] > 0.0 ? log10(R[i.a]) : -HUGE_VAL;
+      break;
+    case OpCode::Sign:
+      R[i.dst] = R[i.a] < 0.0 ? -1 : 1; // 0.0 counts as positive.
+      break;
+    case OpCode::Exp:
+      R[i.dst] = exp(R[i.a]);
+      break;
+    case OpCode::Abs:
+      R[i.dst] = fabs(R[i.a]);
+      break;
+    case OpCode::Sin:
+      R[i.dst] = sin(R[i.a]);
+      break;
+    case OpCode::Cos:
+      R[i.dst] = cos(R[i.a]);
+      break;
+    case OpCode::Tan:
+      R[i.dst] = tan(R[i.a]);
+      break;
+    case OpCode::Asin:
+      R[i.dst] = asin(R[i.a]);
+      break;
+    case OpCode::Acos:
+      R[i.dst] = acos(R[i.a]);
+      break;
+    case OpCode::Atan:
+      R[i.dst] = atan(R[i.a]);
+      break;
+    case OpCode::Floor:
+      R[i.dst] = floor(R[i.a]);
+      break;
+    case OpCode::Ceil:
+      R[i.dst] = ceil(R[i.a]);
+      break;
+    case OpCode::Fraction:
+      {
+        double scratch;
+        R[i.dst] = modf(R[i.a], &scratch);
+      }
+      break;
+    case OpCode::Integer:
+      {
+        double result;
+        modf(R[i.a], &result);
+        R[i.dst] = result;
+      }
+      break;
+    case OpCode::Not:
+      binary = Binary(R[i.a]);
+      if (binary < 0) {
+        i.param->GetValue();
+        throw("Fatal Error.");
+      }
+      R[i.dst] = binary ? 0.0 : 1.0;
+      break;
+    case OpCode::Interpolate1D:
+      R[i.dst] = Interpolate1D(R[i.a], &Data[i.b], i.c);
+      break;
+    case OpCode::Table1D:
+      R[i.dst] = i.table->GetValue(R[i.a]);
+      break;
+    case OpCode::Table2D:
+      R[i.dst] = i.table->GetValue(R[i.a], R[i.b]);
+      break;
+    case OpCode::Table3D:
+      R[i.dst] = i.table->GetValue(R[i.a], R[i.b], R[i.c]);
+      break;
+    }
+  }
+
+  return R[Result];
+}
+
+} // namespace JSBSim
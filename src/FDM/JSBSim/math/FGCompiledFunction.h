@@ -0,0 +1,142 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header: FGCompiledFunction.h
+Date started: October 2026
+
+ ------------- Copyright (C) 2026  The FlightGear Team -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or (at your option) any
+ later version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along
+ with this program; if not, write to the Free Software Foundation, Inc., 59
+ Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be
+ found on the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGCOMPILEDFUNCTION_H
+#define FGCOMPILEDFUNCTION_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <vector>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class FGParameter;
+class FGPropertyNode;
+class FGTable;
+class FGFunction;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** A function expression tree lowered to a flat register based program.
+
+    FGFunction evaluates its tree by calling GetValue() recursively on each
+    node. This class walks the tree once and emits one instruction per
+    operation instead: constants are preloaded into registers, property leaves
+    read their (cached) FGPropertyNode directly and tables are looked up with
+    the registers holding their independent variables. The instructions
+    perform the same floating point operations in the same order as the
+    corresponding FGFunction operations, and <and>, <or>, <ifthen> and
+    <interpolate1d> only evaluate the arguments that the tree would evaluate,
+    so the result is exactly the same.
+
+    Nodes that can not be lowered (e.g. <random>, <switch>, the rotation
+    functions, template functions or internal tables) are evaluated by calling
+    their GetValue() method from the program.
+
+    @see FGFunction
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DECLARATION: FGCompiledFunction
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGCompiledFunction
+{
+public:
+  /** Constructor.
+      @param root the expression to compile, i.e. the single argument of an
+                  FGFunction.
+      @param var the property value that a template function substitutes for
+                 "#". Its node changes from one call to the next so it is
+                 never cached. */
+  explicit FGCompiledFunction(const FGParameter* root,
+                              const FGParameter* var=nullptr);
+
+  /// Evaluates the program, which is the same as root->GetValue().
+  double Evaluate(void) const;
+
+  /// The number of instructions in the program.
+  size_t GetNumInstructions(void) const { return Code.size(); }
+
+  /// The number of tree nodes that are called through GetValue().
+  unsigned int GetNumCalls(void) const { return NumCalls; }
+
+private:
+  enum class OpCode : unsigned char {
+    Call, LateProperty, Property, NegProperty, Copy,
+    Jump, JumpIfFalse, JumpIfTrue,
+    Sum, Product, Difference, Min, Max, Avg,
+    Quotient, Pow, Atan2, Fmod, Mod, Lt, Le, Gt, Ge, Eq, Nq,
+    ToRadians, ToDegrees, Sqrt, Log2, Ln, Log10, Sign, Exp, Abs, Sin, Cos,
+    Tan, Asin, Acos, Atan, Floor, Ceil, Fraction, Integer, Not,
+    Interpolate1D, Table1D, Table2D, Table3D
+  };
+
+  struct Instruction {
+    OpCode op;
+    unsigned int dst;
+    // Operand registers, or offset and count in Args or Data, or jump target.
+    unsigned int a, b, c;
+    union {
+      // Call, LateProperty and the node whose errors JumpIfFalse,
+      // JumpIfTrue and Not report
+      const FGParameter* param;
+      FGPropertyNode* node;
+      const FGTable* table;
+    };
+  };
+
+  mutable std::vector<Instruction> Code; // LateProperty binds in place
+  mutable std::vector<double> Registers;
+  std::vector<unsigned int> Args;
+  std::vector<double> Data;
+  unsigned int Result;
+  unsigned int NumCalls;
+  const FGParameter* Var;
+
+  unsigned int Lower(const FGParameter* p);
+  unsigned int LowerFunction(const FGFunction* f);
+  unsigned int Constant(double value);
+  unsigned int NewRegister(void);
+  size_t Emit(OpCode op, unsigned int dst, unsigned int a=0, unsigned int b=0,
+              unsigned int c=0);
+  unsigned int EmitCall(const FGParameter* p);
+  void BindProperty(Instruction& i) const;
+};
+
+} // namespace JSBSim
+
+#endif
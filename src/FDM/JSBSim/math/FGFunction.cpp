@@ -213,6 +213,12 @@ FGFunction::FGFunction(FGFDMExec* fdmex, Element* el, const string& prefix,
   CheckMinArguments(el, 1);
   CheckMaxArguments(el, 1);
 
+  // Evaluate operations through a flat program rather than the tree. There is
+  // nothing to gain for a single value, property or table.
+  if (fdmex->GetCompileFunctions()
+      && dynamic_cast<FGFunction*>(Parameters[0].ptr()))
+    Program.reset(new FGCompiledFunction(Parameters[0], var));
+
   string sCopyTo = el->GetAttributeValue("copyto");
 
   if (!sCopyTo.empty()) {
@@ -311,6 +317,7 @@ void FGFunction::Load(Element* el, FGPropertyValue* var, FGFDMExec* fdmex,
                       const string& Prefix)
 {
   Name = el->GetAttributeValue("name");
+  Operation = el->GetName();
   Element* element = el->GetElement();
       
   auto sum = [](const decltype(Parameters)& Parameters)->double {
@@ -926,7 +933,7 @@ double FGFunction::GetValue(void) const
 {
   if (cached) return cachedValue;
 
-  double val = Parameters[0]->GetValue();
+  double val = Program ? Program->Evaluate() : Parameters[0]->GetValue();
 
   if (pCopyTo) pCopyTo->setDoubleValue(val);
 
@@ -34,7 +34,10 @@ SENTRY
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include <memory>
+
 #include "FGParameter.h"
+#include "FGCompiledFunction.h"
 #include "input_output/FGPropertyManager.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -811,6 +814,10 @@ public:
     value. */
   void cacheValue(bool shouldCache);
 
+/** The program that evaluates the function, or nullptr if it walks its tree.
+    @see FGFDMExec::SetCompileFunctions */
+  const FGCompiledFunction* GetProgram(void) const { return Program.get(); }
+
   enum class OddEven {Either, Odd, Even};
 
 protected:
@@ -830,7 +837,11 @@ protected:
 
 private:
   std::string Name;
+  std::string Operation; // The name of the element, e.g. "product"
   FGPropertyNode_ptr pCopyTo; // Property node for CopyTo property string
+  std::unique_ptr<FGCompiledFunction> Program;
+
+  friend class FGCompiledFunction;
 
   void Debug(int from);
 };
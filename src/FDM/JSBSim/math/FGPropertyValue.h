@@ -87,6 +87,8 @@ private:
   mutable FGPropertyNode_ptr PropertyNode;
   std::string PropertyName;
   double Sign;
+
+  friend class FGCompiledFunction;
 };
 
 typedef SGSharedPtr<FGPropertyValue> FGPropertyValue_ptr;
@@ -49,6 +49,74 @@ namespace JSBSim {
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+namespace {
+
+// The first breakpoint above the key (or at or above it, with orEqual) among
+// bp[k*stride] for k in [r, r+len-1], or r+len-1 if there is none before.
+// The bisection has no branches on the key, as the breakpoint that it ends
+// on is not predictable.
+unsigned int Bisect(const double* bp, unsigned int stride, unsigned int r,
+                    unsigned int len, double key, bool orEqual)
+{
+  if (orEqual) {
+    while (len > 1) {
+      unsigned int half = len/2;
+      r += half*(bp[(r+half-1)*stride] < key);
+      len -= half;
+    }
+  } else {
+    while (len > 1) {
+      unsigned int half = len/2;
+      r += half*(bp[(r+half-1)*stride] <= key);
+      len -= half;
+    }
+  }
+  return r;
+}
+
+// Steps from the breakpoint index r towards the key, a few breakpoints at a
+// time, and bisects the rest of the way. The key rarely moves by more than a
+// few breakpoints from one frame to the next, but it does jump after a reset
+// or during trim.
+unsigned int Search(const double* bp, unsigned int stride, unsigned int n,
+                    unsigned int r, double key)
+{
+  const unsigned int steps = 16;
+
+  if (r > 2 && bp[(r-1)*stride] > key) {
+    unsigned int last = r > steps+2 ? r-steps : 2;
+    do { r--; } while (r > last && bp[(r-1)*stride] > key);
+    if (r > 2 && bp[(r-1)*stride] > key)
+      r = Bisect(bp, stride, 2, r-2, key, false);
+  } else {
+    unsigned int last = r+steps < n ? r+steps : n;
+    do { r++; } while (r < last && bp[r*stride] < key);
+    if (r < n && bp[r*stride] < key)
+      r = Bisect(bp, stride, r+1, n-r, key, true);
+  }
+
+  return r;
+}
+
+// The index r of the breakpoints bp[(r-1)*stride] and bp[r*stride] that
+// bracket key, for the sorted breakpoints k = 1..n and 2 <= r <= n. This is
+// the index that stepping one breakpoint at a time from the previous index
+// (the hint) finds, so that the result does not depend on how it is found.
+inline unsigned int FindBreakpoint(const double* bp, unsigned int stride,
+                                   unsigned int n, unsigned int hint,
+                                   double key)
+{
+  if ((hint > 2 && bp[(hint-1)*stride] > key)
+      || (hint < n && bp[hint*stride] < key))
+    return Search(bp, stride, n, hint, key);
+
+  return hint;
+}
+
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 FGTable::FGTable(int NRows)
   : nRows(NRows), nCols(1), PropertyManager(nullptr)
 {
@@ -56,8 +124,9 @@ FGTable::FGTable(int NRows)
   colCounter = 0;
   rowCounter = 1;
   nTables = 0;
+  SharedAxes = false;
 
-  Data = Allocate();
+  Allocate();
   Debug(0);
   lastRowIndex=lastColumnIndex=2;
 }
@@ -71,8 +140,9 @@ FGTable::FGTable(int NRows, int NCols)
   colCounter = 1;
   rowCounter = 0;
   nTables = 0;
+  SharedAxes = false;
 
-  Data = Allocate();
+  Allocate();
   Debug(0);
   lastRowIndex=lastColumnIndex=2;
 }
@@ -96,12 +166,8 @@ FGTable::FGTable(const FGTable& t) : PropertyManager(t.PropertyManager)
   lookupProperty[2] = t.lookupProperty[2];
 
   Tables = t.Tables;
-  Data = Allocate();
-  for (unsigned int r=0; r<=nRows; r++) {
-    for (unsigned int c=0; c<=nCols; c++) {
-      Data[r][c] = t.Data[r][c];
-    }
-  }
+  SharedAxes = t.SharedAxes;
+  Data = t.Data;
   lastRowIndex = t.lastRowIndex;
   lastColumnIndex = t.lastColumnIndex;
   lastTableIndex = t.lastTableIndex;
@@ -136,6 +202,7 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
                            "pow, abs, sin, cos, asin, acos, tan, atan, table";
 
   nTables = 0;
+  SharedAxes = false;
 
   // Is this an internal lookup table?
 
@@ -262,7 +329,7 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
     Type = tt1D;
     colCounter = 0;
     rowCounter = 1;
-    Data = Allocate();
+    Allocate();
     Debug(0);
     lastRowIndex = lastColumnIndex = 2;
     *this << buf;
@@ -287,7 +354,7 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
     colCounter = 1;
     rowCounter = 0;
 
-    Data = Allocate();
+    Allocate();
     lastRowIndex = lastColumnIndex = 2;
     *this << buf;
     break;
@@ -300,17 +367,22 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
     rowCounter = 1;
     lastRowIndex = lastColumnIndex = 2;
 
-    Data = Allocate(); // this data array will contain the keys for the associated tables
+    Allocate(); // this data array will contain the keys for the associated tables
     Tables.reserve(nTables); // necessary?
     tableData = el->FindElement("tableData");
     for (i=0; i<nTables; i++) {
       Tables.push_back(new FGTable(PropertyManager, tableData));
-      Data[i+1][1] = tableData->GetAttributeValueAsNumber("breakPoint");
+      Cell(i+1, 1) = tableData->GetAttributeValueAsNumber("breakPoint");
       Tables[i]->lookupProperty[eRow] = lookupProperty[eRow];
       Tables[i]->lookupProperty[eColumn] = lookupProperty[eColumn];
       tableData = el->FindNextElement("tableData");
     }
 
+    for (i=1; i<nTables; i++) {
+      if (!Tables[i]->HasSameBreakpoints(*Tables[0])) break;
+    }
+    SharedAxes = nTables > 1 && i == nTables;
+
     Debug(0);
     break;
   default:
@@ -330,14 +402,14 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
   // check breakpoints, if applicable
   if (dimension > 2) {
     for (b=2; b<=nTables; ++b) {
-      if (Data[b][1] <= Data[b-1][1]) {
+      if (Cell(b, 1) <= Cell(b-1, 1)) {
         std::cerr << el->ReadFrom()
                   << fgred << highint 
                   << "  FGTable: breakpoint lookup is not monotonically increasing" << endl
                   << "  in breakpoint " << b;
         if (nameel != 0) std::cerr << " of table in " << nameel->GetAttributeValue("name");
         std::cerr << ":" << reset << endl
-                  << "  " << Data[b][1] << "<=" << Data[b-1][1] << endl;
+                  << "  " << Cell(b, 1) << "<=" << Cell(b-1, 1) << endl;
         throw BaseException("Breakpoint lookup is not monotonically increasing");
       }
     }
@@ -346,14 +418,14 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
   // check columns, if applicable
   if (dimension > 1) {
     for (c=2; c<=nCols; ++c) {
-      if (Data[0][c] <= Data[0][c-1]) {
+      if (Cell(0, c) <= Cell(0, c-1)) {
         std::cerr << el->ReadFrom()
                   << fgred << highint 
                   << "  FGTable: column lookup is not monotonically increasing" << endl
                   << "  in column " << c;
         if (nameel != 0) std::cerr << " of table in " << nameel->GetAttributeValue("name");
         std::cerr << ":" << reset << endl
-                  << "  " << Data[0][c] << "<=" << Data[0][c-1] << endl;
+                  << "  " << Cell(0, c) << "<=" << Cell(0, c-1) << endl;
         throw BaseException("FGTable: column lookup is not monotonically increasing");
       }
     }
@@ -362,14 +434,14 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
   // check rows
   if (dimension < 3) { // in 3D tables, check only rows of subtables
     for (r=2; r<=nRows; ++r) {
-      if (Data[r][0]<=Data[r-1][0]) {
+      if (Cell(r, 0)<=Cell(r-1, 0)) {
         std::cerr << el->ReadFrom()
                   << fgred << highint 
                   << "  FGTable: row lookup is not monotonically increasing" << endl
                   << "  in row " << r;
         if (nameel != 0) std::cerr << " of table in " << nameel->GetAttributeValue("name");
         std::cerr << ":" << reset << endl
-                  << "  " << Data[r][0] << "<=" << Data[r-1][0] << endl;
+                  << "  " << Cell(r, 0) << "<=" << Cell(r-1, 0) << endl;
         throw BaseException("FGTable: row lookup is not monotonically increasing");
       }
     }
@@ -382,16 +454,9 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-double** FGTable::Allocate(void)
+void FGTable::Allocate(void)
 {
-  Data = new double*[nRows+1];
-  for (unsigned int r=0; r<=nRows; r++) {
-    Data[r] = new double[nCols+1];
-    for (unsigned int c=0; c<=nCols; c++) {
-      Data[r][c] = 0.0;
-    }
-  }
-  return Data;
+  Data.assign((nRows+1)*(nCols+1), 0.0);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -411,9 +476,6 @@ FGTable::~FGTable()
     for (unsigned int i=0; i<nTables; i++) delete Tables[i];
     Tables.clear();
   }
-  for (unsigned int r=0; r<=nRows; r++) delete[] Data[r];
-  delete[] Data;
-
   Debug(1);
 }
 
@@ -452,120 +514,236 @@ double FGTable::GetValue(void) const
 
 double FGTable::GetValue(double key) const
 {
-  double Factor, Value, Span;
-  unsigned int r = lastRowIndex;
+  return Interpolate(FindRow(key));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGTable::GetValue(double rowKey, double colKey) const
+{
+  Bracket row, col;
+
+  FindRowColumn(rowKey, colKey, row, col);
+  return Interpolate(row, col);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGTable::GetValue(double rowKey, double colKey, double tableKey) const
+{
+  Bracket table = FindTable(tableKey);
+  const FGTable* lower = Tables[table.lo-1];
+  const FGTable* upper = Tables[table.hi-1];
+
+  if (!SharedAxes) {
+    if (table.lo == table.hi) return lower->GetValue(rowKey, colKey);
+
+    return table.factor*(upper->GetValue(rowKey, colKey) - lower->GetValue(rowKey, colKey))
+                              + lower->GetValue(rowKey, colKey);
+  }
+
+  // All the sub-tables have the same breakpoints: search them once.
+  Bracket row, col;
+  lower->FindRowColumn(rowKey, colKey, row, col);
+
+  if (table.lo == table.hi) return lower->Interpolate(row, col);
+
+  double value = lower->Interpolate(row, col);
+  return table.factor*(upper->Interpolate(row, col) - value) + value;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTable::GetValues(const vector<const FGTable*>& tables, double key,
+                        vector<double>& values)
+{
+  values.resize(tables.size());
+  if (tables.empty()) return;
+
+  Bracket row = tables[0]->FindRow(key);
+  for (size_t i=0; i<tables.size(); i++) {
+    assert(tables[i]->HasSameBreakpoints(*tables[0]));
+    tables[i]->lastRowIndex = tables[0]->lastRowIndex;
+    values[i] = tables[i]->Interpolate(row);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTable::GetValues(const vector<const FGTable*>& tables, double rowKey,
+                        double colKey, vector<double>& values)
+{
+  values.resize(tables.size());
+  if (tables.empty()) return;
+
+  Bracket row, col;
+  tables[0]->FindRowColumn(rowKey, colKey, row, col);
+  for (size_t i=0; i<tables.size(); i++) {
+    assert(tables[i]->HasSameBreakpoints(*tables[0]));
+    tables[i]->lastRowIndex = tables[0]->lastRowIndex;
+    tables[i]->lastColumnIndex = tables[0]->lastColumnIndex;
+    values[i] = tables[i]->Interpolate(row, col);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGTable::HasSameBreakpoints(const FGTable& t) const
+{
+  if (Type != t.Type || nRows != t.nRows || nCols != t.nCols) return false;
+
+  switch (Type) {
+  case tt1D:
+    for (unsigned int r=1; r<=nRows; r++)
+      if (Cell(r, 0) != t.Cell(r, 0)) return false;
+    return true;
+  case tt2D:
+    for (unsigned int r=1; r<=nRows; r++)
+      if (Cell(r, 0) != t.Cell(r, 0)) return false;
+    for (unsigned int c=1; c<=nCols; c++)
+      if (Cell(0, c) != t.Cell(0, c)) return false;
+    return true;
+  case tt3D:
+    for (unsigned int r=1; r<=nRows; r++) {
+      if (Cell(r, 1) != t.Cell(r, 1)) return false;
+      if (!Tables[r-1]->HasSameBreakpoints(*t.Tables[r-1])) return false;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+inline FGTable::Bracket FGTable::FindRow(double key) const
+{
+  Bracket row;
+  // The rows of a 1D table are {key, value}
+  const double* d = Data.data();
 
   //if the key is off the end of the table, just return the
   //end-of-table value, do not extrapolate
-  if( key <= Data[1][0] ) {
+  if( key <= d[2] ) {
     lastRowIndex=2;
-    //cout << "Key underneath table: " << key << endl;
-    return Data[1][1];
-  } else if ( key >= Data[nRows][0] ) {
+    row.lo = row.hi = 1;
+    row.factor = 0.0;
+    return row;
+  } else if ( key >= d[2*nRows] ) {
     lastRowIndex=nRows;
-    //cout << "Key over table: " << key << endl;
-    return Data[nRows][1];
+    row.lo = row.hi = nRows;
+    row.factor = 0.0;
+    return row;
   }
 
-  // the key is somewhere in the middle, search for the right breakpoint
-  // The search is particularly efficient if
-  // the correct breakpoint has not changed since last frame or
-  // has only changed very little
-
-  while (r > 2     && Data[r-1][0] > key) { r--; }
-  while (r < nRows && Data[r][0]   < key) { r++; }
+  unsigned int r = FindBreakpoint(d, 2, nRows, lastRowIndex, key);
 
   lastRowIndex=r;
-  // make sure denominator below does not go to zero.
+  row.lo = r-1;
+  row.hi = r;
 
-  Span = Data[r][0] - Data[r-1][0];
+  // make sure denominator below does not go to zero.
+  double Span = d[2*r] - d[2*r-2];
   if (Span != 0.0) {
-    Factor = (key - Data[r-1][0]) / Span;
-    if (Factor > 1.0) Factor = 1.0;
+    row.factor = (key - d[2*r-2]) / Span;
+    if (row.factor > 1.0) row.factor = 1.0;
   } else {
-    Factor = 1.0;
+    row.factor = 1.0;
   }
 
-  Value = Factor*(Data[r][1] - Data[r-1][1]) + Data[r-1][1];
-
-  return Value;
+  return row;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-double FGTable::GetValue(double rowKey, double colKey) const
+inline void FGTable::FindRowColumn(double rowKey, double colKey, Bracket& row,
+                            Bracket& col) const
 {
-  double rFactor, cFactor, col1temp, col2temp, Value;
-  unsigned int r = lastRowIndex;
-  unsigned int c = lastColumnIndex;
-
-  while(r > 2     && Data[r-1][0] > rowKey) { r--; }
-  while(r < nRows && Data[r]  [0] < rowKey) { r++; }
-
-  while(c > 2     && Data[0][c-1] > colKey) { c--; }
-  while(c < nCols && Data[0][c]   < colKey) { c++; }
+  // The row keys are in the first column, the column keys in the first row.
+  const double* d = Data.data();
+  const unsigned int stride = nCols+1;
+  unsigned int r = FindBreakpoint(d, stride, nRows, lastRowIndex, rowKey);
+  unsigned int c = FindBreakpoint(d, 1, nCols, lastColumnIndex, colKey);
 
   lastRowIndex=r;
   lastColumnIndex=c;
 
-  rFactor = (rowKey - Data[r-1][0]) / (Data[r][0] - Data[r-1][0]);
-  cFactor = (colKey - Data[0][c-1]) / (Data[0][c] - Data[0][c-1]);
-
-  if (rFactor > 1.0) rFactor = 1.0;
-  else if (rFactor < 0.0) rFactor = 0.0;
+  row.lo = r-1;
+  row.hi = r;
+  row.factor = (rowKey - d[(r-1)*stride]) / (d[r*stride] - d[(r-1)*stride]);
+  col.lo = c-1;
+  col.hi = c;
+  col.factor = (colKey - d[c-1]) / (d[c] - d[c-1]);
 
-  if (cFactor > 1.0) cFactor = 1.0;
-  else if (cFactor < 0.0) cFactor = 0.0;
+  if (row.factor > 1.0) row.factor = 1.0;
+  else if (row.factor < 0.0) row.factor = 0.0;
 
-  col1temp = rFactor*(Data[r][c-1] - Data[r-1][c-1]) + Data[r-1][c-1];
-  col2temp = rFactor*(Data[r][c] - Data[r-1][c]) + Data[r-1][c];
-
-  Value = col1temp + cFactor*(col2temp - col1temp);
-
-  return Value;
+  if (col.factor > 1.0) col.factor = 1.0;
+  else if (col.factor < 0.0) col.factor = 0.0;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-double FGTable::GetValue(double rowKey, double colKey, double tableKey) const
+inline FGTable::Bracket FGTable::FindTable(double tableKey) const
 {
-  double Factor, Value, Span;
-  unsigned int r = lastRowIndex;
+  Bracket table;
 
   //if the key is off the end  (or before the beginning) of the table,
   // just return the boundary-table value, do not extrapolate
 
-  if( tableKey <= Data[1][1] ) {
+  if( tableKey <= Cell(1, 1) ) {
     lastRowIndex=2;
-    return Tables[0]->GetValue(rowKey, colKey);
-  } else if ( tableKey >= Data[nRows][1] ) {
+    table.lo = table.hi = 1;
+    table.factor = 0.0;
+    return table;
+  } else if ( tableKey >= Cell(nRows, 1) ) {
     lastRowIndex=nRows;
-    return Tables[nRows-1]->GetValue(rowKey, colKey);
+    table.lo = table.hi = nRows;
+    table.factor = 0.0;
+    return table;
   }
 
-  // the key is somewhere in the middle, search for the right breakpoint
-  // The search is particularly efficient if
-  // the correct breakpoint has not changed since last frame or
-  // has only changed very little
-
-  while(r > 2     && Data[r-1][1] > tableKey) { r--; }
-  while(r < nRows && Data[r]  [1] < tableKey) { r++; }
+  unsigned int r = FindBreakpoint(&Data[1], nCols+1, nRows, lastRowIndex, tableKey);
 
   lastRowIndex=r;
-  // make sure denominator below does not go to zero.
+  table.lo = r-1;
+  table.hi = r;
 
-  Span = Data[r][1] - Data[r-1][1];
+  // make sure denominator below does not go to zero.
+  double Span = Cell(r, 1) - Cell(r-1, 1);
   if (Span != 0.0) {
-    Factor = (tableKey - Data[r-1][1]) / Span;
-    if (Factor > 1.0) Factor = 1.0;
+    table.factor = (tableKey - Cell(r-1, 1)) / Span;
+    if (table.factor > 1.0) table.factor = 1.0;
   } else {
-    Factor = 1.0;
+    table.factor = 1.0;
   }
 
-  Value = Factor*(Tables[r-1]->GetValue(rowKey, colKey) - Tables[r-2]->GetValue(rowKey, colKey))
-                              + Tables[r-2]->GetValue(rowKey, colKey);
+  return table;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+inline double FGTable::Interpolate(const Bracket& row) const
+{
+  const double* lower = &Data[2*row.lo+1];
+
+  if (row.lo == row.hi) return *lower;
+
+  const double* upper = &Data[2*row.hi+1];
+  return row.factor*(*upper - *lower) + *lower;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+inline double FGTable::Interpolate(const Bracket& row, const Bracket& col) const
+{
+  const double* lower = &Data[row.lo*(nCols+1)];
+  const double* upper = &Data[row.hi*(nCols+1)];
+
+  double col1temp = row.factor*(upper[col.lo] - lower[col.lo]) + lower[col.lo];
+  double col2temp = row.factor*(upper[col.hi] - lower[col.hi]) + lower[col.hi];
 
-  return Value;
+  return col1temp + col.factor*(col2temp - col1temp);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -581,7 +759,7 @@ void FGTable::operator<<(istream& in_stream)
   for (unsigned int r=startRow; r<=nRows; r++) {
     for (unsigned int c=startCol; c<=nCols; c++) {
       if (r != 0 || c != 0) {
-        in_stream >> Data[r][c];
+        in_stream >> Cell(r, c);
       }
     }
   }
@@ -593,7 +771,7 @@ void FGTable::operator<<(istream& in_stream)
 
 FGTable& FGTable::operator<<(const double n)
 {
-  Data[rowCounter][colCounter] = n;
+  Cell(rowCounter, colCounter) = n;
   if (colCounter == (int)nCols) {
     colCounter = 0;
     rowCounter++;
@@ -647,7 +825,7 @@ void FGTable::Print(void)
       if (r == 0 && c == 0) {
         cout << "	";
       } else {
-        cout << Data[r][c] << "	";
+        cout << Cell(r, c) << "	";
         if (Type == tt3D) {
           cout << endl;
           Tables[r-1]->Print();
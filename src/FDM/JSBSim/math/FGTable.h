@@ -38,6 +38,8 @@ SENTRY
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include <vector>
+
 #include "FGParameter.h"
 #include "math/FGPropertyValue.h"
 
@@ -248,6 +250,26 @@ public:
   double GetValue(double key) const;
   double GetValue(double rowKey, double colKey) const;
   double GetValue(double rowKey, double colKey, double TableKey) const;
+
+  /** Looks up several 1D tables that have the same breakpoints, e.g.
+      coefficients that are tabulated against the same angle of attack. The
+      breakpoints that bracket the key are searched only once, in the first
+      table.
+      @param tables the tables, all with the same breakpoints
+      @param key the lookup value
+      @param values receives the value of each table, in the same order
+      @see HasSameBreakpoints */
+  static void GetValues(const std::vector<const FGTable*>& tables, double key,
+                        std::vector<double>& values);
+  /** Looks up several 2D tables that have the same row and column
+      breakpoints.
+      @see GetValues(const std::vector<const FGTable*>&, double, std::vector<double>&) */
+  static void GetValues(const std::vector<const FGTable*>& tables,
+                        double rowKey, double colKey,
+                        std::vector<double>& values);
+
+  /// Whether this table has the same dimension and breakpoints as another.
+  bool HasSameBreakpoints(const FGTable& table) const;
   /** Read the table in.
       Data in the config file should be in matrix format with the row
       independents as the first column and the column independents in
@@ -274,7 +296,7 @@ public:
   FGTable& operator<<(const double n);
   FGTable& operator<<(const int n);
 
-  inline double GetElement(int r, int c) const {return Data[r][c];}
+  inline double GetElement(int r, int c) const {return Cell(r, c);}
 
   double operator()(unsigned int r, unsigned int c) const
   { return GetElement(r, c); }
@@ -295,16 +317,39 @@ private:
   enum axis {eRow=0, eColumn, eTable};
   bool internal;
   FGPropertyValue_ptr lookupProperty[3];
-  double** Data;
+  // The keys and values, row after row: (nRows+1) x (nCols+1)
+  std::vector<double> Data;
   std::vector <FGTable*> Tables;
+  bool SharedAxes; // The sub-tables of a 3D table have the same breakpoints
   unsigned int nRows, nCols, nTables, dimension;
   int colCounter, rowCounter, tableCounter;
   mutable int lastRowIndex, lastColumnIndex, lastTableIndex;
-  double** Allocate(void);
+  void Allocate(void);
+
+  double& Cell(unsigned int r, unsigned int c)
+  { return Data[r*(nCols+1)+c]; }
+  const double& Cell(unsigned int r, unsigned int c) const
+  { return Data[r*(nCols+1)+c]; }
+
+  /// The breakpoints lo and hi that bracket a key and the interpolation
+  /// factor between them. lo and hi are equal when the key is off the table.
+  struct Bracket {
+    unsigned int lo, hi;
+    double factor;
+  };
+
+  Bracket FindRow(double key) const;
+  void FindRowColumn(double rowKey, double colKey, Bracket& row,
+                     Bracket& col) const;
+  Bracket FindTable(double tableKey) const;
+  double Interpolate(const Bracket& row) const;
+  double Interpolate(const Bracket& row, const Bracket& col) const;
   FGPropertyManager* const PropertyManager;
   std::string Name;
   void bind(Element* el, const std::string& Prefix);
   void Debug(int from);
+
+  friend class FGCompiledFunction;
 };
 }
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
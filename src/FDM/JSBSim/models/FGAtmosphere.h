@@ -266,8 +266,12 @@ protected:
       value is fixed whichever gravity model is used by FGInertial.
   */
   static constexpr double g0 = 9.80665 / fttom;
-  /// Specific gas constant for air - ft*lbf/slug/R
-  static double Reng;
+  /// Specific gas constant for dry air - ft*lbf/slug/R
+  static constexpr double Reng0 = Rstar / Mair;
+  /** Specific gas constant for air - ft*lbf/slug/R.
+      It depends on the humidity, so it belongs to each instance: child FDMs
+      may run their atmosphere concurrently. */
+  double Reng = Reng0;
   //@}
 
   static constexpr double SHRatio = 1.4;
@@ -91,6 +91,11 @@ FGWinds::FGWinds(FGFDMExec* fdmex) : FGModel(fdmex)
   // Milspec turbulence model
   windspeed_at_20ft = 0.;
   probability_of_exceedence_index = 0;
+  xi_u_km1 = nu_u_km1 = 0.0;
+  xi_v_km1 = xi_v_km2 = nu_v_km1 = nu_v_km2 = 0.0;
+  xi_w_km1 = xi_w_km2 = nu_w_km1 = nu_w_km2 = 0.0;
+  xi_p_km1 = nu_p_km1 = 0.0;
+  xi_q_km1 = xi_r_km1 = 0.0;
   POE_Table = new FGTable(7,12);
   // this is Figure 7 from p. 49 of MIL-F-8785C
   // rows: probability of exceedance curve index, cols: altitude in ft
@@ -278,16 +283,6 @@ void FGWinds::Turbulence(double h)
       sig_u = sig_w = POE_Table->GetValue(probability_of_exceedence_index, h);
     }
 
-    // keep values from last timesteps
-    // TODO maybe use deque?
-    static double
-      xi_u_km1 = 0, nu_u_km1 = 0,
-      xi_v_km1 = 0, xi_v_km2 = 0, nu_v_km1 = 0, nu_v_km2 = 0,
-      xi_w_km1 = 0, xi_w_km2 = 0, nu_w_km1 = 0, nu_w_km2 = 0,
-      xi_p_km1 = 0, nu_p_km1 = 0,
-      xi_q_km1 = 0, xi_r_km1 = 0;
-
-
     double
       T_V = in.totalDeltaT, // for compatibility of nomenclature
       sig_p = 1.9/sqrt(L_w*b_w)*sig_w, // Yeager1998, eq. (8)
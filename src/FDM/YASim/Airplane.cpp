@@ -2,6 +2,14 @@
 #  include "config.h"
 #endif
 
+#include <limits>
+#include <locale>
+#include <sstream>
+
+#include <simgear/debug/logstream.hxx>
+#include <simgear/props/props_io.hxx>
+#include <simgear/structure/exception.hxx>
+
 #include "Atmosphere.hpp"
 #include "ControlMap.hpp"
 #include "Gear.hpp"
@@ -20,6 +28,10 @@ namespace yasim {
 // gadgets
 inline float abs(float f) { return f<0 ? -f : f; }
 
+// Increment this whenever a change to YASim changes the solver results,
+// so that cached solutions get solved again.
+static const int SOLVER_CACHE_VERSION = 2;
+
 Airplane::Airplane()
 {
 }
@@ -624,7 +636,12 @@ void Airplane::compile(bool verbose)
     solveGear();
     calculateCGHardLimits();
     
-    if(_wing && _tail) solveAirplane(verbose);
+    if(_wing && _tail) {
+        if (!loadSolution(verbose)) {
+            solveAirplane(verbose);
+            saveSolution();
+        }
+    }
     else
     {
        // The rotor(s) mass:
@@ -897,14 +914,9 @@ float Airplane::_checkConvergence(float prev, float current)
     return current;
 }
 
-void Airplane::solveAirplane(bool verbose)
+/// Helper for solveAirplane() and loadSolution()
+void Airplane::setupSolverControls()
 {
-    static const float ARCMIN = 0.0002909f;
-
-    float tmp[3];
-    _solutionIterations = 0;
-    _failureMsg = 0;
-
     if (_approachElevator == nullptr) {
         setElevatorControl("/controls/flight/elevator-trim");
     }
@@ -915,6 +927,17 @@ void Airplane::solveAirplane(bool verbose)
         _tailIncidence = new ControlSetting;
         _tailIncidenceCopy = new ControlSetting;
     }
+}
+
+void Airplane::solveAirplane(bool verbose)
+{
+    static const float ARCMIN = 0.0002909f;
+
+    float tmp[3];
+    _solutionIterations = 0;
+    _failureMsg = 0;
+
+    setupSolverControls();
 
     if (verbose) {
         fprintf(stdout,"i\tdAoa\tdTail\tcl0\tcp1\n");
@@ -1065,6 +1088,147 @@ void Airplane::solveAirplane(bool verbose)
     }
 }
 
+/// All values set by solveAirplane(), in a fixed order: the results,
+/// the coefficients of the wing sections and those of every surface.
+void Airplane::getSolution(std::vector<float>& solution)
+{
+    solution = { _dragFactor, _liftRatio, _config[CRUISE].aoa,
+                 _tailIncidence->val, _tailIncidenceCopy->val,
+                 _approachElevator->val, _tail->getIncidence() };
+
+    std::vector<Wing*> wings = { _wing, _tail };
+    for(int i=0; i<_vstabs.size(); i++)
+        wings.push_back((Wing*)_vstabs.get(i));
+    for(Wing* w : wings) {
+        for(int i=0; i<w->numSections(); i++) {
+            solution.push_back(w->getSectionDrag(i));
+            solution.push_back(w->getSectionLiftRatio(i));
+        }
+    }
+
+    Vector* surfaces = _model.getSurfaces();
+    for(int i=0; i<surfaces->size(); i++) {
+        Surface* s = (Surface*)surfaces->get(i);
+        solution.push_back(s->getTotalForceCoefficient());
+        solution.push_back(s->getDragCoefficient());
+        solution.push_back(s->getLiftCoefficient());
+    }
+}
+
+/// Counterpart of getSolution()
+void Airplane::setSolution(const std::vector<float>& solution)
+{
+    auto it = solution.begin();
+    _dragFactor = *it++;
+    _liftRatio = *it++;
+    _config[CRUISE].aoa = *it++;
+    _tailIncidence->val = *it++;
+    _tailIncidenceCopy->val = *it++;
+    _approachElevator->val = *it++;
+    _tail->setIncidence(*it++);
+
+    std::vector<Wing*> wings = { _wing, _tail };
+    for(int i=0; i<_vstabs.size(); i++)
+        wings.push_back((Wing*)_vstabs.get(i));
+    for(Wing* w : wings) {
+        for(int i=0; i<w->numSections(); i++) {
+            float drag = *it++;
+            w->setSectionCoefficients(i, drag, *it++);
+        }
+    }
+
+    // after the sections, which set the coefficients of their surfaces
+    Vector* surfaces = _model.getSurfaces();
+    for(int i=0; i<surfaces->size(); i++) {
+        Surface* s = (Surface*)surfaces->get(i);
+        s->setTotalForceCoefficient(*it++);
+        s->setDragCoefficient(*it++);
+        s->setLiftCoefficient(*it++);
+    }
+}
+
+/// Set the results of an earlier solveAirplane() of the same airplane
+/// as written by saveSolution(), if there are any.
+bool Airplane::loadSolution(bool verbose)
+{
+    if (_solverCacheFile.isNull() || !_solverCacheFile.exists()) return false;
+
+    SGPropertyNode_ptr root = new SGPropertyNode;
+    try {
+        readProperties(_solverCacheFile, root);
+    } catch (const sg_exception& e) {
+        SG_LOG(SG_FLIGHT, SG_WARN, "YASim: ignoring solver cache " << _solverCacheFile
+               << ": " << e.getFormattedMessage());
+        return false;
+    }
+    if (root->getStringValue("key") != _solverCacheKey ||
+        root->getIntValue("solver-version") != SOLVER_CACHE_VERSION) {
+        return false;
+    }
+
+    setupSolverControls();
+
+    // the values are written with enough digits to read back the same
+    // floats, so the airplane ends up exactly as solving would leave it
+    std::vector<float> solution;
+    getSolution(solution);
+    const size_t count = solution.size();
+    solution.clear();
+    std::istringstream in(root->getStringValue("solution"));
+    in.imbue(std::locale::classic());
+    float f;
+    while (in >> f) solution.push_back(f);
+    if (!in.eof() || solution.size() != count) {
+        SG_LOG(SG_FLIGHT, SG_WARN, "YASim: ignoring solver cache " << _solverCacheFile
+               << ": solution doesn't match the airplane");
+        return false;
+    }
+
+    _solutionIterations = root->getIntValue("iterations");
+    _failureMsg = 0;
+
+    // the approach configuration is the last one solving runs, then
+    // the results on top of it
+    runConfig(_config[APPROACH]);
+    setSolution(solution);
+
+    if (verbose) {
+        fprintf(stdout,"solution read from %s\n", _solverCacheFile.utf8Str().c_str());
+    }
+    if (_wingsN != nullptr) {
+        if (_tailIncidence->propHandle >= 0) {
+            fgSetFloat(_controlMap.getProperty(_tailIncidence->propHandle)->name, _tailIncidence->val);
+        }
+    }
+    return true;
+}
+
+/// Write the results of solveAirplane() for loadSolution()
+void Airplane::saveSolution()
+{
+    if (_solverCacheFile.isNull() || _failureMsg) return;
+
+    std::vector<float> solution;
+    getSolution(solution);
+    std::ostringstream out;
+    out.imbue(std::locale::classic());
+    out.precision(std::numeric_limits<float>::max_digits10);
+    for (float f : solution) out << f << ' ';
+
+    SGPropertyNode_ptr root = new SGPropertyNode;
+    root->setStringValue("key", _solverCacheKey);
+    root->setIntValue("solver-version", SOLVER_CACHE_VERSION);
+    root->setIntValue("iterations", _solutionIterations);
+    root->setStringValue("solution", out.str());
+    try {
+        _solverCacheFile.create_dir(0755);
+        writeProperties(_solverCacheFile, root, true);
+    } catch (const sg_exception& e) {
+        SG_LOG(SG_FLIGHT, SG_WARN, "YASim: can't write solver cache " << _solverCacheFile
+               << ": " << e.getFormattedMessage());
+    }
+}
+
 void Airplane::solveHelicopter(bool verbose)
 {
     _solutionIterations = 0;
@@ -7,8 +7,11 @@
 #include "Rotor.hpp"
 #include "Vector.hpp"
 #include "Version.hpp"
+#include <simgear/misc/sg_path.hxx>
 #include <simgear/props/props.hxx>
 
+#include <vector>
+
 namespace yasim {
 
 class Gear;
@@ -138,6 +141,11 @@ public:
     void  setSolverThreshold(float threshold) { _solverThreshold = threshold; };
     void  setSolverMaxIterations(int i) { _solverMaxIterations = i; };
     void  setSolverMode(int i) { _solverMode = i; };
+    /// Cache the solver results in file, for the airplane identified by
+    /// key (e.g. a hash of its XML). compile() reads them from there
+    /// instead of solving if they were written for the same key by the
+    /// same solver version.
+    void  setSolverCache(const SGPath& file, const std::string& key) { _solverCacheFile = file; _solverCacheKey = key; };
     
 private:
     struct Tank { 
@@ -200,7 +208,12 @@ private:
     float _getLiftForce(Config &cfg);
     float _getDragForce(Config &cfg);
     float _checkConvergence(float prev, float current);
+    void setupSolverControls();
     void solveAirplane(bool verbose = false);
+    void getSolution(std::vector<float>& solution);
+    void setSolution(const std::vector<float>& solution);
+    bool loadSolution(bool verbose);
+    void saveSolution();
     void solveHelicopter(bool verbose = false);
     float compileWing(Wing* w);
     void compileRotorgear();
@@ -230,6 +243,8 @@ private:
     // Trying too hard can result in oscillations (no convergence). 
     float _solverThreshold {1};
     int   _solverMaxIterations {10000};
+    SGPath _solverCacheFile;
+    std::string _solverCacheKey;
     Model _model;
     ControlMap _controlMap;
 
@@ -7,6 +7,7 @@
 #include "Airplane.hpp"
 #include "Vector.hpp"
 
+#include <functional>
 #include <map>
 #include <set>
 #include <string>
@@ -125,6 +125,10 @@ void Model::initIteration()
         Math::add3(v, _gyro, _gyro);
     }
 
+    // The surface forces are computed all at once from a copy of
+    // their parameters, which change between iterations only.
+    _surfaceBatch.load(_surfaces);
+
     // Displace the turbulence coordinates according to the local wind.
     if(_turb) {
         float toff[3];
@@ -167,6 +171,7 @@ void Model::iterate()
     initRotorIteration();
     _body.recalc(); // FIXME: amortize this, somehow
     _integrator.calcNewInterval();
+    _surfaceBatch.store(_surfaces);
 }
 
 void Model::setState(State* s)
@@ -301,14 +306,31 @@ void Model::calcForces(State* s)
         float vs[3] {0,0,0}, pos[3] {0,0,0};
         localWind(pos, s, vs, alt);
         float mach = _atmo.machFromSpeed(Math::mag3(vs));
-        for (i=0; i<_surfaces.size(); i++) {
-            Surface* sf = (Surface*)_surfaces.get(i);
+        if (_surfaceBatch.size() != _surfaces.size()) {
+            _surfaceBatch.load(_surfaces);
+        }
+        if (_turb || _rotorgear.isInUse()) {
+            // turbulence and downwash differ per surface
+            for (i=0; i<_surfaceBatch.size(); i++) {
+                _surfaceBatch.getPosition(i, pos);
+                localWind(pos, s, vs, alt);
+                _surfaceBatch.setWind(i, vs);
+            }
+        } else {
             // Vsurf = wind - velocity + (rot cross (cg - pos))
-            sf->getPosition(pos);
-            localWind(pos, s, vs, alt);
+            float lwind[3], lrot[3], lv[3], cg[3];
+            Math::vmul33(s->orient, _wind, lwind);
+            Math::vmul33(s->orient, s->rot, lrot);
+            Math::vmul33(s->orient, s->v, lv);
+            _body.getCG(cg);
+            _surfaceBatch.calcWind(lwind, lrot, lv, cg);
+        }
+        _surfaceBatch.calcForces(_atmo.getDensity(), mach);
 
+        for (i=0; i<_surfaceBatch.size(); i++) {
             float force[3], torque[3];
-            sf->calcForce(vs, _atmo.getDensity(), mach, force, torque);
+            _surfaceBatch.getPosition(i, pos);
+            _surfaceBatch.getForce(i, force, torque);
             Math::add3(faero, force, faero);
 
             _body.addForce(pos, force);
@@ -8,6 +8,7 @@
 #include "Turbulence.hpp"
 #include "Rotor.hpp"
 #include "Atmosphere.hpp"
+#include "SurfaceBatch.hpp"
 #include <simgear/props/props.hxx>
 
 namespace yasim {
@@ -51,6 +52,7 @@ public:
     void addHook(Hook* hook) { _hook = hook; }
     void addLaunchbar(Launchbar* launchbar) { _launchbar = launchbar; }
     Surface* getSurface(int handle) const { return (Surface*)_surfaces.get(handle); }
+    Vector* getSurfaces() { return &_surfaces; }
     Rotorgear* getRotorgear(void) { return &_rotorgear; }
     Hook* getHook(void) const { return _hook; }
     int addHitch(Hitch* hitch) { return _hitches.add(hitch); }
@@ -93,6 +95,7 @@ private:
 
     Vector _thrusters;
     Vector _surfaces;
+    SurfaceBatch _surfaceBatch;
     Rotorgear _rotorgear;
     Vector _gears;
     Hook* _hook {nullptr};
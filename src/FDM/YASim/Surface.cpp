@@ -241,15 +241,20 @@ void Surface::calcForce(const float* v, const float rho, float mach, float* out,
     float scale = 0.5f*rho*vel*vel*_c0;
     Math::mul3(scale, out, out);
     Math::mul3(scale, torque, torque);
-    // if we have a property tree, export info
+    exportForce(out, pg_correction, wavedrag);
+}
+
+// if we have a property tree, export info
+void Surface::exportForce(const float* force, float pgCorrection, float wavedrag)
+{
     if (_surfN != 0) {
-      _fabsN->setFloatValue(Math::mag3(out));
-      _fxN->setFloatValue(out[0]);
-      _fyN->setFloatValue(out[1]);
-      _fzN->setFloatValue(out[2]);
+      _fabsN->setFloatValue(Math::mag3(force));
+      _fxN->setFloatValue(force[0]);
+      _fyN->setFloatValue(force[1]);
+      _fzN->setFloatValue(force[2]);
       _alphaN->setFloatValue(_alpha);
       _stallAlphaN->setFloatValue(_stallAlpha);      
-      _pgCorrectionN->setFloatValue(pg_correction);
+      _pgCorrectionN->setFloatValue(pgCorrection);
       _dcdwaveN->setFloatValue(wavedrag);
     }
 }
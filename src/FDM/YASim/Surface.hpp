@@ -13,6 +13,9 @@ namespace yasim {
 // front, and flaps act (in both lift and drag) toward the back.
 class Surface
 {
+    // SurfaceBatch computes the forces of many surfaces at once
+    friend class SurfaceBatch;
+
     static int s_idGenerator;
     int _id;        //index for property tree
 
@@ -102,6 +105,7 @@ private:
     float stallFunc(float* v);
     float flapLift(float alpha);
     float controlDrag(float lift, float drag);
+    void exportForce(const float* force, float pgCorrection, float wavedrag);
 
     float _chord {0};     // X-axis size
     float _c0 {1};        // total force coefficient
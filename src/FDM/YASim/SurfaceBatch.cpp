@@ -0,0 +1,327 @@
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "yasim-common.hpp"
+#include "Math.hpp"
+#include "Surface.hpp"
+#include "SurfaceBatch.hpp"
+
+namespace yasim {
+
+void SurfaceBatch::load(const Vector& surfaces)
+{
+    _n = surfaces.size();
+    _stride = (_n + LANES - 1) / LANES * LANES;
+    // padding lanes have no wind and produce no force
+    _data.assign(NUM_FIELDS * _stride, 0);
+    _transonic.clear();
+    _mcrit.clear();
+
+    for(int i=0; i<_n; i++) {
+        Surface* s = (Surface*)surfaces.get(i);
+        field(POS_X)[i] = s->_pos[0];
+        field(POS_Y)[i] = s->_pos[1];
+        field(POS_Z)[i] = s->_pos[2];
+        for(int j=0; j<9; j++)
+            field(Field(ORIENT0 + j))[i] = s->_orient[j];
+        field(C0)[i] = s->_c0;
+        field(CX)[i] = s->_cx;
+        field(CY)[i] = s->_cy;
+        field(CZ)[i] = s->_cz;
+        field(CZ0)[i] = s->_cz0;
+        field(CHORD)[i] = s->_chord;
+        field(PEAK0)[i] = s->_peaks[0];
+        field(PEAK1)[i] = s->_peaks[1];
+        for(int j=0; j<4; j++) {
+            field(Field(STALL0 + j))[i] = s->_stalls[j];
+            field(Field(WIDTH0 + j))[i] = s->_widths[j];
+        }
+        field(SLAT_ALPHA)[i] = s->_slatAlpha;
+        field(SLAT_DRAG)[i] = s->_slatDrag;
+        field(FLAP_LIFT)[i] = s->_flapLift;
+        field(FLAP_DRAG)[i] = s->_flapDrag;
+        field(FLAP_EFFECTIVENESS)[i] = s->_flapEffectiveness;
+        field(SPOILER_LIFT)[i] = s->_spoilerLift;
+        field(SPOILER_DRAG)[i] = s->_spoilerDrag;
+        field(SLAT_POS)[i] = s->_slatPos;
+        field(FLAP_POS)[i] = s->_flapPos;
+        field(SPOILER_POS)[i] = s->_spoilerPos;
+        field(INCIDENCE)[i] = s->_incidence + s->_twist;
+        field(INDUCED_DRAG)[i] = s->_inducedDrag;
+        field(VERSION_32)[i] = s->_version->isVersionOrNewer(Version::YASIM_VERSION_32);
+        if (s->_flow == FLOW_TRANSONIC) {
+            _transonic.push_back(i);
+            _mcrit.push_back(s->_Mcrit);
+            _pgCoefficients = s->pg_coefficients;
+        }
+    }
+}
+
+void SurfaceBatch::getPosition(int i, float* out) const
+{
+    out[0] = field(POS_X)[i];
+    out[1] = field(POS_Y)[i];
+    out[2] = field(POS_Z)[i];
+}
+
+void SurfaceBatch::calcWind(const float* wind, const float* rot, const float* v, const float* cg)
+{
+    const float* px = field(POS_X);
+    const float* py = field(POS_Y);
+    const float* pz = field(POS_Z);
+    float* wx = field(WIND_X);
+    float* wy = field(WIND_Y);
+    float* wz = field(WIND_Z);
+
+    // Same operations as RigidBody::pointVelocity() and Model::localWind()
+    for(int i=0; i<_n; i++) {
+        float dx = px[i] - cg[0], dy = py[i] - cg[1], dz = pz[i] - cg[2];
+        float rx = rot[1]*dz - dy*rot[2];
+        float ry = rot[2]*dx - dz*rot[0];
+        float rz = rot[0]*dy - dx*rot[1];
+        wx[i] = (wind[0] + -1*rx) - v[0];
+        wy[i] = (wind[1] + -1*ry) - v[1];
+        wz[i] = (wind[2] + -1*rz) - v[2];
+    }
+}
+
+void SurfaceBatch::setWind(int i, const float* v)
+{
+    field(WIND_X)[i] = v[0];
+    field(WIND_Y)[i] = v[1];
+    field(WIND_Z)[i] = v[2];
+}
+
+void SurfaceBatch::getForce(int i, float* force, float* torque) const
+{
+    force[0] = field(FORCE_X)[i];
+    force[1] = field(FORCE_Y)[i];
+    force[2] = field(FORCE_Z)[i];
+    torque[0] = field(TORQUE_X)[i];
+    torque[1] = field(TORQUE_Y)[i];
+    torque[2] = field(TORQUE_Z)[i];
+}
+
+void SurfaceBatch::calcForces(float rho, float mach)
+{
+    // The compressibility terms depend on the mach number only, and
+    // only apply to transonic surfaces; these are few, so they are
+    // done one by one.
+    float* pg = field(PG_CORRECTION);
+    float* wave = field(WAVEDRAG);
+    for(int i=0; i<_stride; i++) {
+        pg[i] = 1;
+        wave[i] = 0;
+    }
+    if (!_transonic.empty()) {
+        float pg_correction {1};
+        if (mach < 0.8f) {
+            pg_correction = 1.0f/sqrt(1.0f-(mach*mach));
+        }
+        if ((mach >= 0.8f) && (mach < 1.2f)) {
+            pg_correction = Math::polynomial(_pgCoefficients, mach);
+        }
+        if (mach >= 1.2f) {
+            pg_correction = 2.0f/(((mach*mach)-1.0f)*YASIM_PI);
+        }
+        for(size_t t=0; t<_transonic.size(); t++) {
+            int i = _transonic[t];
+            pg[i] = pg_correction;
+            if (mach > _mcrit[t]) {
+                wave[i] = 9.5f * Math::pow((mach > 1.0f ? 1.0f : mach)-_mcrit[t], 2.8f) + 0.00193f;
+            }
+        }
+    }
+
+    for(int i=0; i<_stride; i+=LANES)
+        calcBlock(i, rho);
+}
+
+// d, or 1 in place of a zero d where the quotient isn't used
+static inline float divisor(float d)
+{
+    return d == 0 ? 1 : d;
+}
+
+// Surface::calcForce() for LANES surfaces from first on.  Branches are
+// replaced by computing both sides and selecting one, with divisors
+// that are only used by one side made safe for the other.  Otherwise
+// the operations and their order are the same.
+void SurfaceBatch::calcBlock(int first, float rho)
+{
+    // A copy of the block's parameters and inputs.  Reading from a
+    // local array, the compiler knows that no read can fault and may
+    // do them all regardless of the selects below.
+    float in[FORCE_X][LANES];
+    for(int f=0; f<FORCE_X; f++)
+        for(int l=0; l<LANES; l++)
+            in[f][l] = field(Field(f))[first+l];
+
+    // results go here first, so that the loop doesn't store into
+    // memory it might read
+    float fx[LANES], fy[LANES], fz[LANES];
+    float tx[LANES], ty[LANES], tz[LANES];
+    float alpha[LANES], stallAlpha[LANES], computed[LANES], alphaSet[LANES];
+
+    // Split v into magnitude and direction.  The square root gets a
+    // loop of its own, as the errno handling of sqrt() would keep the
+    // compiler from vectorizing the one below.
+    float speed[LANES];
+    for(int l=0; l<LANES; l++)
+        speed[l] = Math::sqrt(in[WIND_X][l]*in[WIND_X][l] + in[WIND_Y][l]*in[WIND_Y][l] + in[WIND_Z][l]*in[WIND_Z][l]);
+
+    for(int l=0; l<LANES; l++) {
+        // Zero velocity, or no coefficients at all, means zero force.
+        float vel = speed[l];
+        bool skip = (vel == 0) | ((in[CX][l] == 0) & (in[CY][l] == 0) & (in[CZ][l] == 0));
+
+        // Normalize wind and convert to the surface's coordinates
+        float inv = 1/divisor(vel);
+        float x = inv*in[WIND_X][l], y = inv*in[WIND_Y][l], z = inv*in[WIND_Z][l];
+        float o0 = x*in[ORIENT0][l] + y*in[ORIENT1][l] + z*in[ORIENT2][l];
+        float o1 = x*in[ORIENT3][l] + y*in[ORIENT4][l] + z*in[ORIENT5][l];
+        float o2 = x*in[ORIENT6][l] + y*in[ORIENT7][l] + z*in[ORIENT8][l];
+
+        // "Rotate" by the incidence angle
+        o2 += in[INCIDENCE][l] * o0;
+        float lw0 = o0, lw1 = o1, lw2 = o2;
+
+        // stallFunc()
+        float s0 = in[STALL0][l], s1 = in[STALL1][l], s2 = in[STALL2][l], s3 = in[STALL3][l];
+        float w0 = in[WIDTH0][l], w1 = in[WIDTH1][l], w2 = in[WIDTH2][l], w3 = in[WIDTH3][l];
+        float a = Math::abs(o2/divisor(o0));
+        bool fwdBak = o0 > 0;
+        bool posNeg = o2 < 0;
+        float stallBak = posNeg ? s3 : s2, stallFwd = posNeg ? s1 : s0;
+        float widthBak = posNeg ? w3 : w2, widthFwd = posNeg ? w1 : w0;
+        float stall = fwdBak ? stallBak : stallFwd;
+        float width = fwdBak ? widthBak : widthFwd;
+        float stallPos = fwdBak ? s2 : s0;
+        float p0 = in[PEAK0][l], p1 = in[PEAK1][l];
+        float peak = fwdBak ? p1 : p0;
+        float sp = in[SLAT_POS][l], sla = in[SLAT_ALPHA][l];
+        float slat = in[VERSION_32][l] != 0 ? sp * sla : sla;
+        float sa0 = s0 != 0 ? s0 + slat : s0;
+        float sa = fwdBak ? stallBak : (posNeg ? s1 : sa0);
+        // (stallFunc() divides by zero for a surface with a stall
+        // angle for i but not for i&2; Wing never sets one up)
+        float scale = 0.5f*peak/divisor(stallPos);
+        float frac = (a - sa) / divisor(width);
+        frac = frac*frac*(3-2*frac);
+        float stallMul = scale*(1-frac) + frac;
+        stallMul = a <= sa ? scale : stallMul;
+        stallMul = a > sa+width ? 1 : stallMul;
+        stallMul = stall == 0 ? 1 : stallMul;
+        stallMul = o0 != 0 ? stallMul : 1;
+
+        // Diddle the Z force according to our configuration
+        stallMul *= 1 + in[SPOILER_POS][l] * (in[SPOILER_LIFT][l] - 1);
+        float stallLift = (stallMul - 1) * in[CZ][l] * o2;
+
+        // flapLift()
+        float fl = in[CZ][l] * in[FLAP_POS][l] * (in[FLAP_LIFT][l]-1) * in[FLAP_EFFECTIVENESS][l];
+        float fa = Math::abs(o2);
+        float ffrac = (fa - in[STALL0][l]) / divisor(in[WIDTH0][l]);
+        ffrac = ffrac*ffrac*(3-2*ffrac);
+        float flaplift = fl * (1-ffrac);
+        flaplift = fa > in[STALL0][l] + in[WIDTH0][l] ? 0 : flaplift;
+        flaplift = fa < in[STALL0][l] ? fl : flaplift;
+        flaplift = in[STALL0][l] == 0 ? 0 : flaplift;
+
+        o2 *= in[CZ][l];
+        o2 += in[CZ][l]*in[CZ0][l];
+        o2 += stallLift;
+        o2 += flaplift;
+
+        // compressibility, 1 and 0 unless transonic
+        o2 *= in[PG_CORRECTION][l];
+        o0 += in[WAVEDRAG][l];
+
+        // pitch torque, in local coordinates
+        float t1 = 0.1667f * in[CHORD][l] * (flaplift - (in[CZ][l]*in[CZ0][l] + stallLift));
+        float q0 = 0.0f*in[ORIENT0][l] + t1*in[ORIENT3][l] + 0.0f*in[ORIENT6][l];
+        float q1 = 0.0f*in[ORIENT1][l] + t1*in[ORIENT4][l] + 0.0f*in[ORIENT7][l];
+        float q2 = 0.0f*in[ORIENT2][l] + t1*in[ORIENT5][l] + 0.0f*in[ORIENT8][l];
+
+        // controlDrag()
+        float fp = in[FLAP_POS][l];
+        float fl1 = in[FLAP_LIFT][l]-1;
+        float fpNeg = -fp - in[CZ0][l]/(fp < 0 ? fl1 : divisor(fl1));
+        fpNeg = fpNeg < 0 ? 0 : fpNeg;
+        fp = fp < 0 ? fpNeg : fp;
+        float flapDragAoA = (in[FLAP_LIFT][l] - 1 - in[CZ0][l]) * in[STALL0][l];
+        float drag = in[CX][l] * o0;
+        float fd = Math::abs(o2 * flapDragAoA * fp);
+        fd = drag < 0 ? -fd : fd;
+        drag += fd;
+        drag *= 1 + fp * (in[FLAP_DRAG][l] - 1);
+        drag *= 1 + in[SPOILER_POS][l] * (in[SPOILER_DRAG][l] - 1);
+        drag *= 1 + in[SLAT_POS][l] * (in[SLAT_DRAG][l] - 1);
+        o0 = drag;
+
+        // Add in any specific Y (side force) coefficient.
+        o1 *= in[CY][l];
+
+        // Diddle the induced drag
+        float k = -1*in[INDUCED_DRAG][l]*o2*lw2;
+        o0 = k*lw0 + o0;
+        o1 = k*lw1 + o1;
+        o2 = k*lw2 + o2;
+
+        // Reverse the incidence rotation
+        float r0 = o0 + in[INCIDENCE][l] * o2;
+        float r2 = o2 - in[INCIDENCE][l] * o0;
+        o0 = in[VERSION_32][l] != 0 ? r0 : o0;
+        o2 = in[VERSION_32][l] != 0 ? o2 : r2;
+
+        // Convert back to external coordinates and add in the units
+        float f0 = o0*in[ORIENT0][l] + o1*in[ORIENT3][l] + o2*in[ORIENT6][l];
+        float f1 = o0*in[ORIENT1][l] + o1*in[ORIENT4][l] + o2*in[ORIENT7][l];
+        float f2 = o0*in[ORIENT2][l] + o1*in[ORIENT5][l] + o2*in[ORIENT8][l];
+        float q = 0.5f*rho*vel*vel*in[C0][l];
+
+        fx[l] = skip ? 0 : q*f0;
+        fy[l] = skip ? 0 : q*f1;
+        fz[l] = skip ? 0 : q*f2;
+        tx[l] = skip ? 0 : q*q0;
+        ty[l] = skip ? 0 : q*q1;
+        tz[l] = skip ? 0 : q*q2;
+        alpha[l] = a;
+        stallAlpha[l] = sa;
+        computed[l] = skip ? 0 : 1;
+        alphaSet[l] = skip || o0 == 0 ? 0 : 1;
+    }
+
+    for(int l=0; l<LANES; l++) {
+        field(FORCE_X)[first+l] = fx[l];
+        field(FORCE_Y)[first+l] = fy[l];
+        field(FORCE_Z)[first+l] = fz[l];
+        field(TORQUE_X)[first+l] = tx[l];
+        field(TORQUE_Y)[first+l] = ty[l];
+        field(TORQUE_Z)[first+l] = tz[l];
+        field(ALPHA)[first+l] = alpha[l];
+        field(STALL_ALPHA)[first+l] = stallAlpha[l];
+        field(COMPUTED)[first+l] = computed[l];
+        field(ALPHA_SET)[first+l] = alphaSet[l];
+    }
+}
+
+void SurfaceBatch::store(const Vector& surfaces)
+{
+    if (surfaces.size() != _n) return;
+
+    for(int i=0; i<_n; i++) {
+        Surface* s = (Surface*)surfaces.get(i);
+        if (field(ALPHA_SET)[i] != 0) {
+            s->_alpha = field(ALPHA)[i];
+            s->_stallAlpha = field(STALL_ALPHA)[i];
+        }
+        if (field(COMPUTED)[i] != 0) {
+            float force[3] = { field(FORCE_X)[i], field(FORCE_Y)[i], field(FORCE_Z)[i] };
+            s->exportForce(force, field(PG_CORRECTION)[i], field(WAVEDRAG)[i]);
+        }
+    }
+}
+
+}; // namespace yasim
@@ -0,0 +1,92 @@
+#ifndef _SURFACEBATCH_HPP
+#define _SURFACEBATCH_HPP
+
+#include <vector>
+
+#include "Vector.hpp"
+
+namespace yasim {
+
+class Surface;
+
+//
+// The aerodynamic forces of all surfaces of a Model, computed the same
+// way as Surface::calcForce() does one at a time.
+//
+// The surface parameters are copied into one array per parameter
+// ("structure of arrays"), so that the kernel works on LANES surfaces
+// at once without branches and the compiler can vectorize it (with
+// SSE2 under ENABLE_SIMD, see also CMakeLists.txt).  Where it doesn't,
+// the same code is the scalar fallback.  The operations are those of
+// calcForce() in the same order, so the results are the same unless
+// the compiler contracts multiplies and adds differently.
+//
+class SurfaceBatch
+{
+public:
+    static const int LANES = 8;
+
+    // Copies the parameters of the surfaces (a Vector of Surface*).
+    // Must be called again once any of them changed, e.g. control
+    // positions; Model does this in initIteration().
+    void load(const Vector& surfaces);
+
+    int size() const { return _n; }
+    void getPosition(int i, float* out) const;
+
+    // The local wind at each surface for a rigid body without
+    // turbulence: wind - velocity - (rot cross (pos - cg)), as
+    // Model::localWind() computes it.
+    void calcWind(const float* wind, const float* rot, const float* v, const float* cg);
+    // ...or set it for each surface
+    void setWind(int i, const float* v);
+
+    void calcForces(float rho, float mach);
+
+    void getForce(int i, float* force, float* torque) const;
+
+    // Writes alpha and the debug properties back to the surfaces, as
+    // of the last calcForces().
+    void store(const Vector& surfaces);
+
+private:
+    enum Field {
+        // parameters
+        POS_X, POS_Y, POS_Z,
+        ORIENT0, ORIENT1, ORIENT2, ORIENT3, ORIENT4, ORIENT5, ORIENT6, ORIENT7, ORIENT8,
+        C0, CX, CY, CZ, CZ0, CHORD,
+        PEAK0, PEAK1,
+        STALL0, STALL1, STALL2, STALL3,
+        WIDTH0, WIDTH1, WIDTH2, WIDTH3,
+        SLAT_ALPHA, SLAT_DRAG, FLAP_LIFT, FLAP_DRAG, FLAP_EFFECTIVENESS,
+        SPOILER_LIFT, SPOILER_DRAG,
+        SLAT_POS, FLAP_POS, SPOILER_POS,
+        INCIDENCE, INDUCED_DRAG,
+        VERSION_32,
+        // inputs
+        WIND_X, WIND_Y, WIND_Z,
+        PG_CORRECTION, WAVEDRAG,
+        // outputs
+        FORCE_X, FORCE_Y, FORCE_Z,
+        TORQUE_X, TORQUE_Y, TORQUE_Z,
+        ALPHA, STALL_ALPHA,
+        COMPUTED,   // not skipped for zero wind or coefficients
+        ALPHA_SET,  // alpha and stall alpha were computed
+        NUM_FIELDS
+    };
+
+    float* field(Field f) { return &_data[f * _stride]; }
+    const float* field(Field f) const { return &_data[f * _stride]; }
+
+    void calcBlock(int first, float rho);
+
+    int _n {0};
+    int _stride {0};    // _n rounded up to LANES
+    std::vector<float> _data;
+    std::vector<int> _transonic;
+    std::vector<float> _mcrit;
+    std::vector<float> _pgCoefficients;
+};
+
+}; // namespace yasim
+#endif // _SURFACEBATCH_HPP
@@ -201,6 +201,24 @@ void Wing::setSectionDrag(int section, float pdrag)
     ((WingSection*)_sections.get(section))->_dragScale = pdrag;
 }
 
+float Wing::getSectionDrag(int section) const
+{
+    return ((WingSection*)_sections.get(section))->_dragScale;
+}
+
+float Wing::getSectionLiftRatio(int section) const
+{
+    return ((WingSection*)_sections.get(section))->getLiftRatio();
+}
+
+/// set the results of the solver for a compiled wing
+void Wing::setSectionCoefficients(int section, float drag, float liftRatio)
+{
+    WingSection* ws = (WingSection*)_sections.get(section);
+    ws->setDragCoefficient(drag);
+    ws->setLiftRatio(liftRatio);
+}
+
 void Wing::setSectionStallParams(int section, StallParams sp)
 {
     ((WingSection*)_sections.get(section))->_stallParams = sp;
@@ -170,6 +170,11 @@ public:
     void setFlapParams(int section, WingFlaps type, FlapParams fp);
     void setSectionDrag(int section, float pdrag);
     void setSectionStallParams(int section, StallParams sp);
+    int numSections() const { return _sections.size(); }
+    // solver results per section, valid only after compile()
+    float getSectionDrag(int section) const;
+    float getSectionLiftRatio(int section) const;
+    void setSectionCoefficients(int section, float drag, float liftRatio);
     
     // Compile the thing into a bunch of Surface objects
     void compile();
@@ -177,6 +182,7 @@ public:
     void multiplyDragCoefficient(float factor);
     // setIncidence used to rotate (trim) the hstab
     bool setIncidence(float incidence);
+    float getIncidence() const { return _incidence; };
     // limits for setIncidence
     void setIncidenceMin(float min) { _incidenceMin = min; };
     void setIncidenceMax(float max) { _incidenceMax = max; };
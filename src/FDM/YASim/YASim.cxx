@@ -5,8 +5,12 @@
 
 #include <cstdlib>
 #include <cstdio>
+#include <regex>
+#include <set>
 
 #include <simgear/debug/logstream.hxx>
+#include <simgear/io/iostreams/sgstream.hxx>
+#include <simgear/io/sg_file.hxx>
 #include <simgear/math/sg_geodesy.hxx>
 #include <simgear/misc/sg_path.hxx>
 #include <simgear/scene/model/placement.hxx>
@@ -14,6 +18,7 @@
 
 #include <Main/globals.hxx>
 #include <Main/fg_props.hxx>
+#include <flightgearBuildId.h>
 
 #include "yasim-common.hpp"
 #include "FGFDM.hpp"
@@ -61,6 +66,37 @@ void YASim::property_associations(
     return _fdm->property_associations(fn);
 }
 
+string YASim::solverCacheKey(const SGPath& xml)
+{
+    // <!ENTITY name SYSTEM "file"> (or PUBLIC "id" "file") declarations
+    static const std::regex entity("<!ENTITY\\s+(?:%\\s+)?[^\\s]+\\s+"
+                                   "(?:SYSTEM|PUBLIC\\s+(?:\"[^\"]*\"|'[^']*'))\\s+"
+                                   "(?:\"([^\"]*)\"|'([^']*)')");
+
+    string key = string(FLIGHTGEAR_VERSION) + " " + REVISION;
+    std::vector<SGPath> files{xml};
+    std::set<string> seen{xml.realpath().utf8Str()};
+    for (size_t i = 0; i < files.size(); ++i) {
+        const string hash = SGFile(files[i]).computeHash();
+        if (hash.empty()) {
+            return {}; // can't tell whether it changed
+        }
+        key += " " + hash;
+
+        sg_ifstream in(files[i]);
+        const string text = in.read_all();
+        for (std::sregex_iterator m(text.begin(), text.end(), entity), end; m != end; ++m) {
+            const string name = (*m)[1].matched ? (*m)[1].str() : (*m)[2].str();
+            const SGPath included = files[i].dir() / name;
+            if (seen.insert(included.realpath().utf8Str()).second) {
+                files.push_back(included);
+            }
+        }
+    }
+
+    return key;
+}
+
 void YASim::report()
 {
     Airplane* a = _fdm->getAirplane();
@@ -174,6 +210,14 @@ void YASim::init()
         throw e;
     }
 
+    // The solver results only depend on the code and the XML, so they are
+    // kept between sessions and only solved again once either changes.
+    const string key = solverCacheKey(f);
+    if (!key.empty()) {
+        const string hash = SGFile(f).computeHash();
+        airplane->setSolverCache(globals->get_fg_home() / "YASim" / (hash + ".xml"), key);
+    }
+
     // Compile it into a real airplane, and tell the user what they got
     airplane->compile();
     report();
@@ -1,7 +1,10 @@
 #ifndef _YASIM_HXX
 #define _YASIM_HXX
 
+#include <simgear/misc/sg_path.hxx>
+
 #include <FDM/flight.hxx>
+#include <string>
 #include <vector>
 
 namespace yasim { class FGFDM; };
@@ -21,6 +24,11 @@ public:
     // Subsystem identification.
     static const char* staticSubsystemClassId() { return "yasim"; }
 
+    /// Identifies the solver results of the YASim XML file for caching
+    /// them: the FlightGear version and the hashes of the file and of any
+    /// files it includes as external entities. Empty if one can't be read.
+    static std::string solverCacheKey(const SGPath& xml);
+
     void property_associations(
             std::function<void(const std::string& from, const std::string& to)> fn
             ) override;
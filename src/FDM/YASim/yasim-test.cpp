@@ -6,12 +6,15 @@
 #include <simgear/props/props.hxx>
 #include <simgear/xml/easyxml.hxx>
 #include <simgear/misc/sg_path.hxx>
+#include <simgear/timing/timestamp.hxx>
 
 #include "yasim-common.hpp"
 #include "FGFDM.hpp"
 #include "Atmosphere.hpp"
 #include "RigidBody.hpp"
 #include "Airplane.hpp"
+#include "Surface.hpp"
+#include "SurfaceBatch.hpp"
 
 using namespace yasim;
 using std::string;
@@ -395,6 +398,80 @@ void report(Airplane* a)
     printf(" Axis    z     Yaw   %7.0f  %7.0f  %7.0f\n", SI_inertia[6], SI_inertia[7], SI_inertia[8]);
 }
 
+// Time the aerodynamic forces of all surfaces at the cruise AoA, one
+// surface at a time (Surface::calcForce) and all at once (SurfaceBatch),
+// and report how long compiling (mostly solving) the airplane took
+void yasim_bench(Airplane* a, double solveTime, float alt, float kts, int iterations)
+{
+    printf("solver iterations : %d\n", a->getSolutionIterations());
+    printf("compile and solve : %.1f ms\n", 1e3 * solveTime);
+
+    _setup(a, Airplane::NONE, alt);
+    Model* m = a->getModel();
+    Vector* surfaces = m->getSurfaces();
+    int n = surfaces->size();
+    if (n == 0 || iterations <= 0) return;
+
+    State s;
+    s.setupState(a->getCruiseAoA(), kts * KTS2MPS, 0);
+    Atmosphere atmo;
+    atmo.setStandard(alt);
+    float rho = atmo.getDensity();
+    float mach = atmo.machFromSpeed(kts * KTS2MPS);
+
+    // no wind and no rotation: the same local wind everywhere
+    float zero[3] {0,0,0}, lv[3], cg[3];
+    Math::vmul33(s.orient, s.v, lv);
+    m->getBody()->getCG(cg);
+    float wind[3];
+    Math::mul3(-1, lv, wind);
+
+    SurfaceBatch batch;
+    batch.load(*surfaces);
+    batch.calcWind(zero, zero, lv, cg);
+
+    float force[3], torque[3], sum[3] {0,0,0};
+    SGTimeStamp start = SGTimeStamp::now();
+    for(int i=0; i<iterations; i++) {
+        for(int j=0; j<n; j++) {
+            ((Surface*)surfaces->get(j))->calcForce(wind, rho, mach, force, torque);
+            Math::add3(force, sum, sum);
+        }
+    }
+    double scalar = (SGTimeStamp::now() - start).toSecs();
+
+    start = SGTimeStamp::now();
+    for(int i=0; i<iterations; i++) {
+        batch.calcForces(rho, mach);
+        for(int j=0; j<n; j++) {
+            batch.getForce(j, force, torque);
+            Math::add3(force, sum, sum);
+        }
+    }
+    double batched = (SGTimeStamp::now() - start).toSecs();
+
+    // largest difference between the two, relative to the force
+    float maxDiff = 0;
+    for(int j=0; j<n; j++) {
+        float bforce[3], btorque[3];
+        ((Surface*)surfaces->get(j))->calcForce(wind, rho, mach, force, torque);
+        batch.getForce(j, bforce, btorque);
+        Math::sub3(force, bforce, bforce);
+        float mag = Math::mag3(force);
+        if (mag > 0 && Math::mag3(bforce) / mag > maxDiff)
+            maxDiff = Math::mag3(bforce) / mag;
+    }
+
+    printf("surfaces          : %d\n", n);
+    printf("iterations        : %d\n", iterations);
+    printf("calcForce         : %.1f ns/surface\n", 1e9 * scalar / (iterations * (double)n));
+    printf("SurfaceBatch      : %.1f ns/surface\n", 1e9 * batched / (iterations * (double)n));
+    printf("speedup           : %.2f\n", batched > 0 ? scalar / batched : 0);
+    printf("max. difference   : %g\n", maxDiff);
+    // (and keep the compiler from dropping the loops)
+    printf("# checksum %g\n", Math::mag3(sum));
+}
+
 int usage()
 {
     fprintf(stderr, "Usage: \n");
@@ -414,6 +491,8 @@ int usage()
     fprintf(stderr, "  yasim <aircraft.xml> [--detailed-min-speed -approach]\n");
     fprintf(stderr, "  yasim <aircraft.xml> [--detailed-min-speed -cruise]\n");
     fprintf(stderr, "                       -test print summary and output like -g -m \n");
+    fprintf(stderr, "  yasim <aircraft.xml> [--bench [-n iterations] [-a meters] [-s kts] ]\n");
+    fprintf(stderr, "                       --bench time the solver and the surface forces, one by one and batched\n");
     return 1;
 }
 
@@ -445,7 +524,9 @@ int main(int argc, char** argv)
         a->setSolverMaxIterations(2000);
         verbose=true;
     }
+    SGTimeStamp start = SGTimeStamp::now();
     a->compile(verbose);
+    double solveTime = (SGTimeStamp::now() - start).toSecs();
     if(a->getFailureMsg()) {
         printf("SOLUTION FAILURE: %s\n", a->getFailureMsg());
     }
@@ -551,6 +632,22 @@ int main(int argc, char** argv)
         else if(strcmp(argv[2], "-m") == 0) {
             yasim_masses(a);
         }
+        else if(strcmp(argv[2], "--bench") == 0) {
+            int iterations = 100000;
+            for(int i=3; i<argc; i++) {
+                if (std::strcmp(argv[i], "-n") == 0) {
+                    if (i+1 < argc) iterations = std::atoi(argv[++i]);
+                }
+                else if (std::strcmp(argv[i], "-a") == 0) {
+                    if (i+1 < argc) alt = std::atof(argv[++i]);
+                }
+                else if(std::strcmp(argv[i], "-s") == 0) {
+                    if(i+1 < argc) kts = std::atof(argv[++i]);
+                }
+                else return usage();
+            }
+            yasim_bench(a, solveTime, alt, kts, iterations);
+        }
         else if(strcmp(argv[2], "--min-speed") == 0) {
             alt = 10;
             for(int i=3; i<argc; i++) {
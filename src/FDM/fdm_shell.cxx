@@ -31,6 +31,7 @@
 #include <FDM/fdm_shell.hxx>
 #include <FDM/flight.hxx>
 #include <Aircraft/replay.hxx>
+#include <Main/FrameProfiler.hxx>
 #include <Main/globals.hxx>
 #include <Main/fg_props.hxx>
 #include <Scenery/scenery.hxx>
@@ -195,6 +196,7 @@ void FDMShell::doInitAndBind()
 
 void FDMShell::update(double dt)
 {
+  FG_PROFILE_SCOPE("subsystems/flight");
   if (!_impl) {
     return;
   }
@@ -222,15 +224,16 @@ void FDMShell::update(double dt)
 
   // AI aerodynamic wake interaction
   if (_ai_wake_enabled->getBoolValue()) {
-      for (FGAIBase* base : _ai_mgr->get_ai_list()) {
+      const SGVec3d pos = _impl->getCartPosition();
+      const double maxRangeM = _max_radius_nm->getDoubleValue()*SG_NM_TO_METER;
+      for (FGAIBase* base : _ai_mgr->findObjectsInRange(pos, maxRangeM)) {
           try {
               if (base->isa(FGAIBase::object_type::otAircraft) ) {
-                  SGVec3d pos = _impl->getCartPosition();
                   const SGSharedPtr<FGAIAircraft> aircraft = dynamic_cast<FGAIAircraft*>(base);
                   double range = _ai_mgr->calcRangeFt(pos, aircraft)*SG_FEET_TO_METER;
 
                   if (!aircraft->onGround() && aircraft->getSpeed() > 0.0
-                      && range < _max_radius_nm->getDoubleValue()*SG_NM_TO_METER) {
+                      && range < maxRangeM) {
                       _impl->add_ai_wake(aircraft);
                   }
               }
@@ -0,0 +1,398 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "FrameProfiler.hxx"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include <simgear/props/props.hxx>
+
+#include <Main/fg_props.hxx>
+
+namespace flightgear
+{
+
+namespace
+{
+
+// per thread; 64k events is several seconds of main loop activity
+const uint64_t RING_SIZE = 1 << 16;
+const uint64_t RING_MASK = RING_SIZE - 1;
+
+// frames of history the percentiles are computed over
+const size_t WINDOW_FRAMES = 600;
+
+const int64_t PUBLISH_INTERVAL_NS = 1000 * 1000 * 1000;
+
+struct Event {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<int64_t> begin{0};
+    std::atomic<int64_t> end{0};
+};
+
+struct EventCopy {
+    const char* name;
+    int64_t begin;
+    int64_t end;
+};
+
+/*
+ * Single writer (the owning thread), any number of readers. The writer bumps
+ * _claimed before overwriting a slot and _head once it is complete; a reader
+ * copies slots, then re-reads _claimed to find out which of its copies may
+ * have been overwritten while it was reading (a seqlock, per slot).
+ */
+class ThreadBuffer
+{
+public:
+    ThreadBuffer(int id) :
+        _name("thread-" + std::to_string(id)),
+        _events(new Event[RING_SIZE]),
+        _id(id)
+    {
+    }
+
+    void push(const char* name, int64_t begin, int64_t end)
+    {
+        const uint64_t i = _head.load(std::memory_order_relaxed);
+        _claimed.store(i + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        Event& e = _events[i & RING_MASK];
+        e.name.store(name, std::memory_order_relaxed);
+        e.begin.store(begin, std::memory_order_relaxed);
+        e.end.store(end, std::memory_order_relaxed);
+        _head.store(i + 1, std::memory_order_release);
+    }
+
+    /**
+     * Copy the complete events with index >= from into out, and return the
+     * index following the last one. Events which have already been
+     * overwritten are skipped.
+     */
+    uint64_t read(uint64_t from, std::vector<EventCopy>& out) const
+    {
+        const uint64_t head = _head.load(std::memory_order_acquire);
+        if (head > RING_SIZE) {
+            from = std::max(from, head - RING_SIZE);
+        }
+
+        const size_t start = out.size();
+        for (uint64_t i = from; i < head; ++i) {
+            const Event& e = _events[i & RING_MASK];
+            out.push_back({e.name.load(std::memory_order_relaxed),
+                           e.begin.load(std::memory_order_relaxed),
+                           e.end.load(std::memory_order_relaxed)});
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t claimed = _claimed.load(std::memory_order_relaxed);
+        if (claimed > RING_SIZE && claimed - RING_SIZE > from) {
+            // the writer lapped us while copying: drop the oldest copies
+            const size_t overwritten = std::min<uint64_t>(claimed - RING_SIZE - from, head - from);
+            out.erase(out.begin() + start, out.begin() + start + overwritten);
+        }
+
+        return head;
+    }
+
+    int id() const { return _id; }
+
+    // guarded by the registry lock
+    std::string _name;
+    uint64_t _statsCursor = 0;
+
+private:
+    std::unique_ptr<Event[]> _events;
+    std::atomic<uint64_t> _head{0};
+    std::atomic<uint64_t> _claimed{0};
+    const int _id;
+};
+
+struct Registry {
+    std::mutex lock;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+};
+
+Registry& registry()
+{
+    static Registry r;
+    return r;
+}
+
+// buffers are kept by the registry after their thread exits, so their
+// events still show up in dumps
+thread_local ThreadBuffer* t_buffer = nullptr;
+
+ThreadBuffer* threadBuffer()
+{
+    if (!t_buffer) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> g(r.lock);
+        auto buffer = std::make_shared<ThreadBuffer>(static_cast<int>(r.buffers.size()) + 1);
+        r.buffers.push_back(buffer);
+        t_buffer = buffer.get();
+    }
+
+    return t_buffer;
+}
+
+struct Statistics {
+    std::vector<int64_t> window;
+    size_t next = 0;
+    int64_t frameTotal = 0;
+    bool inFrame = false;
+    bool changed = false;
+
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    SGPropertyNode_ptr p50Node;
+    SGPropertyNode_ptr p99Node;
+
+    void addFrame()
+    {
+        if (window.size() < WINDOW_FRAMES) {
+            window.push_back(frameTotal);
+        } else {
+            window[next] = frameTotal;
+            next = (next + 1) % WINDOW_FRAMES;
+        }
+
+        frameTotal = 0;
+        inFrame = false;
+        changed = true;
+    }
+
+    void compute(std::vector<int64_t>& scratch)
+    {
+        scratch = window;
+        auto percentile = [&scratch](double p) {
+            auto it = scratch.begin() + static_cast<size_t>(p * (scratch.size() - 1));
+            std::nth_element(scratch.begin(), it, scratch.end());
+            return *it * 1e-6;
+        };
+
+        p50Ms = percentile(0.5);
+        p99Ms = percentile(0.99);
+        changed = false;
+    }
+};
+
+// only touched by endFrame(), statistics() and reset(), on the main thread
+struct StatisticsState {
+    std::unordered_map<std::string, Statistics> byName;
+    std::unordered_map<const char*, Statistics*> byPointer;
+    std::vector<Statistics*> inFrame;
+    std::vector<EventCopy> events;
+    std::vector<int64_t> scratch;
+    int64_t lastPublish = 0;
+    SGPropertyNode_ptr enabledNode;
+
+    Statistics& find(const char* name)
+    {
+        auto it = byPointer.find(name);
+        if (it != byPointer.end()) {
+            return *it->second;
+        }
+
+        Statistics* s = &byName[name];
+        byPointer[name] = s;
+        return *s;
+    }
+
+    void publish(const std::string& name, Statistics& s)
+    {
+        if (!s.p50Node) {
+            SGPropertyNode* n = fgGetNode("/sim/performance/" + name, true);
+            s.p50Node = n->getNode("p50-ms", true);
+            s.p99Node = n->getNode("p99-ms", true);
+        }
+
+        s.p50Node->setDoubleValue(s.p50Ms);
+        s.p99Node->setDoubleValue(s.p99Ms);
+    }
+};
+
+StatisticsState& statisticsState()
+{
+    static StatisticsState s;
+    return s;
+}
+
+void writeJSONString(std::ostream& out, const std::string& s)
+{
+    out << '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << ' ';
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+} // anonymous namespace
+
+std::atomic<bool> FrameProfiler::_enabled{true};
+const FrameProfiler::Clock::time_point FrameProfiler::_epoch = FrameProfiler::Clock::now();
+
+void FrameProfiler::setEnabled(bool enabled)
+{
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void FrameProfiler::record(const char* name, int64_t beginNs, int64_t endNs)
+{
+    threadBuffer()->push(name, beginNs, endNs);
+}
+
+void FrameProfiler::setThreadName(const std::string& name)
+{
+    ThreadBuffer* buffer = threadBuffer();
+    std::lock_guard<std::mutex> g(registry().lock);
+    buffer->_name = name;
+}
+
+void FrameProfiler::endFrame()
+{
+    StatisticsState& state = statisticsState();
+    if (!state.enabledNode) {
+        state.enabledNode = fgGetNode("/sim/performance/frame-profiler", true);
+        if (!state.enabledNode->hasValue()) {
+            state.enabledNode->setBoolValue(true);
+        }
+    }
+
+    setEnabled(state.enabledNode->getBoolValue());
+
+    state.events.clear();
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> g(r.lock);
+        for (auto& buffer : r.buffers) {
+            buffer->_statsCursor = buffer->read(buffer->_statsCursor, state.events);
+        }
+    }
+
+    for (const auto& e : state.events) {
+        Statistics& s = state.find(e.name);
+        if (!s.inFrame) {
+            s.inFrame = true;
+            state.inFrame.push_back(&s);
+        }
+        s.frameTotal += e.end - e.begin;
+    }
+
+    for (auto s : state.inFrame) {
+        s->addFrame();
+    }
+    state.inFrame.clear();
+
+    const int64_t t = now();
+    if (t - state.lastPublish < PUBLISH_INTERVAL_NS) {
+        return;
+    }
+
+    state.lastPublish = t;
+    for (auto& it : state.byName) {
+        if (it.second.changed) {
+            it.second.compute(state.scratch);
+            state.publish(it.first, it.second);
+        }
+    }
+}
+
+bool FrameProfiler::statistics(const std::string& name, double& p50Ms, double& p99Ms)
+{
+    StatisticsState& state = statisticsState();
+    auto it = state.byName.find(name);
+    if (it == state.byName.end() || it->second.window.empty()) {
+        return false;
+    }
+
+    if (it->second.changed) {
+        it->second.compute(state.scratch);
+    }
+
+    p50Ms = it->second.p50Ms;
+    p99Ms = it->second.p99Ms;
+    return true;
+}
+
+void FrameProfiler::writeChromeTrace(std::ostream& out)
+{
+    std::vector<std::pair<int, std::string>> threads;
+    std::vector<std::pair<int, std::vector<EventCopy>>> events;
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> g(r.lock);
+        for (auto& buffer : r.buffers) {
+            threads.emplace_back(buffer->id(), buffer->_name);
+            events.emplace_back(buffer->id(), std::vector<EventCopy>());
+            buffer->read(0, events.back().second);
+        }
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&out, &first]() {
+        if (!first) {
+            out << ",\n";
+        }
+        first = false;
+    };
+
+    for (const auto& t : threads) {
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t.first
+            << ",\"args\":{\"name\":";
+        writeJSONString(out, t.second);
+        out << "}}";
+    }
+
+    const auto oldPrecision = out.precision(3);
+    const auto oldFlags = out.setf(std::ios::fixed, std::ios::floatfield);
+    for (const auto& t : events) {
+        for (const auto& e : t.second) {
+            separator();
+            out << "{\"name\":";
+            writeJSONString(out, e.name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << t.first
+                << ",\"ts\":" << e.begin * 1e-3
+                << ",\"dur\":" << (e.end - e.begin) * 1e-3 << "}";
+        }
+    }
+    out.precision(oldPrecision);
+    out.flags(oldFlags);
+
+    out << "\n]}\n";
+}
+
+void FrameProfiler::reset()
+{
+    Registry& r = registry();
+    {
+        std::lock_guard<std::mutex> g(r.lock);
+        for (auto& buffer : r.buffers) {
+            buffer->_statsCursor = buffer->read(buffer->_statsCursor, statisticsState().events);
+        }
+    }
+
+    // keep the thread buffers, their owners still point at them
+    StatisticsState& state = statisticsState();
+    state = StatisticsState();
+}
+
+} // namespace flightgear
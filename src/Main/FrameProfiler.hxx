@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX_FileComment: Lightweight per-frame timing of the main loop and subsystems
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace flightgear
+{
+
+/**
+ * Always-on, low overhead timing of named code regions.
+ *
+ * A Scope (normally created with FG_PROFILE_SCOPE) records its begin and end
+ * time into a ring buffer belonging to the calling thread; recording takes
+ * no locks, so scopes may be used on any thread. Names must be string
+ * literals (or otherwise outlive the profiler), they are stored by pointer.
+ *
+ * Once per frame the main loop calls endFrame(), which folds the events
+ * recorded since the previous frame into a rolling window per name, and
+ * periodically publishes the median and 99th percentile of the per-frame
+ * total to /sim/performance/<name>/p50-ms and p99-ms. Setting
+ * /sim/performance/frame-profiler to false stops recording.
+ *
+ * The recent contents of all ring buffers (a few seconds' worth) can be
+ * written in the Chrome trace event format, which chrome://tracing,
+ * Perfetto and speedscope can open, using the 'frame-profiler-dump'
+ * command.
+ */
+class FrameProfiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name) :
+            _name(isEnabled() ? name : nullptr)
+        {
+            if (_name) {
+                _begin = now();
+            }
+        }
+
+        ~Scope()
+        {
+            if (_name) {
+                record(_name, _begin, now());
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* _name;
+        int64_t _begin = 0;
+    };
+
+    static bool isEnabled()
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    static void setEnabled(bool enabled);
+
+    /// nanoseconds since the profiler epoch (process start, roughly)
+    static int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _epoch).count();
+    }
+
+    static void record(const char* name, int64_t beginNs, int64_t endNs);
+
+    /// name shown for the calling thread in trace dumps
+    static void setThreadName(const std::string& name);
+
+    /**
+     * Update the rolling statistics with everything recorded since the
+     * previous call, and publish them if due. Main thread only.
+     */
+    static void endFrame();
+
+    /**
+     * Rolling per-frame statistics for name, in milliseconds, as of the last
+     * endFrame(). Returns false if nothing was recorded under that name.
+     */
+    static bool statistics(const std::string& name, double& p50Ms, double& p99Ms);
+
+    /// write buffered events as Chrome trace event JSON
+    static void writeChromeTrace(std::ostream& out);
+
+    /// forget the statistics and any events not yet counted (for tests)
+    static void reset();
+
+private:
+    static std::atomic<bool> _enabled;
+    static const Clock::time_point _epoch;
+};
+
+} // namespace flightgear
+
+#define FG_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FG_PROFILE_CONCAT(a, b) FG_PROFILE_CONCAT_IMPL(a, b)
+
+/// time the rest of the enclosing block under name (a string literal)
+#define FG_PROFILE_SCOPE(name) \
+    ::flightgear::FrameProfiler::Scope FG_PROFILE_CONCAT(fgProfileScope, __LINE__)(name)
@@ -0,0 +1,248 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "IOThread.hxx"
+
+#include <algorithm>
+
+#include <simgear/debug/logstream.hxx>
+#include <simgear/io/iochannel.hxx>
+
+#include <Network/protocol.hxx>
+
+#include "FrameProfiler.hxx"
+
+using std::chrono::steady_clock;
+
+namespace flightgear
+{
+
+namespace
+{
+
+// per channel and direction; beyond this the oldest messages are dropped
+const size_t MAX_PENDING = 64;
+
+// even without input channels, check for new ones now and then
+const auto MAX_SLEEP = std::chrono::milliseconds(100);
+
+} // anonymous namespace
+
+void IOThread::Buffer::push(const char* data, size_t length)
+{
+    if (count == MAX_PENDING) {
+        std::rotate(items.begin(), items.begin() + 1, items.begin() + count);
+        --count;
+    }
+
+    if (count == items.size()) {
+        items.emplace_back();
+    }
+    items[count++].assign(data, length);
+}
+
+IOThread::IOThread()
+{
+    _thread = std::thread([this] { run(); });
+}
+
+IOThread::~IOThread()
+{
+    {
+        std::lock_guard<std::mutex> g(_wakeLock);
+        _stop = true;
+    }
+    _wakeCondition.notify_one();
+    _thread.join();
+}
+
+void IOThread::add(FGProtocol* protocol)
+{
+    auto channel = std::make_shared<Channel>();
+    channel->protocol = protocol;
+
+    const SGProtocolDir dir = protocol->get_direction();
+    channel->input = (dir == SG_IO_IN) || (dir == SG_IO_BI);
+    channel->output = (dir == SG_IO_OUT) || (dir == SG_IO_BI);
+
+    const double hz = protocol->get_hz() > 0.0 ? protocol->get_hz() : 1.0;
+    channel->interval = std::chrono::duration_cast<steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / hz));
+    channel->nextRead = steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> g(_channelsLock);
+        _channels.push_back(channel);
+    }
+    _byProtocol[protocol] = channel;
+    wake();
+}
+
+void IOThread::remove(FGProtocol* protocol)
+{
+    auto it = _byProtocol.find(protocol);
+    if (it == _byProtocol.end()) {
+        return;
+    }
+
+    {
+        // waits for the current pass over the channels to finish
+        std::lock_guard<std::mutex> g(_channelsLock);
+        _channels.erase(std::remove(_channels.begin(), _channels.end(), it->second),
+                        _channels.end());
+    }
+    _byProtocol.erase(it);
+}
+
+bool IOThread::contains(FGProtocol* protocol) const
+{
+    return _byProtocol.find(protocol) != _byProtocol.end();
+}
+
+bool IOThread::process(FGProtocol* protocol)
+{
+    auto it = _byProtocol.find(protocol);
+    if (it == _byProtocol.end()) {
+        return false;
+    }
+
+    bool result = true;
+
+    Channel& c = *it->second;
+    if (c.input) {
+        {
+            std::lock_guard<std::mutex> g(c.lock);
+            std::swap(c.received, c.parseBuffer);
+        }
+
+        for (size_t i = 0; i < c.parseBuffer.count; ++i) {
+            std::string& record = c.parseBuffer.items[i];
+            protocol->parse_record(&record[0], static_cast<int>(record.size()));
+        }
+        c.parseBuffer.clear();
+    }
+
+    if (c.output) {
+        bool failed;
+        {
+            std::lock_guard<std::mutex> g(c.lock);
+            failed = c.writeFailed;
+            c.writeFailed = false;
+        }
+
+        // may exit, as FGProtocol::process() would have
+        if (failed) {
+            result = protocol->write_failed();
+        }
+
+        protocol->gen_message();
+
+        int length = 0;
+        const char* message = protocol->get_message(length);
+        if (message && length > 0) {
+            {
+                std::lock_guard<std::mutex> g(c.lock);
+                if (c.toSend.count == MAX_PENDING) {
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+                c.toSend.push(message, length);
+            }
+            wake();
+        }
+    }
+
+    return result;
+}
+
+void IOThread::wake()
+{
+    {
+        std::lock_guard<std::mutex> g(_wakeLock);
+        _work = true;
+    }
+    _wakeCondition.notify_one();
+}
+
+void IOThread::run()
+{
+    FrameProfiler::setThreadName("io");
+    std::vector<char> record(FG_MAX_MSG_SIZE + 1);
+
+    for (;;) {
+        const auto now = steady_clock::now();
+        auto wakeAt = now + MAX_SLEEP;
+        {
+            FG_PROFILE_SCOPE("io/thread");
+            std::lock_guard<std::mutex> g(_channelsLock);
+            for (auto& c : _channels) {
+                serve(*c, now, record);
+                if (c->input && c->nextRead < wakeAt) {
+                    wakeAt = c->nextRead;
+                }
+            }
+        }
+
+        std::unique_lock<std::mutex> wl(_wakeLock);
+        _wakeCondition.wait_until(wl, wakeAt, [this] { return _stop || _work; });
+        if (_stop) {
+            return;
+        }
+        _work = false;
+    }
+}
+
+void IOThread::serve(Channel& c, steady_clock::time_point now, std::vector<char>& record)
+{
+    SGIOChannel* io = c.protocol->get_io_channel();
+
+    if (c.output) {
+        {
+            std::lock_guard<std::mutex> g(c.lock);
+            std::swap(c.toSend, c.writeBuffer);
+        }
+
+        bool failed = false;
+        for (size_t i = 0; i < c.writeBuffer.count; ++i) {
+            const std::string& message = c.writeBuffer.items[i];
+            if (!io->write(message.data(), static_cast<int>(message.size()))) {
+                SG_LOG(SG_IO, SG_WARN, "Error writing data to " << c.protocol->get_name());
+                failed = true;
+            }
+        }
+        c.writeBuffer.clear();
+
+        // the main thread handles the error, it may have to exit
+        if (failed) {
+            std::lock_guard<std::mutex> g(c.lock);
+            c.writeFailed = true;
+        }
+    }
+
+    if (c.input && now >= c.nextRead) {
+        // a bounded number of records per pass, so one busy channel can't
+        // starve the others
+        for (size_t n = 0; n < MAX_PENDING; ++n) {
+            const int length = c.protocol->read_record(record.data(), FG_MAX_MSG_SIZE);
+            if (length <= 0) {
+                break;
+            }
+
+            std::lock_guard<std::mutex> g(c.lock);
+            if (c.received.count == MAX_PENDING) {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            c.received.push(record.data(), length);
+        }
+
+        c.nextRead += c.interval;
+        if (c.nextRead <= now) {
+            c.nextRead = now + c.interval;
+        }
+    }
+}
+
+} // namespace flightgear
@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX_FileComment: Dedicated thread for reading and writing FGIO channels
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class FGProtocol;
+
+namespace flightgear
+{
+
+/**
+ * Moves the channel I/O of FGIO protocols off the main thread.
+ *
+ * The main thread keeps everything which touches the property tree: at the
+ * rate of the channel it generates the outgoing message (the property
+ * snapshot) and parses the records which have come in. The I/O thread does
+ * the reads and writes, including the ones which find nothing to read. The
+ * two exchange messages through a pair of buffers per direction: each side
+ * fills its own, and they are swapped under a short lock.
+ *
+ * Only protocols which implement FGProtocol::supports_io_thread() and its
+ * companions can be added. Once added, the I/O thread is the only user of
+ * the protocol's SGIOChannel until the protocol is removed again.
+ */
+class IOThread
+{
+public:
+    IOThread();
+    ~IOThread();
+
+    /// start doing the I/O of an opened protocol
+    void add(FGProtocol* protocol);
+
+    /// Stop doing the I/O of protocol. Once this returns, the I/O thread
+    /// doesn't touch it any more; messages not yet written are discarded.
+    void remove(FGProtocol* protocol);
+
+    bool contains(FGProtocol* protocol) const;
+
+    /**
+     * The main thread side of FGProtocol::process(): apply the records read
+     * since the last call, then hand over a new outgoing message. Write
+     * errors on the I/O thread since the last call are passed on to
+     * FGProtocol::write_failed(), whose result is returned.
+     */
+    bool process(FGProtocol* protocol);
+
+    /// messages and records dropped because too many were waiting
+    uint64_t droppedMessages() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+    /// messages, reusing their storage from one swap to the next
+    struct Buffer {
+        std::vector<std::string> items;
+        size_t count = 0;
+
+        void push(const char* data, size_t length);
+        void clear() { count = 0; }
+    };
+
+    struct Channel {
+        FGProtocol* protocol;
+        bool input;
+        bool output;
+        std::chrono::steady_clock::duration interval; ///< between reads
+        std::chrono::steady_clock::time_point nextRead;
+
+        // guarded by lock; the other halves are owned by one thread each
+        std::mutex lock;
+        Buffer received;
+        Buffer toSend;
+        bool writeFailed = false;
+
+        Buffer writeBuffer; ///< I/O thread
+        Buffer parseBuffer; ///< main thread
+    };
+
+    void run();
+    void serve(Channel& channel, std::chrono::steady_clock::time_point now, std::vector<char>& record);
+    void wake();
+
+    std::thread _thread;
+
+    // held by the I/O thread while it works on the channels
+    std::mutex _channelsLock;
+    std::vector<std::shared_ptr<Channel>> _channels;
+
+    // main thread only
+    std::unordered_map<FGProtocol*, std::shared_ptr<Channel>> _byProtocol;
+
+    std::mutex _wakeLock;
+    std::condition_variable _wakeCondition;
+    bool _work = false;
+    bool _stop = false;
+
+    std::atomic<uint64_t> _dropped{0};
+};
+
+} // namespace flightgear
@@ -0,0 +1,75 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX_FileComment: Bounded lock-free queue between two threads
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace flightgear
+{
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer
+ * thread. Neither side ever waits: push() fails when the queue is full and
+ * pop() when it is empty, what to do then is up to the caller (drop, retry
+ * or wait on something else).
+ *
+ * The slots are allocated up front and reused, so items that own buffers
+ * (e.g. a std::vector moved in and out) keep their capacity.
+ */
+template <typename T>
+class SPSCQueue
+{
+public:
+    explicit SPSCQueue(size_t capacity) : _slots(capacity + 1)
+    {
+    }
+
+    /// Producer: move item into the queue; false, leaving item alone, if full.
+    bool push(T& item)
+    {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        const size_t next = (tail + 1) % _slots.size();
+        if (next == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        _slots[tail] = std::move(item);
+        _tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer: move the oldest item into item; false if empty.
+    bool pop(T& item)
+    {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = std::move(_slots[head]);
+        _head.store((head + 1) % _slots.size(), std::memory_order_release);
+        return true;
+    }
+
+    /// Either side: the number of queued items, which may be out of date.
+    size_t size() const
+    {
+        const size_t head = _head.load(std::memory_order_acquire);
+        const size_t tail = _tail.load(std::memory_order_acquire);
+        return (tail + _slots.size() - head) % _slots.size();
+    }
+
+    size_t capacity() const { return _slots.size() - 1; }
+
+private:
+    std::vector<T> _slots;
+    alignas(64) std::atomic<size_t> _head{0}; ///< written by the consumer
+    alignas(64) std::atomic<size_t> _tail{0}; ///< written by the producer
+};
+
+} // namespace flightgear
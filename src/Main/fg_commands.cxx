@@ -35,6 +35,7 @@
 #include <Environment/presets.hxx>
 #include <Navaids/NavDataCache.hxx>
 #include <GUI/gui.h>
+#include <Main/FrameProfiler.hxx>
 #include <Main/sentryIntegration.hxx>
 
 #include "fg_init.hxx"
@@ -1036,6 +1037,37 @@ do_profiler_stop(const SGPropertyNode *arg, SGPropertyNode *root)
 #endif
 }
 
+/**
+ * Write the events buffered by the frame profiler (the last few seconds) in
+ * the Chrome trace event format, for chrome://tracing or Perfetto.
+ *
+ * @param filename defaults to fgfs-frame-trace.json in $FG_HOME
+ */
+static bool
+do_frame_profiler_dump(const SGPropertyNode *arg, SGPropertyNode *root)
+{
+    SGPath file(arg->getStringValue("filename"));
+    if (file.isNull())
+        file = globals->get_fg_home() / "fgfs-frame-trace.json";
+
+    const SGPath validated_path = SGPath(file).validate(true);
+    if (validated_path.isNull()) {
+        SG_LOG(SG_IO, SG_ALERT, "frame-profiler-dump: writing to '" << file << "' denied "
+                "(unauthorized directory - authorization no longer follows symlinks)");
+        return false;
+    }
+
+    sg_ofstream out(validated_path);
+    if (!out) {
+        SG_LOG(SG_IO, SG_ALERT, "frame-profiler-dump: unable to open " << validated_path);
+        return false;
+    }
+
+    flightgear::FrameProfiler::writeChromeTrace(out);
+    SG_LOG(SG_IO, SG_INFO, "frame-profiler-dump: wrote " << validated_path);
+    return true;
+}
+
 static bool do_reload_nasal_module(const SGPropertyNode* arg, SGPropertyNode*)
 {
     auto nasalSys = globals->get_subsystem<FGNasalSys>();
@@ -1105,6 +1137,7 @@ static struct {
 
     {"profiler-start", do_profiler_start},
     {"profiler-stop", do_profiler_stop},
+    {"frame-profiler-dump", do_frame_profiler_dump},
 
     {"video-start", do_video_start},
     {"video-stop", do_video_stop},
@@ -62,6 +62,7 @@
 #include <Network/ray.hxx>
 #include <Network/rul.hxx>
 #include <Network/generic.hxx>
+#include <Network/SharedMemoryChannel.hxx>
 
 #if FG_HAVE_DDS
 #include <simgear/io/SGDataDistributionService.hxx>
@@ -71,6 +72,8 @@
 #include <Network/HLA/hla.hxx>
 #endif
 
+#include "FrameProfiler.hxx"
+#include "IOThread.hxx"
 #include "globals.hxx"
 #include "fg_io.hxx"
 
@@ -240,11 +243,11 @@ FGIO::parse_port_config( const string_list& tokens, bool& o_ok )
 #if FG_HAVE_DDS
         SG_LOG( SG_IO, SG_ALERT, "Too few arguments for network protocol. At least 3 arguments required. " <<
                 "Usage: --" << protocol <<
-                "=(file|socket|serial|dds), (in|out|bi), hertz");
+                "=(file|socket|serial|shm|dds), (in|out|bi), hertz");
 #else
         SG_LOG( SG_IO, SG_ALERT, "Too few arguments for network protocol. At least 3 arguments required. " <<
                 "Usage: --" << protocol <<
-                "=(file|socket|serial), (in|out|bi), hertz");
+                "=(file|socket|serial|shm), (in|out|bi), hertz");
 #endif
         delete io;
         return NULL;
@@ -340,6 +343,17 @@ FGIO::parse_port_config( const string_list& tokens, bool& o_ok )
         }
 
         io->set_io_channel( new SGSocket( hostname, port, style ) );
+    } else if ( medium == "shm" ) {
+        if ( tokens.size() < 5 ) {
+            SG_LOG( SG_IO, SG_ALERT, "Too few arguments for shared memory communications. " <<
+                    "Usage --" << protocol << "=shm, (in|out), hertz, name");
+            delete io;
+            return NULL;
+        }
+        string name = tokens[4];
+        SG_LOG( SG_IO, SG_INFO, "  shared memory name = " << name );
+
+        io->set_io_channel( new FGSharedMemoryChannel( name, FG_MAX_MSG_SIZE ) );
     }
 #if FG_HAVE_DDS
     else if ( medium == "dds")  {
@@ -357,6 +371,10 @@ FGIO::parse_port_config( const string_list& tokens, bool& o_ok )
 }
 
 
+FGIO::FGIO() = default;
+
+FGIO::~FGIO() = default;
+
 // step through the port config streams (from fgOPTIONS) and setup
 // serial port channels for each
 void
@@ -367,6 +385,11 @@ FGIO::init()
 
     _realDeltaTime = fgGetNode("/sim/time/delta-realtime-sec");
 
+    if (fgGetBool("/sim/io/thread", false)) {
+        SG_LOG(SG_IO, SG_INFO, "Socket and serial I/O channels use the I/O thread");
+        _ioThread.reset(new flightgear::IOThread);
+    }
+
     // we could almost do this in a single step except pushing a valid
     // port onto the port list copies the structure and destroys the
     // original, which closes the port and frees up the fd ... doh!!!
@@ -413,17 +436,37 @@ FGProtocol* FGIO::add_channel(const string& config, bool& o_ok)
     }
 
     io_channels.push_back( p );
+    if (useIOThread(p)) {
+        _ioThread->add(p);
+    }
     return p;
 }
 
+bool FGIO::useIOThread(FGProtocol* p) const
+{
+    // files are read at the simulation's pace; shared memory never blocks,
+    // a thread would only add a copy
+    return _ioThread && p->supports_io_thread() &&
+           p->get_io_channel()->get_type() != sgFileType &&
+           !FGSharedMemoryChannel::isSharedMemory(p->get_io_channel());
+}
+
 void
 FGIO::reinit()
 {
     SG_LOG(SG_IO, SG_INFO, "FGIO::reinit()");
 
-    std::for_each(io_channels.begin(), io_channels.end(), [](FGProtocol* p) {
+    std::for_each(io_channels.begin(), io_channels.end(), [this](FGProtocol* p) {
         SG_LOG(SG_IO, SG_INFO, "Restarting channel \"" << p->get_name() << "\"");
+        // the I/O thread reads according to the configuration
+        const bool threaded = _ioThread && _ioThread->contains(p);
+        if (threaded) {
+            _ioThread->remove(p);
+        }
         p->reinit();
+        if (threaded) {
+            _ioThread->add(p);
+        }
     });
 }
 
@@ -431,6 +474,7 @@ FGIO::reinit()
 void
 FGIO::update( double /* delta_time_sec */ )
 {
+    FG_PROFILE_SCOPE("subsystems/io");
     // use wall-clock, not simulation, delta time, so that network
     // protocols update when the simulation is paused
     // see http://code.google.com/p/flightgear-bugs/issues/detail?id=125
@@ -447,7 +491,11 @@ FGIO::update( double /* delta_time_sec */ )
         p->dec_count_down( delta_time_sec );
         double dt = 1 / p->get_hz();
         if ( p->get_count_down() < 0.33 * dt ) {
-            p->process();
+            if (_ioThread && _ioThread->contains(p)) {
+                _ioThread->process(p);
+            } else {
+                p->process();
+            }
             p->inc_count();
             while ( p->get_count_down() < 0.33 * dt ) {
                 p->inc_count_down( dt );
@@ -464,6 +512,9 @@ FGIO::shutdown()
     for (; i != end; ++i )
     {
         FGProtocol *p = *i;
+        if (_ioThread) {
+            _ioThread->remove(p);
+        }
         if ( p->is_enabled() ) {
             p->close();
         }
@@ -473,6 +524,7 @@ FGIO::shutdown()
     }
 
     io_channels.clear();
+    _ioThread.reset();
     
     auto cmdMgr = globals->get_commands();
     cmdMgr->removeCommand("add-io-channel");
@@ -570,6 +622,9 @@ bool FGIO::commandRemoveChannel(const SGPropertyNode * arg, SGPropertyNode * roo
     removeFromPropertyTree(name);
 
     FGProtocol* p = *it;
+    if (_ioThread) {
+        _ioThread->remove(p);
+    }
     if (p->is_enabled()) {
         p->close();
     }
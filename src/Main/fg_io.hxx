@@ -29,16 +29,21 @@
 #include <simgear/structure/subsystem_mgr.hxx>
 #include <simgear/props/props.hxx>
 
+#include <memory>
 #include <vector>
 #include <string>
 
 class FGProtocol;
 
+namespace flightgear {
+class IOThread;
+}
+
 class FGIO : public SGSubsystem
 {
 public:
-    FGIO() = default;
-    ~FGIO() = default;
+    FGIO();
+    ~FGIO();
 
     // Subsystem API.
     void bind() override;
@@ -68,6 +73,8 @@ private:
     void removeFromPropertyTree(const string name);
     string generateName(const string protocol);
 
+    bool useIOThread(FGProtocol* p) const;
+
 private:
     // define the global I/O channel list
     //io_container global_io_list;
@@ -76,6 +83,9 @@ private:
     ProtocolVec io_channels;
 
     SGPropertyNode_ptr _realDeltaTime;
+
+    // does the reads and writes of socket and serial channels, if enabled
+    std::unique_ptr<flightgear::IOThread> _ioThread;
     
     bool commandAddChannel(const SGPropertyNode * arg, SGPropertyNode * root);
     bool commandRemoveChannel(const SGPropertyNode * arg, SGPropertyNode * root);
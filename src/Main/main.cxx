@@ -54,6 +54,7 @@
 #include <Add-ons/AddonManager.hxx>
 #include <GUI/MessageBox.hxx>
 #include <GUI/gui.h>
+#include <Main/FrameProfiler.hxx>
 #include <Main/locale.hxx>
 #include <Model/panelnode.hxx>
 #include <Navaids/NavDataCache.hxx>
@@ -116,6 +117,10 @@ static  SGSharedPtr<simgear::Notifications::NasalGarbageCollectionConfigurationN
 // is reposonsible for invoking all of the relevant per frame processing; most of which is handled by subsystems.
 static void fgMainLoop( void )
 {
+    // statistics for the previous frame, which includes its "main-loop" scope
+    flightgear::FrameProfiler::endFrame();
+    FG_PROFILE_SCOPE("main-loop");
+
 #ifdef NASAL_BACKGROUND_GC_THREAD
     //
     // the Nasal GC will automatically run when (during allocation) it discovers that more space is needed.
@@ -161,11 +166,20 @@ static void fgMainLoop( void )
     mgr->get_subsystem<TimeManager>()->computeTimeDeltas(sim_dt, real_dt);
 
     // update all subsystems
-    mgr->update(sim_dt);
+    {
+        FG_PROFILE_SCOPE("subsystems");
+        mgr->update(sim_dt);
+    }
 
     // flush commands waiting in the queue
-    SGCommandMgr::instance()->executedQueuedCommands();
-    simgear::AtomicChangeListener::fireChangeListeners();
+    {
+        FG_PROFILE_SCOPE("queued-commands");
+        SGCommandMgr::instance()->executedQueuedCommands();
+    }
+    {
+        FG_PROFILE_SCOPE("change-listeners");
+        simgear::AtomicChangeListener::fireChangeListeners();
+    }
 
 #ifdef NASAL_BACKGROUND_GC_THREAD
     simgear::Emesary::GlobalTransmitter::instance()->NotifyAll(mln_end);
@@ -285,6 +299,7 @@ void registerMainLoop()
     // init the Emesary receiver for Nasal
     nasal::initMainLoopRecipient();
 
+    flightgear::FrameProfiler::setThreadName("main");
     fgRegisterIdleHandler( fgMainLoop );
 }
 
@@ -21,6 +21,7 @@
 #include <simgear/scene/model/modellib.hxx>
 
 #include <Main/globals.hxx>
+#include <Main/FrameProfiler.hxx>
 #include <Main/fg_props.hxx>
 #include <Viewer/renderer.hxx>
 #include <Viewer/viewmgr.hxx>
@@ -274,6 +275,7 @@ FGAircraftModel::unbind ()
 void
 FGAircraftModel::update (double dt)
 {
+    FG_PROFILE_SCOPE("subsystems/aircraft-model");
     int view_number = globals->get_viewmgr()->getCurrentViewIndex();
     int is_internal = fgGetBool("/sim/current-view/internal");
 
@@ -0,0 +1,169 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "MPPropertyDelta.hxx"
+
+#include <cstring>
+
+#include <simgear/debug/logstream.hxx>
+
+#include "mpmessages.hxx"
+
+namespace
+{
+
+bool isString(simgear::props::Type type)
+{
+    return type == simgear::props::STRING || type == simgear::props::UNSPECIFIED;
+}
+
+bool isInt(simgear::props::Type type)
+{
+    return type == simgear::props::INT || type == simgear::props::LONG
+        || type == simgear::props::BOOL;
+}
+
+FGPropertyData* copyProperty(const FGPropertyData& p)
+{
+    FGPropertyData* copy = new FGPropertyData;
+    copy->id = p.id;
+    copy->type = p.type;
+    if (isString(p.type)) {
+        if (p.string_value) {
+            copy->string_value = new char[strlen(p.string_value) + 1];
+            strcpy(copy->string_value, p.string_value);
+        }
+    } else if (isInt(p.type)) {
+        copy->int_value = p.int_value;
+    } else {
+        copy->float_value = p.float_value;
+    }
+    return copy;
+}
+
+} // anonymous namespace
+
+//////////////////////////////////////////////////////////////////////
+//
+//  MPPropertyDeltaEncoder
+//
+//////////////////////////////////////////////////////////////////////
+void MPPropertyDeltaEncoder::store(const FGPropertyData& p, Value& v)
+{
+    v.type = p.type;
+    v.int_value = 0;
+    v.float_value = 0.0f;
+    v.string_value.clear();
+    if (isString(p.type)) {
+        if (p.string_value)
+            v.string_value = p.string_value;
+    } else if (isInt(p.type)) {
+        v.int_value = p.int_value;
+    } else {
+        v.float_value = p.float_value;
+    }
+}
+
+bool MPPropertyDeltaEncoder::equals(const FGPropertyData& p, const Value& v)
+{
+    if (p.type != v.type)
+        return false;
+    if (isString(p.type))
+        return v.string_value == (p.string_value ? p.string_value : "");
+    if (isInt(p.type))
+        return p.int_value == v.int_value;
+    return p.float_value == v.float_value;
+}
+
+int MPPropertyDeltaEncoder::keyframe(const std::vector<FGPropertyData*>& properties)
+{
+    mKeyframe.clear();
+    for (auto p : properties)
+        store(*p, mKeyframe[p->id]);
+
+    // zero means "no keyframe yet"
+    if (++mSequence <= 0)
+        mSequence = 1;
+    mSinceKeyframe = 1;
+    return mSequence;
+}
+
+void MPPropertyDeltaEncoder::changed(const std::vector<FGPropertyData*>& properties,
+                                     std::vector<FGPropertyData*>& changed)
+{
+    for (auto p : properties) {
+        auto it = mKeyframe.find(p->id);
+        if (it == mKeyframe.end() || !equals(*p, it->second))
+            changed.push_back(p);
+    }
+    ++mSinceKeyframe;
+}
+
+void MPPropertyDeltaEncoder::reset()
+{
+    mKeyframe.clear();
+    mSequence = 0;
+    mSinceKeyframe = 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+//  MPPropertyDeltaDecoder
+//
+//////////////////////////////////////////////////////////////////////
+MPPropertyDeltaDecoder::~MPPropertyDeltaDecoder()
+{
+    clear();
+}
+
+void MPPropertyDeltaDecoder::clear()
+{
+    for (auto p : mKeyframe)
+        delete p;
+    mKeyframe.clear();
+}
+
+void MPPropertyDeltaDecoder::keyframe(int sequence, const std::vector<FGPropertyData*>& properties)
+{
+    clear();
+    mKeyframe.reserve(properties.size());
+    for (auto p : properties)
+        mKeyframe.push_back(copyProperty(*p));
+    mSequence = sequence;
+}
+
+void MPPropertyDeltaDecoder::merge(int base, std::vector<FGPropertyData*>& properties)
+{
+    if (base != mSequence) {
+        SG_LOG(SG_NETWORK, SG_DEBUG, "MP delta relative to keyframe " << base
+               << ", have " << mSequence);
+    }
+
+    // properties takes ownership of the merged result
+    mChanges.clear();
+    for (auto p : properties) {
+        FGPropertyData*& slot = mChanges[p->id];
+        delete slot;
+        slot = p;
+    }
+    properties.clear();
+
+    for (auto k : mKeyframe) {
+        auto it = mChanges.find(k->id);
+        if (it != mChanges.end()) {
+            properties.push_back(it->second);
+            mChanges.erase(it);
+        } else {
+            properties.push_back(copyProperty(*k));
+        }
+    }
+
+    // values which were not in the keyframe
+    for (auto& it : mChanges)
+        properties.push_back(it.second);
+    mChanges.clear();
+}
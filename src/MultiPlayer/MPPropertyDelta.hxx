@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX_FileComment: Keyframe relative encoding of multiplayer property values
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <simgear/props/props.hxx>
+
+struct FGPropertyData;
+
+/*
+ * The MP server relays each packet to every pilot in range, so a sender
+ * never learns what an individual receiver has seen. Delta packets are
+ * therefore relative to the last full packet (the keyframe), rather than
+ * to the previous packet: every delta carries all of the values which
+ * differ from the keyframe, so a lost delta costs nothing and a lost
+ * keyframe at most delays some values until the next one.
+ */
+class MPPropertyDeltaEncoder
+{
+public:
+    /// packets sent between keyframes, including the keyframe itself
+    void setKeyframeInterval(int packets) { mInterval = packets < 1 ? 1 : packets; }
+
+    /// true if the next packet has to be a keyframe
+    bool keyframeDue() const { return mSequence == 0 || mSinceKeyframe >= mInterval; }
+
+    /// Remembers the values of a keyframe about to be sent, and returns
+    /// its (non zero) sequence number.
+    int keyframe(const std::vector<FGPropertyData*>& properties);
+
+    int sequence() const { return mSequence; }
+
+    /// Appends to changed those of properties which differ from the
+    /// keyframe, or were not part of it, and counts a delta packet.
+    void changed(const std::vector<FGPropertyData*>& properties,
+                 std::vector<FGPropertyData*>& changed);
+
+    /// the next packet will be a keyframe
+    void reset();
+
+private:
+    struct Value {
+        simgear::props::Type type;
+        int int_value;
+        float float_value;
+        std::string string_value;
+    };
+
+    static void store(const FGPropertyData& p, Value& v);
+    static bool equals(const FGPropertyData& p, const Value& v);
+
+    std::map<unsigned, Value> mKeyframe;
+    int mSequence = 0;
+    int mInterval = 10;
+    int mSinceKeyframe = 0;
+};
+
+/// The keyframe of one sender, used to complete its delta packets.
+class MPPropertyDeltaDecoder
+{
+public:
+    ~MPPropertyDeltaDecoder();
+
+    void keyframe(int sequence, const std::vector<FGPropertyData*>& properties);
+
+    /**
+     * Turns the properties of a delta packet relative to keyframe base into
+     * a complete set, in the order of the keyframe. If the keyframe was lost,
+     * the previous one is used instead.
+     */
+    void merge(int base, std::vector<FGPropertyData*>& properties);
+
+    int sequence() const { return mSequence; }
+
+private:
+    void clear();
+
+    std::vector<FGPropertyData*> mKeyframe;
+    std::map<unsigned, FGPropertyData*> mChanges; // scratch for merge()
+    int mSequence = 0;
+};
@@ -31,9 +31,11 @@
 
 #include <iostream>
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <errno.h>
 #include <memory>
+#include <thread>
 
 #include <simgear/debug/logstream.hxx>
 #include <simgear/math/sg_random.hxx>
@@ -48,10 +50,13 @@
 
 #include <AIModel/AIManager.hxx>
 #include <AIModel/AIMultiplayer.hxx>
+#include <Main/FrameProfiler.hxx>
+#include <Main/SPSCQueue.hxx>
 #include <Main/fg_props.hxx>
 #include "multiplaymgr.hxx"
 #include "mpmessages.hxx"
 #include "MPServerResolver.hxx"
+#include "MPPropertyDelta.hxx"
 #include <FDM/fdm_shell.hxx>
 #include <FDM/flightProperties.hxx>
 #include <Time/TimeManager.hxx>
@@ -59,6 +64,10 @@
 #include "mpirc.hxx"
 #include "cpdlc.hxx"
 
+#if defined(__linux__)
+#include <sys/socket.h>
+#endif
+
 #if defined(_MSC_VER) || defined(__MINGW32__)
 #include <WS2tcpip.h>
 #endif
@@ -132,6 +141,17 @@ const int V2018_3_BASE = 13000;
 const int FALLBACK_MODEL_ID = 13000;
 const int V2019_3_BASE = 13001;
 const int V2020_4_BASE = 13003;
+const int V2026_4_BASE = 13004;
+
+/*
+ * Optional delta packets (/sim/multiplay/delta/enabled) carry only the properties which changed since the
+ * last full packet (the keyframe). A keyframe is a normal packet with DELTA_KEYFRAME_ID appended as its last
+ * property, which older clients stop reading at. A delta packet starts with DELTA_BASE_ID, so that older
+ * clients ignore all of its properties rather than mistaking it for a complete set; they still see the
+ * position. Delta packets are only sent while every aircraft in range sends keyframes too.
+ */
+const int DELTA_KEYFRAME_ID = V2026_4_BASE;
+const int DELTA_BASE_ID = V2026_4_BASE + 1;
 
 /*
  * definition of properties that are to be transmitted.
@@ -680,6 +700,9 @@ static const IdPropertyList sIdPropertyList[] = {
     { V2019_3_BASE+1, "sim/multiplay/comm-transmit-power-norm", simgear::props::INT, TT_SHORT_FLOAT_NORM ,  V1_1_2_PROP_ID, NULL, NULL },
     // Add new MP properties here
     { V2020_4_BASE, "instrumentation/transponder/mach-number", simgear::props::FLOAT, TT_SHORT_FLOAT_4, V1_1_2_PROP_ID, NULL, NULL },
+    // Written by SendMyPosition() itself, and removed again on receipt
+    { DELTA_KEYFRAME_ID, "sim/multiplay/delta/keyframe-sequence", simgear::props::INT, TT_NOSEND, V1_1_2_PROP_ID, NULL, NULL },
+    { DELTA_BASE_ID, "sim/multiplay/delta/base-sequence", simgear::props::INT, TT_NOSEND, V1_1_2_PROP_ID, NULL, NULL },
 };
 /*
  * For the 2017.x version 2 protocol the properties are sent in two partitions,
@@ -1032,6 +1055,224 @@ static bool do_cpdlc_disconnect(const SGPropertyNode* arg, SGPropertyNode* root)
 }
 
 
+/**
+ * The buffer that holds a multi-player message, suitably aligned.
+ */
+union FGMultiplayMgr::MsgBuf
+{
+    MsgBuf()
+    {
+        memset(&Msg, 0, sizeof(Msg));
+    }
+
+    T_MsgHdr* msgHdr()
+    {
+        return &Header;
+    }
+
+    const T_MsgHdr* msgHdr() const
+    {
+        return reinterpret_cast<const T_MsgHdr*>(&Header);
+    }
+
+    T_PositionMsg* posMsg()
+    {
+        return reinterpret_cast<T_PositionMsg*>(Msg + sizeof(T_MsgHdr));
+    }
+
+    const T_PositionMsg* posMsg() const
+    {
+        return reinterpret_cast<const T_PositionMsg*>(Msg + sizeof(T_MsgHdr));
+    }
+
+    xdr_data_t* properties()
+    {
+        return reinterpret_cast<xdr_data_t*>(Msg + sizeof(T_MsgHdr)
+                                             + sizeof(T_PositionMsg));
+    }
+
+    const xdr_data_t* properties() const
+    {
+        return reinterpret_cast<const xdr_data_t*>(Msg + sizeof(T_MsgHdr)
+                                                   + sizeof(T_PositionMsg));
+    }
+    /**
+     * The end of the properties buffer.
+     */
+    xdr_data_t* propsEnd()
+    {
+        return reinterpret_cast<xdr_data_t*>(Msg + MAX_PACKET_SIZE);
+    };
+
+    const xdr_data_t* propsEnd() const
+    {
+        return reinterpret_cast<const xdr_data_t*>(Msg + MAX_PACKET_SIZE);
+    };
+    /**
+     * The end of properties actually in the buffer. This assumes that
+     * the message header is valid.
+     */
+    xdr_data_t* propsRecvdEnd()
+    {
+        return reinterpret_cast<xdr_data_t*>(Msg + Header.MsgLen);
+    }
+
+    const xdr_data_t* propsRecvdEnd() const
+    {
+        return reinterpret_cast<const xdr_data_t*>(Msg + Header.MsgLen);
+    }
+
+    xdr_data2_t double_val;
+    char Msg[MAX_PACKET_SIZE];
+    T_MsgHdr Header;
+};
+
+//////////////////////////////////////////////////////////////////////
+//
+//  A received message, decoded by the receive thread and waiting to be
+//  applied by the main thread.
+//
+//////////////////////////////////////////////////////////////////////
+struct FGMultiplayMgr::ReceivedMsg
+{
+    // The packet as GetMsg() would have returned it, for recording.
+    std::shared_ptr<std::vector<char>> raw;
+    bool valid = false;
+    // Only for valid position messages which decoded successfully.
+    std::unique_ptr<FGExternalMotionData> motionInfo;
+    int fallback_model_index = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Drains the socket in batches, and validates and decodes each packet
+//  into a single producer / single consumer queue, so that the main
+//  thread only has to apply the results.
+//
+//////////////////////////////////////////////////////////////////////
+class FGMultiplayMgr::ReceiveThread
+{
+public:
+    ReceiveThread(simgear::Socket* socket, size_t capacity) :
+        mSocket(socket),
+        mQueue(capacity),
+        mBufs(BATCH_SIZE)
+    {
+        mThread = std::thread([this] { run(); });
+    }
+
+    ~ReceiveThread()
+    {
+        mStop = true;
+        mThread.join();
+    }
+
+    // Main thread only.
+    bool pop(ReceivedMsg& msg)
+    {
+        return mQueue.pop(msg);
+    }
+
+    std::atomic<int> mDebugLevel{0};
+    std::atomic<uint64_t> mReceived{0};
+    std::atomic<uint64_t> mInvalid{0};
+    std::atomic<uint64_t> mDropped{0};
+
+private:
+    static const int BATCH_SIZE = 32;
+
+    void run()
+    {
+        flightgear::FrameProfiler::setThreadName("mp-receive");
+        while (!mStop) {
+            // wake up regularly to check mStop
+            simgear::Socket* reads[2] = { mSocket, nullptr };
+            if (simgear::Socket::select(reads, nullptr, 100) <= 0)
+                continue;
+
+            FG_PROFILE_SCOPE("mp/receive");
+            int count;
+            do {
+                count = receiveBatch();
+                for (int i = 0; i < count; ++i)
+                    handle(mBufs[i], mLengths[i]);
+            } while (count == BATCH_SIZE && !mStop);
+        }
+    }
+
+    // Fills mBufs / mLengths with up to BATCH_SIZE waiting packets.
+    int receiveBatch()
+    {
+#if defined(__linux__)
+        struct mmsghdr msgs[BATCH_SIZE];
+        struct iovec iovs[BATCH_SIZE];
+        memset(msgs, 0, sizeof(msgs));
+        for (int i = 0; i < BATCH_SIZE; ++i) {
+            iovs[i].iov_base = mBufs[i].Msg;
+            iovs[i].iov_len = sizeof(mBufs[i].Msg);
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        int count = recvmmsg(mSocket->getHandle(), msgs, BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (count < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                SG_LOG(SG_NETWORK, SG_DEBUG, "FGMultiplayMgr::ReceiveThread - Unable to receive data. "
+                    << strerror(errno) << "(errno " << errno << ")");
+            return 0;
+        }
+        for (int i = 0; i < count; ++i)
+            mLengths[i] = msgs[i].msg_len;
+        return count;
+#else
+        int count = 0;
+        while (count < BATCH_SIZE) {
+            simgear::IPAddress SenderAddress;
+            int RecvStatus = mSocket->recvfrom(mBufs[count].Msg, sizeof(mBufs[count].Msg), 0,
+                                               &SenderAddress);
+            if (RecvStatus <= 0)
+                break;
+            mLengths[count++] = RecvStatus;
+        }
+        return count;
+#endif
+    }
+
+    void handle(MsgBuf& msgBuf, int bytes)
+    {
+        ++mReceived;
+        DecodeMsgHdr(msgBuf);
+
+        ReceivedMsg msg;
+        msg.raw = std::make_shared<std::vector<char>>(msgBuf.Msg, msgBuf.Msg + bytes);
+        msg.valid = IsValidMsg(msgBuf, bytes);
+        if (msg.valid) {
+            const int debugLevel = mDebugLevel;
+            if (debugLevel & 16)
+                SG_LOG_HEXDUMP(SG_NETWORK, SG_INFO, msgBuf.Msg, bytes);
+
+            if (msgBuf.msgHdr()->MsgId == POS_DATA_ID) {
+                msg.motionInfo.reset(new FGExternalMotionData);
+                if (!DecodePosMsg(msgBuf, *msg.motionInfo, msg.fallback_model_index, debugLevel))
+                    msg.motionInfo.reset();
+            }
+        } else {
+            ++mInvalid;
+        }
+
+        // Queue full: the main thread has stalled for a while, so it can
+        // only catch up if we drop packets.
+        if (!mQueue.push(msg))
+            ++mDropped;
+    }
+
+    simgear::Socket* mSocket;
+    flightgear::SPSCQueue<ReceivedMsg> mQueue;  // receive thread to main thread
+    std::vector<MsgBuf> mBufs;
+    int mLengths[BATCH_SIZE];
+    std::atomic<bool> mStop{false};
+    std::thread mThread;
+};
+
 //////////////////////////////////////////////////////////////////////
 //
 //  MultiplayMgr constructor
@@ -1061,6 +1302,15 @@ FGMultiplayMgr::FGMultiplayMgr()
   pMultiPlayRange->setIntValue(100);
   pReplayState = fgGetNode("/sim/replay/replay-state", true);
   pLogRawSpeedMultiplayer = fgGetNode("/sim/replay/log-raw-speed-multiplayer", true);
+  pReceivedPackets = fgGetNode("/sim/multiplay/receive-thread/received-packets", true);
+  pInvalidPackets = fgGetNode("/sim/multiplay/receive-thread/invalid-packets", true);
+  pDroppedPackets = fgGetNode("/sim/multiplay/receive-thread/dropped-packets", true);
+  pDeltaEnabled = fgGetNode("/sim/multiplay/delta/enabled", true);
+  pDeltaKeyframeInterval = fgGetNode("/sim/multiplay/delta/keyframe-interval", true);
+  if (!pDeltaKeyframeInterval->hasValue())
+    pDeltaKeyframeInterval->setIntValue(10);
+  pDeltaActive = fgGetNode("/sim/multiplay/delta/active", true);
+  mDeltaEncoder.reset(new MPPropertyDeltaEncoder);
 
 
 } // FGMultiplayMgr::FGMultiplayMgr()
@@ -1174,6 +1424,12 @@ FGMultiplayMgr::init (void)
   mListener = new MPPropertyListener(this);
   globals->get_props()->addChangeListener(mListener, false);
 
+  if (fgGetBool("/sim/multiplay/receive-thread/enabled", true)) {
+    int queuePackets = fgGetInt("/sim/multiplay/receive-thread/queue-packets", 4096);
+    mReceiveThread.reset(new ReceiveThread(mSocket.get(), std::max(queuePackets, 16)));
+    SG_LOG(SG_NETWORK, SG_INFO, "FGMultiplayMgr - receiving on a separate thread");
+  }
+
   fgSetBool("/sim/multiplay/online", true);
   mInitialised = true;
 
@@ -1210,6 +1466,9 @@ FGMultiplayMgr::shutdown (void)
 {
   fgSetBool("/sim/multiplay/online", false);
 
+  // must finish using the socket before it is closed
+  mReceiveThread.reset();
+
   if (mSocket.get()) {
     mSocket->close();
     mSocket.reset();
@@ -1221,6 +1480,8 @@ FGMultiplayMgr::shutdown (void)
     it->second->setDie(true);
   }
   mMultiPlayerMap.clear();
+  mDeltaDecoders.clear();
+  mDeltaEncoder->reset();
 
   if (mListener) {
     globals->get_props()->removeChangeListener(mListener);
@@ -1251,78 +1512,6 @@ FGMultiplayMgr::reinit()
 //
 //////////////////////////////////////////////////////////////////////
 
-/**
- * The buffer that holds a multi-player message, suitably aligned.
- */
-union FGMultiplayMgr::MsgBuf
-{
-    MsgBuf()
-    {
-        memset(&Msg, 0, sizeof(Msg));
-    }
-
-    T_MsgHdr* msgHdr()
-    {
-        return &Header;
-    }
-
-    const T_MsgHdr* msgHdr() const
-    {
-        return reinterpret_cast<const T_MsgHdr*>(&Header);
-    }
-
-    T_PositionMsg* posMsg()
-    {
-        return reinterpret_cast<T_PositionMsg*>(Msg + sizeof(T_MsgHdr));
-    }
-
-    const T_PositionMsg* posMsg() const
-    {
-        return reinterpret_cast<const T_PositionMsg*>(Msg + sizeof(T_MsgHdr));
-    }
-
-    xdr_data_t* properties()
-    {
-        return reinterpret_cast<xdr_data_t*>(Msg + sizeof(T_MsgHdr)
-                                             + sizeof(T_PositionMsg));
-    }
-
-    const xdr_data_t* properties() const
-    {
-        return reinterpret_cast<const xdr_data_t*>(Msg + sizeof(T_MsgHdr)
-                                                   + sizeof(T_PositionMsg));
-    }
-    /**
-     * The end of the properties buffer.
-     */
-    xdr_data_t* propsEnd()
-    {
-        return reinterpret_cast<xdr_data_t*>(Msg + MAX_PACKET_SIZE);
-    };
-
-    const xdr_data_t* propsEnd() const
-    {
-        return reinterpret_cast<const xdr_data_t*>(Msg + MAX_PACKET_SIZE);
-    };
-    /**
-     * The end of properties actually in the buffer. This assumes that
-     * the message header is valid.
-     */
-    xdr_data_t* propsRecvdEnd()
-    {
-        return reinterpret_cast<xdr_data_t*>(Msg + Header.MsgLen);
-    }
-
-    const xdr_data_t* propsRecvdEnd() const
-    {
-        return reinterpret_cast<const xdr_data_t*>(Msg + Header.MsgLen);
-    }
-
-    xdr_data2_t double_val;
-    char Msg[MAX_PACKET_SIZE];
-    T_MsgHdr Header;
-};
-
 bool
 FGMultiplayMgr::isSane(const FGExternalMotionData& motionInfo)
 {
@@ -1479,10 +1668,36 @@ FGMultiplayMgr::SendMyPosition(const FGExternalMotionData& motionInfo)
           ++it;
       }
 
+      /*
+       * Delta packets only contain the properties which differ from the last keyframe (the bool arrays
+       * above are still built from all properties, so a changed block is sent complete).
+       */
+      const bool deltaEnabled = protocolToUse > 1 && pDeltaEnabled->getBoolValue();
+      bool delta = false;
+      std::vector<FGPropertyData*> changedProperties;
+      const std::vector<FGPropertyData*>* properties = &motionInfo.properties;
+      if (deltaEnabled)
+      {
+          mDeltaEncoder->setKeyframeInterval(pDeltaKeyframeInterval->getIntValue());
+          delta = !mDeltaEncoder->keyframeDue() && PeersAcceptDelta();
+      }
+      else
+      {
+          mDeltaEncoder->reset();
+      }
+      if (delta)
+      {
+          mDeltaEncoder->changed(motionInfo.properties, changedProperties);
+          properties = &changedProperties;
+          *ptr++ = XDR_encode_uint32(DELTA_BASE_ID);
+          *ptr++ = XDR_encode_uint32(mDeltaEncoder->sequence());
+      }
+      pDeltaActive->setBoolValue(delta);
+
       for (int partition = 1; partition <= protocolToUse; partition++)
       {
-          std::vector<FGPropertyData*>::const_iterator it = motionInfo.properties.begin();
-          while (it != motionInfo.properties.end()) {
+          std::vector<FGPropertyData*>::const_iterator it = properties->begin();
+          while (it != properties->end()) {
               const struct IdPropertyList* propDef = mPropertyDefinition[(*it)->id];
 
               /*
@@ -1759,6 +1974,14 @@ FGMultiplayMgr::SendMyPosition(const FGExternalMotionData& motionInfo)
       }
       escape:
 
+      // Without room for the sequence number this is just a normal packet, and the next one will
+      // be another attempt at a keyframe.
+      if (deltaEnabled && !delta && ptr + 2 < msgEnd)
+      {
+          *ptr++ = XDR_encode_uint32(DELTA_KEYFRAME_ID);
+          *ptr++ = XDR_encode_uint32(mDeltaEncoder->keyframe(motionInfo.properties));
+      }
+
       msgLen = reinterpret_cast<char*>(ptr) - msgBuf.Msg;
       FillMsgHdr(msgBuf.msgHdr(), POS_DATA_ID, msgLen);
 
@@ -1861,7 +2084,8 @@ int FGMultiplayMgr::GetMsgNetwork(MsgBuf& msgBuf, simgear::IPAddress& SenderAddr
         //  returned will only be that of the next
         //  packet waiting to be processed.
         //////////////////////////////////////////////////
-        if (!mSocket) {
+        if (!mSocket || mReceiveThread) {
+            // the receive thread owns the socket's incoming data
             return 0;
         }
         int RecvStatus = mSocket->recvfrom(msgBuf.Msg, sizeof(msgBuf.Msg), 0,
@@ -1897,6 +2121,14 @@ int FGMultiplayMgr::GetMsgNetwork(MsgBuf& msgBuf, simgear::IPAddress& SenderAddr
             return 0;
         }
         
+        DecodeMsgHdr(msgBuf);
+        return RecvStatus;
+}
+
+// Converts the endiness of the T_MsgHdr in <msgBuf>.
+//
+void FGMultiplayMgr::DecodeMsgHdr(MsgBuf& msgBuf)
+{
         T_MsgHdr* MsgHdr = msgBuf.msgHdr();
         MsgHdr->Magic       = XDR_decode_uint32 (MsgHdr->Magic);
         MsgHdr->Version     = XDR_decode_uint32 (MsgHdr->Version);
@@ -1904,8 +2136,34 @@ int FGMultiplayMgr::GetMsgNetwork(MsgBuf& msgBuf, simgear::IPAddress& SenderAddr
         MsgHdr->MsgLen      = XDR_decode_uint32 (MsgHdr->MsgLen);
         MsgHdr->ReplyPort   = XDR_decode_uint32 (MsgHdr->ReplyPort);
         MsgHdr->Callsign[MAX_CALLSIGN_LEN -1] = '\0';
-        
-        return RecvStatus;
+}
+
+// Checks the (decoded) header of a received message of <bytes> length.
+//
+bool FGMultiplayMgr::IsValidMsg(const MsgBuf& msgBuf, int bytes)
+{
+    if (bytes <= static_cast<int>(sizeof(T_MsgHdr))) {
+      SG_LOG( SG_NETWORK, SG_INFO, "FGMultiplayMgr::MP_ProcessData - "
+              << "received message with insufficient data" );
+      return false;
+    }
+    const T_MsgHdr* MsgHdr = msgBuf.msgHdr();
+    if (MsgHdr->Magic != MSG_MAGIC) {
+        SG_LOG(SG_NETWORK, SG_INFO, "FGMultiplayMgr::MP_ProcessData - "
+              << "message has invalid magic number!" );
+      return false;
+    }
+    if (MsgHdr->Version != PROTO_VER) {
+        SG_LOG(SG_NETWORK, SG_INFO, "FGMultiplayMgr::MP_ProcessData - "
+              << "message has invalid protocol number!" );
+      return false;
+    }
+    if (static_cast<int>(MsgHdr->MsgLen) != bytes) {
+        SG_LOG(SG_NETWORK, SG_INFO, "FGMultiplayMgr::MP_ProcessData - "
+             << "message from " << MsgHdr->Callsign << " has invalid length!");
+      return false;
+    }
+    return true;
 }
 
 // Returns message in msgBuf out-param.
@@ -1987,6 +2245,7 @@ int FGMultiplayMgr::GetMsg(MsgBuf& msgBuf, simgear::IPAddress& SenderAddress)
 void
 FGMultiplayMgr::update(double dt)
 {
+  FG_PROFILE_SCOPE("subsystems/mp");
   // We carry on even if !mInitialised, in case we are replaying a multiplayer
   // recording.
   //
@@ -2006,6 +2265,25 @@ FGMultiplayMgr::update(double dt)
       Send(mpTime);
   }
 
+  //////////////////////////////////////////////////
+  //  Apply the messages decoded by the receive
+  //  thread, if there is one.
+  //////////////////////////////////////////////////
+  if (mReceiveThread) {
+    mReceiveThread->mDebugLevel = pMultiPlayDebugLevel->getIntValue();
+    const bool replaying = pReplayState->getIntValue();
+    ReceivedMsg msg;
+    while (mReceiveThread->pop(msg)) {
+      // Always record all messages.
+      mRecordMessageQueue.push_back(msg.raw);
+      if (msg.valid)
+        ProcessReceivedMsg(msg, replaying, stamp);
+    }
+    pReceivedPackets->setLongValue(mReceiveThread->mReceived);
+    pInvalidPackets->setLongValue(mReceiveThread->mInvalid);
+    pDroppedPackets->setLongValue(mReceiveThread->mDropped);
+  }
+
   //////////////////////////////////////////////////
   //  Read from receive socket and/or multiplayer
   //  replay, and process any data.
@@ -2020,31 +2298,14 @@ FGMultiplayMgr::update(double dt)
     }
     // status is positive: bytes received
     bytes = (ssize_t) RecvStatus;
-    if (bytes <= static_cast<ssize_t>(sizeof(T_MsgHdr))) {
-      SG_LOG( SG_NETWORK, SG_INFO, "FGMultiplayMgr::MP_ProcessData - "
-              << "received message with insufficient data" );
-      break;
-    }
-    
+
     //////////////////////////////////////////////////
     //  Read header
     //////////////////////////////////////////////////
-    T_MsgHdr* MsgHdr = msgBuf.msgHdr();
-    if (MsgHdr->Magic != MSG_MAGIC) {
-        SG_LOG(SG_NETWORK, SG_INFO, "FGMultiplayMgr::MP_ProcessData - "
-              << "message has invalid magic number!" );
-      break;
-    }
-    if (MsgHdr->Version != PROTO_VER) {
-        SG_LOG(SG_NETWORK, SG_INFO, "FGMultiplayMgr::MP_ProcessData - "
-              << "message has invalid protocol number!" );
-      break;
-    }
-    if (static_cast<ssize_t>(MsgHdr->MsgLen) != bytes) {
-        SG_LOG(SG_NETWORK, SG_INFO, "FGMultiplayMgr::MP_ProcessData - "
-             << "message from " << MsgHdr->Callsign << " has invalid length!");
+    if (!IsValidMsg(msgBuf, RecvStatus)) {
       break;
     }
+    T_MsgHdr* MsgHdr = msgBuf.msgHdr();
     //hexdump the incoming packet
     if (pMultiPlayDebugLevel->getIntValue() & 16)
         SG_LOG_HEXDUMP(SG_NETWORK, SG_INFO, msgBuf.Msg, MsgHdr->MsgLen);
@@ -2078,6 +2339,7 @@ FGMultiplayMgr::update(double dt)
       std::string name = it->first;
       it->second->setDie(true);
       mMultiPlayerMap.erase(it);
+      mDeltaDecoders.erase(name);
       it = mMultiPlayerMap.upper_bound(name);
     } else
       ++it;
@@ -2092,6 +2354,48 @@ FGMultiplayMgr::update(double dt)
 } // FGMultiplayMgr::update(void)
 //////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////
+//
+//  Process a message from the receive thread. While replaying, only
+//  live chat messages are used, as in GetMsg().
+//
+//////////////////////////////////////////////////////////////////////
+void
+FGMultiplayMgr::ProcessReceivedMsg(ReceivedMsg& msg, bool replaying, long stamp)
+{
+  const T_MsgHdr* MsgHdr = reinterpret_cast<const T_MsgHdr*>(msg.raw->data());
+  if (replaying && MsgHdr->MsgId != CHAT_MSG_ID)
+    return;
+
+  switch (MsgHdr->MsgId) {
+  case CHAT_MSG_ID:
+    {
+      MsgBuf msgBuf;
+      memcpy(msgBuf.Msg, msg.raw->data(), msg.raw->size());
+      ProcessChatMsg(msgBuf, simgear::IPAddress());
+    }
+    break;
+  case POS_DATA_ID:
+    if (msg.motionInfo) {
+      const T_PositionMsg* PosMsg = reinterpret_cast<const T_PositionMsg*>(
+          msg.raw->data() + sizeof(T_MsgHdr));
+      ApplyPosMsg(MsgHdr->Callsign, PosMsg->Model, *msg.motionInfo,
+                  msg.fallback_model_index, stamp);
+    }
+    break;
+  case UNUSABLE_POS_DATA_ID:
+  case OLD_OLD_POS_DATA_ID:
+  case OLD_PROP_MSG_ID:
+  case OLD_POS_DATA_ID:
+    break;
+  default:
+      SG_LOG(SG_NETWORK, SG_INFO, "FGMultiplayMgr::MP_ProcessData - "
+            << "Unknown message Id received: " << MsgHdr->MsgId );
+    break;
+  }
+} // FGMultiplayMgr::ProcessReceivedMsg()
+//////////////////////////////////////////////////////////////////////
+
 void FGMultiplayMgr::ClearMotion()
 {
     SG_LOG(SG_NETWORK, SG_DEBUG, "Clearing all motion info");
@@ -2234,16 +2538,35 @@ void FGMultiplayMgr::Send(double mpTime)
 void
 FGMultiplayMgr::ProcessPosMsg(const FGMultiplayMgr::MsgBuf& Msg,
    const simgear::IPAddress& SenderAddress, long stamp)
+{
+   FGExternalMotionData motionInfo;
+   int fallback_model_index = 0;
+   if (!DecodePosMsg(Msg, motionInfo, fallback_model_index,
+                     pMultiPlayDebugLevel->getIntValue()))
+      return;
+
+   ApplyPosMsg(Msg.msgHdr()->Callsign, Msg.posMsg()->Model, motionInfo,
+               fallback_model_index, stamp);
+} // FGMultiplayMgr::ProcessPosMsg()
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Decode a position message into <motionInfo>. Only uses immutable
+//  state, so that the receive thread can call it.
+//
+//////////////////////////////////////////////////////////////////////
+bool
+FGMultiplayMgr::DecodePosMsg(const MsgBuf& Msg, FGExternalMotionData& motionInfo,
+   int& fallback_model_index, int debugLevel)
 {
    const T_MsgHdr* MsgHdr = Msg.msgHdr();
    if (MsgHdr->MsgLen < sizeof(T_MsgHdr) + sizeof(T_PositionMsg)) {
       SG_LOG(SG_NETWORK, SG_DEBUG, "FGMultiplayMgr::MP_ProcessData - "
          << "Position message received with insufficient data");
-      return;
+      return false;
    }
    const T_PositionMsg* PosMsg = Msg.posMsg();
-   FGExternalMotionData motionInfo;
-   int fallback_model_index = 0;
+   fallback_model_index = 0;
    motionInfo.time = XDR_decode_double(PosMsg->time);
    motionInfo.lag = XDR_decode_double(PosMsg->lag);
    for (unsigned i = 0; i < 3; ++i)
@@ -2268,7 +2591,7 @@ FGMultiplayMgr::ProcessPosMsg(const FGMultiplayMgr::MsgBuf& Msg,
       SG_LOG(SG_NETWORK, SG_DEBUG, "FGMultiplayMgr::ProcessPosMsg - "
          << "Position message with invalid data (NaN) received from "
          << MsgHdr->Callsign);
-      return;
+      return false;
    }
 
    //cout << "INPUT MESSAGE\n";
@@ -2323,7 +2646,7 @@ FGMultiplayMgr::ProcessPosMsg(const FGMultiplayMgr::MsgBuf& Msg,
             short_int_encoded = true;
         }
 
-        if (pMultiPlayDebugLevel->getIntValue() & 8)
+        if (debugLevel & 8)
             SG_LOG(SG_NETWORK, SG_INFO,
                 "[RECV] add " << std::hex << xdr
                 << std::dec <<
@@ -2511,9 +2834,24 @@ FGMultiplayMgr::ProcessPosMsg(const FGMultiplayMgr::MsgBuf& Msg,
     }
   }
  noprops:
-  FGAIMultiplayer* mp = getMultiplayer(MsgHdr->Callsign);
+  return true;
+} // FGMultiplayMgr::DecodePosMsg()
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Pass a decoded position message to the multiplayer aircraft,
+//  creating it if necessary
+//
+//////////////////////////////////////////////////////////////////////
+void
+FGMultiplayMgr::ApplyPosMsg(const char* Callsign, const char* Model,
+   FGExternalMotionData& motionInfo, int fallback_model_index, long stamp)
+{
+  ApplyPropertyDelta(Callsign, motionInfo);
+
+  FGAIMultiplayer* mp = getMultiplayer(Callsign);
   if (!mp)
-    mp = addMultiplayer(MsgHdr->Callsign, PosMsg->Model, fallback_model_index);
+    mp = addMultiplayer(Callsign, Model, fallback_model_index);
   mp->addMotionInfo(motionInfo, stamp);
   
   // Optionally gather information about the raw speed of a selected
@@ -2522,7 +2860,7 @@ FGMultiplayMgr::ProcessPosMsg(const FGMultiplayMgr::MsgBuf& Msg,
   //
   {
     string callsign = pLogRawSpeedMultiplayer->getStringValue();
-    if (!callsign.empty() && callsign == string(MsgHdr->Callsign)) {
+    if (!callsign.empty() && callsign == string(Callsign)) {
         static SGVec3d s_pos_prev;
         static double s_simtime_prev = -1;
         SGVec3d pos = motionInfo.position;
@@ -2547,7 +2885,66 @@ FGMultiplayMgr::ProcessPosMsg(const FGMultiplayMgr::MsgBuf& Msg,
         s_pos_prev = pos;
     }
   }
-} // FGMultiplayMgr::ProcessPosMsg()
+} // FGMultiplayMgr::ApplyPosMsg()
+
+//////////////////////////////////////////////////////////////////////
+//
+//  Remove the delta markers from a position message, remembering
+//  keyframes and completing delta packets from them
+//
+//////////////////////////////////////////////////////////////////////
+void
+FGMultiplayMgr::ApplyPropertyDelta(const std::string& callsign,
+   FGExternalMotionData& motionInfo)
+{
+  int keyframe = 0;
+  int base = 0;
+  std::vector<FGPropertyData*>& properties = motionInfo.properties;
+  auto it = properties.begin();
+  while (it != properties.end()) {
+    if ((*it)->id == DELTA_KEYFRAME_ID || (*it)->id == DELTA_BASE_ID) {
+      if ((*it)->id == DELTA_KEYFRAME_ID)
+        keyframe = (*it)->int_value;
+      else
+        base = (*it)->int_value;
+      delete *it;
+      it = properties.erase(it);
+    } else
+      ++it;
+  }
+
+  if (keyframe) {
+    auto& decoder = mDeltaDecoders[callsign];
+    if (!decoder)
+      decoder.reset(new MPPropertyDeltaDecoder);
+    decoder->keyframe(keyframe, properties);
+  } else if (base) {
+    auto decoder = mDeltaDecoders.find(callsign);
+    if (decoder != mDeltaDecoders.end()) {
+      decoder->second->merge(base, properties);
+    } else {
+      // we missed its keyframes so far; just use the position until the next one
+      for (auto p : properties)
+        delete p;
+      properties.clear();
+    }
+  } else {
+    // this aircraft doesn't (or no longer does) send keyframes
+    mDeltaDecoders.erase(callsign);
+  }
+} // FGMultiplayMgr::ApplyPropertyDelta()
+
+// True if every aircraft we can see would be able to complete our delta
+// packets.
+bool
+FGMultiplayMgr::PeersAcceptDelta() const
+{
+  for (const auto& it : mMultiPlayerMap) {
+    if (mDeltaDecoders.find(it.first) == mDeltaDecoders.end())
+      return false;
+  }
+  return true;
+}
 
 
 std::shared_ptr<std::vector<char>> FGMultiplayMgr::popMessageHistory()
@@ -35,6 +35,7 @@ const int MIN_MP_PROTOCOL_VERSION = 1;
 const int MAX_MP_PROTOCOL_VERSION = 2;
 
 #include <deque>
+#include <map>
 #include <string>
 #include <vector>
 #include <memory>
@@ -54,6 +55,8 @@ const std::string MPIRC_NICK_PREFIX {"MP_IRC_"};
 
 struct FGExternalMotionData;
 class MPPropertyListener;
+class MPPropertyDeltaEncoder;
+class MPPropertyDeltaDecoder;
 struct T_MsgHdr;
 class FGAIMultiplayer;
 
@@ -113,14 +116,27 @@ private:
     short get_scaled_short(double v, double scale);
 
     union MsgBuf;
+    struct ReceivedMsg;
+    class ReceiveThread;
     FGAIMultiplayer* addMultiplayer(const std::string& callsign,
                                     const std::string& modelName,
                                     const int fallback_model_index);
     void FillMsgHdr(T_MsgHdr *MsgHdr, int iMsgId, unsigned _len = 0u);
     void ProcessPosMsg(const MsgBuf& Msg, const simgear::IPAddress& SenderAddress,
                        long stamp);
+    // Decoding must not depend on mutable state; it runs on the receive thread.
+    static bool DecodePosMsg(const MsgBuf& Msg, FGExternalMotionData& motionInfo,
+                             int& fallback_model_index, int debugLevel);
+    void ApplyPosMsg(const char* Callsign, const char* Model,
+                     FGExternalMotionData& motionInfo, int fallback_model_index,
+                     long stamp);
+    void ApplyPropertyDelta(const std::string& callsign, FGExternalMotionData& motionInfo);
+    bool PeersAcceptDelta() const;
     void ProcessChatMsg(const MsgBuf& Msg, const simgear::IPAddress& SenderAddress);
-    bool isSane(const FGExternalMotionData& motionInfo);
+    void ProcessReceivedMsg(ReceivedMsg& msg, bool replaying, long stamp);
+    static bool isSane(const FGExternalMotionData& motionInfo);
+    static void DecodeMsgHdr(MsgBuf& msgBuf);
+    static bool IsValidMsg(const MsgBuf& msgBuf, int bytes);
     int GetMsgNetwork(MsgBuf& msgBuf, simgear::IPAddress& SenderAddress);
     int GetMsg(MsgBuf& msgBuf, simgear::IPAddress& SenderAddress);
 
@@ -129,6 +145,9 @@ private:
     MultiPlayerMap mMultiPlayerMap;
 
     std::unique_ptr<simgear::Socket> mSocket;
+    /// null unless /sim/multiplay/receive-thread/enabled; declared after
+    /// mSocket so that it is destroyed first
+    std::unique_ptr<ReceiveThread> mReceiveThread;
     simgear::IPAddress mServer;
     bool mHaveServer;
     bool mInitialised;
@@ -145,6 +164,17 @@ private:
     SGPropertyNode *pMultiPlayTransmitPropertyBase;
     SGPropertyNode *pReplayState;
     SGPropertyNode *pLogRawSpeedMultiplayer;
+    SGPropertyNode *pReceivedPackets;
+    SGPropertyNode *pInvalidPackets;
+    SGPropertyNode *pDroppedPackets;
+    SGPropertyNode *pDeltaEnabled;
+    SGPropertyNode *pDeltaKeyframeInterval;
+    SGPropertyNode *pDeltaActive;
+
+    /// state of our own delta packets
+    std::unique_ptr<MPPropertyDeltaEncoder> mDeltaEncoder;
+    /// the last keyframe of each aircraft which sends them
+    std::map<std::string, std::unique_ptr<MPPropertyDeltaDecoder>> mDeltaDecoders;
    
     typedef std::map<unsigned int, const struct IdPropertyList*> PropertyDefinitionMap;
     PropertyDefinitionMap mPropertyDefinition;
@@ -10,13 +10,20 @@
 #include "NavDataCache.hxx"
 
 // std
+#include <algorithm>
 #include <cstddef>  // for std::size_t
 #include <map>
 #include <cstring>  // for memcoy
 #include <cassert>
 #include <stdint.h> // for int64_t
 #include <sstream>  // for std::ostringstream
+#include <atomic>
 #include <mutex>
+#include <deque>
+#include <future>
+#include <optional>
+#include <random>
+#include <thread>
 
 #ifdef SYSTEM_SQLITE
 // the standard sqlite3.h doesn't give a way to set SQLITE_UINT64_TYPE,
@@ -43,6 +50,7 @@
 // SimGear
 #include <simgear/bucket/newbucket.hxx>
 #include <simgear/debug/logstream.hxx>
+#include <simgear/io/iostreams/sgstream.hxx>
 #include <simgear/io/sg_file.hxx>
 #include <simgear/misc/sg_dir.hxx>
 #include <simgear/misc/sg_path.hxx>
@@ -52,6 +60,7 @@
 #include <simgear/threads/SGThread.hxx>
 
 #include "CacheSchema.h"
+#include "NavDataSnapshot.hxx"
 #include "PositionedOctree.hxx"
 #include "fix.hxx"
 #include "markerbeacon.hxx"
@@ -83,6 +92,13 @@ const int MAX_RETRIES = 10;
 
 const int CACHE_SIZE_KBYTES= 32 * 1024;
 
+// page cache of each worker thread connection; these only ever run a
+// few lookups at a time
+const int READER_CACHE_SIZE_KBYTES = 4 * 1024;
+
+// property holding the stamp of the snapshot file matching the database
+const char* SNAPSHOT_STAMP_KEY = "snapshot-stamp";
+
 // bind a std::string to a sqlite statement. The std::string must live the
 // entire duration of the statement execution - do not pass a temporary
 // std::string, or the compiler may delete it, freeing the C-string storage,
@@ -219,10 +235,23 @@ public:
         _completionPercent = percent;
     }
 
+    void addPhaseTiming(const std::string& name, double ms)
+    {
+        std::lock_guard<std::mutex> g(_lock);
+        _phaseTimings.emplace_back(name, ms);
+    }
+
+    std::vector<std::pair<std::string, double>> phaseTimings() const
+    {
+        std::lock_guard<std::mutex> g(_lock);
+        return _phaseTimings;
+    }
+
 private:
   NavDataCache* _cache;
     NavDataCache::RebuildPhase _phase;
     unsigned int _completionPercent;
+    std::vector<std::pair<std::string, double>> _phaseTimings;
   mutable std::mutex _lock;
   bool _isFinished;
 };
@@ -266,6 +295,7 @@ public:
     outer(o),
     db(nullptr),
     path(p),
+    ownerThread(std::this_thread::get_id()),
     readOnly(false),
     cacheHits(0),
     cacheMisses(0),
@@ -351,6 +381,11 @@ public:
 
   void close()
   {
+    {
+      std::lock_guard<std::mutex> g(readerPoolLock);
+      idleReaders.clear();
+    }
+
     for (sqlite3_stmt_ptr stmt : prepared) {
       sqlite3_finalize(stmt);
     }
@@ -358,6 +393,143 @@ public:
     sqlite3_close(db);
   }
 
+  // a read-only connection for worker threads, see ReadScope
+  struct ReaderConnection
+  {
+    ~ReaderConnection()
+    {
+      for (auto& s : statements) {
+        sqlite3_finalize(s.second);
+      }
+      for (auto& s : statementsBySql) {
+        sqlite3_finalize(s.second);
+      }
+      sqlite3_close_v2(db);
+    }
+
+    sqlite3* db = nullptr;
+    // keyed by the statement with the same SQL on the main connection
+    std::map<sqlite3_stmt_ptr, sqlite3_stmt_ptr> statements;
+    std::map<string, sqlite3_stmt_ptr> statementsBySql;
+  };
+
+  // the thread which created the cache, and the rebuild thread while a
+  // rebuild is running, use the main connection
+  bool usesMainConnection() const
+  {
+    const std::thread::id id = std::this_thread::get_id();
+    return (id == ownerThread) || (id == rebuildThread.load());
+  }
+
+  std::unique_ptr<ReaderConnection> acquireReader()
+  {
+    {
+      std::lock_guard<std::mutex> g(readerPoolLock);
+      if (!idleReaders.empty()) {
+        std::unique_ptr<ReaderConnection> reader = std::move(idleReaders.back());
+        idleReaders.pop_back();
+        return reader;
+      }
+    }
+
+    std::unique_ptr<ReaderConnection> reader(new ReaderConnection);
+    std::string pathUtf8 = path.utf8Str();
+    int result = sqlite3_open_v2(pathUtf8.c_str(), &reader->db,
+                                 SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, NULL);
+    if (result != SQLITE_OK) {
+      std::string errMsg = reader->db ? sqlite3_errmsg(reader->db) : "Sqlite API misuse";
+      SG_LOG(SG_NAVCACHE, SG_WARN, "Failed to open reader connection to " << path << ":" << errMsg);
+      throw sg_exception("Navcache failed to open reader connection:" + errMsg);
+    }
+
+    sqlite3_create_function(reader->db, "distanceCartSqr", 6, SQLITE_ANY, NULL,
+                            f_distanceCartSqrFunction, NULL, NULL);
+    std::ostringstream q;
+    q << "PRAGMA cache_size=-" << READER_CACHE_SIZE_KBYTES << ";";
+    sqlite3_exec(reader->db, q.str().c_str(), NULL, NULL, NULL);
+    return reader;
+  }
+
+  void releaseReader(std::unique_ptr<ReaderConnection> reader)
+  {
+    // leave nothing running if a query was interrupted by an exception
+    for (auto& s : reader->statements) {
+      sqlite3_reset(s.second);
+    }
+    for (auto& s : reader->statementsBySql) {
+      sqlite3_reset(s.second);
+    }
+
+    std::lock_guard<std::mutex> g(readerPoolLock);
+    idleReaders.push_back(std::move(reader));
+  }
+
+  /**
+   * Selects the connection the queries in a scope run on. Threads which use
+   * the main connection get its statements back unchanged; other threads
+   * borrow a read-only connection from the pool for the lifetime of the
+   * outermost scope, and get the equivalent statements prepared on it.
+   */
+  class ReadScope
+  {
+  public:
+    explicit ReadScope(NavDataCachePrivate* d) :
+      _d(d)
+    {
+      if (t_reader || d->usesMainConnection()) {
+        return;
+      }
+
+      _owned = d->acquireReader();
+      t_reader = _owned.get();
+    }
+
+    ~ReadScope()
+    {
+      if (_owned) {
+        t_reader = nullptr;
+        _d->releaseReader(std::move(_owned));
+      }
+    }
+
+    bool isMainConnection() const
+    {
+      return t_reader == nullptr;
+    }
+
+    sqlite3_stmt_ptr operator()(sqlite3_stmt_ptr mainStmt) const
+    {
+      if (!t_reader) {
+        return mainStmt;
+      }
+
+      sqlite3_stmt_ptr& stmt = t_reader->statements[mainStmt];
+      if (!stmt) {
+        stmt = _d->prepareSQL(t_reader->db, sqlite3_sql(mainStmt));
+      }
+
+      return stmt;
+    }
+
+    // for SQL built at runtime, only valid on a borrowed connection
+    sqlite3_stmt_ptr statement(const string& sql) const
+    {
+      assert(t_reader);
+      sqlite3_stmt_ptr& stmt = t_reader->statementsBySql[sql];
+      if (!stmt) {
+        stmt = _d->prepareSQL(t_reader->db, sql);
+      }
+
+      return stmt;
+    }
+
+  private:
+    static thread_local ReaderConnection* t_reader;
+
+    NavDataCachePrivate* _d;
+    std::unique_ptr<ReaderConnection> _owned;
+  };
+
   void checkCacheFile()
   {
     SG_LOG(SG_NAVCACHE, SG_INFO, "running DB integrity check");
@@ -386,9 +558,14 @@ public:
 
     
     sqlite3_stmt_ptr prepareSQL(const std::string& sql)
+    {
+        return prepareSQL(db, sql);
+    }
+
+    sqlite3_stmt_ptr prepareSQL(sqlite3* conn, const std::string& sql)
     {
         sqlite3_stmt_ptr stmt;
-        int result = sqlite3_prepare_v2(db, sql.c_str(), sql.length(), &stmt, nullptr);
+        int result = sqlite3_prepare_v2(conn, sql.c_str(), sql.length(), &stmt, nullptr);
         int retries = 0;
         int retryMSec = 1;
         
@@ -401,7 +578,7 @@ public:
             SGTimeStamp::sleepForMSec(retryMSec);
             retryMSec = retryMSec << 1; // double each time
             // try again
-            result = sqlite3_prepare_v2(db, sql.c_str(), sql.length(), &stmt, nullptr);
+            result = sqlite3_prepare_v2(conn, sql.c_str(), sql.length(), &stmt, nullptr);
         }
         
         if (result == SQLITE_OK) {
@@ -413,7 +590,7 @@ public:
         errMsg = "Sqlite API abuse";
         SG_LOG(SG_NAVCACHE, SG_ALERT, "Sqlite API abuse");
       } else {
-        errMsg = sqlite3_errmsg(db);
+        errMsg = sqlite3_errmsg(conn);
         SG_LOG(SG_NAVCACHE, SG_ALERT, "Sqlite error:" << errMsg << " running:\n\t" << sql);
       }
 
@@ -455,7 +632,7 @@ public:
   {
     assert(stmt);
     if (sqlite3_reset(stmt) != SQLITE_OK) {
-      string errMsg = sqlite3_errmsg(db);
+      string errMsg = sqlite3_errmsg(sqlite3_db_handle(stmt));
       SG_LOG(SG_NAVCACHE, SG_ALERT, "Sqlite error resetting:" << errMsg);
       throw sg_exception("Sqlite error resetting:" + errMsg, sqlite3_sql(stmt));
     }
@@ -504,7 +681,7 @@ public:
       errMsg = "Sqlite API abuse";
       SG_LOG(SG_NAVCACHE, SG_ALERT, "Sqlite API abuse");
     } else {
-      errMsg = sqlite3_errmsg(db);
+      errMsg = sqlite3_errmsg(sqlite3_db_handle(stmt));
       SG_LOG(SG_NAVCACHE, SG_ALERT, "Sqlite error:" << errMsg << " (" << result
              << ") while running:\n\t" << sqlite3_sql(stmt));
     }
@@ -521,8 +698,17 @@ public:
     }
   }
 
+  // worker threads only have read-only connections
+  void checkCanWrite() const
+  {
+    if (!usesMainConnection()) {
+      throw sg_exception("NavCache: modification from a worker thread");
+    }
+  }
+
   sqlite3_int64 execInsert(sqlite3_stmt_ptr stmt)
   {
+    checkCanWrite();
     execSelect(stmt);
     sqlite3_int64 rowid = sqlite3_last_insert_rowid(db);
     reset(stmt);
@@ -531,6 +717,7 @@ public:
 
   void execUpdate(sqlite3_stmt_ptr stmt)
   {
+    checkCanWrite();
     execSelect(stmt);
     reset(stmt);
   }
@@ -639,20 +826,14 @@ public:
     searchAirports = prepare("SELECT ident, name FROM positioned WHERE (name LIKE ?1 OR ident LIKE ?1) " AND_TYPED
                              // prioritize entries with matching ICAO
                              " ORDER BY (ident LIKE ?1) DESC");
-    sqlite3_bind_int(searchAirports, 2, FGPositioned::AIRPORT);
-    sqlite3_bind_int(searchAirports, 3, FGPositioned::SEAPORT);
 
     getAllAirports = prepare("SELECT ident, name FROM positioned WHERE type>=?1 AND type <=?2");
-    sqlite3_bind_int(getAllAirports, 1, FGPositioned::AIRPORT);
-    sqlite3_bind_int(getAllAirports, 2, FGPositioned::SEAPORT);
 
 
     getAirportItemByIdent = prepare("SELECT rowid FROM positioned WHERE airport=?1 AND ident=?2 AND type=?3");
 
     findAirportRunway = prepare("SELECT airport, rowid FROM positioned WHERE ident=?2 AND type=?3 AND airport="
                                 "(SELECT rowid FROM positioned WHERE type=?4 AND ident=?1)");
-    sqlite3_bind_int(findAirportRunway, 3, FGPositioned::RUNWAY);
-    sqlite3_bind_int(findAirportRunway, 4, FGPositioned::AIRPORT);
 
     // three-way join to get the navaid ident and runway ident in a single select.
     // we're joining positioned to itself by the navaid runway, with the complication
@@ -663,9 +844,6 @@ public:
                       "AND rwy.rowid = navaid.runway AND navaid.rowid=nav.rowid "
                       "AND (nav.type=?4 OR nav.type=?5)");
 
-    sqlite3_bind_int(findILS, 4, FGPositioned::ILS);
-    sqlite3_bind_int(findILS, 5, FGPositioned::LOC);
-
   // airways
     findAirwayNet = prepare("SELECT rowid FROM airway WHERE network=?1 AND ident=?2");
     findAirway = prepare("SELECT rowid FROM airway WHERE ident=?1");
@@ -698,40 +876,66 @@ public:
 
   FGPositioned* loadById(sqlite_int64 rowId, sqlite3_int64& aptId);
 
+  // The type-specific loaders below take their data from 'rec' when the
+  // item is in the snapshot, and query the database otherwise.
   FGAirport* loadAirport(sqlite_int64 rowId,
                          FGPositioned::Type ty,
-                         const string& id, const string& name, const SGGeod& pos)
+                         const string& id, const string& name, const SGGeod& pos,
+                         const NavDataSnapshot::Record* rec)
   {
-    sqlite3_bind_int64(loadAirportStmt, 1, rowId);
-    execSelect1(loadAirportStmt);
-    bool hasMetar = (sqlite3_column_int(loadAirportStmt, 0) > 0);
-    reset(loadAirportStmt);
+    bool hasMetar;
+    if (rec) {
+      hasMetar = rec->hasMetar;
+    } else {
+      ReadScope q(this);
+      sqlite3_stmt_ptr stmt = q(loadAirportStmt);
+      sqlite3_bind_int64(stmt, 1, rowId);
+      execSelect1(stmt);
+      hasMetar = (sqlite3_column_int(stmt, 0) > 0);
+      reset(stmt);
+    }
 
     return new FGAirport(rowId, id, pos, name, hasMetar, ty);
   }
 
   FGRunwayBase* loadRunway(sqlite3_int64 rowId, FGPositioned::Type ty,
-                           const string& id, const SGGeod& pos, PositionedID apt)
+                           const string& id, const SGGeod& pos, PositionedID apt,
+                           const NavDataSnapshot::Record* rec)
   {
-    sqlite3_bind_int(loadRunwayStmt, 1, rowId);
-    execSelect1(loadRunwayStmt);
-
-    double heading = sqlite3_column_double(loadRunwayStmt, 0);
-    double lengthM = sqlite3_column_int(loadRunwayStmt, 1);
-    double widthM = sqlite3_column_double(loadRunwayStmt, 2);
-    int surface = sqlite3_column_int(loadRunwayStmt, 3);
+    double heading, lengthM, widthM, displacedThreshold, stopway;
+    int surface;
+    PositionedID reciprocal, ils;
+    if (rec) {
+      heading = rec->heading;
+      lengthM = rec->lengthFt;
+      widthM = rec->widthM;
+      surface = rec->surface;
+      displacedThreshold = rec->displacedThreshold;
+      stopway = rec->stopway;
+      reciprocal = rec->reciprocal;
+      ils = rec->ils;
+    } else {
+      ReadScope q(this);
+      sqlite3_stmt_ptr stmt = q(loadRunwayStmt);
+      sqlite3_bind_int(stmt, 1, rowId);
+      execSelect1(stmt);
+
+      heading = sqlite3_column_double(stmt, 0);
+      lengthM = sqlite3_column_int(stmt, 1);
+      widthM = sqlite3_column_double(stmt, 2);
+      surface = sqlite3_column_int(stmt, 3);
+      displacedThreshold = sqlite3_column_double(stmt, 4);
+      stopway = sqlite3_column_double(stmt, 5);
+      reciprocal = sqlite3_column_int64(stmt, 6);
+      ils = sqlite3_column_int64(stmt, 7);
+      reset(stmt);
+    }
 
     if (ty == FGPositioned::TAXIWAY) {
-      reset(loadRunwayStmt);
       return new FGTaxiway(rowId, id, pos, heading, lengthM, widthM, surface);
     } else if (ty == FGPositioned::HELIPAD) {
-        reset(loadRunwayStmt);
         return new FGHelipad(rowId, apt, id, pos, heading, lengthM, widthM, surface);
     } else {
-      double displacedThreshold = sqlite3_column_double(loadRunwayStmt, 4);
-      double stopway = sqlite3_column_double(loadRunwayStmt, 5);
-      PositionedID reciprocal = sqlite3_column_int64(loadRunwayStmt, 6);
-      PositionedID ils = sqlite3_column_int64(loadRunwayStmt, 7);
       FGRunway* r = new FGRunway(rowId, apt, id, pos, heading, lengthM, widthM,
                           displacedThreshold, stopway, surface);
 
@@ -743,7 +947,6 @@ public:
         r->setILS(ils);
       }
 
-      reset(loadRunwayStmt);
       return r;
     }
   }
@@ -751,44 +954,66 @@ public:
   CommStation* loadComm(sqlite3_int64 rowId, FGPositioned::Type ty,
                         const string& id, const string& name,
                         const SGGeod& pos,
-                        PositionedID airport)
+                        PositionedID airport,
+                        const NavDataSnapshot::Record* rec)
   {
       SG_UNUSED(id);
 
-      sqlite3_bind_int64(loadCommStation, 1, rowId);
-      execSelect1(loadCommStation);
-
-      int range = sqlite3_column_int(loadCommStation, 0);
-      int freqKhz = sqlite3_column_int(loadCommStation, 1);
-      reset(loadCommStation);
+      int freqKhz, rangeNm;
+      if (rec) {
+          freqKhz = rec->freq;
+          rangeNm = rec->rangeNm;
+      } else {
+          ReadScope q(this);
+          sqlite3_stmt_ptr stmt = q(loadCommStation);
+          sqlite3_bind_int64(stmt, 1, rowId);
+          execSelect1(stmt);
+
+          freqKhz = sqlite3_column_int(stmt, 0);
+          rangeNm = sqlite3_column_int(stmt, 1);
+          reset(stmt);
+      }
 
-      CommStation* c = new CommStation(rowId, name, ty, pos, freqKhz, range);
+      CommStation* c = new CommStation(rowId, name, ty, pos, rangeNm, freqKhz);
       c->setAirport(airport);
       return c;
   }
 
   FGPositioned* loadNav(sqlite3_int64 rowId,
                        FGPositioned::Type ty, const string& id,
-                       const string& name, const SGGeod& pos)
+                       const string& name, const SGGeod& pos,
+                       const NavDataSnapshot::Record* rec)
   {
-    sqlite3_bind_int64(loadNavaid, 1, rowId);
-    execSelect1(loadNavaid);
+    int rangeNm, freq;
+    double mulituse;
+    PositionedID runway, colocated;
+    if (rec) {
+      rangeNm = rec->rangeNm;
+      freq = rec->freq;
+      mulituse = rec->multiuse;
+      runway = rec->runway;
+      colocated = rec->colocated;
+    } else {
+      ReadScope q(this);
+      sqlite3_stmt_ptr stmt = q(loadNavaid);
+      sqlite3_bind_int64(stmt, 1, rowId);
+      execSelect1(stmt);
+
+      rangeNm = sqlite3_column_int(stmt, 0);
+      freq = sqlite3_column_int(stmt, 1);
+      mulituse = sqlite3_column_double(stmt, 2);
+      runway = sqlite3_column_int64(stmt, 3);
+      colocated = sqlite3_column_int64(stmt, 4);
+      reset(stmt);
+    }
 
-    PositionedID runway = sqlite3_column_int64(loadNavaid, 3);
     // marker beacons are light-weight
     if ((ty == FGPositioned::OM) || (ty == FGPositioned::IM) ||
         (ty == FGPositioned::MM))
     {
-      reset(loadNavaid);
       return new FGMarkerBeaconRecord(rowId, ty, runway, pos);
     }
 
-    int rangeNm = sqlite3_column_int(loadNavaid, 0),
-    freq = sqlite3_column_int(loadNavaid, 1);
-    double mulituse = sqlite3_column_double(loadNavaid, 2);
-    PositionedID colocated = sqlite3_column_int64(loadNavaid, 4);
-    reset(loadNavaid);
-
     FGNavRecord* n =
       (ty == FGPositioned::MOBILE_TACAN)
       ? new FGMobileNavRecord
@@ -819,14 +1044,18 @@ public:
       sqlite3_bind_double(insertPositionedQuery, 6, pos.getLatitudeDeg());
       sqlite3_bind_double(insertPositionedQuery, 7, pos.getElevationM());
 
+      int64_t octreeNode = 0;
       if (spatialIndex) {
           Octree::Leaf* octreeLeaf = Octree::globalPersistentOctree()->findLeafForPos(cartPos);
           assert(intersects(octreeLeaf->bbox(), cartPos));
-          sqlite3_bind_int64(insertPositionedQuery, 8, octreeLeaf->guid());
+          octreeNode = octreeLeaf->guid();
+          sqlite3_bind_int64(insertPositionedQuery, 8, octreeNode);
       } else {
           sqlite3_bind_null(insertPositionedQuery, 8);
       }
 
+      snapshotPositionedInserted(ident, octreeNode);
+
     sqlite3_bind_double(insertPositionedQuery, 9, cartPos.x());
     sqlite3_bind_double(insertPositionedQuery, 10, cartPos.y());
     sqlite3_bind_double(insertPositionedQuery, 11, cartPos.z());
@@ -838,6 +1067,27 @@ public:
   FGPositionedList findAllByString(const string& s, const string& column,
                                      FGPositioned::Filter* filter, bool exact)
   {
+    std::shared_ptr<NavDataSnapshot> snap = activeSnapshot();
+    PositionedIDVec ids;
+    if (snap && exact && (column == "ident") &&
+        snap->findByIdent(s,
+                          filter ? filter->minType() : FGPositioned::INVALID,
+                          filter ? filter->maxType() : FGPositioned::LAST_TYPE,
+                          nullptr, ids))
+    {
+      FGPositionedList result;
+      for (PositionedID id : ids) {
+        FGPositioned* pos = outer->loadById(id);
+        if (filter && !filter->pass(pos)) {
+          continue;
+        }
+
+        result.push_back(pos);
+      }
+
+      return result;
+    }
+
     string query = s;
     if (!exact) query += "%";
 
@@ -849,10 +1099,16 @@ public:
     }
 
   // find or prepare a suitable statement frrm the SQL
-    sqlite3_stmt_ptr stmt = findByStringDict[sql];
-    if (!stmt) {
-      stmt = prepare(sql);
-      findByStringDict[sql] = stmt;
+    ReadScope q(this);
+    sqlite3_stmt_ptr stmt;
+    if (q.isMainConnection()) {
+      stmt = findByStringDict[sql];
+      if (!stmt) {
+        stmt = prepare(sql);
+        findByStringDict[sql] = stmt;
+      }
+    } else {
+      stmt = q.statement(sql);
     }
 
     sqlite_bind_stdstring(stmt, 1, query);
@@ -877,6 +1133,14 @@ public:
     return result;
   }
 
+  // the in-memory instance of an item, if it was loaded already
+  FGPositionedRef cachedItem(PositionedID id)
+  {
+    std::lock_guard<std::mutex> g(cacheLock);
+    auto it = cache.find(id);
+    return (it != cache.end()) ? it->second : FGPositionedRef();
+  }
+
   PositionedIDVec selectIds(sqlite3_stmt_ptr query)
   {
     PositionedIDVec result;
@@ -889,10 +1153,12 @@ public:
 
   double runwayLengthFt(PositionedID rwy)
   {
-    sqlite3_bind_int64(runwayLengthFtQuery, 1, rwy);
-    execSelect1(runwayLengthFtQuery);
-    double length = sqlite3_column_double(runwayLengthFtQuery, 0);
-    reset(runwayLengthFtQuery);
+    ReadScope q(this);
+    sqlite3_stmt_ptr stmt = q(runwayLengthFtQuery);
+    sqlite3_bind_int64(stmt, 1, rwy);
+    execSelect1(stmt);
+    double length = sqlite3_column_double(stmt, 0);
+    reset(stmt);
     return length;
   }
 
@@ -907,6 +1173,148 @@ public:
     deferredOctreeUpdates.clear();
   }
 
+  SGPath snapshotPath() const
+  {
+    return SGPath::fromUtf8(path.utf8Str() + ".snapshot");
+  }
+
+  // the snapshot to answer queries from, if any
+  std::shared_ptr<NavDataSnapshot> activeSnapshot() const
+  {
+    if (!snapshotEnabled || outer->rebuildInProgress) {
+      return nullptr;
+    }
+
+    return std::atomic_load(&snapshot);
+  }
+
+  void writeSnapshot();
+
+  // worker threads may be holding on to the previous one
+  void setSnapshot(std::shared_ptr<NavDataSnapshot> s)
+  {
+    std::atomic_store(&snapshot, std::move(s));
+  }
+
+  // map the snapshot matching the database, (re-)creating it if it is
+  // missing or out of date
+  void openSnapshot()
+  {
+    if (snapshot) {
+      return;
+    }
+
+    const string stamp = outer->readStringProperty(SNAPSHOT_STAMP_KEY);
+    if (!stamp.empty()) {
+      setSnapshot(NavDataSnapshot::open(snapshotPath(), strtoull(stamp.c_str(), nullptr, 10)));
+      snapshotFileMatches = true;
+      if (snapshot) {
+        markSnapshotOverlay();
+      }
+    }
+
+    if (!snapshot && !readOnly) {
+      try {
+        writeSnapshot();
+      } catch (sg_exception& e) {
+        SG_LOG(SG_NAVCACHE, SG_WARN, "NavCache: failed to create snapshot:" << e.what());
+      }
+    }
+  }
+
+  // rows added after the snapshot was written (runtime inserts in earlier
+  // sessions) aren't in it: treat them as modified, as in the session which
+  // inserted them
+  void markSnapshotOverlay()
+  {
+    sqlite3_stmt_ptr stmt = prepare("SELECT ident, octree_node FROM positioned WHERE rowid > ?1");
+    sqlite3_bind_int64(stmt, 1, snapshot->lastRowid());
+    while (stepSelect(stmt)) {
+      const char* ident = (const char*)sqlite3_column_text(stmt, 0);
+      markSnapshotItemModified(ident ? ident : "", sqlite3_column_int64(stmt, 1));
+    }
+    finalize(stmt);
+
+    stmt = prepare("SELECT EXISTS (SELECT 1 FROM navaid WHERE rowid > ?1) "
+                   "OR EXISTS (SELECT 1 FROM comm WHERE rowid > ?1)");
+    sqlite3_bind_int64(stmt, 1, snapshot->lastRowid());
+    if (stepSelect(stmt) && sqlite3_column_int(stmt, 0)) {
+      snapshot->markFrequenciesModified();
+    }
+    finalize(stmt);
+  }
+
+  // the octree branches leading to the item may have been created along
+  // with it, so their children changed too
+  void markSnapshotItemModified(const string& ident, int64_t octreeNode)
+  {
+    snapshot->markIdentModified(ident);
+    for (int64_t node = octreeNode; node > 0; node >>= 3) {
+      snapshot->markOctreeNodeModified(node);
+    }
+  }
+
+  // Positioneds added at runtime only invalidate parts of the snapshot. The
+  // file still matches the base data, and the next session finds the new
+  // rows by rowid.
+  void snapshotPositionedInserted(const string& ident, int64_t octreeNode)
+  {
+    checkCanWrite();
+    if (!snapshot) {
+      return;
+    }
+
+    markSnapshotItemModified(ident, octreeNode);
+  }
+
+  // removing items which were added at runtime is the same as inserting
+  // them: deleted rowids above the snapshot may be re-used, but only by
+  // rows which are also above it
+  void snapshotPositionedRemoved(FGPositioned::Type ty, const string& ident)
+  {
+    checkCanWrite();
+    if (!snapshot) {
+      return;
+    }
+
+    sqlite3_stmt_ptr stmt = prepare("SELECT rowid, octree_node FROM positioned "
+                                    "WHERE type=?1 AND ident=?2");
+    sqlite3_bind_int(stmt, 1, ty);
+    sqlite_bind_stdstring(stmt, 2, ident);
+    bool inSnapshot = false;
+    std::vector<int64_t> nodes;
+    while (stepSelect(stmt)) {
+      inSnapshot |= (sqlite3_column_int64(stmt, 0) <= snapshot->lastRowid());
+      nodes.push_back(sqlite3_column_int64(stmt, 1));
+    }
+    finalize(stmt);
+
+    if (inSnapshot) {
+      discardSnapshot("items were removed");
+      return;
+    }
+
+    for (int64_t node : nodes) {
+      markSnapshotItemModified(ident, node);
+    }
+  }
+
+  // for changes to items which are in the snapshot: stop using it
+  void discardSnapshot(const char* reason)
+  {
+    checkCanWrite();
+    if (!snapshot) {
+      return;
+    }
+
+    SG_LOG(SG_NAVCACHE, SG_INFO, "NavCache: no longer using the snapshot, " << reason);
+    setSnapshot({});
+    if (snapshotFileMatches) {
+      snapshotFileMatches = false;
+      outer->writeStringProperty(SNAPSHOT_STAMP_KEY, string());
+    }
+  }
+
   void removePositionedWithIdent(FGPositioned::Type ty, const std::string& aIdent)
   {
     sqlite3_bind_int(removePOIQuery, 1, ty);
@@ -918,6 +1326,8 @@ public:
   NavDataCache* outer;
   sqlite3* db;
   SGPath path;
+    const std::thread::id ownerThread;
+    std::atomic<std::thread::id> rebuildThread{std::thread::id()};
     bool readOnly;
 
     // flag set during shutdown: allows us to abandon queries, etc
@@ -930,6 +1340,12 @@ public:
     /// the cache drops its reference
     PositionedCache cache;
     unsigned int cacheHits, cacheMisses;
+    // guards the above, items are loaded by worker threads too
+    std::mutex cacheLock;
+
+    // idle read-only connections for worker threads
+    std::mutex readerPoolLock;
+    std::vector<std::unique_ptr<ReaderConnection>> idleReaders;
 
     /**
    * record the levels of open transaction objects we have
@@ -987,8 +1403,21 @@ public:
     // if we're performing a rebuild, the thread that is doing the work.
     // otherwise, NULL
     std::unique_ptr<RebuildThread> rebuilder;
+
+    // per-stage timings of the last finished rebuild; the rebuild thread
+    // keeps its own until it is done
+    std::vector<std::pair<std::string, double>> rebuildTimings;
+
+    // read-only image of the database, see NavDataSnapshot. Only replaced
+    // by the main thread; worker threads take a reference via activeSnapshot()
+    std::shared_ptr<NavDataSnapshot> snapshot;
+    std::atomic<bool> snapshotEnabled{true};
+    bool snapshotFileMatches = true;
 };
 
+thread_local NavDataCache::NavDataCachePrivate::ReaderConnection*
+    NavDataCache::NavDataCachePrivate::ReadScope::t_reader = nullptr;
+
 //////////////////////////////////////////////////////////////////////
 
 FGPositioned* NavDataCache::NavDataCachePrivate::loadById(sqlite3_int64 rowid,
@@ -997,28 +1426,46 @@ FGPositioned* NavDataCache::NavDataCachePrivate::loadById(sqlite3_int64 rowid,
     if (abandonCache)
         throw AbandonCacheException{};
 
-    sqlite3_bind_int64(loadPositioned, 1, rowid);
-    execSelect1(loadPositioned);
+    PositionedID prowid = static_cast<PositionedID>(rowid);
+    FGPositioned::Type ty;
+    string ident, name;
+    SGGeod pos;
+
+    std::shared_ptr<const NavDataSnapshot> snap = activeSnapshot();
+    const NavDataSnapshot::Record* rec = snap ? snap->findRecord(rowid) : nullptr;
+    std::optional<ReadScope> scope;
+    if (rec) {
+      ty = static_cast<FGPositioned::Type>(rec->type);
+      ident = snap->stringAt(rec->ident);
+      name = snap->stringAt(rec->name);
+      aptId = rec->airport;
+      pos = SGGeod::fromDegM(rec->lon, rec->lat, rec->elevM);
+    } else {
+      // held until the end, so the type-specific loaders below share it
+      scope.emplace(this);
+      sqlite3_stmt_ptr stmt = (*scope)(loadPositioned);
+      sqlite3_bind_int64(stmt, 1, rowid);
+      execSelect1(stmt);
 
-    assert(rowid == sqlite3_column_int64(loadPositioned, 0));
-    FGPositioned::Type ty = (FGPositioned::Type)sqlite3_column_int(loadPositioned, 1);
+      assert(rowid == sqlite3_column_int64(stmt, 0));
+      ty = (FGPositioned::Type)sqlite3_column_int(stmt, 1);
 
-    PositionedID prowid = static_cast<PositionedID>(rowid);
-    string ident = (char*)sqlite3_column_text(loadPositioned, 2);
-    string name = (char*)sqlite3_column_text(loadPositioned, 3);
-    aptId = sqlite3_column_int64(loadPositioned, 4);
-    double lon = sqlite3_column_double(loadPositioned, 5);
-    double lat = sqlite3_column_double(loadPositioned, 6);
-    double elev = sqlite3_column_double(loadPositioned, 7);
-    SGGeod pos = SGGeod::fromDegM(lon, lat, elev);
+      ident = (char*)sqlite3_column_text(stmt, 2);
+      name = (char*)sqlite3_column_text(stmt, 3);
+      aptId = sqlite3_column_int64(stmt, 4);
+      double lon = sqlite3_column_double(stmt, 5);
+      double lat = sqlite3_column_double(stmt, 6);
+      double elev = sqlite3_column_double(stmt, 7);
+      pos = SGGeod::fromDegM(lon, lat, elev);
 
-    reset(loadPositioned);
+      reset(stmt);
+    }
 
     switch (ty) {
     case FGPositioned::AIRPORT:
     case FGPositioned::SEAPORT:
     case FGPositioned::HELIPORT:
-      return loadAirport(rowid, ty, ident, name, pos);
+      return loadAirport(rowid, ty, ident, name, pos, rec);
 
     case FGPositioned::TOWER:
       return new AirportTower(prowid, aptId, ident, pos);
@@ -1026,7 +1473,7 @@ FGPositioned* NavDataCache::NavDataCachePrivate::loadById(sqlite3_int64 rowid,
     case FGPositioned::RUNWAY:
     case FGPositioned::HELIPAD:
     case FGPositioned::TAXIWAY:
-      return loadRunway(rowid, ty, ident, pos, aptId);
+      return loadRunway(rowid, ty, ident, pos, aptId, rec);
 
     case FGPositioned::LOC:
     case FGPositioned::VOR:
@@ -1039,7 +1486,7 @@ FGPositioned* NavDataCache::NavDataCachePrivate::loadById(sqlite3_int64 rowid,
     case FGPositioned::DME:
     case FGPositioned::TACAN:
     case FGPositioned::MOBILE_TACAN:
-      return loadNav(rowid, ty, ident, name, pos);
+      return loadNav(rowid, ty, ident, name, pos, rec);
 
     case FGPositioned::FIX:
       return new FGFix(rowid, ident, pos);
@@ -1062,13 +1509,112 @@ FGPositioned* NavDataCache::NavDataCachePrivate::loadById(sqlite3_int64 rowid,
     case FGPositioned::FREQ_ENROUTE:
     case FGPositioned::FREQ_CLEARANCE:
     case FGPositioned::FREQ_UNICOM:
-      return loadComm(rowid, ty, ident, name, pos, aptId);
+      return loadComm(rowid, ty, ident, name, pos, aptId, rec);
 
     default:
       return NULL;
     }
 }
 
+void NavDataCache::NavDataCachePrivate::writeSnapshot()
+{
+    SGTimeStamp st;
+    st.stamp();
+    NavDataSnapshot::Builder builder;
+
+    sqlite3_stmt_ptr stmt = prepare("SELECT rowid, type, ident, name, airport, lon, lat, elev_m, "
+                                    "octree_node, cart_x, cart_y, cart_z FROM positioned ORDER BY rowid");
+    while (stepSelect(stmt)) {
+        NavDataSnapshot::Record& r = builder.addPositioned(
+            sqlite3_column_int64(stmt, 0), sqlite3_column_int(stmt, 1),
+            (const char*)sqlite3_column_text(stmt, 2), (const char*)sqlite3_column_text(stmt, 3));
+        r.airport = sqlite3_column_int64(stmt, 4);
+        r.lon = sqlite3_column_double(stmt, 5);
+        r.lat = sqlite3_column_double(stmt, 6);
+        r.elevM = sqlite3_column_double(stmt, 7);
+        r.octreeNode = sqlite3_column_int64(stmt, 8);
+        for (int i = 0; i < 3; ++i) {
+            r.cart[i] = sqlite3_column_double(stmt, 9 + i);
+        }
+    }
+    finalize(stmt);
+
+    // the other tables share the rowid of the positioned they extend; the
+    // values are read as the load* functions read them
+    stmt = prepare("SELECT rowid, has_metar FROM airport");
+    while (stepSelect(stmt)) {
+        if (NavDataSnapshot::Record* r = builder.find(sqlite3_column_int64(stmt, 0))) {
+            r->flags |= NavDataSnapshot::HAS_AIRPORT;
+            r->hasMetar = (sqlite3_column_int(stmt, 1) > 0);
+        }
+    }
+    finalize(stmt);
+
+    stmt = prepare("SELECT rowid, heading, length_ft, width_m, surface, displaced_threshold, "
+                   "stopway, reciprocal, ils FROM runway");
+    while (stepSelect(stmt)) {
+        if (NavDataSnapshot::Record* r = builder.find(sqlite3_column_int64(stmt, 0))) {
+            r->flags |= NavDataSnapshot::HAS_RUNWAY;
+            r->heading = sqlite3_column_double(stmt, 1);
+            r->lengthFt = sqlite3_column_int(stmt, 2);
+            r->widthM = sqlite3_column_double(stmt, 3);
+            r->surface = sqlite3_column_int(stmt, 4);
+            r->displacedThreshold = sqlite3_column_double(stmt, 5);
+            r->stopway = sqlite3_column_double(stmt, 6);
+            r->reciprocal = sqlite3_column_int64(stmt, 7);
+            r->ils = sqlite3_column_int64(stmt, 8);
+        }
+    }
+    finalize(stmt);
+
+    stmt = prepare("SELECT rowid, range_nm, freq, multiuse, runway, colocated FROM navaid");
+    while (stepSelect(stmt)) {
+        if (NavDataSnapshot::Record* r = builder.find(sqlite3_column_int64(stmt, 0))) {
+            r->flags |= NavDataSnapshot::HAS_NAVAID;
+            r->rangeNm = sqlite3_column_int(stmt, 1);
+            r->freq = sqlite3_column_int(stmt, 2);
+            r->multiuse = sqlite3_column_double(stmt, 3);
+            r->runway = sqlite3_column_int64(stmt, 4);
+            r->colocated = sqlite3_column_int64(stmt, 5);
+        }
+    }
+    finalize(stmt);
+
+    stmt = prepare("SELECT rowid, freq_khz, range_nm FROM comm");
+    while (stepSelect(stmt)) {
+        if (NavDataSnapshot::Record* r = builder.find(sqlite3_column_int64(stmt, 0))) {
+            r->flags |= NavDataSnapshot::HAS_COMM;
+            r->freq = sqlite3_column_int(stmt, 1);
+            r->rangeNm = sqlite3_column_int(stmt, 2);
+        }
+    }
+    finalize(stmt);
+
+    stmt = prepare("SELECT rowid, children FROM octree");
+    while (stepSelect(stmt)) {
+        builder.addOctreeBranch(sqlite3_column_int64(stmt, 0), sqlite3_column_int(stmt, 1));
+    }
+    finalize(stmt);
+
+    // any value will do, as long as a stale snapshot is unlikely to match
+    std::random_device rd;
+    uint64_t stamp = (static_cast<uint64_t>(rd()) << 32) ^ rd() ^
+                     static_cast<uint64_t>(SGTimeStamp::now().toUSecs());
+    if (stamp == 0) {
+        stamp = 1;
+    }
+
+    setSnapshot({});
+    if (!builder.write(snapshotPath(), stamp)) {
+        return;
+    }
+
+    outer->writeStringProperty(SNAPSHOT_STAMP_KEY, std::to_string(stamp));
+    setSnapshot(NavDataSnapshot::open(snapshotPath(), stamp));
+    snapshotFileMatches = true;
+    SG_LOG(SG_NAVCACHE, SG_INFO, "NavCache: snapshot creation took:" << st.elapsedMSec());
+}
+
 bool NavDataCache::NavDataCachePrivate::isCachedFileModified(const SGPath& path, bool verbose)
 {
   if (!path.exists()) {
@@ -1418,6 +1964,7 @@ NavDataCache::getDatFilesInfo(DatFileType datFileType) const
 bool NavDataCache::isRebuildRequired()
 {
   if (d->readOnly) {
+    d->openSnapshot();
     return false;
   }
 
@@ -1450,6 +1997,7 @@ bool NavDataCache::isRebuildRequired()
     if (dontRebuildFlag) {
       SG_LOG(SG_NAVCACHE, SG_ALERT, "NavCache: skipping rebuild because FG_NAVCACHE_REBUILD=0");
       SG_LOG(SG_NAVCACHE, SG_ALERT, "!! Navigation and airport data will be incorrect !!");
+      d->openSnapshot();
       return false;
     } else {
       SG_LOG(SG_NAVCACHE, SG_INFO, "NavCache: main cache rebuild required");
@@ -1458,6 +2006,7 @@ bool NavDataCache::isRebuildRequired()
   }
 
   SG_LOG(SG_NAVCACHE, SG_INFO, "NavCache: no main cache rebuild required");
+  d->openSnapshot();
   return false;
 }
 
@@ -1556,6 +2105,7 @@ NavDataCache::RebuildPhase NavDataCache::rebuild()
     // poll the rebuild thread
     RebuildPhase phase = d->rebuilder->currentPhase();
     if (phase == REBUILD_DONE) {
+        d->rebuildTimings = d->rebuilder->phaseTimings();
         d->rebuilder.reset(); // all done!
         releaseRebuildLock();
     }
@@ -1641,9 +2191,46 @@ void NavDataCache::setRebuildPhaseProgress(RebuildPhase ph, unsigned int percent
     d->rebuilder->setProgress(ph, percent);
 }
 
+std::vector<std::pair<std::string, double>> NavDataCache::rebuildPhaseTimings() const
+{
+    if (d->rebuilder.get()) {
+        return d->rebuilder->phaseTimings(); // still running
+    }
+
+    return d->rebuildTimings;
+}
+
+std::string NavDataCache::readDatFileContents(const SGPath& path,
+                                              bool useExactName)
+{
+    sg_gzifstream in(path, std::ios_base::in | std::ios_base::binary,
+                     useExactName);
+    if (!in.is_open()) {
+        throw sg_io_exception(
+            "Cannot open file (" + simgear::strutils::error_string(errno) + ")",
+            sg_location(path));
+    }
+
+    std::string contents;
+    char buf[64 * 1024];
+    while (in.read(buf, sizeof(buf)) || (in.gcount() > 0)) {
+        contents.append(buf, in.gcount());
+    }
+
+    if (in.bad()) {
+        const std::string errMsg = simgear::strutils::error_string(errno);
+        SG_LOG(SG_NAVCACHE, SG_ALERT,
+               "Error while reading '" << path.utf8Str() << "': " << errMsg);
+        throw sg_io_exception("Error reading file (" + errMsg + ")",
+                              sg_location(path));
+    }
+
+    return contents;
+}
+
 void NavDataCache::loadDatFiles(
     DatFileType type,
-    std::function<void(const SGPath&, std::size_t, std::size_t)> loader)
+    std::function<void(const SGPath&, std::string&, std::size_t, std::size_t)> loader)
 {
   SGTimeStamp st;
   string typeStr = datTypeStr[type];
@@ -1652,14 +2239,34 @@ void NavDataCache::loadDatFiles(
   const PathList datPaths = datFilesInfo.paths;
   std::size_t bytesReadSoFar = 0;
 
+  // Decompression stage: read and inflate the next file on a worker thread
+  // while the current one is loaded, so that's at most two decompressed
+  // buffers held here at once (decompressed apt.dat files are large). The
+  // APTLoader keeps the buffers of all apt.dat files until loadAirports(),
+  // since its scan results point into them.
+  const std::size_t maxInFlight = 1;
+  // apt.dat files were always opened by their exact name
+  const bool useExactName = (type == DATFILETYPE_APT);
+  std::deque<std::future<std::string>> inFlight;
+  std::size_t nextToRead = 0;
+
   st.stamp();
   for (PathList::const_iterator it = datPaths.begin();
        it != datPaths.end(); it++) {
+    while ((nextToRead < datPaths.size()) && (inFlight.size() < maxInFlight)) {
+      inFlight.push_back(std::async(std::launch::async,
+                                    &NavDataCache::readDatFileContents,
+                                    datPaths[nextToRead++], useExactName));
+    }
+
+    std::string contents = inFlight.front().get();
+    inFlight.pop_front();
+
     string path = it->realpath().utf8Str();
     datFiles.push_back(path);
     SG_LOG(SG_GENERAL, SG_INFO,
            "Loading " + typeStr + ".dat file: '" << path << "'");
-    loader(*it, bytesReadSoFar, datFilesInfo.totalSize);
+    loader(*it, contents, bytesReadSoFar, datFilesInfo.totalSize);
     bytesReadSoFar += it->sizeInBytes();
     stampCacheFile(*it); // this uses the realpath() of the file
   }
@@ -1675,6 +2282,19 @@ void NavDataCache::loadDatFiles(
 void NavDataCache::doRebuild()
 {
   rebuildInProgress = true;
+  d->rebuildThread = std::this_thread::get_id();
+  d->setSnapshot({});
+
+  SGTimeStamp phaseStamp;
+  phaseStamp.stamp();
+  auto endPhase = [this, &phaseStamp](const std::string& name) {
+      const double ms = phaseStamp.elapsedMSec();
+      if (d->rebuilder.get()) {
+          d->rebuilder->addPhaseTiming(name, ms);
+      }
+      SG_LOG(SG_NAVCACHE, SG_INFO, "rebuild phase '" << name << "' took:" << ms << "msec");
+      phaseStamp.stamp();
+  };
 
   try {
     d->close(); // completely close the sqlite object
@@ -1683,18 +2303,26 @@ void NavDataCache::doRebuild()
 
     // initialise the root octree node
     d->runSQL("INSERT INTO octree (rowid, children) VALUES (1, 0)");
+    endPhase("init");
 
     SGTimeStamp st;
     {
+        // Single writer: everything below is inserted by this thread,
+        // through prepared statements, inside one large transaction.
         Transaction txn(this);
         APTLoader aptLoader;
         FixesLoader fixesLoader;
         NavLoader navLoader;
 
-        using namespace std::placeholders;  // for _1, _2, _3...
-
         loadDatFiles(DATFILETYPE_APT,
-                     std::bind(&APTLoader::readAptDatFile, &aptLoader, _1, _2, _3));
+                     [&aptLoader](const SGPath& p, std::string& contents,
+                                  std::size_t soFar, std::size_t total) {
+                         // the loader keeps the buffer alive, its scan
+                         // results point into it
+                         aptLoader.readAptDatFile(p, std::move(contents),
+                                                  soFar, total);
+                     });
+        endPhase("apt.dat read");
 
         st.stamp();
         setRebuildPhaseProgress(REBUILD_UNKNOWN);
@@ -1703,20 +2331,32 @@ void NavDataCache::doRebuild()
         SG_LOG(SG_NAVCACHE, SG_INFO,
                "processing airports took:" <<
                st.elapsedMSec());
+        endPhase("airports");
 
         setRebuildPhaseProgress(REBUILD_UNKNOWN);
         metarDataLoad(d->metarDatPath);
         stampCacheFile(d->metarDatPath);
+        endPhase("metar.dat");
 
         loadDatFiles(DATFILETYPE_FIX,
-                     std::bind(&FixesLoader::loadFixes, &fixesLoader, _1, _2, _3));
+                     [&fixesLoader](const SGPath& p, std::string& contents,
+                                    std::size_t soFar, std::size_t total) {
+                         fixesLoader.loadFixes(p, contents, soFar, total);
+                     });
+        endPhase("fix.dat");
+
         loadDatFiles(DATFILETYPE_NAV,
-                     std::bind(&NavLoader::loadNav, &navLoader, _1, _2, _3));
+                     [&navLoader](const SGPath& p, std::string& contents,
+                                  std::size_t soFar, std::size_t total) {
+                         navLoader.loadNav(p, contents, soFar, total);
+                     });
+        endPhase("nav.dat");
 
         setRebuildPhaseProgress(REBUILD_UNKNOWN);
         st.stamp();
         txn.commit();
         SG_LOG(SG_NAVCACHE, SG_INFO, "stage 1 commit took:" << st.elapsedMSec());
+        endPhase("stage 1 commit");
     }
 
 #if 0
@@ -1734,6 +2374,7 @@ void NavDataCache::doRebuild()
           st.stamp();
           txn.commit();
           SG_LOG(SG_NAVCACHE, SG_INFO, "POI commit took:" << st.elapsedMSec());
+          endPhase("poi.dat");
       }
 #endif
 
@@ -1756,13 +2397,17 @@ void NavDataCache::doRebuild()
           st.stamp();
           txn.commit();
           SG_LOG(SG_NAVCACHE, SG_INFO, "final commit took:" << st.elapsedMSec());
-
+          endPhase("carrier/awy.dat");
       }
 
+      d->writeSnapshot();
+      endPhase("snapshot");
+
   } catch (sg_exception& e) {
     SG_LOG(SG_NAVCACHE, SG_ALERT, "caught exception rebuilding navCache:" << e.what());
   }
 
+  d->rebuildThread = std::thread::id();
   rebuildInProgress = false;
 }
 
@@ -1991,6 +2636,7 @@ void NavDataCache::abortTransaction()
 
 void NavDataCache::clearDynamicPositioneds()
 {
+    std::lock_guard<std::mutex> g(d->cacheLock);
     std::for_each(d->cache.begin(), d->cache.end(), [](PositionedCache::value_type& v) {
         if (v.second->type() == FGPositioned::MOBILE_TACAN) {
             auto mobile = fgpositioned_cast<FGMobileNavRecord>(v.second);
@@ -2005,12 +2651,16 @@ FGPositionedRef NavDataCache::loadById(PositionedID rowid)
     return NULL;
   }
   if (!d) return NULL;
-  PositionedCache::iterator it = d->cache.find(rowid);
-  if (it != d->cache.end()) {
-    d->cacheHits++;
-    return it->second; // cache it
+  {
+    std::lock_guard<std::mutex> g(d->cacheLock);
+    PositionedCache::iterator it = d->cache.find(rowid);
+    if (it != d->cache.end()) {
+      d->cacheHits++;
+      return it->second; // cache it
+    }
   }
 
+  // load without holding the lock, so other threads aren't held up
   sqlite3_int64 aptId;
   FGPositionedRef pos = d->loadById(rowid, aptId);
   if (rebuildInProgress) {
@@ -2019,11 +2669,28 @@ FGPositionedRef NavDataCache::loadById(PositionedID rowid)
     // which is not true during the cache rebuild.
     return pos;
   }
-  d->cache.insert(it, PositionedCache::value_type(rowid, pos));
-  d->cacheMisses++;
+
+  const bool isAirportILS = (pos->type() == FGPositioned::ILS) && (aptId > 0);
+  if (isAirportILS && !d->usesMainConnection()) {
+    // the per-airport changes read scenery files and modify the cache,
+    // so leave them to the main thread: hand out an unadjusted instance
+    // without caching it.
+    return pos;
+  }
+
+  {
+    std::lock_guard<std::mutex> g(d->cacheLock);
+    auto r = d->cache.insert(PositionedCache::value_type(rowid, pos));
+    if (!r.second) {
+      // another thread loaded the same item meanwhile; keep a single
+      // instance per ID
+      return r.first->second;
+    }
+    d->cacheMisses++;
+  }
 
   // when we loaded an ILS, we must apply per-airport changes
-  if ((pos->type() == FGPositioned::ILS) && (aptId > 0)) {
+  if (isAirportILS) {
     FGAirport* apt = FGPositioned::loadById<FGAirport>(aptId);
     apt->validateILSData();
   }
@@ -2049,9 +2716,11 @@ PositionedID NavDataCache::insertAirport(FGPositioned::Type ty, const string& id
 
 void NavDataCache::updatePosition(PositionedID item, const SGGeod &pos)
 {
-  if (d->cache.find(item) != d->cache.end()) {
+  d->discardSnapshot("positions were changed");
+  FGPositionedRef cached = d->cachedItem(item);
+  if (cached) {
     SG_LOG(SG_NAVCACHE, SG_DEBUG, "updating position of an item in the cache");
-    d->cache[item]->modifyPosition(pos);
+    cached->modifyPosition(pos);
   }
 
   SGVec3d cartPos(SGVec3d::fromGeod(pos));
@@ -2134,6 +2803,7 @@ NavDataCache::insertRunway(FGPositioned::Type ty, const string& ident,
 
 void NavDataCache::setRunwayReciprocal(PositionedID runway, PositionedID recip)
 {
+  d->discardSnapshot("runways were changed");
   sqlite3_bind_int64(d->setRunwayReciprocal, 1, runway);
   sqlite3_bind_int64(d->setRunwayReciprocal, 2, recip);
   d->execUpdate(d->setRunwayReciprocal);
@@ -2146,13 +2816,15 @@ void NavDataCache::setRunwayReciprocal(PositionedID runway, PositionedID recip)
 
 void NavDataCache::setRunwayILS(PositionedID runway, PositionedID ils)
 {
+  d->discardSnapshot("runways were changed");
   sqlite3_bind_int64(d->setRunwayILS, 1, runway);
   sqlite3_bind_int64(d->setRunwayILS, 2, ils);
   d->execUpdate(d->setRunwayILS);
 
   // and the in-memory one
-  if (d->cache.find(runway) != d->cache.end()) {
-    FGRunway* instance = (FGRunway*) d->cache[runway].ptr();
+  FGPositionedRef cached = d->cachedItem(runway);
+  if (cached) {
+    FGRunway* instance = (FGRunway*) cached.ptr();
     instance->setILS(ils);
   }
 }
@@ -2170,6 +2842,10 @@ NavDataCache::insertNavaid(FGPositioned::Type ty, const string& ident,
 
   sqlite3_int64 rowId = d->insertPositioned(ty, ident, name, pos, apt,
                                             spatialIndex);
+  if (d->snapshot) {
+    d->snapshot->markFrequenciesModified();
+  }
+
   sqlite3_bind_int64(d->insertNavaid, 1, rowId);
   sqlite3_bind_int(d->insertNavaid, 2, freq);
   sqlite3_bind_int(d->insertNavaid, 3, range);
@@ -2181,14 +2857,16 @@ NavDataCache::insertNavaid(FGPositioned::Type ty, const string& ident,
 
 void NavDataCache::setNavaidColocated(PositionedID navaid, PositionedID colocatedDME)
 {
+  d->discardSnapshot("navaids were changed");
   // Update DB entries...
   sqlite3_bind_int64(d->setNavaidColocated, 1, navaid);
   sqlite3_bind_int64(d->setNavaidColocated, 2, colocatedDME);
   d->execUpdate(d->setNavaidColocated);
 
   // ...and the in-memory copy of the navrecord
-  if (d->cache.find(navaid) != d->cache.end()) {
-    FGNavRecord* rec = (FGNavRecord*) d->cache[navaid].get();
+  FGPositionedRef cached = d->cachedItem(navaid);
+  if (cached) {
+    FGNavRecord* rec = (FGNavRecord*) cached.get();
     rec->setColocatedDME(colocatedDME);
   }
 }
@@ -2198,6 +2876,10 @@ PositionedID NavDataCache::insertCommStation(FGPositioned::Type ty,
                                              PositionedID apt)
 {
   sqlite3_int64 rowId = d->insertPositioned(ty, "", name, pos, apt, true);
+  if (d->snapshot) {
+    d->snapshot->markFrequenciesModified();
+  }
+
   sqlite3_bind_int64(d->insertCommStation, 1, rowId);
   sqlite3_bind_int(d->insertCommStation, 2, freq);
   sqlite3_bind_int(d->insertCommStation, 3, range);
@@ -2217,6 +2899,7 @@ PositionedID NavDataCache::createPOI(FGPositioned::Type ty, const std::string& i
 
 bool NavDataCache::removePOI(FGPositioned::Type ty, const std::string& aIdent)
 {
+  d->snapshotPositionedRemoved(ty, aIdent);
   d->removePositionedWithIdent(ty, aIdent);
   // should remove from the live cache too?
 
@@ -2225,6 +2908,7 @@ bool NavDataCache::removePOI(FGPositioned::Type ty, const std::string& aIdent)
 
 void NavDataCache::setAirportMetar(const string& icao, bool hasMetar)
 {
+  d->discardSnapshot("airports were changed");
   sqlite_bind_stdstring(d->setAirportMetar, 1, icao);
   sqlite3_bind_int(d->setAirportMetar, 2, hasMetar);
   d->execUpdate(d->setAirportMetar);
@@ -2251,24 +2935,45 @@ FGPositionedRef NavDataCache::findClosestWithIdent( const string& aIdent,
                                                     const SGGeod& aPos,
                                                     FGPositioned::Filter* aFilter )
 {
-  sqlite_bind_stdstring(d->findClosestWithIdent, 1, aIdent);
+  std::shared_ptr<NavDataSnapshot> snap = d->activeSnapshot();
+  if (snap) {
+    const SGVec3d cartPos(SGVec3d::fromGeod(aPos));
+    PositionedIDVec ids;
+    if (snap->findByIdent(aIdent,
+                          aFilter ? aFilter->minType() : FGPositioned::INVALID,
+                          aFilter ? aFilter->maxType() : FGPositioned::LAST_TYPE,
+                          &cartPos, ids)) {
+      for (PositionedID id : ids) {
+        FGPositionedRef pos = loadById(id);
+        if (!aFilter || aFilter->pass(pos)) {
+          return pos;
+        }
+      }
+
+      return {};
+    }
+  }
+
+  NavDataCachePrivate::ReadScope q(d.get());
+  sqlite3_stmt_ptr stmt = q(d->findClosestWithIdent);
+  sqlite_bind_stdstring(stmt, 1, aIdent);
   if (aFilter) {
-    sqlite3_bind_int(d->findClosestWithIdent, 2, aFilter->minType());
-    sqlite3_bind_int(d->findClosestWithIdent, 3, aFilter->maxType());
+    sqlite3_bind_int(stmt, 2, aFilter->minType());
+    sqlite3_bind_int(stmt, 3, aFilter->maxType());
   } else { // full type range
-    sqlite3_bind_int(d->findClosestWithIdent, 2, FGPositioned::INVALID);
-    sqlite3_bind_int(d->findClosestWithIdent, 3, FGPositioned::LAST_TYPE);
+    sqlite3_bind_int(stmt, 2, FGPositioned::INVALID);
+    sqlite3_bind_int(stmt, 3, FGPositioned::LAST_TYPE);
   }
 
   SGVec3d cartPos(SGVec3d::fromGeod(aPos));
-  sqlite3_bind_double(d->findClosestWithIdent, 4, cartPos.x());
-  sqlite3_bind_double(d->findClosestWithIdent, 5, cartPos.y());
-  sqlite3_bind_double(d->findClosestWithIdent, 6, cartPos.z());
+  sqlite3_bind_double(stmt, 4, cartPos.x());
+  sqlite3_bind_double(stmt, 5, cartPos.y());
+  sqlite3_bind_double(stmt, 6, cartPos.z());
 
   FGPositionedRef result;
 
-  while (d->stepSelect(d->findClosestWithIdent)) {
-    FGPositionedRef pos = loadById(sqlite3_column_int64(d->findClosestWithIdent, 0));
+  while (d->stepSelect(stmt)) {
+    FGPositionedRef pos = loadById(sqlite3_column_int64(stmt, 0));
     if (aFilter && !aFilter->pass(pos)) {
       continue;
     }
@@ -2277,15 +2982,23 @@ FGPositionedRef NavDataCache::findClosestWithIdent( const string& aIdent,
     break;
   }
 
-  d->reset(d->findClosestWithIdent);
+  d->reset(stmt);
   return result;
 }
 
 
 int NavDataCache::getOctreeBranchChildren(int64_t octreeNodeId)
 {
-    sqlite3_bind_int64(d->getOctreeChildren, 1, octreeNodeId);
-    if (!d->execSelect(d->getOctreeChildren)) {
+    int snapshotChildren;
+    std::shared_ptr<NavDataSnapshot> snap = d->activeSnapshot();
+    if (snap && snap->octreeBranchChildren(octreeNodeId, snapshotChildren)) {
+        return snapshotChildren;
+    }
+
+    NavDataCachePrivate::ReadScope q(d.get());
+    sqlite3_stmt_ptr stmt = q(d->getOctreeChildren);
+    sqlite3_bind_int64(stmt, 1, octreeNodeId);
+    if (!d->execSelect(stmt)) {
         // this can occur when in read-only mode: we don't add
         // new Octree nodes to the real DB (only in memory),
         // but will still call this code speculatively.
@@ -2293,8 +3006,8 @@ int NavDataCache::getOctreeBranchChildren(int64_t octreeNodeId)
         return 0;
     }   
 
-  int children = sqlite3_column_int(d->getOctreeChildren, 0);
-  d->reset(d->getOctreeChildren);
+  int children = sqlite3_column_int(stmt, 0);
+  d->reset(stmt);
   return children;
 }
 
@@ -2304,6 +3017,11 @@ void NavDataCache::defineOctreeNode(Octree::Branch* pr, Octree::Node* nd)
     return;
   }
   
+  if (d->snapshot) {
+    d->snapshot->markOctreeNodeModified(pr->guid());
+    d->snapshot->markOctreeNodeModified(nd->guid());
+  }
+
   sqlite3_bind_int64(d->insertOctree, 1, nd->guid());
   d->execInsert(d->insertOctree);
 
@@ -2324,17 +3042,23 @@ void NavDataCache::defineOctreeNode(Octree::Branch* pr, Octree::Node* nd)
 TypedPositionedVec
 NavDataCache::getOctreeLeafChildren(int64_t octreeNodeId)
 {
-  sqlite3_bind_int64(d->getOctreeLeafChildren, 1, octreeNodeId);
-
   TypedPositionedVec r;
-  while (d->stepSelect(d->getOctreeLeafChildren)) {
+  std::shared_ptr<NavDataSnapshot> snap = d->activeSnapshot();
+  if (snap && snap->octreeLeafChildren(octreeNodeId, r)) {
+    return r;
+  }
+
+  NavDataCachePrivate::ReadScope q(d.get());
+  sqlite3_stmt_ptr stmt = q(d->getOctreeLeafChildren);
+  sqlite3_bind_int64(stmt, 1, octreeNodeId);
+  while (d->stepSelect(stmt)) {
     FGPositioned::Type ty = static_cast<FGPositioned::Type>
-      (sqlite3_column_int(d->getOctreeLeafChildren, 1));
+      (sqlite3_column_int(stmt, 1));
     r.push_back(std::make_pair(ty,
-                sqlite3_column_int64(d->getOctreeLeafChildren, 0)));
+                sqlite3_column_int64(stmt, 0)));
   }
 
-  d->reset(d->getOctreeLeafChildren);
+  d->reset(stmt);
   return r;
 }
 
@@ -2354,11 +3078,14 @@ char** NavDataCache::searchAirportNamesAndIdents(const std::string& searchInput)
   string aFilter((pos != string::npos) ? searchInput.substr(pos+1) : searchInput);
   string searchTerm("%" + aFilter + "%");
 
+  NavDataCachePrivate::ReadScope q(d.get());
   if (aFilter.empty() && !heli_p) {
-    stmt = d->getAllAirports;
+    stmt = q(d->getAllAirports);
+    sqlite3_bind_int(stmt, 1, FGPositioned::AIRPORT);
+    sqlite3_bind_int(stmt, 2, FGPositioned::SEAPORT);
     numAllocated = 4096; // start much larger for all airports
   } else {
-    stmt = d->searchAirports;
+    stmt = q(d->searchAirports);
     sqlite_bind_stdstring(stmt, 1, searchTerm);
     if (heli_p) {
         sqlite3_bind_int(stmt, 2, FGPositioned::HELIPORT);
@@ -2416,23 +3143,44 @@ char** NavDataCache::searchAirportNamesAndIdents(const std::string& searchInput)
 FGPositionedRef
 NavDataCache::findCommByFreq(int freqKhz, const SGGeod& aPos, FGPositioned::Filter* aFilter)
 {
-  sqlite3_bind_int(d->findCommByFreq, 1, freqKhz);
+  std::shared_ptr<NavDataSnapshot> snap = d->activeSnapshot();
+  if (snap) {
+    const SGVec3d cartPos(SGVec3d::fromGeod(aPos));
+    PositionedIDVec ids;
+    if (snap->findCommsByFreq(freqKhz,
+                              aFilter ? aFilter->minType() : FGPositioned::FREQ_GROUND,
+                              aFilter ? aFilter->maxType() : FGPositioned::FREQ_UNICOM,
+                              &cartPos, ids)) {
+      for (PositionedID id : ids) {
+        FGPositionedRef p = loadById(id);
+        if (!aFilter || aFilter->pass(p)) {
+          return p;
+        }
+      }
+
+      return {};
+    }
+  }
+
+  NavDataCachePrivate::ReadScope q(d.get());
+  sqlite3_stmt_ptr stmt = q(d->findCommByFreq);
+  sqlite3_bind_int(stmt, 1, freqKhz);
   if (aFilter) {
-    sqlite3_bind_int(d->findCommByFreq, 2, aFilter->minType());
-    sqlite3_bind_int(d->findCommByFreq, 3, aFilter->maxType());
+    sqlite3_bind_int(stmt, 2, aFilter->minType());
+    sqlite3_bind_int(stmt, 3, aFilter->maxType());
   } else { // full type range
-    sqlite3_bind_int(d->findCommByFreq, 2, FGPositioned::FREQ_GROUND);
-    sqlite3_bind_int(d->findCommByFreq, 3, FGPositioned::FREQ_UNICOM);
+    sqlite3_bind_int(stmt, 2, FGPositioned::FREQ_GROUND);
+    sqlite3_bind_int(stmt, 3, FGPositioned::FREQ_UNICOM);
   }
 
   SGVec3d cartPos(SGVec3d::fromGeod(aPos));
-  sqlite3_bind_double(d->findCommByFreq, 4, cartPos.x());
-  sqlite3_bind_double(d->findCommByFreq, 5, cartPos.y());
-  sqlite3_bind_double(d->findCommByFreq, 6, cartPos.z());
+  sqlite3_bind_double(stmt, 4, cartPos.x());
+  sqlite3_bind_double(stmt, 5, cartPos.y());
+  sqlite3_bind_double(stmt, 6, cartPos.z());
   FGPositionedRef result;
 
-  while (d->execSelect(d->findCommByFreq)) {
-    FGPositionedRef p = loadById(sqlite3_column_int64(d->findCommByFreq, 0));
+  while (d->execSelect(stmt)) {
+    FGPositionedRef p = loadById(sqlite3_column_int64(stmt, 0));
     if (aFilter && !aFilter->pass(p)) {
       continue;
     }
@@ -2441,43 +3189,70 @@ NavDataCache::findCommByFreq(int freqKhz, const SGGeod& aPos, FGPositioned::Filt
     break;
   }
 
-  d->reset(d->findCommByFreq);
+  d->reset(stmt);
   return result;
 }
 
 PositionedIDVec
 NavDataCache::findNavaidsByFreq(int freqKhz, const SGGeod& aPos, FGPositioned::Filter* aFilter)
 {
-  sqlite3_bind_int(d->findNavsByFreq, 1, freqKhz);
+  std::shared_ptr<NavDataSnapshot> snap = d->activeSnapshot();
+  if (snap) {
+    const SGVec3d cartPos(SGVec3d::fromGeod(aPos));
+    PositionedIDVec ids;
+    if (snap->findNavaidsByFreq(freqKhz,
+                                aFilter ? aFilter->minType() : FGPositioned::NDB,
+                                aFilter ? aFilter->maxType() : FGPositioned::GS,
+                                &cartPos, ids)) {
+      return ids;
+    }
+  }
+
+  NavDataCachePrivate::ReadScope q(d.get());
+  sqlite3_stmt_ptr stmt = q(d->findNavsByFreq);
+  sqlite3_bind_int(stmt, 1, freqKhz);
   if (aFilter) {
-    sqlite3_bind_int(d->findNavsByFreq, 2, aFilter->minType());
-    sqlite3_bind_int(d->findNavsByFreq, 3, aFilter->maxType());
+    sqlite3_bind_int(stmt, 2, aFilter->minType());
+    sqlite3_bind_int(stmt, 3, aFilter->maxType());
   } else { // full type range
-    sqlite3_bind_int(d->findNavsByFreq, 2, FGPositioned::NDB);
-    sqlite3_bind_int(d->findNavsByFreq, 3, FGPositioned::GS);
+    sqlite3_bind_int(stmt, 2, FGPositioned::NDB);
+    sqlite3_bind_int(stmt, 3, FGPositioned::GS);
   }
 
   SGVec3d cartPos(SGVec3d::fromGeod(aPos));
-  sqlite3_bind_double(d->findNavsByFreq, 4, cartPos.x());
-  sqlite3_bind_double(d->findNavsByFreq, 5, cartPos.y());
-  sqlite3_bind_double(d->findNavsByFreq, 6, cartPos.z());
+  sqlite3_bind_double(stmt, 4, cartPos.x());
+  sqlite3_bind_double(stmt, 5, cartPos.y());
+  sqlite3_bind_double(stmt, 6, cartPos.z());
 
-  return d->selectIds(d->findNavsByFreq);
+  return d->selectIds(stmt);
 }
 
 PositionedIDVec
 NavDataCache::findNavaidsByFreq(int freqKhz, FGPositioned::Filter* aFilter)
 {
-  sqlite3_bind_int(d->findNavsByFreqNoPos, 1, freqKhz);
+  std::shared_ptr<NavDataSnapshot> snap = d->activeSnapshot();
+  if (snap) {
+    PositionedIDVec ids;
+    if (snap->findNavaidsByFreq(freqKhz,
+                                aFilter ? aFilter->minType() : FGPositioned::NDB,
+                                aFilter ? aFilter->maxType() : FGPositioned::GS,
+                                nullptr, ids)) {
+      return ids;
+    }
+  }
+
+  NavDataCachePrivate::ReadScope q(d.get());
+  sqlite3_stmt_ptr stmt = q(d->findNavsByFreqNoPos);
+  sqlite3_bind_int(stmt, 1, freqKhz);
   if (aFilter) {
-    sqlite3_bind_int(d->findNavsByFreqNoPos, 2, aFilter->minType());
-    sqlite3_bind_int(d->findNavsByFreqNoPos, 3, aFilter->maxType());
+    sqlite3_bind_int(stmt, 2, aFilter->minType());
+    sqlite3_bind_int(stmt, 3, aFilter->maxType());
   } else { // full type range
-    sqlite3_bind_int(d->findNavsByFreqNoPos, 2, FGPositioned::NDB);
-    sqlite3_bind_int(d->findNavsByFreqNoPos, 3, FGPositioned::GS);
+    sqlite3_bind_int(stmt, 2, FGPositioned::NDB);
+    sqlite3_bind_int(stmt, 3, FGPositioned::GS);
   }
 
-  return d->selectIds(d->findNavsByFreqNoPos);
+  return d->selectIds(stmt);
 }
 
 PositionedIDVec
@@ -2488,27 +3263,31 @@ NavDataCache::airportItemsOfType(PositionedID apt,FGPositioned::Type ty,
     maxTy = ty; // single-type range
   }
 
-  sqlite3_bind_int64(d->getAirportItems, 1, apt);
-  sqlite3_bind_int(d->getAirportItems, 2, ty);
-  sqlite3_bind_int(d->getAirportItems, 3, maxTy);
+  NavDataCachePrivate::ReadScope q(d.get());
+  sqlite3_stmt_ptr stmt = q(d->getAirportItems);
+  sqlite3_bind_int64(stmt, 1, apt);
+  sqlite3_bind_int(stmt, 2, ty);
+  sqlite3_bind_int(stmt, 3, maxTy);
 
-  return d->selectIds(d->getAirportItems);
+  return d->selectIds(stmt);
 }
 
 PositionedID
 NavDataCache::airportItemWithIdent(PositionedID apt, FGPositioned::Type ty,
                                    const std::string& ident)
 {
-  sqlite3_bind_int64(d->getAirportItemByIdent, 1, apt);
-  sqlite_bind_stdstring(d->getAirportItemByIdent, 2, ident);
-  sqlite3_bind_int(d->getAirportItemByIdent, 3, ty);
+  NavDataCachePrivate::ReadScope q(d.get());
+  sqlite3_stmt_ptr stmt = q(d->getAirportItemByIdent);
+  sqlite3_bind_int64(stmt, 1, apt);
+  sqlite_bind_stdstring(stmt, 2, ident);
+  sqlite3_bind_int(stmt, 3, ty);
   PositionedID result = 0;
 
-  if (d->execSelect(d->getAirportItemByIdent)) {
-    result = sqlite3_column_int64(d->getAirportItemByIdent, 0);
+  if (d->execSelect(stmt)) {
+    result = sqlite3_column_int64(stmt, 0);
   }
 
-  d->reset(d->getAirportItemByIdent);
+  d->reset(stmt);
   return result;
 }
 
@@ -2526,19 +3305,23 @@ NavDataCache::findAirportRunway(const std::string& aName)
   }
 
   AirportRunwayPair result;
-  sqlite_bind_stdstring(d->findAirportRunway, 1, parts[0]);
+  NavDataCachePrivate::ReadScope q(d.get());
+  sqlite3_stmt_ptr stmt = q(d->findAirportRunway);
+  sqlite3_bind_int(stmt, 3, FGPositioned::RUNWAY);
+  sqlite3_bind_int(stmt, 4, FGPositioned::AIRPORT);
+  sqlite_bind_stdstring(stmt, 1, parts[0]);
   const auto cleanedRunway = cleanRunwayNo(parts[1]);
-  sqlite_bind_stdstring(d->findAirportRunway, 2, cleanedRunway);
+  sqlite_bind_stdstring(stmt, 2, cleanedRunway);
 
-  if (d->execSelect(d->findAirportRunway)) {
-    result = AirportRunwayPair(sqlite3_column_int64(d->findAirportRunway, 0),
-                      sqlite3_column_int64(d->findAirportRunway, 1));
+  if (d->execSelect(stmt)) {
+    result = AirportRunwayPair(sqlite3_column_int64(stmt, 0),
+                      sqlite3_column_int64(stmt, 1));
 
   } else {
     SG_LOG(SG_NAVCACHE, SG_WARN, "findAirportRunway: unknown airport/runway:" << aName);
   }
 
-  d->reset(d->findAirportRunway);
+  d->reset(stmt);
   return result;
 }
 
@@ -2547,15 +3330,19 @@ NavDataCache::findILS(PositionedID airport, const string& aRunway, const string&
 {
   string runway(cleanRunwayNo(aRunway));
 
-  sqlite_bind_stdstring(d->findILS, 1, navIdent);
-  sqlite3_bind_int64(d->findILS, 2, airport);
-  sqlite_bind_stdstring(d->findILS, 3, runway);
+  NavDataCachePrivate::ReadScope q(d.get());
+  sqlite3_stmt_ptr stmt = q(d->findILS);
+  sqlite3_bind_int(stmt, 4, FGPositioned::ILS);
+  sqlite3_bind_int(stmt, 5, FGPositioned::LOC);
+  sqlite_bind_stdstring(stmt, 1, navIdent);
+  sqlite3_bind_int64(stmt, 2, airport);
+  sqlite_bind_stdstring(stmt, 3, runway);
   PositionedID result = 0;
-  if (d->execSelect(d->findILS)) {
-    result = sqlite3_column_int64(d->findILS, 0);
+  if (d->execSelect(stmt)) {
+    result = sqlite3_column_int64(stmt, 0);
   }
 
-  d->reset(d->findILS);
+  d->reset(stmt);
   return result;
 }
 
@@ -2563,13 +3350,15 @@ int NavDataCache::findAirway(int network, const string& aName, bool create)
 {
     assert((network == 1) || (network == 2));
 
-    sqlite3_bind_int(d->findAirwayNet, 1, network);
-    sqlite_bind_stdstring(d->findAirwayNet, 2, aName);
+    NavDataCachePrivate::ReadScope q(d.get());
+    sqlite3_stmt_ptr stmt = q(d->findAirwayNet);
+    sqlite3_bind_int(stmt, 1, network);
+    sqlite_bind_stdstring(stmt, 2, aName);
 
     int airway = 0;
-    if (d->execSelect(d->findAirwayNet)) {
+    if (d->execSelect(stmt)) {
         // already exists
-        airway = sqlite3_column_int(d->findAirwayNet, 0);
+        airway = sqlite3_column_int(stmt, 0);
   } else if (create) {
     d->reset(d->insertAirway);
     sqlite_bind_stdstring(d->insertAirway, 1, aName);
@@ -2579,21 +3368,23 @@ int NavDataCache::findAirway(int network, const string& aName, bool create)
       // doesn't exist but don't create
   }
 
-  d->reset(d->findAirwayNet);
+  d->reset(stmt);
   return airway;
 }
 
 int NavDataCache::findAirway(const string& aName)
 {
-  sqlite_bind_stdstring(d->findAirway, 1, aName);
+  NavDataCachePrivate::ReadScope q(d.get());
+  sqlite3_stmt_ptr stmt = q(d->findAirway);
+  sqlite_bind_stdstring(stmt, 1, aName);
 
   int airway = 0;
-  if (d->execSelect(d->findAirway)) {
+  if (d->execSelect(stmt)) {
     // already exists
-    airway = sqlite3_column_int(d->findAirway, 0);
+    airway = sqlite3_column_int(stmt, 0);
   }
 
-  d->reset(d->findAirway);
+  d->reset(stmt);
   return airway;
 }
 
@@ -2609,64 +3400,73 @@ void NavDataCache::insertEdge(int network, int airwayID, PositionedID from, Posi
 
 bool NavDataCache::isInAirwayNetwork(int network, PositionedID pos)
 {
-  sqlite3_bind_int(d->isPosInAirway, 1, network);
-  sqlite3_bind_int64(d->isPosInAirway, 2, pos);
-  bool ok = d->execSelect(d->isPosInAirway);
-  d->reset(d->isPosInAirway);
+  NavDataCachePrivate::ReadScope q(d.get());
+  sqlite3_stmt_ptr stmt = q(d->isPosInAirway);
+  sqlite3_bind_int(stmt, 1, network);
+  sqlite3_bind_int64(stmt, 2, pos);
+  bool ok = d->execSelect(stmt);
+  d->reset(stmt);
 
   return ok;
 }
 
 AirwayEdgeVec NavDataCache::airwayEdgesFrom(int network, PositionedID pos)
 {
-  sqlite3_bind_int(d->airwayEdgesFrom, 1, network);
-  sqlite3_bind_int64(d->airwayEdgesFrom, 2, pos);
+  NavDataCachePrivate::ReadScope q(d.get());
+  sqlite3_stmt_ptr fromStmt = q(d->airwayEdgesFrom);
+  sqlite3_stmt_ptr toStmt = q(d->airwayEdgesTo);
+  sqlite3_bind_int(fromStmt, 1, network);
+  sqlite3_bind_int64(fromStmt, 2, pos);
 
   AirwayEdgeVec result;
-  while (d->stepSelect(d->airwayEdgesFrom)) {
+  while (d->stepSelect(fromStmt)) {
     result.push_back(AirwayEdge(
-                     sqlite3_column_int(d->airwayEdgesFrom, 0),
-                     sqlite3_column_int64(d->airwayEdgesFrom, 1)
+                     sqlite3_column_int(fromStmt, 0),
+                     sqlite3_column_int64(fromStmt, 1)
                      ));
   }
 
-  d->reset(d->airwayEdgesFrom);
+  d->reset(fromStmt);
 
 // find bidirectional / backwsards edges
     // at present all edges are bidirectional
-    sqlite3_bind_int(d->airwayEdgesTo, 1, network);
-    sqlite3_bind_int64(d->airwayEdgesTo, 2, pos);
+    sqlite3_bind_int(toStmt, 1, network);
+    sqlite3_bind_int64(toStmt, 2, pos);
 
-    while (d->stepSelect(d->airwayEdgesTo)) {
+    while (d->stepSelect(toStmt)) {
         result.push_back(AirwayEdge(
-                                    sqlite3_column_int(d->airwayEdgesTo, 0),
-                                    sqlite3_column_int64(d->airwayEdgesTo, 1)
+                                    sqlite3_column_int(toStmt, 0),
+                                    sqlite3_column_int64(toStmt, 1)
                                     ));
     }
 
-    d->reset(d->airwayEdgesTo);
+    d->reset(toStmt);
 
   return result;
 }
 
 AirwayRef NavDataCache::loadAirway(int airwayID)
 {
-    sqlite3_bind_int(d->loadAirway, 1, airwayID);
-    bool ok = d->execSelect(d->loadAirway);
+    NavDataCachePrivate::ReadScope q(d.get());
+    sqlite3_stmt_ptr stmt = q(d->loadAirway);
+    sqlite3_bind_int(stmt, 1, airwayID);
+    bool ok = d->execSelect(stmt);
     AirwayRef result;
     if (ok) {
-        string ident = (char*) sqlite3_column_text(d->loadAirway, 0);
-        Airway::Level network = static_cast<Airway::Level>(sqlite3_column_int(d->loadAirway, 1));
+        string ident = (char*) sqlite3_column_text(stmt, 0);
+        Airway::Level network = static_cast<Airway::Level>(sqlite3_column_int(stmt, 1));
         result = new Airway(ident, network, airwayID, 0, 0);
     }
-    d->reset(d->loadAirway);
+    d->reset(stmt);
     return result;
 }
 
 PositionedIDVec NavDataCache::airwayWaypts(int id)
 {
-    d->reset(d->airwayEdges);
-    sqlite3_bind_int(d->airwayEdges, 1, id);
+    NavDataCachePrivate::ReadScope q(d.get());
+    sqlite3_stmt_ptr stmt = q(d->airwayEdges);
+    d->reset(stmt);
+    sqlite3_bind_int(stmt, 1, id);
 
     typedef std::pair<PositionedID, PositionedID> Edge;
     typedef std::deque<Edge> EdgeVec;
@@ -2674,13 +3474,13 @@ PositionedIDVec NavDataCache::airwayWaypts(int id)
 
 // build up the EdgeVec, order is arbitrary
     EdgeVec rawEdges;
-    while (d->stepSelect(d->airwayEdges)) {
-        rawEdges.push_back(Edge(sqlite3_column_int64(d->airwayEdges, 0),
-                                sqlite3_column_int64(d->airwayEdges, 1)
+    while (d->stepSelect(stmt)) {
+        rawEdges.push_back(Edge(sqlite3_column_int64(stmt, 0),
+                                sqlite3_column_int64(stmt, 1)
                                 ));
     }
 
-    d->reset(d->airwayEdges);
+    d->reset(stmt);
     if (rawEdges.empty()) {
         return {};
     }
@@ -2778,15 +3578,17 @@ PositionedIDVec NavDataCache::airwayWaypts(int id)
 
 PositionedID NavDataCache::findNavaidForRunway(PositionedID runway, FGPositioned::Type ty)
 {
-  sqlite3_bind_int64(d->findNavaidForRunway, 1, runway);
-  sqlite3_bind_int(d->findNavaidForRunway, 2, ty);
+  NavDataCachePrivate::ReadScope q(d.get());
+  sqlite3_stmt_ptr stmt = q(d->findNavaidForRunway);
+  sqlite3_bind_int64(stmt, 1, runway);
+  sqlite3_bind_int(stmt, 2, ty);
 
   PositionedID result = 0;
-  if (d->execSelect(d->findNavaidForRunway)) {
-    result = sqlite3_column_int64(d->findNavaidForRunway, 0);
+  if (d->execSelect(stmt)) {
+    result = sqlite3_column_int64(stmt, 0);
   }
 
-  d->reset(d->findNavaidForRunway);
+  d->reset(stmt);
   return result;
 }
 
@@ -2795,6 +3597,21 @@ bool NavDataCache::isReadOnly() const
     return d->readOnly;
 }
 
+void NavDataCache::setSnapshotEnabled(bool enabled)
+{
+    d->snapshotEnabled = enabled;
+}
+
+bool NavDataCache::isUsingSnapshot() const
+{
+    return d->activeSnapshot() != nullptr;
+}
+
+void NavDataCache::openSnapshot()
+{
+    d->openSnapshot();
+}
+
 SGPath NavDataCache::path() const
 {
     return d->path;
@@ -8,6 +8,7 @@
 #ifndef FG_NAVDATACACHE_HXX
 #define FG_NAVDATACACHE_HXX
 
+#include <atomic>
 #include <memory>
 #include <cstddef>                   // for std::size_t
 #include <functional>
@@ -40,6 +41,16 @@ namespace Octree {
     class Airway;
     using AirwayRef = SGSharedPtr<Airway>;
 
+/**
+ * Queries may be made from any thread. The thread which created the cache
+ * (and the rebuild thread) use the main SQLite connection; other threads
+ * borrow a read-only connection from a pool for the duration of each query.
+ * Loaded items are shared between all threads.
+ *
+ * Modifying the cache remains restricted to the main thread, and so is
+ * anything which may modify it as a side effect, such as the lazily loaded
+ * data of airports (runways, procedures, ground networks).
+ */
 class NavDataCache
 {
 public:
@@ -116,6 +127,21 @@ public:
   unsigned int rebuildPhaseCompletionPercentage() const;
   void setRebuildPhaseProgress(RebuildPhase ph, unsigned int percent = 0);
 
+  /**
+   * Wall-clock time (in msec) spent in each stage of the most recent
+   * rebuild, in the order the stages ran. Empty if no rebuild was done.
+   */
+  std::vector<std::pair<std::string, double>> rebuildPhaseTimings() const;
+
+  /**
+   * Read a complete .dat file, decompressing it if it is gzipped. Safe to
+   * call from any thread; throws sg_io_exception on failure.
+   * @param useExactName open 'path' itself, rather than letting
+   *        sg_gzifstream try 'path' with or without a .gz suffix
+   */
+  static std::string readDatFileContents(const SGPath& path,
+                                         bool useExactName = false);
+
   bool isCachedFileModified(const SGPath& path) const;
   void stampCacheFile(const SGPath& path, const std::string& sha = {});
 
@@ -311,6 +337,17 @@ public:
 
     bool isReadOnly() const;
 
+    /**
+     * Queries are answered from a memory-mapped snapshot of the cache
+     * (see NavDataSnapshot) when one is available, and from SQLite
+     * otherwise. Disabling the snapshot is mostly useful to compare both.
+     */
+    void setSnapshotEnabled(bool enabled);
+    bool isUsingSnapshot() const;
+
+    /// map the snapshot, re-creating it if it was discarded or is out of date
+    void openSnapshot();
+
     class ThreadedGUISearch
     {
     public:
@@ -334,8 +371,12 @@ private:
 
   // A generic function for loading all navigation data files of the
   // specified type (apt/fix/nav etc.) using the passed type-specific loader.
+  // The files are read and decompressed on worker threads, a few files
+  // ahead of the loader, which runs on the calling thread. The loader may
+  // take ownership of the file contents.
   void loadDatFiles(DatFileType type,
-                    std::function<void(const SGPath&, std::size_t, std::size_t)> loader);
+                    std::function<void(const SGPath&, std::string&,
+                                       std::size_t, std::size_t)> loader);
 
   void doRebuild();
 
@@ -348,7 +389,8 @@ private:
   class NavDataCachePrivate;
   std::unique_ptr<NavDataCachePrivate> d;
 
-  bool rebuildInProgress = false;
+  // read by worker threads
+  std::atomic<bool> rebuildInProgress{false};
 };
 
 } // of namespace flightgear
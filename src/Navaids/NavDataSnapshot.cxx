@@ -0,0 +1,557 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX_FileComment: Read-only, memory-mapped image of the navigation data cache
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "NavDataSnapshot.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+
+#include <simgear/debug/logstream.hxx>
+#include <simgear/io/iostreams/sgstream.hxx>
+#include <simgear/io/sg_mmap.hxx>
+#include <simgear/misc/sg_path.hxx>
+
+namespace flightgear
+{
+
+namespace
+{
+
+const char SNAPSHOT_MAGIC[8] = {'F', 'G', 'N', 'A', 'V', 'S', 'N', 'P'};
+// bump when the layout of anything below (or of Record) changes
+const uint32_t SNAPSHOT_VERSION = 1;
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+enum SectionIndex {
+    SECTION_RECORDS = 0,
+    SECTION_LEAVES,
+    SECTION_BRANCHES,
+    SECTION_NAV_FREQS,
+    SECTION_COMM_FREQS,
+    SECTION_IDENTS,
+    SECTION_STRINGS,
+    NUM_SECTIONS
+};
+
+inline uint64_t align8(uint64_t v)
+{
+    return (v + 7) & ~uint64_t(7);
+}
+
+// the ASCII-only case folding of SQLite's NOCASE collation, which the ident
+// column uses
+inline char foldCase(char c)
+{
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+int compareNoCase(const char* a, const char* b)
+{
+    for (;; ++a, ++b) {
+        const unsigned char ca = foldCase(*a), cb = foldCase(*b);
+        if (ca != cb) {
+            return (ca < cb) ? -1 : 1;
+        }
+
+        if (ca == 0) {
+            return 0;
+        }
+    }
+}
+
+struct LeafEntry {
+    int64_t node;
+    int64_t rowid;
+    int32_t type;
+    int32_t padding;
+};
+
+struct BranchEntry {
+    int64_t node;
+    int64_t children;
+};
+
+struct FreqEntry {
+    int64_t rowid;
+    int32_t freq;
+    int32_t type;
+};
+
+struct IdentEntry {
+    int64_t rowid;
+    uint32_t ident;
+    int32_t type;
+};
+
+} // namespace
+
+struct NavDataSnapshot::Section {
+    uint64_t offset;
+    uint64_t count;
+};
+
+struct NavDataSnapshot::Header {
+    char magic[8];
+    uint32_t byteOrder;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t numSections;
+    uint64_t stamp;
+    Section sections[NUM_SECTIONS];
+};
+
+static_assert(std::is_trivially_copyable<NavDataSnapshot::Record>::value,
+              "snapshot records are written and mapped as raw memory");
+
+static const size_t sectionElementSize[NUM_SECTIONS] = {
+    sizeof(NavDataSnapshot::Record),
+    sizeof(LeafEntry),
+    sizeof(BranchEntry),
+    sizeof(FreqEntry),
+    sizeof(FreqEntry),
+    sizeof(IdentEntry),
+    1 // string pool
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+NavDataSnapshot::Builder::Builder()
+{
+    addString(""); // so offset 0 is always the empty string
+}
+
+NavDataSnapshot::Builder::~Builder() = default;
+
+uint32_t NavDataSnapshot::Builder::addString(const char* s)
+{
+    if (!s) {
+        s = "";
+    }
+
+    auto it = _stringOffsets.find(s);
+    if (it != _stringOffsets.end()) {
+        return it->second;
+    }
+
+    const uint32_t offset = static_cast<uint32_t>(_strings.size());
+    _strings.append(s);
+    _strings.push_back('\0');
+    _stringOffsets.emplace(s, offset);
+    return offset;
+}
+
+NavDataSnapshot::Record&
+NavDataSnapshot::Builder::addPositioned(int64_t rowid, int type, const char* ident, const char* name)
+{
+    assert(_records.empty() || (_records.back().rowid < rowid));
+
+    Record r = {};
+    r.rowid = rowid;
+    r.type = type;
+    r.ident = addString(ident);
+    r.name = addString(name);
+    _records.push_back(r);
+    return _records.back();
+}
+
+NavDataSnapshot::Record* NavDataSnapshot::Builder::find(int64_t rowid)
+{
+    auto it = std::lower_bound(_records.begin(), _records.end(), rowid,
+                               [](const Record& r, int64_t id) { return r.rowid < id; });
+    if ((it == _records.end()) || (it->rowid != rowid)) {
+        return nullptr;
+    }
+
+    return &(*it);
+}
+
+void NavDataSnapshot::Builder::addOctreeBranch(int64_t node, int children)
+{
+    _branches.emplace_back(node, children);
+}
+
+bool NavDataSnapshot::Builder::write(const SGPath& path, uint64_t stamp)
+{
+    std::vector<LeafEntry> leaves;
+    std::vector<FreqEntry> navFreqs, commFreqs;
+    std::vector<IdentEntry> idents;
+
+    for (const Record& r : _records) {
+        if (r.octreeNode != 0) {
+            leaves.push_back({r.octreeNode, r.rowid, r.type, 0});
+        }
+
+        if (r.flags & HAS_NAVAID) {
+            navFreqs.push_back({r.rowid, r.freq, r.type});
+        } else if (r.flags & HAS_COMM) {
+            commFreqs.push_back({r.rowid, r.freq, r.type});
+        }
+
+        if (_strings[r.ident] != '\0') {
+            idents.push_back({r.rowid, r.ident, r.type});
+        }
+    }
+
+    // records are in rowid order, so stable sorts keep equal keys in rowid
+    // order, as the SQLite indexes do
+    std::stable_sort(leaves.begin(), leaves.end(),
+                     [](const LeafEntry& a, const LeafEntry& b) { return a.node < b.node; });
+    auto byFreq = [](const FreqEntry& a, const FreqEntry& b) { return a.freq < b.freq; };
+    std::stable_sort(navFreqs.begin(), navFreqs.end(), byFreq);
+    std::stable_sort(commFreqs.begin(), commFreqs.end(), byFreq);
+    const char* strings = _strings.data();
+    std::stable_sort(idents.begin(), idents.end(),
+                     [strings](const IdentEntry& a, const IdentEntry& b) {
+                         return compareNoCase(strings + a.ident, strings + b.ident) < 0;
+                     });
+
+    std::vector<BranchEntry> branches;
+    branches.reserve(_branches.size());
+    for (const auto& b : _branches) {
+        branches.push_back({b.first, b.second});
+    }
+    std::sort(branches.begin(), branches.end(),
+              [](const BranchEntry& a, const BranchEntry& b) { return a.node < b.node; });
+
+    Header header = {};
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.version = SNAPSHOT_VERSION;
+    header.recordSize = sizeof(Record);
+    header.numSections = NUM_SECTIONS;
+    header.stamp = stamp;
+
+    const void* sectionData[NUM_SECTIONS] = {
+        _records.data(), leaves.data(), branches.data(), navFreqs.data(),
+        commFreqs.data(), idents.data(), _strings.data()};
+    const size_t sectionCount[NUM_SECTIONS] = {
+        _records.size(), leaves.size(), branches.size(), navFreqs.size(),
+        commFreqs.size(), idents.size(), _strings.size()};
+
+    uint64_t offset = align8(sizeof(Header));
+    for (int s = 0; s < NUM_SECTIONS; ++s) {
+        header.sections[s].offset = offset;
+        header.sections[s].count = sectionCount[s];
+        offset = align8(offset + sectionCount[s] * sectionElementSize[s]);
+    }
+
+    // write to a temporary file, and move it in place once complete, so
+    // a process which has the previous snapshot mapped is unaffected
+    SGPath tmpPath = SGPath::fromUtf8(path.utf8Str() + ".tmp");
+    {
+        sg_ofstream out(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        const char zeros[8] = {0};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        out.write(zeros, align8(sizeof(Header)) - sizeof(Header));
+        for (int s = 0; s < NUM_SECTIONS; ++s) {
+            const uint64_t bytes = sectionCount[s] * sectionElementSize[s];
+            out.write(static_cast<const char*>(sectionData[s]), bytes);
+            out.write(zeros, align8(bytes) - bytes);
+        }
+
+        out.close();
+        if (out.fail()) {
+            SG_LOG(SG_NAVCACHE, SG_WARN, "NavCache: failed to write snapshot " << tmpPath);
+            tmpPath.remove();
+            return false;
+        }
+    }
+
+    if (!tmpPath.rename(path)) {
+        SG_LOG(SG_NAVCACHE, SG_WARN, "NavCache: failed to move snapshot into place at " << path);
+        tmpPath.remove();
+        return false;
+    }
+
+    SG_LOG(SG_NAVCACHE, SG_INFO, "NavCache: wrote snapshot of " << _records.size()
+           << " items (" << offset / 1024 << "kb) at " << path);
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+NavDataSnapshot::NavDataSnapshot() = default;
+
+NavDataSnapshot::~NavDataSnapshot()
+{
+    if (_mapping) {
+        _mapping->close();
+    }
+}
+
+std::unique_ptr<NavDataSnapshot> NavDataSnapshot::open(const SGPath& path, uint64_t expectedStamp)
+{
+    if (!path.exists()) {
+        return {};
+    }
+
+    std::unique_ptr<NavDataSnapshot> snap(new NavDataSnapshot);
+    snap->_mapping.reset(new SGMMapFile(path));
+    if (!snap->_mapping->open(SG_IO_IN)) {
+        SG_LOG(SG_NAVCACHE, SG_WARN, "NavCache: failed to map snapshot " << path);
+        return {};
+    }
+
+    const size_t fileSize = snap->_mapping->get_size();
+    snap->_data = snap->_mapping->get();
+    if (!snap->_data || (fileSize < sizeof(Header))) {
+        SG_LOG(SG_NAVCACHE, SG_WARN, "NavCache: snapshot " << path << " is truncated");
+        return {};
+    }
+
+    const Header* header = reinterpret_cast<const Header*>(snap->_data);
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) ||
+        (header->byteOrder != BYTE_ORDER_MARK) ||
+        (header->version != SNAPSHOT_VERSION) ||
+        (header->recordSize != sizeof(Record)) ||
+        (header->numSections != NUM_SECTIONS))
+    {
+        SG_LOG(SG_NAVCACHE, SG_INFO, "NavCache: snapshot " << path << " has an unknown format");
+        return {};
+    }
+
+    if (header->stamp != expectedStamp) {
+        SG_LOG(SG_NAVCACHE, SG_INFO, "NavCache: snapshot " << path << " doesn't match the cache");
+        return {};
+    }
+
+    for (int s = 0; s < NUM_SECTIONS; ++s) {
+        const Section& sec = header->sections[s];
+        if ((sec.offset % 8) || (sec.offset > fileSize) ||
+            (sec.count > (fileSize - sec.offset) / sectionElementSize[s]))
+        {
+            SG_LOG(SG_NAVCACHE, SG_WARN, "NavCache: snapshot " << path << " is corrupt");
+            return {};
+        }
+    }
+
+    const Section& strings = header->sections[SECTION_STRINGS];
+    if ((strings.count == 0) || (snap->_data[strings.offset + strings.count - 1] != '\0')) {
+        SG_LOG(SG_NAVCACHE, SG_WARN, "NavCache: snapshot " << path << " is corrupt");
+        return {};
+    }
+
+    snap->_header = header;
+    SG_LOG(SG_NAVCACHE, SG_INFO, "NavCache: using snapshot at " << path << " ("
+           << snap->size() << " items)");
+    return snap;
+}
+
+template <class T>
+const T* NavDataSnapshot::section(int index, size_t& count) const
+{
+    const Section& s = _header->sections[index];
+    count = s.count;
+    return reinterpret_cast<const T*>(_data + s.offset);
+}
+
+size_t NavDataSnapshot::size() const
+{
+    return _header->sections[SECTION_RECORDS].count;
+}
+
+int64_t NavDataSnapshot::lastRowid() const
+{
+    size_t count;
+    const Record* records = section<Record>(SECTION_RECORDS, count);
+    return (count > 0) ? records[count - 1].rowid : 0;
+}
+
+const NavDataSnapshot::Record* NavDataSnapshot::findRecord(int64_t rowid) const
+{
+    size_t count;
+    const Record* records = section<Record>(SECTION_RECORDS, count);
+    if (count == 0) {
+        return nullptr;
+    }
+
+    // rowids are allocated sequentially during a rebuild, so the record is
+    // almost always found by indexing directly
+    const int64_t index = rowid - records[0].rowid;
+    if ((index >= 0) && (static_cast<uint64_t>(index) < count) &&
+        (records[index].rowid == rowid))
+    {
+        return records + index;
+    }
+
+    const Record* end = records + count;
+    const Record* it = std::lower_bound(records, end, rowid,
+                                        [](const Record& r, int64_t id) { return r.rowid < id; });
+    return ((it != end) && (it->rowid == rowid)) ? it : nullptr;
+}
+
+const char* NavDataSnapshot::stringAt(uint32_t offset) const
+{
+    return _data + _header->sections[SECTION_STRINGS].offset + offset;
+}
+
+bool NavDataSnapshot::isNodeModified(int64_t node) const
+{
+    if (!_hasModifiedItems) {
+        return false; // common case, no lock needed
+    }
+
+    std::lock_guard<std::mutex> g(_modifiedLock);
+    return _modifiedNodes.count(node) > 0;
+}
+
+bool NavDataSnapshot::isIdentModified(const std::string& key) const
+{
+    if (!_hasModifiedItems) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> g(_modifiedLock);
+    return _modifiedIdents.count(key) > 0;
+}
+
+bool NavDataSnapshot::octreeLeafChildren(int64_t node, TypedPositionedVec& result) const
+{
+    if (isNodeModified(node)) {
+        return false;
+    }
+
+    size_t count;
+    const LeafEntry* leaves = section<LeafEntry>(SECTION_LEAVES, count);
+    const LeafEntry* it = std::lower_bound(leaves, leaves + count, node,
+                                           [](const LeafEntry& e, int64_t n) { return e.node < n; });
+    for (; (it != leaves + count) && (it->node == node); ++it) {
+        result.push_back(std::make_pair(static_cast<FGPositioned::Type>(it->type), it->rowid));
+    }
+
+    return true;
+}
+
+bool NavDataSnapshot::octreeBranchChildren(int64_t node, int& children) const
+{
+    if (isNodeModified(node)) {
+        return false;
+    }
+
+    size_t count;
+    const BranchEntry* branches = section<BranchEntry>(SECTION_BRANCHES, count);
+    const BranchEntry* it = std::lower_bound(branches, branches + count, node,
+                                             [](const BranchEntry& e, int64_t n) { return e.node < n; });
+    children = ((it != branches + count) && (it->node == node)) ? static_cast<int>(it->children) : 0;
+    return true;
+}
+
+void NavDataSnapshot::sortByDistance(const SGVec3d& cartPos, PositionedIDVec& ids) const
+{
+    std::vector<std::pair<double, PositionedID>> byDistance;
+    byDistance.reserve(ids.size());
+    for (PositionedID id : ids) {
+        const Record* r = findRecord(id);
+        const SGVec3d pos(r->cart[0], r->cart[1], r->cart[2]);
+        byDistance.emplace_back(distSqr(pos, cartPos), id);
+    }
+
+    std::stable_sort(byDistance.begin(), byDistance.end(),
+                     [](const std::pair<double, PositionedID>& a,
+                        const std::pair<double, PositionedID>& b) { return a.first < b.first; });
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = byDistance[i].second;
+    }
+}
+
+bool NavDataSnapshot::findByFreq(int sectionIndex, int freq, int minType, int maxType,
+                                 const SGVec3d* cartPos, PositionedIDVec& result) const
+{
+    if (_frequenciesModified) {
+        return false;
+    }
+
+    size_t count;
+    const FreqEntry* entries = section<FreqEntry>(sectionIndex, count);
+    const FreqEntry* it = std::lower_bound(entries, entries + count, freq,
+                                           [](const FreqEntry& e, int f) { return e.freq < f; });
+    for (; (it != entries + count) && (it->freq == freq); ++it) {
+        if ((it->type >= minType) && (it->type <= maxType)) {
+            result.push_back(it->rowid);
+        }
+    }
+
+    if (cartPos) {
+        sortByDistance(*cartPos, result);
+    }
+
+    return true;
+}
+
+bool NavDataSnapshot::findNavaidsByFreq(int freq, int minType, int maxType,
+                                        const SGVec3d* cartPos, PositionedIDVec& result) const
+{
+    return findByFreq(SECTION_NAV_FREQS, freq, minType, maxType, cartPos, result);
+}
+
+bool NavDataSnapshot::findCommsByFreq(int freq, int minType, int maxType,
+                                      const SGVec3d* cartPos, PositionedIDVec& result) const
+{
+    return findByFreq(SECTION_COMM_FREQS, freq, minType, maxType, cartPos, result);
+}
+
+bool NavDataSnapshot::findByIdent(const std::string& ident, int minType, int maxType,
+                                  const SGVec3d* cartPos, PositionedIDVec& result) const
+{
+    std::string key(ident);
+    std::transform(key.begin(), key.end(), key.begin(), foldCase);
+    if (isIdentModified(key)) {
+        return false;
+    }
+
+    size_t count;
+    const IdentEntry* entries = section<IdentEntry>(SECTION_IDENTS, count);
+    const char* strings = stringAt(0);
+    const IdentEntry* end = entries + count;
+    const IdentEntry* lower = std::lower_bound(entries, end, key.c_str(),
+                                               [strings](const IdentEntry& e, const char* k) {
+                                                   return compareNoCase(strings + e.ident, k) < 0;
+                                               });
+    const IdentEntry* upper = std::upper_bound(lower, end, key.c_str(),
+                                               [strings](const char* k, const IdentEntry& e) {
+                                                   return compareNoCase(k, strings + e.ident) < 0;
+                                               });
+
+    for (const IdentEntry* it = lower; it != upper; ++it) {
+        if ((it->type >= minType) && (it->type <= maxType)) {
+            result.push_back(it->rowid);
+        }
+    }
+
+    if (cartPos) {
+        sortByDistance(*cartPos, result);
+    }
+
+    return true;
+}
+
+void NavDataSnapshot::markOctreeNodeModified(int64_t node)
+{
+    std::lock_guard<std::mutex> g(_modifiedLock);
+    _modifiedNodes.insert(node);
+    _hasModifiedItems = true;
+}
+
+void NavDataSnapshot::markIdentModified(const std::string& ident)
+{
+    std::string key(ident);
+    std::transform(key.begin(), key.end(), key.begin(), foldCase);
+
+    std::lock_guard<std::mutex> g(_modifiedLock);
+    _modifiedIdents.insert(key);
+    _hasModifiedItems = true;
+}
+
+void NavDataSnapshot::markFrequenciesModified()
+{
+    _frequenciesModified = true;
+}
+
+} // namespace flightgear
@@ -0,0 +1,172 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX_FileComment: Read-only, memory-mapped image of the navigation data cache
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <simgear/math/SGVec3.hxx>
+
+#include <Navaids/NavDataCache.hxx>
+
+class SGMMapFile;
+class SGPath;
+
+namespace flightgear
+{
+
+/**
+ * A flat binary image of the (immutable once built) contents of the
+ * NavDataCache: one fixed-size record per positioned, the octree layout and
+ * sorted frequency and ident indexes. The file is written next to the
+ * SQLite cache after a rebuild and mapped read-only at start-up, so lookups
+ * are binary searches over the mapping instead of SQL statements.
+ *
+ * Each file carries a stamp which is also stored in the SQLite cache; a
+ * snapshot whose stamp doesn't match is ignored. Items added to the database
+ * at runtime (user waypoints, mostly) are not in the snapshot, and don't
+ * invalidate it: they are marked as modified, in this session and (by rowid)
+ * in later ones, so queries which could involve them return false and the
+ * caller falls back to SQLite.
+ *
+ * The layout is native-endian and not meant to be portable between machines.
+ *
+ * Queries may run on any thread; the mark*Modified() functions may be called
+ * concurrently with them.
+ */
+class NavDataSnapshot
+{
+public:
+    ~NavDataSnapshot();
+
+    enum RecordFlags {
+        HAS_AIRPORT = 1 << 0,
+        HAS_RUNWAY = 1 << 1,
+        HAS_NAVAID = 1 << 2,
+        HAS_COMM = 1 << 3
+    };
+
+    /// one row of the 'positioned' table, plus the columns of whichever of
+    /// the airport / runway / navaid / comm tables has the same rowid
+    struct Record {
+        int64_t rowid;
+        int64_t airport;
+        int64_t octreeNode; ///< 0 if not in the spatial index
+        double lon, lat, elevM;
+        double cart[3];
+        uint32_t ident; ///< offsets into the string pool
+        uint32_t name;
+        int32_t type;
+        int32_t flags; ///< RecordFlags
+
+        // airports
+        int32_t hasMetar;
+        // runways
+        int32_t surface;
+        double heading, lengthFt, widthM, displacedThreshold, stopway;
+        int64_t reciprocal, ils;
+        // navaids and comms
+        int32_t freq, rangeNm;
+        double multiuse;
+        int64_t runway, colocated;
+    };
+
+    /**
+     * Collects the cache contents and writes the snapshot file. Records must
+     * be added in increasing rowid order.
+     */
+    class Builder
+    {
+    public:
+        Builder();
+        ~Builder();
+
+        Record& addPositioned(int64_t rowid, int type, const char* ident, const char* name);
+        Record* find(int64_t rowid);
+
+        void addOctreeBranch(int64_t node, int children);
+
+        bool write(const SGPath& path, uint64_t stamp);
+
+    private:
+        uint32_t addString(const char* s);
+
+        std::vector<Record> _records;
+        std::vector<std::pair<int64_t, int64_t>> _branches;
+        std::string _strings;
+        std::unordered_map<std::string, uint32_t> _stringOffsets;
+    };
+
+    /**
+     * Map the snapshot at path, if it exists, is well-formed and carries
+     * the expected stamp. Returns nullptr otherwise.
+     */
+    static std::unique_ptr<NavDataSnapshot> open(const SGPath& path, uint64_t expectedStamp);
+
+    size_t size() const;
+    /// the highest rowid in the snapshot: rows above it were added later
+    int64_t lastRowid() const;
+
+    /// nullptr if rowid is not in the snapshot
+    const Record* findRecord(int64_t rowid) const;
+    const char* stringAt(uint32_t offset) const;
+
+    // The queries below mirror the SQL ones in NavDataCache, including the
+    // ordering of results. They return false if the snapshot can't answer,
+    // because the database was changed since it was written.
+    bool octreeLeafChildren(int64_t node, TypedPositionedVec& result) const;
+    bool octreeBranchChildren(int64_t node, int& children) const;
+
+    /// cartPos may be null, in which case results are in rowid order,
+    /// otherwise they are sorted by distance from cartPos
+    bool findNavaidsByFreq(int freq, int minType, int maxType,
+                           const SGVec3d* cartPos, PositionedIDVec& result) const;
+    bool findCommsByFreq(int freq, int minType, int maxType,
+                         const SGVec3d* cartPos, PositionedIDVec& result) const;
+    /// exact, case-insensitive (ASCII) ident match
+    bool findByIdent(const std::string& ident, int minType, int maxType,
+                     const SGVec3d* cartPos, PositionedIDVec& result) const;
+
+    // Runtime changes to the database, which the snapshot doesn't reflect
+    void markOctreeNodeModified(int64_t node);
+    void markIdentModified(const std::string& ident);
+    void markFrequenciesModified();
+
+private:
+    struct Header;
+    struct Section;
+
+    NavDataSnapshot();
+
+    template <class T>
+    const T* section(int index, size_t& count) const;
+
+    bool findByFreq(int sectionIndex, int freq, int minType, int maxType,
+                    const SGVec3d* cartPos, PositionedIDVec& result) const;
+    void sortByDistance(const SGVec3d& cartPos, PositionedIDVec& ids) const;
+
+    bool isNodeModified(int64_t node) const;
+    bool isIdentModified(const std::string& key) const;
+
+    std::unique_ptr<SGMMapFile> _mapping;
+    const char* _data = nullptr;
+    const Header* _header = nullptr;
+
+    mutable std::mutex _modifiedLock;
+    std::atomic<bool> _hasModifiedItems{false};
+    std::set<int64_t> _modifiedNodes;
+    std::set<std::string> _modifiedIdents; ///< upper-cased
+    std::atomic<bool> _frequenciesModified{false};
+};
+
+} // namespace flightgear
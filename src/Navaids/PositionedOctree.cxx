@@ -30,6 +30,7 @@
 #include <algorithm> // for sort
 #include <cstring> // for memset
 #include <iostream>
+#include <mutex>
 
 #include <simgear/debug/logstream.hxx>
 #include <simgear/structure/exception.hxx>
@@ -48,6 +49,11 @@ static std::unique_ptr<Node> global_transientOctree;
 
 double RADIUS_EARTH_M = 7000 * 1000.0; // 7000km is plenty
 
+// Searches may run on worker threads (see NavDataCache), so lazily loading
+// or creating nodes, and adding items, happens under this lock. It is
+// recursive because loading a branch creates its child nodes.
+static std::recursive_mutex static_nodesLock;
+
 Node* globalTransientOctree()
 {
     if (!global_transientOctree) {
@@ -115,11 +121,19 @@ void Leaf::visit(const SGVec3d& aPos, double aCutoff,
 
   loadChildren();
 
-  ChildMap::const_iterator it = children.lower_bound(aFilter->minType());
-  ChildMap::const_iterator end = children.upper_bound(aFilter->maxType());
+  // copy the IDs, so the lock isn't held while loading the items
+  PositionedIDVec ids;
+  {
+    std::lock_guard<std::recursive_mutex> g(static_nodesLock);
+    ChildMap::const_iterator it = children.lower_bound(aFilter->minType());
+    ChildMap::const_iterator end = children.upper_bound(aFilter->maxType());
+    for (; it != end; ++it) {
+      ids.push_back(it->second);
+    }
+  }
 
-  for (; it != end; ++it) {
-    FGPositioned* p = cache->loadById(it->second);
+  for (PositionedID id : ids) {
+    FGPositioned* p = cache->loadById(id);
     double d = dist(aPos, p->cart());
     if (d > aCutoff) {
       continue;
@@ -149,6 +163,7 @@ void Leaf::visit(const SGVec3d& aPos, double aCutoff,
 void Leaf::insertChild(FGPositioned::Type ty, PositionedID id)
 {
   assert(_childrenLoaded);
+  std::lock_guard<std::recursive_mutex> g(static_nodesLock);
   children.insert(children.end(), TypedPositioned(ty, id));
 }
 
@@ -158,6 +173,11 @@ void Leaf::loadChildren()
         return;
     }
 
+  std::lock_guard<std::recursive_mutex> g(static_nodesLock);
+  if (_childrenLoaded) {
+    return; // loaded by another thread meanwhile
+  }
+
   NavDataCache* cache = NavDataCache::instance();
   for (const auto& tp : cache->getOctreeLeafChildren(guid())) {
     // REVIEW: Memory Leak - 1,728 bytes in 36 blocks are still reachable
@@ -171,7 +191,9 @@ void Leaf::loadChildren()
 
 Branch::Branch(const SGBoxd& aBox, int64_t aIdent, bool persistent) : Node(aBox, aIdent, persistent)
 {
-    _children.fill(nullptr);
+    for (auto& child : _children) {
+        child = nullptr;
+    }
     if (!_persistent) {
         _childrenLoaded = true;
     }
@@ -183,16 +205,17 @@ void Branch::visit(const SGVec3d& aPos, double aCutoff,
 {
   loadChildren();
   for (unsigned int i=0; i<8; ++i) {
-      if (!_children[i]) {
+      Node* child = _children[i];
+      if (!child) {
           continue;
       }
 
-      double d = _children[i]->distToNearest(aPos);
+      double d = child->distToNearest(aPos);
       if (d > aCutoff) {
           continue; // exceeded cutoff
     }
 
-    aQ.push(Ordered<Node*>(_children[i], d));
+    aQ.push(Ordered<Node*>(child, d));
   } // of child iteration
 }
 
@@ -204,16 +227,17 @@ void Branch::visitForLines(const SGVec3d& aPos, double aCutoff,
     Node::visitForLines(aPos, aCutoff, aLines, aQ);
 
     for (unsigned int i=0; i<8; ++i) {
-        if (!_children[i]) {
+        Node* child = _children[i];
+        if (!child) {
             continue;
         }
 
-        double d = _children[i]->distToNearest(aPos);
+        double d = child->distToNearest(aPos);
         if (d > aCutoff) {
             continue; // exceeded cutoff
         }
 
-        aQ.push_back(_children[i]);
+        aQ.push_back(child);
     } // of child iteration
 }
 
@@ -271,6 +295,12 @@ Node* Branch::childForPos(const SGVec3d& aCart) const
 Node* Branch::childAtIndex(int childIndex) const
 {
     Node* child = _children[childIndex];
+    if (child) {
+        return child;
+    }
+
+    std::lock_guard<std::recursive_mutex> g(static_nodesLock);
+    child = _children[childIndex];
     if (!child) { // lazy building of children
         SGBoxd cb(boxForChild(childIndex));
         double d2 = dot(cb.getSize(), cb.getSize());
@@ -307,6 +337,11 @@ void Branch::loadChildren() const
         return;
     }
 
+  std::lock_guard<std::recursive_mutex> g(static_nodesLock);
+  if (_childrenLoaded) {
+    return; // loaded by another thread meanwhile
+  }
+
   int childrenMask = NavDataCache::instance()->getOctreeBranchChildren(guid());
   for (int i=0; i<8; ++i) {
     if ((1 << i) & childrenMask) {
@@ -26,6 +26,7 @@
 
 // std
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <functional>
 #include <map>
@@ -195,7 +196,7 @@ namespace Octree
     void insertChild(FGPositioned::Type ty, PositionedID id);
 
   private:
-      bool _childrenLoaded = false;
+      std::atomic<bool> _childrenLoaded{false};
 
       typedef std::multimap<FGPositioned::Type, PositionedID> ChildMap;
       ChildMap children;
@@ -242,8 +243,10 @@ namespace Octree
 
     void loadChildren() const;
 
-    mutable std::array<Node*, 8> _children;
-    mutable bool _childrenLoaded = false;
+    // nodes are searched from worker threads too; children are created
+    // lazily, under a lock, but read without one
+    mutable std::array<std::atomic<Node*>, 8> _children;
+    mutable std::atomic<bool> _childrenLoaded{false};
   };
 
   bool findNearestN(const SGVec3d& aPos, unsigned int aN, double aCutoffM, FGPositioned::Filter* aFilter, FGPositionedList& aResults, int aCutoffMsec);
@@ -23,6 +23,7 @@
 
 #include <tuple>
 #include <algorithm>
+#include <mutex>
 #include <set>
 
 #include <simgear/sg_inlines.h>
@@ -46,8 +47,18 @@ namespace flightgear
 {
 
 static std::vector<AirwayRef> static_airwaysCache;
+// airways are looked up by routing on worker threads too
+static std::mutex static_airwaysCacheLock;
 typedef SGSharedPtr<FGPositioned> FGPositionedRef;
 
+template <class Pred>
+static AirwayRef findCachedAirway(Pred pred)
+{
+    std::lock_guard<std::mutex> g(static_airwaysCacheLock);
+    auto it = std::find_if(static_airwaysCache.begin(), static_airwaysCache.end(), pred);
+    return (it != static_airwaysCache.end()) ? *it : AirwayRef();
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 class AStarOpenNode : public SGReferenced
@@ -92,24 +103,24 @@ using AStarOpenNodeRef = SGSharedPtr<AStarOpenNode>;
 
 Airway::Network* Airway::lowLevel()
 {
-  static Network* static_lowLevel = nullptr;
-  
-  if (!static_lowLevel) {
-      static_lowLevel = new Network;
-      static_lowLevel->_networkID = Airway::LowLevel;
-  }
-  
+  // initialisation of function statics is thread-safe
+  static Network* static_lowLevel = [] {
+      Network* n = new Network;
+      n->_networkID = Airway::LowLevel;
+      return n;
+  }();
+
   return static_lowLevel;
 }
 
 Airway::Network* Airway::highLevel()
 {
-  static Network* static_highLevel = nullptr;
-  if (!static_highLevel) {
-    static_highLevel = new Network;
-      static_highLevel->_networkID = Airway::HighLevel;
-  }
-  
+  static Network* static_highLevel = [] {
+      Network* n = new Network;
+      n->_networkID = Airway::HighLevel;
+      return n;
+  }();
+
   return static_highLevel;
 }
 
@@ -124,6 +135,7 @@ Airway::Airway(const std::string& aIdent,
   _bottomAltitudeFt(aBottom)
 {
     assert((level == HighLevel) || (level == LowLevel));
+    std::lock_guard<std::mutex> g(static_airwaysCacheLock);
     static_airwaysCache.push_back(this);
 }
 
@@ -281,11 +293,10 @@ bool Airway::containsNavaid(const FGPositionedRef &navaid) const
 int Airway::Network::findAirway(const std::string& aName)
 {
     const Level level = _networkID;
-    auto it = std::find_if(static_airwaysCache.begin(), static_airwaysCache.end(),
-                           [aName, level](const AirwayRef& awy)
+    AirwayRef cached = findCachedAirway([aName, level](const AirwayRef& awy)
     { return (awy->_level == level) && (awy->ident() == aName); });
-    if (it != static_airwaysCache.end()) {
-        return (*it)->_cacheId;
+    if (cached) {
+        return cached->_cacheId;
     }
 
     return NavDataCache::instance()->findAirway(_networkID, aName, true);
@@ -293,14 +304,13 @@ int Airway::Network::findAirway(const std::string& aName)
 
 AirwayRef Airway::findByIdent(const std::string& aIdent, Level level)
 {
-    auto it = std::find_if(static_airwaysCache.begin(), static_airwaysCache.end(),
-                           [aIdent, level](const AirwayRef& awy)
+    AirwayRef cached = findCachedAirway([aIdent, level](const AirwayRef& awy)
     { 
       if ((level != Both) && (awy->_level != level)) return false;
       return (awy->ident() == aIdent); 
     });
-    if (it != static_airwaysCache.end()) {
-        return *it;
+    if (cached) {
+        return cached;
     }
 
     auto ndc = NavDataCache::instance();
@@ -326,11 +336,10 @@ AirwayRef Airway::findByIdent(const std::string& aIdent, Level level)
 
     AirwayRef Airway::loadByCacheId(int cacheId)
     {
-        auto it = std::find_if(static_airwaysCache.begin(), static_airwaysCache.end(),
-                               [cacheId](const AirwayRef& awy)
-                               { return (awy->_cacheId == cacheId); });
-        if (it != static_airwaysCache.end()) {
-            return *it;
+        AirwayRef cached = findCachedAirway([cacheId](const AirwayRef& awy)
+                                            { return (awy->_cacheId == cacheId); });
+        if (cached) {
+            return cached;
         }
 
         return NavDataCache::instance()->loadAirway(cacheId);
@@ -444,13 +453,17 @@ static double headingDiffDeg(double a, double b)
     
 bool Airway::Network::inNetwork(PositionedID posID) const
 {
-  NetworkMembershipDict::iterator it = _inNetworkCache.find(posID);
-  if (it != _inNetworkCache.end()) {
-    return it->second; // cached, easy
+  {
+    std::lock_guard<std::mutex> g(_inNetworkLock);
+    NetworkMembershipDict::iterator it = _inNetworkCache.find(posID);
+    if (it != _inNetworkCache.end()) {
+      return it->second; // cached, easy
+    }
   }
-  
+
   bool r =  NavDataCache::instance()->isInAirwayNetwork(_networkID, posID);
-  _inNetworkCache.insert(it, std::make_pair(posID, r));
+  std::lock_guard<std::mutex> g(_inNetworkLock);
+  _inNetworkCache.insert(std::make_pair(posID, r));
   return r;
 }
 
@@ -21,6 +21,7 @@
 #define FG_AIRWAYS_HXX
 
 #include <map>
+#include <mutex>
 #include <vector>
 
 #include <Navaids/route.hxx>
@@ -157,6 +158,7 @@ public:
      */
     typedef std::map<PositionedID, bool> NetworkMembershipDict;
     mutable NetworkMembershipDict _inNetworkCache;
+    mutable std::mutex _inNetworkLock;
     
     Level _networkID;
   };
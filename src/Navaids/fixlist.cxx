@@ -28,6 +28,7 @@
 #include <stdlib.h>             // atof()
 
 #include <algorithm>
+#include <sstream>
 #include <string>               // std::getline()
 #include <errno.h>
 
@@ -68,14 +69,19 @@ FixesLoader::~FixesLoader()
 void FixesLoader::loadFixes(const SGPath& path, std::size_t bytesReadSoFar,
                             std::size_t totalSizeOfAllDatFiles)
 {
-  sg_gzifstream in( path );
-  const std::string utf8path = path.utf8Str();
+  loadFixes(path, NavDataCache::readDatFileContents(path), bytesReadSoFar,
+            totalSizeOfAllDatFiles);
+}
 
-  if ( !in.is_open() ) {
-    throw sg_io_exception(
-      "Cannot open file (" + simgear::strutils::error_string(errno) + ")",
-      sg_location(path));
-  }
+void FixesLoader::loadFixes(const SGPath& path, const std::string& contents,
+                            std::size_t bytesReadSoFar,
+                            std::size_t totalSizeOfAllDatFiles)
+{
+  std::istringstream in(contents);
+  const std::string utf8path = path.utf8Str();
+  // progress is reported relative to the size of the file on disk
+  const double sizeOnDiskRatio =
+    contents.empty() ? 0.0 : static_cast<double>(path.sizeInBytes()) / contents.size();
 
   // toss the first two lines of the file
   for (int i = 0; i < 2; i++) {
@@ -149,7 +155,11 @@ void FixesLoader::loadFixes(const SGPath& path, std::size_t bytesReadSoFar,
 
     if ((lineNumber % 100) == 0) {
       // every 100 lines
-      unsigned int percent = ((bytesReadSoFar + in.approxOffset()) * 100)
+      // tellg() fails once the last line has set eofbit
+      const std::size_t pos = in.eof() ? contents.size()
+                                       : static_cast<std::size_t>(in.tellg());
+      const std::size_t offset = static_cast<std::size_t>(pos * sizeOnDiskRatio);
+      unsigned int percent = ((bytesReadSoFar + offset) * 100)
         / totalSizeOfAllDatFiles;
       _cache->setRebuildPhaseProgress(NavDataCache::REBUILD_FIXES, percent);
     }
@@ -159,7 +169,7 @@ void FixesLoader::loadFixes(const SGPath& path, std::size_t bytesReadSoFar,
 }
 
 void FixesLoader::throwExceptionIfStreamError(
-  const sg_gzifstream& input_stream, const SGPath& path)
+  const std::istream& input_stream, const SGPath& path)
 {
   if (input_stream.bad()) {
     const std::string errMsg = simgear::strutils::error_string(errno);
@@ -27,11 +27,11 @@
 
 #include <simgear/compiler.h>
 #include <simgear/math/SGGeod.hxx>
+#include <istream>
 #include <unordered_map>
 #include <string>
 
 class SGPath;
-class sg_gzifstream;
 
 namespace flightgear
 {
@@ -46,9 +46,13 @@ namespace flightgear
     // Load fixes from the specified fix.dat (or fix.dat.gz) file
     void loadFixes(const SGPath& path, std::size_t bytesReadSoFar,
                    std::size_t totalSizeOfAllDatFiles);
+    // Same, for a file whose (decompressed) contents are already in memory
+    void loadFixes(const SGPath& path, const std::string& contents,
+                   std::size_t bytesReadSoFar,
+                   std::size_t totalSizeOfAllDatFiles);
 
   private:
-    void throwExceptionIfStreamError(const sg_gzifstream& input_stream,
+    void throwExceptionIfStreamError(const std::istream& input_stream,
                                      const SGPath& path);
 
     NavDataCache* _cache;
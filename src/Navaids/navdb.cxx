@@ -27,6 +27,7 @@
 #include <string>
 #include <vector>
 #include <istream>
+#include <sstream>
 #include <cmath>
 #include <cstddef>              // std::size_t
 #include <cerrno>
@@ -428,16 +429,21 @@ PositionedID NavLoader::processNavLine(
 // load and initialize the navigational databases
 void NavLoader::loadNav(const SGPath& path, std::size_t bytesReadSoFar,
                         std::size_t totalSizeOfAllDatFiles)
+{
+  loadNav(path, NavDataCache::readDatFileContents(path), bytesReadSoFar,
+          totalSizeOfAllDatFiles);
+}
+
+void NavLoader::loadNav(const SGPath& path, const std::string& contents,
+                        std::size_t bytesReadSoFar,
+                        std::size_t totalSizeOfAllDatFiles)
 {
   NavDataCache* cache = NavDataCache::instance();
   const string utf8Path = path.utf8Str();
-  sg_gzifstream in(path);
-
-  if ( !in.is_open() ) {
-    throw sg_io_exception(
-      "Cannot open file (" + simgear::strutils::error_string(errno) + ")",
-      sg_location(path));
-  }
+  std::istringstream in(contents);
+  // progress is reported relative to the size of the file on disk
+  const double sizeOnDiskRatio =
+    contents.empty() ? 0.0 : static_cast<double>(path.sizeInBytes()) / contents.size();
 
   string line;
 
@@ -480,7 +486,11 @@ void NavLoader::loadNav(const SGPath& path, std::size_t bytesReadSoFar,
 
     if ((lineNumber % 100) == 0) {
       // every 100 lines
-      unsigned int percent = ((bytesReadSoFar + in.approxOffset()) * 100)
+      // tellg() fails once the last line has set eofbit
+      const std::size_t pos = in.eof() ? contents.size()
+                                       : static_cast<std::size_t>(in.tellg());
+      const std::size_t offset = static_cast<std::size_t>(pos * sizeOnDiskRatio);
+      unsigned int percent = ((bytesReadSoFar + offset) * 100)
         / totalSizeOfAllDatFiles;
       cache->setRebuildPhaseProgress(NavDataCache::REBUILD_NAVAIDS, percent);
     }
@@ -44,6 +44,10 @@ class NavLoader {
     // load and initialize the navigational databases
     void loadNav(const SGPath& path, std::size_t bytesReadSoFar,
                  std::size_t totalSizeOfAllDatFiles);
+    // Same, for a file whose (decompressed) contents are already in memory
+    void loadNav(const SGPath& path, const std::string& contents,
+                 std::size_t bytesReadSoFar,
+                 std::size_t totalSizeOfAllDatFiles);
 
     void loadCarrierNav(const SGPath& path);
 
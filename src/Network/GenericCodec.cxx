@@ -0,0 +1,619 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "GenericCodec.hxx"
+
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <simgear/misc/stdint.hxx>
+#include <simgear/misc/strutils.hxx>
+
+namespace
+{
+
+// snprintf() handles wider fields and more decimals
+const int MAX_DIRECT_WIDTH = 64;
+const int MAX_DIRECT_PRECISION = 15;
+
+const double POW10[MAX_DIRECT_PRECISION + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+    1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+// each formatted value used to go through a char[255]
+const size_t MAX_FIELD_LENGTH = 254;
+
+union u32 {
+    uint32_t intVal;
+    float floatVal;
+};
+
+union u64 {
+    uint64_t longVal;
+    double doubleVal;
+};
+
+inline void put32(char* p, uint32_t v, bool swap)
+{
+    if (swap)
+        v = sg_bswap_32(v);
+    memcpy(p, &v, sizeof(v));
+}
+
+inline uint32_t get32(const char* p, bool swap)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return swap ? sg_bswap_32(v) : v;
+}
+
+inline void append(char*& p, char* end, const char* s, size_t n)
+{
+    if (n > static_cast<size_t>(end - p))
+        n = end - p;
+    memcpy(p, s, n);
+    p += n;
+}
+
+inline void append(char*& p, char* end, const std::string& s)
+{
+    append(p, end, s.data(), s.size());
+}
+
+inline void fill(char*& p, char* end, char c, int n)
+{
+    for (; n > 0 && p < end; --n)
+        *p++ = c;
+}
+
+/**
+ * Write the decimal digits of v, with a '.' before the last precision of
+ * them, so that they end at end, and return their start.
+ */
+char* digits(uint64_t v, int precision, char* end)
+{
+    char* b = end;
+    int n = 0;
+    do {
+        *--b = '0' + static_cast<char>(v % 10);
+        v /= 10;
+        if (++n == precision)
+            *--b = '.';
+    } while (v || n <= precision);
+    return b;
+}
+
+/**
+ * Round a (not negative) to precision decimals the way printf would. Near a
+ * tie the result depends on the exact binary value, which the scaling below
+ * has rounded already; those (and huge values) return false, to be left to
+ * snprintf().
+ */
+bool roundFixed(double a, int precision, uint64_t& result)
+{
+    const double scaled = a * POW10[precision];
+    if (!(scaled < 4e15))
+        return false;
+
+    const double whole = std::floor(scaled);
+    const double frac = scaled - whole;
+    if (std::fabs(frac - 0.5) <= scaled * 4e-16)
+        return false;
+
+    result = static_cast<uint64_t>(whole) + (frac > 0.5 ? 1 : 0);
+    return true;
+}
+
+} // anonymous namespace
+
+void FGGenericCodec::compile(std::vector<Chunk>& chunks, const Layout& layout)
+{
+    _layout = layout;
+    _instructions.clear();
+    _instructions.reserve(chunks.size());
+
+    for (auto& chunk : chunks) {
+        Instruction ins;
+        ins.chunk = &chunk;
+        ins.prop = chunk.prop;
+        ins.offset = chunk.offset;
+        ins.factor = chunk.factor;
+        ins.swap = layout.byteSwap;
+
+        switch (chunk.type) {
+        case FG_BOOL:
+            ins.op = OP_BOOL;
+            ins.size = 1;
+            break;
+        case FG_FLOAT:
+            ins.op = OP_FLOAT32;
+            ins.size = sizeof(int32_t);
+            break;
+        case FG_DOUBLE:
+            ins.op = OP_DOUBLE64;
+            ins.size = sizeof(int64_t);
+            break;
+        case FG_FIXED:
+            ins.op = OP_FIXED32;
+            ins.size = sizeof(int32_t);
+            break;
+        case FG_STRING:
+            ins.op = OP_STRING;
+            ins.size = 0;
+            break;
+        case FG_BYTE:
+            ins.op = OP_INT8;
+            ins.size = sizeof(int8_t);
+            break;
+        case FG_WORD:
+            ins.op = OP_INT16;
+            ins.size = sizeof(int16_t);
+            break;
+        default:
+            ins.op = OP_INT32;
+            ins.size = sizeof(int32_t);
+            break;
+        }
+
+        if (!layout.binary) {
+            ins.format = simgear::strutils::sanitizePrintfFormat(chunk.format);
+            parseFormat(ins);
+        }
+
+        _instructions.push_back(ins);
+    }
+}
+
+void FGGenericCodec::clear()
+{
+    _instructions.clear();
+}
+
+void FGGenericCodec::parseFormat(Instruction& ins)
+{
+    ins.prefix.clear();
+    ins.suffix.clear();
+    ins.conversion = CONV_NONE;
+    ins.direct = false;
+    ins.leftAlign = false;
+    ins.zeroPad = false;
+    ins.width = 0;
+    ins.precision = -1;
+
+    const std::string& f = ins.format;
+    std::string* literal = &ins.prefix;
+    for (size_t i = 0; i < f.size(); ++i) {
+        if (f[i] != '%') {
+            literal->push_back(f[i]);
+            continue;
+        }
+
+        if (++i == f.size())
+            return;
+        if (f[i] == '%') {
+            literal->push_back('%');
+            continue;
+        }
+        if (ins.conversion != CONV_NONE)
+            return;
+
+        for (; i < f.size(); ++i) {
+            if (f[i] == '-')
+                ins.leftAlign = true;
+            else if (f[i] == '0')
+                ins.zeroPad = true;
+            else if (f[i] == '+' || f[i] == ' ' || f[i] == '#' || f[i] == '\'')
+                return;
+            else
+                break;
+        }
+
+        for (; i < f.size() && isdigit(static_cast<unsigned char>(f[i])); ++i) {
+            ins.width = ins.width * 10 + (f[i] - '0');
+            if (ins.width > MAX_DIRECT_WIDTH)
+                return;
+        }
+
+        if (i < f.size() && f[i] == '.') {
+            ins.precision = 0;
+            for (++i; i < f.size() && isdigit(static_cast<unsigned char>(f[i])); ++i) {
+                ins.precision = ins.precision * 10 + (f[i] - '0');
+                if (ins.precision > MAX_DIRECT_PRECISION)
+                    return;
+            }
+        }
+
+        bool isLong = false;
+        if (i < f.size() && f[i] == 'l') {
+            isLong = true;
+            ++i;
+        }
+        if (i == f.size())
+            return;
+
+        switch (f[i]) {
+        case 'd':
+        case 'i':
+            if (isLong || ins.precision >= 0)
+                return;
+            ins.conversion = CONV_INT;
+            break;
+        case 'f':
+        case 'F':
+            if (ins.precision < 0)
+                ins.precision = 6;
+            ins.conversion = CONV_FIXED_POINT;
+            break;
+        case 's':
+            if (isLong || ins.width > 0 || ins.precision >= 0)
+                return;
+            ins.conversion = CONV_STRING;
+            break;
+        default:
+            return;
+        }
+
+        literal = &ins.suffix;
+    }
+
+    // the conversion has to suit the argument the chunk type passes
+    switch (ins.conversion) {
+    case CONV_NONE:
+        ins.direct = true;
+        break;
+    case CONV_INT:
+        ins.direct = ins.op == OP_BOOL || ins.op == OP_INT32 ||
+                     ins.op == OP_INT8 || ins.op == OP_INT16;
+        break;
+    case CONV_FIXED_POINT:
+        ins.direct = ins.op == OP_FLOAT32 || ins.op == OP_FIXED32 ||
+                     ins.op == OP_DOUBLE64;
+        break;
+    case CONV_STRING:
+        ins.direct = ins.op == OP_STRING;
+        break;
+    }
+}
+
+int FGGenericCodec::encode(char* buf, size_t size) const
+{
+    return _layout.binary ? encodeBinary(buf, size) : encodeAscii(buf, size);
+}
+
+int FGGenericCodec::encodeBinary(char* buf, size_t size) const
+{
+    char* p = buf;
+    char* const end = buf + size;
+
+    for (const auto& ins : _instructions) {
+        if (ins.size > static_cast<size_t>(end - p))
+            break;
+
+        switch (ins.op) {
+        case OP_BOOL:
+            *p = ins.prop->getBoolValue() ? 1 : 0;
+            break;
+
+        case OP_INT32: {
+            int32_t intVal = ins.offset + ins.prop->getFloatValue() * ins.factor;
+            put32(p, static_cast<uint32_t>(intVal), ins.swap);
+            break;
+        }
+
+        case OP_FIXED32: {
+            double val = ins.offset + ins.prop->getFloatValue() * ins.factor;
+            int32_t fixed = (int)(val * 65536.0f);
+            put32(p, static_cast<uint32_t>(fixed), ins.swap);
+            break;
+        }
+
+        case OP_FLOAT32: {
+            u32 tmpun32;
+            tmpun32.floatVal = static_cast<float>(ins.offset + ins.prop->getFloatValue() * ins.factor);
+            put32(p, tmpun32.intVal, ins.swap);
+            break;
+        }
+
+        case OP_DOUBLE64: {
+            u64 tmpun64;
+            tmpun64.doubleVal = ins.offset + ins.prop->getDoubleValue() * ins.factor;
+            if (ins.swap)
+                tmpun64.longVal = sg_bswap_64(tmpun64.longVal);
+            memcpy(p, &tmpun64.longVal, sizeof(uint64_t));
+            break;
+        }
+
+        case OP_INT8: {
+            int8_t byteVal = ins.offset + ins.prop->getFloatValue() * ins.factor;
+            memcpy(p, &byteVal, sizeof(int8_t));
+            break;
+        }
+
+        case OP_INT16: {
+            // words have always been sent in host byte order
+            int16_t wordVal = ins.offset + ins.prop->getFloatValue() * ins.factor;
+            memcpy(p, &wordVal, sizeof(int16_t));
+            break;
+        }
+
+        case OP_STRING: {
+            /* Format for strings is
+             * [length as int, 4 bytes][ASCII data, length bytes]
+             */
+            if (end - p < static_cast<ptrdiff_t>(sizeof(int32_t)))
+                break;
+
+            const std::string strdata = ins.prop->getStringValue();
+            size_t strlength = strdata.length();
+            if (strlength > static_cast<size_t>(end - p) - sizeof(int32_t))
+                strlength = end - p - sizeof(int32_t);
+
+            put32(p, static_cast<uint32_t>(strlength), ins.swap);
+            p += sizeof(int32_t);
+            memcpy(p, strdata.data(), strlength);
+            p += strlength;
+            break;
+        }
+        }
+
+        p += ins.size;
+    }
+
+    if (_layout.footer != FOOTER_NONE && end - p >= static_cast<ptrdiff_t>(sizeof(int32_t))) {
+        int32_t intValue = _layout.footer == FOOTER_LENGTH ? static_cast<int32_t>(p - buf)
+                                                           : _layout.footerValue;
+        put32(p, static_cast<uint32_t>(intValue), _layout.byteSwap);
+        p += sizeof(int32_t);
+    }
+
+    return static_cast<int>(p - buf);
+}
+
+int FGGenericCodec::encodeAscii(char* buf, size_t size) const
+{
+    char* p = buf;
+    char* const end = buf + size;
+    char tmp[255];
+
+    for (size_t i = 0; i < _instructions.size(); ++i) {
+        const Instruction& ins = _instructions[i];
+        if (i > 0)
+            append(p, end, _layout.varSeparator);
+
+        char* const field = p;
+        double val = 0.0;
+        if (ins.op != OP_BOOL && ins.op != OP_STRING) {
+            val = ins.offset + ins.factor * (ins.op == OP_DOUBLE64 ? ins.prop->getDoubleValue()
+                                                                   : ins.prop->getFloatValue());
+            if (ins.op == OP_FLOAT32 || ins.op == OP_FIXED32)
+                val = static_cast<float>(val);
+        }
+
+        bool done = false;
+        if (ins.direct) {
+            char number[48];
+            char* const numberEnd = number + sizeof(number);
+            char* digitsBegin = numberEnd;
+            bool negative = false;
+
+            switch (ins.conversion) {
+            case CONV_NONE:
+                done = true;
+                break;
+
+            case CONV_INT: {
+                const int v = ins.op == OP_BOOL ? ins.prop->getBoolValue() : static_cast<int>(val);
+                negative = v < 0;
+                const uint64_t magnitude = negative ? 0 - static_cast<uint64_t>(static_cast<int64_t>(v))
+                                                    : static_cast<uint64_t>(v);
+                digitsBegin = digits(magnitude, 0, numberEnd);
+                done = true;
+                break;
+            }
+
+            case CONV_FIXED_POINT: {
+                uint64_t rounded;
+                if (std::isfinite(val) && roundFixed(std::fabs(val), ins.precision, rounded)) {
+                    negative = std::signbit(val);
+                    digitsBegin = digits(rounded, ins.precision, numberEnd);
+                    done = true;
+                }
+                break;
+            }
+
+            case CONV_STRING: {
+                append(p, end, ins.prefix);
+                const std::string s = ins.prop->getStringValue();
+                append(p, end, s);
+                append(p, end, ins.suffix);
+                done = true;
+                break;
+            }
+            }
+
+            if (done && ins.conversion != CONV_STRING) {
+                append(p, end, ins.prefix);
+
+                const int length = static_cast<int>(numberEnd - digitsBegin) + (negative ? 1 : 0);
+                const int padding = ins.width - length;
+                if (ins.leftAlign) {
+                    fill(p, end, '-', negative ? 1 : 0);
+                    append(p, end, digitsBegin, numberEnd - digitsBegin);
+                    fill(p, end, ' ', padding);
+                } else if (ins.zeroPad) {
+                    fill(p, end, '-', negative ? 1 : 0);
+                    fill(p, end, '0', padding);
+                    append(p, end, digitsBegin, numberEnd - digitsBegin);
+                } else {
+                    fill(p, end, ' ', padding);
+                    fill(p, end, '-', negative ? 1 : 0);
+                    append(p, end, digitsBegin, numberEnd - digitsBegin);
+                }
+
+                append(p, end, ins.suffix);
+            }
+        }
+
+        if (!done) {
+            const char* format = ins.format.c_str();
+            switch (ins.op) {
+            case OP_BOOL:
+                snprintf(tmp, sizeof(tmp), format, ins.prop->getBoolValue());
+                break;
+            case OP_INT32:
+            case OP_INT8:
+            case OP_INT16:
+                snprintf(tmp, sizeof(tmp), format, (int)val);
+                break;
+            case OP_FLOAT32:
+            case OP_FIXED32:
+                snprintf(tmp, sizeof(tmp), format, (float)val);
+                break;
+            case OP_DOUBLE64:
+                snprintf(tmp, sizeof(tmp), format, val);
+                break;
+            case OP_STRING:
+                snprintf(tmp, sizeof(tmp), format, ins.prop->getStringValue().c_str());
+                break;
+            }
+            append(p, end, tmp, strlen(tmp));
+        }
+
+        if (static_cast<size_t>(p - field) > MAX_FIELD_LENGTH)
+            p = field + MAX_FIELD_LENGTH;
+    }
+
+    /* After each lot of variables has been added, put the line separator
+     * char/string
+     */
+    append(p, end, _layout.lineSeparator);
+
+    return static_cast<int>(p - buf);
+}
+
+void FGGenericCodec::decodeBinary(const char* buf, size_t length) const
+{
+    const char* p = buf;
+    const char* const end = buf + length;
+
+    for (const auto& ins : _instructions) {
+        if (p >= end || ins.size > static_cast<size_t>(end - p))
+            break;
+
+        switch (ins.op) {
+        case OP_INT32:
+            updateValue(*ins.chunk, (int)(int32_t)get32(p, ins.swap));
+            break;
+
+        case OP_BOOL:
+            updateValue(*ins.chunk, p[0] != 0);
+            break;
+
+        case OP_FIXED32:
+            updateValue(*ins.chunk, (float)(int32_t)get32(p, ins.swap) / 65536.0f);
+            break;
+
+        case OP_FLOAT32: {
+            u32 tmpun32;
+            tmpun32.intVal = get32(p, ins.swap);
+            updateValue(*ins.chunk, tmpun32.floatVal);
+            break;
+        }
+
+        case OP_DOUBLE64: {
+            u64 tmpun64;
+            memcpy(&tmpun64.longVal, p, sizeof(uint64_t));
+            if (ins.swap)
+                tmpun64.longVal = sg_bswap_64(tmpun64.longVal);
+            updateValue(*ins.chunk, tmpun64.doubleVal);
+            break;
+        }
+
+        case OP_INT8:
+            updateValue(*ins.chunk, (int)*(const int8_t*)p);
+            break;
+
+        case OP_INT16: {
+            uint16_t wordVal;
+            memcpy(&wordVal, p, sizeof(uint16_t));
+            if (ins.swap)
+                wordVal = sg_bswap_16(wordVal);
+            updateValue(*ins.chunk, (int)(int16_t)wordVal);
+            break;
+        }
+
+        case OP_STRING:
+            // not supported in binary input, and takes no space
+            break;
+        }
+
+        p += ins.size;
+    }
+}
+
+void FGGenericCodec::decodeAscii(char* line) const
+{
+    const std::string& separator = _layout.varSeparator;
+    const size_t varsep_len = separator.length();
+
+    char* p1 = line;
+    for (const auto& ins : _instructions) {
+        if (!p1)
+            break;
+
+        char* p2 = nullptr;
+        if (varsep_len > 0) {
+            p2 = strstr(p1, separator.c_str());
+            if (p2) {
+                *p2 = 0;
+                p2 += varsep_len;
+            }
+        }
+
+        switch (ins.op) {
+        case OP_INT8:
+        case OP_INT16:
+        case OP_INT32:
+            updateValue(*ins.chunk, atoi(p1));
+            break;
+
+        case OP_BOOL:
+            updateValue(*ins.chunk, atof(p1) != 0.0);
+            break;
+
+        case OP_FIXED32:
+        case OP_FLOAT32:
+            updateValue(*ins.chunk, (float)strtod(p1, 0));
+            break;
+
+        case OP_DOUBLE64:
+            updateValue(*ins.chunk, (double)strtod(p1, 0));
+            break;
+
+        case OP_STRING:
+            ins.prop->setStringValue(p1);
+            break;
+        }
+
+        p1 = p2;
+    }
+}
+
+void FGGenericCodec::updateValue(Chunk& prot, bool val)
+{
+    if (prot.rel) {
+        // value inverted if received true, otherwise leave unchanged
+        if (val)
+            setValue(prot.prop, !getValue<bool>(prot.prop));
+    } else {
+        setValue(prot.prop, val);
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX_FileComment: Precompiled encoder/decoder for generic protocol messages
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <simgear/math/SGMath.hxx>
+#include <simgear/props/props.hxx>
+
+/**
+ * The chunks of one direction of a generic protocol, turned into a flat list
+ * of instructions once, when the channel is opened.
+ *
+ * Each instruction holds everything needed to move its value between the
+ * property tree and the message: the property node, the wire size and
+ * whether bytes are swapped for binary messages, or the format already
+ * sanitised and split into literal text and a single conversion for ASCII
+ * ones. ASCII conversions of the forms the shipped protocols use
+ * (%d, %i, %f, %.Nf, %s, with width, '-' and '0' flags) are written directly;
+ * anything else, and values too close to a rounding tie to be sure of the
+ * last digit, still go through snprintf, so the output doesn't change.
+ */
+class FGGenericCodec
+{
+public:
+    enum Type { FG_BOOL = 0, FG_INT, FG_FLOAT, FG_DOUBLE, FG_STRING, FG_FIXED, FG_BYTE, FG_WORD };
+    enum Footer { FOOTER_NONE, FOOTER_LENGTH, FOOTER_MAGIC };
+
+    /// one <chunk> of the protocol definition
+    struct Chunk {
+        std::string format;
+        Type type;
+        double offset;
+        double factor;
+        double min, max;
+        bool wrap;
+        bool rel;
+        SGPropertyNode_ptr prop;
+    };
+
+    /// how the chunks are framed
+    struct Layout {
+        bool binary = false;
+        bool byteSwap = false; ///< binary values are converted to network order
+        Footer footer = FOOTER_NONE;
+        int footerValue = 0;
+        std::string varSeparator;
+        std::string lineSeparator;
+    };
+
+    /// chunks must stay alive (and unchanged) while the codec is used
+    void compile(std::vector<Chunk>& chunks, const Layout& layout);
+
+    void clear();
+
+    /// Write a message with the current property values to buf, and return
+    /// its length. A message longer than size is truncated.
+    int encode(char* buf, size_t size) const;
+
+    /// Update the properties from a binary message.
+    void decodeBinary(const char* buf, size_t length) const;
+
+    /// Update the properties from a NUL terminated ASCII line, without its
+    /// line separator. The separators in line are overwritten.
+    void decodeAscii(char* line) const;
+
+private:
+    enum Op { OP_BOOL, OP_INT32, OP_FIXED32, OP_FLOAT32, OP_DOUBLE64, OP_INT8, OP_INT16, OP_STRING };
+    enum Conversion { CONV_NONE, CONV_INT, CONV_FIXED_POINT, CONV_STRING };
+
+    struct Instruction {
+        Chunk* chunk = nullptr;
+        SGPropertyNode* prop = nullptr;
+        Op op = OP_INT32;
+        double offset = 0.0;
+        double factor = 1.0;
+        unsigned size = 0; ///< bytes on the wire, 0 for strings
+        bool swap = false;
+
+        // ASCII output
+        std::string format; ///< sanitised, for snprintf
+        std::string prefix;
+        std::string suffix;
+        Conversion conversion = CONV_NONE;
+        bool direct = false; ///< conversion can be written without snprintf
+        bool leftAlign = false;
+        bool zeroPad = false;
+        int width = 0;
+        int precision = -1;
+    };
+
+    int encodeBinary(char* buf, size_t size) const;
+    int encodeAscii(char* buf, size_t size) const;
+
+    static void parseFormat(Instruction& ins);
+
+    template <class T>
+    static void updateValue(Chunk& prot, const T& val)
+    {
+        T new_val = (prot.rel ? getValue<T>(prot.prop) : 0)
+                  + prot.offset
+                  + prot.factor * val;
+
+        if (prot.max > prot.min) {
+            if (prot.wrap)
+                new_val = SGMisc<double>::normalizePeriodic(prot.min, prot.max, new_val);
+            else
+                new_val = SGMisc<T>::clip(new_val, prot.min, prot.max);
+        }
+
+        setValue(prot.prop, new_val);
+    }
+
+    // Special handling for bool (relative change = toggle, no min/max, no wrap)
+    static void updateValue(Chunk& prot, bool val);
+
+    std::vector<Instruction> _instructions;
+    Layout _layout;
+};
@@ -0,0 +1,237 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "SharedMemoryChannel.hxx"
+
+#include <cstring>
+
+#include <simgear/debug/logstream.hxx>
+
+#ifdef HAVE_SHM_OPEN
+#  include <sys/mman.h>         // shm_open() mmap()
+#  include <sys/stat.h>         // fstat()
+#  include <fcntl.h>            // O_* constants
+#  include <unistd.h>           // ftruncate() close()
+#  include <errno.h>
+#endif
+
+FGSharedMemoryChannel::FGSharedMemoryChannel(const std::string& name, uint32_t slotSize, uint32_t slotCount) :
+    _name(name),
+    _slotSize(slotSize),
+    _slotCount(slotCount)
+{
+    if (_name.empty() || _name[0] != '/') {
+        _name = "/" + _name;
+    }
+    // behaves like a datagram socket: whole messages, reads never block
+    set_type(sgSocketType);
+}
+
+FGSharedMemoryChannel::~FGSharedMemoryChannel()
+{
+    close();
+}
+
+bool FGSharedMemoryChannel::isSharedMemory(SGIOChannel* io)
+{
+    return dynamic_cast<FGSharedMemoryChannel*>(io) != nullptr;
+}
+
+#ifdef HAVE_SHM_OPEN
+
+bool FGSharedMemoryChannel::open(const SGProtocolDir d)
+{
+    _dir = d;
+    if (d == SG_IO_IN) {
+        // the writer may come later, read() keeps trying
+        if (!attach()) {
+            SG_LOG(SG_IO, SG_INFO, "Shared memory " << _name << " doesn't exist yet, waiting for the writer");
+        }
+        return true;
+    }
+
+    if (d != SG_IO_OUT) {
+        SG_LOG(SG_IO, SG_ALERT, "Shared memory channels are one way, use in or out: " << _name);
+        return false;
+    }
+
+    _fd = shm_open(_name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (_fd < 0) {
+        SG_LOG(SG_IO, SG_ALERT, "Error creating shared memory " << _name << ": " << strerror(errno));
+        return false;
+    }
+
+    _size = flightgear::SharedMemoryRing::segmentSize(_slotCount, _slotSize);
+    struct stat st;
+    if (fstat(_fd, &st) == 0 && st.st_size > 0 && static_cast<size_t>(st.st_size) != _size) {
+        // left by a writer with other sizes: replace it, and tell its
+        // readers to attach to the new one
+        void* old = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+        if (old != MAP_FAILED) {
+            if (static_cast<size_t>(st.st_size) >= sizeof(flightgear::SharedMemoryRing::Header)) {
+                flightgear::SharedMemoryRing(old).retire();
+            }
+            munmap(old, st.st_size);
+        }
+        ::close(_fd);
+        shm_unlink(_name.c_str());
+        _fd = shm_open(_name.c_str(), O_CREAT | O_RDWR, 0644);
+        if (_fd < 0) {
+            SG_LOG(SG_IO, SG_ALERT, "Error creating shared memory " << _name << ": " << strerror(errno));
+            return false;
+        }
+        st.st_size = 0;
+    }
+
+    if (static_cast<size_t>(st.st_size) != _size) {
+        if (ftruncate(_fd, _size) != 0) {
+            SG_LOG(SG_IO, SG_ALERT, "Error sizing shared memory " << _name << ": " << strerror(errno));
+            close();
+            return false;
+        }
+    }
+
+    _base = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    if (_base == MAP_FAILED) {
+        SG_LOG(SG_IO, SG_ALERT, "Error mapping shared memory " << _name << ": " << strerror(errno));
+        _base = nullptr;
+        close();
+        return false;
+    }
+
+    _ring = flightgear::SharedMemoryRing(_base);
+    _ring.create(_slotCount, _slotSize);
+    return true;
+}
+
+bool FGSharedMemoryChannel::attach()
+{
+    if (_base) {
+        return true;
+    }
+
+    if (_fd < 0) {
+        _fd = shm_open(_name.c_str(), O_RDONLY, 0);
+        if (_fd < 0) {
+            return false;
+        }
+    }
+
+    // the writer may still be setting it up
+    struct stat st;
+    if (fstat(_fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(flightgear::SharedMemoryRing::Header)) {
+        return false;
+    }
+
+    void* base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, _fd, 0);
+    if (base == MAP_FAILED) {
+        SG_LOG(SG_IO, SG_WARN, "Error mapping shared memory " << _name << ": " << strerror(errno));
+        return false;
+    }
+
+    flightgear::SharedMemoryRing ring(base);
+    if (!ring.valid() ||
+        static_cast<size_t>(st.st_size) < flightgear::SharedMemoryRing::segmentSize(ring.slotCount(), ring.slotSize())) {
+        munmap(base, st.st_size);
+        return false;
+    }
+
+    _base = base;
+    _size = st.st_size;
+    _ring = ring;
+    _lastRead = 0;
+    SG_LOG(SG_IO, SG_INFO, "Attached to shared memory " << _name);
+    return true;
+}
+
+int FGSharedMemoryChannel::read(char* buf, int length)
+{
+    if (_dir != SG_IO_IN || length <= 0) {
+        return 0;
+    }
+    if (_base && !_ring.valid()) {
+        close(); // retired by the writer
+    }
+    if (!attach()) {
+        return 0;
+    }
+    return static_cast<int>(_ring.read(buf, length, _lastRead));
+}
+
+// The segment is deliberately not unlinked, also not by the writer: readers
+// keep the last message and carry on when a writer starts again. It stays in
+// /dev/shm until removed by hand, or replaced by a writer of another size.
+bool FGSharedMemoryChannel::close()
+{
+    if (_base) {
+        munmap(_base, _size);
+        _base = nullptr;
+        _size = 0;
+    }
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+    _ring = flightgear::SharedMemoryRing();
+    return true;
+}
+
+#else // of HAVE_SHM_OPEN
+
+bool FGSharedMemoryChannel::open(const SGProtocolDir d)
+{
+    SG_LOG(SG_IO, SG_ALERT, "Shared memory channels are not supported on this platform");
+    return false;
+}
+
+bool FGSharedMemoryChannel::attach()
+{
+    return false;
+}
+
+int FGSharedMemoryChannel::read(char* buf, int length)
+{
+    return 0;
+}
+
+// The segment is deliberately not unlinked, also not by the writer: readers
+// keep the last message and carry on when a writer starts again. It stays in
+// /dev/shm until removed by hand, or replaced by a writer of another size.
+bool FGSharedMemoryChannel::close()
+{
+    return true;
+}
+
+#endif
+
+int FGSharedMemoryChannel::readline(char* buf, int length)
+{
+    // every message is a record
+    const int n = read(buf, length - 1);
+    if (n >= 0 && length > 0) {
+        buf[n] = 0;
+    }
+    return n;
+}
+
+int FGSharedMemoryChannel::write(const char* buf, const int length)
+{
+    if (_dir != SG_IO_OUT || !_base || length < 0) {
+        return 0;
+    }
+
+    if (!_ring.write(buf, length)) {
+        SG_LOG(SG_IO, SG_ALERT, "Message of " << length << " bytes too big for shared memory " << _name);
+        return 0;
+    }
+    return length;
+}
+
+int FGSharedMemoryChannel::writestring(const char* str)
+{
+    return write(str, strlen(str));
+}
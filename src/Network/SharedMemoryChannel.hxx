@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX_FileComment: I/O channel to other processes on the same machine thru shared memory
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <simgear/io/iochannel.hxx>
+
+#include "SharedMemoryRing.hxx"
+
+/**
+ * An I/O channel to processes on the same machine, thru a POSIX shared memory
+ * segment holding a SharedMemoryRing.
+ *
+ * The output side creates the segment and every write() publishes one
+ * message. Input sides attach to it (once it exists) and read() returns the
+ * latest message, or nothing if that was read before; older messages are
+ * skipped. So, like a datagram socket, it passes whole messages and never
+ * blocks, but a message is a memory copy instead of a round trip thru the
+ * network stack.
+ *
+ * Messages keep the byte order of the machine, native-fdm and native-ctrls
+ * skip their conversion to network order on this channel.
+ *
+ * The segment stays after the writer closes it, on purpose: readers see the
+ * last message and reattach when a writer starts again, taking it over. It
+ * is never unlinked by fgfs, remove /dev/shm/<name> to get rid of it.
+ * Needs shm_open(), so not available on Windows.
+ */
+class FGSharedMemoryChannel : public SGIOChannel
+{
+public:
+    /// @param name of the segment, with or without the leading '/'
+    explicit FGSharedMemoryChannel(const std::string& name, uint32_t slotSize = 16384, uint32_t slotCount = 8);
+    ~FGSharedMemoryChannel();
+
+    bool open(const SGProtocolDir d) override;
+    int read(char* buf, int length) override;
+    int readline(char* buf, int length) override;
+    int write(const char* buf, const int length) override;
+    int writestring(const char* str) override;
+    bool close() override;
+
+    /// whether messages on io may stay in host byte order
+    static bool isSharedMemory(SGIOChannel* io);
+
+private:
+    bool attach();
+
+    std::string _name;
+    uint32_t _slotSize;
+    uint32_t _slotCount;
+    SGProtocolDir _dir = SG_IO_NONE;
+
+    int _fd = -1;
+    void* _base = nullptr;
+    size_t _size = 0;
+    flightgear::SharedMemoryRing _ring;
+    uint64_t _lastRead = 0;
+};
@@ -0,0 +1,184 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX_FileComment: Seqlock message ring for one writer and any number of readers
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Only standard headers on purpose: the processes at the other end of a
+// shared memory channel can include this to read (or write) the segment.
+
+namespace flightgear
+{
+
+/**
+ * The layout of a shared memory segment passing messages from one writer to
+ * readers in other processes, and the protocol for using it.
+ *
+ * The segment is a header followed by a ring of slots. The writer puts each
+ * message into the next slot and then publishes its number. A reader only
+ * ever looks at the latest message: it copies the slot and checks the slot's
+ * sequence number before and after, like a seqlock. The writer never waits
+ * for readers, and a reader only retries when the writer has come round the
+ * whole ring while it was copying, so with a few slots it doesn't wait either.
+ * Readers give up after a few retries, so a writer that stopped halfway thru
+ * a message can't keep them spinning.
+ *
+ * Messages are passed as they are: structs keep the byte order of the
+ * machine, which all processes using the segment share.
+ */
+class SharedMemoryRing
+{
+public:
+    static const uint32_t MAGIC = 0x46475352; // "FGSR"
+    static const uint32_t VERSION = 1;
+    static const size_t CACHE_LINE = 64;
+    static const int READ_ATTEMPTS = 4;
+
+    struct alignas(CACHE_LINE) Header {
+        std::atomic<uint32_t> magic; ///< set last, once the rest is valid
+        uint32_t version;
+        uint32_t slotCount;
+        uint32_t slotSize;             ///< payload bytes per slot
+        std::atomic<uint64_t> published; ///< messages written; the latest is number published
+    };
+
+    struct alignas(CACHE_LINE) Slot {
+        std::atomic<uint64_t> sequence; ///< 2n once message n is complete, odd while writing
+        std::atomic<uint32_t> length;
+        // the payload follows, at the next cache line
+    };
+
+    /// bytes needed for a segment
+    static size_t segmentSize(uint32_t slotCount, uint32_t slotSize)
+    {
+        return sizeof(Header) + slotCount * slotStride(slotSize);
+    }
+
+    /// use the segment at base, which must stay mapped
+    explicit SharedMemoryRing(void* base = nullptr) : _header(static_cast<Header*>(base)) {}
+
+    /**
+     * Writer: set up the segment. A segment left by a previous writer with
+     * the same geometry is taken over, so its readers carry on.
+     */
+    void create(uint32_t slotCount, uint32_t slotSize)
+    {
+        if (valid() && _header->slotCount == slotCount && _header->slotSize == slotSize) {
+            return;
+        }
+
+        _header->magic.store(0, std::memory_order_relaxed);
+        _header->version = VERSION;
+        _header->slotCount = slotCount;
+        _header->slotSize = slotSize;
+        _header->published.store(0, std::memory_order_relaxed);
+        for (uint32_t i = 0; i < slotCount; ++i) {
+            slot(i)->sequence.store(0, std::memory_order_relaxed);
+            slot(i)->length.store(0, std::memory_order_relaxed);
+        }
+        _header->magic.store(MAGIC, std::memory_order_release);
+    }
+
+    /// Writer: tell readers to let go of the segment, before removing it
+    void retire()
+    {
+        _header->magic.store(0, std::memory_order_release);
+    }
+
+    /// whether the segment has been set up by a writer, and not retired
+    bool valid() const
+    {
+        return _header && _header->magic.load(std::memory_order_acquire) == MAGIC &&
+               _header->version == VERSION;
+    }
+
+    uint32_t slotCount() const { return _header->slotCount; }
+    uint32_t slotSize() const { return _header->slotSize; }
+
+    /// Writer: publish a message of at most slotSize() bytes
+    bool write(const void* data, uint32_t length)
+    {
+        if (length > _header->slotSize) {
+            return false;
+        }
+
+        const uint64_t n = _header->published.load(std::memory_order_relaxed) + 1;
+        Slot* s = slot((n - 1) % _header->slotCount);
+
+        s->sequence.store(2 * n - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(payload(s), data, length);
+        s->length.store(length, std::memory_order_relaxed);
+        s->sequence.store(2 * n, std::memory_order_release);
+
+        _header->published.store(n, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Reader: copy the latest message, if it isn't the one read last time.
+     * @param buf receives at most length bytes of the message
+     * @param last the number of the message read last time, updated
+     * @return bytes copied, 0 if there is no new message
+     *
+     * A writer that is slow, or died halfway thru a message, leaves the
+     * latest slot odd: after READ_ATTEMPTS tries this returns 0 as if there
+     * was nothing new, and the next poll tries again.
+     */
+    uint32_t read(void* buf, uint32_t length, uint64_t& last) const
+    {
+        for (int attempt = 0; attempt < READ_ATTEMPTS; ++attempt) {
+            const uint64_t n = _header->published.load(std::memory_order_acquire);
+            if (n == last || n == 0) {
+                return 0;
+            }
+
+            const Slot* s = slot((n - 1) % _header->slotCount);
+            const uint64_t before = s->sequence.load(std::memory_order_acquire);
+            if (before != 2 * n) {
+                continue; // already being overwritten, there is a newer one
+            }
+
+            uint32_t copied = s->length.load(std::memory_order_relaxed);
+            if (copied > length) {
+                copied = length;
+            }
+            std::memcpy(buf, payload(s), copied);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s->sequence.load(std::memory_order_relaxed) == before) {
+                last = n;
+                return copied;
+            }
+        }
+        return 0;
+    }
+
+private:
+    static size_t slotStride(uint32_t slotSize)
+    {
+        return sizeof(Slot) + (slotSize + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    }
+
+    Slot* slot(uint32_t i) const
+    {
+        char* first = reinterpret_cast<char*>(_header) + sizeof(Header);
+        return reinterpret_cast<Slot*>(first + i * slotStride(_header->slotSize));
+    }
+
+    static char* payload(const Slot* s)
+    {
+        return reinterpret_cast<char*>(const_cast<Slot*>(s)) + sizeof(Slot);
+    }
+
+    Header* _header;
+};
+
+} // namespace flightgear
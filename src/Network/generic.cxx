@@ -255,317 +255,18 @@ FGGeneric::~FGGeneric() {
   delete wrapper;
 }
 
-union u32 {
-    uint32_t intVal;
-    float floatVal;
-};
-
-union u64 {
-    uint64_t longVal;
-    double doubleVal;
-};
-
 // generate the message
-bool FGGeneric::gen_message_binary() {
-    string generic_sentence;
-    length = 0;
-
-    double val;
-    for (unsigned int i = 0; i < _out_message.size(); i++) {
-
-        switch (_out_message[i].type) {
-        case FG_INT:
-        {
-            val = _out_message[i].offset +
-                  _out_message[i].prop->getFloatValue() * _out_message[i].factor;
-            int32_t intVal = val;
-            if (binary_byte_order != BYTE_ORDER_MATCHES_NETWORK_ORDER) {
-                intVal = (int32_t) sg_bswap_32((uint32_t)intVal);
-            }
-            memcpy(&buf[length], &intVal, sizeof(int32_t));
-            length += sizeof(int32_t);
-            break;
-        }
-
-        case FG_BOOL:
-            buf[length] = (char) (_out_message[i].prop->getBoolValue() ? true : false);
-            length += 1;
-            break;
-
-        case FG_FIXED:
-        {
-            val = _out_message[i].offset +
-                 _out_message[i].prop->getFloatValue() * _out_message[i].factor;
-
-            int32_t fixed = (int)(val * 65536.0f);
-            if (binary_byte_order != BYTE_ORDER_MATCHES_NETWORK_ORDER) {
-                fixed = (int32_t) sg_bswap_32((uint32_t)fixed);
-            } 
-            memcpy(&buf[length], &fixed, sizeof(int32_t));
-            length += sizeof(int32_t);
-            break;
-        }
-
-        case FG_FLOAT:
-        {
-            val = _out_message[i].offset +
-                 _out_message[i].prop->getFloatValue() * _out_message[i].factor;
-            u32 tmpun32;
-            tmpun32.floatVal = static_cast<float>(val);
-
-            if (binary_byte_order != BYTE_ORDER_MATCHES_NETWORK_ORDER) {
-                tmpun32.intVal = sg_bswap_32(tmpun32.intVal);
-            }
-            memcpy(&buf[length], &tmpun32.intVal, sizeof(uint32_t));
-            length += sizeof(uint32_t);
-            break;
-        }
-
-        case FG_DOUBLE:
-        {
-            val = _out_message[i].offset +
-                 _out_message[i].prop->getDoubleValue() * _out_message[i].factor;
-            u64 tmpun64;
-            tmpun64.doubleVal = val;
-
-            if (binary_byte_order != BYTE_ORDER_MATCHES_NETWORK_ORDER) {
-                tmpun64.longVal = sg_bswap_64(tmpun64.longVal);
-            }
-            memcpy(&buf[length], &tmpun64.longVal, sizeof(uint64_t));
-            length += sizeof(uint64_t);
-            break;
-        }
-
-        case FG_BYTE:
-        {
-            val = _out_message[i].offset +
-                  _out_message[i].prop->getFloatValue() * _out_message[i].factor;
-            int8_t byteVal = val;
-            memcpy(&buf[length], &byteVal, sizeof(int8_t));
-            length += sizeof(int8_t);
-            break;
-        }
-
-        case FG_WORD:
-        {
-            val = _out_message[i].offset +
-                  _out_message[i].prop->getFloatValue() * _out_message[i].factor;
-            int16_t wordVal = val;
-            memcpy(&buf[length], &wordVal, sizeof(int16_t));
-            length += sizeof(int16_t);
-            break;
-        }
-
-        default: // SG_STRING
-            string strdata = _out_message[i].prop->getStringValue();
-            size_t strlength = strdata.length();
-
-            if (binary_byte_order == BYTE_ORDER_NEEDS_CONVERSION) {
-                SG_LOG( SG_IO, SG_ALERT, "Generic protocol: "
-                        "FG_STRING will be written in host byte order.");
-            }
-            /* Format for strings is 
-             * [length as int, 4 bytes][ASCII data, length bytes]
-             */
-            if (binary_byte_order != BYTE_ORDER_MATCHES_NETWORK_ORDER) {
-                strlength = sg_bswap_32(strlength);
-            }
-            memcpy(&buf[length], &strlength, sizeof(int32_t));
-            length += sizeof(int32_t);
-            strncpy(&buf[length], strdata.c_str(), strlength);
-            length += strlength; 
-            /* FIXME padding for alignment? Something like: 
-             * length += (strlength % 4 > 0 ? sizeof(int32_t) - strlength % 4 : 0;
-             */
-            break;
-
-        }
-    }
-
-    // add the footer to the packet ("line")
-    switch (binary_footer_type) {
-        case FOOTER_LENGTH:
-            binary_footer_value = length;
-            break;
-
-        case FOOTER_MAGIC:
-        case FOOTER_NONE:
-            break;
-    }
-
-    if (binary_footer_type != FOOTER_NONE) {
-        int32_t intValue = binary_footer_value;
-        if (binary_byte_order != BYTE_ORDER_MATCHES_NETWORK_ORDER) {
-            intValue = sg_bswap_32(binary_footer_value);
-        }
-        memcpy(&buf[length], &intValue, sizeof(int32_t));
-        length += sizeof(int32_t);
-    }
-
-    if( wrapper ) length = wrapper->wrap( length, reinterpret_cast<uint8_t*>(buf) );
-
-    return true;
-}
-
-bool FGGeneric::gen_message_ascii() {
-    string generic_sentence;
-    char tmp[255];
-    length = 0;
-
-    double val;
-    for (unsigned int i = 0; i < _out_message.size(); i++) {
-
-        if (i > 0) {
-            generic_sentence += var_separator;
-        }
-        
-        string format = simgear::strutils::sanitizePrintfFormat(_out_message[i].format);
-
-        switch (_out_message[i].type) {
-        case FG_BYTE:
-        case FG_WORD:
-        case FG_INT:
-            val = _out_message[i].offset +
-                  _out_message[i].prop->getFloatValue() * _out_message[i].factor;
-            snprintf(tmp, 255, format.c_str(), (int)val);
-            break;
-
-        case FG_BOOL:
-            snprintf(tmp, 255, format.c_str(),
-                               _out_message[i].prop->getBoolValue());
-            break;
-
-        case FG_FIXED:
-            val = _out_message[i].offset +
-                _out_message[i].prop->getFloatValue() * _out_message[i].factor;
-            snprintf(tmp, 255, format.c_str(), (float)val);
-            break;
-
-        case FG_FLOAT:
-            val = _out_message[i].offset +
-                _out_message[i].prop->getFloatValue() * _out_message[i].factor;
-            snprintf(tmp, 255, format.c_str(), (float)val);
-            break;
-
-        case FG_DOUBLE:
-            val = _out_message[i].offset +
-                _out_message[i].prop->getDoubleValue() * _out_message[i].factor;
-            snprintf(tmp, 255, format.c_str(), (double)val);
-            break;
-
-        default: // SG_STRING
-            snprintf(tmp, 255, format.c_str(),
-                                   _out_message[i].prop->getStringValue().c_str());
-        }
-
-        generic_sentence += tmp;
-    }
-
-    /* After each lot of variables has been added, put the line separator
-     * char/string
-     */
-    generic_sentence += line_separator;
-
-    length =  generic_sentence.length();
-    strncpy( buf, generic_sentence.c_str(), length );
-
-    return true;
-}
-
 bool FGGeneric::gen_message() {
-    if (binary_mode) {
-        return gen_message_binary();
-    } else {
-        return gen_message_ascii();
-    }
-}
-
-bool FGGeneric::parse_message_binary(int length) {
-    char *p2, *p1 = buf;
-    int32_t tmp32;
-    int i = -1;
+    // leave room for the wrapper to escape every byte
+    const size_t size = wrapper ? (FG_MAX_MSG_SIZE - 4) / 2 : FG_MAX_MSG_SIZE;
+    length = _out_codec.encode(buf, size);
 
-    p2 = p1 + length;
-    while ((++i < (int)_in_message.size()) && (p1  < p2)) {
+    if( binary_mode && wrapper ) length = wrapper->wrap( length, reinterpret_cast<uint8_t*>(buf) );
 
-        switch (_in_message[i].type) {
-        case FG_INT:
-            if (binary_byte_order == BYTE_ORDER_NEEDS_CONVERSION) {
-                tmp32 = sg_bswap_32(*(int32_t *)p1);
-            } else {
-                tmp32 = *(int32_t *)p1;
-            }
-            updateValue(_in_message[i], (int)tmp32);
-            p1 += sizeof(int32_t);
-            break;
-
-        case FG_BOOL:
-            updateValue(_in_message[i], p1[0] != 0);
-            p1 += 1;
-            break;
-
-        case FG_FIXED:
-            if (binary_byte_order == BYTE_ORDER_NEEDS_CONVERSION) {
-                tmp32 = sg_bswap_32(*(int32_t *)p1);
-            } else {
-                tmp32 = *(int32_t *)p1;
-            }
-            updateValue(_in_message[i], (float)tmp32 / 65536.0f);
-            p1 += sizeof(int32_t);
-            break;
-
-        case FG_FLOAT:
-            u32 tmpun32;
-            if (binary_byte_order == BYTE_ORDER_NEEDS_CONVERSION) {
-                tmpun32.intVal = sg_bswap_32(*(uint32_t *)p1);
-            } else {
-                tmpun32.floatVal = *(float *)p1;
-            }
-            updateValue(_in_message[i], tmpun32.floatVal);
-            p1 += sizeof(int32_t);
-            break;
-
-        case FG_DOUBLE:
-            u64 tmpun64;
-            if (binary_byte_order == BYTE_ORDER_NEEDS_CONVERSION) {
-                tmpun64.longVal = sg_bswap_64(*(uint64_t *)p1);
-            } else {
-                tmpun64.doubleVal = *(double *)p1;
-            }
-            updateValue(_in_message[i], tmpun64.doubleVal);
-            p1 += sizeof(int64_t);
-            break;
-
-        case FG_BYTE:
-            tmp32 = *(int8_t *)p1;
-            updateValue(_in_message[i], (int)tmp32);
-            p1 += sizeof(int8_t);
-            break;
-
-        case FG_WORD:
-            if (binary_byte_order == BYTE_ORDER_NEEDS_CONVERSION) {
-                tmp32 = sg_bswap_16(*(int16_t *)p1);
-            } else {
-                tmp32 = *(int16_t *)p1;
-            }
-            updateValue(_in_message[i], (int)tmp32);
-            p1 += sizeof(int16_t);
-            break;
-
-        default: // SG_STRING
-            SG_LOG( SG_IO, SG_ALERT, "Generic protocol: "
-                    "Ignoring unsupported binary input chunk type.");
-            break;
-        }
-    }
-    
     return true;
 }
 
 bool FGGeneric::parse_message_ascii(int length) {
-    char *p1 = buf;
-    int i = -1;
-    int chunks = _in_message.size();
     int line_separator_size = line_separator.size();
 
     if (length < line_separator_size ||
@@ -577,53 +278,14 @@ bool FGGeneric::parse_message_ascii(int length) {
         buf[length - line_separator_size] = 0;
     }
 
-    size_t varsep_len = var_separator.length();
-    while ((++i < chunks) && p1) {
-        char* p2 = NULL;
-
-        if (varsep_len > 0)
-        {
-            p2 = strstr(p1, var_separator.c_str());
-            if (p2) {
-                *p2 = 0;
-                p2 += varsep_len;
-            }
-        }
-
-        switch (_in_message[i].type) {
-        case FG_BYTE:
-        case FG_WORD:
-        case FG_INT:
-            updateValue(_in_message[i], atoi(p1));
-            break;
-
-        case FG_BOOL:
-            updateValue(_in_message[i], atof(p1) != 0.0);
-            break;
-
-        case FG_FIXED:
-        case FG_FLOAT:
-            updateValue(_in_message[i], (float)strtod(p1, 0));
-            break;
-
-        case FG_DOUBLE:
-            updateValue(_in_message[i], (double)strtod(p1, 0));
-            break;
-
-        default: // SG_STRING
-            _in_message[i].prop->setStringValue(p1);
-            break;
-        }
-
-        p1 = p2;
-    }
-
+    _in_codec.decodeAscii(buf);
     return true;
 }
 
 bool FGGeneric::parse_message_len(int length) {
     if (binary_mode) {
-        return parse_message_binary(length);
+        _in_codec.decodeBinary(buf, length);
+        return true;
     } else {
         return parse_message_ascii(length);
     }
@@ -646,6 +308,7 @@ bool FGGeneric::open() {
     }
 
     set_enabled( true );
+    compile();
 
     if ( ((get_direction() == SG_IO_OUT )||
           (get_direction() == SG_IO_BI))
@@ -669,7 +332,7 @@ bool FGGeneric::process() {
         gen_message();
         if ( ! io->write( buf, length ) ) {
             SG_LOG( SG_IO, SG_WARN, "Error writing data." );
-            goto error_out;
+            return write_failed();
         }
     }
 
@@ -718,7 +381,11 @@ bool FGGeneric::process() {
         }
     }
     return true;
-error_out:
+}
+
+
+// a message couldn't be written, by process() or by the I/O thread
+bool FGGeneric::write_failed() {
     if (exitOnError) {
         fgOSExit(1);
         return true; // should not get there, but please the compiler
@@ -727,6 +394,43 @@ error_out:
 }
 
 
+// read one record, on the I/O thread
+int FGGeneric::read_record(char *record, int size) {
+    SGIOChannel *io = get_io_channel();
+
+    if (!binary_mode) {
+        return io->readline( record, size );
+    }
+
+    if ( binary_record_length > size ) {
+        return 0;
+    }
+
+    int len = io->read( record, binary_record_length );
+    if ( len > 0 && len != binary_record_length ) {
+        SG_LOG( SG_IO, SG_ALERT,
+                "Generic protocol: Received binary "
+                "record of unexpected size, expected: "
+                << binary_record_length << " but received: "
+                << len);
+        return 0;
+    }
+    return len;
+}
+
+
+// apply a record the I/O thread has read
+bool FGGeneric::parse_record(char *record, int len) {
+    if ( len <= 0 || len >= FG_MAX_MSG_SIZE ) {
+        return false;
+    }
+
+    memcpy( buf, record, len );
+    buf[len] = 0;
+    return parse_message_len( len );
+}
+
+
 // close the channel
 bool FGGeneric::close() {
     SGIOChannel *io = get_io_channel();
@@ -741,6 +445,8 @@ bool FGGeneric::close() {
     }
 
     set_enabled( false );
+    _out_codec.clear();
+    _in_codec.clear();
 
     if ( ! io->close() ) {
         return false;
@@ -770,6 +476,10 @@ FGGeneric::reinit()
          return;
     }
 
+    // the codecs point into the chunk lists
+    _out_codec.clear();
+    _in_codec.clear();
+
     const auto dir = get_direction();
     if ((dir == SG_IO_OUT) || (dir == SG_IO_BI)) {
         SGPropertyNode *output = root.getNode("generic/output");
@@ -803,6 +513,39 @@ FGGeneric::reinit()
     }
 
     initOk = true;
+
+    if (is_enabled()) {
+        compile();
+    }
+}
+
+
+// turn the chunks into the instruction lists used for every message
+void
+FGGeneric::compile()
+{
+    FGGenericCodec::Layout layout;
+    layout.binary = binary_mode;
+    if (binary_mode) {
+        layout.byteSwap = binary_byte_order == BYTE_ORDER_NEEDS_CONVERSION;
+        layout.footer = binary_footer_type;
+        layout.footerValue = binary_footer_value;
+    }
+    layout.varSeparator = var_separator;
+    layout.lineSeparator = line_separator;
+
+    _out_codec.compile(_out_message, layout);
+    _in_codec.compile(_in_message, layout);
+
+    if (binary_mode) {
+        for (const auto& chunk : _in_message) {
+            if (chunk.type == FGGenericCodec::FG_STRING) {
+                SG_LOG( SG_IO, SG_ALERT, "Generic protocol: "
+                        "Ignoring unsupported binary input chunk type.");
+                break;
+            }
+        }
+    }
 }
 
 
@@ -857,7 +600,7 @@ FGGeneric::read_config(SGPropertyNode *root, vector<_serial_prot> &msg)
         }
     } else {
         // default values: no footer and record_length = sizeof(representation)
-        binary_footer_type = FOOTER_NONE;
+        binary_footer_type = FGGenericCodec::FOOTER_NONE;
         binary_record_length = -1;
 
         // default choice is network byte order (big endian)
@@ -870,9 +613,9 @@ FGGeneric::read_config(SGPropertyNode *root, vector<_serial_prot> &msg)
         if ( root->hasValue("binary_footer") ) {
             string footer_type = root->getStringValue("binary_footer");
             if ( footer_type == "length" ) {
-                binary_footer_type = FOOTER_LENGTH;
+                binary_footer_type = FGGenericCodec::FOOTER_LENGTH;
             } else if ( footer_type.substr(0, 5) == "magic" ) {
-                binary_footer_type = FOOTER_MAGIC;
+                binary_footer_type = FGGenericCodec::FOOTER_MAGIC;
                 binary_footer_value = strtol(footer_type.substr(6, 
                             footer_type.length() - 6).c_str(), (char**)0, 0);
             } else if ( footer_type != "none" ) {
@@ -941,27 +684,27 @@ FGGeneric::read_config(SGPropertyNode *root, vector<_serial_prot> &msg)
         // Note: officially the type is called 'bool' but for backward
         //       compatibility 'boolean' will also be supported.
         if (type == "bool" || type == "boolean") {
-            chunk.type = FG_BOOL;
+            chunk.type = FGGenericCodec::FG_BOOL;
             record_length += 1;
         } else if (type == "float") {
-            chunk.type = FG_FLOAT;
+            chunk.type = FGGenericCodec::FG_FLOAT;
             record_length += sizeof(int32_t);
         } else if (type == "double") {
-            chunk.type = FG_DOUBLE;
+            chunk.type = FGGenericCodec::FG_DOUBLE;
             record_length += sizeof(int64_t);
         } else if (type == "fixed") {
-            chunk.type = FG_FIXED;
+            chunk.type = FGGenericCodec::FG_FIXED;
             record_length += sizeof(int32_t);
         } else if (type == "string") {
-            chunk.type = FG_STRING;
+            chunk.type = FGGenericCodec::FG_STRING;
         } else if (type == "byte") {
-            chunk.type = FG_BYTE;
+            chunk.type = FGGenericCodec::FG_BYTE;
             record_length += sizeof(int8_t);
         } else if (type == "word") {
-            chunk.type = FG_WORD;
+            chunk.type = FGGenericCodec::FG_WORD;
             record_length += sizeof(int16_t);
         } else {
-            chunk.type = FG_INT;
+            chunk.type = FGGenericCodec::FG_INT;
             record_length += sizeof(int32_t);
         }
         msg.push_back(chunk);
@@ -993,17 +736,3 @@ FGGeneric::read_config(SGPropertyNode *root, vector<_serial_prot> &msg)
 
     return true;
 }
-
-void FGGeneric::updateValue(FGGeneric::_serial_prot& prot, bool val)
-{
-  if( prot.rel )
-  {
-    // value inverted if received true, otherwise leave unchanged
-    if( val )
-      setValue(prot.prop, !getValue<bool>(prot.prop));
-  }
-  else
-  {
-    setValue(prot.prop, val);
-  }
-}
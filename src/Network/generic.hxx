@@ -27,6 +27,7 @@
 #include <string>
 
 #include "protocol.hxx"
+#include "GenericCodec.hxx"
 
 
 class FGGeneric : public FGProtocol {
@@ -50,24 +51,19 @@ public:
     // close the channel
     bool close();
 
+    // I/O thread support
+    bool supports_io_thread() const override { return true; }
+    int read_record(char *record, int size) override;
+    const char *get_message(int& len) const override { len = length; return buf; }
+    bool parse_record(char *record, int len) override;
+    bool write_failed() override;
+
     void setExitOnError(bool val) { exitOnError = val; }
     bool getExitOnError() { return exitOnError; }
     bool getInitOk(void) { return initOk; }
 protected:
 
-    enum e_type { FG_BOOL=0, FG_INT, FG_FLOAT, FG_DOUBLE, FG_STRING, FG_FIXED, FG_BYTE, FG_WORD };
-
-    typedef struct {
-     // std::string name;
-        std::string format;
-        e_type type;
-        double offset;
-        double factor;
-        double min, max;
-        bool wrap;
-        bool rel;
-        SGPropertyNode_ptr prop;
-    } _serial_prot;
+    typedef FGGenericCodec::Chunk _serial_prot;
 
 private:
 
@@ -85,40 +81,21 @@ private:
     vector<_serial_prot> _out_message;
     vector<_serial_prot> _in_message;
 
+    // compiled by open()
+    FGGenericCodec _out_codec;
+    FGGenericCodec _in_codec;
+
     bool binary_mode;
-    enum {FOOTER_NONE, FOOTER_LENGTH, FOOTER_MAGIC} binary_footer_type;
+    FGGenericCodec::Footer binary_footer_type;
     int binary_footer_value;
     int binary_record_length;
     enum {BYTE_ORDER_NEEDS_CONVERSION, BYTE_ORDER_MATCHES_NETWORK_ORDER} binary_byte_order;
 
-    bool gen_message_ascii();
-    bool gen_message_binary();
     bool parse_message_ascii(int length);
-    bool parse_message_binary(int length);
+    void compile();
     bool read_config(SGPropertyNode *root, vector<_serial_prot> &msg);
     bool exitOnError;
     bool initOk;
 
     class FGProtocolWrapper * wrapper;
-    
-    template<class T>
-    static void updateValue(_serial_prot& prot, const T& val)
-    {
-      T new_val = (prot.rel ? getValue<T>(prot.prop) : 0)
-                + prot.offset
-                + prot.factor * val;
-                
-      if( prot.max > prot.min )
-      {
-        if( prot.wrap )
-          new_val = SGMisc<double>::normalizePeriodic(prot.min, prot.max, new_val);
-        else
-          new_val = SGMisc<T>::clip(new_val, prot.min, prot.max);
-      }
-
-      setValue(prot.prop, new_val);
-    }
-    
-    // Special handling for bool (relative change = toggle, no min/max, no wrap)
-    static void updateValue(_serial_prot& prot, bool val);
 };
@@ -28,6 +28,20 @@ using std::string;
 namespace flightgear {
 namespace http {
 
+// a tree dump in progress
+class JsonDump : public ConnectionData {
+public:
+  JsonDump( SGPropertyNode_ptr node, int depth, bool indent, double timestamp ) :
+    writer( node, depth, indent, timestamp ) {}
+
+  PropertyJsonWriter writer;
+};
+
+const static string KEY_JSONDUMP("JsonUriHandler::JsonDump");
+
+// bytes of json written per request or poll
+const static size_t CHUNK_SIZE = 64 * 1024;
+
 bool JsonUriHandler::handleRequest( const HTTPRequest & request, HTTPResponse & response, Connection * connection )
 {
   response.Header["Content-Type"] = "application/json; charset=UTF-8";
@@ -56,14 +70,17 @@ bool JsonUriHandler::handleRequest( const HTTPRequest & request, HTTPResponse &
       return true;
     } 
 
-    response.Content = JSON::toJsonString( indent, node, depth, timestamp ? fgGetDouble("/sim/time/elapsed-sec") : -1.0 );
-
-#define MAX_STR_SIZE 50000
-    if (response.Content.size() < MAX_STR_SIZE) {
-        return true;
-    } else {
-        return false;
+    SGSharedPtr<JsonDump> dump = new JsonDump( node, depth, indent, timestamp ? fgGetDouble("/sim/time/elapsed-sec") : -1.0 );
+    if( NULL == connection ) {
+      dump->writer.write( response.Content );
+      return true;
     }
+    if( dump->writer.write( response.Content, CHUNK_SIZE ) )
+      return true;
+
+    // big tree: send it chunked, one piece per frame thru poll()
+    connection->put( KEY_JSONDUMP, dump );
+    return false;
   }
 
   if( request.Method == "POST" ) {
@@ -93,6 +110,25 @@ bool JsonUriHandler::handleRequest( const HTTPRequest & request, HTTPResponse &
 
 }
 
+bool JsonUriHandler::poll( Connection * connection )
+{
+  SGSharedPtr<ConnectionData> data = connection->get(KEY_JSONDUMP);
+  JsonDump * dump = dynamic_cast<JsonDump*>( data.get() );
+  if( NULL == dump ) {
+    connection->remove(KEY_JSONDUMP);
+    return true;
+  }
+
+  string chunk;
+  bool done = dump->writer.write( chunk, CHUNK_SIZE );
+  connection->write( chunk.c_str(), chunk.length() );
+  if( done ) {
+    connection->remove(KEY_JSONDUMP);
+    connection->write( "", 0 );
+  }
+  return done;
+}
+
 SGPropertyNode_ptr JsonUriHandler::getRequestedNode(const HTTPRequest & request)
 {
   SG_LOG(SG_NETWORK,SG_INFO, "JsonUriHandler: request is '" << request.Uri << "'" );
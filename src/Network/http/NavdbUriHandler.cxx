@@ -275,6 +275,24 @@ static cJSON * createFeatureFor(FGPositioned * positioned)
   return feature;
 }
 
+bool NavdbUriHandler::isThreadSafe(const HTTPRequest & request) const
+{
+  // navdb queries may run on any thread, but airports load their runways
+  // and taxiways lazily, which is restricted to the main thread
+  string query = request.RequestVariables.get("q");
+  if (query == "airport") return false;
+  if (query != "findWithinRange") return true;
+
+  try {
+    FGPositioned::TypeFilter filter =
+      FGPositioned::TypeFilter::fromString(request.RequestVariables.get("type"));
+    return filter.minType() > FGPositioned::SEAPORT;
+  }
+  catch (...) {
+    return true; // bad request
+  }
+}
+
 bool NavdbUriHandler::handleRequest(const HTTPRequest & request, HTTPResponse & response, Connection * connection)
 {
 
@@ -30,6 +30,7 @@ class NavdbUriHandler : public URIHandler {
 public:
   NavdbUriHandler( const std::string& uri = "/navdb" ) : URIHandler( uri  ) {}
   virtual bool handleRequest( const HTTPRequest & request, HTTPResponse & response, Connection * connection );
+  virtual bool isThreadSafe( const HTTPRequest & request ) const;
 };
 
 } // namespace http
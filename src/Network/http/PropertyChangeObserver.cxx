@@ -19,6 +19,7 @@
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "PropertyChangeObserver.hxx"
+#include "jsonprops.hxx"
 
 #include <Main/fg_props.hxx>
 using std::string;
@@ -39,7 +40,7 @@ PropertyChangeObserver::~PropertyChangeObserver()
 void PropertyChangeObserver::check()
 {
 
-  for (Entries_t::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+  for (Entries_t::iterator it = _entries.begin(); it != _entries.end(); ) {
     if (!(*it)->_node.isShared()) {
       // node is no longer used but by us - remove the entry
       it = _entries.erase(it);
@@ -48,10 +49,13 @@ void PropertyChangeObserver::check()
 
     if(!(*it)->_changed ) {
       (*it)->_changed = (*it)->_prevValue != (*it)->_node->getStringValue();
-      if ((*it)->_changed)
+      if ((*it)->_changed) {
         (*it)->_prevValue = (*it)->_node->getStringValue();
+        (*it)->_changeCount++;
+      }
 
     }
+    ++it;
   }
 }
 
@@ -63,29 +67,63 @@ void PropertyChangeObserver::uncheck()
 }
 
 const SGPropertyNode_ptr PropertyChangeObserver::addObservation( const string propertyName)
+{
+  PropertyChangeObserverEntryRef entry = observe( propertyName );
+  if (entry.valid()) {
+    // if a new observer is added to a property, mark it as changed to ensure the observer
+    // gets notified on initial call. This also causes a notification for all other observers of this
+    // property.
+    entry->_changed = true;
+    return entry->_node;
+  }
+
+  SGPropertyNode_ptr empty;
+  return empty;
+}
+
+PropertyChangeObserverEntryRef PropertyChangeObserver::observe( const string & propertyName )
 {
   for (Entries_t::iterator it = _entries.begin(); it != _entries.end(); ++it) {
     if (propertyName == (*it)->_node->getPath(true) ) {
-      // if a new observer is added to a property, mark it as changed to ensure the observer
-      // gets notified on initial call. This also causes a notification for all other observers of this
-      // property.
-      (*it)->_changed = true;
-      return (*it)->_node;
+      return *it;
     }
   }
 
   try {
     PropertyChangeObserverEntryRef entry = new PropertyChangeObserverEntry();
     entry->_node = fgGetNode( propertyName, true );
+    // the current value is not a change, for the next check()
+    entry->_prevValue = entry->_node->getStringValue();
     _entries.push_back( entry );
-    return entry->_node;
+    return entry;
   }
   catch( string & s ) {
     SG_LOG(SG_NETWORK,SG_WARN,"httpd: can't observer '" << propertyName << "'. Invalid name." );
   }
 
-  SGPropertyNode_ptr empty;
-  return empty;
+  return PropertyChangeObserverEntryRef();
+}
+
+void PropertyChangeObserver::appendJson( PropertyChangeObserverEntry & entry, double timestamp, string & out )
+{
+  if (!entry._jsonValid || entry._jsonChangeCount != entry._changeCount) {
+    entry._json = JSON::toJsonString( false, entry._node, 0 );
+    // toJsonString() puts the timestamp right before the last member; quotes
+    // in names and values are escaped, so this can't match inside them
+    entry._jsonTsPos = entry._json.rfind( ",\"nChildren\":" );
+    entry._jsonChangeCount = entry._changeCount;
+    entry._jsonValid = true;
+  }
+
+  if (timestamp < 0.0 || entry._jsonTsPos == string::npos) {
+    out += entry._json;
+    return;
+  }
+
+  out.append( entry._json, 0, entry._jsonTsPos );
+  out += ",\"ts\":";
+  JSON::appendNumber( out, timestamp );
+  out.append( entry._json, entry._jsonTsPos, string::npos );
 }
 
 bool PropertyChangeObserver::isChangedValue(const SGPropertyNode_ptr node)
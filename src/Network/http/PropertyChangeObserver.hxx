@@ -30,12 +30,27 @@ namespace http {
 
 struct PropertyChangeObserverEntry : public SGReferenced {
   PropertyChangeObserverEntry()
-      : _changed(true)
+      : _changed(true),
+        _changeCount(0),
+        _jsonValid(false),
+        _jsonChangeCount(0),
+        _jsonTsPos(std::string::npos)
   {
   }
   SGPropertyNode_ptr _node;
   std::string _prevValue;
   bool _changed;
+
+  // Incremented whenever check() sees a new value, so that watchers which
+  // don't look every frame can tell if they are behind.
+  unsigned _changeCount;
+
+  // The node as JSON without a timestamp, shared by everyone sending it
+  // (see appendJson()), and where the timestamp goes into it.
+  std::string _json;
+  bool _jsonValid;
+  unsigned _jsonChangeCount;
+  std::string::size_type _jsonTsPos;
 };
 
 typedef SGSharedPtr<PropertyChangeObserverEntry> PropertyChangeObserverEntryRef;
@@ -48,6 +63,19 @@ public:
   const SGPropertyNode_ptr addObservation( const std::string propertyName);
   bool isChangedValue(const SGPropertyNode_ptr node);
 
+  /**
+   * Like addObservation(), but returns the entry itself, which lets the
+   * caller follow its _changeCount without searching.
+   */
+  PropertyChangeObserverEntryRef observe( const std::string & propertyName );
+
+  /**
+   * Append the node of entry to out as JSON::toJsonString() with the given
+   * timestamp would. The node is serialized at most once per change of its
+   * value however many clients send it; only the timestamp is per call.
+   */
+  static void appendJson( PropertyChangeObserverEntry & entry, double timestamp, std::string & out );
+
   void check();
   void uncheck();
 
@@ -121,7 +121,9 @@ PropertyChangeWebsocket::PropertyChangeWebsocket(PropertyChangeObserver * proper
     : id(++nextid),
       _propertyChangeObserver(propertyChangeObserver),
       _minTriggerInterval(fgGetDouble("/sim/http/property-websocket/update-interval-secs", 0.05)), // default 20Hz
-      _lastTrigger(-1000)
+      _lastTrigger(-1000),
+      _batch(false),
+      _elapsedSec(fgGetNode("/sim/time/elapsed-sec", true))
 {
 }
 
@@ -137,17 +139,51 @@ void PropertyChangeWebsocket::close()
 
 void PropertyChangeWebsocket::handleGetCommand(const string_list& nodes, WebsocketWriter &writer)
 {
-  double t = fgGetDouble("/sim/time/elapsed-sec");
+  double t = _elapsedSec->getDoubleValue();
+  _batchText.clear();
   string_list::const_iterator it;
   for (it = nodes.begin(); it != nodes.end(); ++it) {
     SGPropertyNode_ptr n = fgGetNode(*it);
     if (!n) {
       SG_LOG(SG_NETWORK, SG_WARN, "httpd: get '" << *it << "'  not found");
-      return;
+      break;
     }
     
-    writer.writeText( JSON::toJsonString( false, n, 0, t ) );
+    if (_batch) {
+      _batchText += _batchText.empty() ? '[' : ',';
+      _batchText += JSON::toJsonString( false, n, 0, t );
+    } else {
+      writer.writeText( JSON::toJsonString( false, n, 0, t ) );
+    }
   } // of nodes iteration
+
+  writeBatch(writer);
+}
+
+void PropertyChangeWebsocket::handleConfigureCommand(cJSON * json)
+{
+  cJSON * batch = cJSON_GetObjectItem(json, "batch");
+  if ( NULL != batch ) {
+    _batch = batch->type == cJSON_True;
+  }
+
+  cJSON * interval = cJSON_GetObjectItem(json, "interval");
+  if ( NULL != interval && interval->type == cJSON_Number ) {
+    _minTriggerInterval = interval->valuedouble;
+  }
+
+  SG_LOG(SG_NETWORK, SG_INFO, "httpd: PropertyChangeWebsocket #" << id
+         << " batch=" << _batch << " interval=" << _minTriggerInterval);
+}
+
+// Sends and clears _batchText, if anything has been added to it
+void PropertyChangeWebsocket::writeBatch(WebsocketWriter & writer)
+{
+  if (_batchText.empty()) return;
+
+  _batchText += ']';
+  writer.writeText( _batchText );
+  _batchText.clear();
 }
   
 void PropertyChangeWebsocket::handleRequest(const HTTPRequest & request, WebsocketWriter &writer)
@@ -192,6 +228,8 @@ void PropertyChangeWebsocket::handleRequest(const HTTPRequest & request, Websock
     
     if (command == "get") {
       handleGetCommand(nodeNames, writer);
+    } else if (command == "configure") {
+      handleConfigureCommand(json);
     } else if (command == "set") {
       handleSetCommand(nodeNames, json, writer);
     } else if (command == "exec") {
@@ -209,7 +247,7 @@ void PropertyChangeWebsocket::handleRequest(const HTTPRequest & request, Websock
 
 void PropertyChangeWebsocket::poll(WebsocketWriter & writer)
 {
-  double now = fgGetDouble("/sim/time/elapsed-sec");
+  double now = _elapsedSec->getDoubleValue();
 
   if( _minTriggerInterval > .0 ) {
     if( now - _lastTrigger <= _minTriggerInterval )
@@ -218,16 +256,28 @@ void PropertyChangeWebsocket::poll(WebsocketWriter & writer)
     _lastTrigger = now;
   }
 
+  // Send whatever changed since we last looked, which may have been several
+  // frames ago. The JSON of a node is shared with all other clients.
+  _batchText.clear();
   for (WatchedNodesList::iterator it = _watchedNodes.begin(); it != _watchedNodes.end(); ++it) {
-    SGPropertyNode_ptr node = *it;
+    PropertyChangeObserverEntry & entry = *it->entry;
+    if (it->sent && it->sentChangeCount == entry._changeCount)
+      continue;
 
-    string newValue;
-    if (_propertyChangeObserver->isChangedValue(node)) {
-      string out = JSON::toJsonString( false, node, 0, now );
-      SG_LOG(SG_NETWORK, SG_DEBUG, "PropertyChangeWebsocket::poll() new Value for " << node->getPath(true) << " '" << node->getStringValue() << "' #" << id << ": " << out );
-      writer.writeText( out );
+    it->sent = true;
+    it->sentChangeCount = entry._changeCount;
+    SG_LOG(SG_NETWORK, SG_DEBUG, "PropertyChangeWebsocket::poll() new Value for " << entry._node->getPath(true) << " '" << entry._node->getStringValue() << "' #" << id );
+    if (_batch) {
+      _batchText += _batchText.empty() ? '[' : ',';
+      PropertyChangeObserver::appendJson( entry, now, _batchText );
+    } else {
+      _frameText.clear();
+      PropertyChangeObserver::appendJson( entry, now, _frameText );
+      writer.writeText( _frameText );
     }
   }
+
+  writeBatch(writer);
 }
 
 void PropertyChangeWebsocket::WatchedNodesList::handleCommand(const string & command, const string & node,
@@ -235,18 +285,19 @@ void PropertyChangeWebsocket::WatchedNodesList::handleCommand(const string & com
 {
   if (command == "addListener") {
     for (iterator it = begin(); it != end(); ++it) {
-      if (node == (*it)->getPath(true)) {
+      if (node == it->entry->_node->getPath(true)) {
         SG_LOG(SG_NETWORK, SG_WARN, "httpd: " << command << " '" << node << "' ignored (duplicate)");
         return; // dupliate
       }
     }
-    SGPropertyNode_ptr n = propertyChangeObserver->addObservation(node);
-    if (n.valid()) push_back(n);
+    // a new listener gets the current value on the next poll
+    PropertyChangeObserverEntryRef entry = propertyChangeObserver->observe(node);
+    if (entry.valid()) push_back({ entry, 0, false });
     SG_LOG(SG_NETWORK, SG_INFO, "httpd: " << command << " '" << node << "' success");
 
   } else if (command == "removeListener") {
     for (iterator it = begin(); it != end(); ++it) {
-      if (node == (*it)->getPath(true)) {
+      if (node == it->entry->_node->getPath(true)) {
         this->erase(it);
         SG_LOG(SG_NETWORK, SG_INFO, "httpd: " << command << " '" << node << "' success");
         return;
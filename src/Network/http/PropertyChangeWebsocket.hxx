@@ -22,15 +22,28 @@
 #define PROPERTYCHANGEWEBSOCKET_HXX_
 
 #include "Websocket.hxx"
+#include "PropertyChangeObserver.hxx"
 #include <simgear/props/props.hxx>
 
 #include <vector>
 
+struct cJSON;
+
 namespace flightgear {
 namespace http {
 
-class PropertyChangeObserver;
-
+/*
+ * Commands (JSON objects) understood from the client:
+ *  { command: 'addListener' | 'removeListener', node: '/foo', nodes: [ '/bar', ... ] }
+ *  { command: 'get' | 'set', node(s) as above, value: v | values: [ ... ] }
+ *  { command: 'exec', fgcommand: 'name', ... }
+ *  { command: 'configure', batch: true, interval: 0.1 }
+ *
+ * Changes of the watched nodes are pushed at most every 'interval' seconds
+ * (default /sim/http/property-websocket/update-interval-secs). Normally each
+ * node is a frame of its own; with 'batch' set, all changes since the last
+ * push go into one frame holding an array of them.
+ */
 class PropertyChangeWebsocket: public Websocket {
 public:
   PropertyChangeWebsocket(PropertyChangeObserver * propertyChangeObserver);
@@ -44,8 +57,16 @@ private:
   PropertyChangeObserver * _propertyChangeObserver;
 
   void handleGetCommand(const string_list& nodes, WebsocketWriter &writer);
-  
-  class WatchedNodesList: public std::vector<SGPropertyNode_ptr> {
+  void handleConfigureCommand(cJSON * json);
+  void writeBatch(WebsocketWriter & writer);
+
+  struct WatchedNode {
+    PropertyChangeObserverEntryRef entry;
+    unsigned sentChangeCount;
+    bool sent;
+  };
+
+  class WatchedNodesList: public std::vector<WatchedNode> {
   public:
     void handleCommand(const std::string & command, const std::string & node, PropertyChangeObserver * propertyChangeObserver);
   };
@@ -53,6 +74,10 @@ private:
   WatchedNodesList _watchedNodes;
   double _minTriggerInterval;
   double _lastTrigger;
+  bool _batch;
+  std::string _batchText; // reused to build batch frames
+  std::string _frameText; // reused to build single node frames
+  SGPropertyNode_ptr _elapsedSec;
 };
 
 }
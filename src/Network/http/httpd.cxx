@@ -33,11 +33,19 @@
 #include "NavdbUriHandler.hxx"
 #include "PropertyChangeObserver.hxx"
 #include <Main/fg_props.hxx>
+#include <Main/FrameProfiler.hxx>
 
 #include <mongoose.h>
 #include <cJSON.h>
 
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #ifdef MG_VERSION
@@ -48,6 +56,11 @@ enum mg_result { MG_FALSE=0,
                  MG_MORE };
 #endif
 
+#ifndef closesocket
+#include <unistd.h>
+#define closesocket(x) ::close(x)
+#endif
+
 using std::string;
 using std::vector;
 
@@ -61,6 +74,7 @@ const char * PROPERTY_ROOT = "/sim/http";
 struct Mg_Message_Array {
     struct mg_http_message* http_msg;
     struct mg_ws_message* ws_msg;
+    bool dispatched; // the main thread keeps state for this connection
 };
 
 /**
@@ -126,10 +140,13 @@ public:
       struct mg_http_message* req_msg = msg->http_msg;
       struct mg_ws_message* ws_msg = msg->ws_msg;
 
-      Method = NotNull(req_msg->method.ptr, req_msg->method.len);
-      Uri = urlDecode(NotNull(req_msg->uri.ptr, req_msg->uri.len));
-      HttpVersion = NotNull(req_msg->proto.ptr, req_msg->proto.len); // HTTP/1.1
-      QueryString = NotNull(req_msg->query.ptr, req_msg->query.len);
+      // websocket messages come without the http message of the upgrade
+      if (req_msg) {
+          Method = NotNull(req_msg->method.ptr, req_msg->method.len);
+          Uri = urlDecode(NotNull(req_msg->uri.ptr, req_msg->uri.len));
+          HttpVersion = NotNull(req_msg->proto.ptr, req_msg->proto.len); // HTTP/1.1
+          QueryString = NotNull(req_msg->query.ptr, req_msg->query.len);
+      }
 
       //remoteAddress = NotNull(connection->loc.ip);   // we aren't processing the IP here
       remotePort = connection->rem.port;
@@ -140,7 +157,7 @@ public:
       {
           Content = NotNull(ws_msg->data.ptr, ws_msg->data.len);
 
-      } else {
+      } else if (req_msg) {
           using namespace simgear::strutils;
           string_list pairs = split(string(QueryString), "&");
           for (string_list::iterator it = pairs.begin(); it != pairs.end(); ++it) {
@@ -189,10 +206,20 @@ public:
 
 };
 
+class MongooseConnection;
+
 /**
  * A FGHttpd implementation based on mongoose httpd
  *
  * Mongoose API is documented here: http://cesanta.com/docs/API.shtml
+ *
+ * Mongoose runs on a thread of its own, so neither slow clients nor static
+ * files ever hold up a frame. Everything which touches the property tree or
+ * the scene happens on the main thread: requests for such URIs are handed
+ * over as tasks, which update() runs within a time budget, and the output
+ * they produce is handed back to the httpd thread for sending. Static files
+ * and requests which URIHandler::isThreadSafe() allows (navdb) are served on
+ * the httpd thread directly.
  */
 class MongooseHttpd : public FGHttpd
 {
@@ -209,9 +236,9 @@ public:
 
     // Subsystem API.
     void bind() override;            // Currently a noop
-    void init() override;            // Reads the configuration PropertyNode, installs URIHandlers and configures mongoose
+    void init() override;            // Reads the configuration PropertyNode, installs URIHandlers, starts mongoose
     void unbind() override;          // shutdown of mongoose, clear connections, unregister URIHandlers
-    void update(double dt) override; // poll connections, check for changed properties
+    void update(double dt) override; // run requests handed over by mongoose, poll connections, check for changed properties
 
     // Subsystem identification.
     static const char* staticSubsystemClassId() { return "mongoose-httpd"; }
@@ -227,18 +254,45 @@ public:
 
     Websocket * newWebsocket(const string & uri);
 
+    typedef std::function<void(struct mg_connection *)> Sender;
+
+    /**
+     * Called on the main thread to send something to a client: the httpd
+     * thread calls sender with the mongoose connection, unless the client
+     * has gone away in the meantime.
+     */
+    void send(unsigned long id, Sender sender);
+
 private:
-    int poll(struct mg_connection * connection);
-    int request(struct mg_connection * connection);
-    int onConnect(struct mg_connection * connection);
+    typedef std::function<void()> Task;
+
+    struct Output {
+        unsigned long id;
+        Sender sender;
+    };
+
+    // httpd thread
+    void run();
+    void flushOutput();
+    void dispatch(struct mg_connection * connection, Task task);
+    void request(struct mg_connection * connection);
+    void onWebsocketOpen(struct mg_connection * connection);
+    void onWebsocketMessage(struct mg_connection * connection);
     void close(struct mg_connection * connection);
 
+    // main thread
+    void runTasks();
+    void closeConnection(unsigned long id);
+    void wake();
+    void stop();
+
     static void staticRequestHandler(struct mg_connection *, int event, void *ev_data, void *fn_data);
+    static void wakeupHandler(struct mg_connection *, int event, void *ev_data, void *fn_data);
 
     //struct mg_server *_server;
     struct {
         struct mg_mgr mgr;
-        const char* addr;
+        string addr;
         string root_dir;
         string mime_types;
         int idle_timeout_ms;
@@ -248,46 +302,120 @@ private:
 
     SGPropertyNode_ptr _configNode;
 
-    typedef int (MongooseHttpd::*handler_t)(struct mg_connection *);
     URIHandlerMap _uriHandler;
 
     PropertyChangeObserver _propertyChangeObserver;
+
+    std::thread _thread;
+    std::atomic<bool> _stop{false};
+    int _wakeSocket = -1; ///< a datagram here makes mg_mgr_poll() return
+
+    // handed over from the httpd thread to the main thread
+    std::mutex _tasksLock;
+    std::deque<Task> _tasks;
+    double _taskBudgetMs = 2.0;
+
+    // handed over from the main thread to the httpd thread
+    std::mutex _outputLock;
+    std::vector<Output> _output;
+    std::vector<Output> _sending; ///< httpd thread
+    bool _outputPending = false;  ///< main thread
+
+    // main thread: the state of the connections handled there, by mongoose id
+    std::map<unsigned long, MongooseConnection *> _connections;
 };
 
+/**
+ * Fills in the response headers common to all dynamic content
+ */
+static void prepareResponse(HTTPResponse & response)
+{
+  response.Header["Server"] = "FlightGear/" FLIGHTGEAR_VERSION " Mongoose/" MONGOOSE_VERSION;
+  response.Header["Connection"] = "keep-alive";
+  response.Header["Cache-Control"] = "no-cache";
+  {
+    char buf[64];
+    time_t now = time(NULL);
+    struct tm utc;
+    // called on both threads, so no gmtime()
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    gmtime_s(&utc, &now);
+#else
+    gmtime_r(&now, &utc);
+#endif
+    strftime(buf, sizeof(buf), "%a, %d %b %Y %H:%M:%S GMT", &utc);
+    response.Header["Date"] = buf;
+  }
+}
+
+/**
+ * Sends the response of an URIHandler, httpd thread only
+ *
+ * @param done what the handler's handleRequest() returned
+ */
+static void sendResponse(struct mg_connection * connection, const HTTPResponse & response, bool done)
+{
+  // fill in the response header
+  string header;
+  for (HTTPResponse::Header_t::const_iterator it = response.Header.begin(); it != response.Header.end(); ++it) {
+      const string name = it->first;
+      const string value = it->second;
+      if (name.empty() || value.empty()) continue;
+      header += (name + ": " + value + "\r\n");
+  }
+
+  if (done) {
+      mg_http_reply(connection, response.StatusCode, header.c_str(), response.Content.c_str());
+  } else {
+      if (response.StatusCode == 200) {
+          // Status OK but more content to come: chunk encoding, the handler's
+          // poll() writes the remaining chunks and the terminating one
+          mg_printf(connection, "HTTP/1.1 200 OK\r\n%sTransfer-Encoding: chunked\r\n\r\n", header.c_str());
+          if (!response.Content.empty())
+              mg_http_write_chunk(connection, response.Content.c_str(), response.Content.size());
+      } else {
+          // just send the error code
+          mg_http_reply(connection, response.StatusCode, header.c_str(), "");
+      }
+  }
+}
+
+/**
+ * The main thread state of a mongoose connection
+ *
+ * The mongoose connection itself belongs to the httpd thread, so this only
+ * knows its id; anything written goes through MongooseHttpd::send().
+ */
 class MongooseConnection: public Connection {
 public:
-  MongooseConnection(MongooseHttpd * httpd)
-      : _httpd(httpd)
+  MongooseConnection(MongooseHttpd * httpd, unsigned long id)
+      : _httpd(httpd), _id(id)
   {
   }
 
   virtual ~MongooseConnection();
 
-  virtual void close(struct mg_connection * connection) = 0;
-  virtual int poll(struct mg_connection * connection) = 0;
-  virtual int request(struct mg_connection * connection) = 0;
-  virtual int onConnect(struct mg_connection * connection) {return 0;}
+  virtual void close() = 0;
+  virtual bool poll() = 0;
+  virtual void request(const HTTPRequest & request) = 0;
+  virtual void onConnect(const HTTPRequest & request) {}
   virtual void write(const char * data, size_t len)
   {
-      if (_connection) {
-          if (len) {
-              mg_http_write_chunk(_connection, data, len);
-          } else {
-              mg_http_printf_chunk(_connection, "");
-          }
+      if (len) {
+          const string chunk(data, len);
+          _httpd->send(_id, [chunk](struct mg_connection * c) {
+              mg_http_write_chunk(c, chunk.data(), chunk.size());
+          });
+      } else {
+          _httpd->send(_id, [](struct mg_connection * c) {
+              mg_http_printf_chunk(c, "");
+          });
       }
   }
 
-  static MongooseConnection * getConnection(MongooseHttpd * httpd, struct mg_connection * connection);
-
 protected:
-  void setConnection(struct mg_connection * connection)
-  {
-    _connection = connection;
-  }
   MongooseHttpd * _httpd;
-  struct ::mg_connection * _connection;
-
+  unsigned long _id;
 };
 
 MongooseConnection::~MongooseConnection()
@@ -296,17 +424,17 @@ MongooseConnection::~MongooseConnection()
 
 class RegularConnection: public MongooseConnection {
 public:
-  RegularConnection(MongooseHttpd * httpd)
-      : MongooseConnection(httpd)
+  RegularConnection(MongooseHttpd * httpd, unsigned long id)
+      : MongooseConnection(httpd, id)
   {
   }
   virtual ~RegularConnection()
   {
   }
 
-  virtual void close(struct mg_connection * connection);
-  virtual int poll(struct mg_connection * connection);
-  virtual int request(struct mg_connection * connection);
+  virtual void close();
+  virtual bool poll();
+  virtual void request(const HTTPRequest & request);
 
 private:
   SGSharedPtr<URIHandler> _handler;
@@ -314,188 +442,115 @@ private:
 
 class WebsocketConnection: public MongooseConnection {
 public:
-  WebsocketConnection(MongooseHttpd * httpd)
-      : MongooseConnection(httpd), _websocket(NULL)
+  WebsocketConnection(MongooseHttpd * httpd, unsigned long id)
+      : MongooseConnection(httpd, id), _websocket(NULL)
   {
   }
   virtual ~WebsocketConnection()
   {
       delete _websocket;
   }
-  virtual void close(struct mg_connection * connection);
-  virtual int poll(struct mg_connection * connection);
-  virtual int request(struct mg_connection * connection);
-  virtual int onConnect(struct mg_connection * connection);
+  virtual void close();
+  virtual bool poll();
+  virtual void request(const HTTPRequest & request);
+  virtual void onConnect(const HTTPRequest & request);
 
 private:
   class MongooseWebsocketWriter: public WebsocketWriter {
   public:
-    MongooseWebsocketWriter(struct mg_connection * connection)
-        : _connection(connection)
+    MongooseWebsocketWriter(MongooseHttpd * httpd, unsigned long id)
+        : _httpd(httpd), _id(id)
     {
     }
 
     virtual int writeToWebsocket(int opcode, const char * data, size_t len)
     {
-        return mg_ws_send(_connection, data, len, opcode);
-          // mg_websocket_write(_connection, opcode, data, len);
+        const string frame(data, len);
+        _httpd->send(_id, [opcode, frame](struct mg_connection * c) {
+            mg_ws_send(c, frame.data(), frame.size(), opcode);
+        });
+        return static_cast<int>(len);
     }
   private:
-    struct mg_connection * _connection;
+    MongooseHttpd * _httpd;
+    unsigned long _id;
   };
   Websocket * _websocket;
 };
 
-// a pointer to MongooseConnection is stored in the associated mg_connection->fn_data
-MongooseConnection * MongooseConnection::getConnection(MongooseHttpd * httpd, struct ::mg_connection * connection)
-{
-    MongooseConnection* c = static_cast<MongooseConnection*>(connection->fn_data);
-    if (c) return c;
-
-    if (connection->is_websocket) 
-        c = new WebsocketConnection(httpd);
-    else c = new RegularConnection(httpd);
-
-    connection->fn_data = c;
-    return c;
-}
-
-// Called on MG_EV_HTTP_MSG
-int RegularConnection::request(struct mg_connection* connection)
+void RegularConnection::request(const HTTPRequest & request)
 {
-  setConnection(connection);
-  struct Mg_Message_Array* msg = (struct Mg_Message_Array*)(connection->data);
-  MongooseHTTPRequest request(connection);
   SG_LOG(SG_NETWORK, SG_INFO, "RegularConnection::request for " << request.Uri);
 
-  // find a handler for the uri and remember it for possible polls on this connection
+  // find the handler for the uri and remember it for possible polls on this connection
   _handler = _httpd->findHandler(request.Uri);
-  if (!_handler.valid()) {
-      // uri not registered - check for websocket uri
-      if ((request.Uri.find("/PropertyListener") == 0)||
-          (request.Uri.find("/PropertyTreeMirror/") == 0)){
-
-          SG_LOG(SG_NETWORK, SG_INFO, "Upgrade to WebSocket for: " << request.Uri);
-          mg_ws_upgrade(connection, msg->http_msg, NULL);
-          return MG_TRUE;
-      } else {
-          return MG_FALSE;
-      }
-  }
+  if (!_handler.valid()) return; // the httpd thread only hands over handled uris
 
   // We handle this URI, prepare the response
   HTTPResponse response;
-  response.Header["Server"] = "FlightGear/" FLIGHTGEAR_VERSION " Mongoose/" MONGOOSE_VERSION;
-  response.Header["Connection"] = "keep-alive";
-  response.Header["Cache-Control"] = "no-cache";
-  {
-    char buf[64];
-    time_t now = time(NULL);
-    strftime(buf, sizeof(buf), "%a, %d %b %Y %H:%M:%S GMT", gmtime(&now));
-    response.Header["Date"] = buf;
-  }
+  prepareResponse(response);
 
-  // hand the request over to the handler, returns true if request is finished, 
+  // hand the request over to the handler, returns true if request is finished,
   // false the handler wants to get polled again (calling handlePoll() next time)
   bool done = _handler->handleRequest(request, response, this);
-  // fill in the response header
-  string header;
-  for (HTTPResponse::Header_t::const_iterator it = response.Header.begin(); it != response.Header.end(); ++it) {
-      const string name = it->first;
-      const string value = it->second;
-      if (name.empty() || value.empty()) continue;
-      header += (name + ": " + value + "\r\n");
-  }
-
-  if (done) {
-      mg_http_reply(connection, response.StatusCode, header.c_str(), response.Content.c_str());
-  } else {
-      if (response.StatusCode == 200) {
-          // Status OK but response.Content too long, try chunk encoding
-          mg_printf(connection, "HTTP/1.1 200 OK\r\n%sTransfer-Encoding: chunked\r\n\r\n", header.c_str());
-          mg_http_write_chunk(connection, response.Content.c_str(), response.Content.size());
-          mg_http_printf_chunk(connection, "");
-      } else {
-          // just send the error code
-          mg_http_reply(connection, response.StatusCode, header.c_str(), "");
-      }
-  }
-  return done ? MG_TRUE : MG_MORE;
+  _httpd->send(_id, [response, done](struct mg_connection * c) {
+      sendResponse(c, response, done);
+  });
 }
 
-int RegularConnection::poll(struct mg_connection * connection)
+bool RegularConnection::poll()
 {
-  setConnection(connection);
-  if (!_handler.valid()) return MG_FALSE;
-  // only return MG_TRUE if we handle this request
-  return _handler->poll(this) ? MG_TRUE : MG_MORE;
+  if (!_handler.valid()) return false;
+  // only return true if we handle this request
+  return _handler->poll(this);
 }
 
-void RegularConnection::close(struct mg_connection * connection)
+void RegularConnection::close()
 {
-  setConnection(nullptr);
   // nothing to close
 }
 
-void WebsocketConnection::close(struct mg_connection * connection)
+void WebsocketConnection::close()
 {
-  setConnection(nullptr);
   if ( NULL != _websocket) _websocket->close();
   delete _websocket;
   _websocket = NULL;
 }
 
-int WebsocketConnection::poll(struct mg_connection * connection)
+bool WebsocketConnection::poll()
 {
-  setConnection(connection);
-  // we get polled before the first request came in but we know 
+  // we get polled before the first request came in but we know
   // nothing about how to handle that before we know the URI.
   // so simply ignore that poll
   if ( NULL != _websocket) {
-    MongooseWebsocketWriter writer(connection);
+    MongooseWebsocketWriter writer(_httpd, _id);
     _websocket->poll(writer);
   }
-  return MG_MORE;
+  return false;
 }
 
 // called on MG_EV_WS_OPEN
-int WebsocketConnection::onConnect(struct mg_connection * connection)
+void WebsocketConnection::onConnect(const HTTPRequest & request)
 {
-  setConnection(connection);
-  struct Mg_Message_Array* msg = (struct Mg_Message_Array*)(connection->data);
-  MongooseHTTPRequest request(connection);
   SG_LOG(SG_NETWORK, SG_INFO, "WebsocketConnection::connect for " << request.Uri);
   if ( NULL == _websocket) _websocket = _httpd->newWebsocket(request.Uri);
   if ( NULL == _websocket) {
     SG_LOG(SG_NETWORK, SG_WARN, "httpd: unhandled websocket uri: " << request.Uri);
-    return 0;
   }
-
-  return 0;
 }
 
 // called on MG_EV_WS_MSG
-int WebsocketConnection::request(struct mg_connection* connection)
+void WebsocketConnection::request(const HTTPRequest & request)
 {
-  setConnection(connection);
-  struct Mg_Message_Array* msg = (struct Mg_Message_Array*)(connection->data);
-
-  if ((msg->ws_msg->flags & 0x0f) >= 0x8) {
-    // control opcode (close/ping/pong)
-    return MG_MORE;
-  }
-
-  MongooseHTTPRequest request(connection);
   SG_LOG(SG_NETWORK, SG_DEBUG, "WebsocketConnection::request for " << request.Uri);
 
   if ( NULL == _websocket) {
     SG_LOG(SG_NETWORK, SG_ALERT, "httpd: unhandled websocket uri: " << request.Uri);
-    return MG_TRUE; // close connection - good bye
+    return;
   }
 
-  MongooseWebsocketWriter writer(connection);
+  MongooseWebsocketWriter writer(_httpd, _id);
   _websocket->handleRequest(request, writer);
-  return MG_MORE;
 }
 
 MongooseHttpd::MongooseHttpd(SGPropertyNode_ptr configNode)
@@ -507,6 +562,7 @@ MongooseHttpd::MongooseHttpd(SGPropertyNode_ptr configNode)
 
 MongooseHttpd::~MongooseHttpd()
 {
+    stop();
     //mg_destroy_server(&_server);
     mg_mgr_free(&_server.mgr);
 }
@@ -564,8 +620,8 @@ void MongooseHttpd::init()
     string docRoot = n->getStringValue("document-root", fgRoot.c_str());
     if (docRoot[0] != '/') docRoot.insert(0, "/").insert(0, fgRoot);
 
-    _server.addr = (string("http://0.0.0.0:") + n->getStringValue("listening-port", "8080")).c_str();
-    mg_http_listen(&_server.mgr, _server.addr, MongooseHttpd::staticRequestHandler, NULL);
+    _server.addr = string("http://0.0.0.0:") + n->getStringValue("listening-port", "8080");
+    mg_http_listen(&_server.mgr, _server.addr.c_str(), MongooseHttpd::staticRequestHandler, NULL);
     {
       // build url rewrites relative to fg-root
       string rewrites = n->getStringValue("url-rewrites", "");
@@ -605,12 +661,19 @@ void MongooseHttpd::init()
     _opts.root_dir = _server.root_dir.c_str();
     _opts.mime_types = _server.mime_types.c_str();
 
+    // how long update() may spend on handed over requests per frame
+    _taskBudgetMs = n->getDoubleValue("task-budget-ms", 2.0);
+
     SG_LOG(SG_NETWORK, SG_INFO, "starting mongoose with these options: ");
     SG_LOG(SG_NETWORK, SG_INFO, "  > addr: '" << _server.addr << "'");
     SG_LOG(SG_NETWORK, SG_INFO, "  > root_dir: '" << _server.root_dir << "'");
     SG_LOG(SG_NETWORK, SG_INFO, "end of mongoose options.");
   }
 
+  _wakeSocket = mg_mkpipe(&_server.mgr, MongooseHttpd::wakeupHandler, this, true);
+  _stop = false;
+  _thread = std::thread([this] { run(); });
+
   _configNode->setBoolValue("running",true);
 
 }
@@ -622,52 +685,211 @@ void MongooseHttpd::bind()
 void MongooseHttpd::unbind()
 {
   _configNode->setBoolValue("running",false);
+  stop();
   //mg_destroy_server(&_server);
   mg_mgr_free(&_server.mgr);
+
+  for (auto & it : _connections) {
+    it.second->close();
+    delete it.second;
+  }
+  _connections.clear();
+  _tasks.clear();
+  _output.clear();
+  _outputPending = false;
+
   _uriHandler.clear();
   _propertyChangeObserver.clear();
 }
 
+void MongooseHttpd::stop()
+{
+  if (!_thread.joinable()) return;
+
+  _stop = true;
+  wake();
+  _thread.join();
+
+  closesocket(_wakeSocket);
+  _wakeSocket = -1;
+}
+
 void MongooseHttpd::update(double dt)
 {
   _propertyChangeObserver.check();
-  mg_mgr_poll(&_server.mgr, 0);
+  runTasks();
+  for (auto & it : _connections) {
+    it.second->poll();
+  }
   _propertyChangeObserver.uncheck();
+
+  if (_outputPending) {
+    _outputPending = false;
+    wake();
+  }
+}
+
+void MongooseHttpd::runTasks()
+{
+  FG_PROFILE_SCOPE("httpd/tasks");
+  const auto budget = std::chrono::duration<double, std::milli>(_taskBudgetMs);
+  const auto start = std::chrono::steady_clock::now();
+
+  // at least one task per frame, even with an exhausted budget
+  do {
+    Task task;
+    {
+      std::lock_guard<std::mutex> g(_tasksLock);
+      if (_tasks.empty()) return;
+      task = std::move(_tasks.front());
+      _tasks.pop_front();
+    }
+    task();
+  } while (std::chrono::steady_clock::now() - start < budget);
+}
+
+void MongooseHttpd::send(unsigned long id, Sender sender)
+{
+  std::lock_guard<std::mutex> g(_outputLock);
+  _output.push_back(Output{id, std::move(sender)});
+  _outputPending = true;
 }
 
-int MongooseHttpd::poll(struct mg_connection * connection)
+void MongooseHttpd::wake()
 {
-  if ( NULL == connection->fn_data) return MG_FALSE; // connection not yet set up - ignore poll
+  if (_wakeSocket < 0) return;
+  ::send((MG_SOCKET_TYPE) _wakeSocket, "w", 1, 0);
+}
 
-  return MongooseConnection::getConnection(this, connection)->poll(connection);
+void MongooseHttpd::run()
+{
+  FrameProfiler::setThreadName("httpd");
+  while (!_stop) {
+    mg_mgr_poll(&_server.mgr, 100);
+    flushOutput();
+  }
 }
 
-int MongooseHttpd::request(struct mg_connection * connection)
+void MongooseHttpd::flushOutput()
 {
-    auto c = MongooseConnection::getConnection(this, connection);
-    if (c == nullptr) 
-        return MG_FALSE;
+  {
+    std::lock_guard<std::mutex> g(_outputLock);
+    std::swap(_output, _sending);
+  }
 
-    if ((c->request(connection)) == MG_FALSE) {
-        // no dynamic handler, serve static pages
-        struct Mg_Message_Array* msg = (struct Mg_Message_Array*)(connection->data);
-        mg_http_serve_dir(connection, msg->http_msg, &(_opts));
+  struct mg_connection * c = NULL;
+  for (auto & output : _sending) {
+    if (c == NULL || c->id != output.id) {
+      for (c = _server.mgr.conns; c != NULL && c->id != output.id; c = c->next) {
+      }
     }
-    return MG_TRUE;
+    // the client may have closed the connection in the meantime
+    if (c != NULL) output.sender(c);
+  }
+  _sending.clear();
 }
 
-int MongooseHttpd::onConnect(struct ::mg_connection * connection)
+void MongooseHttpd::dispatch(struct mg_connection * connection, Task task)
 {
-  return MongooseConnection::getConnection(this, connection)->onConnect(connection);
+  struct Mg_Message_Array* msg = (struct Mg_Message_Array*)(connection->data);
+  msg->dispatched = true;
+
+  std::lock_guard<std::mutex> g(_tasksLock);
+  _tasks.push_back(std::move(task));
+}
+
+// Called on MG_EV_HTTP_MSG
+void MongooseHttpd::request(struct mg_connection * connection)
+{
+  struct Mg_Message_Array* msg = (struct Mg_Message_Array*)(connection->data);
+  MongooseHTTPRequest request(connection);
+
+  SGSharedPtr<URIHandler> handler = findHandler(request.Uri);
+  if (!handler.valid()) {
+      // uri not registered - check for websocket uri
+      if ((request.Uri.find("/PropertyListener") == 0)||
+          (request.Uri.find("/PropertyTreeMirror/") == 0)){
+
+          SG_LOG(SG_NETWORK, SG_INFO, "Upgrade to WebSocket for: " << request.Uri);
+          mg_ws_upgrade(connection, msg->http_msg, NULL);
+      } else {
+          // no dynamic handler, serve static pages
+          mg_http_serve_dir(connection, msg->http_msg, &(_opts));
+      }
+      return;
+  }
+
+  if (handler->isThreadSafe(request)) {
+      SG_LOG(SG_NETWORK, SG_INFO, "MongooseHttpd::request for " << request.Uri);
+      HTTPResponse response;
+      prepareResponse(response);
+      bool done = handler->handleRequest(request, response, NULL);
+      sendResponse(connection, response, done);
+      return;
+  }
+
+  const unsigned long id = connection->id;
+  dispatch(connection, [this, id, request] {
+      MongooseConnection *& c = _connections[id];
+      if (c == NULL) c = new RegularConnection(this, id);
+      c->request(request);
+  });
+}
+
+// Called on MG_EV_WS_OPEN
+void MongooseHttpd::onWebsocketOpen(struct mg_connection * connection)
+{
+  MongooseHTTPRequest request(connection);
+  const unsigned long id = connection->id;
+  dispatch(connection, [this, id, request] {
+      // the regular connection has been upgraded
+      MongooseConnection *& c = _connections[id];
+      if (c != NULL) {
+          c->close();
+          delete c;
+      }
+      c = new WebsocketConnection(this, id);
+      c->onConnect(request);
+  });
+}
+
+// Called on MG_EV_WS_MSG
+void MongooseHttpd::onWebsocketMessage(struct mg_connection * connection)
+{
+  struct Mg_Message_Array* msg = (struct Mg_Message_Array*)(connection->data);
+  if ((msg->ws_msg->flags & 0x0f) >= 0x8) {
+    // control opcode (close/ping/pong)
+    return;
+  }
+
+  MongooseHTTPRequest request(connection);
+  const unsigned long id = connection->id;
+  dispatch(connection, [this, id, request] {
+      auto it = _connections.find(id);
+      if (it != _connections.end()) it->second->request(request);
+  });
 }
 
+// Called on MG_EV_CLOSE
 void MongooseHttpd::close(struct ::mg_connection * connection)
 {
-  MongooseConnection * c = MongooseConnection::getConnection(this, connection);
-  c->close(connection);
+  struct Mg_Message_Array* msg = (struct Mg_Message_Array*)(connection->data);
+  if (!msg->dispatched) return; // the main thread never heard of it
+
+  const unsigned long id = connection->id;
+  dispatch(connection, [this, id] { closeConnection(id); });
+}
+
+void MongooseHttpd::closeConnection(unsigned long id)
+{
+  auto it = _connections.find(id);
+  if (it == _connections.end()) return;
 
-  // delete c -- we'll try to reuse RegularConnection
+  it->second->close();
+  delete it->second;
+  _connections.erase(it);
 }
+
 Websocket * MongooseHttpd::newWebsocket(const string & uri)
 {
   if (uri.find("/PropertyListener") == 0) {
@@ -681,6 +903,7 @@ Websocket * MongooseHttpd::newWebsocket(const string & uri)
   return NULL;
 }
 
+// runs on the httpd thread, like all mongoose callbacks
 void MongooseHttpd::staticRequestHandler(struct ::mg_connection* connection, int event, void* ev_data, void* fn_data)
 {
     // the mg_mgr struct is storing the pointer on init();
@@ -690,52 +913,43 @@ void MongooseHttpd::staticRequestHandler(struct ::mg_connection* connection, int
     struct Mg_Message_Array* msg = (struct Mg_Message_Array*)(connection->data);
 
     switch (event) {
-        case MG_EV_POLL:
-            // on each ITERATION, update websocket
-            httpd->poll(connection);
-            return;
-
-        case MG_EV_HTTP_MSG: 
+        case MG_EV_HTTP_MSG:
             // on each HTTP_MSG, generate response from the request
             msg->http_msg = (struct mg_http_message*)ev_data;
             httpd->request(connection);
+            msg->http_msg = NULL; // only valid during the event
             return;
 
         case MG_EV_OPEN:
             // on each EV_OPEN, a new connection would be created
             memset(connection->data, 0, sizeof(connection->data));
             connection->fn_data = NULL;
-            httpd->onConnect(connection);
             return;
 
-        case MG_EV_CLOSE: 
+        case MG_EV_CLOSE:
             // on each EV_CLOSE, close the connection
             httpd->close(connection);
             connection->fn_data = (void *)NULL;
             MG_INFO(("HTTP SERVER closed connetion on Port: %d", connection->loc.port));
             return;
 
-        case MG_EV_ERROR: 
+        case MG_EV_ERROR:
             // on each EV_ERROR, print the message but continue
             MG_INFO(("HTTP SERVER error: %s", (char*)ev_data));  // we don't handle errors - let mongoose do the work
             return;
 
-        case MG_EV_WS_OPEN: 
-            // on each WS_OPEN, close regular connection and establish new websocket connection
-            httpd->close(connection);
-            connection->fn_data = NULL;
+        case MG_EV_WS_OPEN:
+            // on each WS_OPEN, replace the regular connection by a websocket connection
             msg->http_msg = (struct mg_http_message*)ev_data;
-            /*if (!(connection->is_websocket)) {
-                MG_INFO(("Switching to websocket on Port: %d", connection->loc.port));
-                connection->is_websocket = 1;
-            }*/
-            httpd->onConnect(connection);
+            httpd->onWebsocketOpen(connection);
+            msg->http_msg = NULL;
             return;
 
         case MG_EV_WS_MSG:
             // on each WS_MSG, client message comes
             msg->ws_msg = (struct mg_ws_message*)ev_data;
-            httpd->request(connection);
+            httpd->onWebsocketMessage(connection);
+            msg->ws_msg = NULL;
             return;
 
         default:
@@ -743,6 +957,12 @@ void MongooseHttpd::staticRequestHandler(struct ::mg_connection* connection, int
   }
 }
 
+void MongooseHttpd::wakeupHandler(struct ::mg_connection* connection, int event, void* ev_data, void* fn_data)
+{
+    // the datagram only serves to interrupt mg_mgr_poll()
+    if (event == MG_EV_READ) connection->recv.len = 0;
+}
+
 FGHttpd * FGHttpd::createInstance(SGPropertyNode_ptr configNode)
 {
 // only create a server if a port has been configured
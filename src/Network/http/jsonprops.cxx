@@ -21,11 +21,173 @@
 #include "jsonprops.hxx"
 #include <simgear/misc/strutils.hxx>
 #include <simgear/math/SGMath.hxx>
+
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+
 namespace flightgear {
 namespace http {
 
 using std::string;
 
+// mirrors print_number() of cJSON
+void JSON::appendNumber(string & out, double d)
+{
+  char buf[64];
+  int len;
+  if (d <= INT_MAX && d >= INT_MIN && fabs((double)(int)d - d) <= DBL_EPSILON)
+    len = snprintf(buf, sizeof(buf), "%d", (int)d);
+  else if (fabs(floor(d) - d) <= DBL_EPSILON && fabs(d) < 1.0e60)
+    len = snprintf(buf, sizeof(buf), "%.0f", d);
+  else if (fabs(d) < 1.0e-6 || fabs(d) > 1.0e9)
+    len = snprintf(buf, sizeof(buf), "%e", d);
+  else
+    len = snprintf(buf, sizeof(buf), "%f", d);
+  out.append(buf, len);
+}
+
+// mirrors print_string_ptr() of cJSON
+void JSON::appendString(string & out, const char * s)
+{
+  out += '"';
+  const char * run = s; // not yet appended, needing no escapes
+  for (const char * p = s; ; ++p) {
+    const unsigned char c = *p;
+    if (c > 31 && c != '"' && c != '\\') continue;
+
+    out.append(run, p - run);
+    if (c == 0) break;
+    run = p + 1;
+
+    out += '\\';
+    switch (c) {
+      case '\\': out += '\\'; break;
+      case '"': out += '"'; break;
+      case '\b': out += 'b'; break;
+      case '\f': out += 'f'; break;
+      case '\n': out += 'n'; break;
+      case '\r': out += 'r'; break;
+      case '\t': out += 't'; break;
+      default: {
+        char buf[8];
+        snprintf(buf, sizeof(buf), "u%04x", c);
+        out += buf;
+        break;
+      }
+    }
+  }
+  out += '"';
+}
+
+PropertyJsonWriter::PropertyJsonWriter(SGPropertyNode_ptr n, int depth, bool indent, double timestamp) :
+  _root(n),
+  _depth(depth),
+  _indent(indent),
+  _timestamp(timestamp),
+  _started(false)
+{
+}
+
+bool PropertyJsonWriter::write(string & out, size_t limit)
+{
+  const size_t start = out.size();
+  if (!_started) {
+    _started = true;
+    writeNode(out, _root, _depth, 0);
+  }
+
+  while (!_stack.empty()) {
+    if (out.size() - start >= limit) return false;
+
+    Level & level = _stack.back();
+    if (level.nextChild < level.node->nChildren()) {
+      if (level.nextChild > 0) out += _indent ? ", " : ",";
+      SGPropertyNode * child = level.node->getChild(level.nextChild++);
+      // may push the child, so level must not be used afterwards
+      writeNode(out, child, level.depth - 1, level.indent + 2);
+    } else {
+      out += ']';
+      closeObject(out, level.indent);
+      _stack.pop_back();
+    }
+  }
+  return true;
+}
+
+// the members of JSON::toJson(), in the same order
+void PropertyJsonWriter::writeNode(string & out, SGPropertyNode * n, int depth, int indent)
+{
+  out += '{';
+  if (_indent) out += '\n';
+
+  writeMember(out, "path", indent, true);
+  JSON::appendString(out, n->getPath(true).c_str());
+  writeMember(out, "name", indent, false);
+  JSON::appendString(out, n->getNameString().c_str());
+  if( n->hasValue() ) {
+    writeMember(out, "value", indent, false);
+    switch( n->getType() ) {
+      case simgear::props::BOOL:
+        out += n->getBoolValue() ? "true" : "false";
+        break;
+      case simgear::props::INT:
+      case simgear::props::LONG:
+      case simgear::props::FLOAT:
+      case simgear::props::DOUBLE: {
+        double val = n->getDoubleValue();
+        if (SGMiscd::isNaN(val)) out += "null";
+        else JSON::appendNumber(out, val);
+        break;
+      }
+      default:
+        JSON::appendString(out, n->getStringValue().c_str());
+        break;
+    }
+  }
+  writeMember(out, "type", indent, false);
+  JSON::appendString(out, JSON::getPropertyTypeString(n->getType()));
+  writeMember(out, "index", indent, false);
+  JSON::appendNumber(out, n->getIndex());
+  if( _timestamp >= 0.0 ) {
+    writeMember(out, "ts", indent, false);
+    JSON::appendNumber(out, _timestamp);
+  }
+  writeMember(out, "nChildren", indent, false);
+  JSON::appendNumber(out, n->nChildren());
+
+  if (depth > 0 && n->nChildren() > 0) {
+    writeMember(out, "children", indent, false);
+    out += '[';
+    _stack.push_back(Level{n, depth, 0, indent});
+  } else {
+    closeObject(out, indent);
+  }
+}
+
+void PropertyJsonWriter::writeMember(string & out, const char * name, int indent, bool first)
+{
+  if (!first) out += ',';
+  if (_indent) {
+    if (!first) out += '\n';
+    out.append(indent + 1, '\t');
+  }
+  out += '"';
+  out += name;
+  out += "\":";
+  if (_indent) out += '\t';
+}
+
+void PropertyJsonWriter::closeObject(string & out, int indent)
+{
+  if (_indent) {
+    out += '\n';
+    out.append(indent, '\t');
+  }
+  out += '}';
+}
+
 const char * JSON::getPropertyTypeString(simgear::props::Type type)
 {
   switch (type) {
@@ -202,11 +364,8 @@ void JSON::addChildrenToProp(cJSON * json, SGPropertyNode_ptr n)
 
 string JSON::toJsonString(bool indent, SGPropertyNode_ptr n, int depth, double timestamp )
 {
-  cJSON * json = toJson( n, depth, timestamp );
-  char * jsonString = indent ? cJSON_Print( json ) : cJSON_PrintUnformatted( json );
-  string reply(jsonString);
-  free( jsonString );
-  cJSON_Delete( json );
+  string reply;
+  PropertyJsonWriter(n, depth, indent, timestamp).write(reply);
   return reply;
 }
 
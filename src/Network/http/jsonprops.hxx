@@ -24,15 +24,64 @@
 #include <simgear/props/props.hxx>
 #include <cJSON.h>
 #include <string>
+#include <vector>
 
 namespace flightgear {
 namespace http {
 
+/**
+ * Writes a property subtree as JSON straight into a string, without building
+ * a cJSON tree first. The output is the same as printing JSON::toJson() with
+ * cJSON_Print() or cJSON_PrintUnformatted().
+ *
+ * The output may be taken in pieces: write() returns once it has appended
+ * the given amount, and continues where it stopped on the next call. Nodes
+ * added or removed in between show up as they would in a later dump.
+ */
+class PropertyJsonWriter {
+public:
+  PropertyJsonWriter(SGPropertyNode_ptr n, int depth, bool indent, double timestamp = -1.0);
+
+  /**
+   * Append the next piece of output
+   * @param out appended to
+   * @param limit stop after appending about this many bytes
+   * @return true once the output is complete
+   */
+  bool write(std::string & out, size_t limit = std::string::npos);
+
+  bool done() const { return _started && _stack.empty(); }
+
+private:
+  // a node whose children are being written
+  struct Level {
+    SGPropertyNode_ptr node;
+    int depth;    // levels of children still to write below node
+    int nextChild;
+    int indent;   // the depth cJSON prints the node's object at
+  };
+
+  void writeNode(std::string & out, SGPropertyNode * n, int depth, int indent);
+  void writeMember(std::string & out, const char * name, int indent, bool first);
+  void closeObject(std::string & out, int indent);
+
+  SGPropertyNode_ptr _root;
+  int _depth;
+  bool _indent;
+  double _timestamp;
+  bool _started;
+  std::vector<Level> _stack;
+};
+
 class JSON {
 public:
   static cJSON * toJson(SGPropertyNode_ptr n, int depth, double timestamp = -1.0 );
   static std::string toJsonString(bool indent, SGPropertyNode_ptr n, int depth, double timestamp = -1.0 );
 
+  // cJSON's rendering of numbers and strings
+  static void appendNumber(std::string & out, double d);
+  static void appendString(std::string & out, const char * s);
+
   static const char * getPropertyTypeString(simgear::props::Type type);
   static cJSON * valueToJson(SGPropertyNode_ptr n);
 
@@ -71,7 +71,9 @@ public:
    * @param request The HTTP Request filled in by the httpd
    * @param response the HTTP Response to be filled in by the hander
    * @param connection Connection specific information, can be used to store persistent state
-   * @return true if the request has been completely answered, false to get poll()ed
+   * @return true if the request has been completely answered, false to get poll()ed.
+   * In the latter case, response.Content is sent as the first chunk of a chunked
+   * response, and poll() writes the remaining ones, ending with an empty chunk.
    */
   virtual bool handleRequest( const HTTPRequest & request, HTTPResponse & response, Connection * connection = NULL ) {
     if( request.Method == "GET" ) return handleGetRequest( request, response, connection );
@@ -110,6 +112,15 @@ public:
    */
   virtual bool poll( Connection * connection ) { return false; }
 
+  /**
+   * Whether the httpd may answer this request on its own thread instead of
+   * the main thread. Such requests must not touch the property tree, must be
+   * answered by handleRequest() alone and get no Connection.
+   * @param request @see handleRequest()
+   * @return true if handleRequest() may be called from any thread for this request
+   */
+  virtual bool isThreadSafe( const HTTPRequest & request ) const { return false; }
+
   /**
    * Getter for the URI this handler serves
    *
@@ -0,0 +1,175 @@
+// PayloadEncoder.cxx -- encodings of batched property updates
+//
+// Copyright (C) 2026  The FlightGear Team
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "config.h"
+
+#include "PayloadEncoder.hxx"
+
+#include <Network/http/jsonprops.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+using std::string;
+
+namespace flightgear {
+namespace mqtt {
+
+namespace {
+
+typedef std::map<string, PayloadEncoder::Factory> Factories_t;
+
+Factories_t & factories()
+{
+  static Factories_t f = {
+    { "binary", [] { return new BinaryPayloadEncoder; } },
+    { "json", [] { return new JsonPayloadEncoder; } }
+  };
+  return f;
+}
+
+void appendLE(string & out, uint64_t v, int bytes)
+{
+  for (int i = 0; i < bytes; ++i) {
+    out += static_cast<char>((v >> (8 * i)) & 0xff);
+  }
+}
+
+void appendString16(string & out, const string & s)
+{
+  const size_t len = std::min<size_t>(s.size(), 0xffff);
+  appendLE(out, len, 2);
+  out.append(s, 0, len);
+}
+
+} // anonymous namespace
+
+void PayloadEncoder::registerEncoder(const string & name, Factory factory)
+{
+  factories()[name] = factory;
+}
+
+std::unique_ptr<PayloadEncoder> PayloadEncoder::create(const string & name)
+{
+  Factories_t::const_iterator it = factories().find(name);
+  if (it == factories().end()) return std::unique_ptr<PayloadEncoder>();
+  return std::unique_ptr<PayloadEncoder>(it->second());
+}
+
+void BinaryPayloadEncoder::begin(string & out)
+{
+  out = "FGMQ";
+  out += static_cast<char>(VERSION);
+  appendLE(out, 0, 2); // count, set by end()
+}
+
+void BinaryPayloadEncoder::add(string & out, const string & path, SGPropertyNode * node)
+{
+  appendString16(out, path);
+
+  switch (node->getType()) {
+  case simgear::props::BOOL:
+    out += static_cast<char>(BOOL);
+    out += static_cast<char>(node->getBoolValue() ? 1 : 0);
+    break;
+  case simgear::props::INT:
+    out += static_cast<char>(INT);
+    appendLE(out, static_cast<uint32_t>(node->getIntValue()), 4);
+    break;
+  case simgear::props::LONG:
+    out += static_cast<char>(LONG);
+    appendLE(out, static_cast<uint64_t>(node->getLongValue()), 8);
+    break;
+  case simgear::props::FLOAT: {
+    float f = node->getFloatValue();
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    out += static_cast<char>(FLOAT);
+    appendLE(out, bits, 4);
+    break;
+  }
+  case simgear::props::DOUBLE: {
+    double d = node->getDoubleValue();
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    out += static_cast<char>(DOUBLE);
+    appendLE(out, bits, 8);
+    break;
+  }
+  default:
+    out += static_cast<char>(STRING);
+    appendString16(out, node->getStringValue());
+    break;
+  }
+}
+
+void BinaryPayloadEncoder::end(string & out, unsigned count)
+{
+  out[5] = static_cast<char>(count & 0xff);
+  out[6] = static_cast<char>((count >> 8) & 0xff);
+}
+
+void JsonPayloadEncoder::begin(string & out)
+{
+  out = "{";
+}
+
+void JsonPayloadEncoder::add(string & out, const string & path, SGPropertyNode * node)
+{
+  if (out.size() > 1) out += ',';
+  http::JSON::appendString(out, path.c_str());
+  out += ':';
+
+  switch (node->getType()) {
+  case simgear::props::BOOL:
+    out += node->getBoolValue() ? "true" : "false";
+    break;
+  case simgear::props::INT:
+  case simgear::props::LONG:
+    out += std::to_string(node->getLongValue());
+    break;
+  case simgear::props::FLOAT:
+  case simgear::props::DOUBLE: {
+    const double d = node->getDoubleValue();
+    if (!std::isfinite(d)) {
+      out += "null";
+    } else {
+      // enough digits to get the same double back
+      char buf[32];
+      snprintf(buf, sizeof(buf), "%.17g", d);
+      out += buf;
+    }
+    break;
+  }
+  default:
+    http::JSON::appendString(out, node->getStringValue().c_str());
+    break;
+  }
+}
+
+void JsonPayloadEncoder::end(string & out, unsigned count)
+{
+  out += '}';
+}
+
+}  // namespace mqtt
+}  // namespace flightgear
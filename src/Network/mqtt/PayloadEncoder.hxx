@@ -0,0 +1,93 @@
+// PayloadEncoder.hxx -- encodings of batched property updates
+//
+// Copyright (C) 2026  The FlightGear Team
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#ifndef FG_MQTT_PAYLOADENCODER_HXX
+#define FG_MQTT_PAYLOADENCODER_HXX
+
+#include <simgear/props/props.hxx>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace flightgear {
+namespace mqtt {
+
+/**
+ * Turns the properties changed during one batch window into the payload of
+ * a single MQTT message.
+ *
+ * Encoders are looked up by name (options/encoding); others than the built
+ * in "binary" and "json" can be added with registerEncoder().
+ */
+class PayloadEncoder {
+public:
+  virtual ~PayloadEncoder() {}
+
+  /// start a payload, out is empty
+  virtual void begin(std::string & out) = 0;
+  /// append the value of node, published as path
+  virtual void add(std::string & out, const std::string & path, SGPropertyNode * node) = 0;
+  /// finish a payload with count properties
+  virtual void end(std::string & out, unsigned count) = 0;
+
+  typedef std::function<PayloadEncoder*()> Factory;
+  static void registerEncoder(const std::string & name, Factory factory);
+
+  /// @return NULL for unknown names
+  static std::unique_ptr<PayloadEncoder> create(const std::string & name);
+};
+
+/**
+ * "binary": all little endian, so any reader can decode it.
+ *
+ *   "FGMQ" version:u8 count:u16
+ *   count times: pathlength:u16 path type:u8 value
+ *
+ * with type and value
+ *   1 bool     u8
+ *   2 int      i32
+ *   3 long     i64
+ *   4 float    f32
+ *   5 double   f64
+ *   6 string   length:u16 bytes
+ */
+class BinaryPayloadEncoder : public PayloadEncoder {
+public:
+  enum Type { BOOL = 1, INT, LONG, FLOAT, DOUBLE, STRING };
+  static const unsigned char VERSION = 1;
+
+  void begin(std::string & out) override;
+  void add(std::string & out, const std::string & path, SGPropertyNode * node) override;
+  void end(std::string & out, unsigned count) override;
+};
+
+/**
+ * "json": an object of path: value
+ */
+class JsonPayloadEncoder : public PayloadEncoder {
+public:
+  void begin(std::string & out) override;
+  void add(std::string & out, const std::string & path, SGPropertyNode * node) override;
+  void end(std::string & out, unsigned count) override;
+};
+
+}  // namespace mqtt
+}  // namespace flightgear
+
+#endif // FG_MQTT_PAYLOADENCODER_HXX
@@ -0,0 +1,155 @@
+// WatchedProperties.cxx -- the properties mirrored to the MQTT broker
+//
+// Copyright (C) 2026  The FlightGear Team
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "config.h"
+
+#include "WatchedProperties.hxx"
+
+#include <cmath>
+
+using std::string;
+
+namespace flightgear {
+namespace mqtt {
+
+WatchedProperties::WatchedProperties()
+    : _applyingRemote(false)
+{
+}
+
+WatchedProperties::~WatchedProperties()
+{
+  clear();
+}
+
+bool WatchedProperties::add( SGPropertyNode * node, double deadband )
+{
+  if (_byNode.find(node) != _byNode.end()) return false;
+
+  std::unique_ptr<WatchedProperty> entry(new WatchedProperty);
+  entry->_node = node;
+  entry->_path = node->getPath(true);
+  entry->_deadband = deadband;
+  entry->_dirty = false;
+  entry->_known = false;
+  entry->_value = 0.0;
+
+  WatchedProperty * e = entry.get();
+  _entries.push_back(std::move(entry));
+  _byNode[node] = e;
+  _byPath[e->_path] = e;
+
+  node->addChangeListener(this);
+  if (node->isTied()) _tied.push_back(e);
+
+  // the broker doesn't know it yet
+  markDirty(*e);
+  return true;
+}
+
+void WatchedProperties::clear()
+{
+  for (auto & e : _entries) {
+    e->_node->removeChangeListener(this);
+  }
+  _entries.clear();
+  _byNode.clear();
+  _byPath.clear();
+  _dirty.clear();
+  _tied.clear();
+}
+
+WatchedProperty * WatchedProperties::find( const string & path )
+{
+  auto it = _byPath.find(path);
+  return it == _byPath.end() ? NULL : it->second;
+}
+
+void WatchedProperties::collect( std::vector<WatchedProperty*> & changed )
+{
+  changed.clear();
+
+  for (WatchedProperty * e : _tied) {
+    if (exceedsDeadband(*e)) markDirty(*e);
+  }
+
+  for (WatchedProperty * e : _dirty) {
+    e->_dirty = false;
+    if (exceedsDeadband(*e)) {
+      remember(*e);
+      changed.push_back(e);
+    }
+  }
+  _dirty.clear();
+}
+
+void WatchedProperties::valueChanged( SGPropertyNode * node )
+{
+  if (_applyingRemote) return;
+
+  auto it = _byNode.find(node);
+  if (it != _byNode.end()) markDirty(*it->second);
+}
+
+bool WatchedProperties::isNumeric( const SGPropertyNode * node )
+{
+  switch (node->getType()) {
+  case simgear::props::BOOL:
+  case simgear::props::INT:
+  case simgear::props::LONG:
+  case simgear::props::FLOAT:
+  case simgear::props::DOUBLE:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool WatchedProperties::exceedsDeadband( const WatchedProperty & entry ) const
+{
+  if (!entry._known) return true;
+
+  if (isNumeric(entry._node)) {
+    const double v = entry._node->getDoubleValue();
+    if (std::isnan(v) || std::isnan(entry._value)) {
+      return std::isnan(v) != std::isnan(entry._value);
+    }
+    return std::fabs(v - entry._value) > entry._deadband;
+  }
+  return entry._node->getStringValue() != entry._stringValue;
+}
+
+void WatchedProperties::remember( WatchedProperty & entry )
+{
+  entry._known = true;
+  if (isNumeric(entry._node)) {
+    entry._value = entry._node->getDoubleValue();
+  } else {
+    entry._stringValue = entry._node->getStringValue();
+  }
+}
+
+void WatchedProperties::markDirty( WatchedProperty & entry )
+{
+  if (entry._dirty) return;
+  entry._dirty = true;
+  _dirty.push_back(&entry);
+}
+
+}  // namespace mqtt
+}  // namespace flightgear
@@ -0,0 +1,104 @@
+// WatchedProperties.hxx -- the properties mirrored to the MQTT broker
+//
+// Copyright (C) 2026  The FlightGear Team
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#ifndef FG_MQTT_WATCHEDPROPERTIES_HXX
+#define FG_MQTT_WATCHEDPROPERTIES_HXX
+
+#include <simgear/props/props.hxx>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace flightgear {
+namespace mqtt {
+
+struct WatchedProperty {
+  SGPropertyNode_ptr _node;
+  std::string _path;        // the topic
+  double _deadband;         // numeric changes up to this are not published
+  bool _dirty;
+  // the value last published, or received from the broker
+  bool _known;
+  double _value;
+  std::string _stringValue;
+};
+
+/**
+ * The properties mirrored to the broker, and which of them need publishing.
+ *
+ * A change listener on each property puts it into a dirty list, so nothing
+ * is looked at while the properties don't change. collect() then drops
+ * numeric changes within the property's deadband of the last published
+ * value. Tied properties don't notify listeners; the few there are get
+ * compared every collect().
+ */
+class WatchedProperties : public SGPropertyChangeListener {
+public:
+  WatchedProperties();
+  ~WatchedProperties();
+
+  /// @return false if already watched
+  bool add( SGPropertyNode * node, double deadband );
+  void clear();
+  size_t size() const { return _entries.size(); }
+
+  WatchedProperty * find( const std::string & path );
+
+  /**
+   * The properties which changed by more than their deadband since they
+   * were last published, which they now count as. Properties not
+   * published yet are always included.
+   */
+  void collect( std::vector<WatchedProperty*> & changed );
+
+  /**
+   * Set a property to a value received from the broker, which doesn't
+   * need to be published back.
+   * @param apply sets the value on the node
+   */
+  template <class F>
+  void applyRemote( WatchedProperty & entry, F apply )
+  {
+    _applyingRemote = true;
+    apply( entry._node.get() );
+    _applyingRemote = false;
+    remember( entry );
+  }
+
+  void valueChanged( SGPropertyNode * node ) override;
+
+private:
+  static bool isNumeric( const SGPropertyNode * node );
+  bool exceedsDeadband( const WatchedProperty & entry ) const;
+  void remember( WatchedProperty & entry );
+  void markDirty( WatchedProperty & entry );
+
+  std::vector<std::unique_ptr<WatchedProperty>> _entries;
+  std::unordered_map<SGPropertyNode*, WatchedProperty*> _byNode;
+  std::unordered_map<std::string, WatchedProperty*> _byPath;
+  std::vector<WatchedProperty*> _dirty;
+  std::vector<WatchedProperty*> _tied;
+  bool _applyingRemote;
+};
+
+}  // namespace mqtt
+}  // namespace flightgear
+
+#endif // FG_MQTT_WATCHEDPROPERTIES_HXX
@@ -21,11 +21,16 @@
 #include "config.h"
 
 #include "mqttd.hxx"
-#include "PropertyChangeObserver.hxx"
+#include "PayloadEncoder.hxx"
+#include "WatchedProperties.hxx"
 #include <Main/fg_props.hxx>
 
+#include <simgear/timing/timestamp.hxx>
+
 #include <mongoose.h>
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
@@ -54,6 +59,7 @@ public:
     uint8_t sub_qos;    // Inbound QoS, default to 0
     int timeout_ms;
     struct mg_connection* conn;
+    bool connected;     // CONNACK received
 
     map<string, struct mg_str> updateList;
 
@@ -64,7 +70,8 @@ public:
                                sub_qos(0),
                                pub_qos(1),
                                timeout_ms(3000),
-                               conn(nullptr)
+                               conn(nullptr),
+                               connected(false)
     {
         mg_mgr_init(&mgr);
     }
@@ -75,7 +82,8 @@ public:
                                          sub_qos(0),
                                          pub_qos(1),
                                          timeout_ms(3000),
-                                         conn(nullptr)
+                                         conn(nullptr),
+                                         connected(false)
     {
         mg_mgr_init(&mgr);
     }
@@ -87,6 +95,7 @@ public:
     int establishConnection(string& url, int timeout_ms);
     int subscribeUpdate(SGPropertyNode_ptr node, struct mg_str data);
     int publishUpdate(SGPropertyNode_ptr node);
+    int publish(const string& topic, const string& payload);
 
 private:
     static void staticRequestHandler(struct mg_connection*, int event, void* ev_data, void* fn_data);
@@ -197,6 +206,15 @@ int MongooseMQTTConnection::publishUpdate(SGPropertyNode_ptr node)
 }
 
 
+int MongooseMQTTConnection::publish(const string& topic, const string& payload)
+{
+    if (conn == NULL) return 0;
+
+    mg_mqtt_pub(conn, mg_str_n(topic.c_str(), topic.size()),
+                mg_str_n(payload.data(), payload.size()), pub_qos, false);
+    return payload.size();
+}
+
 void MongooseMQTTConnection::staticRequestHandler(struct mg_connection *c, int ev, void *ev_data, void *fn_data) {
     MongooseMQTTConnection* p_conn = (MongooseMQTTConnection*)fn_data;
     const char* s_url = p_conn->addr.c_str();
@@ -219,6 +237,7 @@ void MongooseMQTTConnection::staticRequestHandler(struct mg_connection *c, int e
     }
   } else if (ev == MG_EV_MQTT_OPEN) {
     // MQTT connect is successful
+    p_conn->connected = true;
     struct mg_str subt = mg_str(s_sub_topic);
     struct mg_str pubt = mg_str(s_pub_topic), data = mg_str("hello");
     SG_LOG(SG_NETWORK, SG_INFO, "MQTT connection CONNECTED to " << s_url);
@@ -239,6 +258,7 @@ void MongooseMQTTConnection::staticRequestHandler(struct mg_connection *c, int e
   } else if (ev == MG_EV_CLOSE) {
     SG_LOG(SG_NETWORK, SG_INFO, "MQTT connection CLOSED.");
     *s_conn = NULL;  // Mark that we're closed
+    p_conn->connected = false;
   }
 
 }
@@ -271,6 +291,16 @@ void MongooseMQTTConnection::staticReconnectTimer(void* arg)
  * A FGMqttd implementation based on mongoose mqttd
  *
  * Mongoose API is documented here: mqtt://cesanta.com/docs/API.shtml
+ *
+ * Besides url, watched-list and retry-timeout-ms, these options apply:
+ *   default-deadband     numeric changes up to this are not published (0)
+ *   deadband[n]/path     a different deadband for the properties below path,
+ *   deadband[n]/value    the longest matching path wins
+ *   batch-interval-ms    publish all changes within this time as a single
+ *                        message; 0 publishes each property to its own
+ *                        topic every frame (0)
+ *   batch-topic          the topic of those messages (fgfs/batch)
+ *   encoding             their payload, see PayloadEncoder (binary)
  */
 class MongooseMqttd : public FGMqttd
 {
@@ -295,25 +325,34 @@ public:
     static const char* staticSubsystemClassId() { return "mongoose-mqttd"; }
 
 private:
+    void addWatchedNode(SGPropertyNode* node);
+    double deadbandFor(const string& path) const;
+    void publishChanges();
 
     MongooseMQTTConnection _conn;
 
     SGPropertyNode_ptr _configNode;
-    
-    PropertyChangeObserver _propertyChangeObserver;
 
-    class WatchedNodesList : public std::vector<SGPropertyNode_ptr>
-    {
-    public:
-        int addWatchedNode(const std::string& node, PropertyChangeObserver* propertyChangeObserver);
-        int removeWatchedNode(const std::string& node, PropertyChangeObserver* propertyChangeObserver);
-    };
+    WatchedProperties _watched;
+
+    // options/deadband[n]: path prefix and deadband, longest prefix wins
+    vector<std::pair<string, double>> _deadbands;
+    double _defaultDeadband;
+
+    // 0 publishes each changed property to its own topic every frame
+    int _batchIntervalMs;
+    string _batchTopic;
+    std::unique_ptr<PayloadEncoder> _encoder;
+    SGTimeStamp _lastPublish;
 
-    WatchedNodesList _watchedNodes;
+    vector<WatchedProperty*> _changed;
+    string _payload;
 };
 
 MongooseMqttd::MongooseMqttd(SGPropertyNode_ptr configNode)
-    : _configNode(configNode)
+    : _configNode(configNode),
+      _defaultDeadband(0.0),
+      _batchIntervalMs(0)
 {
 }
 
@@ -337,15 +376,42 @@ void MongooseMqttd::init()
     string topic = n->getStringValue("watched-list", "/network/mqtt");
     int timeout = n->getIntValue("retry-timeout-ms", 30000);
 
+    _defaultDeadband = n->getDoubleValue("default-deadband", 0.0);
+    _deadbands.clear();
+    for (SGPropertyNode* d : n->getChildren("deadband")) {
+        string path = d->getStringValue("path");
+        if (path.empty()) continue;
+        if (path.back() == '/') path.pop_back();
+        _deadbands.emplace_back(path, d->getDoubleValue("value", 0.0));
+    }
+
+    _batchIntervalMs = n->getIntValue("batch-interval-ms", 0);
+    _batchTopic = n->getStringValue("batch-topic", "fgfs/batch");
+    string encoding = n->getStringValue("encoding", "binary");
+    _encoder.reset();
+    if (_batchIntervalMs > 0) {
+        _encoder = PayloadEncoder::create(encoding);
+        if (!_encoder) {
+            SG_LOG(SG_NETWORK, SG_WARN, "mqttd: unknown encoding '" << encoding << "', using binary");
+            _encoder = PayloadEncoder::create("binary");
+        }
+    }
+
     SG_LOG(SG_NETWORK, SG_INFO, "starting mqtt connection with these options: ");
     SG_LOG(SG_NETWORK, SG_INFO, "  > addr: '" << addr << "'");
     SG_LOG(SG_NETWORK, SG_INFO, "  > interested-topic: '" << topic << "'");
     SG_LOG(SG_NETWORK, SG_INFO, "  > retry-timeout: '" << timeout << "'");
+    SG_LOG(SG_NETWORK, SG_INFO, "  > default-deadband: '" << _defaultDeadband << "'");
+    if (_batchIntervalMs > 0) {
+        SG_LOG(SG_NETWORK, SG_INFO, "  > batch: every " << _batchIntervalMs << "ms to '"
+               << _batchTopic << "' as " << encoding);
+    }
     SG_LOG(SG_NETWORK, SG_INFO, "end of mqtt options.");
-    
+
     _conn.sub_topic = topic + "/#";
-    _propertyChangeObserver.clear();
-    _watchedNodes.addWatchedNode(topic, &_propertyChangeObserver);
+    _watched.clear();
+    addWatchedNode(fgGetNode(topic, true));
+    SG_LOG(SG_NETWORK, SG_INFO, "mqttd: watching " << _watched.size() << " properties below " << topic);
 
     if (_conn.establishConnection(addr, timeout)) 
     {
@@ -362,50 +428,61 @@ void MongooseMqttd::unbind()
 {
   _configNode->setBoolValue("running",false);
   //mg_mgr_free(&_conn.mgr);
-  _propertyChangeObserver.clear();
-  _watchedNodes.clear();
+  _watched.clear();
 }
 
 void MongooseMqttd::update(double dt)
 {
-    string path, data;
-
-    _propertyChangeObserver.check();
-
-    for (WatchedNodesList::iterator it = _watchedNodes.begin(); it != _watchedNodes.end(); ++it) {
-        SGPropertyNode_ptr node = *it;
-
-        if (_propertyChangeObserver.isChangedValue(node)) {
-            path = node->getPath(true);
-            data = node->getStringValue();
-            
-            SG_LOG(SG_NETWORK, SG_INFO, "mqttd: new Local Value for " << path << ": " << data);
-            _conn.publishUpdate(node);
+    // Changes are collected while the broker can't be reached, and go out
+    // once it can.
+    if (_conn.connected) {
+        if (_batchIntervalMs <= 0 || _lastPublish.elapsedMSec() >= _batchIntervalMs) {
+            _lastPublish.stamp();
+            publishChanges();
         }
     }
 
     mg_mgr_poll(&_conn.mgr, 0);
 
-    for (WatchedNodesList::iterator it = _watchedNodes.begin(); it != _watchedNodes.end(); ++it) {
-        SGPropertyNode_ptr node = *it;
-        // Skip to update the node we've just published
-        if (!_propertyChangeObserver.isChangedValue(node)) 
-        {
-            path = node->getPath(true);
-
-            auto newData = _conn.updateList.find(path);
-
-            if (newData != _conn.updateList.end()) {
-                //node->setStringValue(newData->second);
-                _conn.subscribeUpdate(node, newData->second);
-                free((void*)newData->second.ptr);
-            }
+    for (auto& update : _conn.updateList) {
+        WatchedProperty* entry = _watched.find(update.first);
+        // Skip nodes changed locally since, those win
+        if (entry != NULL && !entry->_dirty) {
+            _watched.applyRemote(*entry, [&](SGPropertyNode* node) {
+                _conn.subscribeUpdate(node, update.second);
+            });
         }
+        free((void*)update.second.ptr);
     }
     _conn.updateList.clear();
+}
+
+void MongooseMqttd::publishChanges()
+{
+    _watched.collect(_changed);
+    if (_changed.empty()) return;
+
+    if (!_encoder) {
+        for (WatchedProperty* entry : _changed) {
+            SG_LOG(SG_NETWORK, SG_DEBUG, "mqttd: new Local Value for " << entry->_path << ": "
+                   << entry->_node->getStringValue());
+            _conn.publishUpdate(entry->_node);
+        }
+        return;
+    }
 
-    _propertyChangeObserver.check();   // To flush updates by remote,
-    _propertyChangeObserver.uncheck(); // So we don't resend the updates on next iteration.
+    // the binary encoding counts in 16 bits
+    const size_t maxPerPayload = 0xffff;
+    for (size_t first = 0; first < _changed.size(); first += maxPerPayload) {
+        const size_t last = std::min(_changed.size(), first + maxPerPayload);
+        _encoder->begin(_payload);
+        for (size_t i = first; i < last; ++i) {
+            _encoder->add(_payload, _changed[i]->_path, _changed[i]->_node);
+        }
+        _encoder->end(_payload, last - first);
+        _conn.publish(_batchTopic, _payload);
+    }
+    SG_LOG(SG_NETWORK, SG_DEBUG, "mqttd: published " << _changed.size() << " changes to " << _batchTopic);
 }
 
 FGMqttd * FGMqttd::createInstance(SGPropertyNode_ptr configNode)
@@ -417,48 +494,32 @@ FGMqttd * FGMqttd::createInstance(SGPropertyNode_ptr configNode)
   return new MongooseMqttd(configNode);
 }
 
-int MongooseMqttd::WatchedNodesList::addWatchedNode(const std::string& node, PropertyChangeObserver* propertyChangeObserver)
+double MongooseMqttd::deadbandFor(const string& path) const
 {
-    for (iterator it = begin(); it != end(); ++it) {
-        if (node == (*it)->getPath(true)) {
-            SG_LOG(SG_NETWORK, SG_WARN, "mqttd: addWatchedNode (" << node << ") ignored (duplicate)");
-            return 0; // duplicated
-        }
-    }
-    SGPropertyNode *ls = fgGetNode(node, true);
-    int nCh = ls->nChildren();
-    if (ls->hasValue()) {
-        SGPropertyNode_ptr n = propertyChangeObserver->addObservation(node);
-        if (n.valid()) push_back(n);
-        string strAct = "";
-        auto act = ls->getNode("_attr_/active");
-        if (act)
-            strAct = act->getStringValue();
-
-        SG_LOG(SG_NETWORK, SG_INFO, "mqttd: addWatchedNode (" << node << ") success. sigACT=" << strAct);
-
-        return 1;
-    } else if (nCh > 0) {
-        for (int i = 0; i < nCh; i++) {
-            addWatchedNode(ls->getChild(i)->getPath(), propertyChangeObserver);
-        }
-        return nCh;
+    double deadband = _defaultDeadband;
+    size_t matched = 0;
+    for (const auto& d : _deadbands) {
+        const string& prefix = d.first;
+        if (prefix.size() < matched || path.compare(0, prefix.size(), prefix) != 0) continue;
+        if (path.size() != prefix.size() && path[prefix.size()] != '/') continue;
+        deadband = d.second;
+        matched = prefix.size();
     }
+    return deadband;
 }
 
-int MongooseMqttd::WatchedNodesList::removeWatchedNode(const std::string& node, PropertyChangeObserver* propertyChangeObserver)
+void MongooseMqttd::addWatchedNode(SGPropertyNode* node)
 {
-    for (iterator it = begin(); it != end(); ++it) {
-        if (node == (*it)->getPath(true)) {
-            this->erase(it);
-            SG_LOG(SG_NETWORK, SG_INFO, "mqttd: removeWatchedNode (" << node << ") success");
-            
-            return 1;
+    if (node->hasValue()) {
+        const string path = node->getPath(true);
+        if (!_watched.add(node, deadbandFor(path))) {
+            SG_LOG(SG_NETWORK, SG_WARN, "mqttd: addWatchedNode (" << path << ") ignored (duplicate)");
         }
+        return;
+    }
+    for (int i = 0; i < node->nChildren(); i++) {
+        addWatchedNode(node->getChild(i));
     }
-    SG_LOG(SG_NETWORK, SG_WARN, "mqttd: removeWatchedNode (" << node << ") ignored (not found)");
-
-    return 0;
 }
 
 } // namespace mqtt
@@ -37,6 +37,7 @@
 #include <Scenery/scenery.hxx>	// ground elevation
 
 #include "native_structs.hxx"
+#include "SharedMemoryChannel.hxx"
 #include "native_ctrls.hxx"
 
 // FreeBSD works better with this included last ... (?)
@@ -81,6 +82,9 @@ bool FGNativeCtrls::process() {
     int length;
     char *buf;
 
+    // processes sharing memory with us share our byte order too
+    const bool net_byte_order = !FGSharedMemoryChannel::isSharedMemory( io );
+
     if ( io->get_type() == sgDDSType ) {
         buf = reinterpret_cast<char*>(&ctrls.dds);
         length = sizeof(FG_DDS_Ctrls);
@@ -94,7 +98,7 @@ bool FGNativeCtrls::process() {
         if ( io->get_type() == sgDDSType ) {
             FGProps2Ctrls( globals->get_props(), &ctrls.dds, true, true );
         } else {
-            FGProps2Ctrls( globals->get_props(), &ctrls.net, true, true );
+            FGProps2Ctrls( globals->get_props(), &ctrls.net, true, net_byte_order );
         }
 
         if ( ! io->write( buf, length ) ) {
@@ -107,7 +111,7 @@ bool FGNativeCtrls::process() {
         if ( io->get_type() == sgFileType ) {
             if ( io->read( buf, length ) == length ) {
                 SG_LOG( SG_IO, SG_INFO, "Success reading data." );
-                FGCtrls2Props( globals->get_props(), &ctrls.net, true, true );
+                FGCtrls2Props( globals->get_props(), &ctrls.net, true, net_byte_order );
             }
         } else if ( io->get_type() == sgDDSType ) {
             while ( io->read( buf, length ) == length ) {
@@ -117,7 +121,7 @@ bool FGNativeCtrls::process() {
         } else {
             while ( io->read( buf, length ) == length ) {
                 SG_LOG( SG_IO, SG_INFO, "Success reading data." );
-                FGCtrls2Props( globals->get_props(), &ctrls.net, true, true );
+                FGCtrls2Props( globals->get_props(), &ctrls.net, true, net_byte_order );
             }
         }
     }
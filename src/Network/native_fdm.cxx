@@ -39,6 +39,7 @@
 #include <Scenery/scenery.hxx>
 
 #include "native_structs.hxx"
+#include "SharedMemoryChannel.hxx"
 #include "native_fdm.hxx"
 
 // FreeBSD works better with this included last ... (?)
@@ -86,6 +87,9 @@ bool FGNativeFDM::process() {
     int length;
     char *buf;
 
+    // processes sharing memory with us share our byte order too
+    const bool net_byte_order = !FGSharedMemoryChannel::isSharedMemory( io );
+
     if ( io->get_type() == sgDDSType ) {
         buf = reinterpret_cast<char*>(&fdm.dds);
         length = sizeof(FG_DDS_FDM);
@@ -99,7 +103,7 @@ bool FGNativeFDM::process() {
         if ( io->get_type() == sgDDSType ) {
             FGProps2FDM( globals->get_props(), &fdm.dds );
         } else {
-            FGProps2FDM( globals->get_props(), &fdm.net );
+            FGProps2FDM( globals->get_props(), &fdm.net, net_byte_order );
         }
 
         if ( ! io->write( buf, length ) ) {
@@ -110,7 +114,7 @@ bool FGNativeFDM::process() {
         if ( io->get_type() == sgFileType ) {
             if ( io->read( buf, length ) == length ) {
                 SG_LOG( SG_IO, SG_INFO, "Success reading data." );
-                FGFDM2Props( globals->get_props(), &fdm.net );
+                FGFDM2Props( globals->get_props(), &fdm.net, net_byte_order );
             }
         } else if ( io->get_type() == sgDDSType ) {
             while ( io->read( buf, length ) == length ) {
@@ -120,7 +124,7 @@ bool FGNativeFDM::process() {
         } else {
             while ( io->read( buf, length ) == length ) {
                 SG_LOG( SG_IO, SG_INFO, "  Success reading data." );
-                FGFDM2Props( globals->get_props(), &fdm.net );
+                FGFDM2Props( globals->get_props(), &fdm.net, net_byte_order );
             }
         }
     }
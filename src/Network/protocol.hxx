@@ -77,6 +77,19 @@ public:
     virtual bool gen_message();
     virtual bool parse_message();
 
+    // Protocols which can leave reading and writing their channel to the
+    // I/O thread (flightgear::IOThread) implement these. read_record() is
+    // called on the I/O thread and returns the length of the record it read
+    // into buf, or 0 if there was none. gen_message(), get_message() and
+    // parse_record() are called on the main thread. So is write_failed(),
+    // once the I/O thread failed to write a message; it returns what
+    // process() would have returned after that failure.
+    virtual bool supports_io_thread() const { return false; }
+    virtual int read_record( char *buf, int size ) { return 0; }
+    virtual const char *get_message( int& length ) const { length = 0; return nullptr; }
+    virtual bool parse_record( char *record, int length ) { return false; }
+    virtual bool write_failed() { return false; }
+
     // inline std::string get_protocol() const { return protocol_str; }
     // inline void set_protocol( const std::string& str ) { protocol_str = str; }
 
@@ -43,6 +43,7 @@
 
 #include <Main/fg_props.hxx>
 #include <Main/globals.hxx>
+#include <Main/FrameProfiler.hxx>
 #include <Main/sentryIntegration.hxx>
 #include <Scripting/NasalModelData.hxx>
 #include <Scripting/NasalSys.hxx>
@@ -514,6 +515,7 @@ void FGTileMgr::update_queues(bool& isDownloadingScenery)
 // disk.
 void FGTileMgr::update(double)
 {
+    FG_PROFILE_SCOPE("scenery/tile-manager");
     double vis = _visibilityMeters->getDoubleValue();
     schedule_tiles_at(globals->get_view_position(), vis);
 
@@ -70,6 +70,7 @@
 #include "NasalSys_private.hxx"
 #include "NasalUnitTesting.hxx"
 
+#include <Main/FrameProfiler.hxx>
 #include <Main/globals.hxx>
 #include <Main/fg_props.hxx>
 #include <Main/sentryIntegration.hxx>
@@ -206,6 +207,7 @@ public:
       // event manager).
       _isRunning = false;
 
+    FG_PROFILE_SCOPE("nasal/timers");
     naRef *args = nullptr;
     _sys->callMethod(_func, _self, 0, args, naNil() /* locals */);
   }
@@ -1271,6 +1273,7 @@ naRef FGNasalSys::wrappedPropsNode(SGPropertyNode* aProps)
 
 void FGNasalSys::update(double)
 {
+    FG_PROFILE_SCOPE("subsystems/nasal");
     if( NasalClipboard::getInstance() )
         NasalClipboard::getInstance()->update();
 
@@ -1801,7 +1804,10 @@ void FGNasalSys::setTimer(naContext c, int argc, naRef* args)
 
 void FGNasalSys::handleTimer(NasalTimer* t)
 {
-    call(t->handler, 0, 0, naNil());
+    {
+        FG_PROFILE_SCOPE("nasal/timers");
+        call(t->handler, 0, 0, naNil());
+    }
     auto it =  std::find(_nasalTimers.begin(), _nasalTimers.end(), t);
     assert(it != _nasalTimers.end());
     _nasalTimers.erase(it);
@@ -1992,6 +1998,7 @@ FGNasalListener::~FGNasalListener()
 void FGNasalListener::call(SGPropertyNode* which, naRef mode)
 {
     if(_active || _dead) return;
+    FG_PROFILE_SCOPE("nasal/listeners");
     _active++;
     naRef arg[4];
     arg[0] = _nas->propNodeGhost(which);
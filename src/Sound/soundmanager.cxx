@@ -25,6 +25,7 @@
 #include "VoiceSynthesizer.hxx"
 #include "sample_queue.hxx"
 #include "soundmanager.hxx"
+#include <Main/FrameProfiler.hxx>
 #include <Main/globals.hxx>
 #include <Main/fg_props.hxx>
 #include <Viewer/view.hxx>
@@ -161,6 +162,7 @@ bool FGSoundManager::stationaryView() const
 // Actual sound update is triggered by the subsystem manager.
 void FGSoundManager::update(double dt)
 {
+    FG_PROFILE_SCOPE("subsystems/sound");
     if (is_working() && _is_initialized && _sound_working->getBoolValue())
     {
         bool enabled = _sound_enabled->getBoolValue() && !_frozen->getBoolValue();
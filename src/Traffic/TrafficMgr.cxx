@@ -72,6 +72,7 @@
 #include <AIModel/performancedb.hxx>
 
 #include <Airports/airport.hxx>
+#include <Main/FrameProfiler.hxx>
 #include <Main/fg_init.hxx>
 #include <Main/globals.hxx>
 #include <Main/fg_props.hxx>
@@ -717,6 +718,7 @@ bool FGTrafficManager::metarReady(double dt)
 
 void FGTrafficManager::update(double dt)
 {
+    FG_PROFILE_SCOPE("subsystems/traffic-manager");
     if (!enabled)
     {
         if (inited || doingInit)
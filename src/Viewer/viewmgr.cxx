@@ -34,6 +34,7 @@
 #include <simgear/screen/video-encoder.hxx>
 #include <simgear/structure/commands.hxx>
 
+#include <Main/FrameProfiler.hxx>
 #include <Main/fg_props.hxx>
 #include "view.hxx"
 #include "sview.hxx"
@@ -215,6 +216,7 @@ static void videoEncodingError(const std::string& message)
 void
 FGViewMgr::update (double dt)
 {
+    FG_PROFILE_SCOPE("subsystems/view-manager");
     flightgear::View* currentView = get_current_view();
     if (!currentView) {
         return;
@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "MPTrafficGenerator.hxx"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <simgear/constants.h>
+#include <simgear/math/SGMath.hxx>
+
+#include <MultiPlayer/mpmessages.hxx>
+
+namespace FGTestApi {
+
+MPTrafficGenerator::MPTrafficGenerator(const std::string& host, int port,
+                                       int numAircraft, const SGGeod& centre) :
+    _address(host.c_str(), port),
+    _numAircraft(numAircraft),
+    _centre(centre)
+{
+    _socket.open(false);
+}
+
+MPTrafficGenerator::~MPTrafficGenerator()
+{
+    _socket.close();
+}
+
+std::string MPTrafficGenerator::callsign(int index)
+{
+    // callsigns are at most MAX_CALLSIGN_LEN - 1 characters
+    char buf[MAX_CALLSIGN_LEN];
+    snprintf(buf, sizeof(buf), "MP%04d", index % 10000);
+    return buf;
+}
+
+void MPTrafficGenerator::sendFrame(double time, int begin, int end)
+{
+    if (end < 0) {
+        end = _numAircraft;
+    }
+
+    const unsigned numProps = 6;
+    const size_t length = sizeof(T_MsgHdr) + sizeof(T_PositionMsg) + numProps * 2 * sizeof(xdr_data_t);
+
+    for (int i = begin; i < end; ++i) {
+        std::vector<char> packet(length, 0);
+        auto header = reinterpret_cast<T_MsgHdr*>(packet.data());
+        header->Magic = XDR_encode_uint32(MSG_MAGIC);
+        header->Version = XDR_encode_uint32(PROTO_VER);
+        header->MsgId = XDR_encode_uint32(POS_DATA_ID);
+        header->MsgLen = XDR_encode_uint32(length);
+        strncpy(header->Callsign, callsign(i).c_str(), MAX_CALLSIGN_LEN - 1);
+
+        auto pos = reinterpret_cast<T_PositionMsg*>(packet.data() + sizeof(T_MsgHdr));
+        strncpy(pos->Model, "Aircraft/c172p/Models/c172p.xml", MAX_MODEL_NAME_LEN - 1);
+        pos->time = XDR_encode_double(time);
+        pos->lag = XDR_encode_double(0.1);
+
+        // a 2km circle, each aircraft at its own phase and altitude
+        const double angle = (time * 0.05 + i * SG_2PI / _numAircraft);
+        SGGeod geod = SGGeod::fromGeodM(
+            SGGeod::fromDeg(_centre.getLongitudeDeg() + 0.03 * std::cos(angle),
+                            _centre.getLatitudeDeg() + 0.02 * std::sin(angle)),
+            1000.0 + 10.0 * i);
+        SGVec3d cart = SGVec3d::fromGeod(geod);
+        for (unsigned j = 0; j < 3; ++j) {
+            pos->position[j] = XDR_encode_double(cart(j));
+            pos->orientation[j] = XDR_encode_float(0.0f);
+            pos->linearVel[j] = XDR_encode_float(j == 0 ? 50.0f : 0.0f);
+            pos->angularVel[j] = XDR_encode_float(0.0f);
+            pos->linearAccel[j] = XDR_encode_float(0.0f);
+            pos->angularAccel[j] = XDR_encode_float(0.0f);
+        }
+        pos->pad = 0;
+
+        // surface-positions/*-pos-norm, as plain floats
+        auto xdr = reinterpret_cast<xdr_data_t*>(pos + 1);
+        for (unsigned p = 0; p < numProps; ++p) {
+            *xdr++ = XDR_encode_uint32(100 + p);
+            *xdr++ = XDR_encode_float(static_cast<float>(std::sin(time + p)));
+        }
+
+        send(packet);
+    }
+}
+
+void MPTrafficGenerator::sendInvalid()
+{
+    std::vector<char> packet(sizeof(T_MsgHdr) + sizeof(T_PositionMsg), 0);
+    auto header = reinterpret_cast<T_MsgHdr*>(packet.data());
+    header->Magic = XDR_encode_uint32(0xdeadbeef);
+    header->Version = XDR_encode_uint32(PROTO_VER);
+    header->MsgId = XDR_encode_uint32(POS_DATA_ID);
+    header->MsgLen = XDR_encode_uint32(packet.size());
+    send(packet);
+}
+
+void MPTrafficGenerator::send(const std::vector<char>& packet)
+{
+    _socket.sendto(packet.data(), packet.size(), 0, &_address);
+    ++_packetsSent;
+}
+
+} // namespace FGTestApi
@@ -0,0 +1,51 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX_FileComment: Sends synthetic multiplayer position packets over UDP
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <simgear/io/raw_socket.hxx>
+#include <simgear/math/SGGeod.hxx>
+
+namespace FGTestApi {
+
+/**
+ * Plays the part of an MP server with a crowd of pilots: each frame sends one
+ * POS_DATA packet per aircraft, with a few surface position properties, to
+ * the given (normally loopback) address. The aircraft fly in a circle around
+ * a centre point, so successive packets differ.
+ */
+class MPTrafficGenerator
+{
+public:
+    MPTrafficGenerator(const std::string& host, int port, int numAircraft,
+                       const SGGeod& centre);
+    ~MPTrafficGenerator();
+
+    static std::string callsign(int index);
+
+    /// send one packet for each aircraft with index in [begin, end)
+    void sendFrame(double time, int begin = 0, int end = -1);
+
+    /// send a packet with a corrupt header
+    void sendInvalid();
+
+    size_t packetsSent() const { return _packetsSent; }
+
+private:
+    void send(const std::vector<char>& packet);
+
+    simgear::Socket _socket;
+    simgear::IPAddress _address;
+    int _numAircraft;
+    SGGeod _centre;
+    size_t _packetsSent = 0;
+};
+
+} // namespace FGTestApi
@@ -40,6 +40,12 @@ void initNavDataCache()
           SGTimeStamp::sleepForMSec(1000);
           std::cerr << "." << std::flush;
         }
+
+        // report the cold-start cost of each rebuild stage
+        std::cerr << std::endl;
+        for (const auto& phase : cache->rebuildPhaseTimings()) {
+            std::cerr << "  " << phase.first << ": " << phase.second << "ms" << std::endl;
+        }
     }
 }
 
@@ -20,6 +20,7 @@
 #include "test_AIFlightPlan.hxx"
 #include "test_AIManager.hxx"
 #include "test_groundnet.hxx"
+#include "test_motionHistory.hxx"
 #include "test_traffic.hxx"
 #include "test_TrafficMgr.hxx"
 #include "test_submodels.hxx"
@@ -29,6 +30,7 @@
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(AIFlightPlanTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(AIManagerTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(GroundnetTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(MotionHistoryTests, "Unit tests");
 // CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(TrafficTests, "Unit tests");
 // CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(TrafficMgrTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(SubmodelsTests, "Unit tests");
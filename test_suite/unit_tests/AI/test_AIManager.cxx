@@ -37,6 +37,8 @@
 #include <Navaids/NavDataCache.hxx>
 #include <Navaids/navrecord.hxx>
 
+#include <simgear/structure/commands.hxx>
+
 /////////////////////////////////////////////////////////////////////////////
 
 // Set up function for each test.
@@ -129,3 +131,59 @@ void AIManagerTests::testAircraftWaypoints()
     std::unique_ptr<FGAIFlightPlan> aiFP(new FGAIFlightPlan);
     ai->setFlightPlan(std::move(aiFP));    
 }
+
+// test the spatial index and ID lookups
+
+void AIManagerTests::testProximityQueries()
+{
+    auto aim = globals->get_subsystem<FGAIManager>();
+
+    auto eggd = FGAirport::findByIdent("EGGD");
+    auto bikf = FGAirport::findByIdent("BIKF");
+    FGTestApi::setPositionAndStabilise(eggd->geod());
+
+    auto makeStatic = [aim](const std::string& name, const SGGeod& pos) {
+        SGPropertyNode_ptr def(new SGPropertyNode);
+        def->setStringValue("type", "static");
+        def->setStringValue("name", name);
+        def->setDoubleValue("latitude", pos.getLatitudeDeg());
+        def->setDoubleValue("longitude", pos.getLongitudeDeg());
+        def->setDoubleValue("altitude", 100.0);
+        return aim->addObject(def);
+    };
+
+    const SGGeod north = SGGeodesy::direct(eggd->geod(), 0.0, 2000.0);
+    auto a = makeStatic("a", eggd->geod());
+    auto b = makeStatic("b", north);
+    auto c = makeStatic("c", bikf->geod());
+
+    // queries work straight after attach(), before any update
+    auto inRange = aim->findObjectsInRange(SGVec3d::fromGeod(eggd->geod()), 5000.0);
+    CPPUNIT_ASSERT_EQUAL(2, static_cast<int>(inRange.size()));
+    CPPUNIT_ASSERT(inRange.front() == a);
+    CPPUNIT_ASSERT(inRange.back() == b);
+
+    FGTestApi::runForTime(1.0);
+
+    auto nearest = aim->findNearestObjects(SGVec3d::fromGeod(north), 2, 10000.0);
+    CPPUNIT_ASSERT_EQUAL(2, static_cast<int>(nearest.size()));
+    CPPUNIT_ASSERT(nearest.front() == b);
+    CPPUNIT_ASSERT(nearest.back() == a);
+
+    inRange = aim->findObjectsInRange(SGVec3d::fromGeod(bikf->geod()), 1000.0);
+    CPPUNIT_ASSERT_EQUAL(1, static_cast<int>(inRange.size()));
+    CPPUNIT_ASSERT(inRange.front() == c);
+
+    CPPUNIT_ASSERT(aim->getObjectById(b->getID()) == b);
+    CPPUNIT_ASSERT(aim->getObjectFromProperty(c->_getProps()) == c);
+
+    SGPropertyNode_ptr args(new SGPropertyNode);
+    args->setIntValue("id", b->getID());
+    globals->get_commands()->execute("remove-aiobject", args);
+    FGTestApi::runForTime(1.0);
+
+    CPPUNIT_ASSERT(!aim->getObjectById(b->getID()));
+    inRange = aim->findObjectsInRange(SGVec3d::fromGeod(eggd->geod()), 5000.0);
+    CPPUNIT_ASSERT_EQUAL(1, static_cast<int>(inRange.size()));
+    CPPUNIT_ASSERT(inRange.front() == a);
+}
@@ -35,6 +35,7 @@ class AIManagerTests : public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(AIManagerTests);
     CPPUNIT_TEST(testBasic);
     CPPUNIT_TEST(testAircraftWaypoints);
+    CPPUNIT_TEST(testProximityQueries);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -49,4 +50,5 @@ public:
     // The tests.
     void testBasic();
     void testAircraftWaypoints();
+    void testProximityQueries();
 };
@@ -21,9 +21,13 @@
 
 #include "test_groundnet.hxx"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <map>
 #include <memory>
 #include <iostream>
+#include <queue>
 
 
 #include "test_suite/FGTestApi/NavDataCache.hxx"
@@ -45,6 +49,8 @@
 #include <Main/fg_props.hxx>
 #include <Main/globals.hxx>
 
+#include <simgear/timing/timestamp.hxx>
+
 /////////////////////////////////////////////////////////////////////////////
 
 // Set up function for each test.
@@ -67,6 +73,13 @@ void GroundnetTests::setUp()
     FGAirportRef ybbn = FGAirport::getByIdent("YBBN");
     ybbn->testSuiteInjectGroundnetXML(SGPath::fromUtf8(FG_TEST_SUITE_DATA) / "YBBN.groundnet.xml");
 
+    // the big hubs are used for route-finding benchmarks
+    FGAirportRef eddf = FGAirport::getByIdent("EDDF");
+    eddf->testSuiteInjectGroundnetXML(SGPath::fromUtf8(FG_TEST_SUITE_DATA) / "EDDF.groundnet.xml");
+
+    FGAirportRef yssy = FGAirport::getByIdent("YSSY");
+    yssy->testSuiteInjectGroundnetXML(SGPath::fromUtf8(FG_TEST_SUITE_DATA) / "YSSY.groundnet.xml");
+
 
     globals->get_subsystem_mgr()->add<PerformanceDB>();
     globals->get_subsystem_mgr()->add<FGATCManager>();
@@ -120,3 +133,248 @@ void GroundnetTests::testFind()
     CPPUNIT_ASSERT(pushForwardSegment);
     CPPUNIT_ASSERT_EQUAL(1027, pushForwardSegment->getEnd()->getIndex());
 }
+
+namespace {
+
+// the edge penalty of FGGroundNetwork::findShortestRoute
+double referencePenalty(const FGTaxiNode* node)
+{
+    return (node->type() == FGPositioned::PARKING ? 10000 : 0) +
+           (node->getIsOnRunway() ? 1000 : 0);
+}
+
+/**
+ * The taxi graph as seen through the public API, and the plain Dijkstra
+ * search findShortestRoute used before it was replaced by A*.
+ */
+class ReferenceRouter
+{
+public:
+    explicit ReferenceRouter(FGGroundNetwork* network)
+    {
+        // everything reachable from a parking
+        std::queue<FGTaxiNode*> pending;
+        for (const auto& park : network->allParkings()) {
+            add(park, pending);
+        }
+
+        while (!pending.empty()) {
+            FGTaxiNode* node = pending.front();
+            pending.pop();
+            for (const auto& target : network->findSegmentsFrom(node)) {
+                edges[node].push_back(target);
+                add(target, pending);
+            }
+        }
+    }
+
+    // cost of the shortest route, HUGE_VAL if there is none
+    double cost(FGTaxiNode* start, FGTaxiNode* end) const
+    {
+        std::map<FGTaxiNode*, double> score;
+        using Open = std::pair<double, FGTaxiNode*>;
+        std::priority_queue<Open, std::vector<Open>, std::greater<Open>> open;
+        score[start] = 0.0;
+        open.push({0.0, start});
+        while (!open.empty()) {
+            const Open best = open.top();
+            open.pop();
+            if (best.second == end) {
+                return best.first;
+            }
+
+            if (best.first > score[best.second]) {
+                continue;
+            }
+
+            auto it = edges.find(best.second);
+            if (it == edges.end()) {
+                continue;
+            }
+
+            for (const auto& target : it->second) {
+                const double alt = best.first + dist(best.second->cart(), target->cart()) + referencePenalty(target);
+                auto known = score.find(target.ptr());
+                if (known == score.end() || alt < known->second) {
+                    score[target.ptr()] = alt;
+                    open.push({alt, target.ptr()});
+                }
+            }
+        }
+
+        return HUGE_VAL;
+    }
+
+    std::vector<FGTaxiNodeRef> nodes;
+
+private:
+    void add(const FGTaxiNodeRef& node, std::queue<FGTaxiNode*>& pending)
+    {
+        if (edges.insert({node.ptr(), {}}).second) {
+            nodes.push_back(node);
+            pending.push(node.ptr());
+        }
+    }
+
+    std::map<FGTaxiNode*, FGTaxiNodeVector> edges;
+};
+
+// checks that the route is a chain of segments of the network starting
+// and ending at the given nodes, and returns its cost
+double checkedRouteCost(FGGroundNetwork* network, FGTaxiRoute route, FGTaxiNode* start, FGTaxiNode* end)
+{
+    FGTaxiNodeRef node, previous;
+    int segment = 0;
+    double cost = 0.0;
+    route.first();
+    while (route.next(node, &segment)) {
+        if (!previous) {
+            CPPUNIT_ASSERT(node.ptr() == start);
+        } else {
+            FGTaxiSegment* seg = network->findSegment(segment);
+            CPPUNIT_ASSERT(seg);
+            CPPUNIT_ASSERT(seg->getStart().ptr() == previous.ptr());
+            CPPUNIT_ASSERT(seg->getEnd().ptr() == node.ptr());
+            cost += dist(previous->cart(), node->cart()) + referencePenalty(node);
+        }
+        previous = node;
+    }
+
+    CPPUNIT_ASSERT(previous.ptr() == end);
+    return cost;
+}
+
+} // of anonymous namespace
+
+/**
+ * Compares findShortestRoute with a plain Dijkstra search: between
+ * parkings and runway entries in both directions, and between arbitrary
+ * nodes. Routes must exist for the same pairs, be made of connected
+ * segments and cost the same (ties may pick a different route).
+ */
+
+void GroundnetTests::testShortestRouteReference()
+{
+    for (const auto& ident : {"EGPH", "YBBN", "EDDF", "YSSY"}) {
+        FGAirportRef apt = FGAirport::getByIdent(ident);
+        FGGroundNetwork* network = apt->groundNetwork();
+        CPPUNIT_ASSERT_EQUAL(true, network->exists());
+        ReferenceRouter reference(network);
+
+        FGTaxiNodeVector parkings, entries;
+        const FGParkingList& allParkings = network->allParkings();
+        const size_t parkingStep = std::max<size_t>(1, allParkings.size() / 20);
+        for (size_t p = 0; p < allParkings.size(); p += parkingStep) {
+            parkings.push_back(allParkings[p]);
+        }
+
+        for (unsigned int r = 0; r < apt->numRunways(); ++r) {
+            FGTaxiNodeRef entry = network->findNearestNodeOnRunwayEntry(apt->getRunwayByIndex(r)->threshold());
+            if (entry) {
+                entries.push_back(entry);
+            }
+        }
+        CPPUNIT_ASSERT(!entries.empty());
+
+        std::vector<std::pair<FGTaxiNodeRef, FGTaxiNodeRef>> pairs;
+        for (const auto& park : parkings) {
+            for (const auto& entry : entries) {
+                pairs.push_back({park, entry});
+                pairs.push_back({entry, park});
+            }
+        }
+
+        // arbitrary nodes, which also finds pairs without a route on
+        // networks with one-way segments
+        const size_t nodeCount = reference.nodes.size();
+        for (size_t i = 0; i < 200; ++i) {
+            const FGTaxiNodeRef& from = reference.nodes[(i * 7919) % nodeCount];
+            const FGTaxiNodeRef& to = reference.nodes[(i * 104729 + 13) % nodeCount];
+            if (from.ptr() != to.ptr()) {
+                pairs.push_back({from, to});
+            }
+        }
+
+        network->invalidateRouteCache();
+        int unreachable = 0;
+        for (const auto& pair : pairs) {
+            const double expected = reference.cost(pair.first, pair.second);
+            FGTaxiRoute route = network->findShortestRoute(pair.first, pair.second, false);
+            if (expected == HUGE_VAL) {
+                CPPUNIT_ASSERT(route.empty());
+                ++unreachable;
+                continue;
+            }
+
+            CPPUNIT_ASSERT(!route.empty());
+            const double cost = checkedRouteCost(network, route, pair.first, pair.second);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, cost, 1e-6 * expected + 1e-6);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, route.getDistance(), 1e-6 * expected + 1e-6);
+
+            // the cached copy is the same route
+            FGTaxiRoute cached = network->findShortestRoute(pair.first, pair.second, false);
+            CPPUNIT_ASSERT_EQUAL(route.size(), cached.size());
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(cost, checkedRouteCost(network, cached, pair.first, pair.second), 1e-9);
+        }
+
+        std::cout << std::endl << ident << ": " << pairs.size() << " routes checked, "
+                  << unreachable << " without a route" << std::endl;
+    }
+
+    // a node of another ground network can't be reached
+    FGGroundNetwork* egph = FGAirport::getByIdent("EGPH")->groundNetwork();
+    FGTaxiNodeRef foreign = FGAirport::getByIdent("YBBN")->groundNetwork()->findParkingByName("GA1");
+    FGTaxiNodeRef parking = egph->findParkingByName("main-apron10");
+    CPPUNIT_ASSERT(foreign && parking);
+    CPPUNIT_ASSERT(egph->findShortestRoute(parking, foreign, false).empty());
+    CPPUNIT_ASSERT(egph->findShortestRoute(foreign, parking, false).empty());
+}
+
+/**
+ * Routes every parking of the big hubs to every runway entry, once with an
+ * empty route cache and once more with the cache populated. The cached
+ * routes must be identical to the freshly searched ones.
+ */
+
+void GroundnetTests::testShortestRouteBenchmark()
+{
+    for (const auto& ident : {"EDDF", "YSSY"}) {
+        FGAirportRef apt = FGAirport::getByIdent(ident);
+        FGGroundNetwork* network = apt->groundNetwork();
+        CPPUNIT_ASSERT_EQUAL(true, network->exists());
+
+        FGTaxiNodeVector ends;
+        for (unsigned int r = 0; r < apt->numRunways(); ++r) {
+            FGRunwayRef runway = apt->getRunwayByIndex(r);
+            FGTaxiNodeRef entry = network->findNearestNodeOnRunwayEntry(runway->threshold());
+            if (entry) {
+                ends.push_back(entry);
+            }
+        }
+        CPPUNIT_ASSERT(!ends.empty());
+
+        network->invalidateRouteCache();
+        std::vector<int> coldSizes;
+        SGTimeStamp st;
+        st.stamp();
+        for (const auto& park : network->allParkings()) {
+            for (const auto& end : ends) {
+                coldSizes.push_back(network->findShortestRoute(park, end, false).size());
+            }
+        }
+        const double coldMSec = st.elapsedMSec();
+
+        std::vector<int> warmSizes;
+        st.stamp();
+        for (const auto& park : network->allParkings()) {
+            for (const auto& end : ends) {
+                warmSizes.push_back(network->findShortestRoute(park, end, false).size());
+            }
+        }
+        const double warmMSec = st.elapsedMSec();
+
+        CPPUNIT_ASSERT(coldSizes == warmSizes);
+        std::cout << std::endl << ident << ": " << coldSizes.size() << " routes, "
+                  << coldMSec << "ms searched, " << warmMSec << "ms repeated" << std::endl;
+    }
+}
@@ -35,7 +35,9 @@ class GroundnetTests : public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(GroundnetTests);
     CPPUNIT_TEST(testShortestRoute);
     CPPUNIT_TEST(testFind);
-    
+    CPPUNIT_TEST(testShortestRouteReference);
+    CPPUNIT_TEST(testShortestRouteBenchmark);
+
     CPPUNIT_TEST_SUITE_END();
 
 
@@ -49,4 +51,6 @@ public:
     // The tests.
     void testShortestRoute();
     void testFind();
+    void testShortestRouteReference();
+    void testShortestRouteBenchmark();
 };
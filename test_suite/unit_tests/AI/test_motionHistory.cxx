@@ -0,0 +1,274 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "test_motionHistory.hxx"
+
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <simgear/timing/timestamp.hxx>
+
+#include <AIModel/AIMotionHistory.hxx>
+#include <MultiPlayer/mpmessages.hxx>
+
+namespace {
+
+const int NUM_FLOAT_PROPERTIES = 40;
+
+// a packet like the MP manager decodes, with string properties if wanted
+std::unique_ptr<FGExternalMotionData> makeMotion(double time, int numFloats, bool strings)
+{
+    std::unique_ptr<FGExternalMotionData> m(new FGExternalMotionData);
+    m->time = time;
+    m->lag = 0.1;
+    m->position = SGVec3d(time, 0, 0);
+    m->orientation = SGQuatf::unit();
+    m->linearVel = SGVec3f(1, 0, 0);
+    m->angularVel = SGVec3f::zeros();
+    m->linearAccel = SGVec3f::zeros();
+    m->angularAccel = SGVec3f::zeros();
+
+    for (int i = 0; i < numFloats; ++i) {
+        auto p = new FGPropertyData;
+        p->id = 100 + i;
+        p->type = simgear::props::FLOAT;
+        p->float_value = static_cast<float>(time + i);
+        m->properties.push_back(p);
+    }
+
+    if (strings) {
+        auto p = new FGPropertyData;
+        p->id = 10100;
+        p->type = simgear::props::STRING;
+        const std::string s = "t=" + std::to_string(static_cast<int>(time * 10));
+        p->string_value = new char[s.size() + 1];
+        strcpy(p->string_value, s.c_str());
+        m->properties.push_back(p);
+
+        p = new FGPropertyData;
+        p->id = 10101;
+        p->type = simgear::props::INT;
+        p->int_value = static_cast<int>(time * 10);
+        m->properties.push_back(p);
+    }
+
+    return m;
+}
+
+// what FGAIMultiplayer::update() does with the history each frame
+float consume(FGAIMotionHistory& history, double t)
+{
+    size_t next = history.upperBound(t);
+    size_t prev = next;
+    float sum = 0;
+    if (next == history.size()) {
+        --next;
+        --prev;
+    } else if (next > 0) {
+        --prev;
+    }
+
+    const auto& s = history[next];
+    const auto* props = history.properties(s);
+    for (uint32_t i = 0; i < s.numProperties; ++i) {
+        if (props[i].type == simgear::props::FLOAT) {
+            sum += props[i].float_value;
+        }
+    }
+
+    history.eraseFront(prev);
+    return sum;
+}
+
+} // anonymous namespace
+
+
+// Set up function for each test.
+void MotionHistoryTests::setUp()
+{
+}
+
+
+// Clean up after each test.
+void MotionHistoryTests::tearDown()
+{
+}
+
+
+void MotionHistoryTests::testOrdering()
+{
+    FGAIMotionHistory history;
+    CPPUNIT_ASSERT(history.empty());
+
+    for (double t : {1.0, 2.0, 4.0, 3.0, 0.5}) {
+        history.add(t, *makeMotion(t, 0, false));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5), history.size());
+    const double expected[] = {0.5, 1.0, 2.0, 3.0, 4.0};
+    for (size_t i = 0; i < 5; ++i) {
+        CPPUNIT_ASSERT_EQUAL(expected[i], history[i].key);
+        CPPUNIT_ASSERT_EQUAL(expected[i], history[i].position.x());
+    }
+
+    // a sample with an existing time replaces it
+    auto replacement = makeMotion(2.0, 0, false);
+    replacement->position = SGVec3d(42, 0, 0);
+    history.add(2.0, *replacement);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5), history.size());
+    CPPUNIT_ASSERT_EQUAL(42.0, history[2].position.x());
+
+    // upper bound, searching forwards and backwards from the cursor
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), history.upperBound(0.1));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), history.upperBound(1.5));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), history.upperBound(2.0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5), history.upperBound(9.0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), history.upperBound(0.5));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), history.upperBound(3.5));
+
+    history.eraseFront(2);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), history.size());
+    CPPUNIT_ASSERT_EQUAL(2.0, history.front().key);
+    CPPUNIT_ASSERT_EQUAL(4.0, history.back().key);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), history.upperBound(3.5));
+
+    // the key can differ from the packet time (simple-time compensation)
+    history.add(10.0, *makeMotion(7.0, 0, false));
+    CPPUNIT_ASSERT_EQUAL(10.0, history.back().key);
+    CPPUNIT_ASSERT_EQUAL(7.0, history.back().time);
+
+    history.clear();
+    CPPUNIT_ASSERT(history.empty());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), history.upperBound(1.0));
+}
+
+
+void MotionHistoryTests::testProperties()
+{
+    FGAIMotionHistory history;
+
+    // enough samples to wrap and grow the rings several times, consuming
+    // some of them as we go
+    double t = 0;
+    for (int i = 0; i < 1000; ++i) {
+        t += 0.05;
+        const bool late = (i % 7 == 3);
+        const double time = late ? t - 0.075 : t;
+        history.add(time, *makeMotion(time, 1 + i % NUM_FLOAT_PROPERTIES, true));
+
+        if (i % 5 == 0) {
+            size_t prev = history.upperBound(t - 1.0);
+            if (prev > 0) {
+                history.eraseFront(prev - 1);
+            }
+        }
+
+        for (size_t j = 0; j < history.size(); ++j) {
+            const auto& s = history[j];
+            if (j > 0) {
+                CPPUNIT_ASSERT(history[j - 1].key < s.key);
+            }
+
+            CPPUNIT_ASSERT(s.numProperties >= 3);
+            const auto* props = history.properties(s);
+            const uint32_t numFloats = s.numProperties - 2;
+            for (uint32_t k = 0; k < numFloats; ++k) {
+                CPPUNIT_ASSERT_EQUAL(100u + k, props[k].id);
+                CPPUNIT_ASSERT_EQUAL(static_cast<float>(s.time + k), props[k].float_value);
+            }
+
+            const auto& str = props[numFloats];
+            const std::string expected = "t=" + std::to_string(static_cast<int>(s.time * 10));
+            CPPUNIT_ASSERT_EQUAL(10100u, str.id);
+            CPPUNIT_ASSERT_EQUAL(expected, std::string(history.stringValue(str)));
+            CPPUNIT_ASSERT_EQUAL(static_cast<int>(s.time * 10), props[numFloats + 1].int_value);
+        }
+    }
+}
+
+
+// 500 pilots sending at 20Hz, viewed at 60Hz, for a minute. Compares the
+// ring with the std::map the history used to be kept in.
+void MotionHistoryTests::testManyPilots()
+{
+    const int numPilots = 500;
+    const int frames = 60 * 60;
+    const double frameDt = 1.0 / 60;
+
+    std::vector<FGAIMotionHistory> histories(numPilots);
+    std::vector<std::map<double, FGExternalMotionData>> maps(numPilots);
+
+    double ringUSec = 0, mapUSec = 0;
+    double ringSum = 0, mapSum = 0;
+    SGTimeStamp st;
+    for (int frame = 0; frame < frames; ++frame) {
+        const double now = frame * frameDt;
+
+        // every third frame, each pilot sends a packet
+        for (int p = frame % 3; p < numPilots; p += 3) {
+            auto m = makeMotion(now, NUM_FLOAT_PROPERTIES, p % 10 == 0);
+
+            st.stamp();
+            histories[p].add(now, *m);
+            ringUSec += st.elapsedUSec();
+
+            st.stamp();
+            maps[p][now] = *m;
+            m->properties.clear(); // the map owns them now
+            mapUSec += st.elapsedUSec();
+        }
+
+        // and everybody is drawn, a little in the past
+        const double t = now - 0.1;
+        st.stamp();
+        for (auto& h : histories) {
+            if (!h.empty()) {
+                ringSum += consume(h, t);
+            }
+        }
+        ringUSec += st.elapsedUSec();
+
+        st.stamp();
+        for (auto& m : maps) {
+            if (m.empty()) {
+                continue;
+            }
+
+            auto nextIt = m.upper_bound(t);
+            auto prevIt = nextIt;
+            if (nextIt == m.end()) {
+                --nextIt;
+                --prevIt;
+            } else if (nextIt != m.begin()) {
+                --prevIt;
+            }
+            float sum = 0;
+            for (auto prop : nextIt->second.properties) {
+                if (prop->type == simgear::props::FLOAT) {
+                    sum += prop->float_value;
+                }
+            }
+            mapSum += sum;
+            m.erase(m.begin(), prevIt);
+        }
+        mapUSec += st.elapsedUSec();
+    }
+
+    const double pilotFrames = static_cast<double>(frames) * numPilots;
+    std::cout << "\nMotion history, " << numPilots << " pilots: ring "
+              << ringUSec * 1000.0 / pilotFrames << " ns, map "
+              << mapUSec * 1000.0 / pilotFrames << " ns per pilot per frame" << std::endl;
+
+    // both saw the same data
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(mapSum, ringSum, std::fabs(mapSum) * 1e-9);
+    for (int p = 0; p < numPilots; ++p) {
+        CPPUNIT_ASSERT_EQUAL(maps[p].size(), histories[p].size());
+    }
+}
@@ -0,0 +1,33 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+// The multiplayer motion history unit tests.
+class MotionHistoryTests : public CppUnit::TestFixture
+{
+    // Set up the test suite.
+    CPPUNIT_TEST_SUITE(MotionHistoryTests);
+    CPPUNIT_TEST(testOrdering);
+    CPPUNIT_TEST(testProperties);
+    CPPUNIT_TEST(testManyPilots);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    // Set up function for each test.
+    void setUp();
+
+    // Clean up after each test.
+    void tearDown();
+
+    // The tests.
+    void testOrdering();
+    void testProperties();
+    void testManyPilots();
+};
@@ -0,0 +1,11 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "test_continuous.hxx"
+#include "test_replayStore.hxx"
+
+// Set up the unit tests.
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ContinuousRecordingTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ReplayStoreTests, "Unit tests");
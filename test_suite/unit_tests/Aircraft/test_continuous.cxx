@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "test_continuous.hxx"
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include <simgear/misc/sg_path.hxx>
+#include <simgear/timing/timestamp.hxx>
+
+#include <Aircraft/continuous.hxx>
+#include <Main/fg_props.hxx>
+#include <Main/globals.hxx>
+
+
+// Set up function for each test.
+void ContinuousRecordingTests::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("continuous-recording");
+}
+
+
+// Clean up after each test.
+void ContinuousRecordingTests::tearDown()
+{
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+
+void ContinuousRecordingTests::testWriterThread()
+{
+    SGPropertyNode_ptr config = new SGPropertyNode;
+    config->addChild("data")->setStringValue("signals");
+    config->addChild("data")->setStringValue("multiplayer");
+
+    const int frameCount = 2000;
+    std::vector<FGReplayData> frames(frameCount);
+    for (int i = 0; i < frameCount; ++i) {
+        FGReplayData& frame = frames[i];
+        frame.sim_time = i / 60.0;
+        frame.raw_data.resize(8192);
+        for (size_t j = 0; j < frame.raw_data.size(); ++j) {
+            frame.raw_data[j] = static_cast<char>((j < 256) ? i * j : j);
+        }
+        if (i % 10 == 0) {
+            frame.multiplayer_messages.push_back(
+                std::make_shared<std::vector<char>>(200, static_cast<char>(i)));
+        }
+    }
+
+    // Returns time spent in the main thread.
+    auto record = [&](const SGPath& path, bool writerThread) {
+        Continuous continuous(nullptr);
+        continuous.m_out_config = config;
+        continuous.m_out_compression = 1;
+        continuous.m_out.open(path.c_str(), std::ofstream::binary | std::ofstream::trunc);
+        CPPUNIT_ASSERT(continuous.m_out.good());
+        if (writerThread) {
+            // big enough that nothing is dropped
+            continuousStartWriter(continuous, frameCount);
+        }
+
+        SGTimeStamp st;
+        st.stamp();
+        for (auto& frame : frames) {
+            CPPUNIT_ASSERT(continuousRecordFrame(continuous, &frame));
+        }
+        const double msec = st.elapsedMSec();
+
+        continuousStopWriter(continuous);
+        continuous.m_out.close();
+        return msec;
+    };
+
+    auto readFile = [](const SGPath& path) {
+        std::ifstream in(path.c_str(), std::ifstream::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+
+    const SGPath directPath = globals->get_fg_home() / "continuous-direct.fgtape";
+    const SGPath threadedPath = globals->get_fg_home() / "continuous-threaded.fgtape";
+    const double directMSec = record(directPath, false);
+    const double threadedMSec = record(threadedPath, true);
+
+    // the writer thread must produce exactly the same file
+    const auto direct = readFile(directPath);
+    const auto threaded = readFile(threadedPath);
+    CPPUNIT_ASSERT(!direct.empty());
+    CPPUNIT_ASSERT(direct == threaded);
+
+    CPPUNIT_ASSERT_EQUAL(frameCount, fgGetInt("/sim/replay/continuous-writer/written-frames"));
+    CPPUNIT_ASSERT_EQUAL(0, fgGetInt("/sim/replay/continuous-writer/dropped-frames"));
+    CPPUNIT_ASSERT_EQUAL(0, fgGetInt("/sim/replay/continuous-writer/queued-frames"));
+
+    std::cout << std::endl << "continuous recording, main thread time per frame: "
+              << directMSec * 1000 / frameCount << "us direct, "
+              << threadedMSec * 1000 / frameCount << "us with writer thread" << std::endl;
+
+    directPath.remove();
+    threadedPath.remove();
+}
@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "test_replayStore.hxx"
+
+#include <cmath>
+#include <iostream>
+
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include <Aircraft/replay-store.hxx>
+
+
+namespace {
+
+const size_t recordSize = 512;
+const double frameDt = 1.0 / 60;
+
+// A frame where only the first few signals change, like a real recording
+// where most of the aircraft state is constant from one frame to the next.
+FGReplayData makeFrame(int i)
+{
+    FGReplayData frame;
+    frame.sim_time = i * frameDt;
+    frame.raw_data.resize(recordSize);
+    for (size_t j = 0; j < recordSize; ++j) {
+        frame.raw_data[j] = (j < 64) ? static_cast<char>((i * (j + 1)) & 0xff) : static_cast<char>(j);
+    }
+
+    if (i % 10 == 0) {
+        frame.multiplayer_messages.push_back(
+            std::make_shared<std::vector<char>>(20 + i % 7, static_cast<char>(i)));
+    }
+    return frame;
+}
+
+void checkFrame(const FGReplayData* frame, int i)
+{
+    CPPUNIT_ASSERT(frame);
+    const FGReplayData expected = makeFrame(i);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.sim_time, frame->sim_time, 1e-9);
+    CPPUNIT_ASSERT(expected.raw_data == frame->raw_data);
+    CPPUNIT_ASSERT_EQUAL(expected.multiplayer_messages.size(), frame->multiplayer_messages.size());
+    for (size_t m = 0; m < expected.multiplayer_messages.size(); ++m) {
+        CPPUNIT_ASSERT(*expected.multiplayer_messages[m] == *frame->multiplayer_messages[m]);
+    }
+}
+
+} // namespace
+
+
+// Set up function for each test.
+void ReplayStoreTests::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("replay-store");
+}
+
+
+// Clean up after each test.
+void ReplayStoreTests::tearDown()
+{
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+
+void ReplayStoreTests::testRoundTrip()
+{
+    const int frameCount = 3000;
+    FGReplayFrameStore store;
+    store.configure(64, 1024 * 1024 * 1024);
+    for (int i = 0; i < frameCount; ++i) {
+        store.push_back(makeFrame(i));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(frameCount), store.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, store.front_time(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL((frameCount - 1) * frameDt, store.back_time(), 1e-9);
+
+    int i = 0;
+    CPPUNIT_ASSERT(store.forEach([&i](const FGReplayData& frame) {
+        checkFrame(&frame, i++);
+        return true;
+    }));
+    CPPUNIT_ASSERT_EQUAL(frameCount, i);
+
+    const size_t rawBytes = frameCount * recordSize;
+    std::cout << std::endl << "replay store: " << frameCount << " frames, "
+              << store.bytes() << " bytes (" << rawBytes << " uncompressed)" << std::endl;
+    CPPUNIT_ASSERT(store.bytes() < rawBytes / 4);
+}
+
+
+void ReplayStoreTests::testSeek()
+{
+    const int frameCount = 1000;
+    FGReplayFrameStore store;
+    store.configure(32, 1024 * 1024 * 1024);
+    for (int i = 0; i < frameCount; ++i) {
+        store.push_back(makeFrame(i));
+    }
+
+    FGReplayData* older = nullptr;
+    FGReplayData* newer = nullptr;
+
+    // before the first frame
+    CPPUNIT_ASSERT(store.find(-1.0, older, newer));
+    CPPUNIT_ASSERT(!older);
+    checkFrame(newer, 0);
+
+    // after the last frame
+    CPPUNIT_ASSERT(store.find(frameCount * frameDt, older, newer));
+    checkFrame(older, frameCount - 1);
+    CPPUNIT_ASSERT(!newer);
+
+    // forwards, backwards and random access, including across keyframes
+    auto checkBetween = [&](int i) {
+        CPPUNIT_ASSERT(store.find((i + 0.5) * frameDt, older, newer));
+        checkFrame(older, i);
+        checkFrame(newer, i + 1);
+    };
+    for (int i = 0; i < frameCount - 1; ++i) {
+        checkBetween(i);
+    }
+    for (int i = frameCount - 2; i >= 0; --i) {
+        checkBetween(i);
+    }
+    for (int i : {31, 500, 32, 999 - 1, 0, 63, 64, 700}) {
+        checkBetween(i);
+    }
+
+    // exact frame times
+    CPPUNIT_ASSERT(store.find(64 * frameDt, older, newer));
+    checkFrame(older, 64);
+}
+
+
+void ReplayStoreTests::testMemoryBudget()
+{
+    const size_t budget = 64 * 1024;
+    FGReplayFrameStore store;
+    store.configure(64, budget);
+    const int frameCount = 20000;
+    for (int i = 0; i < frameCount; ++i) {
+        store.push_back(makeFrame(i));
+    }
+
+    // The oldest chunks are dropped; the open chunk is not counted against
+    // the budget until it is compressed.
+    CPPUNIT_ASSERT(store.bytes() <= budget + 64 * (recordSize + 64));
+    CPPUNIT_ASSERT(store.size() < static_cast<size_t>(frameCount));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL((frameCount - 1) * frameDt, store.back_time(), 1e-9);
+
+    // whatever is left is still intact
+    const int first = static_cast<int>(std::lround(store.front_time() / frameDt));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(frameCount - first), store.size());
+    FGReplayData* older = nullptr;
+    FGReplayData* newer = nullptr;
+    CPPUNIT_ASSERT(store.find((first + 100.5) * frameDt, older, newer));
+    checkFrame(older, first + 100);
+    checkFrame(newer, first + 101);
+
+    store.clear();
+    CPPUNIT_ASSERT(store.empty());
+    CPPUNIT_ASSERT(!store.find(0.0, older, newer));
+}
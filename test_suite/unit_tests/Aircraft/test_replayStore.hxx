@@ -0,0 +1,33 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+// Tests for the compressed in-memory replay frame store.
+class ReplayStoreTests : public CppUnit::TestFixture
+{
+    // Set up the test suite.
+    CPPUNIT_TEST_SUITE(ReplayStoreTests);
+    CPPUNIT_TEST(testRoundTrip);
+    CPPUNIT_TEST(testSeek);
+    CPPUNIT_TEST(testMemoryBudget);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    // Set up function for each test.
+    void setUp();
+
+    // Clean up after each test.
+    void tearDown();
+
+    // The tests.
+    void testRoundTrip();
+    void testSeek();
+    void testMemoryBudget();
+};
@@ -21,9 +21,16 @@
 
 #include "test_airport.hxx"
 
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 #include <memory>
+#include <string_view>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
 
 #include "test_suite/FGTestApi/NavDataCache.hxx"
 #include "test_suite/FGTestApi/TestDataLogger.hxx"
@@ -31,6 +38,7 @@
 
 #include <simgear/math/sg_geodesy.hxx>
 #include <simgear/math/SGGeod.hxx>
+#include <simgear/timing/timestamp.hxx>
 #include <AIModel/AIAircraft.hxx>
 #include <AIModel/AIFlightPlan.hxx>
 #include <AIModel/AIManager.hxx>
@@ -38,6 +46,7 @@
 
 #include <Airports/airport.hxx>
 #include <Airports/airportdynamicsmanager.hxx>
+#include <Airports/apt_loader.hxx>
 #include <Airports/runways.hxx>
 #include <Traffic/TrafficMgr.hxx>
 #include <Time/TimeManager.hxx>
@@ -47,6 +56,8 @@
 #include <Main/fg_props.hxx>
 #include <Main/globals.hxx>
 
+#include <Navaids/NavDataCache.hxx>
+
 /////////////////////////////////////////////////////////////////////////////
 
 // Set up function for each test.
@@ -82,3 +93,87 @@ void AirportTests::testAirport()
     CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Distance between the runway start and point on centerline should be runway length", length, calculated, 1);
 
 }
+
+void AirportTests::testAptDatTokenizer()
+{
+    using namespace flightgear::aptdat;
+    std::vector<std::string_view> fields;
+
+    splitFields("  100 45.72 1 0 0.25\t\t1 3 0 01R\r", fields);
+    CPPUNIT_ASSERT_EQUAL((size_t) 9, fields.size());
+    CPPUNIT_ASSERT(fields[0] == "100");
+    CPPUNIT_ASSERT(fields[4] == "0.25");
+    CPPUNIT_ASSERT(fields[8] == "01R");
+
+    // the rest of the line is kept as-is after 'maxSplit' fields
+    splitFields("110 1 0.25 150.00 Main  apron  (north)", fields, 4);
+    CPPUNIT_ASSERT_EQUAL((size_t) 5, fields.size());
+    CPPUNIT_ASSERT(fields[4] == "Main  apron  (north)");
+
+    splitFields(" \t\r", fields);
+    CPPUNIT_ASSERT(fields.empty());
+
+    // same results as atof() / atoi() for what apt.dat contains
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-33.94611100, parseDouble("-33.94611100"), 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(151.17722200, parseDouble("+151.17722200"), 1e-12);
+    CPPUNIT_ASSERT_EQUAL(0.0, parseDouble("x"));
+    CPPUNIT_ASSERT_EQUAL(1302, parseInt("1302 datum_lat"));
+    CPPUNIT_ASSERT_EQUAL(17, parseInt("  17\r"));
+    CPPUNIT_ASSERT_EQUAL(-4, parseInt("-4"));
+    CPPUNIT_ASSERT_EQUAL(0, parseInt(""));
+}
+
+/**
+ * @brief Parse every row of the default apt.dat with APTLoader
+ *
+ * The loader has no cache, so it runs the same scan and row parsing as a
+ * cache rebuild but stores nothing. Prints the throughput of each step and
+ * the peak RSS of the test process.
+ */
+void AirportTests::testAptDatParseBenchmark()
+{
+    const SGPath aptDat = globals->get_fg_root() / "Airports" / "apt.dat.gz";
+    if (!aptDat.exists()) {
+        std::cout << std::endl << "No " << aptDat << ", skipping apt.dat benchmark" << std::endl;
+        return;
+    }
+
+    SGTimeStamp st;
+    st.stamp();
+    std::string contents = flightgear::NavDataCache::readDatFileContents(aptDat, true);
+    const double readSec = st.elapsedMSec() / 1000.0;
+    const std::size_t lines = std::count(contents.begin(), contents.end(), '\n');
+    CPPUNIT_ASSERT(lines > 0);
+
+    flightgear::APTLoader loader(nullptr);
+    st.stamp();
+    loader.readAptDatFile(aptDat, std::move(contents), 0, aptDat.sizeInBytes());
+    const double scanSec = st.elapsedMSec() / 1000.0;
+
+    st.stamp();
+    loader.loadAirports();
+    const double parseSec = st.elapsedMSec() / 1000.0;
+
+    auto linesPerSec = [lines](double sec) {
+        return static_cast<std::size_t>(lines / std::max(sec, 1e-6));
+    };
+
+    std::cout << std::endl << aptDat << ": " << lines << " lines, read "
+              << readSec << "s, scan " << scanSec << "s ("
+              << linesPerSec(scanSec) << " lines/s), parse " << parseSec
+              << "s (" << linesPerSec(parseSec) << " lines/s), "
+              << linesPerSec(scanSec + parseSec) << " lines/s overall" << std::endl;
+
+#if !defined(_WIN32)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        // kilobytes on Linux, bytes on macOS
+#if defined(SG_MAC)
+        const long peakKb = usage.ru_maxrss / 1024;
+#else
+        const long peakKb = usage.ru_maxrss;
+#endif
+        std::cout << "peak RSS: " << peakKb / 1024 << "MB" << std::endl;
+    }
+#endif
+}
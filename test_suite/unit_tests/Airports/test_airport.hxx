@@ -34,6 +34,8 @@ class AirportTests : public CppUnit::TestFixture
     // Set up the test suite.
     CPPUNIT_TEST_SUITE(AirportTests);
     CPPUNIT_TEST(testAirport);
+    CPPUNIT_TEST(testAptDatTokenizer);
+    CPPUNIT_TEST(testAptDatParseBenchmark);
     CPPUNIT_TEST_SUITE_END();
 
 
@@ -46,4 +48,6 @@ public:
 
     // The tests.
     void testAirport();
+    void testAptDatTokenizer();
+    void testAptDatParseBenchmark();
 };
@@ -19,12 +19,24 @@
 
 #include "test_ls_matrix.hxx"
 #include "testAeroElement.hxx"
+#include "testJSBSimChildFDMs.hxx"
+#include "testJSBSimFunction.hxx"
+#include "testJSBSimTable.hxx"
+#include "testJSBSimWorkerPool.hxx"
 #include "testYASimAtmosphere.hxx"
 #include "testYASimGear.hxx"
+#include "testYASimSolverCache.hxx"
+#include "testYASimSurfaceBatch.hxx"
 
 
 // Set up the unit tests.
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(AeroElementTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(JSBSimChildFDMTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(JSBSimFunctionTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(JSBSimTableTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(JSBSimWorkerPoolTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(LaRCSimMatrixTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(YASimAtmosphereTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(YASimGearTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(YASimSolverCacheTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(YASimSurfaceBatchTests, "Unit tests");
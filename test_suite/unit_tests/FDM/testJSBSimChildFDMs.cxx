@@ -0,0 +1,316 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "testJSBSimChildFDMs.hxx"
+
+#include <cmath>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include "FDM/JSBSim/FGFDMExec.h"
+#include "FDM/JSBSim/FGWorkerPool.h"
+#include "FDM/JSBSim/initialization/FGInitialCondition.h"
+#include "FDM/JSBSim/input_output/FGPropertyManager.h"
+
+#include <Main/globals.hxx>
+
+#include <simgear/io/iostreams/sgstream.hxx>
+#include <simgear/misc/sg_dir.hxx>
+
+using namespace JSBSim;
+
+namespace {
+
+const int CHILD_COUNT = 4;
+
+const char* metricsXML = R"(
+  <metrics>
+    <wingarea unit="FT2">174</wingarea>
+    <wingspan unit="FT">36</wingspan>
+    <chord unit="FT">4.9</chord>
+    <htailarea unit="FT2">22</htailarea>
+    <htailarm unit="FT">16</htailarm>
+    <vtailarea unit="FT2">16</vtailarea>
+    <vtailarm unit="FT">16</vtailarm>
+    <location name="AERORP" unit="IN"><x>40</x><y>0</y><z>0</z></location>
+  </metrics>
+)";
+
+const char* aerodynamicsXML = R"(
+  <ground_reactions/>
+  <aerodynamics>
+    <axis name="LIFT">
+      <function name="aero/force/lift">
+        <product>
+          <property>aero/qbar-psf</property>
+          <property>metrics/Sw-sqft</property>
+          <sum>
+            <value>0.25</value>
+            <product><value>5.0</value><property>aero/alpha-rad</property></product>
+          </sum>
+        </product>
+      </function>
+    </axis>
+    <axis name="DRAG">
+      <function name="aero/force/drag">
+        <product>
+          <property>aero/qbar-psf</property>
+          <property>metrics/Sw-sqft</property>
+          <value>0.04</value>
+        </product>
+      </function>
+    </axis>
+    <axis name="PITCH">
+      <function name="aero/moment/pitch">
+        <product>
+          <property>aero/qbar-psf</property>
+          <property>metrics/Sw-sqft</property>
+          <property>metrics/cbarw-ft</property>
+          <sum>
+            <product><value>-0.8</value><property>aero/alpha-rad</property></product>
+            <product><value>-1.0</value><property>fcs/elevator-pos-rad</property></product>
+          </sum>
+        </product>
+      </function>
+    </axis>
+  </aerodynamics>
+)";
+
+std::string massBalanceXML(double weight)
+{
+    return R"(
+  <mass_balance>
+    <ixx unit="SLUG*FT2">950</ixx>
+    <iyy unit="SLUG*FT2">1350</iyy>
+    <izz unit="SLUG*FT2">1970</izz>
+    <emptywt unit="LBS">)" + std::to_string(weight) + R"(</emptywt>
+    <location name="CG" unit="IN"><x>40</x><y>0</y><z>0</z></location>
+  </mass_balance>
+)";
+}
+
+// The children differ a little, and each has a pitch hold, filters and a
+// random input, which uses the random engine of its own FDM
+std::string childXML(int index)
+{
+    const std::string k = std::to_string(index);
+    return R"(<?xml version="1.0"?>
+<fdm_config name="glider)" + k + R"(" version="2.0" release="ALPHA">)" +
+           metricsXML + massBalanceXML(600 + 100 * index) + aerodynamicsXML + R"(
+  <flight_control name="fcs">
+    <channel name="pitch">
+      <pid name="fcs/pitch-hold">
+        <input>attitude/theta-rad</input>
+        <kp>)" + std::to_string(0.5 + 0.2 * index) + R"(</kp>
+        <ki>0.1</ki>
+        <kd>0.05</kd>
+      </pid>
+      <lag_filter name="fcs/pitch-lag">
+        <input>fcs/pitch-hold</input>
+        <c1>)" + std::to_string(4 + index) + R"(</c1>
+      </lag_filter>
+      <fcs_function name="fcs/gust">
+        <function>
+          <product>
+            <value>0.01</value>
+            <random/>
+          </product>
+        </function>
+      </fcs_function>
+      <summer name="fcs/elevator-sum">
+        <input>fcs/pitch-lag</input>
+        <input>fcs/gust</input>
+        <clipto><min>-0.3</min><max>0.3</max></clipto>
+      </summer>
+      <actuator name="fcs/elevator-actuator">
+        <input>fcs/elevator-sum</input>
+        <rate_limit>0.5</rate_limit>
+        <output>fcs/elevator-pos-rad</output>
+      </actuator>
+      <integrator name="fcs/pitch-integral">
+        <input>fcs/elevator-pos-rad</input>
+        <c1>1</c1>
+      </integrator>
+    </channel>
+  </flight_control>
+</fdm_config>
+)";
+}
+
+std::string parentXML()
+{
+    std::string children;
+    for (int i = 0; i < CHILD_COUNT; ++i) {
+        children += R"(
+  <child name="glider)" + std::to_string(i) + R"(">
+    <location unit="IN"><x>)" + std::to_string(-400 * (i + 1)) + R"(</x><y>0</y><z>0</z></location>
+  </child>)";
+    }
+
+    return std::string(R"(<?xml version="1.0"?>
+<fdm_config name="tug" version="2.0" release="ALPHA">)") +
+           metricsXML + massBalanceXML(1600) + aerodynamicsXML + children + R"(
+</fdm_config>
+)";
+}
+
+void writeFile(const SGPath& path, const std::string& text)
+{
+    simgear::Dir(path.dirPath()).create(0755);
+    sg_ofstream out(path, std::ios::out | std::ios::trunc);
+    out << text;
+}
+
+void collect(SGPropertyNode* node, std::vector<std::pair<std::string, double>>& values)
+{
+    // tied to a bool through an int pointer, so only its first byte is set
+    if (node->getNameString() == "pause") {
+        return;
+    }
+
+    if (node->nChildren() == 0 && node->hasValue()) {
+        values.emplace_back(node->getPath(), node->getDoubleValue());
+    }
+
+    for (int i = 0; i < node->nChildren(); ++i) {
+        collect(node->getChild(i), values);
+    }
+}
+
+// every value in the properties of the FDM and of its children
+std::vector<std::pair<std::string, double>> state(FGFDMExec* fdm)
+{
+    std::vector<std::pair<std::string, double>> values;
+    collect(fdm->GetPropertyManager()->GetNode()->getParent(), values);
+    return values;
+}
+
+void checkSameState(FGFDMExec* expected, FGFDMExec* actual)
+{
+    const auto e = state(expected);
+    const auto a = state(actual);
+    CPPUNIT_ASSERT_EQUAL(e.size(), a.size());
+    for (size_t i = 0; i < e.size(); ++i) {
+        CPPUNIT_ASSERT_EQUAL(e[i].first, a[i].first);
+        if (!(std::isnan(e[i].second) && std::isnan(a[i].second))) {
+            CPPUNIT_ASSERT_EQUAL_MESSAGE(e[i].first, e[i].second, a[i].second);
+        }
+    }
+}
+
+struct ThreadRecorder : SGPropertyChangeListener {
+    void valueChanged(SGPropertyNode*) override
+    {
+        threads.insert(std::this_thread::get_id());
+        ++calls;
+    }
+
+    std::set<std::thread::id> threads;
+    int calls = 0;
+};
+
+} // of anonymous namespace
+
+
+void JSBSimChildFDMTests::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("JSBSimChildFDMs");
+    _debugLevel = FGJSBBase::debug_lvl;
+    FGJSBBase::debug_lvl = 0;
+
+    _dir = globals->get_fg_home() / "JSBSimChildFDMTests";
+    simgear::Dir(_dir).remove(true);
+    writeFile(_dir / "aircraft" / "tug" / "tug.xml", parentXML());
+    for (int i = 0; i < CHILD_COUNT; ++i) {
+        const std::string name = "glider" + std::to_string(i);
+        writeFile(_dir / "aircraft" / name / (name + ".xml"), childXML(i));
+    }
+}
+
+void JSBSimChildFDMTests::tearDown()
+{
+    simgear::Dir(_dir).remove(true);
+    FGJSBBase::debug_lvl = _debugLevel;
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+std::unique_ptr<FGFDMExec> JSBSimChildFDMTests::load(const std::shared_ptr<FGWorkerPool>& pool)
+{
+    std::unique_ptr<FGFDMExec> fdm(new FGFDMExec);
+    fdm->SetWorkerPool(pool);
+    CPPUNIT_ASSERT(fdm->LoadModel(_dir / "aircraft", _dir / "engine", _dir / "systems", "tug"));
+
+    FGInitialCondition* ic = fdm->GetIC();
+    ic->SetAltitudeASLFtIC(5000.0);
+    ic->SetVcalibratedKtsIC(100.0);
+    ic->SetThetaDegIC(2.0);
+    CPPUNIT_ASSERT(fdm->RunIC());
+    return fdm;
+}
+
+
+// Every child element is read, and every child FDM runs
+void JSBSimChildFDMTests::testLoad()
+{
+    auto fdm = load(nullptr);
+    CPPUNIT_ASSERT_EQUAL(CHILD_COUNT, fdm->GetFDMCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(CHILD_COUNT + 1), fdm->EnumerateFDMs().size());
+
+    for (int step = 0; step < 10; ++step) {
+        fdm->Run();
+    }
+
+    for (int i = 0; i < CHILD_COUNT; ++i) {
+        FGFDMExec* child = fdm->GetChildFDM(i)->exec;
+        CPPUNIT_ASSERT_EQUAL("glider" + std::to_string(i), child->GetModelName());
+        CPPUNIT_ASSERT(child->GetSimTime() > 0.0);
+        CPPUNIT_ASSERT(child->GetPropertyManager()->GetNode("fcs/pitch-integral")->getDoubleValue() != 0.0);
+    }
+}
+
+// The children only depend on the state of the parent, so the order they run
+// in doesn't matter: the results are the same to the last bit
+void JSBSimChildFDMTests::testParallelEqualsSerial()
+{
+    auto serial = load(nullptr);
+    for (unsigned int threads : {2, 3, 8}) {
+        auto parallel = load(std::make_shared<FGWorkerPool>(threads));
+        checkSameState(serial.get(), parallel.get());
+    }
+
+    auto parallel = load(std::make_shared<FGWorkerPool>(4));
+    for (int step = 0; step < 240; ++step) {
+        serial->Run();
+        parallel->Run();
+    }
+    checkSameState(serial.get(), parallel.get());
+}
+
+// A child with a listener in its properties runs on the calling thread
+void JSBSimChildFDMTests::testListeners()
+{
+    auto serial = load(nullptr);
+    auto parallel = load(std::make_shared<FGWorkerPool>(4));
+
+    ThreadRecorder recorder;
+    parallel->GetChildFDM(2)->exec->GetPropertyManager()->GetNode("fcs/pitch-lag")->addChangeListener(&recorder);
+
+    for (int step = 0; step < 120; ++step) {
+        serial->Run();
+        parallel->Run();
+    }
+
+    CPPUNIT_ASSERT(recorder.calls > 0);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), recorder.threads.size());
+    CPPUNIT_ASSERT(*recorder.threads.begin() == std::this_thread::get_id());
+    checkSameState(serial.get(), parallel.get());
+}
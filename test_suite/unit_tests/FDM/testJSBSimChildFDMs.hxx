@@ -0,0 +1,40 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <memory>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <simgear/misc/sg_path.hxx>
+
+namespace JSBSim {
+class FGFDMExec;
+class FGWorkerPool;
+}
+
+// Child FDMs run on a worker pool against the serial loop of FGFDMExec::Run()
+struct JSBSimChildFDMTests : CppUnit::TestFixture
+{
+    void setUp();
+
+    void tearDown();
+
+    void testLoad();
+    void testParallelEqualsSerial();
+    void testListeners();
+
+    CPPUNIT_TEST_SUITE(JSBSimChildFDMTests);
+    CPPUNIT_TEST(testLoad);
+    CPPUNIT_TEST(testParallelEqualsSerial);
+    CPPUNIT_TEST(testListeners);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    std::unique_ptr<JSBSim::FGFDMExec> load(const std::shared_ptr<JSBSim::FGWorkerPool>& pool);
+
+    short _debugLevel;
+    SGPath _dir;
+};
@@ -0,0 +1,279 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "testJSBSimFunction.hxx"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include <simgear/xml/easyxml.hxx>
+
+#include "FDM/JSBSim/input_output/FGXMLParse.h"
+#include "FDM/JSBSim/math/FGFunction.h"
+
+using namespace JSBSim;
+
+namespace {
+
+std::mt19937 generator(42);
+
+double random(double min, double max)
+{
+    return std::uniform_real_distribution<double>(min, max)(generator);
+}
+
+// Both functions return the same value for the current inputs, or both throw.
+void checkSame(const FGFunction& compiled, const FGFunction& interpreted)
+{
+    double expected = 0.0, actual = 0.0;
+    bool expectedThrow = false, actualThrow = false;
+
+    try {
+        expected = interpreted.GetValue();
+    } catch (...) {
+        expectedThrow = true;
+    }
+    try {
+        actual = compiled.GetValue();
+    } catch (...) {
+        actualThrow = true;
+    }
+
+    CPPUNIT_ASSERT_EQUAL(expectedThrow, actualThrow);
+    if (std::isnan(expected)) {
+        CPPUNIT_ASSERT(std::isnan(actual));
+    } else {
+        CPPUNIT_ASSERT_EQUAL(expected, actual);
+    }
+}
+
+// Swallows what is written to std::cerr while it exists
+struct QuietErrors
+{
+    std::ostringstream swallowed;
+    std::streambuf* saved;
+
+    QuietErrors() : saved(std::cerr.rdbuf(swallowed.rdbuf())) {}
+    ~QuietErrors() { std::cerr.rdbuf(saved); }
+};
+
+} // of anonymous namespace
+
+
+void JSBSimFunctionTests::setUp()
+{
+    _debugLevel = FGJSBBase::debug_lvl;
+    FGJSBBase::debug_lvl = 0;
+    _fdmex.reset(new FGFDMExec);
+    generator.seed(42);
+
+    FGPropertyManager* pm = _fdmex->GetPropertyManager();
+    for (const char* name : {"test/a", "test/b", "test/c", "test/d"}) {
+        _values.push_back(pm->GetNode(name, true));
+    }
+    for (const char* name : {"test/f", "test/g"}) {
+        _flags.push_back(pm->GetNode(name, true));
+    }
+}
+
+void JSBSimFunctionTests::tearDown()
+{
+    _flags.clear();
+    _values.clear();
+    _fdmex.reset();
+    FGJSBBase::debug_lvl = _debugLevel;
+}
+
+// Random values, with zeros and whole numbers to hit the special cases of
+// quotient, fmod and the comparisons. The flags are mostly 0 or 1, but
+// sometimes not a boolean, which makes a conditional throw if it reads them.
+void JSBSimFunctionTests::setInputs()
+{
+    for (auto& node : _values) {
+        switch (generator() % 8) {
+        case 0:
+            node->setDoubleValue(0.0);
+            break;
+        case 1:
+            node->setDoubleValue(static_cast<int>(generator() % 7) - 3);
+            break;
+        default:
+            node->setDoubleValue(random(-4, 4));
+        }
+    }
+    for (auto& node : _flags) {
+        node->setDoubleValue(generator() % 16 ? generator() % 2 : 0.5);
+    }
+}
+
+// Loads the function in xml compiled and interpreted, and checks that both
+// evaluate the same over random inputs.
+void JSBSimFunctionTests::compare(const std::string& xml)
+{
+    FGXMLParse parser;
+    std::istringstream in(xml);
+    readXML(in, parser);
+    Element* el = parser.GetDocument();
+
+    _fdmex->SetCompileFunctions(true);
+    FGFunction compiled(_fdmex.get(), el);
+    _fdmex->SetCompileFunctions(false);
+    FGFunction interpreted(_fdmex.get(), el);
+
+    CPPUNIT_ASSERT(compiled.GetProgram());
+    CPPUNIT_ASSERT(!interpreted.GetProgram());
+
+    for (unsigned int i=0; i<2000; i++) {
+        setInputs();
+        checkSame(compiled, interpreted);
+    }
+}
+
+void JSBSimFunctionTests::testListOperations()
+{
+    compare("<function><sum><p>test/a</p><p>-test/b</p><v>0.1</v><p>test/c</p></sum></function>");
+    compare("<function><product><v>0.5</v><p>test/a</p><p>test/b</p><p>-test/c</p></product></function>");
+    compare("<function><difference><p>test/a</p><v>0.3</v><p>test/b</p><p>test/c</p></difference></function>");
+    compare("<function><difference><v>1</v><p>test/a</p></difference></function>");
+    compare("<function><min><p>test/a</p><p>test/b</p><v>1.5</v></min></function>");
+    compare("<function><max><p>test/a</p><p>test/b</p><p>test/c</p><p>test/d</p></max></function>");
+    compare("<function><avg><p>test/a</p><v>2</v><p>test/b</p></avg></function>");
+    compare("<function>"
+            "  <sum>"
+            "    <product><p>test/a</p><p>test/b</p></product>"
+            "    <product><v>-2</v><sum><p>test/c</p><v>1</v></sum><p>test/d</p></product>"
+            "    <max><p>test/a</p><avg><p>test/b</p><p>test/c</p></avg></max>"
+            "  </sum>"
+            "</function>");
+}
+
+void JSBSimFunctionTests::testBinaryOperations()
+{
+    // The operand order matters for all of these.
+    compare("<function><quotient><p>test/a</p><p>test/b</p></quotient></function>");
+    compare("<function><quotient><v>1</v><p>test/a</p></quotient></function>");
+    compare("<function><quotient><p>test/a</p><v>3</v></quotient></function>");
+    compare("<function><fmod><p>test/a</p><p>test/b</p></fmod></function>");
+    compare("<function><fmod><v>10</v><p>test/b</p></fmod></function>");
+    compare("<function><fmod><p>test/a</p><v>1.5</v></fmod></function>");
+    compare("<function><pow><p>test/a</p><p>test/b</p></pow></function>");
+    compare("<function><pow><v>2</v><p>test/b</p></pow></function>");
+    compare("<function><atan2><p>test/a</p><p>test/b</p></atan2></function>");
+    // an integer division by zero would trap
+    compare("<function><mod><product><p>test/a</p><v>4</v></product><v>3</v></mod></function>");
+    compare("<function><sum>"
+            "  <lt><p>test/a</p><p>test/b</p></lt>"
+            "  <product><v>2</v><le><p>test/a</p><v>0</v></le></product>"
+            "  <product><v>4</v><gt><v>1</v><p>test/b</p></gt></product>"
+            "  <product><v>8</v><ge><p>test/c</p><p>test/d</p></ge></product>"
+            "  <product><v>16</v><eq><p>test/a</p><p>test/c</p></eq></product>"
+            "  <product><v>32</v><nq><p>test/b</p><p>test/d</p></nq></product>"
+            "</sum></function>");
+}
+
+void JSBSimFunctionTests::testMathFunctions()
+{
+    for (const char* op : {"toradians", "todegrees", "sqrt", "log2", "ln", "log10",
+                           "sign", "exp", "abs", "sin", "cos", "tan", "atan",
+                           "floor", "ceil", "fraction", "integer"}) {
+        std::string tag(op);
+        compare("<function><" + tag + "><product><p>test/a</p><p>test/b</p></product></" + tag + "></function>");
+    }
+    compare("<function><asin><quotient><p>test/a</p><v>4</v></quotient></asin></function>");
+    compare("<function><acos><quotient><p>test/b</p><v>4</v></quotient></acos></function>");
+}
+
+void JSBSimFunctionTests::testLogic()
+{
+    // A flag that isn't a boolean throws where it is read, so the functions
+    // only throw alike if they skip the same arguments.
+    QuietErrors quiet;
+
+    compare("<function><and><p>test/f</p><p>test/g</p></and></function>");
+    compare("<function><or><p>test/f</p><p>test/g</p></or></function>");
+    compare("<function><and><lt><p>test/a</p><v>0</v></lt><p>test/f</p><not><p>test/g</p></not></and></function>");
+    compare("<function><or><gt><p>test/a</p><p>test/b</p></gt><p>test/f</p><p>test/g</p></or></function>");
+    compare("<function>"
+            "  <ifthen>"
+            "    <p>test/f</p>"
+            "    <quotient><p>test/a</p><p>test/b</p></quotient>"
+            "    <ifthen><p>test/g</p><p>test/c</p><v>-1</v></ifthen>"
+            "  </ifthen>"
+            "</function>");
+    compare("<function>"
+            "  <ifthen>"
+            "    <or><p>test/f</p><lt><p>test/a</p><p>test/b</p></lt></or>"
+            "    <and><p>test/g</p><ge><p>test/c</p><v>0</v></ge></and>"
+            "    <not><p>test/g</p></not>"
+            "  </ifthen>"
+            "</function>");
+}
+
+void JSBSimFunctionTests::testInterpolate1D()
+{
+    compare("<function>"
+            "  <interpolate1d>"
+            "    <p>test/a</p>"
+            "    <v>-3</v><v>1</v> <v>-1</v><v>2</v> <v>0</v><v>-0.5</v> <v>2</v><v>4</v>"
+            "  </interpolate1d>"
+            "</function>");
+    compare("<function>"
+            "  <interpolate1d>"
+            "    <product><p>test/a</p><v>2</v></product>"
+            "    <v>-1</v><v>1</v> <v>1</v><v>3</v> <v>3</v><v>2</v>"
+            "  </interpolate1d>"
+            "</function>");
+    // breakpoints and values that change
+    compare("<function>"
+            "  <interpolate1d>"
+            "    <p>test/a</p>"
+            "    <v>-2</v><p>test/b</p> <v>0</v><p>test/c</p> <v>1</v><v>5</v> <v>3</v><p>test/d</p>"
+            "  </interpolate1d>"
+            "</function>");
+}
+
+void JSBSimFunctionTests::testTables()
+{
+    compare("<function><product><p>test/d</p><table>"
+            "  <independentVar>test/a</independentVar>"
+            "  <tableData>"
+            "    -3 0.1\n -1 0.4\n 0 0.3\n 0.5 -0.2\n 2 1.1\n 3 0.9"
+            "  </tableData>"
+            "</table></product></function>");
+    compare("<function><product><v>0.5</v><p>test/c</p><table>"
+            "  <independentVar lookup=\"row\">test/a</independentVar>"
+            "  <independentVar lookup=\"column\">test/b</independentVar>"
+            "  <tableData>"
+            "          -2    0     1     3\n"
+            "    -3   0.1   0.2   0.3   0.4\n"
+            "    -1   0.5  -0.1   0.7   0.2\n"
+            "     0   1.0   0.3  -0.6   0.8\n"
+            "     2   0.2   0.9   0.4  -1.0"
+            "  </tableData>"
+            "</table></product></function>");
+    compare("<function><sum><p>test/d</p><table>"
+            "  <independentVar lookup=\"row\">test/a</independentVar>"
+            "  <independentVar lookup=\"column\">test/b</independentVar>"
+            "  <independentVar lookup=\"table\">test/c</independentVar>"
+            "  <tableData breakPoint=\"-1\">"
+            "          -1    1\n"
+            "    -2   0.1   0.2\n"
+            "     2   0.3   0.4"
+            "  </tableData>"
+            "  <tableData breakPoint=\"0\">"
+            "          -1    1\n"
+            "    -2   0.5   0.6\n"
+            "     2  -0.3   0.8"
+            "  </tableData>"
+            "  <tableData breakPoint=\"2.5\">"
+            "          -2    0    2\n"
+            "    -1   1.5   0.6  -0.2\n"
+            "     0   0.3   0.1   0.9\n"
+            "     3  -0.4   0.7   0.2"
+            "  </tableData>"
+            "</table></sum></function>");
+}
@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "FDM/JSBSim/FGFDMExec.h"
+#include "FDM/JSBSim/input_output/FGPropertyManager.h"
+
+// Compiled functions (FGCompiledFunction) against the tree walk
+struct JSBSimFunctionTests : CppUnit::TestFixture
+{
+    void setUp();
+
+    void tearDown();
+
+    void testListOperations();
+    void testBinaryOperations();
+    void testMathFunctions();
+    void testLogic();
+    void testInterpolate1D();
+    void testTables();
+
+    CPPUNIT_TEST_SUITE(JSBSimFunctionTests);
+    CPPUNIT_TEST(testListOperations);
+    CPPUNIT_TEST(testBinaryOperations);
+    CPPUNIT_TEST(testMathFunctions);
+    CPPUNIT_TEST(testLogic);
+    CPPUNIT_TEST(testInterpolate1D);
+    CPPUNIT_TEST(testTables);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    void compare(const std::string& xml);
+    void setInputs();
+
+    short _debugLevel;
+    std::unique_ptr<JSBSim::FGFDMExec> _fdmex;
+    std::vector<JSBSim::FGPropertyNode_ptr> _values, _flags;
+};
@@ -0,0 +1,386 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "testJSBSimTable.hxx"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <simgear/timing/timestamp.hxx>
+#include <simgear/xml/easyxml.hxx>
+
+#include "FDM/JSBSim/FGJSBBase.h"
+
+using namespace JSBSim;
+
+namespace {
+
+std::mt19937 generator(42);
+
+double random(double min, double max)
+{
+    return std::uniform_real_distribution<double>(min, max)(generator);
+}
+
+// n increasing breakpoints from about start
+std::vector<double> breakpoints(unsigned int n, double start)
+{
+    std::vector<double> bp;
+    double x = start;
+    for (unsigned int i=0; i<n; i++) {
+        x += random(0.1, 2);
+        bp.push_back(x);
+    }
+    return bp;
+}
+
+// The lookup that FGTable did before it bisected: step one breakpoint at
+// a time from the last one.
+struct LinearSearch
+{
+    unsigned int lastRow = 2, lastColumn = 2;
+
+    double lookup(const FGTable& t, double key)
+    {
+        unsigned int n = t.GetNumRows(), r = lastRow;
+        if (key <= t(1, 0)) {
+            lastRow = 2;
+            return t(1, 1);
+        } else if (key >= t(n, 0)) {
+            lastRow = n;
+            return t(n, 1);
+        }
+        while (r > 2 && t(r-1, 0) > key) r--;
+        while (r < n && t(r, 0) < key) r++;
+        lastRow = r;
+
+        double span = t(r, 0) - t(r-1, 0), factor = 1.0;
+        if (span != 0.0) factor = std::min((key - t(r-1, 0)) / span, 1.0);
+        return factor*(t(r, 1) - t(r-1, 1)) + t(r-1, 1);
+    }
+
+    double lookup(const FGTable& t, unsigned int nCols, double rowKey, double colKey)
+    {
+        unsigned int n = t.GetNumRows(), r = lastRow, c = lastColumn;
+        while (r > 2 && t(r-1, 0) > rowKey) r--;
+        while (r < n && t(r, 0) < rowKey) r++;
+        while (c > 2 && t(0, c-1) > colKey) c--;
+        while (c < nCols && t(0, c) < colKey) c++;
+        lastRow = r;
+        lastColumn = c;
+
+        double rFactor = (rowKey - t(r-1, 0)) / (t(r, 0) - t(r-1, 0));
+        double cFactor = (colKey - t(0, c-1)) / (t(0, c) - t(0, c-1));
+        rFactor = std::max(0.0, std::min(rFactor, 1.0));
+        cFactor = std::max(0.0, std::min(cFactor, 1.0));
+
+        double col1 = rFactor*(t(r, c-1) - t(r-1, c-1)) + t(r-1, c-1);
+        double col2 = rFactor*(t(r, c) - t(r-1, c)) + t(r-1, c);
+        return col1 + cFactor*(col2 - col1);
+    }
+};
+
+// Keys that mostly move a little from one lookup to the next, but also jump
+// anywhere (including off the table) and hit breakpoints exactly.
+std::vector<double> keys(const std::vector<double>& bp, unsigned int count, bool exact)
+{
+    std::vector<double> k;
+    double key = bp.front();
+    for (unsigned int i=0; i<count; i++) {
+        switch (generator() % 8) {
+        case 0:
+            key = random(bp.front() - 1, bp.back() + 1);
+            break;
+        case 1:
+            key = exact ? bp[generator() % bp.size()] : random(bp.front(), bp.back());
+            break;
+        default:
+            key += random(-0.3, 0.3);
+        }
+        k.push_back(key);
+    }
+    return k;
+}
+
+FGTable* makeTable1D(const std::vector<double>& rows)
+{
+    FGTable* t = new FGTable(rows.size());
+    for (double r: rows) *t << r << random(-10, 10);
+    return t;
+}
+
+FGTable* makeTable2D(const std::vector<double>& rows, const std::vector<double>& cols)
+{
+    FGTable* t = new FGTable(rows.size(), cols.size());
+    for (double c: cols) *t << c;
+    for (double r: rows) {
+        *t << r;
+        for (unsigned int c=0; c<cols.size(); c++) *t << random(-10, 10);
+    }
+    return t;
+}
+
+// The <tableData> of a 2D table
+std::string tableData(const std::vector<double>& rows, const std::vector<double>& cols)
+{
+    std::ostringstream s;
+    s << std::setprecision(17);
+    for (double c: cols) s << " " << c;
+    s << "\n";
+    for (double r: rows) {
+        s << r;
+        for (unsigned int c=0; c<cols.size(); c++) s << " " << random(-10, 10);
+        s << "\n";
+    }
+    return s.str();
+}
+
+} // of anonymous namespace
+
+
+void JSBSimTableTests::setUp()
+{
+    _debugLevel = FGJSBBase::debug_lvl;
+    FGJSBBase::debug_lvl = 0;
+    _propertyManager.reset(new FGPropertyManager);
+    _parser.reset(new FGXMLParse);
+    generator.seed(42);
+}
+
+void JSBSimTableTests::tearDown()
+{
+    _parser.reset();
+    _propertyManager.reset();
+    FGJSBBase::debug_lvl = _debugLevel;
+}
+
+FGTable* JSBSimTableTests::makeTable(const std::string& xml)
+{
+    std::istringstream in(xml);
+    _parser->reset();
+    readXML(in, *_parser);
+    return new FGTable(_propertyManager.get(), _parser->GetDocument());
+}
+
+void JSBSimTableTests::testLookup1D()
+{
+    for (unsigned int n : {2, 3, 5, 17, 60, 400}) {
+        std::vector<double> bp = breakpoints(n, -10);
+        std::unique_ptr<FGTable> t(makeTable1D(bp));
+        LinearSearch reference;
+
+        for (double key: keys(bp, 5000, true)) {
+            CPPUNIT_ASSERT_EQUAL(reference.lookup(*t, key), t->GetValue(key));
+        }
+    }
+}
+
+void JSBSimTableTests::testLookup2D()
+{
+    for (unsigned int n : {2, 3, 9, 40, 300}) {
+        std::vector<double> rows = breakpoints(n, -5), cols = breakpoints(n/2 + 2, 0);
+        std::unique_ptr<FGTable> t(makeTable2D(rows, cols));
+        LinearSearch reference;
+
+        std::vector<double> rowKeys = keys(rows, 5000, true);
+        std::vector<double> colKeys = keys(cols, 5000, true);
+        for (unsigned int i=0; i<rowKeys.size(); i++) {
+            CPPUNIT_ASSERT_EQUAL(reference.lookup(*t, cols.size(), rowKeys[i], colKeys[i]),
+                                 t->GetValue(rowKeys[i], colKeys[i]));
+        }
+    }
+}
+
+void JSBSimTableTests::testLookup3D()
+{
+    // The sub-tables of a 3D table usually have the same breakpoints, which
+    // are then only searched once, but they don't have to.
+    for (bool shared : {true, false}) {
+        std::vector<double> tables = breakpoints(7, -1);
+        std::vector<double> rows = breakpoints(12, 0), cols = breakpoints(8, 0);
+        std::ostringstream xml;
+        std::vector<std::unique_ptr<FGTable>> subTables;
+        std::vector<LinearSearch> references(tables.size());
+        std::vector<unsigned int> nCols;
+
+        xml << std::setprecision(17)
+            << "<table>\n"
+            << "  <independentVar lookup=\"row\">row</independentVar>\n"
+            << "  <independentVar lookup=\"column\">column</independentVar>\n"
+            << "  <independentVar lookup=\"table\">table</independentVar>\n";
+        for (double b: tables) {
+            if (!shared) cols = breakpoints(4 + generator() % 6, 0);
+            std::string data = tableData(rows, cols);
+            xml << "  <tableData breakPoint=\"" << b << "\">\n" << data << "  </tableData>\n";
+            subTables.emplace_back(makeTable(
+                "<table>\n"
+                "  <independentVar lookup=\"row\">row</independentVar>\n"
+                "  <independentVar lookup=\"column\">column</independentVar>\n"
+                "  <tableData>\n" + data + "  </tableData>\n"
+                "</table>\n"));
+            nCols.push_back(cols.size());
+        }
+        xml << "</table>\n";
+        std::unique_ptr<FGTable> t(makeTable(xml.str()));
+
+        // Random keys, as on a breakpoint either neighbouring sub-table may
+        // be searched and the result may differ in the last bit.
+        for (unsigned int i=0; i<5000; i++) {
+            double rowKey = random(-1, rows.back() + 1);
+            double colKey = random(-1, 14);
+            double tableKey = random(tables.front() - 1, tables.back() + 1);
+
+            double expected;
+            unsigned int r = 1;
+            while (r < tables.size() - 1 && tables[r] < tableKey) r++;
+            if (tableKey <= tables.front()) {
+                expected = references[0].lookup(*subTables[0], nCols[0], rowKey, colKey);
+            } else if (tableKey >= tables.back()) {
+                expected = references.back().lookup(*subTables.back(), nCols.back(), rowKey, colKey);
+            } else {
+                double lower = references[r-1].lookup(*subTables[r-1], nCols[r-1], rowKey, colKey);
+                double upper = references[r].lookup(*subTables[r], nCols[r], rowKey, colKey);
+                double factor = (tableKey - tables[r-1]) / (tables[r] - tables[r-1]);
+                expected = factor*(upper - lower) + lower;
+            }
+
+            CPPUNIT_ASSERT_EQUAL(expected, t->GetValue(rowKey, colKey, tableKey));
+        }
+    }
+}
+
+void JSBSimTableTests::testBatch()
+{
+    std::vector<double> rows = breakpoints(20, -4), cols = breakpoints(7, 0);
+    std::vector<std::unique_ptr<FGTable>> tables1D, tables2D;
+    std::vector<const FGTable*> batch1D, batch2D;
+    for (unsigned int i=0; i<6; i++) {
+        tables1D.emplace_back(makeTable1D(rows));
+        tables2D.emplace_back(makeTable2D(rows, cols));
+        batch1D.push_back(tables1D.back().get());
+        batch2D.push_back(tables2D.back().get());
+    }
+
+    CPPUNIT_ASSERT(tables1D[0]->HasSameBreakpoints(*tables1D[5]));
+    CPPUNIT_ASSERT(tables2D[0]->HasSameBreakpoints(*tables2D[5]));
+    CPPUNIT_ASSERT(!tables1D[0]->HasSameBreakpoints(*tables2D[0]));
+    std::unique_ptr<FGTable> other(makeTable2D(rows, breakpoints(7, 0)));
+    CPPUNIT_ASSERT(!tables2D[0]->HasSameBreakpoints(*other));
+
+    std::vector<LinearSearch> references1D(6), references2D(6);
+    std::vector<double> values;
+    std::vector<double> rowKeys = keys(rows, 2000, false);
+    std::vector<double> colKeys = keys(cols, 2000, false);
+    for (unsigned int k=0; k<rowKeys.size(); k++) {
+        FGTable::GetValues(batch1D, rowKeys[k], values);
+        CPPUNIT_ASSERT_EQUAL(batch1D.size(), values.size());
+        for (unsigned int i=0; i<batch1D.size(); i++) {
+            CPPUNIT_ASSERT_EQUAL(references1D[i].lookup(*batch1D[i], rowKeys[k]), values[i]);
+        }
+
+        FGTable::GetValues(batch2D, rowKeys[k], colKeys[k], values);
+        CPPUNIT_ASSERT_EQUAL(batch2D.size(), values.size());
+        for (unsigned int i=0; i<batch2D.size(); i++) {
+            CPPUNIT_ASSERT_EQUAL(references2D[i].lookup(*batch2D[i], cols.size(), rowKeys[k], colKeys[k]),
+                                 values[i]);
+        }
+    }
+}
+
+void JSBSimTableTests::testBenchmark()
+{
+    const unsigned int count = 200000;
+    std::vector<double> rows = breakpoints(40, -10), cols = breakpoints(12, 0);
+    std::vector<double> tables = breakpoints(6, 0);
+    std::unique_ptr<FGTable> t1(makeTable1D(rows)), t2(makeTable2D(rows, cols));
+
+    std::ostringstream xml;
+    xml << std::setprecision(17) << "<table>\n"
+        << "  <independentVar lookup=\"row\">row</independentVar>\n"
+        << "  <independentVar lookup=\"column\">column</independentVar>\n"
+        << "  <independentVar lookup=\"table\">table</independentVar>\n";
+    for (double b: tables)
+        xml << "  <tableData breakPoint=\"" << b << "\">\n" << tableData(rows, cols) << "  </tableData>\n";
+    xml << "</table>\n";
+    std::unique_ptr<FGTable> t3(makeTable(xml.str()));
+
+    std::vector<std::unique_ptr<FGTable>> coefficients;
+    std::vector<const FGTable*> batch;
+    for (unsigned int i=0; i<8; i++) {
+        coefficients.emplace_back(makeTable2D(rows, cols));
+        batch.push_back(coefficients.back().get());
+    }
+
+    // slowly changing keys, as in flight, and keys jumping around as
+    // during trim
+    std::vector<double> smoothRows, smoothCols, smoothTables;
+    std::vector<double> jumpRows, jumpCols, jumpTables;
+    for (unsigned int i=0; i<count; i++) {
+        double phase = i * 1e-3;
+        smoothRows.push_back(rows.front() + (rows.back() - rows.front()) * 0.5 * (1 + sin(phase)));
+        smoothCols.push_back(cols.front() + (cols.back() - cols.front()) * 0.5 * (1 + cos(phase)));
+        smoothTables.push_back(tables.front() + (tables.back() - tables.front()) * 0.5 * (1 + sin(0.3 * phase)));
+        jumpRows.push_back(random(rows.front(), rows.back()));
+        jumpCols.push_back(random(cols.front(), cols.back()));
+        jumpTables.push_back(random(tables.front(), tables.back()));
+    }
+
+    double sum = 0.0;
+    std::vector<double> values;
+    SGTimeStamp st;
+    auto nsec = [&](const SGTimeStamp& start) {
+        return 1000.0 * (SGTimeStamp::now() - start).toUSecs() / count;
+    };
+
+    for (bool smooth : {true, false}) {
+        const std::vector<double>& r = smooth ? smoothRows : jumpRows;
+        const std::vector<double>& c = smooth ? smoothCols : jumpCols;
+        const std::vector<double>& b = smooth ? smoothTables : jumpTables;
+        LinearSearch linear1D, linear2D;
+
+        st.stamp();
+        for (unsigned int i=0; i<count; i++) sum += linear1D.lookup(*t1, r[i]);
+        double linear1DTime = nsec(st);
+        st.stamp();
+        for (unsigned int i=0; i<count; i++) sum += t1->GetValue(r[i]);
+        double lookup1DTime = nsec(st);
+
+        st.stamp();
+        for (unsigned int i=0; i<count; i++) sum += linear2D.lookup(*t2, cols.size(), r[i], c[i]);
+        double linear2DTime = nsec(st);
+        st.stamp();
+        for (unsigned int i=0; i<count; i++) sum += t2->GetValue(r[i], c[i]);
+        double lookup2DTime = nsec(st);
+
+        st.stamp();
+        for (unsigned int i=0; i<count; i++) sum += t3->GetValue(r[i], c[i], b[i]);
+        double lookup3DTime = nsec(st);
+
+        st.stamp();
+        for (unsigned int i=0; i<count; i++) {
+            for (const FGTable* t: batch) sum += t->GetValue(r[i], c[i]);
+        }
+        double singleTime = nsec(st);
+        st.stamp();
+        for (unsigned int i=0; i<count; i++) {
+            FGTable::GetValues(batch, r[i], c[i], values);
+            for (double v: values) sum += v;
+        }
+        double batchTime = nsec(st);
+
+        std::cout << "FGTable " << (smooth ? "smooth" : "jumping") << " keys (ns per lookup):"
+                  << " 1D " << lookup1DTime << " (linear search " << linear1DTime << "),"
+                  << " 2D " << lookup2DTime << " (linear search " << linear2DTime << "),"
+                  << " 3D " << lookup3DTime << ","
+                  << " 8 2D tables " << batchTime << " (one by one " << singleTime << ")"
+                  << std::endl;
+    }
+
+    CPPUNIT_ASSERT(std::isfinite(sum));
+}
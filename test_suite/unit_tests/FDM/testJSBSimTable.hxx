@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <memory>
+#include <string>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "FDM/JSBSim/input_output/FGPropertyManager.h"
+#include "FDM/JSBSim/input_output/FGXMLParse.h"
+#include "FDM/JSBSim/math/FGTable.h"
+
+struct JSBSimTableTests : CppUnit::TestFixture
+{
+    void setUp();
+
+    void tearDown();
+
+    void testLookup1D();
+    void testLookup2D();
+    void testLookup3D();
+    void testBatch();
+    void testBenchmark();
+
+    CPPUNIT_TEST_SUITE(JSBSimTableTests);
+    CPPUNIT_TEST(testLookup1D);
+    CPPUNIT_TEST(testLookup2D);
+    CPPUNIT_TEST(testLookup3D);
+    CPPUNIT_TEST(testBatch);
+    CPPUNIT_TEST(testBenchmark);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    JSBSim::FGTable* makeTable(const std::string& xml);
+
+    short _debugLevel;
+    std::unique_ptr<JSBSim::FGPropertyManager> _propertyManager;
+    std::unique_ptr<JSBSim::FGXMLParse> _parser;
+};
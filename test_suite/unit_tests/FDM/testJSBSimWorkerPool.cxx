@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "testJSBSimWorkerPool.hxx"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "FDM/JSBSim/FGWorkerPool.h"
+
+using JSBSim::FGWorkerPool;
+
+
+void JSBSimWorkerPoolTests::testRun()
+{
+    for (unsigned int threads : {1, 2, 5}) {
+        FGWorkerPool pool(threads);
+        CPPUNIT_ASSERT_EQUAL(threads, pool.GetNumThreads());
+
+        // every task runs exactly once per batch, whatever the batch size
+        std::vector<int> runs(40, 0);
+        for (unsigned int count=0; count<=runs.size(); count++) {
+            pool.Run(count, [&runs](unsigned int i) { runs[i]++; });
+        }
+        for (unsigned int i=0; i<runs.size(); i++) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<int>(runs.size() - i), runs[i]);
+        }
+    }
+}
+
+void JSBSimWorkerPoolTests::testNested()
+{
+    // e.g. FDMs with child FDMs, all run by the same pool
+    FGWorkerPool pool(4);
+    std::vector<std::vector<int>> runs(6, std::vector<int>(3, 0));
+
+    pool.Run(runs.size(), [&](unsigned int i) {
+        pool.Run(runs[i].size(), [&](unsigned int j) { runs[i][j]++; });
+    });
+
+    for (const auto& children : runs) {
+        for (int r : children) CPPUNIT_ASSERT_EQUAL(1, r);
+    }
+}
+
+void JSBSimWorkerPoolTests::testExceptions()
+{
+    for (unsigned int threads : {1, 3}) {
+        FGWorkerPool pool(threads);
+        std::vector<int> runs(10, 0);
+
+        CPPUNIT_ASSERT_THROW(pool.Run(runs.size(), [&runs](unsigned int i) {
+            runs[i]++;
+            if (i == 2 || i == 7) throw std::runtime_error("task failed");
+        }), std::runtime_error);
+
+        // the other tasks ran anyway, and the pool is still usable
+        for (int r : runs) CPPUNIT_ASSERT_EQUAL(1, r);
+        pool.Run(runs.size(), [&runs](unsigned int i) { runs[i]++; });
+        for (int r : runs) CPPUNIT_ASSERT_EQUAL(2, r);
+    }
+}
+
+void JSBSimWorkerPoolTests::testSharedPool()
+{
+    // several threads starting batches on one pool
+    FGWorkerPool pool(3);
+    std::vector<std::atomic<int>> runs(4);
+    std::vector<std::thread> callers;
+
+    for (unsigned int c=0; c<runs.size(); c++) {
+        runs[c] = 0;
+        callers.emplace_back([&pool, &runs, c]() {
+            for (int batch=0; batch<200; batch++) {
+                pool.Run(5, [&runs, c](unsigned int) { runs[c]++; });
+            }
+        });
+    }
+    for (auto& caller : callers) caller.join();
+
+    for (const auto& r : runs) CPPUNIT_ASSERT_EQUAL(1000, r.load());
+}
@@ -0,0 +1,22 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+struct JSBSimWorkerPoolTests : CppUnit::TestFixture
+{
+    void testRun();
+    void testNested();
+    void testExceptions();
+    void testSharedPool();
+
+    CPPUNIT_TEST_SUITE(JSBSimWorkerPoolTests);
+    CPPUNIT_TEST(testRun);
+    CPPUNIT_TEST(testNested);
+    CPPUNIT_TEST(testExceptions);
+    CPPUNIT_TEST(testSharedPool);
+    CPPUNIT_TEST_SUITE_END();
+};
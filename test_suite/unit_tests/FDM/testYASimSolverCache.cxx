@@ -0,0 +1,247 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "testYASimSolverCache.hxx"
+
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include "FDM/YASim/Airplane.hpp"
+#include "FDM/YASim/FGFDM.hpp"
+#include "FDM/YASim/Model.hpp"
+#include "FDM/YASim/Surface.hpp"
+#include "FDM/YASim/YASim.hxx"
+
+#include <Main/globals.hxx>
+
+#include <simgear/io/iostreams/sgstream.hxx>
+#include <simgear/misc/sg_dir.hxx>
+#include <simgear/props/props_io.hxx>
+#include <simgear/xml/easyxml.hxx>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace yasim;
+
+namespace {
+
+// A small jet the solver converges on in a few hundred iterations
+const char* airplaneXML = R"(<?xml version="1.0"?>
+<airplane mass="2000" version="YASIM_VERSION_CURRENT">
+  <approach speed="70" aoa="6" fuel="0.5">
+    <control-setting axis="/controls/engines/engine[0]/throttle" value="0.4"/>
+    <control-setting axis="/controls/flight/flaps" value="1"/>
+    <control-setting axis="/controls/gear/gear-down" value="1"/>
+  </approach>
+  <cruise speed="200" alt="10000" fuel="0.5">
+    <control-setting axis="/controls/engines/engine[0]/throttle" value="1"/>
+    <control-setting axis="/controls/flight/flaps" value="0"/>
+    <control-setting axis="/controls/gear/gear-down" value="0"/>
+  </cruise>
+  <cockpit x="2" y="0" z="0.7"/>
+  <fuselage ax="4" ay="0" az="0" bx="-5" by="0" bz="0" width="1.4" taper="0.3" midpoint="0.4"/>
+  <wing x="0" y="0.6" z="-0.3" length="5.5" chord="1.6" incidence="2" twist="-2" taper="0.6" dihedral="4" camber="0.05">
+    <stall aoa="15" width="4" peak="1.5"/>
+    <flap0 start="0" end="0.6" lift="1.5" drag="1.7"/>
+    <flap1 start="0.6" end="1" lift="1.3" drag="1.1"/>
+    <control-input axis="/controls/flight/flaps" control="FLAP0"/>
+    <control-input axis="/controls/flight/aileron" control="FLAP1" split="true"/>
+  </wing>
+  <hstab x="-4.5" y="0.2" z="0.3" length="2" chord="1" taper="0.6" sweep="5">
+    <stall aoa="16" width="4" peak="1.5"/>
+    <flap0 start="0" end="1" lift="1.5" drag="1.2"/>
+    <control-input axis="/controls/flight/elevator" control="FLAP0"/>
+    <control-input axis="/controls/flight/elevator-trim" control="FLAP0"/>
+  </hstab>
+  <vstab x="-4.2" y="0" z="0.5" length="1.6" chord="1.2" taper="0.5" sweep="20">
+    <stall aoa="16" width="4" peak="1.5"/>
+    <flap0 start="0" end="1" lift="1.3" drag="1.1"/>
+    <control-input axis="/controls/flight/rudder" control="FLAP0" invert="true"/>
+  </vstab>
+  <thruster x="-3" y="0" z="0" vx="1" vy="0" vz="0" thrust="1500">
+    <control-input axis="/controls/engines/engine[0]/throttle" control="THROTTLE"/>
+  </thruster>
+  <gear x="2" y="0" z="-1.4" compression="0.3">
+    <control-input axis="/controls/gear/gear-down" control="EXTEND"/>
+  </gear>
+  <gear x="-0.4" y="1.4" z="-1.4" compression="0.3">
+    <control-input axis="/controls/gear/gear-down" control="EXTEND"/>
+  </gear>
+  <gear x="-0.4" y="-1.4" z="-1.4" compression="0.3">
+    <control-input axis="/controls/gear/gear-down" control="EXTEND"/>
+  </gear>
+  <tank x="0" y="0" z="0" capacity="600"/>
+  <ballast x="1.5" y="0" z="0" mass="150"/>
+</airplane>
+)";
+
+void writeFile(const SGPath& path, const std::string& text)
+{
+    sg_ofstream out(path, std::ios::out | std::ios::trunc);
+    out << text;
+}
+
+// Everything the solver sets, as far as it can be seen from outside
+std::vector<float> solution(Airplane* a)
+{
+    std::vector<float> result = { a->getDragCoefficient(), a->getLiftRatio(), a->getCruiseAoA(),
+                                  a->getTailIncidence(), a->getApproachElevator(),
+                                  a->getTail()->getIncidence() };
+    Vector* surfaces = a->getModel()->getSurfaces();
+    for (int i = 0; i < surfaces->size(); ++i) {
+        Surface* s = (Surface*)surfaces->get(i);
+        result.push_back(s->getTotalForceCoefficient());
+        result.push_back(s->getDragCoefficient());
+        result.push_back(s->getLiftCoefficient());
+    }
+    return result;
+}
+
+// an airplane compiled from the XML, with the solver cache (if any)
+std::unique_ptr<FGFDM> compile(const SGPath& xml, const SGPath& cache, const std::string& key)
+{
+    std::unique_ptr<FGFDM> fdm(new FGFDM);
+    readXML(xml, *fdm);
+    if (!cache.isNull()) {
+        fdm->getAirplane()->setSolverCache(cache, key);
+    }
+    fdm->getAirplane()->compile();
+    CPPUNIT_ASSERT(!fdm->getAirplane()->getFailureMsg());
+    return fdm;
+}
+
+// Sets a value in the cache file. A solution read from the cache shows
+// the changed iteration count, a solved one doesn't.
+void editCache(const SGPath& cache, const std::string& name, const std::string& value)
+{
+    SGPropertyNode_ptr root = new SGPropertyNode;
+    readProperties(cache, root);
+    root->setStringValue(name, value);
+    writeProperties(cache, root, true);
+}
+
+const int MARKED_ITERATIONS = 123456;
+
+} // of anonymous namespace
+
+
+void YASimSolverCacheTests::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("YASimSolverCache");
+    _dir = globals->get_fg_home() / "YASimSolverCacheTests";
+    simgear::Dir(_dir).remove(true);
+    simgear::Dir(_dir).create(0755);
+    _xml = _dir / "airplane.xml";
+    _cache = _dir / "cache" / "solution.xml";
+    writeFile(_xml, airplaneXML);
+}
+
+void YASimSolverCacheTests::tearDown()
+{
+    simgear::Dir(_dir).remove(true);
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+
+// Without a cache file the airplane is solved, and the result written
+void YASimSolverCacheTests::testMiss()
+{
+    auto fdm = compile(_xml, _cache, "key");
+    CPPUNIT_ASSERT(fdm->getAirplane()->getSolutionIterations() > 0);
+    CPPUNIT_ASSERT(_cache.exists());
+
+    SGPropertyNode_ptr root = new SGPropertyNode;
+    readProperties(_cache, root);
+    CPPUNIT_ASSERT_EQUAL(std::string("key"), std::string(root->getStringValue("key")));
+    CPPUNIT_ASSERT_EQUAL(fdm->getAirplane()->getSolutionIterations(), root->getIntValue("iterations"));
+}
+
+// The same key reads the solution instead of solving
+void YASimSolverCacheTests::testHit()
+{
+    compile(_xml, _cache, "key");
+    editCache(_cache, "iterations", std::to_string(MARKED_ITERATIONS));
+
+    auto fdm = compile(_xml, _cache, "key");
+    CPPUNIT_ASSERT_EQUAL(MARKED_ITERATIONS, fdm->getAirplane()->getSolutionIterations());
+}
+
+// A different key, solver version or airplane solves again
+void YASimSolverCacheTests::testInvalidation()
+{
+    compile(_xml, _cache, "key");
+    editCache(_cache, "iterations", std::to_string(MARKED_ITERATIONS));
+
+    auto other = compile(_xml, _cache, "other key");
+    CPPUNIT_ASSERT(other->getAirplane()->getSolutionIterations() != MARKED_ITERATIONS);
+
+    // solving again wrote the new key
+    editCache(_cache, "iterations", std::to_string(MARKED_ITERATIONS));
+    editCache(_cache, "solver-version", "1");
+    auto version = compile(_xml, _cache, "other key");
+    CPPUNIT_ASSERT(version->getAirplane()->getSolutionIterations() != MARKED_ITERATIONS);
+
+    // a solution that doesn't fit the airplane
+    SGPropertyNode_ptr root = new SGPropertyNode;
+    readProperties(_cache, root);
+    const std::string values = root->getStringValue("solution");
+    editCache(_cache, "iterations", std::to_string(MARKED_ITERATIONS));
+    editCache(_cache, "solution", values.substr(0, values.rfind(' ', values.size() - 2)));
+    auto shorter = compile(_xml, _cache, "other key");
+    CPPUNIT_ASSERT(shorter->getAirplane()->getSolutionIterations() != MARKED_ITERATIONS);
+
+    editCache(_cache, "iterations", std::to_string(MARKED_ITERATIONS));
+    editCache(_cache, "solution", values + " 1.0");
+    auto longer = compile(_xml, _cache, "other key");
+    CPPUNIT_ASSERT(longer->getAirplane()->getSolutionIterations() != MARKED_ITERATIONS);
+}
+
+// Reading the solution leaves the airplane exactly as solving does
+void YASimSolverCacheTests::testRestoredEqualsSolved()
+{
+    auto uncached = compile(_xml, SGPath(), "");
+    auto solved = compile(_xml, _cache, "key");
+    auto restored = compile(_xml, _cache, "key");
+
+    const std::vector<float> expected = solution(uncached->getAirplane());
+    CPPUNIT_ASSERT(expected == solution(solved->getAirplane()));
+    CPPUNIT_ASSERT(expected == solution(restored->getAirplane()));
+    CPPUNIT_ASSERT_EQUAL(uncached->getAirplane()->getSolutionIterations(),
+                         restored->getAirplane()->getSolutionIterations());
+}
+
+// The key changes with the XML and the files it includes
+void YASimSolverCacheTests::testKey()
+{
+    const SGPath top = _dir / "top.xml";
+    SGPath engine = _dir / "engine.xml";
+    writeFile(top, "<?xml version=\"1.0\"?>\n"
+                   "<!DOCTYPE airplane [ <!ENTITY engine SYSTEM \"engine.xml\"> ]>\n"
+                   "<airplane mass=\"2000\">&engine;</airplane>\n");
+    writeFile(engine, "<thruster thrust=\"1500\"/>\n");
+
+    const std::string key = YASim::solverCacheKey(top);
+    CPPUNIT_ASSERT(!key.empty());
+    CPPUNIT_ASSERT(key.find(FLIGHTGEAR_VERSION) != std::string::npos);
+    CPPUNIT_ASSERT_EQUAL(key, YASim::solverCacheKey(top));
+
+    writeFile(engine, "<thruster thrust=\"1600\"/>\n");
+    const std::string changedInclude = YASim::solverCacheKey(top);
+    CPPUNIT_ASSERT(changedInclude != key);
+
+    writeFile(top, "<?xml version=\"1.0\"?>\n"
+                   "<!DOCTYPE airplane [ <!ENTITY engine SYSTEM \"engine.xml\"> ]>\n"
+                   "<airplane mass=\"2100\">&engine;</airplane>\n");
+    const std::string changedTop = YASim::solverCacheKey(top);
+    CPPUNIT_ASSERT(changedTop != key);
+    CPPUNIT_ASSERT(changedTop != changedInclude);
+
+    // without the include, nothing can be cached
+    engine.remove();
+    CPPUNIT_ASSERT(YASim::solverCacheKey(top).empty());
+}
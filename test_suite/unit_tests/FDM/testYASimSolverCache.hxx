@@ -0,0 +1,35 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <simgear/misc/sg_path.hxx>
+
+struct YASimSolverCacheTests : CppUnit::TestFixture
+{
+    void setUp();
+
+    void tearDown();
+
+    void testMiss();
+    void testHit();
+    void testInvalidation();
+    void testRestoredEqualsSolved();
+    void testKey();
+
+    CPPUNIT_TEST_SUITE(YASimSolverCacheTests);
+    CPPUNIT_TEST(testMiss);
+    CPPUNIT_TEST(testHit);
+    CPPUNIT_TEST(testInvalidation);
+    CPPUNIT_TEST(testRestoredEqualsSolved);
+    CPPUNIT_TEST(testKey);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    SGPath _dir;
+    SGPath _xml;
+    SGPath _cache;
+};
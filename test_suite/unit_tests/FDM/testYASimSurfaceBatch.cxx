@@ -0,0 +1,210 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "testYASimSurfaceBatch.hxx"
+
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include "FDM/YASim/Math.hpp"
+#include "FDM/YASim/Surface.hpp"
+#include "FDM/YASim/SurfaceBatch.hpp"
+
+#include <random>
+
+using namespace yasim;
+
+namespace {
+
+std::mt19937 generator(42);
+
+float random(float min, float max)
+{
+    return std::uniform_real_distribution<float>(min, max)(generator);
+}
+
+// Surface::calcForce() and the batch do the same operations, but the
+// compiler may contract multiplies and adds differently in the two,
+// and with the wind nearly normal to the surface (alpha = |z/x|) the
+// difference grows.
+const float tolerance = 1e-3f;
+
+void checkEqual(const float* expected, const float* actual)
+{
+    float diff[3];
+    Math::sub3(expected, actual, diff);
+    CPPUNIT_ASSERT(Math::mag3(diff) <= tolerance * (1 + Math::mag3(expected)));
+}
+
+} // of anonymous namespace
+
+
+void YASimSurfaceBatchTests::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("");
+    _v32.setVersion("YASIM_VERSION_32");
+    generator.seed(42);
+}
+
+void YASimSurfaceBatchTests::tearDown()
+{
+    for (int i=0; i<_surfaces.size(); i++) {
+        delete (Surface*)_surfaces.get(i);
+    }
+    Surface::resetIDgen();
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+// Surfaces covering the branches of Surface::calcForce(): with and
+// without stall, controls both ways, either version, some transonic
+// and some without any coefficients.
+void YASimSurfaceBatchTests::addSurfaces(int n)
+{
+    for (int i=0; i<n; i++) {
+        float pos[3] = { random(-10, 10), random(-10, 10), random(-2, 2) };
+        Surface* s = new Surface(i % 3 ? &_v32 : &_original, pos, random(0.1f, 2));
+
+        float orient[9], y[3] = { random(-1, 1), random(-1, 1), random(-1, 1) };
+        float x[3] = { random(-1, 1), random(-1, 1), random(0.1f, 1) };
+        Math::unit3(x, orient);
+        Math::mul3(-Math::dot3(y, orient), orient, x);
+        Math::add3(y, x, y);
+        Math::unit3(y, orient+3);
+        Math::cross3(orient, orient+3, orient+6);
+        s->setOrientation(orient);
+
+        s->setChord(random(0, 3));
+        if (i % 17) {
+            s->setDragCoefficient(random(0, 1));
+            s->setYDrag(random(0, 1));
+            s->setLiftCoefficient(random(0, 5));
+        } else {
+            s->setDragCoefficient(0);
+            s->setYDrag(0);
+            s->setLiftCoefficient(0);
+        }
+        s->setZeroAlphaLift(random(-0.1f, 0.1f));
+        s->setStallPeak(0, random(1, 2));
+        s->setStallPeak(1, random(1, 2));
+        if (i % 5) {
+            for (int j=0; j<4; j++) {
+                s->setStall(j, random(0.1f, 0.4f));
+                s->setStallWidth(j, random(0.01f, 0.2f));
+            }
+        }
+        s->setSlatParams(random(0, 0.1f), random(1, 1.5f));
+        s->setFlapParams(random(1, 2), random(1, 2));
+        s->setSpoilerParams(random(0, 1), random(1, 3));
+        s->setFlapPos(random(-1, 1));
+        s->setSlatPos(random(0, 1));
+        s->setSpoilerPos(random(0, 1));
+        s->setFlapEffectiveness(random(0.5f, 1.5f));
+        s->setIncidence(random(-0.1f, 0.1f));
+        s->setTwist(random(-0.05f, 0.05f));
+        s->setInducedDrag(random(0, 2));
+        if (i % 4 == 0) {
+            s->setFlowRegime(FLOW_TRANSONIC);
+            s->setCriticalMachNumber(random(0.5f, 0.9f));
+        }
+        _surfaces.add(s);
+    }
+}
+
+void YASimSurfaceBatchTests::testForces()
+{
+    // not a multiple of SurfaceBatch::LANES
+    addSurfaces(203);
+    SurfaceBatch batch;
+    batch.load(_surfaces);
+    CPPUNIT_ASSERT_EQUAL(_surfaces.size(), batch.size());
+
+    std::vector<float> winds(3 * _surfaces.size());
+    std::vector<float> alphas(_surfaces.size());
+    for (int run=0; run<50; run++) {
+        float mach = random(0, 1.5f), rho = random(0.3f, 1.3f);
+        for (int i=0; i<_surfaces.size(); i++) {
+            float* v = &winds[3*i];
+            v[0] = random(-200, 200);
+            v[1] = random(-50, 50);
+            v[2] = random(-100, 100);
+            batch.setWind(i, v);
+        }
+        batch.calcForces(rho, mach);
+        batch.store(_surfaces);
+        for (int i=0; i<_surfaces.size(); i++) {
+            alphas[i] = ((Surface*)_surfaces.get(i))->getAlpha();
+        }
+
+        for (int i=0; i<_surfaces.size(); i++) {
+            Surface* s = (Surface*)_surfaces.get(i);
+            float force[3], torque[3], bforce[3], btorque[3];
+            s->calcForce(&winds[3*i], rho, mach, force, torque);
+            batch.getForce(i, bforce, btorque);
+            checkEqual(force, bforce);
+            checkEqual(torque, btorque);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(s->getAlpha(), alphas[i], tolerance * (1 + alphas[i]));
+        }
+    }
+}
+
+void YASimSurfaceBatchTests::testWind()
+{
+    addSurfaces(20);
+    SurfaceBatch batch;
+    batch.load(_surfaces);
+
+    float wind[3] = { 3, -2, 1 }, rot[3] = { 0.1f, -0.3f, 0.05f };
+    float v[3] = { -80, 1, 4 }, cg[3] = { 0.5f, 0, -0.2f };
+    batch.calcWind(wind, rot, v, cg);
+    batch.calcForces(1.2f, 0.3f);
+
+    for (int i=0; i<_surfaces.size(); i++) {
+        Surface* s = (Surface*)_surfaces.get(i);
+        float pos[3], spos[3], lwind[3];
+        batch.getPosition(i, pos);
+        s->getPosition(spos);
+        checkEqual(spos, pos);
+
+        // wind - velocity - (rot cross (pos - cg))
+        Math::sub3(pos, cg, lwind);
+        Math::cross3(rot, lwind, lwind);
+        Math::mul3(-1, lwind, lwind);
+        Math::add3(wind, lwind, lwind);
+        Math::sub3(lwind, v, lwind);
+
+        float force[3], torque[3], bforce[3], btorque[3];
+        s->calcForce(lwind, 1.2f, 0.3f, force, torque);
+        batch.getForce(i, bforce, btorque);
+        checkEqual(force, bforce);
+        checkEqual(torque, btorque);
+    }
+}
+
+void YASimSurfaceBatchTests::testNoForce()
+{
+    addSurfaces(17);
+    SurfaceBatch batch;
+    batch.load(_surfaces);
+
+    // no wind at all
+    float zero[3] = { 0, 0, 0 }, v[3] = { -50, 0, 0 };
+    batch.calcWind(zero, zero, zero, zero);
+    batch.calcForces(1.2f, 0.3f);
+    for (int i=0; i<_surfaces.size(); i++) {
+        float force[3], torque[3];
+        batch.getForce(i, force, torque);
+        checkEqual(zero, force);
+        checkEqual(zero, torque);
+    }
+
+    // the first surface has no coefficients
+    batch.calcWind(zero, zero, v, zero);
+    batch.calcForces(1.2f, 0.3f);
+    float force[3], torque[3];
+    batch.getForce(0, force, torque);
+    checkEqual(zero, force);
+    checkEqual(zero, torque);
+    batch.getForce(1, force, torque);
+    CPPUNIT_ASSERT(Math::mag3(force) > 0);
+}
@@ -0,0 +1,34 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "FDM/YASim/Vector.hpp"
+#include "FDM/YASim/Version.hpp"
+
+struct YASimSurfaceBatchTests : CppUnit::TestFixture
+{
+    void setUp();
+
+    void tearDown();
+
+    void testForces();
+    void testWind();
+    void testNoForce();
+
+    CPPUNIT_TEST_SUITE(YASimSurfaceBatchTests);
+    CPPUNIT_TEST(testForces);
+    CPPUNIT_TEST(testWind);
+    CPPUNIT_TEST(testNoForce);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    void addSurfaces(int n);
+
+    yasim::Version _original;
+    yasim::Version _v32;
+    yasim::Vector _surfaces;
+};
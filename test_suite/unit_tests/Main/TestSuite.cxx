@@ -18,11 +18,17 @@
  */
 
 #include "test_autosaveMigration.hxx"
+#include "test_frameProfiler.hxx"
+#include "test_ioThread.hxx"
 #include "test_posinit.hxx"
+#include "test_spscQueue.hxx"
 #include "test_timeManager.hxx"
 
 
 // Set up the unit tests.
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(AutosaveMigrationTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(FrameProfilerTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(IOThreadTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(PosInitTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(SPSCQueueTests, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(TimeManagerTests, "Unit tests");
@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "test_frameProfiler.hxx"
+
+#include <sstream>
+#include <thread>
+
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include <Main/FrameProfiler.hxx>
+
+using namespace flightgear;
+
+
+// Set up function for each test.
+void FrameProfilerTests::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("frameProfiler");
+    FrameProfiler::setEnabled(true);
+    FrameProfiler::reset();
+}
+
+
+// Clean up after each test.
+void FrameProfilerTests::tearDown()
+{
+    FrameProfiler::reset();
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+
+void FrameProfilerTests::testStatistics()
+{
+    double p50, p99;
+    CPPUNIT_ASSERT(!FrameProfiler::statistics("test/update", p50, p99));
+
+    // 100 frames of 1ms each, except for two slow ones; an event recorded
+    // twice in one frame counts once, with the total duration
+    const int64_t ms = 1000 * 1000;
+    for (int frame = 0; frame < 100; ++frame) {
+        const int64_t t = frame * 20 * ms;
+        if (frame % 50 == 0) {
+            FrameProfiler::record("test/update", t, t + 30 * ms);
+        } else {
+            FrameProfiler::record("test/update", t, t + ms / 2);
+            FrameProfiler::record("test/update", t + ms, t + ms + ms / 2);
+        }
+        FrameProfiler::endFrame();
+    }
+
+    CPPUNIT_ASSERT(FrameProfiler::statistics("test/update", p50, p99));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, p50, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(30.0, p99, 1e-9);
+
+    // frames without the event don't dilute the statistics
+    for (int frame = 0; frame < 100; ++frame) {
+        FrameProfiler::endFrame();
+    }
+    CPPUNIT_ASSERT(FrameProfiler::statistics("test/update", p50, p99));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, p50, 1e-9);
+
+    FrameProfiler::setEnabled(false);
+    {
+        FG_PROFILE_SCOPE("test/disabled");
+    }
+    FrameProfiler::setEnabled(true);
+    FrameProfiler::endFrame();
+    CPPUNIT_ASSERT(!FrameProfiler::statistics("test/disabled", p50, p99));
+}
+
+
+void FrameProfilerTests::testChromeTrace()
+{
+    {
+        FG_PROFILE_SCOPE("test/main-thread");
+    }
+
+    std::thread worker([]() {
+        FrameProfiler::setThreadName("test-worker");
+        for (int i = 0; i < 10; ++i) {
+            FG_PROFILE_SCOPE("test/worker");
+        }
+    });
+    worker.join();
+
+    // events from other threads contribute to the statistics too
+    FrameProfiler::endFrame();
+    double p50, p99;
+    CPPUNIT_ASSERT(FrameProfiler::statistics("test/worker", p50, p99));
+    CPPUNIT_ASSERT(FrameProfiler::statistics("test/main-thread", p50, p99));
+
+    std::ostringstream out;
+    FrameProfiler::writeChromeTrace(out);
+    const std::string json = out.str();
+
+    CPPUNIT_ASSERT_EQUAL(0, json.compare(0, 2, "{\""));
+    CPPUNIT_ASSERT(json.find("\"traceEvents\":[") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"args\":{\"name\":\"test-worker\"}") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("{\"name\":\"test/main-thread\",\"ph\":\"X\"") != std::string::npos);
+
+    size_t count = 0;
+    for (size_t pos = json.find("\"test/worker\""); pos != std::string::npos;
+         pos = json.find("\"test/worker\"", pos + 1)) {
+        ++count;
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(10), count);
+}
@@ -0,0 +1,253 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "test_ioThread.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <simgear/io/iochannel.hxx>
+
+#include <Main/IOThread.hxx>
+#include <Network/protocol.hxx>
+
+using namespace flightgear;
+
+namespace {
+
+// an in-memory channel, which records the thread reading it
+class QueueChannel : public SGIOChannel
+{
+public:
+    int readline(char* buf, int length) override
+    {
+        ++reads;
+        std::lock_guard<std::mutex> g(lock);
+        reader = std::this_thread::get_id();
+        if (incoming.empty()) {
+            return 0;
+        }
+
+        const std::string line = incoming.front();
+        incoming.pop_front();
+        const int n = std::min<int>(line.size(), length - 1);
+        memcpy(buf, line.data(), n);
+        buf[n] = 0;
+        return n;
+    }
+
+    int write(const char* buf, const int length) override
+    {
+        if (failWrites) {
+            return 0;
+        }
+
+        std::lock_guard<std::mutex> g(lock);
+        written.emplace_back(buf, length);
+        return length;
+    }
+
+    size_t pending()
+    {
+        std::lock_guard<std::mutex> g(lock);
+        return incoming.size();
+    }
+
+    size_t writtenCount()
+    {
+        std::lock_guard<std::mutex> g(lock);
+        return written.size();
+    }
+
+    std::mutex lock;
+    std::deque<std::string> incoming;
+    std::vector<std::string> written;
+    std::thread::id reader;
+    std::atomic<int> reads{0};
+    std::atomic<bool> failWrites{false};
+};
+
+class TestProtocol : public FGProtocol
+{
+public:
+    TestProtocol(const std::string& direction) : channel(new QueueChannel)
+    {
+        set_io_channel(channel);
+        set_direction(direction);
+        set_hz(1000);
+        set_enabled(true);
+    }
+
+    bool supports_io_thread() const override { return true; }
+
+    bool gen_message() override
+    {
+        message = "message " + std::to_string(sent++) + "\n";
+        return true;
+    }
+
+    const char* get_message(int& length) const override
+    {
+        length = static_cast<int>(message.size());
+        return message.data();
+    }
+
+    int read_record(char* buf, int size) override
+    {
+        return channel->readline(buf, size);
+    }
+
+    bool parse_record(char* record, int length) override
+    {
+        parsed.emplace_back(record, length);
+        return true;
+    }
+
+    bool write_failed() override
+    {
+        failureThreads.push_back(std::this_thread::get_id());
+        return false;
+    }
+
+    QueueChannel* channel; // owned by FGProtocol
+    std::string message;
+    int sent = 0;
+    std::vector<std::string> parsed;
+    std::vector<std::thread::id> failureThreads;
+};
+
+bool waitFor(std::function<bool()> condition)
+{
+    const auto giveUp = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > giveUp) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+
+// Set up function for each test.
+void IOThreadTests::setUp()
+{
+}
+
+
+// Clean up after each test.
+void IOThreadTests::tearDown()
+{
+}
+
+
+void IOThreadTests::testOutput()
+{
+    TestProtocol protocol("out");
+    IOThread thread;
+    thread.add(&protocol);
+    CPPUNIT_ASSERT(thread.contains(&protocol));
+
+    for (int i = 0; i < 50; ++i) {
+        thread.process(&protocol);
+    }
+
+    CPPUNIT_ASSERT(waitFor([&] { return protocol.channel->writtenCount() == 50; }));
+    for (int i = 0; i < 50; ++i) {
+        CPPUNIT_ASSERT_EQUAL("message " + std::to_string(i) + "\n", protocol.channel->written[i]);
+    }
+
+    // output only channels are never read
+    CPPUNIT_ASSERT_EQUAL(0, protocol.channel->reads.load());
+    thread.remove(&protocol);
+}
+
+
+void IOThreadTests::testInput()
+{
+    TestProtocol protocol("in");
+    for (int i = 0; i < 10; ++i) {
+        protocol.channel->incoming.push_back("record " + std::to_string(i));
+    }
+
+    IOThread thread;
+    thread.add(&protocol);
+    CPPUNIT_ASSERT(waitFor([&] { return protocol.channel->pending() == 0; }));
+    CPPUNIT_ASSERT(protocol.channel->reader != std::this_thread::get_id());
+
+    // the records are parsed on this thread, when the channel is due
+    CPPUNIT_ASSERT(protocol.parsed.empty());
+    CPPUNIT_ASSERT(waitFor([&] {
+        thread.process(&protocol);
+        return protocol.parsed.size() == 10;
+    }));
+
+    for (int i = 0; i < 10; ++i) {
+        CPPUNIT_ASSERT_EQUAL("record " + std::to_string(i), protocol.parsed[i]);
+    }
+
+    // input only channels don't generate messages
+    CPPUNIT_ASSERT_EQUAL(0, protocol.sent);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), protocol.channel->writtenCount());
+    thread.remove(&protocol);
+}
+
+
+void IOThreadTests::testRemove()
+{
+    TestProtocol protocol("bi");
+    IOThread thread;
+    thread.add(&protocol);
+
+    // idle channels are read at their rate, on the I/O thread
+    CPPUNIT_ASSERT(waitFor([&] { return protocol.channel->reads.load() >= 5; }));
+
+    thread.remove(&protocol);
+    CPPUNIT_ASSERT(!thread.contains(&protocol));
+    const int reads = protocol.channel->reads.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CPPUNIT_ASSERT_EQUAL(reads, protocol.channel->reads.load());
+
+    // removed channels are left alone by process() too
+    thread.process(&protocol);
+    CPPUNIT_ASSERT_EQUAL(0, protocol.sent);
+}
+
+
+void IOThreadTests::testWriteError()
+{
+    TestProtocol protocol("out");
+    protocol.channel->failWrites = true;
+    IOThread thread;
+    thread.add(&protocol);
+
+    // the failure is reported by a later process(), on this thread, so that
+    // channels set to exit on errors still can
+    CPPUNIT_ASSERT(waitFor([&] { return !thread.process(&protocol); }));
+    CPPUNIT_ASSERT(!protocol.failureThreads.empty());
+    for (const auto& id : protocol.failureThreads) {
+        CPPUNIT_ASSERT(id == std::this_thread::get_id());
+    }
+
+    // once written again, the channel is fine
+    protocol.channel->failWrites = false;
+    CPPUNIT_ASSERT(waitFor([&] {
+        thread.process(&protocol);
+        return protocol.channel->writtenCount() > 0;
+    }));
+    CPPUNIT_ASSERT(waitFor([&] { return thread.process(&protocol); }));
+    thread.remove(&protocol);
+}
@@ -0,0 +1,35 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+
+// The FGIO channel thread unit tests.
+class IOThreadTests : public CppUnit::TestFixture
+{
+    // Set up the test suite.
+    CPPUNIT_TEST_SUITE(IOThreadTests);
+    CPPUNIT_TEST(testOutput);
+    CPPUNIT_TEST(testInput);
+    CPPUNIT_TEST(testRemove);
+    CPPUNIT_TEST(testWriteError);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    // Set up function for each test.
+    void setUp();
+
+    // Clean up after each test.
+    void tearDown();
+
+    // The tests.
+    void testOutput();
+    void testInput();
+    void testRemove();
+    void testWriteError();
+};
@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "test_spscQueue.hxx"
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include <Main/SPSCQueue.hxx>
+
+using namespace flightgear;
+
+
+void SPSCQueueTests::testOrder()
+{
+    SPSCQueue<int> queue(4);
+    int item = 0;
+    CPPUNIT_ASSERT(!queue.pop(item));
+
+    // wrap around the slots a few times
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            item = round * 10 + i;
+            CPPUNIT_ASSERT(queue.push(item));
+        }
+        CPPUNIT_ASSERT_EQUAL(size_t{3}, queue.size());
+        for (int i = 0; i < 3; ++i) {
+            CPPUNIT_ASSERT(queue.pop(item));
+            CPPUNIT_ASSERT_EQUAL(round * 10 + i, item);
+        }
+        CPPUNIT_ASSERT_EQUAL(size_t{0}, queue.size());
+    }
+}
+
+void SPSCQueueTests::testFull()
+{
+    SPSCQueue<int> queue(3);
+    CPPUNIT_ASSERT_EQUAL(size_t{3}, queue.capacity());
+
+    int item = 0;
+    for (int i = 0; i < 3; ++i) {
+        item = i;
+        CPPUNIT_ASSERT(queue.push(item));
+    }
+    item = 99;
+    CPPUNIT_ASSERT(!queue.push(item));
+    CPPUNIT_ASSERT_EQUAL(size_t{3}, queue.size());
+
+    // one pop frees one slot
+    CPPUNIT_ASSERT(queue.pop(item));
+    CPPUNIT_ASSERT_EQUAL(0, item);
+    item = 3;
+    CPPUNIT_ASSERT(queue.push(item));
+    for (int i = 1; i <= 3; ++i) {
+        CPPUNIT_ASSERT(queue.pop(item));
+        CPPUNIT_ASSERT_EQUAL(i, item);
+    }
+    CPPUNIT_ASSERT(!queue.pop(item));
+}
+
+void SPSCQueueTests::testMoveOnly()
+{
+    SPSCQueue<std::unique_ptr<int>> queue(1);
+    auto item = std::make_unique<int>(7);
+    CPPUNIT_ASSERT(queue.push(item));
+    CPPUNIT_ASSERT(!item);
+
+    // a failed push leaves the item with the caller
+    auto other = std::make_unique<int>(8);
+    CPPUNIT_ASSERT(!queue.push(other));
+    CPPUNIT_ASSERT(other);
+
+    CPPUNIT_ASSERT(queue.pop(item));
+    CPPUNIT_ASSERT_EQUAL(7, *item);
+}
+
+void SPSCQueueTests::testThreads()
+{
+    const uint64_t count = 200000;
+    SPSCQueue<uint64_t> queue(16);
+
+    std::thread producer([&queue, count] {
+        for (uint64_t i = 0; i < count; ++i) {
+            uint64_t item = i;
+            while (!queue.push(item)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // every item arrives, once and in order
+    uint64_t expected = 0;
+    while (expected < count) {
+        uint64_t item;
+        if (!queue.pop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        CPPUNIT_ASSERT_EQUAL(expected, item);
+        ++expected;
+    }
+    producer.join();
+
+    uint64_t item;
+    CPPUNIT_ASSERT(!queue.pop(item));
+}
@@ -0,0 +1,29 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+
+// The single producer / single consumer queue unit tests.
+class SPSCQueueTests : public CppUnit::TestFixture
+{
+    // Set up the test suite.
+    CPPUNIT_TEST_SUITE(SPSCQueueTests);
+    CPPUNIT_TEST(testOrder);
+    CPPUNIT_TEST(testFull);
+    CPPUNIT_TEST(testMoveOnly);
+    CPPUNIT_TEST(testThreads);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    // The tests.
+    void testOrder();
+    void testFull();
+    void testMoveOnly();
+    void testThreads();
+};
@@ -0,0 +1,11 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "test_mpDelta.hxx"
+#include "test_mpReceive.hxx"
+
+// Set up the unit tests.
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(MPDeltaTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(MPReceiveTests, "Unit tests");
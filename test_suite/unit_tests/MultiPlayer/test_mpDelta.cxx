@@ -0,0 +1,200 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "test_mpDelta.hxx"
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <MultiPlayer/MPPropertyDelta.hxx>
+#include <MultiPlayer/mpmessages.hxx>
+
+namespace {
+
+FGPropertyData* makeProperty(unsigned id, float value)
+{
+    FGPropertyData* p = new FGPropertyData;
+    p->id = id;
+    p->type = simgear::props::FLOAT;
+    p->float_value = value;
+    return p;
+}
+
+FGPropertyData* makeProperty(unsigned id, int value)
+{
+    FGPropertyData* p = new FGPropertyData;
+    p->id = id;
+    p->type = simgear::props::INT;
+    p->int_value = value;
+    return p;
+}
+
+FGPropertyData* makeProperty(unsigned id, const char* value)
+{
+    FGPropertyData* p = new FGPropertyData;
+    p->id = id;
+    p->type = simgear::props::STRING;
+    p->string_value = new char[strlen(value) + 1];
+    strcpy(p->string_value, value);
+    return p;
+}
+
+// The local aircraft at a given frame: an aileron which keeps moving, a
+// flap setting and a string which change now and then, and a constant.
+void makeFrame(int frame, FGExternalMotionData& m)
+{
+    m.properties.push_back(makeProperty(100, static_cast<float>(std::sin(frame * 0.1))));
+    m.properties.push_back(makeProperty(101, 0.5f));
+    m.properties.push_back(makeProperty(1001, frame < 7 ? 0 : 2));
+    m.properties.push_back(makeProperty(1101, frame < 8 ? "hello" : "world"));
+}
+
+// What arrives at the receiver (the decoder takes ownership).
+void transmit(const std::vector<FGPropertyData*>& sent, FGExternalMotionData& received)
+{
+    for (auto p : sent) {
+        switch (p->type) {
+        case simgear::props::STRING:
+            received.properties.push_back(makeProperty(p->id, p->string_value));
+            break;
+        case simgear::props::INT:
+            received.properties.push_back(makeProperty(p->id, p->int_value));
+            break;
+        default:
+            received.properties.push_back(makeProperty(p->id, p->float_value));
+            break;
+        }
+    }
+}
+
+void checkEqual(const FGExternalMotionData& expected, const FGExternalMotionData& actual)
+{
+    CPPUNIT_ASSERT_EQUAL(expected.properties.size(), actual.properties.size());
+    for (size_t i = 0; i < expected.properties.size(); ++i) {
+        const FGPropertyData* e = expected.properties[i];
+        const FGPropertyData* a = actual.properties[i];
+        CPPUNIT_ASSERT_EQUAL(e->id, a->id);
+        CPPUNIT_ASSERT_EQUAL(e->type, a->type);
+        switch (e->type) {
+        case simgear::props::STRING:
+            CPPUNIT_ASSERT_EQUAL(std::string(e->string_value), std::string(a->string_value));
+            break;
+        case simgear::props::INT:
+            CPPUNIT_ASSERT_EQUAL(e->int_value, a->int_value);
+            break;
+        default:
+            CPPUNIT_ASSERT_EQUAL(e->float_value, a->float_value);
+            break;
+        }
+    }
+}
+
+} // anonymous namespace
+
+
+void MPDeltaTests::testKeyframeInterval()
+{
+    MPPropertyDeltaEncoder encoder;
+    encoder.setKeyframeInterval(3);
+    CPPUNIT_ASSERT(encoder.keyframeDue());
+
+    FGExternalMotionData m;
+    makeFrame(0, m);
+    std::vector<FGPropertyData*> changed;
+    for (int sequence = 1; sequence <= 3; ++sequence) {
+        CPPUNIT_ASSERT(encoder.keyframeDue());
+        CPPUNIT_ASSERT_EQUAL(sequence, encoder.keyframe(m.properties));
+        for (int i = 0; i < 2; ++i) {
+            CPPUNIT_ASSERT(!encoder.keyframeDue());
+            changed.clear();
+            encoder.changed(m.properties, changed);
+            CPPUNIT_ASSERT(changed.empty());
+        }
+    }
+
+    encoder.reset();
+    CPPUNIT_ASSERT(encoder.keyframeDue());
+    CPPUNIT_ASSERT_EQUAL(1, encoder.keyframe(m.properties));
+}
+
+
+void MPDeltaTests::testRoundTrip()
+{
+    MPPropertyDeltaEncoder encoder;
+    MPPropertyDeltaDecoder decoder;
+    encoder.setKeyframeInterval(5);
+
+    size_t deltaProperties = 0;
+    for (int frame = 0; frame < 20; ++frame) {
+        FGExternalMotionData sent;
+        makeFrame(frame, sent);
+
+        FGExternalMotionData received;
+        if (encoder.keyframeDue()) {
+            const int sequence = encoder.keyframe(sent.properties);
+            transmit(sent.properties, received);
+            decoder.keyframe(sequence, received.properties);
+        } else {
+            std::vector<FGPropertyData*> changed;
+            encoder.changed(sent.properties, changed);
+            transmit(changed, received);
+            deltaProperties += received.properties.size();
+            decoder.merge(encoder.sequence(), received.properties);
+        }
+
+        checkEqual(sent, received);
+    }
+
+    // Only the aileron changes in most deltas: 16 deltas, 3 carrying the
+    // flaps and 2 the string.
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(16 + 3 + 2), deltaProperties);
+}
+
+
+void MPDeltaTests::testLostKeyframe()
+{
+    MPPropertyDeltaEncoder encoder;
+    MPPropertyDeltaDecoder decoder;
+    encoder.setKeyframeInterval(5);
+
+    for (int frame = 0; frame < 20; ++frame) {
+        FGExternalMotionData sent;
+        makeFrame(frame, sent);
+
+        FGExternalMotionData received;
+        if (encoder.keyframeDue()) {
+            const int sequence = encoder.keyframe(sent.properties);
+            // the keyframe of frame 10, the first with the new string, is lost
+            if (frame == 10)
+                continue;
+            transmit(sent.properties, received);
+            decoder.keyframe(sequence, received.properties);
+        } else {
+            std::vector<FGPropertyData*> changed;
+            encoder.changed(sent.properties, changed);
+            // so are a couple of deltas
+            if (frame == 3 || frame == 4)
+                continue;
+            transmit(changed, received);
+            decoder.merge(encoder.sequence(), received.properties);
+        }
+
+        if (frame >= 11 && frame < 15) {
+            // the previous keyframe fills in, with the old string
+            CPPUNIT_ASSERT_EQUAL(2, decoder.sequence());
+            CPPUNIT_ASSERT_EQUAL(sent.properties.size(), received.properties.size());
+            CPPUNIT_ASSERT_EQUAL(sent.properties[0]->float_value,
+                                 received.properties[0]->float_value);
+            CPPUNIT_ASSERT_EQUAL(std::string("hello"),
+                                 std::string(received.properties[3]->string_value));
+        } else {
+            checkEqual(sent, received);
+        }
+    }
+}
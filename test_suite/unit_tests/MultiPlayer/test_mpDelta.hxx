@@ -0,0 +1,27 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+
+// Keyframe relative encoding of multiplayer properties.
+class MPDeltaTests : public CppUnit::TestFixture
+{
+    // Set up the test suite.
+    CPPUNIT_TEST_SUITE(MPDeltaTests);
+    CPPUNIT_TEST(testKeyframeInterval);
+    CPPUNIT_TEST(testRoundTrip);
+    CPPUNIT_TEST(testLostKeyframe);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    // The tests.
+    void testKeyframeInterval();
+    void testRoundTrip();
+    void testLostKeyframe();
+};
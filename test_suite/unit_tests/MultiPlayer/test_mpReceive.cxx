@@ -0,0 +1,166 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "test_mpReceive.hxx"
+
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include "test_suite/FGTestApi/MPTrafficGenerator.hxx"
+#include "test_suite/FGTestApi/NavDataCache.hxx"
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include <simgear/timing/timestamp.hxx>
+
+#include <AIModel/AIManager.hxx>
+#include <AIModel/AIMultiplayer.hxx>
+#include <Main/fg_props.hxx>
+#include <Main/globals.hxx>
+#include <MultiPlayer/multiplaymgr.hxx>
+
+namespace {
+
+const int RX_PORT = 15710;
+const int TX_PORT = 15711;
+const int NUM_AIRCRAFT = 300;
+
+std::unique_ptr<FGTestApi::MPTrafficGenerator> generator;
+
+} // anonymous namespace
+
+
+// Set up function for each test.
+void MPReceiveTests::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("mpReceive");
+    FGTestApi::setUp::initNavDataCache();
+
+    globals->get_subsystem_mgr()->add<FGAIManager>();
+
+    auto props = globals->get_props();
+    props->setBoolValue("sim/ai/enabled", true);
+    props->setStringValue("sim/multiplay/callsign", "TESTER");
+    props->setStringValue("sim/multiplay/txhost", "127.0.0.1");
+    props->setIntValue("sim/multiplay/txport", TX_PORT);
+    props->setIntValue("sim/multiplay/rxport", RX_PORT);
+    props->setStringValue("sim/model/path", "Aircraft/ufo/Models/ufo.xml");
+}
+
+
+// Clean up after each test.
+void MPReceiveTests::tearDown()
+{
+    generator.reset();
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+
+void MPReceiveTests::init(bool receiveThread)
+{
+    fgSetBool("/sim/multiplay/receive-thread/enabled", receiveThread);
+    globals->get_subsystem_mgr()->add<FGMultiplayMgr>();
+
+    globals->get_subsystem_mgr()->bind();
+    globals->get_subsystem_mgr()->init();
+    globals->get_subsystem_mgr()->postinit();
+
+    CPPUNIT_ASSERT(fgGetBool("/sim/multiplay/online"));
+
+    generator.reset(new FGTestApi::MPTrafficGenerator("127.0.0.1", RX_PORT, NUM_AIRCRAFT,
+                                                      SGGeod::fromDeg(-22.6, 64.0)));
+}
+
+
+// Send a packet from every aircraft each frame, and update the MP manager
+// until it has seen all of them. Returns the average main thread time spent
+// in update() per packet, in microseconds.
+double MPReceiveTests::receiveFrames(int frames)
+{
+    auto mp = globals->get_subsystem<FGMultiplayMgr>();
+    auto receivedNode = fgGetNode("/sim/multiplay/receive-thread/received-packets", true);
+    const bool threaded = fgGetBool("/sim/multiplay/receive-thread/enabled");
+
+    double updateUSec = 0.0;
+    size_t expected = generator->packetsSent();
+    for (int frame = 0; frame < frames; ++frame) {
+        // in batches, so the socket buffer can't overflow
+        for (int begin = 0; begin < NUM_AIRCRAFT; begin += 50) {
+            generator->sendFrame(frame * 0.1, begin, std::min(begin + 50, NUM_AIRCRAFT));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        expected += NUM_AIRCRAFT;
+
+        SGTimeStamp st;
+        if (threaded) {
+            SGTimeStamp waited;
+            waited.stamp();
+            while (static_cast<size_t>(receivedNode->getLongValue()) < expected) {
+                CPPUNIT_ASSERT(waited.elapsedMSec() < 5000);
+                st.stamp();
+                mp->update(0.1);
+                updateUSec += st.elapsedUSec();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        } else {
+            st.stamp();
+            mp->update(0.1);
+            updateUSec += st.elapsedUSec();
+        }
+    }
+
+    return updateUSec / (frames * NUM_AIRCRAFT);
+}
+
+
+void MPReceiveTests::testReceiveThread()
+{
+    init(true);
+    auto mp = globals->get_subsystem<FGMultiplayMgr>();
+
+    const double usec = receiveFrames(10);
+    std::cout << "\nMP receive thread: " << usec << " usec per packet on the main thread" << std::endl;
+
+    for (int i = 0; i < NUM_AIRCRAFT; ++i) {
+        const auto callsign = FGTestApi::MPTrafficGenerator::callsign(i);
+        auto aircraft = mp->getMultiplayer(callsign);
+        CPPUNIT_ASSERT_MESSAGE(callsign, aircraft);
+        CPPUNIT_ASSERT(aircraft->getLastTimestamp() > 0);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(0L, fgGetNode("/sim/multiplay/receive-thread/dropped-packets")->getLongValue());
+    CPPUNIT_ASSERT_EQUAL(0L, fgGetNode("/sim/multiplay/receive-thread/invalid-packets")->getLongValue());
+
+    // a corrupt packet is counted, and doesn't hold up the ones behind it
+    const long received = fgGetNode("/sim/multiplay/receive-thread/received-packets")->getLongValue();
+    generator->sendInvalid();
+    generator->sendFrame(1.0, 0, 1);
+
+    SGTimeStamp waited;
+    waited.stamp();
+    while (fgGetNode("/sim/multiplay/receive-thread/received-packets")->getLongValue() < received + 2) {
+        CPPUNIT_ASSERT(waited.elapsedMSec() < 5000);
+        mp->update(0.1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CPPUNIT_ASSERT_EQUAL(1L, fgGetNode("/sim/multiplay/receive-thread/invalid-packets")->getLongValue());
+}
+
+
+void MPReceiveTests::testInlineReceive()
+{
+    init(false);
+    auto mp = globals->get_subsystem<FGMultiplayMgr>();
+
+    const double usec = receiveFrames(10);
+    std::cout << "\nMP inline receive: " << usec << " usec per packet on the main thread" << std::endl;
+
+    for (int i = 0; i < NUM_AIRCRAFT; ++i) {
+        const auto callsign = FGTestApi::MPTrafficGenerator::callsign(i);
+        CPPUNIT_ASSERT_MESSAGE(callsign, mp->getMultiplayer(callsign));
+    }
+}
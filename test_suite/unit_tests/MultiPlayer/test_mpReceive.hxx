@@ -0,0 +1,34 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+
+// Receiving multiplayer traffic, with and without the receive thread.
+class MPReceiveTests : public CppUnit::TestFixture
+{
+    // Set up the test suite.
+    CPPUNIT_TEST_SUITE(MPReceiveTests);
+    CPPUNIT_TEST(testReceiveThread);
+    CPPUNIT_TEST(testInlineReceive);
+    CPPUNIT_TEST_SUITE_END();
+
+    void init(bool receiveThread);
+    double receiveFrames(int frames);
+
+public:
+    // Set up function for each test.
+    void setUp();
+
+    // Clean up after each test.
+    void tearDown();
+
+    // The tests.
+    void testReceiveThread();
+    void testInlineReceive();
+};
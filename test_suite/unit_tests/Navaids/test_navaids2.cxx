@@ -1,12 +1,24 @@
 #include "test_navaids2.hxx"
 
+#include <atomic>
+#include <iostream>
+#include <thread>
+
 #include "test_suite/FGTestApi/testGlobals.hxx"
 #include "test_suite/FGTestApi/NavDataCache.hxx"
 
+#include <simgear/structure/exception.hxx>
+#include <simgear/timing/timestamp.hxx>
+
+#include <ATC/CommStation.hxx>
+#include <Airports/airport.hxx>
 #include <Navaids/NavDataCache.hxx>
+#include <Navaids/PositionedOctree.hxx>
 #include <Navaids/navrecord.hxx>
 #include <Navaids/navlist.hxx>
 
+using flightgear::NavDataCache;
+
 
 // Set up function for each test.
 void NavaidsTests::setUp()
@@ -34,3 +46,253 @@ void NavaidsTests::testBasic()
     CPPUNIT_ASSERT_EQUAL(tla->get_freq(), 11570);
     CPPUNIT_ASSERT_EQUAL(tla->get_range(), 130);
 }
+
+// The same queries, answered from the snapshot and from SQLite
+void NavaidsTests::testSnapshotMatchesDatabase()
+{
+    NavDataCache* cache = NavDataCache::instance();
+    if (cache->isReadOnly()) {
+        return;
+    }
+
+    // other tests may have discarded it
+    cache->setSnapshotEnabled(true);
+    cache->openSnapshot();
+    CPPUNIT_ASSERT(cache->isUsingSnapshot());
+
+    const std::vector<SGGeod> positions = {
+        SGGeod::fromDeg(-2.27, 53.35),   // EGCC
+        SGGeod::fromDeg(151.18, -33.95), // YSSY
+        SGGeod::fromDeg(-122.37, 37.62)  // KSFO
+    };
+    const std::vector<int> navFreqs = {11570, 11630, 10990, 11310, 338, 382};
+
+    auto runQueries = [&](std::vector<PositionedIDVec>& results) {
+        for (const auto& pos : positions) {
+            for (int freq : navFreqs) {
+                results.push_back(cache->findNavaidsByFreq(freq, pos, nullptr));
+                results.push_back(cache->findNavaidsByFreq(freq, nullptr));
+            }
+
+            auto leaf = flightgear::Octree::globalPersistentOctree()->findLeafForPos(SGVec3d::fromGeod(pos));
+            PositionedIDVec leafItems;
+            for (const auto& item : cache->getOctreeLeafChildren(leaf->guid())) {
+                leafItems.push_back(item.second);
+            }
+            results.push_back(leafItems);
+        }
+
+        for (const char* ident : {"EGCC", "yssy", "TNT", "SFO"}) {
+            PositionedIDVec closest;
+            for (const auto& pos : positions) {
+                FGPositionedRef p = cache->findClosestWithIdent(ident, pos, nullptr);
+                closest.push_back(p ? p->guid() : 0);
+            }
+            results.push_back(closest);
+
+            PositionedIDVec all;
+            for (const auto& p : cache->findAllWithIdent(ident, nullptr, true)) {
+                all.push_back(p->guid());
+            }
+            results.push_back(all);
+        }
+
+        PositionedIDVec comms;
+        for (const char* icao : {"EGCC", "YSSY", "KSFO"}) {
+            FGAirportRef apt = FGAirport::findByIdent(icao);
+            if (!apt) {
+                continue;
+            }
+
+            for (const auto& c : apt->commStations()) {
+                FGPositionedRef p = cache->findCommByFreq(c->freqKHz(), apt->geod(), nullptr);
+                comms.push_back(p ? p->guid() : 0);
+            }
+        }
+        results.push_back(comms);
+    };
+
+    std::vector<PositionedIDVec> fromSnapshot, fromDatabase;
+    SGTimeStamp st;
+    st.stamp();
+    runQueries(fromSnapshot);
+    const double snapshotMSec = st.elapsedMSec();
+
+    cache->setSnapshotEnabled(false);
+    CPPUNIT_ASSERT(!cache->isUsingSnapshot());
+    st.stamp();
+    runQueries(fromDatabase);
+    const double databaseMSec = st.elapsedMSec();
+    cache->setSnapshotEnabled(true);
+
+    CPPUNIT_ASSERT_EQUAL(fromDatabase.size(), fromSnapshot.size());
+    for (size_t i = 0; i < fromDatabase.size(); ++i) {
+        CPPUNIT_ASSERT(fromDatabase[i] == fromSnapshot[i]);
+    }
+
+    std::cout << std::endl << "navcache queries: " << snapshotMSec << "ms from the snapshot, "
+              << databaseMSec << "ms from SQLite" << std::endl;
+}
+
+
+// User waypoints are added to the database at runtime, but leave the
+// snapshot (and the stamp which validates it in later sessions) alone
+void NavaidsTests::testSnapshotUserWaypoints()
+{
+    NavDataCache* cache = NavDataCache::instance();
+    if (cache->isReadOnly()) {
+        return;
+    }
+
+    cache->setSnapshotEnabled(true);
+    cache->openSnapshot();
+    CPPUNIT_ASSERT(cache->isUsingSnapshot());
+    const std::string stamp = cache->readStringProperty("snapshot-stamp");
+    CPPUNIT_ASSERT(!stamp.empty());
+
+    const SGGeod pos = SGGeod::fromDeg(-2.31, 53.37); // near EGCC
+    FGPositionedRef wpt = FGPositioned::createUserWaypoint("SNAPWPT", pos);
+    CPPUNIT_ASSERT(wpt);
+
+    CPPUNIT_ASSERT(cache->isUsingSnapshot());
+    CPPUNIT_ASSERT_EQUAL(stamp, cache->readStringProperty("snapshot-stamp"));
+
+    // the modified ident and octree leaf are answered from SQLite
+    FGPositionedRef found = cache->findClosestWithIdent("SNAPWPT", pos, nullptr);
+    CPPUNIT_ASSERT(found);
+    CPPUNIT_ASSERT_EQUAL(wpt->guid(), found->guid());
+
+    FGPositioned::TypeFilter filter(FGPositioned::WAYPOINT);
+    bool inRange = false;
+    for (const auto& p : FGPositioned::findWithinRange(pos, 1.0, &filter)) {
+        inRange |= (p->guid() == wpt->guid());
+    }
+    CPPUNIT_ASSERT(inRange);
+
+    CPPUNIT_ASSERT(FGPositioned::deleteUserWaypoint("SNAPWPT"));
+    CPPUNIT_ASSERT(cache->isUsingSnapshot());
+    CPPUNIT_ASSERT_EQUAL(stamp, cache->readStringProperty("snapshot-stamp"));
+    CPPUNIT_ASSERT(!cache->findClosestWithIdent("SNAPWPT", pos, nullptr));
+
+    // changing items which are in the snapshot still discards it
+    FGAirportRef egcc = FGAirport::getByIdent("EGCC");
+    CPPUNIT_ASSERT(egcc);
+    cache->setAirportMetar("EGCC", egcc->getMetar());
+    CPPUNIT_ASSERT(!cache->isUsingSnapshot());
+    CPPUNIT_ASSERT(cache->readStringProperty("snapshot-stamp").empty());
+
+    cache->openSnapshot();
+    CPPUNIT_ASSERT(cache->isUsingSnapshot());
+    CPPUNIT_ASSERT(cache->readStringProperty("snapshot-stamp") != stamp);
+}
+
+
+void NavaidsTests::testConcurrentReaders()
+{
+    NavDataCache* cache = NavDataCache::instance();
+
+    const std::vector<SGGeod> positions = {
+        SGGeod::fromDeg(-2.27, 53.35),   // EGCC
+        SGGeod::fromDeg(151.18, -33.95), // YSSY
+        SGGeod::fromDeg(-122.37, 37.62), // KSFO
+        SGGeod::fromDeg(8.57, 50.03)     // EDDF
+    };
+    const std::vector<int> navFreqs = {11570, 11630, 10990, 11310, 338, 382};
+
+    auto runQueries = [&](std::vector<PositionedIDVec>& results) {
+        for (const auto& pos : positions) {
+            for (int freq : navFreqs) {
+                results.push_back(cache->findNavaidsByFreq(freq, pos, nullptr));
+            }
+
+            PositionedIDVec closest;
+            for (const auto& p : FGPositioned::findClosestN(pos, 20, 50.0, nullptr)) {
+                closest.push_back(p->guid());
+            }
+            results.push_back(closest);
+
+            PositionedIDVec inRange;
+            for (const auto& p : FGPositioned::findWithinRange(pos, 30.0, nullptr)) {
+                inRange.push_back(p->guid());
+            }
+            results.push_back(inRange);
+        }
+
+        for (const char* ident : {"EGCC", "YSSY", "KSFO", "EDDF", "TNT"}) {
+            PositionedIDVec items;
+            for (const auto& pos : positions) {
+                FGPositionedRef p = cache->findClosestWithIdent(ident, pos, nullptr);
+                items.push_back(p ? p->guid() : 0);
+                if (p && p->type() == FGPositioned::AIRPORT) {
+                    for (PositionedID rwy : cache->airportItemsOfType(p->guid(), FGPositioned::RUNWAY)) {
+                        items.push_back(rwy);
+                    }
+                }
+            }
+            results.push_back(items);
+        }
+    };
+
+    // reference results, computed on the main thread
+    std::vector<PositionedIDVec> expected;
+    runQueries(expected);
+
+    const int threadCount = 8;
+    const int iterations = 20;
+    std::atomic<int> mismatches{0};
+    std::atomic<int> failures{0};
+
+    auto worker = [&]() {
+        try {
+            for (int i = 0; i < iterations; ++i) {
+                std::vector<PositionedIDVec> results;
+                runQueries(results);
+                if (results != expected) {
+                    ++mismatches;
+                }
+
+                // instances must be shared with the main thread's cache
+                for (const auto& ids : expected) {
+                    for (PositionedID id : ids) {
+                        if (id && !cache->loadById(id)) {
+                            ++mismatches;
+                        }
+                    }
+                }
+            }
+        } catch (sg_exception& e) {
+            std::cerr << "navcache worker failed: " << e.getFormattedMessage() << std::endl;
+            ++failures;
+        }
+    };
+
+    // exercise both the snapshot and the pooled SQLite connections
+    for (bool useSnapshot : {false, true}) {
+        cache->setSnapshotEnabled(useSnapshot);
+
+        SGTimeStamp st;
+        st.stamp();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back(worker);
+        }
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        std::cout << std::endl << "navcache: " << threadCount << " threads x " << iterations
+                  << " iterations in " << st.elapsedMSec() << "ms"
+                  << (useSnapshot ? " (snapshot)" : " (SQLite)") << std::endl;
+    }
+
+    CPPUNIT_ASSERT_EQUAL(0, failures.load());
+    CPPUNIT_ASSERT_EQUAL(0, mismatches.load());
+
+    // same ID, same instance, regardless of which thread loaded it
+    FGPositionedRef tnt = cache->findClosestWithIdent("TNT", positions.front(), nullptr);
+    CPPUNIT_ASSERT(tnt);
+    FGPositionedRef fromWorker;
+    std::thread([&]() { fromWorker = cache->loadById(tnt->guid()); }).join();
+    CPPUNIT_ASSERT(fromWorker.get() == tnt.get());
+}
@@ -32,6 +32,9 @@ class NavaidsTests : public CppUnit::TestFixture
     // Set up the test suite.
     CPPUNIT_TEST_SUITE(NavaidsTests);
     CPPUNIT_TEST(testBasic);
+    CPPUNIT_TEST(testSnapshotMatchesDatabase);
+    CPPUNIT_TEST(testSnapshotUserWaypoints);
+    CPPUNIT_TEST(testConcurrentReaders);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -43,6 +46,9 @@ public:
 
     // The tests.
     void testBasic();
+    void testSnapshotMatchesDatabase();
+    void testSnapshotUserWaypoints();
+    void testConcurrentReaders();
 };
 
 #endif  // _FG_NAVAIDS_UNIT_TESTS_HXX
@@ -5,12 +5,32 @@
 
 #include "config.h"
 
+#include "test_genericCodec.hxx"
+#include "test_httpd.hxx"
+#include "test_jsonprops.hxx"
+#include "test_mqtt.hxx"
+#include "test_propertyWebsocket.hxx"
+
+// Set up the unit tests.
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(GenericCodecTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(HttpdTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(JsonPropsTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(MqttTests, "Unit tests");
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(PropertyWebsocketTests, "Unit tests");
+
+#if defined(HAVE_SHM_OPEN)
+
+#include "test_sharedMemory.hxx"
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(SharedMemoryTests, "Unit tests");
+
+#endif
+
 #if defined(ENABLE_SWIFT)
 
 #include "test_swiftAircraftManager.hxx"
 #include "test_swiftService.hxx"
 
-// Set up the unit tests.
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(SwiftAircraftManagerTest, "Unit tests");
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(SwiftServiceTest, "Unit tests");
 
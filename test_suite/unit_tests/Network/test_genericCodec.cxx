@@ -0,0 +1,548 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "test_genericCodec.hxx"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <simgear/misc/stdint.hxx>
+#include <simgear/misc/strutils.hxx>
+#include <simgear/props/props.hxx>
+#include <simgear/timing/timestamp.hxx>
+
+#include <Network/GenericCodec.hxx>
+
+namespace {
+
+typedef FGGenericCodec::Chunk Chunk;
+
+const size_t MSG_SIZE = 16384;
+
+Chunk makeChunk(SGPropertyNode* prop, FGGenericCodec::Type type, const std::string& format = "%d")
+{
+    Chunk c;
+    c.format = format;
+    c.type = type;
+    c.offset = 0.0;
+    c.factor = 1.0;
+    c.min = 0.0;
+    c.max = 0.0;
+    c.wrap = false;
+    c.rel = false;
+    c.prop = prop;
+    return c;
+}
+
+union u32 {
+    uint32_t intVal;
+    float floatVal;
+};
+
+union u64 {
+    uint64_t longVal;
+    double doubleVal;
+};
+
+// FGGeneric::gen_message_ascii() as it was before the codec
+std::string legacyAscii(const std::vector<Chunk>& chunks, const std::string& var_separator,
+                        const std::string& line_separator)
+{
+    std::string generic_sentence;
+    char tmp[255];
+
+    double val;
+    for (unsigned int i = 0; i < chunks.size(); i++) {
+
+        if (i > 0) {
+            generic_sentence += var_separator;
+        }
+
+        std::string format = simgear::strutils::sanitizePrintfFormat(chunks[i].format);
+
+        switch (chunks[i].type) {
+        case FGGenericCodec::FG_BYTE:
+        case FGGenericCodec::FG_WORD:
+        case FGGenericCodec::FG_INT:
+            val = chunks[i].offset + chunks[i].prop->getFloatValue() * chunks[i].factor;
+            snprintf(tmp, 255, format.c_str(), (int)val);
+            break;
+
+        case FGGenericCodec::FG_BOOL:
+            snprintf(tmp, 255, format.c_str(), chunks[i].prop->getBoolValue());
+            break;
+
+        case FGGenericCodec::FG_FIXED:
+        case FGGenericCodec::FG_FLOAT:
+            val = chunks[i].offset + chunks[i].prop->getFloatValue() * chunks[i].factor;
+            snprintf(tmp, 255, format.c_str(), (float)val);
+            break;
+
+        case FGGenericCodec::FG_DOUBLE:
+            val = chunks[i].offset + chunks[i].prop->getDoubleValue() * chunks[i].factor;
+            snprintf(tmp, 255, format.c_str(), (double)val);
+            break;
+
+        default: // SG_STRING
+            snprintf(tmp, 255, format.c_str(), chunks[i].prop->getStringValue().c_str());
+        }
+
+        generic_sentence += tmp;
+    }
+
+    generic_sentence += line_separator;
+    return generic_sentence;
+}
+
+// FGGeneric::gen_message_binary() as it was before the codec, less strings
+int legacyBinary(const std::vector<Chunk>& chunks, bool swap, char* buf)
+{
+    int length = 0;
+
+    double val;
+    for (unsigned int i = 0; i < chunks.size(); i++) {
+
+        switch (chunks[i].type) {
+        case FGGenericCodec::FG_INT: {
+            val = chunks[i].offset + chunks[i].prop->getFloatValue() * chunks[i].factor;
+            int32_t intVal = val;
+            if (swap) {
+                intVal = (int32_t)sg_bswap_32((uint32_t)intVal);
+            }
+            memcpy(&buf[length], &intVal, sizeof(int32_t));
+            length += sizeof(int32_t);
+            break;
+        }
+
+        case FGGenericCodec::FG_BOOL:
+            buf[length] = (char)(chunks[i].prop->getBoolValue() ? true : false);
+            length += 1;
+            break;
+
+        case FGGenericCodec::FG_FIXED: {
+            val = chunks[i].offset + chunks[i].prop->getFloatValue() * chunks[i].factor;
+            int32_t fixed = (int)(val * 65536.0f);
+            if (swap) {
+                fixed = (int32_t)sg_bswap_32((uint32_t)fixed);
+            }
+            memcpy(&buf[length], &fixed, sizeof(int32_t));
+            length += sizeof(int32_t);
+            break;
+        }
+
+        case FGGenericCodec::FG_FLOAT: {
+            val = chunks[i].offset + chunks[i].prop->getFloatValue() * chunks[i].factor;
+            u32 tmpun32;
+            tmpun32.floatVal = static_cast<float>(val);
+            if (swap) {
+                tmpun32.intVal = sg_bswap_32(tmpun32.intVal);
+            }
+            memcpy(&buf[length], &tmpun32.intVal, sizeof(uint32_t));
+            length += sizeof(uint32_t);
+            break;
+        }
+
+        case FGGenericCodec::FG_DOUBLE: {
+            val = chunks[i].offset + chunks[i].prop->getDoubleValue() * chunks[i].factor;
+            u64 tmpun64;
+            tmpun64.doubleVal = val;
+            if (swap) {
+                tmpun64.longVal = sg_bswap_64(tmpun64.longVal);
+            }
+            memcpy(&buf[length], &tmpun64.longVal, sizeof(uint64_t));
+            length += sizeof(uint64_t);
+            break;
+        }
+
+        case FGGenericCodec::FG_BYTE: {
+            val = chunks[i].offset + chunks[i].prop->getFloatValue() * chunks[i].factor;
+            int8_t byteVal = val;
+            memcpy(&buf[length], &byteVal, sizeof(int8_t));
+            length += sizeof(int8_t);
+            break;
+        }
+
+        case FGGenericCodec::FG_WORD: {
+            val = chunks[i].offset + chunks[i].prop->getFloatValue() * chunks[i].factor;
+            int16_t wordVal = val;
+            memcpy(&buf[length], &wordVal, sizeof(int16_t));
+            length += sizeof(int16_t);
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    return length;
+}
+
+// one value of each type, in the properties under root
+std::vector<Chunk> allTypes(SGPropertyNode* root)
+{
+    root->setBoolValue("bool", true);
+    root->setIntValue("int", -1234);
+    root->setFloatValue("float", 3.25f);
+    root->setDoubleValue("double", 1234.5678);
+    root->setFloatValue("fixed", -2.5f);
+    root->setIntValue("byte", -7);
+    root->setIntValue("word", 300);
+
+    std::vector<Chunk> chunks;
+    chunks.push_back(makeChunk(root->getNode("bool"), FGGenericCodec::FG_BOOL));
+    chunks.push_back(makeChunk(root->getNode("int"), FGGenericCodec::FG_INT));
+    chunks.push_back(makeChunk(root->getNode("float"), FGGenericCodec::FG_FLOAT, "%f"));
+    chunks.push_back(makeChunk(root->getNode("double"), FGGenericCodec::FG_DOUBLE, "%.6f"));
+    chunks.push_back(makeChunk(root->getNode("fixed"), FGGenericCodec::FG_FIXED, "%.3f"));
+    chunks.push_back(makeChunk(root->getNode("byte"), FGGenericCodec::FG_BYTE));
+    chunks.push_back(makeChunk(root->getNode("word"), FGGenericCodec::FG_WORD));
+    return chunks;
+}
+
+// the same chunks, bound to properties under another root
+std::vector<Chunk> rebind(std::vector<Chunk> chunks, SGPropertyNode* root)
+{
+    for (auto& c : chunks) {
+        c.prop = root->getNode(c.prop->getNameString(), true);
+    }
+    return chunks;
+}
+
+} // anonymous namespace
+
+// Set up function for each test.
+void GenericCodecTests::setUp()
+{
+}
+
+// Clean up after each test.
+void GenericCodecTests::tearDown()
+{
+}
+
+void GenericCodecTests::testBinaryRoundTrip()
+{
+    SGPropertyNode_ptr out = new SGPropertyNode;
+    SGPropertyNode_ptr in = new SGPropertyNode;
+    auto outChunks = allTypes(out);
+    auto inChunks = rebind(outChunks, in);
+
+    FGGenericCodec::Layout layout;
+    layout.binary = true;
+
+    FGGenericCodec encoder, decoder;
+    encoder.compile(outChunks, layout);
+    decoder.compile(inChunks, layout);
+
+    char buf[MSG_SIZE];
+    char legacy[MSG_SIZE];
+    const int length = encoder.encode(buf, sizeof(buf));
+    CPPUNIT_ASSERT_EQUAL(1 + 4 + 4 + 8 + 4 + 1 + 2, length);
+    CPPUNIT_ASSERT_EQUAL(legacyBinary(outChunks, false, legacy), length);
+    CPPUNIT_ASSERT(memcmp(buf, legacy, length) == 0);
+
+    decoder.decodeBinary(buf, length);
+    CPPUNIT_ASSERT_EQUAL(true, in->getBoolValue("bool"));
+    CPPUNIT_ASSERT_EQUAL(-1234, in->getIntValue("int"));
+    CPPUNIT_ASSERT_EQUAL(3.25f, in->getFloatValue("float"));
+    CPPUNIT_ASSERT_EQUAL(1234.5678, in->getDoubleValue("double"));
+    CPPUNIT_ASSERT_EQUAL(-2.5f, in->getFloatValue("fixed"));
+    CPPUNIT_ASSERT_EQUAL(-7, in->getIntValue("byte"));
+    CPPUNIT_ASSERT_EQUAL(300, in->getIntValue("word"));
+
+    // network byte order gives the same bytes as before
+    layout.byteSwap = true;
+    encoder.compile(outChunks, layout);
+    CPPUNIT_ASSERT_EQUAL(legacyBinary(outChunks, true, legacy), encoder.encode(buf, sizeof(buf)));
+    CPPUNIT_ASSERT(memcmp(buf, legacy, length) == 0);
+
+    // a short message only updates the chunks it holds completely
+    in->setIntValue("int", 0);
+    in->setFloatValue("float", 0.0f);
+    decoder.compile(inChunks, FGGenericCodec::Layout{true});
+    encoder.compile(outChunks, FGGenericCodec::Layout{true});
+    encoder.encode(buf, sizeof(buf));
+    decoder.decodeBinary(buf, 1 + 4 + 2);
+    CPPUNIT_ASSERT_EQUAL(-1234, in->getIntValue("int"));
+    CPPUNIT_ASSERT_EQUAL(0.0f, in->getFloatValue("float"));
+}
+
+void GenericCodecTests::testBinaryLayout()
+{
+    SGPropertyNode_ptr root = new SGPropertyNode;
+    root->setIntValue("int", 0x01020304);
+    root->setStringValue("string", "hello");
+
+    std::vector<Chunk> chunks;
+    chunks.push_back(makeChunk(root->getNode("int"), FGGenericCodec::FG_INT));
+    chunks.push_back(makeChunk(root->getNode("string"), FGGenericCodec::FG_STRING));
+
+    FGGenericCodec::Layout layout;
+    layout.binary = true;
+    layout.byteSwap = sgIsLittleEndian();
+    layout.footer = FGGenericCodec::FOOTER_LENGTH;
+
+    FGGenericCodec codec;
+    codec.compile(chunks, layout);
+
+    char buf[MSG_SIZE];
+    int length = codec.encode(buf, sizeof(buf));
+    const char expected[] = {1, 2, 3, 4, 0, 0, 0, 5, 'h', 'e', 'l', 'l', 'o', 0, 0, 0, 13};
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(sizeof(expected)), length);
+    CPPUNIT_ASSERT(memcmp(buf, expected, length) == 0);
+
+    layout.footer = FGGenericCodec::FOOTER_MAGIC;
+    layout.footerValue = 0x0a0b0c0d;
+    codec.compile(chunks, layout);
+    length = codec.encode(buf, sizeof(buf));
+    const char magic[] = {0x0a, 0x0b, 0x0c, 0x0d};
+    CPPUNIT_ASSERT_EQUAL(17, length);
+    CPPUNIT_ASSERT(memcmp(buf + 13, magic, 4) == 0);
+
+    // never written past the end, the string is cut short
+    length = codec.encode(buf, 10);
+    CPPUNIT_ASSERT_EQUAL(10, length);
+    CPPUNIT_ASSERT(memcmp(buf, expected, 4) == 0);
+    CPPUNIT_ASSERT_EQUAL(2, static_cast<int>(buf[7]));
+}
+
+void GenericCodecTests::testAsciiFormats()
+{
+    SGPropertyNode_ptr root = new SGPropertyNode;
+    SGPropertyNode* value = root->getNode("value", true);
+
+    struct Case {
+        FGGenericCodec::Type type;
+        const char* format;
+    };
+    const Case cases[] = {
+        {FGGenericCodec::FG_INT, "%d"},
+        {FGGenericCodec::FG_INT, "%i"},
+        {FGGenericCodec::FG_INT, "%6d"},
+        {FGGenericCodec::FG_INT, "%-6d|"},
+        {FGGenericCodec::FG_INT, "%06d"},
+        {FGGenericCodec::FG_INT, "%+d"},
+        {FGGenericCodec::FG_INT, "%x"},
+        {FGGenericCodec::FG_INT, "%.3d"},
+        {FGGenericCodec::FG_INT, "v=%d%%"},
+        {FGGenericCodec::FG_BYTE, "%d"},
+        {FGGenericCodec::FG_WORD, "%d"},
+        {FGGenericCodec::FG_BOOL, "%d"},
+        {FGGenericCodec::FG_FLOAT, "%f"},
+        {FGGenericCodec::FG_FLOAT, "%.2f"},
+        {FGGenericCodec::FG_FIXED, "%.4f"},
+        {FGGenericCodec::FG_DOUBLE, "%f"},
+        {FGGenericCodec::FG_DOUBLE, "%lf"},
+        {FGGenericCodec::FG_DOUBLE, "%.0f"},
+        {FGGenericCodec::FG_DOUBLE, "%.8f"},
+        {FGGenericCodec::FG_DOUBLE, "%10.3f"},
+        {FGGenericCodec::FG_DOUBLE, "%-10.3f|"},
+        {FGGenericCodec::FG_DOUBLE, "%010.3f"},
+        {FGGenericCodec::FG_DOUBLE, "%.20f"},
+        {FGGenericCodec::FG_DOUBLE, "%e"},
+        {FGGenericCodec::FG_DOUBLE, "%g"},
+        {FGGenericCodec::FG_DOUBLE, "alt: %.1f ft"},
+        {FGGenericCodec::FG_STRING, "%s"},
+        {FGGenericCodec::FG_STRING, "<%s>"},
+        {FGGenericCodec::FG_STRING, "%8s"},
+        {FGGenericCodec::FG_STRING, "no conversion"},
+    };
+
+    const double values[] = {
+        0.0, -0.0, 0.5, 1.5, 2.5, -2.5, 0.125, 0.005, -0.001, 1.0 / 3.0,
+        3.14159265358979, 123456.789, -98765.4321, 1e-7, 1e9, 2147483000.0,
+        1e20, -1e300, std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::quiet_NaN()};
+
+    FGGenericCodec::Layout layout;
+    layout.varSeparator = ",";
+    layout.lineSeparator = "\n";
+
+    char buf[MSG_SIZE];
+    for (const auto& c : cases) {
+        std::vector<Chunk> chunks(1, makeChunk(value, c.type, c.format));
+        FGGenericCodec codec;
+        codec.compile(chunks, layout);
+
+        for (double v : values) {
+            // out of range conversions to int aren't defined
+            const bool isInteger = c.type == FGGenericCodec::FG_INT || c.type == FGGenericCodec::FG_BYTE ||
+                                   c.type == FGGenericCodec::FG_WORD;
+            if (isInteger && !(std::fabs(v) < 1e9)) {
+                continue;
+            }
+
+            if (c.type == FGGenericCodec::FG_STRING) {
+                value->setStringValue(std::to_string(v));
+            } else if (c.type == FGGenericCodec::FG_BOOL) {
+                value->setBoolValue(v != 0.0);
+            } else {
+                value->setDoubleValue(v);
+            }
+
+            const std::string expected = legacyAscii(chunks, layout.varSeparator, layout.lineSeparator);
+            const int length = codec.encode(buf, sizeof(buf));
+            CPPUNIT_ASSERT_EQUAL(expected, std::string(buf, length));
+        }
+    }
+
+    // fixed point output agrees with printf across the range
+    std::vector<Chunk> chunks;
+    for (int precision = 0; precision <= 9; ++precision) {
+        chunks.push_back(makeChunk(root->getNode("value", precision, true), FGGenericCodec::FG_DOUBLE,
+                                   "%." + std::to_string(precision) + "f"));
+    }
+
+    FGGenericCodec codec;
+    codec.compile(chunks, layout);
+
+    uint64_t seed = 12345;
+    for (int i = 0; i < 20000; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        const double mantissa = static_cast<double>(seed >> 11) / static_cast<double>(1ULL << 53) - 0.5;
+        const double v = std::ldexp(mantissa, static_cast<int>((seed >> 3) % 48) - 16);
+        for (auto& c : chunks) {
+            c.prop->setDoubleValue(v);
+        }
+
+        const std::string expected = legacyAscii(chunks, layout.varSeparator, layout.lineSeparator);
+        const int length = codec.encode(buf, sizeof(buf));
+        CPPUNIT_ASSERT_EQUAL(expected, std::string(buf, length));
+    }
+}
+
+void GenericCodecTests::testAsciiRoundTrip()
+{
+    SGPropertyNode_ptr out = new SGPropertyNode;
+    SGPropertyNode_ptr in = new SGPropertyNode;
+    auto outChunks = allTypes(out);
+    out->setStringValue("string", "on the ground");
+    outChunks.push_back(makeChunk(out->getNode("string"), FGGenericCodec::FG_STRING, "%s"));
+    auto inChunks = rebind(outChunks, in);
+
+    FGGenericCodec::Layout layout;
+    layout.varSeparator = "\t";
+    layout.lineSeparator = "\r\n";
+
+    FGGenericCodec encoder, decoder;
+    encoder.compile(outChunks, layout);
+    decoder.compile(inChunks, layout);
+
+    char buf[MSG_SIZE];
+    const int length = encoder.encode(buf, sizeof(buf));
+    CPPUNIT_ASSERT_EQUAL(std::string("1\t-1234\t3.250000\t1234.567800\t-2.500\t-7\t300\ton the ground\r\n"),
+                         std::string(buf, length));
+
+    buf[length - 2] = 0;
+    decoder.decodeAscii(buf);
+    CPPUNIT_ASSERT_EQUAL(true, in->getBoolValue("bool"));
+    CPPUNIT_ASSERT_EQUAL(-1234, in->getIntValue("int"));
+    CPPUNIT_ASSERT_EQUAL(3.25f, in->getFloatValue("float"));
+    CPPUNIT_ASSERT_EQUAL(1234.5678, in->getDoubleValue("double"));
+    CPPUNIT_ASSERT_EQUAL(-2.5f, in->getFloatValue("fixed"));
+    CPPUNIT_ASSERT_EQUAL(-7, in->getIntValue("byte"));
+    CPPUNIT_ASSERT_EQUAL(300, in->getIntValue("word"));
+    CPPUNIT_ASSERT_EQUAL(std::string("on the ground"), in->getStringValue("string"));
+
+    // relative, scaled and clipped input
+    inChunks[1].rel = true;
+    inChunks[1].factor = 2.0;
+    inChunks[3].min = 0.0;
+    inChunks[3].max = 1000.0;
+    decoder.compile(inChunks, layout);
+    encoder.encode(buf, sizeof(buf));
+    buf[length - 2] = 0;
+    decoder.decodeAscii(buf);
+    CPPUNIT_ASSERT_EQUAL(-1234 * 3, in->getIntValue("int"));
+    CPPUNIT_ASSERT_EQUAL(1000.0, in->getDoubleValue("double"));
+}
+
+void GenericCodecTests::testThroughput()
+{
+    // something like a motion platform feed
+    SGPropertyNode_ptr root = new SGPropertyNode;
+    std::vector<Chunk> chunks;
+    for (int i = 0; i < 24; ++i) {
+        SGPropertyNode* n = root->getNode("double", i, true);
+        n->setDoubleValue(i * 123.456789 - 1000.0);
+        chunks.push_back(makeChunk(n, FGGenericCodec::FG_DOUBLE, "%.4f"));
+    }
+    for (int i = 0; i < 8; ++i) {
+        SGPropertyNode* n = root->getNode("float", i, true);
+        n->setFloatValue(i * 0.37f);
+        chunks.push_back(makeChunk(n, FGGenericCodec::FG_FLOAT, "%.3f"));
+    }
+    for (int i = 0; i < 8; ++i) {
+        SGPropertyNode* n = root->getNode("int", i, true);
+        n->setIntValue(i * 1001 - 3000);
+        chunks.push_back(makeChunk(n, FGGenericCodec::FG_INT, "%d"));
+    }
+    for (int i = 0; i < 4; ++i) {
+        SGPropertyNode* n = root->getNode("bool", i, true);
+        n->setBoolValue(i & 1);
+        chunks.push_back(makeChunk(n, FGGenericCodec::FG_BOOL, "%d"));
+    }
+
+    const int messages = 20000;
+    char buf[MSG_SIZE];
+    SGTimeStamp st;
+
+    // ASCII
+    FGGenericCodec::Layout layout;
+    layout.varSeparator = ",";
+    layout.lineSeparator = "\n";
+    FGGenericCodec codec;
+    codec.compile(chunks, layout);
+
+    size_t legacyTotal = 0, codecTotal = 0;
+    st.stamp();
+    for (int i = 0; i < messages; ++i) {
+        chunks[0].prop->setDoubleValue(i * 0.01);
+        legacyTotal += legacyAscii(chunks, layout.varSeparator, layout.lineSeparator).size();
+    }
+    const double legacyAsciiUSec = st.elapsedUSec();
+
+    st.stamp();
+    for (int i = 0; i < messages; ++i) {
+        chunks[0].prop->setDoubleValue(i * 0.01);
+        codecTotal += codec.encode(buf, sizeof(buf));
+    }
+    const double codecAsciiUSec = st.elapsedUSec();
+    CPPUNIT_ASSERT_EQUAL(legacyTotal, codecTotal);
+
+    // binary
+    layout.binary = true;
+    layout.byteSwap = true;
+    codec.compile(chunks, layout);
+
+    legacyTotal = codecTotal = 0;
+    st.stamp();
+    for (int i = 0; i < messages; ++i) {
+        legacyTotal += legacyBinary(chunks, true, buf);
+    }
+    const double legacyBinaryUSec = st.elapsedUSec();
+
+    st.stamp();
+    for (int i = 0; i < messages; ++i) {
+        codecTotal += codec.encode(buf, sizeof(buf));
+    }
+    const double codecBinaryUSec = st.elapsedUSec();
+    CPPUNIT_ASSERT_EQUAL(legacyTotal, codecTotal);
+
+    auto rate = [messages](double usec) {
+        return usec > 0 ? static_cast<int>(messages * 1e6 / usec) : 0;
+    };
+    std::cout << "\nGeneric protocol, " << chunks.size() << " chunks, messages/s: ASCII "
+              << rate(legacyAsciiUSec) << " before, " << rate(codecAsciiUSec) << " compiled; binary "
+              << rate(legacyBinaryUSec) << " before, " << rate(codecBinaryUSec) << " compiled" << std::endl;
+}
@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+// The generic protocol codec unit tests.
+class GenericCodecTests : public CppUnit::TestFixture
+{
+    // Set up the test suite.
+    CPPUNIT_TEST_SUITE(GenericCodecTests);
+    CPPUNIT_TEST(testBinaryRoundTrip);
+    CPPUNIT_TEST(testBinaryLayout);
+    CPPUNIT_TEST(testAsciiFormats);
+    CPPUNIT_TEST(testAsciiRoundTrip);
+    CPPUNIT_TEST(testThroughput);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    // Set up function for each test.
+    void setUp();
+
+    // Clean up after each test.
+    void tearDown();
+
+    // The tests.
+    void testBinaryRoundTrip();
+    void testBinaryLayout();
+    void testAsciiFormats();
+    void testAsciiRoundTrip();
+    void testThroughput();
+};
@@ -0,0 +1,184 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "test_httpd.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include <simgear/io/HTTPClient.hxx>
+#include <simgear/io/HTTPMemoryRequest.hxx>
+#include <simgear/io/iostreams/sgstream.hxx>
+#include <simgear/misc/sg_dir.hxx>
+#include <simgear/props/props.hxx>
+
+#include <Main/fg_props.hxx>
+#include <Main/globals.hxx>
+#include <Network/http/httpd.hxx>
+
+namespace {
+
+const char* PORT = "18089";
+
+struct FrameTimes {
+    std::vector<double> msec;
+
+    double mean() const
+    {
+        double sum = 0.0;
+        for (double t : msec) {
+            sum += t;
+        }
+        return msec.empty() ? 0.0 : sum / msec.size();
+    }
+
+    double max() const
+    {
+        return msec.empty() ? 0.0 : *std::max_element(msec.begin(), msec.end());
+    }
+
+    double p99() const
+    {
+        if (msec.empty()) {
+            return 0.0;
+        }
+        std::vector<double> sorted(msec);
+        const size_t i = (sorted.size() * 99) / 100;
+        std::nth_element(sorted.begin(), sorted.begin() + i, sorted.end());
+        return sorted[i];
+    }
+};
+
+// update() the httpd at 60 Hz for the given time, like the main loop would
+FrameTimes runFrames(SGSubsystem* httpd, double seconds)
+{
+    FrameTimes times;
+    const auto frame = std::chrono::microseconds(16667);
+    const auto end = std::chrono::steady_clock::now() +
+                     std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+
+    while (std::chrono::steady_clock::now() < end) {
+        const auto start = std::chrono::steady_clock::now();
+        httpd->update(1.0 / 60);
+        times.msec.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        std::this_thread::sleep_until(start + frame);
+    }
+    return times;
+}
+
+} // anonymous namespace
+
+
+// Set up function for each test.
+void HttpdTests::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("httpd");
+}
+
+
+// Clean up after each test.
+void HttpdTests::tearDown()
+{
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+
+// 200 requests per second, mixed property tree dumps and static files, are
+// all answered while the frames run, and don't make the frames much slower
+void HttpdTests::testFrameTimesUnderLoad()
+{
+    SGPath docRoot = globals->get_fg_home() / "httpd-test";
+    simgear::Dir(docRoot).create(0755);
+    {
+        sg_ofstream s(docRoot / "index.html");
+        for (int i = 0; i < 1000; ++i) {
+            s << "<p>static content " << i << "</p>\n";
+        }
+    }
+
+    SGPropertyNode* tree = fgGetNode("/test/tree", true);
+    for (int i = 0; i < 10; ++i) {
+        SGPropertyNode* group = tree->getNode("group", i, true);
+        for (int j = 0; j < 20; ++j) {
+            group->getNode("value", j, true)->setDoubleValue(i * j * 0.5);
+        }
+    }
+
+    SGPropertyNode_ptr config = fgGetNode(flightgear::http::PROPERTY_ROOT, true);
+    config->setStringValue("options/listening-port", PORT);
+    config->setStringValue("options/document-root", docRoot.utf8Str());
+    config->setStringValue("uri-handler/json", "/json/");
+
+    std::unique_ptr<SGSubsystem> httpd(flightgear::http::FGHttpd::createInstance(config));
+    CPPUNIT_ASSERT(httpd);
+    httpd->init();
+
+    const FrameTimes idle = runFrames(httpd.get(), 1.0);
+
+    std::atomic<bool> stop{false}, answered{false};
+    std::vector<simgear::HTTP::Request_ptr> requests;
+    std::thread client([&] {
+        simgear::HTTP::Client http;
+        const std::string base = std::string("http://localhost:") + PORT;
+        const std::string urls[] = {"/json/test/tree?d=3", "/index.html"};
+
+        auto next = std::chrono::steady_clock::now();
+        while (!stop && !answered) {
+            if (requests.size() < 400 && std::chrono::steady_clock::now() >= next) {
+                simgear::HTTP::Request_ptr r(new simgear::HTTP::MemoryRequest(base + urls[requests.size() % 2]));
+                http.makeRequest(r);
+                requests.push_back(r);
+                next += std::chrono::milliseconds(5);
+            }
+            http.update(1);
+            answered = requests.size() == 400 &&
+                       std::all_of(requests.begin(), requests.end(),
+                                   [](const simgear::HTTP::Request_ptr& r) { return r->isComplete(); });
+        }
+    });
+
+    const FrameTimes loaded = runFrames(httpd.get(), 2.0);
+
+    // answer the remaining requests, giving up after a few seconds
+    for (int i = 0; i < 300 && !answered; ++i) {
+        httpd->update(1.0 / 60);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    stop = true;
+    client.join();
+    httpd->unbind();
+
+    std::cout << "httpd frame times: idle mean " << idle.mean() << " p99 " << idle.p99()
+              << " max " << idle.max() << " ms, with 200 req/s mean " << loaded.mean()
+              << " p99 " << loaded.p99() << " max " << loaded.max() << " ms" << std::endl;
+
+    // The tree dumps are the only thing left on the main thread, and they are
+    // spread over the frames by the 2 ms task budget. The bound is loose, so
+    // that slow or busy machines pass: under load, 99% of the frames must
+    // stay within a 60 Hz frame, or within 10 times the idle p99 when even
+    // idle frames are that slow. Isolated stalls (the max) are not checked.
+    CPPUNIT_ASSERT(!idle.msec.empty());
+    CPPUNIT_ASSERT(!loaded.msec.empty());
+    const double limit = std::max(1000.0 / 60, 10 * idle.p99());
+    CPPUNIT_ASSERT_MESSAGE("p99 frame time under load " + std::to_string(loaded.p99()) +
+                               " ms exceeds " + std::to_string(limit) + " ms",
+                           loaded.p99() <= limit);
+
+    CPPUNIT_ASSERT_EQUAL(size_t(400), requests.size());
+    for (const auto& r : requests) {
+        CPPUNIT_ASSERT(r->isComplete());
+        CPPUNIT_ASSERT_EQUAL(200, r->responseCode());
+    }
+}
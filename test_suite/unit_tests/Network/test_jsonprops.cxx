@@ -0,0 +1,189 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "test_jsonprops.hxx"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include <simgear/props/props.hxx>
+#include <simgear/timing/timestamp.hxx>
+
+#include <Main/fg_props.hxx>
+#include <Network/http/jsonprops.hxx>
+
+using flightgear::http::JSON;
+using flightgear::http::PropertyJsonWriter;
+
+namespace {
+
+// what JSON::toJsonString() used to do
+std::string printDOM(bool indent, SGPropertyNode_ptr n, int depth, double timestamp)
+{
+    cJSON* json = JSON::toJson(n, depth, timestamp);
+    char* s = indent ? cJSON_Print(json) : cJSON_PrintUnformatted(json);
+    std::string result(s);
+    free(s);
+    cJSON_Delete(json);
+    return result;
+}
+
+// bytes allocated by cJSON, counted thru its hooks
+size_t allocated = 0;
+size_t peakAllocated = 0;
+
+void* countingMalloc(size_t size)
+{
+    size_t* p = static_cast<size_t*>(malloc(size + sizeof(size_t)));
+    *p = size;
+    allocated += size;
+    peakAllocated = std::max(peakAllocated, allocated);
+    return p + 1;
+}
+
+void countingFree(void* ptr)
+{
+    if (!ptr) {
+        return;
+    }
+    size_t* p = static_cast<size_t*>(ptr) - 1;
+    allocated -= *p;
+    free(p);
+}
+
+SGPropertyNode* createTestTree()
+{
+    SGPropertyNode* tree = fgGetNode("/test/json", true);
+    const double values[] = {0.0, 1.0, -1.0, 2147483647.0, 2147483648.0, -3e10, 1e61,
+                             1.5e-7, 0.1, 123.456, 1e9 + 0.5, -0.0, 1e-300,
+                             std::numeric_limits<double>::quiet_NaN()};
+    int i = 0;
+    for (double v : values) {
+        tree->getNode("double", i++, true)->setDoubleValue(v);
+    }
+    tree->getNode("int", true)->setIntValue(-42);
+    tree->getNode("long", true)->setLongValue(1234567890123LL);
+    tree->getNode("float", true)->setFloatValue(0.25f);
+    tree->getNode("bool", true)->setBoolValue(true);
+    tree->getNode("string", 2, true)->setStringValue("a\"b\\c\n\r\t\b\f\x01\x1f/\xc3\xa9");
+    tree->getNode("empty", true);
+    tree->getNode("group/sub[1]/deep", true)->setIntValue(7);
+    return tree;
+}
+
+} // anonymous namespace
+
+
+// Set up function for each test.
+void JsonPropsTests::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("jsonprops");
+}
+
+
+// Clean up after each test.
+void JsonPropsTests::tearDown()
+{
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+
+// The writer must produce exactly what cJSON printed, clients parse it
+void JsonPropsTests::testSameAsCJSON()
+{
+    SGPropertyNode* tree = createTestTree();
+
+    for (bool indent : {false, true}) {
+        for (int depth = 0; depth < 5; ++depth) {
+            for (double timestamp : {-1.0, 12.5}) {
+                CPPUNIT_ASSERT_EQUAL(printDOM(indent, tree, depth, timestamp),
+                                     JSON::toJsonString(indent, tree, depth, timestamp));
+            }
+        }
+    }
+}
+
+
+// Writing in pieces must give the same output as writing at once
+void JsonPropsTests::testChunks()
+{
+    SGPropertyNode* tree = createTestTree();
+
+    for (bool indent : {false, true}) {
+        const std::string whole = JSON::toJsonString(indent, tree, 4, 1.0);
+        for (size_t limit : {1, 7, 100, 4096}) {
+            PropertyJsonWriter writer(tree, 4, indent, 1.0);
+            std::string pieces;
+            int n = 1;
+            while (!writer.write(pieces, limit)) {
+                ++n;
+            }
+            CPPUNIT_ASSERT(writer.done());
+            CPPUNIT_ASSERT_EQUAL(whole, pieces);
+            if (limit == 1) {
+                // one piece per node
+                CPPUNIT_ASSERT(n > 20);
+            }
+        }
+    }
+}
+
+
+// Time and peak memory of the cJSON tree against the streaming writer for
+// 100k nodes
+void JsonPropsTests::testBenchmark()
+{
+    SGPropertyNode* tree = fgGetNode("/test/big", true);
+    for (int i = 0; i < 100; ++i) {
+        SGPropertyNode* group = tree->getNode("group", i, true);
+        for (int j = 0; j < 1000; ++j) {
+            group->getNode("value", j, true)->setDoubleValue(i * j * 0.5);
+        }
+    }
+
+    cJSON_Hooks hooks = {countingMalloc, countingFree};
+    cJSON_InitHooks(&hooks);
+    allocated = peakAllocated = 0;
+
+    SGTimeStamp st;
+    st.stamp();
+    cJSON* json = JSON::toJson(tree, 2);
+    char* s = cJSON_PrintUnformatted(json);
+    const std::string dom(s);
+    countingFree(s);
+    cJSON_Delete(json);
+    const int domMsec = st.elapsedMSec();
+    const size_t domPeak = peakAllocated;
+
+    cJSON_InitHooks(NULL);
+
+    // the way JsonUriHandler sends it
+    st.stamp();
+    PropertyJsonWriter writer(tree, 2, false);
+    std::string chunk, streamed;
+    size_t writerPeak = 0;
+    bool done = false;
+    while (!done) {
+        chunk.clear();
+        done = writer.write(chunk, 64 * 1024);
+        writerPeak = std::max(writerPeak, chunk.capacity());
+        streamed += chunk;
+    }
+    const int writerMsec = st.elapsedMSec();
+
+    std::cout << "JSON of 100k nodes (" << dom.size() << " bytes): cJSON " << domMsec
+              << " ms, peak " << domPeak / 1024 << " KiB; writer " << writerMsec
+              << " ms, peak " << writerPeak / 1024 << " KiB" << std::endl;
+
+    CPPUNIT_ASSERT_EQUAL(dom, streamed);
+    CPPUNIT_ASSERT(writerPeak < domPeak / 10);
+}
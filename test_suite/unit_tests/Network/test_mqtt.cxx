@@ -0,0 +1,418 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "test_mqtt.hxx"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include <simgear/props/props.hxx>
+
+#include <Main/fg_props.hxx>
+#include <Network/mqtt/PayloadEncoder.hxx>
+#include <Network/mqtt/mqttd.hxx>
+
+#include <cJSON.h>
+#include <mongoose.h>
+
+using flightgear::mqtt::BinaryPayloadEncoder;
+using flightgear::mqtt::JsonPayloadEncoder;
+
+namespace {
+
+const char* BROKER_URL = "mqtt://127.0.0.1:18883";
+const char* BATCH_TOPIC = "fgfs/batch";
+
+// Just enough of a broker for one client: acknowledges CONNECT and
+// SUBSCRIBE, records what is published and can publish to the client.
+struct StubBroker {
+    struct mg_mgr mgr;
+    struct mg_connection* client = nullptr;
+    bool subscribed = false;
+    std::vector<std::pair<std::string, std::string>> published;
+
+    StubBroker()
+    {
+        mg_mgr_init(&mgr);
+        CPPUNIT_ASSERT(mg_mqtt_listen(&mgr, BROKER_URL, handler, this));
+    }
+
+    ~StubBroker() { mg_mgr_free(&mgr); }
+
+    size_t count(const std::string& topic) const
+    {
+        size_t n = 0;
+        for (const auto& p : published) {
+            if (p.first == topic) ++n;
+        }
+        return n;
+    }
+
+    void publish(const std::string& topic, const void* data, size_t len)
+    {
+        CPPUNIT_ASSERT(client);
+        mg_mqtt_pub(client, mg_str_n(topic.c_str(), topic.size()),
+                    mg_str_n(static_cast<const char*>(data), len), 0, false);
+    }
+
+    static void handler(struct mg_connection* c, int ev, void* ev_data, void* fn_data)
+    {
+        StubBroker* broker = static_cast<StubBroker*>(fn_data);
+        if (ev == MG_EV_MQTT_CMD) {
+            struct mg_mqtt_message* mm = static_cast<struct mg_mqtt_message*>(ev_data);
+            switch (mm->cmd) {
+            case MQTT_CMD_CONNECT: {
+                uint8_t response[] = {0, 0};
+                mg_mqtt_send_header(c, MQTT_CMD_CONNACK, 0, sizeof(response));
+                mg_send(c, response, sizeof(response));
+                broker->client = c;
+                break;
+            }
+            case MQTT_CMD_SUBSCRIBE: {
+                // mqttd subscribes to a single topic at QoS 0
+                uint16_t id = mg_htons(mm->id);
+                uint8_t qos = 0;
+                mg_mqtt_send_header(c, MQTT_CMD_SUBACK, 0, sizeof(id) + sizeof(qos));
+                mg_send(c, &id, sizeof(id));
+                mg_send(c, &qos, sizeof(qos));
+                broker->subscribed = true;
+                break;
+            }
+            case MQTT_CMD_PUBLISH:
+                broker->published.emplace_back(std::string(mm->topic.ptr, mm->topic.len),
+                                               std::string(mm->data.ptr, mm->data.len));
+                break;
+            }
+        } else if (ev == MG_EV_CLOSE && c == broker->client) {
+            broker->client = nullptr;
+            broker->subscribed = false;
+        }
+    }
+};
+
+// run mqttd and the broker for the given time, like the main loop would
+void pump(SGSubsystem* mqttd, StubBroker& broker, int msec)
+{
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(msec);
+    while (std::chrono::steady_clock::now() < end) {
+        mqttd->update(0.01);
+        mg_mgr_poll(&broker.mgr, 1);
+    }
+}
+
+std::unique_ptr<SGSubsystem> startMqttd(StubBroker& broker)
+{
+    SGPropertyNode_ptr config = fgGetNode(flightgear::mqtt::PROPERTY_ROOT, true);
+    config->setStringValue("options/listening-port", "1");
+    config->setStringValue("options/url", BROKER_URL);
+    config->setStringValue("options/watched-list", "/network/mqtt");
+    config->setIntValue("options/retry-timeout-ms", 100);
+
+    std::unique_ptr<SGSubsystem> mqttd(flightgear::mqtt::FGMqttd::createInstance(config));
+    CPPUNIT_ASSERT(mqttd);
+    mqttd->init();
+
+    for (int i = 0; i < 300 && !broker.subscribed; ++i) {
+        pump(mqttd.get(), broker, 10);
+    }
+    CPPUNIT_ASSERT(broker.subscribed);
+
+    // the initial values go out once connected
+    pump(mqttd.get(), broker, 300);
+    return mqttd;
+}
+
+struct BinaryValue {
+    int type;
+    double number;
+    std::string string;
+};
+
+template <class T>
+T readLE(const std::string& in, size_t& pos)
+{
+    uint64_t v = 0;
+    CPPUNIT_ASSERT(pos + sizeof(T) <= in.size());
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        v |= uint64_t(static_cast<unsigned char>(in[pos + i])) << (8 * i);
+    }
+    pos += sizeof(T);
+    T t;
+    if (sizeof(T) == 8) {
+        uint64_t u = v;
+        memcpy(&t, &u, sizeof(t));
+    } else if (sizeof(T) == 4) {
+        uint32_t u = static_cast<uint32_t>(v);
+        memcpy(&t, &u, sizeof(t));
+    } else if (sizeof(T) == 2) {
+        uint16_t u = static_cast<uint16_t>(v);
+        memcpy(&t, &u, sizeof(t));
+    } else {
+        uint8_t u = static_cast<uint8_t>(v);
+        memcpy(&t, &u, sizeof(t));
+    }
+    return t;
+}
+
+std::string readString16(const std::string& in, size_t& pos)
+{
+    const uint16_t len = readLE<uint16_t>(in, pos);
+    CPPUNIT_ASSERT(pos + len <= in.size());
+    std::string s = in.substr(pos, len);
+    pos += len;
+    return s;
+}
+
+// decode a "binary" payload the way a consumer outside FlightGear would
+std::map<std::string, BinaryValue> decodeBinary(const std::string& payload)
+{
+    std::map<std::string, BinaryValue> values;
+    CPPUNIT_ASSERT(payload.size() >= 7);
+    CPPUNIT_ASSERT_EQUAL(std::string("FGMQ"), payload.substr(0, 4));
+    CPPUNIT_ASSERT_EQUAL(int(BinaryPayloadEncoder::VERSION), int(payload[4]));
+
+    size_t pos = 5;
+    const uint16_t count = readLE<uint16_t>(payload, pos);
+    for (unsigned i = 0; i < count; ++i) {
+        const std::string path = readString16(payload, pos);
+        BinaryValue& v = values[path];
+        v.type = readLE<uint8_t>(payload, pos);
+        switch (v.type) {
+        case BinaryPayloadEncoder::BOOL: v.number = readLE<uint8_t>(payload, pos); break;
+        case BinaryPayloadEncoder::INT: v.number = readLE<int32_t>(payload, pos); break;
+        case BinaryPayloadEncoder::LONG: v.number = readLE<int64_t>(payload, pos); break;
+        case BinaryPayloadEncoder::FLOAT: v.number = readLE<float>(payload, pos); break;
+        case BinaryPayloadEncoder::DOUBLE: v.number = readLE<double>(payload, pos); break;
+        case BinaryPayloadEncoder::STRING: v.string = readString16(payload, pos); break;
+        default: CPPUNIT_FAIL("unknown type in payload");
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(payload.size(), pos);
+    CPPUNIT_ASSERT_EQUAL(size_t(count), values.size());
+    return values;
+}
+
+// one property of each type, below /test/types
+std::vector<SGPropertyNode*> makeTypedNodes()
+{
+    SGPropertyNode* root = fgGetNode("/test/types", true);
+    root->setBoolValue("b", true);
+    root->setIntValue("i", -123456);
+    root->setLongValue("l", -1234567890123LL);
+    root->setFloatValue("f", 1.5f);
+    root->setDoubleValue("d", 47.123456789012345);
+    root->setStringValue("s", "say \"hello\"\n");
+    return {root->getNode("b"), root->getNode("i"), root->getNode("l"),
+            root->getNode("f"), root->getNode("d"), root->getNode("s")};
+}
+
+} // anonymous namespace
+
+
+// Set up function for each test.
+void MqttTests::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("mqtt");
+}
+
+
+// Clean up after each test.
+void MqttTests::tearDown()
+{
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+
+void MqttTests::testBinaryEncoding()
+{
+    std::vector<SGPropertyNode*> nodes = makeTypedNodes();
+    std::unique_ptr<flightgear::mqtt::PayloadEncoder> encoder =
+        flightgear::mqtt::PayloadEncoder::create("binary");
+    CPPUNIT_ASSERT(encoder);
+
+    std::string payload;
+    encoder->begin(payload);
+    for (SGPropertyNode* n : nodes) {
+        encoder->add(payload, n->getPath(true), n);
+    }
+    encoder->end(payload, nodes.size());
+
+    auto values = decodeBinary(payload);
+    CPPUNIT_ASSERT_EQUAL(int(BinaryPayloadEncoder::BOOL), values["/test/types/b"].type);
+    CPPUNIT_ASSERT_EQUAL(1.0, values["/test/types/b"].number);
+    CPPUNIT_ASSERT_EQUAL(int(BinaryPayloadEncoder::INT), values["/test/types/i"].type);
+    CPPUNIT_ASSERT_EQUAL(-123456.0, values["/test/types/i"].number);
+    CPPUNIT_ASSERT_EQUAL(int(BinaryPayloadEncoder::LONG), values["/test/types/l"].type);
+    CPPUNIT_ASSERT_EQUAL(-1234567890123.0, values["/test/types/l"].number);
+    CPPUNIT_ASSERT_EQUAL(int(BinaryPayloadEncoder::FLOAT), values["/test/types/f"].type);
+    CPPUNIT_ASSERT_EQUAL(1.5, values["/test/types/f"].number);
+    CPPUNIT_ASSERT_EQUAL(int(BinaryPayloadEncoder::DOUBLE), values["/test/types/d"].type);
+    CPPUNIT_ASSERT_EQUAL(47.123456789012345, values["/test/types/d"].number);
+    CPPUNIT_ASSERT_EQUAL(int(BinaryPayloadEncoder::STRING), values["/test/types/s"].type);
+    CPPUNIT_ASSERT_EQUAL(std::string("say \"hello\"\n"), values["/test/types/s"].string);
+
+    CPPUNIT_ASSERT(!flightgear::mqtt::PayloadEncoder::create("no-such-encoding"));
+}
+
+
+void MqttTests::testJsonEncoding()
+{
+    std::vector<SGPropertyNode*> nodes = makeTypedNodes();
+    JsonPayloadEncoder encoder;
+
+    std::string payload;
+    encoder.begin(payload);
+    for (SGPropertyNode* n : nodes) {
+        encoder.add(payload, n->getPath(true), n);
+    }
+    encoder.end(payload, nodes.size());
+
+    cJSON* json = cJSON_Parse(payload.c_str());
+    CPPUNIT_ASSERT(json);
+    CPPUNIT_ASSERT_EQUAL(6, cJSON_GetArraySize(json));
+    CPPUNIT_ASSERT_EQUAL(cJSON_True, cJSON_GetObjectItem(json, "/test/types/b")->type);
+    CPPUNIT_ASSERT_EQUAL(-123456.0, cJSON_GetObjectItem(json, "/test/types/i")->valuedouble);
+    CPPUNIT_ASSERT_EQUAL(-1234567890123.0, cJSON_GetObjectItem(json, "/test/types/l")->valuedouble);
+    CPPUNIT_ASSERT_EQUAL(1.5, cJSON_GetObjectItem(json, "/test/types/f")->valuedouble);
+    // cJSON's own number parser is not exact in the last digits
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(47.123456789012345, cJSON_GetObjectItem(json, "/test/types/d")->valuedouble, 1e-12);
+    CPPUNIT_ASSERT_EQUAL(std::string("say \"hello\"\n"),
+                         std::string(cJSON_GetObjectItem(json, "/test/types/s")->valuestring));
+    cJSON_Delete(json);
+}
+
+
+// With a batch window, everything changed within it goes out as one payload
+void MqttTests::testBatching()
+{
+    const int N = 50;
+    SGPropertyNode* batch = fgGetNode("/network/mqtt/batch", true);
+    for (int i = 0; i < N; ++i) {
+        batch->getNode("value", i, true)->setDoubleValue(0.0);
+    }
+    fgSetInt("/sim/mqtt/options/batch-interval-ms", 100);
+    fgSetString("/sim/mqtt/options/batch-topic", BATCH_TOPIC);
+    fgSetString("/sim/mqtt/options/encoding", "binary");
+
+    StubBroker broker;
+    std::unique_ptr<SGSubsystem> mqttd = startMqttd(broker);
+
+    CPPUNIT_ASSERT_EQUAL(size_t(1), broker.count(BATCH_TOPIC));
+    CPPUNIT_ASSERT_EQUAL(size_t(N), decodeBinary(broker.published.back().second).size());
+    broker.published.clear();
+
+    // change everything every 10ms frame for a second
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    int frame = 0;
+    while (std::chrono::steady_clock::now() < end) {
+        ++frame;
+        for (int i = 0; i < N; ++i) {
+            batch->getChild("value", i)->setDoubleValue(frame + i * 0.001);
+        }
+        pump(mqttd.get(), broker, 10);
+    }
+    pump(mqttd.get(), broker, 300);
+    mqttd->unbind();
+
+    // one message per window instead of one per property and frame
+    const size_t batches = broker.count(BATCH_TOPIC);
+    std::cout << "mqtt: " << N << " properties changed in " << frame
+              << " frames, published as " << batches << " messages" << std::endl;
+    CPPUNIT_ASSERT_EQUAL(batches, broker.published.size());
+    CPPUNIT_ASSERT(batches >= 5);
+    CPPUNIT_ASSERT(batches <= 14);
+
+    // the last one has the final values
+    auto values = decodeBinary(broker.published.back().second);
+    CPPUNIT_ASSERT_EQUAL(size_t(N), values.size());
+    for (int i = 0; i < N; ++i) {
+        const std::string path = batch->getChild("value", i)->getPath(true);
+        CPPUNIT_ASSERT_EQUAL(frame + i * 0.001, values[path].number);
+    }
+}
+
+
+// Numeric changes within the deadband of the last published value are not
+// published, and setting the same value again never is
+void MqttTests::testDeadband()
+{
+    fgSetDouble("/network/mqtt/coarse/a", 0.0);
+    fgSetDouble("/network/mqtt/fine/b", 0.0);
+    fgSetString("/network/mqtt/fine/s", "one");
+    fgSetString("/sim/mqtt/options/deadband/path", "/network/mqtt/coarse");
+    fgSetDouble("/sim/mqtt/options/deadband/value", 0.5);
+
+    StubBroker broker;
+    std::unique_ptr<SGSubsystem> mqttd = startMqttd(broker);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), broker.count("/network/mqtt/coarse/a"));
+    CPPUNIT_ASSERT_EQUAL(size_t(1), broker.count("/network/mqtt/fine/b"));
+    CPPUNIT_ASSERT_EQUAL(size_t(1), broker.count("/network/mqtt/fine/s"));
+    broker.published.clear();
+
+    fgSetDouble("/network/mqtt/coarse/a", 0.2);
+    pump(mqttd.get(), broker, 50);
+    fgSetDouble("/network/mqtt/coarse/a", 0.45);
+    pump(mqttd.get(), broker, 50);
+    fgSetString("/network/mqtt/fine/s", "one");
+    pump(mqttd.get(), broker, 50);
+    CPPUNIT_ASSERT(broker.published.empty());
+
+    fgSetDouble("/network/mqtt/coarse/a", 0.6);
+    fgSetDouble("/network/mqtt/fine/b", 0.01);
+    fgSetString("/network/mqtt/fine/s", "two");
+    pump(mqttd.get(), broker, 100);
+    mqttd->unbind();
+
+    CPPUNIT_ASSERT_EQUAL(size_t(3), broker.published.size());
+    for (const auto& p : broker.published) {
+        if (p.first == "/network/mqtt/coarse/a") {
+            double d;
+            CPPUNIT_ASSERT_EQUAL(sizeof(d), p.second.size());
+            memcpy(&d, p.second.data(), sizeof(d));
+            CPPUNIT_ASSERT_EQUAL(0.6, d);
+        } else if (p.first == "/network/mqtt/fine/s") {
+            CPPUNIT_ASSERT_EQUAL(std::string("two"), p.second);
+        } else {
+            CPPUNIT_ASSERT_EQUAL(std::string("/network/mqtt/fine/b"), p.first);
+        }
+    }
+}
+
+
+// A value received from the broker is applied, but not sent back to it
+void MqttTests::testRemoteUpdateNotEchoed()
+{
+    fgSetDouble("/network/mqtt/remote/x", 1.0);
+
+    StubBroker broker;
+    std::unique_ptr<SGSubsystem> mqttd = startMqttd(broker);
+    broker.published.clear();
+
+    const double remote = 42.0;
+    broker.publish("/network/mqtt/remote/x", &remote, sizeof(remote));
+    // not watched, must be ignored
+    broker.publish("/network/mqtt/remote/unknown", &remote, sizeof(remote));
+    pump(mqttd.get(), broker, 200);
+
+    CPPUNIT_ASSERT_EQUAL(remote, fgGetDouble("/network/mqtt/remote/x"));
+    CPPUNIT_ASSERT(!fgGetNode("/network/mqtt/remote/unknown"));
+    CPPUNIT_ASSERT(broker.published.empty());
+
+    // local changes still go out
+    fgSetDouble("/network/mqtt/remote/x", 43.0);
+    pump(mqttd.get(), broker, 100);
+    mqttd->unbind();
+    CPPUNIT_ASSERT_EQUAL(size_t(1), broker.count("/network/mqtt/remote/x"));
+}
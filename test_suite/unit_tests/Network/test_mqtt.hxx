@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+// The mqttd unit tests, against a stub broker on localhost.
+class MqttTests : public CppUnit::TestFixture
+{
+    // Set up the test suite.
+    CPPUNIT_TEST_SUITE(MqttTests);
+    CPPUNIT_TEST(testBinaryEncoding);
+    CPPUNIT_TEST(testJsonEncoding);
+    CPPUNIT_TEST(testBatching);
+    CPPUNIT_TEST(testDeadband);
+    CPPUNIT_TEST(testRemoteUpdateNotEchoed);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    // Set up function for each test.
+    void setUp();
+
+    // Clean up after each test.
+    void tearDown();
+
+    // The tests.
+    void testBinaryEncoding();
+    void testJsonEncoding();
+    void testBatching();
+    void testDeadband();
+    void testRemoteUpdateNotEchoed();
+};
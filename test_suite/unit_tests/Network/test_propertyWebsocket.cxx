@@ -0,0 +1,250 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "test_propertyWebsocket.hxx"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cJSON.h>
+
+#include "test_suite/FGTestApi/testGlobals.hxx"
+
+#include <simgear/props/props.hxx>
+
+#include <Main/fg_props.hxx>
+#include <Network/http/PropertyChangeObserver.hxx>
+#include <Network/http/PropertyChangeWebsocket.hxx>
+#include <Network/http/jsonprops.hxx>
+
+using namespace flightgear::http;
+
+namespace {
+
+// keeps the text frames written to it
+class RecordingWriter : public WebsocketWriter
+{
+public:
+    int writeToWebsocket(int opcode, const char* data, size_t len) override
+    {
+        CPPUNIT_ASSERT_EQUAL(1, opcode);
+        frames.emplace_back(data, len);
+        return 0;
+    }
+
+    std::vector<std::string> frames;
+};
+
+// a websocket client, as the httpd drives it
+struct Client {
+    explicit Client(PropertyChangeObserver* observer) : ws(observer) {}
+
+    void command(const std::string& json)
+    {
+        HTTPRequest request;
+        request.Content = json;
+        ws.handleRequest(request, writer);
+    }
+
+    PropertyChangeWebsocket ws;
+    RecordingWriter writer;
+};
+
+// one httpd update at the given time
+void frame(PropertyChangeObserver& observer, double time, const std::vector<Client*>& clients)
+{
+    fgSetDouble("/sim/time/elapsed-sec", time);
+    observer.check();
+    for (Client* c : clients) {
+        c->ws.poll(c->writer);
+    }
+    observer.uncheck();
+}
+
+std::string member(const std::string& frame, const char* name)
+{
+    cJSON* json = cJSON_Parse(frame.c_str());
+    CPPUNIT_ASSERT(json);
+    cJSON* item = cJSON_GetObjectItem(json, name);
+    CPPUNIT_ASSERT(item);
+    std::string result = item->type == cJSON_String ? item->valuestring
+                                                    : std::to_string(item->valuedouble);
+    cJSON_Delete(json);
+    return result;
+}
+
+double timestamp(const std::string& frame)
+{
+    return std::stod(member(frame, "ts"));
+}
+
+} // anonymous namespace
+
+
+// Set up function for each test.
+void PropertyWebsocketTests::setUp()
+{
+    FGTestApi::setUp::initTestGlobals("propertyWebsocket");
+}
+
+
+// Clean up after each test.
+void PropertyWebsocketTests::tearDown()
+{
+    FGTestApi::tearDown::shutdownTestGlobals();
+}
+
+
+// A new listener gets the current value once, not again on the next frames
+void PropertyWebsocketTests::testInitialValueSentOnce()
+{
+    fgSetString("/test/a", "one");
+    PropertyChangeObserver observer;
+    Client client(&observer);
+    client.command("{\"command\":\"configure\",\"interval\":0}");
+
+    // the httpd handles requests between check() and uncheck()
+    fgSetDouble("/sim/time/elapsed-sec", 0.0);
+    observer.check();
+    client.command("{\"command\":\"addListener\",\"node\":\"/test/a\"}");
+    client.ws.poll(client.writer);
+    observer.uncheck();
+
+    for (int i = 1; i <= 5; ++i) {
+        frame(observer, i, {&client});
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(1), client.writer.frames.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("one"), member(client.writer.frames[0], "value"));
+
+    fgSetString("/test/a", "two");
+    frame(observer, 6, {&client});
+    frame(observer, 7, {&client});
+    CPPUNIT_ASSERT_EQUAL(size_t(2), client.writer.frames.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("two"), member(client.writer.frames[1], "value"));
+}
+
+// Clients share the serialization of a change, but each gets the time of
+// its own send
+void PropertyWebsocketTests::testSharedJsonTimestamps()
+{
+    SGPropertyNode_ptr node = fgGetNode("/test/b", true);
+    node->setDoubleValue(1.5);
+    PropertyChangeObserver observer;
+    Client fast(&observer), slow(&observer);
+    fast.command("{\"command\":\"configure\",\"interval\":0}");
+    slow.command("{\"command\":\"configure\",\"interval\":0.5}");
+    fast.command("{\"command\":\"addListener\",\"node\":\"/test/b\"}");
+    slow.command("{\"command\":\"addListener\",\"node\":\"/test/b\"}");
+
+    frame(observer, 10.0, {&fast, &slow});
+    CPPUNIT_ASSERT_EQUAL(size_t(1), fast.writer.frames.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), slow.writer.frames.size());
+
+    node->setDoubleValue(2.5);
+    frame(observer, 10.25, {&fast, &slow});
+    frame(observer, 10.75, {&fast, &slow});
+    CPPUNIT_ASSERT_EQUAL(size_t(2), fast.writer.frames.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(2), slow.writer.frames.size());
+
+    // the same text as serializing the node for each of them
+    CPPUNIT_ASSERT_EQUAL(JSON::toJsonString(false, node, 0, 10.25), fast.writer.frames[1]);
+    CPPUNIT_ASSERT_EQUAL(JSON::toJsonString(false, node, 0, 10.75), slow.writer.frames[1]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.25, timestamp(fast.writer.frames[1]), 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.75, timestamp(slow.writer.frames[1]), 1e-6);
+}
+
+// A client that polls less often than the value changes gets the latest
+// value once
+void PropertyWebsocketTests::testCatchUp()
+{
+    fgSetInt("/test/c", 0);
+    PropertyChangeObserver observer;
+    Client client(&observer);
+    client.command("{\"command\":\"configure\",\"interval\":1.0}");
+    client.command("{\"command\":\"addListener\",\"node\":\"/test/c\"}");
+
+    frame(observer, 0.0, {&client});
+    CPPUNIT_ASSERT_EQUAL(size_t(1), client.writer.frames.size());
+
+    for (int i = 1; i <= 4; ++i) {
+        fgSetInt("/test/c", i);
+        frame(observer, 0.2 * i, {&client});
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(1), client.writer.frames.size());
+
+    frame(observer, 1.1, {&client});
+    frame(observer, 2.2, {&client});
+    CPPUNIT_ASSERT_EQUAL(size_t(2), client.writer.frames.size());
+    CPPUNIT_ASSERT_EQUAL(std::to_string(4.0), member(client.writer.frames[1], "value"));
+}
+
+// Each client has its own interval
+void PropertyWebsocketTests::testInterval()
+{
+    SGPropertyNode_ptr node = fgGetNode("/test/d", true);
+    PropertyChangeObserver observer;
+    Client every(&observer), seldom(&observer);
+    every.command("{\"command\":\"configure\",\"interval\":0}");
+    seldom.command("{\"command\":\"configure\",\"interval\":0.95}");
+    every.command("{\"command\":\"addListener\",\"node\":\"/test/d\"}");
+    seldom.command("{\"command\":\"addListener\",\"node\":\"/test/d\"}");
+
+    // a change every 0.1 s for 3 s
+    for (int i = 0; i < 30; ++i) {
+        node->setIntValue(i);
+        frame(observer, 0.1 * i, {&every, &seldom});
+    }
+
+    CPPUNIT_ASSERT_EQUAL(size_t(30), every.writer.frames.size());
+    // at 0, 1.0, 2.0 (the interval is exceeded every 10th frame)
+    CPPUNIT_ASSERT_EQUAL(size_t(3), seldom.writer.frames.size());
+    CPPUNIT_ASSERT_EQUAL(std::to_string(20.0), member(seldom.writer.frames[2], "value"));
+}
+
+// In batch mode, all changes since the last push go into one frame
+void PropertyWebsocketTests::testBatch()
+{
+    fgSetInt("/test/e/x", 1);
+    fgSetInt("/test/e/y", 2);
+    fgSetInt("/test/e/z", 3);
+    PropertyChangeObserver observer;
+    Client client(&observer);
+    client.command("{\"command\":\"configure\",\"batch\":true,\"interval\":0}");
+    client.command("{\"command\":\"addListener\",\"nodes\":[\"/test/e/x\",\"/test/e/y\",\"/test/e/z\"]}");
+
+    auto paths = [](const std::string& frame) {
+        std::vector<std::string> result;
+        cJSON* json = cJSON_Parse(frame.c_str());
+        CPPUNIT_ASSERT(json);
+        CPPUNIT_ASSERT_EQUAL(int(cJSON_Array), json->type);
+        for (int i = 0; i < cJSON_GetArraySize(json); ++i) {
+            result.push_back(cJSON_GetObjectItem(cJSON_GetArrayItem(json, i), "path")->valuestring);
+        }
+        cJSON_Delete(json);
+        return result;
+    };
+
+    frame(observer, 1.0, {&client});
+    CPPUNIT_ASSERT_EQUAL(size_t(1), client.writer.frames.size());
+    const std::vector<std::string> all{"/test/e/x", "/test/e/y", "/test/e/z"};
+    CPPUNIT_ASSERT(all == paths(client.writer.frames[0]));
+
+    // nothing changed: no frame at all, rather than an empty array
+    frame(observer, 2.0, {&client});
+    CPPUNIT_ASSERT_EQUAL(size_t(1), client.writer.frames.size());
+
+    fgSetInt("/test/e/y", 20);
+    frame(observer, 3.0, {&client});
+    CPPUNIT_ASSERT_EQUAL(size_t(2), client.writer.frames.size());
+    CPPUNIT_ASSERT(std::vector<std::string>{"/test/e/y"} == paths(client.writer.frames[1]));
+
+    // 'get' answers with one array too
+    client.command("{\"command\":\"get\",\"nodes\":[\"/test/e/x\",\"/test/e/z\"]}");
+    CPPUNIT_ASSERT_EQUAL(size_t(3), client.writer.frames.size());
+    CPPUNIT_ASSERT((std::vector<std::string>{"/test/e/x", "/test/e/z"}) == paths(client.writer.frames[2]));
+}
@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+// The property change websocket unit tests.
+class PropertyWebsocketTests : public CppUnit::TestFixture
+{
+    // Set up the test suite.
+    CPPUNIT_TEST_SUITE(PropertyWebsocketTests);
+    CPPUNIT_TEST(testInitialValueSentOnce);
+    CPPUNIT_TEST(testSharedJsonTimestamps);
+    CPPUNIT_TEST(testCatchUp);
+    CPPUNIT_TEST(testInterval);
+    CPPUNIT_TEST(testBatch);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    // Set up function for each test.
+    void setUp();
+
+    // Clean up after each test.
+    void tearDown();
+
+    // The tests.
+    void testInitialValueSentOnce();
+    void testSharedJsonTimestamps();
+    void testCatchUp();
+    void testInterval();
+    void testBatch();
+};
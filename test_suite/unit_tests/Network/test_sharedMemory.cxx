@@ -0,0 +1,407 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "test_sharedMemory.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <Network/SharedMemoryChannel.hxx>
+#include <Network/net_fdm.hxx>
+
+using flightgear::SharedMemoryRing;
+
+namespace {
+
+// unique per test run, segments outlive their writers
+std::string segmentName(const char* what)
+{
+    return std::string("/fg-test-") + what + "-" + std::to_string(getpid());
+}
+
+int64_t nowNSec()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// an FGNetFDM sized message, which tells whether it was torn
+struct Message {
+    uint64_t number;
+    int64_t sent; ///< steady clock, shared by the processes of a machine
+    uint64_t fill[(sizeof(FGNetFDM) - 16) / 8];
+
+    void set(uint64_t n)
+    {
+        number = n;
+        std::fill(std::begin(fill), std::end(fill), n * 0x9e3779b97f4a7c15ULL);
+        sent = nowNSec();
+    }
+
+    bool intact() const
+    {
+        return std::all_of(std::begin(fill), std::end(fill),
+                           [this](uint64_t v) { return v == number * 0x9e3779b97f4a7c15ULL; });
+    }
+};
+
+const int MESSAGES = 2000;
+const auto INTERVAL = std::chrono::microseconds(500);
+
+struct Latencies {
+    std::vector<double> usec;
+    int torn = 0;
+
+    void print(const char* what)
+    {
+        std::sort(usec.begin(), usec.end());
+        double sum = 0.0;
+        for (double u : usec) {
+            sum += u;
+        }
+        const double mean = sum / usec.size();
+        double var = 0.0;
+        for (double u : usec) {
+            var += (u - mean) * (u - mean);
+        }
+        std::cout << what << ": " << usec.size() << " of " << MESSAGES << " messages, latency mean "
+                  << mean << " median " << usec[usec.size() / 2] << " p99 " << usec[usec.size() * 99 / 100]
+                  << " max " << usec.back() << " us, jitter (stddev) " << std::sqrt(var / usec.size())
+                  << " us" << std::endl;
+    }
+};
+
+bool readAll(int fd, void* buf, size_t length)
+{
+    char* p = static_cast<char*>(buf);
+    while (length > 0) {
+        const ssize_t n = ::read(fd, p, length);
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        length -= n;
+    }
+    return true;
+}
+
+void writeAll(int fd, const void* buf, size_t length)
+{
+    const char* p = static_cast<const char*>(buf);
+    while (length > 0) {
+        const ssize_t n = ::write(fd, p, length);
+        if (n <= 0) {
+            return;
+        }
+        p += n;
+        length -= n;
+    }
+}
+
+// Child side: receive until the last message, busy waiting like a motion
+// platform loop would, then report the latencies thru the pipe.
+template <class Receive>
+void reportLatencies(int pipe, Receive receive)
+{
+    Latencies result;
+    Message m;
+    const int64_t giveUp = nowNSec() + 10000000000LL;
+    while (nowNSec() < giveUp) {
+        if (!receive(m)) {
+            continue;
+        }
+        result.usec.push_back((nowNSec() - m.sent) / 1000.0);
+        if (!m.intact()) {
+            ++result.torn;
+        }
+        if (m.number == MESSAGES) {
+            break;
+        }
+    }
+
+    const int count = result.usec.size();
+    writeAll(pipe, &count, sizeof(count));
+    writeAll(pipe, &result.torn, sizeof(result.torn));
+    writeAll(pipe, result.usec.data(), count * sizeof(double));
+}
+
+Latencies collectLatencies(int pipe, pid_t child)
+{
+    Latencies result;
+    int count = 0;
+    CPPUNIT_ASSERT(readAll(pipe, &count, sizeof(count)));
+    CPPUNIT_ASSERT(readAll(pipe, &result.torn, sizeof(result.torn)));
+    result.usec.resize(count);
+    CPPUNIT_ASSERT(readAll(pipe, result.usec.data(), count * sizeof(double)));
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    return result;
+}
+
+// Parent side: a message every INTERVAL
+template <class Send>
+void sendMessages(Send send)
+{
+    Message m;
+    auto next = std::chrono::steady_clock::now();
+    for (int i = 1; i <= MESSAGES; ++i) {
+        std::this_thread::sleep_until(next);
+        next += INTERVAL;
+        m.set(i);
+        send(m);
+    }
+}
+
+} // anonymous namespace
+
+
+// Set up function for each test.
+void SharedMemoryTests::setUp()
+{
+}
+
+
+// Clean up after each test.
+void SharedMemoryTests::tearDown()
+{
+}
+
+
+// Readers get the latest message only, once
+void SharedMemoryTests::testRing()
+{
+    const uint32_t slots = 4, size = 100;
+    alignas(SharedMemoryRing::CACHE_LINE) char memory[1024] = {};
+    CPPUNIT_ASSERT(SharedMemoryRing::segmentSize(slots, size) <= sizeof(memory));
+    void* base = memory;
+
+    SharedMemoryRing writer(base);
+    CPPUNIT_ASSERT(!writer.valid());
+    writer.create(slots, size);
+    CPPUNIT_ASSERT(writer.valid());
+
+    SharedMemoryRing reader(base);
+    uint64_t last = 0;
+    char buf[200];
+    CPPUNIT_ASSERT_EQUAL(0u, reader.read(buf, sizeof(buf), last));
+
+    CPPUNIT_ASSERT(writer.write("one", 3));
+    CPPUNIT_ASSERT_EQUAL(3u, reader.read(buf, sizeof(buf), last));
+    CPPUNIT_ASSERT_EQUAL(std::string("one"), std::string(buf, 3));
+    CPPUNIT_ASSERT_EQUAL(0u, reader.read(buf, sizeof(buf), last));
+
+    // round the ring more than once: only the latest counts
+    for (int i = 0; i < 10; ++i) {
+        const std::string s = "message " + std::to_string(i);
+        CPPUNIT_ASSERT(writer.write(s.data(), s.size()));
+    }
+    CPPUNIT_ASSERT_EQUAL(9u, reader.read(buf, sizeof(buf), last));
+    CPPUNIT_ASSERT_EQUAL(std::string("message 9"), std::string(buf, 9));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(11), last);
+    CPPUNIT_ASSERT_EQUAL(0u, reader.read(buf, sizeof(buf), last));
+
+    // too big to publish, too long to read whole
+    CPPUNIT_ASSERT(!writer.write(buf, size + 1));
+    CPPUNIT_ASSERT(writer.write("truncated", 9));
+    CPPUNIT_ASSERT_EQUAL(5u, reader.read(buf, 5, last));
+
+    // a second reader has its own position
+    uint64_t other = 0;
+    CPPUNIT_ASSERT_EQUAL(9u, reader.read(buf, sizeof(buf), other));
+}
+
+
+// A writer that died halfway thru a message doesn't keep readers spinning
+void SharedMemoryTests::testTornSlot()
+{
+    const uint32_t slots = 4, size = 100;
+    alignas(SharedMemoryRing::CACHE_LINE) char memory[1024] = {};
+    void* base = memory;
+
+    SharedMemoryRing writer(base);
+    writer.create(slots, size);
+    CPPUNIT_ASSERT(writer.write("one", 3));
+    CPPUNIT_ASSERT(writer.write("two", 3));
+
+    // leave the latest slot, the second, as the writer left it mid-copy
+    const size_t line = SharedMemoryRing::CACHE_LINE;
+    const size_t stride = sizeof(SharedMemoryRing::Slot) + (size + line - 1) / line * line;
+    auto slot = reinterpret_cast<SharedMemoryRing::Slot*>(memory + sizeof(SharedMemoryRing::Header) + stride);
+    slot->sequence.store(3);
+
+    SharedMemoryRing reader(base);
+    uint64_t last = 0;
+    char buf[200];
+    CPPUNIT_ASSERT_EQUAL(0u, reader.read(buf, sizeof(buf), last));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), last);
+
+    // once the slot is complete the message is there
+    slot->sequence.store(4);
+    CPPUNIT_ASSERT_EQUAL(3u, reader.read(buf, sizeof(buf), last));
+    CPPUNIT_ASSERT_EQUAL(std::string("two"), std::string(buf, 3));
+}
+
+
+// Reader and writer channels thru a real segment, reader first
+void SharedMemoryTests::testChannel()
+{
+    const std::string name = segmentName("channel");
+    FGSharedMemoryChannel reader(name);
+    CPPUNIT_ASSERT(reader.open(SG_IO_IN));
+
+    char buf[64];
+    CPPUNIT_ASSERT_EQUAL(0, reader.read(buf, sizeof(buf)));
+
+    FGSharedMemoryChannel writer(name, 64, 4);
+    CPPUNIT_ASSERT(writer.open(SG_IO_OUT));
+    CPPUNIT_ASSERT(FGSharedMemoryChannel::isSharedMemory(&writer));
+    CPPUNIT_ASSERT_EQUAL(0, reader.read(buf, sizeof(buf)));
+
+    CPPUNIT_ASSERT_EQUAL(5, writer.write("hello", 5));
+    CPPUNIT_ASSERT_EQUAL(6, writer.writestring("world\n"));
+    CPPUNIT_ASSERT_EQUAL(6, reader.readline(buf, sizeof(buf)));
+    CPPUNIT_ASSERT_EQUAL(std::string("world\n"), std::string(buf));
+    CPPUNIT_ASSERT_EQUAL(0, reader.read(buf, sizeof(buf)));
+
+    // nothing goes the wrong way
+    CPPUNIT_ASSERT_EQUAL(0, reader.write("x", 1));
+    CPPUNIT_ASSERT_EQUAL(0, writer.read(buf, sizeof(buf)));
+    CPPUNIT_ASSERT_EQUAL(0, writer.write(buf, 65));
+
+    FGSharedMemoryChannel both(name);
+    CPPUNIT_ASSERT(!both.open(SG_IO_BI));
+
+    writer.close();
+    reader.close();
+    shm_unlink(name.c_str());
+}
+
+
+// Readers carry on when the writer comes back, even with another size
+void SharedMemoryTests::testWriterRestart()
+{
+    const std::string name = segmentName("restart");
+    char buf[128];
+
+    std::unique_ptr<FGSharedMemoryChannel> writer(new FGSharedMemoryChannel(name, 64, 4));
+    CPPUNIT_ASSERT(writer->open(SG_IO_OUT));
+    CPPUNIT_ASSERT_EQUAL(5, writer->write("first", 5));
+
+    FGSharedMemoryChannel reader(name);
+    CPPUNIT_ASSERT(reader.open(SG_IO_IN));
+    CPPUNIT_ASSERT_EQUAL(5, reader.read(buf, sizeof(buf)));
+
+    // the same geometry: taken over, the reader just sees the next message
+    writer.reset(new FGSharedMemoryChannel(name, 64, 4));
+    CPPUNIT_ASSERT(writer->open(SG_IO_OUT));
+    CPPUNIT_ASSERT_EQUAL(0, reader.read(buf, sizeof(buf)));
+    CPPUNIT_ASSERT_EQUAL(6, writer->write("second", 6));
+    CPPUNIT_ASSERT_EQUAL(6, reader.read(buf, sizeof(buf)));
+    CPPUNIT_ASSERT_EQUAL(std::string("second"), std::string(buf, 6));
+
+    // bigger messages: a new segment, the reader moves over to it
+    writer.reset(new FGSharedMemoryChannel(name, 128, 4));
+    CPPUNIT_ASSERT(writer->open(SG_IO_OUT));
+    std::string big(100, 'b');
+    CPPUNIT_ASSERT_EQUAL(100, writer->write(big.data(), big.size()));
+    CPPUNIT_ASSERT_EQUAL(100, reader.read(buf, sizeof(buf)));
+    CPPUNIT_ASSERT_EQUAL(big, std::string(buf, 100));
+
+    writer.reset();
+    reader.close();
+    shm_unlink(name.c_str());
+}
+
+
+// Latency and jitter of an FGNetFDM sized message from this process to
+// another one, thru shared memory and, for comparison, UDP over loopback
+void SharedMemoryTests::testTwoProcessLatency()
+{
+    // shared memory
+    const std::string name = segmentName("latency");
+    FGSharedMemoryChannel writer(name, sizeof(Message));
+    CPPUNIT_ASSERT(writer.open(SG_IO_OUT));
+
+    int results[2];
+    CPPUNIT_ASSERT_EQUAL(0, pipe(results));
+    pid_t child = fork();
+    CPPUNIT_ASSERT(child >= 0);
+    if (child == 0) {
+        ::close(results[0]);
+        FGSharedMemoryChannel reader(name);
+        reader.open(SG_IO_IN);
+        reportLatencies(results[1], [&](Message& m) {
+            return reader.read(reinterpret_cast<char*>(&m), sizeof(m)) == sizeof(m);
+        });
+        _exit(0);
+    }
+    ::close(results[1]);
+
+    // let the child attach
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    sendMessages([&](const Message& m) {
+        writer.write(reinterpret_cast<const char*>(&m), sizeof(m));
+    });
+    Latencies shm = collectLatencies(results[0], child);
+    ::close(results[0]);
+    writer.close();
+    shm_unlink(name.c_str());
+
+    // UDP
+    int receiver = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    CPPUNIT_ASSERT_EQUAL(0, bind(receiver, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)));
+    socklen_t addrLength = sizeof(addr);
+    getsockname(receiver, reinterpret_cast<sockaddr*>(&addr), &addrLength);
+
+    CPPUNIT_ASSERT_EQUAL(0, pipe(results));
+    child = fork();
+    CPPUNIT_ASSERT(child >= 0);
+    if (child == 0) {
+        ::close(results[0]);
+        reportLatencies(results[1], [&](Message& m) {
+            return recv(receiver, &m, sizeof(m), MSG_DONTWAIT) == sizeof(m);
+        });
+        _exit(0);
+    }
+    ::close(results[1]);
+    ::close(receiver);
+
+    int sender = socket(AF_INET, SOCK_DGRAM, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    sendMessages([&](const Message& m) {
+        sendto(sender, &m, sizeof(m), 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    });
+    Latencies udp = collectLatencies(results[0], child);
+    ::close(results[0]);
+    ::close(sender);
+
+    shm.print("shared memory");
+    udp.print("UDP loopback");
+
+    // readers busy waiting see nearly every message, and never a torn one
+    CPPUNIT_ASSERT(shm.usec.size() > MESSAGES / 2);
+    CPPUNIT_ASSERT_EQUAL(0, shm.torn);
+}
@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2026 The FlightGear Team
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+// The shared memory channel unit tests.
+class SharedMemoryTests : public CppUnit::TestFixture
+{
+    // Set up the test suite.
+    CPPUNIT_TEST_SUITE(SharedMemoryTests);
+    CPPUNIT_TEST(testRing);
+    CPPUNIT_TEST(testTornSlot);
+    CPPUNIT_TEST(testChannel);
+    CPPUNIT_TEST(testWriterRestart);
+    CPPUNIT_TEST(testTwoProcessLatency);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    // Set up function for each test.
+    void setUp();
+
+    // Clean up after each test.
+    void tearDown();
+
+    // The tests.
+    void testRing();
+    void testTornSlot();
+    void testChannel();
+    void testWriterRestart();
+    void testTwoProcessLatency();
+};